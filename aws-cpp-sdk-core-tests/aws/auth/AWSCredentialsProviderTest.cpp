@@ -19,6 +19,7 @@
 #include <aws/testing/mocks/aws/auth/MockAWSHttpResourceClient.h>
 #include <aws/testing/platform/PlatformTesting.h>
 #include <aws/core/auth/AWSCredentialsProvider.h>
+#include <aws/core/auth/AWSCredentialsRefreshScheduler.h>
 #include <aws/core/platform/Environment.h>
 #include <aws/core/platform/FileSystem.h>
 #include <aws/core/utils/UnreferencedParam.h>
@@ -215,6 +216,27 @@ TEST_F(EnvironmentModifyingTest, TestEnvironmentVariablesExist)
 }
 
 
+TEST_F(EnvironmentModifyingTest, TestSnapshotChangesOnlyWithCredentials)
+{
+    Aws::Environment::SetEnv("AWS_ACCESS_KEY_ID", "Access Key", 1);
+    Aws::Environment::SetEnv("AWS_SECRET_ACCESS_KEY", "Secret Key", 1);
+
+    EnvironmentAWSCredentialsProvider provider;
+    auto snapshot = provider.GetAWSCredentialsSnapshot();
+    ASSERT_EQ("Access Key", snapshot->GetAWSAccessKeyId());
+    auto version = provider.GetAWSCredentialsVersion();
+    ASSERT_EQ(snapshot, provider.GetAWSCredentialsSnapshot());
+    ASSERT_EQ(version, provider.GetAWSCredentialsVersion());
+
+    Aws::Environment::SetEnv("AWS_ACCESS_KEY_ID", "Other Access Key", 1);
+    auto nextSnapshot = provider.GetAWSCredentialsSnapshot();
+    ASSERT_EQ("Other Access Key", nextSnapshot->GetAWSAccessKeyId());
+    ASSERT_NE(snapshot, nextSnapshot);
+    ASSERT_EQ(version + 1, provider.GetAWSCredentialsVersion());
+    //whoever still holds the old snapshot keeps seeing the old credentials.
+    ASSERT_EQ("Access Key", snapshot->GetAWSAccessKeyId());
+}
+
 TEST_F(EnvironmentModifyingTest, TestEnvironmentVariablesDoNotExist)
 {
     Aws::Environment::UnSetEnv("AWS_ACCESS_KEY_ID");
@@ -259,6 +281,110 @@ TEST(InstanceProfileCredentialsProviderTest, TestThatProviderRefreshes)
     ASSERT_EQ("betterSecretKey", provider.GetAWSCredentials().GetAWSSecretKey());    
 }
 
+TEST(SimpleAWSCredentialsProviderTest, TestSnapshotIsShared)
+{
+    SimpleAWSCredentialsProvider provider("accessKey", "secretKey", "sessionToken");
+    auto snapshot = provider.GetAWSCredentialsSnapshot();
+    ASSERT_EQ("accessKey", snapshot->GetAWSAccessKeyId());
+    ASSERT_EQ("secretKey", snapshot->GetAWSSecretKey());
+    ASSERT_EQ("sessionToken", snapshot->GetSessionToken());
+    ASSERT_EQ(snapshot, provider.GetAWSCredentialsSnapshot());
+    ASSERT_EQ(1u, provider.GetAWSCredentialsVersion());
+    ASSERT_TRUE(*snapshot == provider.GetAWSCredentials());
+}
+
+TEST(InstanceProfileCredentialsProviderTest, TestRefreshPublishesNewSnapshot)
+{
+    auto mockClient = Aws::MakeShared<MockEC2MetadataClient>(AllocationTag);
+
+    const char* validCredentials = "{ \"AccessKeyId\": \"goodAccessKey\", \"SecretAccessKey\": \"goodSecretKey\", \"Token\": \"goodToken\" }";
+    mockClient->SetMockedCredentialsValue(validCredentials);
+
+    InstanceProfileCredentialsProvider provider(Aws::MakeShared<Aws::Config::EC2InstanceProfileConfigLoader>(AllocationTag, mockClient), 10);
+    auto snapshot = provider.GetAWSCredentialsSnapshot();
+    ASSERT_EQ("goodAccessKey", snapshot->GetAWSAccessKeyId());
+    auto version = provider.GetAWSCredentialsVersion();
+
+    const char* nextSetOfCredentials = "{ \"AccessKeyId\": \"betterAccessKey\", \"SecretAccessKey\": \"betterSecretKey\", \"Token\": \"betterToken\" }";
+    mockClient->SetMockedCredentialsValue(nextSetOfCredentials);
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    auto nextSnapshot = provider.GetAWSCredentialsSnapshot();
+    ASSERT_EQ("betterAccessKey", nextSnapshot->GetAWSAccessKeyId());
+    ASSERT_LT(version, provider.GetAWSCredentialsVersion());
+    ASSERT_EQ("goodAccessKey", snapshot->GetAWSAccessKeyId());
+}
+
+TEST(InstanceProfileCredentialsProviderTest, TestCallersKeepCredentialsWhileRefreshIsInFlight)
+{
+    auto mockClient = Aws::MakeShared<MockEC2MetadataClient>(AllocationTag);
+
+    const char* validCredentials = "{ \"AccessKeyId\": \"goodAccessKey\", \"SecretAccessKey\": \"goodSecretKey\", \"Token\": \"goodToken\" }";
+    mockClient->SetMockedCredentialsValue(validCredentials);
+
+    InstanceProfileCredentialsProvider provider(Aws::MakeShared<Aws::Config::EC2InstanceProfileConfigLoader>(AllocationTag, mockClient), 10);
+    ASSERT_EQ("goodAccessKey", provider.GetAWSCredentials().GetAWSAccessKeyId());
+    ASSERT_EQ(1u, mockClient->GetRequestCount());
+
+    const char* nextSetOfCredentials = "{ \"AccessKeyId\": \"betterAccessKey\", \"SecretAccessKey\": \"betterSecretKey\", \"Token\": \"betterToken\" }";
+    mockClient->SetMockedCredentialsValue(nextSetOfCredentials);
+    mockClient->HoldRequests();
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    AWSCredentials refreshedCredentials;
+    std::thread refresher([&] { refreshedCredentials = provider.GetAWSCredentials(); });
+    mockClient->WaitForRequests(2);
+
+    //the refresh is stuck at the endpoint, everybody else keeps going with the credentials they had.
+    EXPECT_EQ("goodAccessKey", provider.GetAWSCredentials().GetAWSAccessKeyId());
+    EXPECT_EQ(2u, mockClient->GetRequestCount());
+
+    mockClient->ReleaseRequests();
+    refresher.join();
+    ASSERT_EQ("betterAccessKey", refreshedCredentials.GetAWSAccessKeyId());
+    ASSERT_EQ("betterAccessKey", provider.GetAWSCredentials().GetAWSAccessKeyId());
+}
+
+TEST(InstanceProfileCredentialsProviderTest, TestBackgroundRefreshRunsAheadOfCallers)
+{
+    auto mockClient = Aws::MakeShared<MockEC2MetadataClient>(AllocationTag);
+
+    const char* validCredentials = "{ \"AccessKeyId\": \"goodAccessKey\", \"SecretAccessKey\": \"goodSecretKey\", \"Token\": \"goodToken\" }";
+    mockClient->SetMockedCredentialsValue(validCredentials);
+
+    auto scheduler = Aws::MakeShared<AWSCredentialsRefreshScheduler>(AllocationTag);
+    InstanceProfileCredentialsProvider provider(Aws::MakeShared<Aws::Config::EC2InstanceProfileConfigLoader>(AllocationTag, mockClient), 1000);
+    provider.EnableBackgroundRefresh(scheduler, 500);
+    //the first pull is started by the scheduler, callers wait for it.
+    mockClient->WaitForRequests(1);
+
+    ASSERT_EQ("goodAccessKey", provider.GetAWSCredentials().GetAWSAccessKeyId());
+    ASSERT_EQ(1u, mockClient->GetRequestCount());
+    ASSERT_NE(std::this_thread::get_id(), mockClient->GetLastRequestThread());
+
+    const char* nextSetOfCredentials = "{ \"AccessKeyId\": \"betterAccessKey\", \"SecretAccessKey\": \"betterSecretKey\", \"Token\": \"betterToken\" }";
+    mockClient->SetMockedCredentialsValue(nextSetOfCredentials);
+    mockClient->HoldRequests();
+
+    //the scheduler pulls the next credentials half way into the refresh period, well before callers would.
+    mockClient->WaitForRequests(2);
+    EXPECT_NE(std::this_thread::get_id(), mockClient->GetLastRequestThread());
+    EXPECT_EQ("goodAccessKey", provider.GetAWSCredentials().GetAWSAccessKeyId());
+    mockClient->ReleaseRequests();
+
+    for (unsigned i = 0; i < 500 && provider.GetAWSCredentials().GetAWSAccessKeyId() != "betterAccessKey"; ++i)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    ASSERT_EQ("betterAccessKey", provider.GetAWSCredentials().GetAWSAccessKeyId());
+    ASSERT_EQ("betterSecretKey", provider.GetAWSCredentials().GetAWSSecretKey());
+
+    provider.DisableBackgroundRefresh();
+    auto requestCount = mockClient->GetRequestCount();
+    ASSERT_EQ("betterAccessKey", provider.GetAWSCredentials().GetAWSAccessKeyId());
+    ASSERT_EQ(requestCount, mockClient->GetRequestCount());
+}
+
 TEST(InstanceProfileCredentialsProviderTest, TestEC2MetadataClientCouldntFindCredentials)
 {
     auto mockClient = Aws::MakeShared<MockEC2MetadataClient>(AllocationTag);
@@ -18,6 +18,7 @@
 #include <aws/core/client/AWSError.h>
 #include <aws/core/client/ClientConfiguration.h>
 #include <aws/core/client/DefaultRetryStrategy.h>
+#include <aws/core/client/RequestMetrics.h>
 #include <aws/core/AmazonWebServiceRequest.h>
 #include <aws/core/auth/AWSAuthSigner.h>
 #include <aws/core/auth/AWSCredentialsProvider.h>
@@ -48,9 +49,9 @@ public:
     }
 
     void InvokeBuildHttpRequest(const AmazonWebServiceRequest& request,
-        const std::shared_ptr<HttpRequest>& httpRequest) const
+        const std::shared_ptr<HttpRequest>& httpRequest, bool hashPayload = false) const
     {
-        BuildHttpRequest(request, httpRequest);
+        BuildHttpRequest(request, httpRequest, hashPayload);
     }
 
 protected:
@@ -100,6 +101,35 @@ private:
     mutable int m_attemptedRetries;
 };
 
+class QuotaHookRecordingRetryStrategy : public CountedRetryStrategy
+{
+public:
+    QuotaHookRecordingRetryStrategy() : m_sendTokens(0), m_bookkeepingCalls(0), m_retriedBookkeepingCalls(0) {}
+    void GetSendToken() override { ++m_sendTokens; }
+    void RequestBookkeeping(const HttpResponseOutcome&) override { ++m_bookkeepingCalls; }
+    void RequestBookkeeping(const HttpResponseOutcome&, const AWSError<CoreErrors>&) override { ++m_retriedBookkeepingCalls; }
+    int m_sendTokens;
+    int m_bookkeepingCalls;
+    int m_retriedBookkeepingCalls;
+};
+
+class RecordingRequestMetricsCollector : public RequestMetricsCollector
+{
+public:
+    void OnAttemptCompleted(const RequestAttemptMetrics& metrics) override { m_attempts.push_back(metrics); }
+    Aws::Vector<RequestAttemptMetrics> m_attempts;
+};
+
+class FailingSigner : public Aws::Client::AWSAuthSigner
+{
+public:
+    bool SignRequest(HttpRequest&) const override { return false; }
+    bool PresignRequest(HttpRequest&, long long) const override { return false; }
+    bool PresignRequest(HttpRequest&, const char*, long long) const override { return false; }
+    bool PresignRequest(HttpRequest&, const char*, const char*, long long) const override { return false; }
+    const char* GetName() const override { return Aws::Auth::SIGV4_SIGNER; }
+};
+
 class MockAWSClient : AWSClient
 {
     using DateTime = Aws::Utils::DateTime;
@@ -112,6 +142,9 @@ public:
                     "wJalrXUtnFEMI/K7MDENG+bPxRfiCYEXAMPLEKEY"), "service", "us-east-1"), nullptr) , 
         m_countedRetryStrategy(std::static_pointer_cast<CountedRetryStrategy>(config.retryStrategy)) { }
 
+    MockAWSClient(const ClientConfiguration& config, const std::shared_ptr<Aws::Client::AWSAuthSigner>& signer) : AWSClient(config, signer, nullptr),
+        m_countedRetryStrategy(std::static_pointer_cast<CountedRetryStrategy>(config.retryStrategy)) { }
+
     Aws::Client::HttpResponseOutcome MakeRequest(const AmazonWebServiceRequest& request)
     {
         m_countedRetryStrategy->ResetAttemptedRetriesCount();
@@ -121,6 +154,20 @@ public:
         return httpOutcome;
     }
 
+    Aws::Client::HttpResponseOutcome MakeRequestAsync(const std::shared_ptr<const AmazonWebServiceRequest>& request)
+    {
+        m_countedRetryStrategy->ResetAttemptedRetriesCount();
+        const URI uri("domain.com/something");
+        const auto method = HttpMethod::HTTP_GET;
+        std::shared_ptr<HttpResponseOutcome> httpOutcome;
+        AWSClient::AttemptExhaustivelyAsync(uri, request, method, Aws::Auth::SIGV4_SIGNER, [&httpOutcome](const HttpResponseOutcome& outcome)
+        {
+            httpOutcome = Aws::MakeShared<HttpResponseOutcome>(ALLOCATION_TAG, outcome);
+        });
+        // the mock http client completes inline, so the handler must have been called by now.
+        return httpOutcome ? *httpOutcome : HttpResponseOutcome(AWSError<CoreErrors>(CoreErrors::UNKNOWN, false));
+    }
+
     int GetRequestAttemptedRetries()
     {
         return m_countedRetryStrategy->GetAttemptedRetriesCount();
@@ -282,6 +329,155 @@ TEST_F(AWSClientTestSuite, TestClockChangesAfterSkewHasBeenSet)
     ASSERT_EQ(1, client->GetRequestAttemptedRetries());
 }
 
+TEST_F(AWSClientTestSuite, TestAsyncAttemptRetriesOnClockSkew)
+{
+    HeaderValueCollection responseHeaders, requestHeaders;
+    responseHeaders.emplace("Date", (DateTime::Now() + std::chrono::hours(1)).ToGmtString(DateFormat::RFC822)); // server is ahead of us by 1 hour
+    auto request = Aws::MakeShared<AmazonWebServiceRequestMock>(ALLOCATION_TAG);
+    requestHeaders.emplace("X-Amz-Date", DateTime::Now().ToGmtString(DateFormat::ISO_8601));
+    request->SetHeaders(requestHeaders);
+    QueueMockResponse(HttpResponseCode::BAD_REQUEST, responseHeaders);
+    QueueMockResponse(HttpResponseCode::BAD_REQUEST, responseHeaders);
+    auto outcome = client->MakeRequestAsync(request);
+    ASSERT_FALSE(outcome.IsSuccess());
+    ASSERT_EQ(HttpResponseCode::BAD_REQUEST, outcome.GetError().GetResponseCode());
+    ASSERT_EQ(1, client->GetRequestAttemptedRetries());
+}
+
+TEST_F(AWSClientTestSuite, TestAsyncAttemptSucceeds)
+{
+    HeaderValueCollection responseHeaders;
+    responseHeaders.emplace("x-amz-request-id", "abc123");
+    auto request = Aws::MakeShared<AmazonWebServiceRequestMock>(ALLOCATION_TAG);
+    QueueMockResponse(HttpResponseCode::OK, responseHeaders);
+    auto outcome = client->MakeRequestAsync(request);
+    ASSERT_TRUE(outcome.IsSuccess());
+    ASSERT_EQ(HttpResponseCode::OK, outcome.GetResult()->GetResponseCode());
+    ASSERT_EQ("abc123", outcome.GetResult()->GetHeader("x-amz-request-id"));
+    ASSERT_EQ(0, client->GetRequestAttemptedRetries());
+}
+
+TEST_F(AWSClientTestSuite, TestAsyncAttemptReportsSigningFailure)
+{
+    ClientConfiguration config;
+    config.scheme = Scheme::HTTP;
+    config.retryStrategy = Aws::MakeShared<CountedRetryStrategy>(ALLOCATION_TAG);
+    MockAWSClient failingClient(config, Aws::MakeShared<FailingSigner>(ALLOCATION_TAG));
+
+    auto outcome = failingClient.MakeRequestAsync(Aws::MakeShared<AmazonWebServiceRequestMock>(ALLOCATION_TAG));
+    ASSERT_FALSE(outcome.IsSuccess());
+    ASSERT_EQ(CoreErrors::CLIENT_SIGNING_FAILURE, outcome.GetError().GetErrorType());
+    ASSERT_EQ(0u, mockHttpClient->GetAllRequestsMade().size());
+}
+
+TEST_F(AWSClientTestSuite, TestRetrySleepAsyncCancelledWhenProcessingDisabled)
+{
+    bool invoked = false;
+    bool cancelled = false;
+    mockHttpClient->DisableRequestProcessing();
+    // must not sleep at all once processing is disabled.
+    mockHttpClient->RetryRequestSleepAsync(std::chrono::hours(1), [&invoked, &cancelled](bool wasCancelled)
+    {
+        invoked = true;
+        cancelled = wasCancelled;
+    });
+    mockHttpClient->EnableRequestProcessing();
+    ASSERT_TRUE(invoked);
+    ASSERT_TRUE(cancelled);
+}
+
+TEST_F(AWSClientTestSuite, TestRequestMetricsReportedPerAttempt)
+{
+    ClientConfiguration config;
+    config.scheme = Scheme::HTTP;
+    config.retryStrategy = Aws::MakeShared<CountedRetryStrategy>(ALLOCATION_TAG);
+    auto recorder = Aws::MakeShared<RecordingRequestMetricsCollector>(ALLOCATION_TAG);
+    config.requestMetricsCollector = recorder;
+    MockAWSClient metricsClient(config);
+
+    HeaderValueCollection responseHeaders, requestHeaders;
+    responseHeaders.emplace("Date", (DateTime::Now() + std::chrono::hours(1)).ToGmtString(DateFormat::RFC822)); // server is ahead of us by 1 hour
+    AmazonWebServiceRequestMock request;
+    requestHeaders.emplace("X-Amz-Date", DateTime::Now().ToGmtString(DateFormat::ISO_8601));
+    request.SetHeaders(requestHeaders);
+    QueueMockResponse(HttpResponseCode::BAD_REQUEST, responseHeaders);
+    QueueMockResponse(HttpResponseCode::OK, HeaderValueCollection());
+    auto outcome = metricsClient.MakeRequest(request);
+    ASSERT_TRUE(outcome.IsSuccess());
+
+    ASSERT_EQ(2u, recorder->m_attempts.size());
+    for (size_t i = 0; i < recorder->m_attempts.size(); ++i)
+    {
+        const RequestAttemptMetrics& attempt = recorder->m_attempts[i];
+        ASSERT_EQ(static_cast<long>(i), attempt.attempt);
+        ASSERT_STREQ("AmazonWebServiceRequestMock", attempt.requestName);
+        ASSERT_STREQ("service", attempt.serviceName);
+        ASSERT_GE(attempt.totalTime, attempt.signingTime);
+    }
+    ASSERT_EQ(HttpResponseCode::BAD_REQUEST, recorder->m_attempts[0].responseCode);
+    ASSERT_FALSE(recorder->m_attempts[0].success);
+    ASSERT_EQ(HttpResponseCode::OK, recorder->m_attempts[1].responseCode);
+    ASSERT_TRUE(recorder->m_attempts[1].success);
+
+    //with no collector configured nothing is recorded.
+    QueueMockResponse(HttpResponseCode::OK, HeaderValueCollection());
+    ASSERT_TRUE(client->MakeRequest(request).IsSuccess());
+    ASSERT_EQ(2u, recorder->m_attempts.size());
+}
+
+TEST_F(AWSClientTestSuite, TestRetryQuotaHooksCalledPerAttempt)
+{
+    ClientConfiguration config;
+    config.scheme = Scheme::HTTP;
+    auto retryStrategy = Aws::MakeShared<QuotaHookRecordingRetryStrategy>(ALLOCATION_TAG);
+    config.retryStrategy = retryStrategy;
+    MockAWSClient quotaClient(config);
+
+    HeaderValueCollection responseHeaders, requestHeaders;
+    responseHeaders.emplace("Date", (DateTime::Now() + std::chrono::hours(1)).ToGmtString(DateFormat::RFC822)); // server is ahead of us by 1 hour
+    AmazonWebServiceRequestMock request;
+    requestHeaders.emplace("X-Amz-Date", DateTime::Now().ToGmtString(DateFormat::ISO_8601));
+    request.SetHeaders(requestHeaders);
+    QueueMockResponse(HttpResponseCode::BAD_REQUEST, responseHeaders);
+    QueueMockResponse(HttpResponseCode::OK, HeaderValueCollection());
+    ASSERT_TRUE(quotaClient.MakeRequest(request).IsSuccess());
+
+    //a send token for every attempt, the failed attempt is booked as a retried error and the successful one as a success.
+    ASSERT_EQ(2, retryStrategy->m_sendTokens);
+    ASSERT_EQ(1, retryStrategy->m_bookkeepingCalls);
+    ASSERT_EQ(1, retryStrategy->m_retriedBookkeepingCalls);
+}
+
+TEST(AWSClientTest, TestHistogramRequestMetricsCollector)
+{
+    auto collector = Aws::MakeShared<HistogramRequestMetricsCollector>(ALLOCATION_TAG);
+    RequestAttemptMetrics metrics;
+    metrics.signingTime = std::chrono::microseconds(40);
+    metrics.transferMetrics.timeToFirstByte = std::chrono::microseconds(2000);
+    metrics.transferMetrics.bytesReceived = 100;
+    metrics.totalTime = std::chrono::microseconds(2500);
+    collector->OnAttemptCompleted(metrics);
+
+    metrics.attempt = 1;
+    metrics.success = true;
+    metrics.retrySleepTime = std::chrono::microseconds(50000);
+    collector->OnAttemptCompleted(metrics);
+
+    ASSERT_EQ(2u, collector->GetAttemptCount());
+    ASSERT_EQ(1u, collector->GetFailedAttemptCount());
+    ASSERT_EQ(1u, collector->GetRetryCount());
+    ASSERT_EQ(200u, collector->GetBytesReceived());
+    ASSERT_EQ(1u, collector->GetHistogram(RequestMetricsPhase::RETRY_SLEEP).GetCount());
+    ASSERT_EQ(50000, collector->GetHistogram(RequestMetricsPhase::RETRY_SLEEP).GetMax());
+    ASSERT_EQ(40, collector->GetHistogram(RequestMetricsPhase::SIGNING).GetValueAtPercentile(99));
+    ASSERT_EQ(2000, collector->GetHistogram(RequestMetricsPhase::TIME_TO_FIRST_BYTE).GetValueAtPercentile(50));
+    ASSERT_EQ(2u, collector->GetHistogram(RequestMetricsPhase::TOTAL).GetCount());
+
+    collector->Reset();
+    ASSERT_EQ(0u, collector->GetAttemptCount());
+    ASSERT_EQ(0u, collector->GetHistogram(RequestMetricsPhase::TOTAL).GetCount());
+}
+
 TEST(AWSClientTest, TestBuildHttpRequestWithHeadersOnly)
 {
     HeaderValueCollection headerValues;
@@ -352,7 +548,7 @@ TEST(AWSClientTest, TestBuildHttpRequestWithHeadersAndBody)
 
     //content-length should be added if body is set. If it is not there is should be added.
     AccessViolatingAWSClient awsClient;
-    awsClient.InvokeBuildHttpRequest(amazonWebServiceRequest, httpRequest);
+    awsClient.InvokeBuildHttpRequest(amazonWebServiceRequest, httpRequest, true);
 
     ASSERT_TRUE(httpRequest->HasHeader("test1"));
     ASSERT_TRUE(httpRequest->HasHeader("test2"));
@@ -374,4 +570,13 @@ TEST(AWSClientTest, TestBuildHttpRequestWithHeadersAndBody)
     Aws::StringStream contentLengthExpected;
     contentLengthExpected << ss->str().length();
     ASSERT_EQ(contentLengthExpected.str(), finalHeaders[Http::CONTENT_LENGTH_HEADER]);  
+
+    //the payload sha256 is computed in the same pass as the md5 and kept for the signer.
+    ASSERT_EQ(Utils::HashingUtils::CalculateSHA256(*ss), httpRequest->GetContentBodyDigest(Utils::Crypto::DigestAlgorithm::SHA256));
+
+    //but not when the signer won't hash the body, such as for an unsigned payload over https.
+    auto unsignedPayloadRequest = Aws::MakeShared<Standard::StandardHttpRequest>(ALLOCATION_TAG, uri, HttpMethod::HTTP_GET);
+    awsClient.InvokeBuildHttpRequest(amazonWebServiceRequest, unsignedPayloadRequest);
+    ASSERT_EQ(hashResult, unsignedPayloadRequest->GetHeaderValue(Http::CONTENT_MD5_HEADER));
+    ASSERT_EQ(0u, unsignedPayloadRequest->GetContentBodyDigest(Utils::Crypto::DigestAlgorithm::SHA256).GetLength());
 }
@@ -0,0 +1,150 @@
+/*
+* Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+*
+* Licensed under the Apache License, Version 2.0 (the "License").
+* You may not use this file except in compliance with the License.
+* A copy of the License is located at
+*
+*  http://aws.amazon.com/apache2.0
+*
+* or in the "license" file accompanying this file. This file is distributed
+* on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+* express or implied. See the License for the specific language governing
+* permissions and limitations under the License.
+*/
+
+#include <aws/external/gtest.h>
+#include <aws/core/client/AdaptiveRetryStrategy.h>
+#include <aws/core/client/StandardRetryStrategy.h>
+#include <aws/core/client/AWSError.h>
+#include <aws/core/client/CoreErrors.h>
+#include <aws/core/http/HttpResponse.h>
+#include <aws/core/utils/Outcome.h>
+#include <aws/core/utils/memory/stl/AWSSet.h>
+
+using namespace Aws::Client;
+using namespace Aws::Http;
+
+static const char* ALLOCATION_TAG = "RetryStrategyTest";
+
+TEST(RetryStrategyTest, TestFullJitterStaysWithinBackoff)
+{
+    StandardRetryStrategy strategy(10, 25, 1000);
+    AWSError<CoreErrors> error(CoreErrors::SERVICE_UNAVAILABLE, true);
+
+    for (long retries = 0; retries < 10; ++retries)
+    {
+        long ceiling = (std::min)(25L << retries, 1000L);
+        Aws::Set<long> delays;
+        for (int i = 0; i < 200; ++i)
+        {
+            long delay = strategy.CalculateDelayBeforeNextRetry(error, retries);
+            ASSERT_GE(delay, 0);
+            ASSERT_LE(delay, ceiling);
+            delays.insert(delay);
+        }
+        //jittered, not lockstep.
+        ASSERT_GT(delays.size(), 10u);
+    }
+}
+
+TEST(RetryStrategyTest, TestRetryQuotaIsSpentAndRefunded)
+{
+    auto quota = Aws::MakeShared<DefaultRetryQuotaContainer>(ALLOCATION_TAG, 12, 5, 10);
+    StandardRetryStrategy strategy(quota, 10);
+    AWSError<CoreErrors> throttled(CoreErrors::THROTTLING, true);
+    AWSError<CoreErrors> timedOut(CoreErrors::NETWORK_CONNECTION, true);
+
+    ASSERT_FALSE(strategy.ShouldRetry(AWSError<CoreErrors>(CoreErrors::VALIDATION, false), 0));
+    ASSERT_EQ(12, quota->GetRetryQuota());
+
+    ASSERT_TRUE(strategy.ShouldRetry(throttled, 0));
+    ASSERT_TRUE(strategy.ShouldRetry(throttled, 1));
+    ASSERT_EQ(2, quota->GetRetryQuota());
+    ASSERT_FALSE(strategy.ShouldRetry(throttled, 2));
+    ASSERT_EQ(2, quota->GetRetryQuota());
+
+    std::shared_ptr<HttpResponse> response;
+    strategy.RequestBookkeeping(HttpResponseOutcome(response), throttled);
+    ASSERT_EQ(7, quota->GetRetryQuota());
+    strategy.RequestBookkeeping(HttpResponseOutcome(response));
+    ASSERT_EQ(8, quota->GetRetryQuota());
+    ASSERT_FALSE(strategy.ShouldRetry(timedOut, 0));
+
+    //failures refund nothing and the quota never grows past where it started.
+    strategy.RequestBookkeeping(HttpResponseOutcome(throttled), throttled);
+    ASSERT_EQ(8, quota->GetRetryQuota());
+    quota->ReleaseRetryQuota(100);
+    ASSERT_EQ(12, quota->GetRetryQuota());
+    ASSERT_TRUE(strategy.ShouldRetry(timedOut, 0));
+    ASSERT_EQ(2, quota->GetRetryQuota());
+
+    StandardRetryStrategy limitedStrategy(1);
+    ASSERT_TRUE(limitedStrategy.ShouldRetry(throttled, 0));
+    ASSERT_FALSE(limitedStrategy.ShouldRetry(throttled, 1));
+}
+
+TEST(RetryStrategyTest, TestThrottlingErrorDetection)
+{
+    ASSERT_TRUE(AdaptiveRetryStrategy::IsThrottlingError(AWSError<CoreErrors>(CoreErrors::THROTTLING, true)));
+    ASSERT_TRUE(AdaptiveRetryStrategy::IsThrottlingError(AWSError<CoreErrors>(CoreErrors::SLOW_DOWN, true)));
+    ASSERT_TRUE(AdaptiveRetryStrategy::IsThrottlingError(
+        AWSError<CoreErrors>(CoreErrors::SERVICE_EXTENSION_START_RANGE, "ProvisionedThroughputExceededException", "", true)));
+    AWSError<CoreErrors> tooManyRequests(CoreErrors::UNKNOWN, false);
+    tooManyRequests.SetResponseCode(HttpResponseCode::TOO_MANY_REQUESTS);
+    ASSERT_TRUE(AdaptiveRetryStrategy::IsThrottlingError(tooManyRequests));
+
+    ASSERT_FALSE(AdaptiveRetryStrategy::IsThrottlingError(AWSError<CoreErrors>(CoreErrors::SERVICE_UNAVAILABLE, true)));
+    ASSERT_FALSE(AdaptiveRetryStrategy::IsThrottlingError(AWSError<CoreErrors>(CoreErrors::UNKNOWN, "ValidationException", "", false)));
+}
+
+TEST(RetryStrategyTest, TestTokenBucketFollowsThrottling)
+{
+    RetryTokenBucket bucket;
+    auto start = std::chrono::steady_clock::now();
+    ASSERT_FALSE(bucket.IsEnabled());
+    ASSERT_TRUE(bucket.Acquire(1, true));
+
+    //10 requests a second for 5 seconds, all successful.
+    for (int i = 1; i <= 50; ++i)
+    {
+        bucket.UpdateClientSendingRate(false, start + std::chrono::milliseconds(100 * i));
+    }
+    ASSERT_FALSE(bucket.IsEnabled());
+    ASSERT_NEAR(10.0, bucket.GetMeasuredSendRate(), 1.0);
+
+    bucket.UpdateClientSendingRate(true, start + std::chrono::milliseconds(5100));
+    ASSERT_TRUE(bucket.IsEnabled());
+    double throttledRate = bucket.GetFillRate();
+    ASSERT_NEAR(0.7 * bucket.GetMeasuredSendRate(), throttledRate, 1.0);
+
+    //a second throttle cuts the rate further.
+    bucket.UpdateClientSendingRate(true, start + std::chrono::milliseconds(5200));
+    ASSERT_LT(bucket.GetFillRate(), throttledRate);
+    double twiceThrottledRate = bucket.GetFillRate();
+
+    //after a quiet period successes grow it back.
+    for (int i = 1; i <= 20; ++i)
+    {
+        bucket.UpdateClientSendingRate(false, start + std::chrono::milliseconds(8000 + 100 * i));
+    }
+    ASSERT_GT(bucket.GetFillRate(), twiceThrottledRate);
+}
+
+TEST(RetryStrategyTest, TestAdaptiveStrategyLimitsSendRate)
+{
+    AdaptiveRetryStrategy strategy;
+    AWSError<CoreErrors> throttled(CoreErrors::THROTTLING, true);
+    ASSERT_TRUE(strategy.HasSendToken());
+
+    strategy.RequestBookkeeping(HttpResponseOutcome(throttled));
+    ASSERT_TRUE(strategy.GetRetryTokenBucket().IsEnabled());
+
+    //with nothing measured yet the rate drops to the floor, so the bucket is soon empty.
+    bool ranDry = false;
+    for (int i = 0; i < 10 && !ranDry; ++i)
+    {
+        ranDry = !strategy.HasSendToken();
+    }
+    ASSERT_TRUE(ranDry);
+}
@@ -0,0 +1,130 @@
+/*
+  * Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+  * 
+  * Licensed under the Apache License, Version 2.0 (the "License").
+  * You may not use this file except in compliance with the License.
+  * A copy of the License is located at
+  * 
+  *  http://aws.amazon.com/apache2.0
+  * 
+  * or in the "license" file accompanying this file. This file is distributed
+  * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+  * express or implied. See the License for the specific language governing
+  * permissions and limitations under the License.
+  */
+
+#ifdef ENABLE_CURL_CLIENT
+
+#include <aws/external/gtest.h>
+#include <aws/core/http/curl/CurlHandleContainer.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+using namespace Aws::Http;
+
+TEST(CurlHandleContainerTest, ReusesIdleHandleOfSameEndpoint)
+{
+    CurlHandleContainer container(4);
+    CURL* handle = container.AcquireCurlHandle("s3.amazonaws.com:443");
+    ASSERT_NE(nullptr, handle);
+    container.ReleaseCurlHandle(handle, "s3.amazonaws.com:443");
+
+    ASSERT_EQ(handle, container.AcquireCurlHandle("s3.amazonaws.com:443"));
+    ASSERT_EQ(1u, container.GetHitCount());
+    ASSERT_EQ(1u, container.GetMissCount());
+    ASSERT_EQ(1u, container.GetPoolSize());
+    container.ReleaseCurlHandle(handle, "s3.amazonaws.com:443");
+}
+
+TEST(CurlHandleContainerTest, PrefersNewHandleOverIdleHandleOfOtherEndpoint)
+{
+    CurlHandleContainer container(4);
+    CURL* s3Handle = container.AcquireCurlHandle("s3.amazonaws.com:443");
+    container.ReleaseCurlHandle(s3Handle, "s3.amazonaws.com:443");
+
+    CURL* dynamoHandle = container.AcquireCurlHandle("dynamodb.us-east-1.amazonaws.com:443");
+    ASSERT_NE(s3Handle, dynamoHandle);
+    ASSERT_EQ(0u, container.GetHitCount());
+    ASSERT_EQ(2u, container.GetMissCount());
+    ASSERT_EQ(2u, container.GetPoolSize());
+    container.ReleaseCurlHandle(dynamoHandle, "dynamodb.us-east-1.amazonaws.com:443");
+}
+
+TEST(CurlHandleContainerTest, RepurposesIdleHandleOfOtherEndpointAtMaxSize)
+{
+    CurlHandleContainer container(1);
+    CURL* s3Handle = container.AcquireCurlHandle("s3.amazonaws.com:443");
+    container.ReleaseCurlHandle(s3Handle, "s3.amazonaws.com:443");
+
+    ASSERT_EQ(s3Handle, container.AcquireCurlHandle("dynamodb.us-east-1.amazonaws.com:443"));
+    ASSERT_EQ(2u, container.GetMissCount());
+    ASSERT_EQ(1u, container.GetPoolSize());
+    container.ReleaseCurlHandle(s3Handle, "dynamodb.us-east-1.amazonaws.com:443");
+}
+
+TEST(CurlHandleContainerTest, BlocksUntilHandleIsReleased)
+{
+    CurlHandleContainer container(1);
+    CURL* handle = container.AcquireCurlHandle();
+
+    std::atomic<CURL*> acquired(nullptr);
+    std::thread waiter([&]() { acquired = container.AcquireCurlHandle(); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    ASSERT_EQ(nullptr, acquired.load());
+
+    container.ReleaseCurlHandle(handle);
+    waiter.join();
+    ASSERT_EQ(handle, acquired.load());
+    container.ReleaseCurlHandle(handle);
+}
+
+TEST(CurlHandleContainerTest, EvictsIdleHandles)
+{
+    //long enough that releasing the second handle can't already evict the first on a loaded machine.
+    CurlHandleContainer container(4, 3000, 1000, 200);
+    CURL* first = container.AcquireCurlHandle("s3.amazonaws.com:443");
+    CURL* second = container.AcquireCurlHandle("s3.amazonaws.com:443");
+    container.ReleaseCurlHandle(first, "s3.amazonaws.com:443");
+    container.ReleaseCurlHandle(second, "s3.amazonaws.com:443");
+    ASSERT_EQ(2u, container.GetPoolSize());
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(250));
+    ASSERT_EQ(2u, container.EvictIdleHandles());
+    ASSERT_EQ(2u, container.GetEvictionCount());
+    ASSERT_EQ(0u, container.GetPoolSize());
+}
+
+TEST(CurlHandleContainerTest, KeepsIdleHandlesWithoutIdleTimeout)
+{
+    CurlHandleContainer container(4, 3000, 1000, 0);
+    CURL* handle = container.AcquireCurlHandle();
+    container.ReleaseCurlHandle(handle);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    ASSERT_EQ(0u, container.EvictIdleHandles());
+    ASSERT_EQ(1u, container.GetPoolSize());
+}
+
+TEST(CurlHandleContainerTest, WarmupConnectsDistinctHandlesUpToMaxSize)
+{
+    CurlHandleContainer container(4);
+    std::atomic<unsigned> connectCalls(0);
+    ASSERT_EQ(4u, container.Warmup("s3.amazonaws.com:443", 8, [&](CURL*) { ++connectCalls; return true; }));
+    ASSERT_EQ(4u, connectCalls.load());
+    ASSERT_EQ(4u, container.GetPoolSize());
+
+    CURL* handles[4];
+    for (auto& handle : handles)
+    {
+        handle = container.AcquireCurlHandle("s3.amazonaws.com:443");
+    }
+    ASSERT_EQ(4u, container.GetHitCount());
+
+    for (auto handle : handles)
+    {
+        container.ReleaseCurlHandle(handle, "s3.amazonaws.com:443");
+    }
+}
+
+#endif // ENABLE_CURL_CLIENT
@@ -0,0 +1,365 @@
+/*
+  * Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+  *
+  * Licensed under the Apache License, Version 2.0 (the "License").
+  * You may not use this file except in compliance with the License.
+  * A copy of the License is located at
+  *
+  *  http://aws.amazon.com/apache2.0
+  *
+  * or in the "license" file accompanying this file. This file is distributed
+  * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+  * express or implied. See the License for the specific language governing
+  * permissions and limitations under the License.
+  */
+
+#if defined(ENABLE_CURL_CLIENT) && !defined(_WIN32)
+
+#include <aws/external/gtest.h>
+#include <aws/core/client/ClientConfiguration.h>
+#include <aws/core/http/HttpClientFactory.h>
+#include <aws/core/http/HttpResponse.h>
+#include <aws/core/http/curl/CurlMultiHttpClient.h>
+#include <aws/core/utils/StringUtils.h>
+#include <aws/core/utils/memory/stl/AWSStringStream.h>
+#include <aws/core/utils/memory/stl/AWSVector.h>
+#include <aws/core/utils/ratelimiter/DefaultRateLimiter.h>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <thread>
+
+using namespace Aws::Client;
+using namespace Aws::Http;
+using namespace Aws::Utils;
+
+// http server on a loopback port, each connection is served on its own thread and gets one response:
+//   /delay/<ms>[/...]  the path as body, after ms milliseconds
+//   /bytes/<n>         n bytes of body
+//   /hang              nothing until the server is stopped
+class LoopbackHttpServer
+{
+public:
+    LoopbackHttpServer() : m_listenSocket(socket(AF_INET, SOCK_STREAM, 0)), m_port(0), m_stopped(false), m_requestsReceived(0)
+    {
+        int reuse = 1;
+        setsockopt(m_listenSocket, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+        struct sockaddr_in address = {};
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        address.sin_port = 0;
+        socklen_t addressLength = sizeof(address);
+        if (bind(m_listenSocket, reinterpret_cast<struct sockaddr*>(&address), addressLength) == 0 && listen(m_listenSocket, 128) == 0 &&
+            getsockname(m_listenSocket, reinterpret_cast<struct sockaddr*>(&address), &addressLength) == 0)
+        {
+            m_port = ntohs(address.sin_port);
+        }
+
+        m_acceptThread = std::thread([this]() { AcceptConnections(); });
+    }
+
+    ~LoopbackHttpServer()
+    {
+        Stop();
+    }
+
+    void Stop()
+    {
+        {
+            std::lock_guard<std::mutex> locker(m_lock);
+            if (m_stopped)
+            {
+                return;
+            }
+            m_stopped = true;
+        }
+        m_signal.notify_all();
+
+        shutdown(m_listenSocket, SHUT_RDWR);
+        m_acceptThread.join();
+        close(m_listenSocket);
+        for (auto& connectionThread : m_connectionThreads)
+        {
+            connectionThread.join();
+        }
+    }
+
+    Aws::String GetUrl(const Aws::String& path) const
+    {
+        return "http://127.0.0.1:" + StringUtils::to_string(m_port) + path;
+    }
+
+    bool WaitForRequests(size_t count, std::chrono::milliseconds timeout)
+    {
+        std::unique_lock<std::mutex> locker(m_lock);
+        return m_signal.wait_for(locker, timeout, [this, count]() { return m_requestsReceived >= count; });
+    }
+
+private:
+    void AcceptConnections()
+    {
+        for (;;)
+        {
+            int connection = accept(m_listenSocket, nullptr, nullptr);
+            if (connection < 0)
+            {
+                return;
+            }
+
+            m_connectionThreads.emplace_back([this, connection]() { Serve(connection); });
+        }
+    }
+
+    void Serve(int connection)
+    {
+        Aws::String request;
+        char buffer[1024];
+        while (request.find("\r\n\r\n") == Aws::String::npos)
+        {
+            ssize_t received = recv(connection, buffer, sizeof(buffer), 0);
+            if (received <= 0)
+            {
+                close(connection);
+                return;
+            }
+            request.append(buffer, static_cast<size_t>(received));
+        }
+
+        size_t pathBegin = request.find(' ') + 1;
+        Aws::String path = request.substr(pathBegin, request.find(' ', pathBegin) - pathBegin);
+
+        std::unique_lock<std::mutex> locker(m_lock);
+        ++m_requestsReceived;
+        m_signal.notify_all();
+
+        Aws::String body;
+        if (path.find("/delay/") == 0)
+        {
+            std::chrono::milliseconds delay(atoi(path.c_str() + strlen("/delay/")));
+            m_signal.wait_for(locker, delay, [this]() { return m_stopped; });
+            body = path;
+        }
+        else if (path.find("/bytes/") == 0)
+        {
+            body = Aws::String(static_cast<size_t>(atoi(path.c_str() + strlen("/bytes/"))), 'b');
+        }
+        else
+        {
+            m_signal.wait(locker, [this]() { return m_stopped; });
+        }
+        locker.unlock();
+
+        Aws::StringStream response;
+        response << "HTTP/1.1 200 OK\r\nContent-Length: " << body.size() << "\r\nConnection: close\r\n\r\n" << body;
+        Aws::String responseString = response.str();
+        for (size_t sent = 0; sent < responseString.size();)
+        {
+            ssize_t written = send(connection, responseString.c_str() + sent, responseString.size() - sent, MSG_NOSIGNAL);
+            if (written <= 0)
+            {
+                break;
+            }
+            sent += static_cast<size_t>(written);
+        }
+        close(connection);
+    }
+
+    int m_listenSocket;
+    unsigned short m_port;
+    std::thread m_acceptThread;
+    Aws::Vector<std::thread> m_connectionThreads;
+    std::mutex m_lock;
+    std::condition_variable m_signal;
+    bool m_stopped;
+    size_t m_requestsReceived;
+};
+
+// collects the responses handed to MakeRequestAsync handlers along with the thread they completed on.
+class CompletionRecorder
+{
+public:
+    struct Completion
+    {
+        std::shared_ptr<HttpRequest> request;
+        std::shared_ptr<HttpResponse> response;
+        std::thread::id thread;
+        std::chrono::steady_clock::time_point time;
+    };
+
+    RequestCompletedEventHandler Handler()
+    {
+        return [this](const std::shared_ptr<HttpRequest>& request, const std::shared_ptr<HttpResponse>& response)
+        {
+            std::lock_guard<std::mutex> locker(m_lock);
+            Completion completion = { request, response, std::this_thread::get_id(), std::chrono::steady_clock::now() };
+            m_completions.push_back(completion);
+            m_signal.notify_all();
+        };
+    }
+
+    bool WaitFor(size_t count, std::chrono::milliseconds timeout)
+    {
+        std::unique_lock<std::mutex> locker(m_lock);
+        return m_signal.wait_for(locker, timeout, [this, count]() { return m_completions.size() >= count; });
+    }
+
+    Aws::Vector<Completion> GetCompletions()
+    {
+        std::lock_guard<std::mutex> locker(m_lock);
+        return m_completions;
+    }
+
+private:
+    std::mutex m_lock;
+    std::condition_variable m_signal;
+    Aws::Vector<Completion> m_completions;
+};
+
+static Aws::String ReadBody(const std::shared_ptr<HttpResponse>& response)
+{
+    Aws::StringStream body;
+    body << response->GetResponseBody().rdbuf();
+    return body.str();
+}
+
+static std::shared_ptr<HttpRequest> CreateGetRequest(const Aws::String& url)
+{
+    return CreateHttpRequest(URI(url), HttpMethod::HTTP_GET, Aws::Utils::Stream::DefaultResponseStreamFactoryMethod);
+}
+
+static ClientConfiguration CreateConfig()
+{
+    ClientConfiguration config;
+    config.scheme = Scheme::HTTP;
+    config.httpEventLoopThreads = 1;
+    config.maxConnections = 32;
+    config.connectTimeoutMs = 1000;
+    config.requestTimeoutMs = 1000;
+    return config;
+}
+
+TEST(CurlMultiHttpClientTest, TestConcurrentRequestsShareTheEventLoop)
+{
+    LoopbackHttpServer server;
+    CompletionRecorder recorder;
+    CurlMultiHttpClient client(CreateConfig());
+
+    const size_t requestCount = 16;
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < requestCount; ++i)
+    {
+        client.MakeRequestAsync(CreateGetRequest(server.GetUrl("/delay/500/" + StringUtils::to_string(i))), recorder.Handler());
+    }
+    ASSERT_TRUE(recorder.WaitFor(requestCount, std::chrono::seconds(10)));
+
+    // one loop thread waits on all of them at once, one after the other would take 8 seconds.
+    ASSERT_LT(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(3000));
+    auto completions = recorder.GetCompletions();
+    for (const auto& completion : completions)
+    {
+        ASSERT_NE(nullptr, completion.response);
+        ASSERT_EQ(HttpResponseCode::OK, completion.response->GetResponseCode());
+        ASSERT_EQ(completion.request->GetUri().GetPath(), ReadBody(completion.response));
+        ASSERT_EQ(completions[0].thread, completion.thread);
+    }
+    ASSERT_NE(std::this_thread::get_id(), completions[0].thread);
+}
+
+TEST(CurlMultiHttpClientTest, TestBlockingRequestWaitsForTheEventLoop)
+{
+    LoopbackHttpServer server;
+    CurlMultiHttpClient client(CreateConfig());
+
+    auto request = CreateGetRequest(server.GetUrl("/delay/10"));
+    auto response = client.MakeRequest(*request);
+    ASSERT_NE(nullptr, response);
+    ASSERT_EQ(HttpResponseCode::OK, response->GetResponseCode());
+    ASSERT_EQ("/delay/10", ReadBody(response));
+}
+
+TEST(CurlMultiHttpClientTest, TestDisablingRequestProcessingCancelsRequestsAndTimers)
+{
+    LoopbackHttpServer server;
+    CompletionRecorder recorder;
+    CurlMultiHttpClient client(CreateConfig());
+
+    client.MakeRequestAsync(CreateGetRequest(server.GetUrl("/hang")), recorder.Handler());
+    ASSERT_TRUE(server.WaitForRequests(1, std::chrono::seconds(5)));
+
+    std::mutex timerLock;
+    std::condition_variable timerSignal;
+    bool timerFired = false;
+    bool timerCancelled = false;
+    client.RetryRequestSleepAsync(std::chrono::hours(1), [&](bool cancelled)
+    {
+        std::lock_guard<std::mutex> locker(timerLock);
+        timerFired = true;
+        timerCancelled = cancelled;
+        timerSignal.notify_all();
+    });
+
+    auto start = std::chrono::steady_clock::now();
+    client.DisableRequestProcessing();
+    ASSERT_TRUE(recorder.WaitFor(1, std::chrono::seconds(5)));
+    ASSERT_EQ(nullptr, recorder.GetCompletions()[0].response);
+    // well before the request timeout would have ended it.
+    ASSERT_LT(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(500));
+
+    std::unique_lock<std::mutex> locker(timerLock);
+    ASSERT_TRUE(timerSignal.wait_for(locker, std::chrono::seconds(5), [&]() { return timerFired; }));
+    ASSERT_TRUE(timerCancelled);
+}
+
+TEST(CurlMultiHttpClientTest, TestStalledRequestTimesOutWithoutHoldingUpOthers)
+{
+    LoopbackHttpServer server;
+    CompletionRecorder recorder;
+    CurlMultiHttpClient client(CreateConfig());
+
+    auto start = std::chrono::steady_clock::now();
+    client.MakeRequestAsync(CreateGetRequest(server.GetUrl("/hang")), recorder.Handler());
+    client.MakeRequestAsync(CreateGetRequest(server.GetUrl("/delay/100")), recorder.Handler());
+    ASSERT_TRUE(recorder.WaitFor(2, std::chrono::seconds(10)));
+
+    // nothing arrived for requestTimeoutMs, curl gives up on the stalled transfer.
+    auto completions = recorder.GetCompletions();
+    ASSERT_EQ("/delay/100", completions[0].request->GetUri().GetPath());
+    ASSERT_NE(nullptr, completions[0].response);
+    ASSERT_EQ("/hang", completions[1].request->GetUri().GetPath());
+    ASSERT_EQ(nullptr, completions[1].response);
+    ASSERT_GE(completions[1].time - start, std::chrono::milliseconds(900));
+    ASSERT_LT(completions[1].time - start, std::chrono::milliseconds(5000));
+}
+
+TEST(CurlMultiHttpClientTest, TestRateLimitedRequestDoesNotBlockTheEventLoop)
+{
+    LoopbackHttpServer server;
+    CompletionRecorder recorder;
+    Aws::Utils::RateLimits::DefaultRateLimiter<> readLimiter(32 * 1024);
+    CurlMultiHttpClient client(CreateConfig());
+
+    auto start = std::chrono::steady_clock::now();
+    client.MakeRequestAsync(CreateGetRequest(server.GetUrl("/bytes/131072")), recorder.Handler(), &readLimiter);
+    ASSERT_TRUE(server.WaitForRequests(1, std::chrono::seconds(5)));
+    client.MakeRequestAsync(CreateGetRequest(server.GetUrl("/delay/0")), recorder.Handler());
+    ASSERT_TRUE(recorder.WaitFor(2, std::chrono::seconds(15)));
+
+    // the throttled transfer is paused rather than sleeping the loop, so the other request does not wait for it.
+    auto completions = recorder.GetCompletions();
+    ASSERT_EQ("/delay/0", completions[0].request->GetUri().GetPath());
+    ASSERT_LT(completions[0].time - start, std::chrono::milliseconds(1000));
+    ASSERT_EQ("/bytes/131072", completions[1].request->GetUri().GetPath());
+    ASSERT_NE(nullptr, completions[1].response);
+    ASSERT_EQ(131072u, ReadBody(completions[1].response).size());
+    ASSERT_GE(completions[1].time - start, std::chrono::milliseconds(2000));
+}
+
+#endif // defined(ENABLE_CURL_CLIENT) && !defined(_WIN32)
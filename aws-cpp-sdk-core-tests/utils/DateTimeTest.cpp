@@ -156,3 +156,64 @@ TEST(DateTimeTest, TestFormatAutoDetect)
     DateTime parsedBadDate(badDate, DateFormat::AutoDetect);
     ASSERT_FALSE(parsedBadDate.WasParseSuccessful());
 }
+
+TEST(DateTimeTest, TestFormatIntoBuffer)
+{
+    DateTime gmtDate("2002-10-02T08:05:09Z", DateFormat::ISO_8601);
+    char buffer[DateTime::RFC822_LENGTH + 1];
+
+    ASSERT_EQ(DateTime::RFC822_LENGTH, gmtDate.ToGmtString(DateFormat::RFC822, buffer, sizeof(buffer)));
+    ASSERT_STREQ("Wed, 02 Oct 2002 08:05:09 GMT", buffer);
+    ASSERT_EQ(DateTime::ISO_8601_LENGTH, gmtDate.ToGmtString(DateFormat::ISO_8601, buffer, sizeof(buffer)));
+    ASSERT_STREQ("2002-10-02T08:05:09Z", buffer);
+    ASSERT_EQ(DateTime::ISO_8601_BASIC_LENGTH, gmtDate.ToGmtString(DateFormat::ISO_8601_BASIC, buffer, sizeof(buffer)));
+    ASSERT_STREQ("20021002T080509Z", buffer);
+    ASSERT_EQ("20021002T080509Z", gmtDate.ToGmtString(DateFormat::ISO_8601_BASIC));
+
+    //no room for the null terminator
+    ASSERT_EQ(0u, gmtDate.ToGmtString(DateFormat::ISO_8601, buffer, DateTime::ISO_8601_LENGTH));
+    ASSERT_EQ(0u, gmtDate.ToGmtString(DateFormat::AutoDetect, buffer, sizeof(buffer)));
+}
+
+TEST(DateTimeTest, TestFixedFormatsMatchStrftime)
+{
+    //every 97 hours and 13 seconds from 1901 through 2105, so leap years, century years and pre epoch times are all covered.
+    for (int64_t seconds = -2145916800LL; seconds < 4260211200LL; seconds += 97 * 3600 + 13)
+    {
+        //to_time_t truncates pre epoch millis towards zero, so only add some past the epoch.
+        DateTime date(seconds * 1000 + (seconds >= 0 ? 999 : 0));
+        Aws::String rfc822 = date.ToGmtString(DateFormat::RFC822);
+        Aws::String iso8601 = date.ToGmtString(DateFormat::ISO_8601);
+        Aws::String iso8601Basic = date.ToGmtString(DateFormat::ISO_8601_BASIC);
+        ASSERT_EQ(date.ToGmtString("%a, %d %b %Y %H:%M:%S") + " GMT", rfc822);
+        ASSERT_EQ(date.ToGmtString("%Y-%m-%dT%H:%M:%SZ"), iso8601);
+        ASSERT_EQ(date.ToGmtString("%Y%m%dT%H%M%SZ"), iso8601Basic);
+
+        DateTime truncated(seconds * 1000);
+        ASSERT_EQ(truncated, DateTime(rfc822, DateFormat::RFC822));
+        ASSERT_EQ(truncated, DateTime(iso8601, DateFormat::ISO_8601));
+        ASSERT_EQ(truncated, DateTime(iso8601Basic, DateFormat::ISO_8601_BASIC));
+        ASSERT_EQ(truncated, DateTime(rfc822, DateFormat::AutoDetect));
+        ASSERT_EQ(truncated, DateTime(iso8601, DateFormat::AutoDetect));
+    }
+}
+
+TEST(DateTimeTest, TestNonCanonicalTimestampsStillParse)
+{
+    DateTime expected("2002-10-02T08:05:09Z", DateFormat::ISO_8601);
+
+    //fractional seconds are dropped, as before.
+    DateTime withMillis("2002-10-02T08:05:09.123Z", DateFormat::ISO_8601);
+    ASSERT_TRUE(withMillis.WasParseSuccessful());
+    ASSERT_EQ(expected, withMillis);
+
+    DateTime utcZone("Wed, 02 Oct 2002 08:05:09 UTC", DateFormat::RFC822);
+    ASSERT_TRUE(utcZone.WasParseSuccessful());
+    ASSERT_EQ(expected, utcZone);
+
+    DateTime badWeekDay("Xyz, 02 Oct 2002 08:05:09 GMT", DateFormat::RFC822);
+    ASSERT_FALSE(badWeekDay.WasParseSuccessful());
+
+    DateTime badBasic("20021002T0805Z", DateFormat::ISO_8601_BASIC);
+    ASSERT_FALSE(badBasic.WasParseSuccessful());
+}
@@ -63,6 +63,59 @@ TEST(FileTest, TempFile)
     ASSERT_FALSE(testIn.good());
 }
 
+TEST(FileTest, TestPositionedWritesInAnyOrder)
+{
+    TempFile tempFile(std::ios_base::out | std::ios_base::trunc);
+    tempFile << "stale contents";
+    tempFile.close();
+
+    {
+        Aws::FileSystem::PositionedWriteFile file(tempFile.GetFileName().c_str(), true);
+        ASSERT_TRUE(file);
+        ASSERT_TRUE(file.Preallocate(12));
+
+        const unsigned char second[] = { 'w', 'o', 'r', 'l', 'd', '!' };
+        const unsigned char first[] = { 'h', 'e', 'l', 'l', 'o', ' ' };
+        ASSERT_TRUE(file.WriteAt(second, sizeof(second), 6));
+        ASSERT_TRUE(file.WriteAt(first, sizeof(first), 0));
+        ASSERT_TRUE(file.Sync());
+
+        // preallocation never shrinks the file
+        ASSERT_TRUE(file.Preallocate(4));
+    }
+
+    std::ifstream testIn(tempFile.GetFileName().c_str(), std::ios_base::in | std::ios_base::binary);
+    Aws::String contents((std::istreambuf_iterator<char>(testIn)), std::istreambuf_iterator<char>());
+    ASSERT_EQ("hello world!", contents);
+
+    Aws::FileSystem::PositionedWriteFile badFile(Aws::FileSystem::Join("boogieMan", "file").c_str(), false);
+    ASSERT_FALSE(badFile);
+}
+
+TEST(FileTest, TestPositionedReadsInAnyOrder)
+{
+    TempFile tempFile(std::ios_base::out | std::ios_base::trunc);
+    tempFile << "hello world!";
+    tempFile.close();
+
+    Aws::FileSystem::PositionedReadFile file(tempFile.GetFileName().c_str());
+    ASSERT_TRUE(file);
+
+    unsigned char second[6] = {};
+    unsigned char first[6] = {};
+    ASSERT_TRUE(file.ReadAt(second, sizeof(second), 6));
+    ASSERT_TRUE(file.ReadAt(first, sizeof(first), 0));
+    ASSERT_EQ("world!", Aws::String(reinterpret_cast<char*>(second), sizeof(second)));
+    ASSERT_EQ("hello ", Aws::String(reinterpret_cast<char*>(first), sizeof(first)));
+
+    // a range past the end of the file is not read partially
+    unsigned char pastEnd[4] = {};
+    ASSERT_FALSE(file.ReadAt(pastEnd, sizeof(pastEnd), 10));
+
+    Aws::FileSystem::PositionedReadFile badFile(Aws::FileSystem::Join("boogieMan", "file").c_str());
+    ASSERT_FALSE(badFile);
+}
+
 class DirectoryTreeTest : public ::testing::Test
 {
 public:
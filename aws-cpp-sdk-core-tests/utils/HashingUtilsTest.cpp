@@ -16,8 +16,14 @@
 #include <aws/external/gtest.h>
 
 #include <aws/core/utils/HashingUtils.h>
+#include <aws/core/utils/CPUFeatures.h>
+#include <aws/core/utils/FileSystemUtils.h>
+#include <aws/core/utils/StringUtils.h>
+#include <aws/core/utils/base64/Base64.h>
+#include <aws/core/utils/crypto/Sha256TreeHash.h>
+#include <aws/core/utils/threading/Executor.h>
 #include <aws/core/utils/memory/stl/AWSStringStream.h>
-
+#include <random>
 
 using namespace Aws::Utils;
 
@@ -88,6 +94,82 @@ TEST(HashingUtilsTest, TestHexEncodingDecoding)
     ASSERT_EQ(hexBuffer, HashingUtils::HexDecode(afterEncoding));
 }
 
+static ByteBuffer RandomBytes(std::minstd_rand& random, size_t length)
+{
+    ByteBuffer buffer(length);
+    for (size_t i = 0; i < length; ++i)
+    {
+        buffer[i] = static_cast<unsigned char>(random());
+    }
+    return buffer;
+}
+
+//runs fn once through whatever vector codecs this cpu has and once through the scalar ones.
+template<typename Fn>
+static void ForSIMDAndScalar(Fn&& fn)
+{
+    fn();
+    CPUFeatures::SetSIMDEnabled(false);
+    fn();
+    CPUFeatures::SetSIMDEnabled(true);
+}
+
+TEST(HashingUtilsTest, TestVectorCodecsMatchScalarCodecs)
+{
+    std::minstd_rand random(42);
+    //long enough to go through several vector blocks plus every tail length.
+    for (size_t length = 0; length < 300; ++length)
+    {
+        ByteBuffer data = RandomBytes(random, length);
+        Aws::String base64Results[2];
+        Aws::String hexResults[2];
+        size_t run = 0;
+        ForSIMDAndScalar([&]
+        {
+            base64Results[run] = HashingUtils::Base64Encode(data);
+            hexResults[run] = HashingUtils::HexEncode(data);
+            ASSERT_EQ(data, HashingUtils::Base64Decode(base64Results[run]));
+            ASSERT_EQ(length, HashingUtils::HexDecode(hexResults[run].c_str(), hexResults[run].length(), data.GetUnderlyingData()));
+            ++run;
+        });
+        ASSERT_EQ(base64Results[0], base64Results[1]);
+        ASSERT_EQ(hexResults[0], hexResults[1]);
+        ASSERT_EQ(Aws::Utils::Base64::Base64::CalculateBase64EncodedLength(length), base64Results[0].length());
+    }
+}
+
+TEST(HashingUtilsTest, TestVectorDecodersHandleUnexpectedCharacters)
+{
+    std::minstd_rand random(7);
+    ByteBuffer data = RandomBytes(random, 240);
+    Aws::String base64 = HashingUtils::Base64Encode(data);
+    Aws::String hex = HashingUtils::HexEncode(data);
+
+    //upper case hex is accepted everywhere.
+    Aws::String upperHex = StringUtils::ToUpper(hex.c_str());
+    ASSERT_EQ(data, HashingUtils::HexDecode(upperHex));
+
+    for (size_t position : { size_t(0), size_t(17), size_t(100), size_t(319), size_t(479) })
+    {
+        Aws::String badHex = hex;
+        badHex[position] = 'g';
+        ForSIMDAndScalar([&]
+        {
+            ASSERT_EQ(0u, HashingUtils::HexDecode(badHex.c_str(), badHex.length(), data.GetUnderlyingData()));
+        });
+
+        //the base64 decoder doesn't validate, but both paths have to agree on what they make of junk.
+        Aws::String junkBase64 = base64;
+        junkBase64[position % base64.length()] = static_cast<char>(0x80 + position % 0x80);
+        ByteBuffer decoded[2];
+        size_t run = 0;
+        ForSIMDAndScalar([&] { decoded[run++] = HashingUtils::Base64Decode(junkBase64); });
+        ASSERT_EQ(decoded[0], decoded[1]);
+    }
+
+    ASSERT_EQ(0u, HashingUtils::HexDecode("abc", 3, data.GetUnderlyingData()));
+}
+
 TEST(HashingUtilsTest, TestSHA256HMAC)
 {
     const char* toHash = "TestHash";
@@ -247,6 +329,63 @@ TEST(HashingUtilsTest, TestSHA256TreeHashFromStreamWhenSizeMoreThanOneMB)
     EXPECT_STREQ("ff9ea39186cb33cd5ade7aca078e297a1622f8c1abdd4cc47bcbf66dc5877e1f", HashingUtils::HexEncode(HashingUtils::CalculateSHA256TreeHash(EightMBStream)).c_str());
 }
 
+TEST(HashingUtilsTest, TestParallelTreeHashMatchesSequentialTreeHash)
+{
+    static const size_t partSize = 2 * Crypto::Sha256TreeHash::LEAF_SIZE;
+    std::minstd_rand random(7);
+    ByteBuffer data = RandomBytes(random, 9 * Crypto::Sha256TreeHash::LEAF_SIZE + 12345);
+    Aws::String dataStr(reinterpret_cast<const char*>(data.GetUnderlyingData()), data.GetLength());
+
+    Aws::Utils::Threading::PooledThreadExecutor executor(4);
+    Crypto::Sha256TreeHash parallelTreeHash(&executor, 4);
+    Crypto::TreeHashResult result = parallelTreeHash.Calculate(data.GetUnderlyingData(), data.GetLength(), partSize);
+
+    ASSERT_EQ(HashingUtils::HexEncode(HashingUtils::CalculateSHA256TreeHash(dataStr)), HashingUtils::HexEncode(result.archiveTreeHash));
+    ASSERT_EQ(5u, result.partTreeHashes.size());
+    for (size_t part = 0; part < result.partTreeHashes.size(); ++part)
+    {
+        Aws::String partStr(dataStr, part * partSize, partSize);
+        EXPECT_EQ(HashingUtils::HexEncode(HashingUtils::CalculateSHA256TreeHash(partStr)), HashingUtils::HexEncode(result.partTreeHashes[part]));
+    }
+
+    // with power of two sized parts, the archive tree hash is the tree hash of the part tree hashes
+    Crypto::TreeHashResult fourMBParts = parallelTreeHash.Calculate(data.GetUnderlyingData(), data.GetLength(), 4 * Crypto::Sha256TreeHash::LEAF_SIZE);
+    ASSERT_EQ(3u, fourMBParts.partTreeHashes.size());
+    EXPECT_EQ(result.archiveTreeHash, Crypto::Sha256TreeHash::ComputeTreeHash(fourMBParts.partTreeHashes, 0, fourMBParts.partTreeHashes.size()));
+
+    // same as the known values used above, hashed on the calling thread only
+    Aws::String eightMBStr(1024 * 1024 * 8, '0');
+    Crypto::Sha256TreeHash sequentialTreeHash;
+    EXPECT_STREQ("ff9ea39186cb33cd5ade7aca078e297a1622f8c1abdd4cc47bcbf66dc5877e1f", HashingUtils::HexEncode(sequentialTreeHash.Calculate(
+        reinterpret_cast<const unsigned char*>(eightMBStr.c_str()), eightMBStr.size()).archiveTreeHash).c_str());
+    EXPECT_EQ(HashingUtils::CalculateSHA256(""), sequentialTreeHash.Calculate(nullptr, 0).archiveTreeHash);
+
+    // part sizes which do not line up with the leaves are rejected
+    EXPECT_TRUE(parallelTreeHash.Calculate(data.GetUnderlyingData(), data.GetLength(), partSize + 1).partTreeHashes.empty());
+}
+
+TEST(HashingUtilsTest, TestTreeHashOfMappedFile)
+{
+    Aws::String fileStr(3 * Crypto::Sha256TreeHash::LEAF_SIZE + 1, 'x');
+    Crypto::Sha256TreeHash treeHash;
+    {
+        TempFile file(std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+        file << fileStr;
+        file.close();
+
+        Crypto::TreeHashResult result = treeHash.CalculateFile(file.GetFileName().c_str(), 2 * Crypto::Sha256TreeHash::LEAF_SIZE);
+        EXPECT_EQ(HashingUtils::CalculateSHA256TreeHash(fileStr), result.archiveTreeHash);
+        EXPECT_EQ(2u, result.partTreeHashes.size());
+    }
+    {
+        TempFile emptyFile(std::ios_base::out | std::ios_base::trunc);
+        emptyFile.close();
+        EXPECT_EQ(HashingUtils::CalculateSHA256(""), treeHash.CalculateFile(emptyFile.GetFileName().c_str()).archiveTreeHash);
+    }
+
+    EXPECT_EQ(0u, treeHash.CalculateFile("DoesNotExist/NoSuchFile").archiveTreeHash.GetLength());
+}
+
 static void TestMD5FromString(const char* value, const char* expectedBase64Hash)
 {
     Aws::String source(value);
@@ -317,4 +456,3 @@ TEST(HashingUtilsTest, TestMD5FromStream)
     // "12345678901234567890123456789012345678901234567890123456789012345678901234567890" -> 57edf4a22be3c955ac49da2e2107b67a -> V+30oivjyVWsSdouIQe2eg== (base 64)
     TestMD5FromStream( "12345678901234567890123456789012345678901234567890123456789012345678901234567890", "V+30oivjyVWsSdouIQe2eg==" );
 }
-
@@ -0,0 +1,100 @@
+/*
+* Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+*
+* Licensed under the Apache License, Version 2.0 (the "License").
+* You may not use this file except in compliance with the License.
+* A copy of the License is located at
+*
+*  http://aws.amazon.com/apache2.0
+*
+* or in the "license" file accompanying this file. This file is distributed
+* on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+* express or implied. See the License for the specific language governing
+* permissions and limitations under the License.
+*/
+#include <aws/external/gtest.h>
+#include <aws/core/utils/Histogram.h>
+#include <thread>
+#include <vector>
+
+using namespace Aws::Utils;
+
+TEST(HistogramTest, TestEmptyHistogram)
+{
+    Histogram histogram;
+    ASSERT_EQ(0u, histogram.GetCount());
+    ASSERT_EQ(0, histogram.GetMin());
+    ASSERT_EQ(0, histogram.GetMax());
+    ASSERT_EQ(0.0, histogram.GetMean());
+    ASSERT_EQ(0, histogram.GetValueAtPercentile(50));
+}
+
+TEST(HistogramTest, TestSmallValuesAreExact)
+{
+    Histogram histogram;
+    for (int64_t value = 1; value <= 100; ++value)
+    {
+        histogram.Record(value);
+    }
+
+    ASSERT_EQ(100u, histogram.GetCount());
+    ASSERT_EQ(1, histogram.GetMin());
+    ASSERT_EQ(100, histogram.GetMax());
+    ASSERT_DOUBLE_EQ(50.5, histogram.GetMean());
+    ASSERT_EQ(50, histogram.GetValueAtPercentile(50));
+    ASSERT_EQ(99, histogram.GetValueAtPercentile(99));
+    ASSERT_EQ(100, histogram.GetValueAtPercentile(100));
+    ASSERT_EQ(1, histogram.GetValueAtPercentile(0));
+}
+
+TEST(HistogramTest, TestLargeValuesWithinRelativeError)
+{
+    Histogram histogram;
+    for (int64_t value = 1000; value <= 1000000; value += 1000)
+    {
+        histogram.Record(value);
+    }
+
+    const double percentiles[] = { 50, 90, 99, 99.9 };
+    const int64_t expectedValues[] = { 500000, 900000, 990000, 999000 };
+    for (size_t i = 0; i < 4; ++i)
+    {
+        int64_t reported = histogram.GetValueAtPercentile(percentiles[i]);
+        ASSERT_GE(reported, expectedValues[i]);
+        ASSERT_LE(reported, expectedValues[i] + expectedValues[i] / 64);
+    }
+    ASSERT_EQ(1000000, histogram.GetValueAtPercentile(100));
+
+    histogram.Record(-5);
+    histogram.Record(Histogram::GetHighestTrackableValue() * 4);
+    ASSERT_EQ(0, histogram.GetMin());
+    ASSERT_EQ(Histogram::GetHighestTrackableValue() * 4, histogram.GetValueAtPercentile(100));
+
+    histogram.Reset();
+    ASSERT_EQ(0u, histogram.GetCount());
+    ASSERT_EQ(0, histogram.GetValueAtPercentile(99));
+}
+
+TEST(HistogramTest, TestConcurrentRecording)
+{
+    Histogram histogram;
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 4; ++i)
+    {
+        threads.emplace_back([&histogram, i]()
+        {
+            for (int64_t value = 0; value < 10000; ++value)
+            {
+                histogram.Record(value * (i + 1));
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    ASSERT_EQ(40000u, histogram.GetCount());
+    ASSERT_EQ(0, histogram.GetMin());
+    ASSERT_EQ(9999 * 4, histogram.GetMax());
+}
@@ -0,0 +1,175 @@
+/*
+* Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+*
+* Licensed under the Apache License, Version 2.0 (the "License").
+* You may not use this file except in compliance with the License.
+* A copy of the License is located at
+*
+*  http://aws.amazon.com/apache2.0
+*
+* or in the "license" file accompanying this file. This file is distributed
+* on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+* express or implied. See the License for the specific language governing
+* permissions and limitations under the License.
+*/
+
+#include <aws/external/gtest.h>
+#include <aws/core/utils/crypto/Crc32.h>
+#include <aws/core/utils/crypto/Factories.h>
+#include <aws/core/utils/crypto/MD5.h>
+#include <aws/core/utils/crypto/MultiDigest.h>
+#include <aws/core/utils/crypto/Sha256.h>
+#include <aws/core/utils/HashingUtils.h>
+#include <aws/core/utils/Outcome.h>
+#include <aws/core/utils/memory/stl/AWSStringStream.h>
+
+using namespace Aws::Utils;
+using namespace Aws::Utils::Crypto;
+
+static const char* MULTI_DIGEST_TEST_TAG = "MultiDigestTest";
+
+//a hash that only implements Calculate, like a custom HashFactory implementation written before Update/GetHash existed.
+class CalculateOnlyHash : public Hash
+{
+public:
+    CalculateOnlyHash(const std::shared_ptr<Hash>& hash, size_t& updates) : m_hash(hash), m_updates(updates) {}
+
+    HashResult Calculate(const Aws::String& str) override { return m_hash->Calculate(str); }
+
+    HashResult Calculate(Aws::IStream& stream) override { return m_hash->Calculate(stream); }
+
+    void Update(const unsigned char*, size_t) override { ++m_updates; }
+
+private:
+    std::shared_ptr<Hash> m_hash;
+    size_t& m_updates;
+};
+
+class CalculateOnlyHashFactory : public HashFactory
+{
+public:
+    CalculateOnlyHashFactory(const std::shared_ptr<Hash>& hash, size_t& updates) : m_hash(hash), m_updates(updates) {}
+
+    std::shared_ptr<Hash> CreateImplementation() const override
+    {
+        return Aws::MakeShared<CalculateOnlyHash>(MULTI_DIGEST_TEST_TAG, m_hash, m_updates);
+    }
+
+private:
+    std::shared_ptr<Hash> m_hash;
+    size_t& m_updates;
+};
+
+static ByteBuffer ToBuffer(const char* str)
+{
+    return ByteBuffer(reinterpret_cast<const unsigned char*>(str), strlen(str));
+}
+
+TEST(Crc32Test, TestKnownValues)
+{
+    Crc32 crc32;
+    EXPECT_EQ("00000000", HashingUtils::HexEncode(crc32.Calculate("").GetResult()));
+    EXPECT_EQ("cbf43926", HashingUtils::HexEncode(crc32.Calculate("123456789").GetResult()));
+    EXPECT_EQ("414fa339", HashingUtils::HexEncode(crc32.Calculate("The quick brown fox jumps over the lazy dog").GetResult()));
+
+    EXPECT_EQ(0xCBF43926u, Crc32::Checksum(0, reinterpret_cast<const unsigned char*>("123456789"), 9));
+    uint32_t crc = Crc32::Checksum(0, reinterpret_cast<const unsigned char*>("12345"), 5);
+    EXPECT_EQ(0xCBF43926u, Crc32::Checksum(crc, reinterpret_cast<const unsigned char*>("6789"), 4));
+}
+
+TEST(MultiDigestTest, TestIncrementalHashesMatchOneShotHashes)
+{
+    Aws::String data;
+    for (int i = 0; i < 1000; ++i)
+    {
+        data.append("incremental digest data ");
+    }
+
+    MD5 md5;
+    Sha256 sha256;
+    Crc32 crc32;
+    Hash* hashes[] = { &md5, &sha256, &crc32 };
+    for (Hash* hash : hashes)
+    {
+        //uneven pieces, crossing block boundaries.
+        size_t pos = 0;
+        for (size_t piece = 1; pos < data.size(); piece = piece * 3 + 1)
+        {
+            size_t length = (std::min)(piece, data.size() - pos);
+            hash->Update(reinterpret_cast<const unsigned char*>(data.c_str()) + pos, length);
+            pos += length;
+        }
+        EXPECT_EQ(hash->Calculate(data).GetResult(), hash->GetHash().GetResult());
+
+        //GetHash starts over.
+        EXPECT_EQ(hash->Calculate("").GetResult(), hash->GetHash().GetResult());
+        hash->Update(reinterpret_cast<const unsigned char*>("abc"), 3);
+        EXPECT_EQ(hash->Calculate("abc").GetResult(), hash->GetHash().GetResult());
+    }
+}
+
+TEST(MultiDigestTest, TestStreamIsDigestedInOnePass)
+{
+    Aws::String data(3 * MultiDigest::STREAM_BUFFER_SIZE + 17, 'x');
+    for (size_t i = 0; i < data.size(); i += 7)
+    {
+        data[i] = static_cast<char>('a' + i % 26);
+    }
+    Aws::StringStream stream(data);
+    stream.seekg(10);
+
+    MultiDigest digests;
+    digests.AddAlgorithm(DigestAlgorithm::MD5);
+    digests.AddAlgorithm(DigestAlgorithm::SHA256);
+    digests.AddAlgorithm(DigestAlgorithm::CRC32);
+    digests.AddAlgorithm(DigestAlgorithm::SHA256);
+    ASSERT_TRUE(digests.HasAlgorithm(DigestAlgorithm::CRC32));
+    ASSERT_TRUE(digests.Calculate(stream));
+
+    EXPECT_EQ(10, stream.tellg());
+    EXPECT_EQ(HashingUtils::CalculateMD5(data), digests.GetDigest(DigestAlgorithm::MD5));
+    EXPECT_EQ(HashingUtils::CalculateSHA256(data), digests.GetDigest(DigestAlgorithm::SHA256));
+    EXPECT_EQ(Crc32().Calculate(data).GetResult(), digests.GetDigest(DigestAlgorithm::CRC32));
+
+    ASSERT_TRUE(digests.Calculate(reinterpret_cast<const unsigned char*>("abc"), 3));
+    EXPECT_EQ(HashingUtils::CalculateSHA256("abc"), digests.GetDigest(DigestAlgorithm::SHA256));
+    EXPECT_EQ(ToBuffer("\x35\x24\x41\xc2"), digests.GetDigest(DigestAlgorithm::CRC32));
+
+    MultiDigest md5Only;
+    md5Only.AddAlgorithm(DigestAlgorithm::MD5);
+    ASSERT_TRUE(md5Only.Calculate(stream));
+    EXPECT_FALSE(md5Only.HasAlgorithm(DigestAlgorithm::SHA256));
+    EXPECT_EQ(0u, md5Only.GetDigest(DigestAlgorithm::SHA256).GetLength());
+}
+
+TEST(MultiDigestTest, TestHashesThatAreNotIncrementalAreCalculatedWhole)
+{
+    size_t updates = 0;
+    auto sha256 = CreateSha256Implementation();
+    ASSERT_TRUE(sha256->IsIncremental());
+    ASSERT_TRUE(MD5().IsIncremental());
+
+    CalculateOnlyHash calculateOnly(sha256, updates);
+    EXPECT_FALSE(calculateOnly.IsIncremental());
+    EXPECT_FALSE(calculateOnly.GetHash().IsSuccess());
+
+    MultiDigest digests;
+    SetSha256Factory(Aws::MakeShared<CalculateOnlyHashFactory>(MULTI_DIGEST_TEST_TAG, sha256, updates));
+    digests.AddAlgorithm(DigestAlgorithm::SHA256);
+    CleanupCrypto();
+    InitCrypto();
+    digests.AddAlgorithm(DigestAlgorithm::MD5);
+
+    Aws::String data(2 * MultiDigest::STREAM_BUFFER_SIZE + 5, 'y');
+    Aws::StringStream stream(data);
+    stream.seekg(10);
+    ASSERT_TRUE(digests.Calculate(stream));
+    EXPECT_EQ(10, stream.tellg());
+    EXPECT_EQ(HashingUtils::CalculateSHA256(data), digests.GetDigest(DigestAlgorithm::SHA256));
+    EXPECT_EQ(HashingUtils::CalculateMD5(data), digests.GetDigest(DigestAlgorithm::MD5));
+
+    ASSERT_TRUE(digests.Calculate(reinterpret_cast<const unsigned char*>("abc"), 3));
+    EXPECT_EQ(HashingUtils::CalculateSHA256("abc"), digests.GetDigest(DigestAlgorithm::SHA256));
+    EXPECT_EQ(HashingUtils::CalculateMD5("abc"), digests.GetDigest(DigestAlgorithm::MD5));
+    EXPECT_EQ(0u, updates);
+}
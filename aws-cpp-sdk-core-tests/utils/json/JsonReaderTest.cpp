@@ -0,0 +1,344 @@
+
+/*
+* Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+*
+* Licensed under the Apache License, Version 2.0 (the "License").
+* You may not use this file except in compliance with the License.
+* A copy of the License is located at
+*
+*  http://aws.amazon.com/apache2.0
+*
+* or in the "license" file accompanying this file. This file is distributed
+* on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+* express or implied. See the License for the specific language governing
+* permissions and limitations under the License.
+*/
+
+#include <aws/external/gtest.h>
+
+#include <aws/core/utils/json/JsonReader.h>
+#include <aws/core/utils/DateTime.h>
+#include <aws/core/utils/memory/stl/AWSStringStream.h>
+
+#include <clocale>
+
+using namespace Aws::Utils::Json;
+using namespace Aws::Utils;
+
+namespace JsonReaderTestModel
+{
+    enum class Color
+    {
+        NOT_SET,
+        RED,
+        GREEN
+    };
+
+    static Color GetColorForName(const Aws::String& name)
+    {
+        return name == "red" ? Color::RED : name == "green" ? Color::GREEN : Color::NOT_SET;
+    }
+
+    inline bool ReadJson(JsonReader& reader, Color& value)
+    {
+        if (reader.ReadNull())
+        {
+            return true;
+        }
+
+        Aws::String name;
+        if (!reader.ReadString(name))
+        {
+            return false;
+        }
+        value = GetColorForName(name);
+        return true;
+    }
+
+    inline bool ReadJsonKey(const Aws::String& key, Color& value)
+    {
+        value = GetColorForName(key);
+        return true;
+    }
+
+    // laid out the way the generator emits structures.
+    class Tag
+    {
+    public:
+        Tag() : m_weight(0), m_nameHasBeenSet(false), m_weightHasBeenSet(false) {}
+
+        bool Deserialize(JsonReader& reader)
+        {
+            if (!reader.StartObject())
+            {
+                return false;
+            }
+
+            Aws::String key;
+            while (reader.NextMember(key))
+            {
+                if (reader.ReadNull())
+                {
+                    continue;
+                }
+
+                if (key == "Name")
+                {
+                    if (!ReadJson(reader, m_name))
+                    {
+                        return false;
+                    }
+                    m_nameHasBeenSet = true;
+                }
+                else if (key == "Weight")
+                {
+                    if (!ReadJson(reader, m_weight))
+                    {
+                        return false;
+                    }
+                    m_weightHasBeenSet = true;
+                }
+                else if (!reader.SkipValue())
+                {
+                    return false;
+                }
+            }
+            return !reader.HasError();
+        }
+
+        Aws::String m_name;
+        long long m_weight;
+        bool m_nameHasBeenSet;
+        bool m_weightHasBeenSet;
+    };
+
+    class Listing
+    {
+    public:
+        Listing() : m_count(0), m_ratio(0.0), m_truncated(false), m_color(Color::NOT_SET) {}
+
+        bool Deserialize(JsonReader& reader)
+        {
+            if (!reader.StartObject())
+            {
+                return false;
+            }
+
+            Aws::String key;
+            while (reader.NextMember(key))
+            {
+                bool read = true;
+                if (key == "Count") read = ReadJson(reader, m_count);
+                else if (key == "Ratio") read = ReadJson(reader, m_ratio);
+                else if (key == "Truncated") read = ReadJson(reader, m_truncated);
+                else if (key == "Color") read = ReadJson(reader, m_color);
+                else if (key == "Created") read = ReadJson(reader, m_created);
+                else if (key == "Data") read = ReadJson(reader, m_data);
+                else if (key == "Tags") read = ReadJson(reader, m_tags);
+                else if (key == "Groups") read = ReadJson(reader, m_groups);
+                else if (key == "ByColor") read = ReadJson(reader, m_byColor);
+                else if (key == "Raw") read = ReadJson(reader, m_raw);
+                else read = reader.SkipValue();
+
+                if (!read)
+                {
+                    return false;
+                }
+            }
+            return !reader.HasError();
+        }
+
+        int m_count;
+        double m_ratio;
+        bool m_truncated;
+        Color m_color;
+        DateTime m_created;
+        ByteBuffer m_data;
+        Aws::Vector<Tag> m_tags;
+        Aws::Map<Aws::String, Aws::Vector<Aws::String>> m_groups;
+        Aws::Map<Color, int> m_byColor;
+        JsonValue m_raw;
+    };
+
+    // hand written types that only know how to build themselves from a JsonValue.
+    class Legacy
+    {
+    public:
+        Legacy() {}
+        Legacy(const JsonValue& jsonValue) : m_value(jsonValue.GetString("S")) {}
+
+        Aws::String m_value;
+    };
+}
+
+using namespace JsonReaderTestModel;
+
+static const char* LISTING_JSON =
+    "{ \"Count\": 3, \"Ratio\": 0.25, \"Truncated\": true, \"Color\": \"green\", \"Created\": 1466193284.5,"
+    "  \"Data\": \"aGVsbG8=\", \"Unknown\": {\"Nested\": [1, {\"a\": \"]}\"}, null, false]},"
+    "  \"Tags\": [ {\"Name\": \"first\", \"Weight\": 9007199254740993}, {\"Weight\": 1e3}, {} ],"
+    "  \"Groups\": {\"admins\": [\"alice\", \"bob\"], \"none\": []},"
+    "  \"ByColor\": {\"red\": 1, \"green\": 2},"
+    "  \"Raw\": {\"Keep\": [1, \"two\"]} }";
+
+TEST(JsonReaderTest, TestReadGeneratedStyleStructure)
+{
+    JsonReader reader(LISTING_JSON, strlen(LISTING_JSON));
+    Listing listing;
+    ASSERT_TRUE(ReadJson(reader, listing)) << reader.GetErrorMessage();
+    ASSERT_FALSE(reader.HasError());
+
+    ASSERT_EQ(3, listing.m_count);
+    ASSERT_DOUBLE_EQ(0.25, listing.m_ratio);
+    ASSERT_TRUE(listing.m_truncated);
+    ASSERT_EQ(Color::GREEN, listing.m_color);
+    ASSERT_EQ(1466193284500LL, listing.m_created.Millis());
+    ASSERT_EQ(5u, listing.m_data.GetLength());
+    ASSERT_EQ('h', listing.m_data[0]);
+
+    ASSERT_EQ(3u, listing.m_tags.size());
+    ASSERT_EQ("first", listing.m_tags[0].m_name);
+    ASSERT_EQ(9007199254740993LL, listing.m_tags[0].m_weight);
+    ASSERT_TRUE(listing.m_tags[0].m_nameHasBeenSet);
+    ASSERT_FALSE(listing.m_tags[1].m_nameHasBeenSet);
+    ASSERT_EQ(1000, listing.m_tags[1].m_weight);
+    ASSERT_FALSE(listing.m_tags[2].m_weightHasBeenSet);
+
+    ASSERT_EQ(2u, listing.m_groups.size());
+    ASSERT_EQ(2u, listing.m_groups["admins"].size());
+    ASSERT_EQ("bob", listing.m_groups["admins"][1]);
+    ASSERT_TRUE(listing.m_groups["none"].empty());
+
+    ASSERT_EQ(1, listing.m_byColor[Color::RED]);
+    ASSERT_EQ(2, listing.m_byColor[Color::GREEN]);
+
+    ASSERT_EQ("two", listing.m_raw.GetArray("Keep")[1].AsString());
+}
+
+TEST(JsonReaderTest, TestStreamInputMatchesBufferInput)
+{
+    // large enough to straddle several refills of the reader's chunk buffer.
+    Aws::StringStream json;
+    json << "{\"Tags\": [";
+    for (int i = 0; i < 2000; ++i)
+    {
+        json << (i ? "," : "") << "{\"Name\": \"tag\\u00e9\\ud83d\\ude00-" << i << "\", \"Weight\": " << i << "}";
+    }
+    json << "]}";
+
+    Listing listing;
+    JsonReader reader(json);
+    ASSERT_TRUE(ReadJson(reader, listing)) << reader.GetErrorMessage();
+
+    ASSERT_EQ(2000u, listing.m_tags.size());
+    ASSERT_EQ("tag\xC3\xA9\xF0\x9F\x98\x80-1999", listing.m_tags[1999].m_name);
+    ASSERT_EQ(1999, listing.m_tags[1999].m_weight);
+}
+
+TEST(JsonReaderTest, TestStringEscapes)
+{
+    const char* json = "[\"a\\\"b\\\\c\\/d\\n\\t\", \"\\u0041\\u00DF\"]";
+    JsonReader reader(json, strlen(json));
+    Aws::Vector<Aws::String> values;
+    ASSERT_TRUE(ReadJson(reader, values));
+    ASSERT_EQ(2u, values.size());
+    ASSERT_EQ("a\"b\\c/d\n\t", values[0]);
+    ASSERT_EQ("A\xC3\x9F", values[1]);
+}
+
+TEST(JsonReaderTest, TestNullLeavesValuesUntouched)
+{
+    const char* json = "{\"Count\": null, \"Ratio\": null, \"Truncated\": null, \"Created\": null, \"Tags\": null, \"Color\": null}";
+    JsonReader reader(json, strlen(json));
+    Listing listing;
+    listing.m_count = 7;
+    listing.m_ratio = 0.5;
+    listing.m_color = Color::RED;
+    ASSERT_TRUE(ReadJson(reader, listing));
+    ASSERT_FALSE(reader.HasError());
+    ASSERT_EQ(7, listing.m_count);
+    ASSERT_DOUBLE_EQ(0.5, listing.m_ratio);
+    ASSERT_FALSE(listing.m_truncated);
+    ASSERT_TRUE(listing.m_tags.empty());
+    ASSERT_EQ(Color::RED, listing.m_color);
+}
+
+TEST(JsonReaderTest, TestNullMembersAreNotSet)
+{
+    const char* json = "[{\"Name\": null, \"Weight\": null}, {\"Name\": \"x\", \"Weight\": 3}]";
+    JsonReader reader(json, strlen(json));
+    Aws::Vector<Tag> tags;
+    ASSERT_TRUE(ReadJson(reader, tags));
+    ASSERT_EQ(2u, tags.size());
+    ASSERT_FALSE(tags[0].m_nameHasBeenSet);
+    ASSERT_FALSE(tags[0].m_weightHasBeenSet);
+    ASSERT_TRUE(tags[1].m_nameHasBeenSet);
+    ASSERT_EQ(3, tags[1].m_weight);
+}
+
+TEST(JsonReaderTest, TestNumbersIgnoreLocaleDecimalPoint)
+{
+    Aws::String previousLocale(setlocale(LC_NUMERIC, nullptr));
+    // only runs where a locale with a decimal comma is installed.
+    if (!setlocale(LC_NUMERIC, "de_DE.UTF-8") && !setlocale(LC_NUMERIC, "de_DE.utf8") && !setlocale(LC_NUMERIC, "de_DE"))
+    {
+        return;
+    }
+
+    const char* json = "{\"Count\": 2.0e1, \"Ratio\": 1.5}";
+    JsonReader reader(json, strlen(json));
+    Listing listing;
+    bool read = ReadJson(reader, listing);
+    setlocale(LC_NUMERIC, previousLocale.c_str());
+
+    ASSERT_TRUE(read);
+    ASSERT_EQ(20, listing.m_count);
+    ASSERT_DOUBLE_EQ(1.5, listing.m_ratio);
+}
+
+TEST(JsonReaderTest, TestJsonValueConstructibleTypesReadThroughTree)
+{
+    const char* json = "{\"first\": {\"S\": \"one\"}, \"second\": {\"S\": \"two\", \"Ignored\": [1]}}";
+    JsonReader reader(json, strlen(json));
+    Aws::Map<Aws::String, Legacy> values;
+    ASSERT_TRUE(ReadJson(reader, values));
+    ASSERT_EQ("one", values["first"].m_value);
+    ASSERT_EQ("two", values["second"].m_value);
+}
+
+TEST(JsonReaderTest, TestMalformedInputLatchesError)
+{
+    const char* inputs[] = {
+        "{\"Count\": 1,}",
+        "{\"Count\" 1}",
+        "{\"Count\": 1",
+        "{\"Tags\": [{\"Name\": \"x\"} {\"Name\": \"y\"}]}",
+        "{\"Count\": \"three\"}",
+        "{\"Truncated\": yes}",
+        "{\"Data\": \"unterminated}",
+        "{\"Color\": \"\\q\"}",
+        "{\"Unknown\": [1, 2}",
+        "[]"
+    };
+
+    for (const char* input : inputs)
+    {
+        JsonReader reader(input, strlen(input));
+        Listing listing;
+        ASSERT_FALSE(ReadJson(reader, listing)) << input;
+        ASSERT_TRUE(reader.HasError()) << input;
+        ASSERT_FALSE(reader.GetErrorMessage().empty());
+
+        Aws::String value;
+        ASSERT_FALSE(reader.ReadString(value));
+    }
+}
+
+TEST(JsonReaderTest, TestErrorReportsOffset)
+{
+    const char* json = "{\"Count\": tru}";
+    JsonReader reader(json, strlen(json));
+    Listing listing;
+    ASSERT_FALSE(ReadJson(reader, listing));
+    ASSERT_STREQ("Expected integer at offset 13", reader.GetErrorMessage().c_str());
+}
@@ -0,0 +1,237 @@
+
+/*
+* Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+*
+* Licensed under the Apache License, Version 2.0 (the "License").
+* You may not use this file except in compliance with the License.
+* A copy of the License is located at
+*
+*  http://aws.amazon.com/apache2.0
+*
+* or in the "license" file accompanying this file. This file is distributed
+* on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+* express or implied. See the License for the specific language governing
+* permissions and limitations under the License.
+*/
+
+#include <aws/external/gtest.h>
+
+#include <aws/core/utils/json/JsonWriter.h>
+#include <aws/core/utils/json/JsonReader.h>
+#include <aws/core/utils/DateTime.h>
+
+#include <clocale>
+#include <limits>
+
+using namespace Aws::Utils::Json;
+using namespace Aws::Utils;
+
+namespace JsonWriterTestModel
+{
+    enum class Color
+    {
+        NOT_SET,
+        RED,
+        GREEN
+    };
+
+    static Aws::String GetNameForColor(Color value)
+    {
+        return value == Color::RED ? "red" : value == Color::GREEN ? "green" : "";
+    }
+
+    inline void WriteJson(JsonWriter& writer, Color value)
+    {
+        writer.String(GetNameForColor(value));
+    }
+
+    inline void WriteJsonKey(JsonWriter& writer, Color value)
+    {
+        writer.Key(GetNameForColor(value));
+    }
+
+    // laid out the way the generator emits structures.
+    class Tag
+    {
+    public:
+        Tag() : m_weight(0), m_nameHasBeenSet(false), m_weightHasBeenSet(false) {}
+
+        void Serialize(JsonWriter& writer) const
+        {
+            writer.StartObject();
+            if (m_nameHasBeenSet)
+            {
+                writer.Key("Name");
+                WriteJson(writer, m_name);
+            }
+            if (m_weightHasBeenSet)
+            {
+                writer.Key("Weight");
+                WriteJson(writer, m_weight);
+            }
+            writer.EndObject();
+        }
+
+        Aws::String m_name;
+        long long m_weight;
+        bool m_nameHasBeenSet;
+        bool m_weightHasBeenSet;
+    };
+
+    // hand written types that only know how to produce a JsonValue.
+    class Legacy
+    {
+    public:
+        JsonValue Jsonize() const
+        {
+            JsonValue value;
+            value.WithString("S", m_value);
+            return value;
+        }
+
+        Aws::String m_value;
+    };
+}
+
+using namespace JsonWriterTestModel;
+
+TEST(JsonWriterTest, TestWriteNestedValues)
+{
+    Tag first;
+    first.m_name = "first";
+    first.m_nameHasBeenSet = true;
+    first.m_weight = 9007199254740993LL;
+    first.m_weightHasBeenSet = true;
+
+    Aws::Vector<Tag> tags;
+    tags.push_back(first);
+    tags.push_back(Tag());
+
+    Aws::Map<Aws::String, Aws::Vector<Aws::String>> groups;
+    groups["admins"] = { "alice", "bob" };
+    groups["none"];
+
+    Aws::Map<Color, int> byColor;
+    byColor[Color::RED] = 1;
+    byColor[Color::GREEN] = 2;
+
+    Aws::String output;
+    JsonWriter writer(output);
+    writer.StartObject();
+    writer.Key("Count");
+    WriteJson(writer, 3);
+    writer.Key("Truncated");
+    WriteJson(writer, true);
+    writer.Key("Color");
+    WriteJson(writer, Color::GREEN);
+    writer.Key("Data");
+    WriteJson(writer, ByteBuffer(reinterpret_cast<const unsigned char*>("hello"), 5));
+    writer.Key("Tags");
+    WriteJson(writer, tags);
+    writer.Key("Groups");
+    WriteJson(writer, groups);
+    writer.Key("ByColor");
+    WriteJson(writer, byColor);
+    writer.Key("Nothing");
+    writer.Null();
+    writer.EndObject();
+
+    ASSERT_STREQ("{\"Count\":3,\"Truncated\":true,\"Color\":\"green\",\"Data\":\"aGVsbG8=\","
+        "\"Tags\":[{\"Name\":\"first\",\"Weight\":9007199254740993},{}],"
+        "\"Groups\":{\"admins\":[\"alice\",\"bob\"],\"none\":[]},"
+        "\"ByColor\":{\"red\":1,\"green\":2},\"Nothing\":null}", output.c_str());
+}
+
+TEST(JsonWriterTest, TestStringEscapes)
+{
+    Aws::String output;
+    JsonWriter writer(output);
+    writer.StartArray();
+    writer.String("a\"b\\c/d\n\t\x01");
+    writer.String("\xC3\x9F");
+    writer.EndArray();
+
+    ASSERT_STREQ("[\"a\\\"b\\\\c/d\\n\\t\\u0001\",\"\xC3\x9F\"]", output.c_str());
+
+    JsonValue parsed(output);
+    ASSERT_TRUE(parsed.WasParseSuccessful());
+    ASSERT_EQ("a\"b\\c/d\n\t\x01", parsed.AsArray()[0].AsString());
+}
+
+TEST(JsonWriterTest, TestNumbersRoundTrip)
+{
+    DateTime created(static_cast<int64_t>(1466193284500LL));
+
+    Aws::String output;
+    JsonWriter writer(output);
+    writer.StartArray();
+    WriteJson(writer, 0.1);
+    WriteJson(writer, -1.5e300);
+    WriteJson(writer, created);
+    writer.Double(std::numeric_limits<double>::infinity());
+    writer.EndArray();
+
+    JsonReader reader(output.c_str(), output.size());
+    ASSERT_TRUE(reader.StartArray());
+
+    double value = 0.0;
+    ASSERT_TRUE(reader.NextElement());
+    ASSERT_TRUE(reader.ReadDouble(value));
+    ASSERT_EQ(0.1, value);
+    ASSERT_TRUE(reader.NextElement());
+    ASSERT_TRUE(reader.ReadDouble(value));
+    ASSERT_EQ(-1.5e300, value);
+
+    DateTime read;
+    ASSERT_TRUE(reader.NextElement());
+    ASSERT_TRUE(ReadJson(reader, read));
+    ASSERT_EQ(created.Millis(), read.Millis());
+
+    ASSERT_TRUE(reader.NextElement());
+    ASSERT_TRUE(reader.ReadNull());
+    ASSERT_FALSE(reader.NextElement());
+    ASSERT_FALSE(reader.HasError());
+}
+
+TEST(JsonWriterTest, TestDoublesIgnoreLocaleDecimalPoint)
+{
+    Aws::String previousLocale(setlocale(LC_NUMERIC, nullptr));
+    // only runs where a locale with a decimal comma is installed.
+    if (!setlocale(LC_NUMERIC, "de_DE.UTF-8") && !setlocale(LC_NUMERIC, "de_DE.utf8") && !setlocale(LC_NUMERIC, "de_DE"))
+    {
+        return;
+    }
+
+    Aws::String output;
+    JsonWriter writer(output);
+    writer.StartArray();
+    writer.Double(1.5);
+    writer.Double(-0.25);
+    writer.EndArray();
+    setlocale(LC_NUMERIC, previousLocale.c_str());
+
+    ASSERT_STREQ("[1.5,-0.25]", output.c_str());
+}
+
+TEST(JsonWriterTest, TestJsonizeTypesWriteThroughTree)
+{
+    Aws::Map<Aws::String, Legacy> values;
+    values["first"].m_value = "one";
+
+    Aws::String output;
+    JsonWriter writer(output);
+    WriteJson(writer, values);
+
+    JsonValue parsed(output);
+    ASSERT_TRUE(parsed.WasParseSuccessful());
+    ASSERT_EQ("one", parsed.GetObject("first").GetString("S"));
+}
+
+TEST(JsonWriterTest, TestAppendsToExistingOutput)
+{
+    Aws::String output = "prefix";
+    JsonWriter writer(output);
+    writer.StartObject();
+    writer.EndObject();
+    ASSERT_STREQ("prefix{}", output.c_str());
+}
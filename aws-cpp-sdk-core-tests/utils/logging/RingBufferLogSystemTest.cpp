@@ -0,0 +1,141 @@
+/*
+  * Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+  * 
+  * Licensed under the Apache License, Version 2.0 (the "License").
+  * You may not use this file except in compliance with the License.
+  * A copy of the License is located at
+  * 
+  *  http://aws.amazon.com/apache2.0
+  * 
+  * or in the "license" file accompanying this file. This file is distributed
+  * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+  * express or implied. See the License for the specific language governing
+  * permissions and limitations under the License.
+  */
+
+#include <aws/external/gtest.h>
+
+#include <aws/core/utils/logging/RingBufferLogSystem.h>
+#include <aws/core/utils/logging/LogMacros.h>
+#include <aws/core/utils/logging/AWSLogging.h>
+#include <aws/core/utils/memory/AWSMemory.h>
+#include <aws/core/utils/memory/stl/AWSStringStream.h>
+#include <aws/core/utils/StringUtils.h>
+
+#include <thread>
+
+using namespace Aws::Utils;
+using namespace Aws::Utils::Logging;
+
+static const char* AllocationTag = "RingBufferLogSystemTest";
+
+static Aws::Vector<Aws::String> LogFromThreads(const std::shared_ptr<Aws::StringStream>& output, RingBufferOverflowPolicy policy,
+        size_t recordsPerRing, int threadCount, int statementsPerThread, size_t& dropped, size_t& blocked)
+{
+    {
+        auto logger = Aws::MakeShared<RingBufferLogSystem>(AllocationTag, LogLevel::Debug, output, policy, recordsPerRing);
+        Aws::Utils::Logging::PushLogger(logger);
+
+        Aws::Vector<std::thread> threads;
+        for (int t = 0; t < threadCount; ++t)
+        {
+            threads.push_back(std::thread([t, statementsPerThread] {
+                for (int i = 0; i < statementsPerThread; ++i)
+                {
+                    AWS_LOGSTREAM_DEBUG("RingBufferLogSystemTest", "thread " << t << " statement " << i);
+                }
+            }));
+        }
+
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+
+        Aws::Utils::Logging::PopLogger();
+        dropped = logger->GetDroppedCount();
+        blocked = logger->GetBlockedCount();
+    }
+
+    return StringUtils::SplitOnLine(output->str());
+}
+
+TEST(RingBufferLogSystemTest, testFormatsLikeFormattedLogSystem)
+{
+    auto output = Aws::MakeShared<Aws::StringStream>(AllocationTag);
+    {
+        auto logger = Aws::MakeShared<RingBufferLogSystem>(AllocationTag, LogLevel::Info, output);
+        Aws::Utils::Logging::PushLogger(logger);
+        AWS_LOG_ERROR("RingBufferTag", "test %s format level %d", "error", 7);
+        AWS_LOGSTREAM_INFO("RingBufferTag", "test " << "info " << "stream level");
+        AWS_LOGSTREAM_DEBUG("RingBufferTag", "filtered out");
+        Aws::Utils::Logging::PopLogger();
+    }
+
+    Aws::Vector<Aws::String> lines = StringUtils::SplitOnLine(output->str());
+    ASSERT_EQ(2u, lines.size());
+    ASSERT_EQ(0u, lines[0].find("[ERROR] "));
+    ASSERT_NE(Aws::String::npos, lines[0].find(" RingBufferTag ["));
+    ASSERT_NE(Aws::String::npos, lines[0].find("] test error format level 7"));
+    ASSERT_EQ(0u, lines[1].find("[INFO] "));
+    ASSERT_NE(Aws::String::npos, lines[1].find("] test info stream level"));
+}
+
+TEST(RingBufferLogSystemTest, testLongStatementsSpillIntact)
+{
+    auto output = Aws::MakeShared<Aws::StringStream>(AllocationTag);
+    Aws::String longText(RingBufferLogSystem::INLINE_MESSAGE_LENGTH * 3, 'x');
+    Aws::String longTag(RingBufferLogSystem::MAX_TAG_LENGTH + 10, 't');
+    size_t spilled = 0;
+    {
+        auto logger = Aws::MakeShared<RingBufferLogSystem>(AllocationTag, LogLevel::Trace, output);
+        logger->Log(LogLevel::Warn, longTag.c_str(), "%s|%s", longText.c_str(), "end");
+        Aws::OStringStream message;
+        message << longText << "|stream";
+        logger->LogStream(LogLevel::Warn, "Tag", message);
+        spilled = logger->GetSpilledCount();
+    }
+
+    ASSERT_EQ(2u, spilled);
+    Aws::Vector<Aws::String> lines = StringUtils::SplitOnLine(output->str());
+    ASSERT_EQ(2u, lines.size());
+    ASSERT_NE(Aws::String::npos, lines[0].find(longText + "|end"));
+    ASSERT_NE(Aws::String::npos, lines[0].find(" " + Aws::String(RingBufferLogSystem::MAX_TAG_LENGTH, 't') + " ["));
+    ASSERT_NE(Aws::String::npos, lines[1].find(longText + "|stream"));
+}
+
+TEST(RingBufferLogSystemTest, testBlockPolicyKeepsEveryStatementInThreadOrder)
+{
+    static const int THREAD_COUNT = 4;
+    static const int STATEMENT_COUNT = 2000;
+    size_t dropped = 0;
+    size_t blocked = 0;
+    auto output = Aws::MakeShared<Aws::StringStream>(AllocationTag);
+    Aws::Vector<Aws::String> lines = LogFromThreads(output, RingBufferOverflowPolicy::BLOCK, 2, THREAD_COUNT, STATEMENT_COUNT, dropped, blocked);
+
+    ASSERT_EQ(0u, dropped);
+    ASSERT_EQ(static_cast<size_t>(THREAD_COUNT * STATEMENT_COUNT), lines.size());
+
+    int next[THREAD_COUNT] = {};
+    for (const auto& line : lines)
+    {
+        size_t threadPos = line.find("thread ");
+        ASSERT_NE(Aws::String::npos, threadPos);
+        int thread = StringUtils::ConvertToInt32(line.substr(threadPos + 7, 1).c_str());
+        Aws::String expected = "statement " + StringUtils::to_string(next[thread]++);
+        ASSERT_EQ(line.size() - expected.size(), line.rfind(expected));
+    }
+}
+
+TEST(RingBufferLogSystemTest, testDropPolicyCountsEveryLostStatement)
+{
+    static const int THREAD_COUNT = 4;
+    static const int STATEMENT_COUNT = 2000;
+    size_t dropped = 0;
+    size_t blocked = 0;
+    auto output = Aws::MakeShared<Aws::StringStream>(AllocationTag);
+    Aws::Vector<Aws::String> lines = LogFromThreads(output, RingBufferOverflowPolicy::DROP, 1, THREAD_COUNT, STATEMENT_COUNT, dropped, blocked);
+
+    ASSERT_EQ(0u, blocked);
+    ASSERT_EQ(static_cast<size_t>(THREAD_COUNT * STATEMENT_COUNT), lines.size() + dropped);
+}
@@ -0,0 +1,224 @@
+/*
+* Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+*
+* Licensed under the Apache License, Version 2.0 (the "License").
+* You may not use this file except in compliance with the License.
+* A copy of the License is located at
+*
+*  http://aws.amazon.com/apache2.0
+*
+* or in the "license" file accompanying this file. This file is distributed
+* on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+* express or implied. See the License for the specific language governing
+* permissions and limitations under the License.
+*/
+
+#include <aws/external/gtest.h>
+#include <aws/core/utils/memory/ArenaMemorySystem.h>
+#include <aws/testing/MemoryTesting.h>
+#include <cstring>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace Aws::Utils::Memory;
+
+namespace
+{
+    /**
+     * Minimal std allocator over a given memory system, so containers can be pointed at a test instance of ArenaMemorySystem
+     * without installing it as the global memory system.
+     */
+    template<typename T>
+    class SystemAllocator
+    {
+    public:
+        typedef T value_type;
+
+        SystemAllocator(MemorySystemInterface& memorySystem) : m_memorySystem(&memorySystem) {}
+        template<typename U>
+        SystemAllocator(const SystemAllocator<U>& other) : m_memorySystem(other.m_memorySystem) {}
+
+        T* allocate(std::size_t n) { return static_cast<T*>(m_memorySystem->AllocateMemory(n * sizeof(T), 1, "SystemAllocator")); }
+        void deallocate(T* p, std::size_t) { m_memorySystem->FreeMemory(p); }
+
+        template<typename U>
+        bool operator==(const SystemAllocator<U>& other) const { return m_memorySystem == other.m_memorySystem; }
+        template<typename U>
+        bool operator!=(const SystemAllocator<U>& other) const { return m_memorySystem != other.m_memorySystem; }
+
+        MemorySystemInterface* m_memorySystem;
+    };
+
+    typedef std::basic_string<char, std::char_traits<char>, SystemAllocator<char>> TestString;
+    typedef std::map<TestString, TestString, std::less<TestString>, SystemAllocator<std::pair<const TestString, TestString>>> TestHeaderMap;
+    typedef std::vector<TestString, SystemAllocator<TestString>> TestStringVector;
+
+    /**
+     * Roughly the allocation pattern of one call: request members, a header map, a response body and a handful of parsed fields.
+     */
+    size_t SimulateRequest(MemorySystemInterface& memorySystem, size_t index)
+    {
+        SystemAllocator<char> allocator(memorySystem);
+        TestHeaderMap headers(std::less<TestString>(), allocator);
+        static const char* headerNames[] = { "host", "x-amz-date", "x-amz-content-sha256", "x-amz-target", "content-type", "authorization",
+            "x-amzn-requestid", "content-length", "date", "connection" };
+        for (auto headerName : headerNames)
+        {
+            TestString value(std::to_string(index).c_str(), allocator);
+            value.append(" some header value that does not fit in the small string buffer");
+            headers.emplace(TestString(headerName, allocator), value);
+        }
+
+        TestString body(2048, 'x', allocator);
+        TestStringVector parsedFields(allocator);
+        for (size_t i = 0; i < 20; ++i)
+        {
+            parsedFields.emplace_back(body, i * 50, 40 + i, allocator);
+        }
+
+        return headers.size() + parsedFields.size();
+    }
+}
+
+TEST(ArenaMemorySystemTest, AllocationsOutsideScopeGoToUnderlyingSystem)
+{
+    BaseTestMemorySystem underlying;
+    ArenaMemorySystem arenaSystem(&underlying);
+
+    void* memory = arenaSystem.AllocateMemory(64, 1);
+    ASSERT_NE(nullptr, memory);
+    memset(memory, 0xAB, 64);
+    ASSERT_EQ(1u, underlying.GetCurrentOutstandingAllocations());
+    ASSERT_EQ(0u, arenaSystem.GetArenaAllocationCount());
+
+    arenaSystem.FreeMemory(memory);
+    ASSERT_EQ(0u, underlying.GetCurrentOutstandingAllocations());
+    ASSERT_EQ(0u, underlying.GetCurrentBytesAllocated());
+}
+
+TEST(ArenaMemorySystemTest, ScopedAllocationsShareBlocks)
+{
+    BaseTestMemorySystem underlying;
+    ArenaMemorySystem arenaSystem(&underlying, 4096);
+    std::vector<void*> allocations;
+    {
+        ScopedArena scope(arenaSystem);
+        for (size_t i = 0; i < 100; ++i)
+        {
+            void* memory = arenaSystem.AllocateMemory(24, 1);
+            ASSERT_NE(nullptr, memory);
+            ASSERT_EQ(0u, reinterpret_cast<uintptr_t>(memory) % 16);
+            memset(memory, static_cast<int>(i), 24);
+            allocations.push_back(memory);
+        }
+
+        ASSERT_EQ(100u, arenaSystem.GetArenaAllocationCount());
+        // the arena itself plus one block per 4k
+        ASSERT_EQ(1 + arenaSystem.GetArenaBlockCount(), underlying.GetTotalAllocationCount());
+        ASSERT_LE(arenaSystem.GetArenaBlockCount(), 2u);
+    }
+
+    for (size_t i = 0; i < allocations.size(); ++i)
+    {
+        ASSERT_EQ(static_cast<unsigned char>(i), *static_cast<unsigned char*>(allocations[i]));
+        arenaSystem.FreeMemory(allocations[i]);
+    }
+    ASSERT_EQ(0u, underlying.GetCurrentOutstandingAllocations());
+}
+
+TEST(ArenaMemorySystemTest, AllocationsOutliveTheirScope)
+{
+    BaseTestMemorySystem underlying;
+    ArenaMemorySystem arenaSystem(&underlying);
+    void* memory = nullptr;
+    {
+        ScopedArena scope(arenaSystem);
+        memory = arenaSystem.AllocateMemory(100, 1);
+        ASSERT_NE(nullptr, memory);
+        arenaSystem.FreeMemory(arenaSystem.AllocateMemory(100, 1));
+    }
+
+    ASSERT_EQ(2u, underlying.GetCurrentOutstandingAllocations());
+    memset(memory, 0, 100);
+
+    // no longer in scope, so this one goes to the underlying system
+    void* heapMemory = arenaSystem.AllocateMemory(100, 1);
+    ASSERT_EQ(3u, underlying.GetCurrentOutstandingAllocations());
+    arenaSystem.FreeMemory(heapMemory);
+
+    arenaSystem.FreeMemory(memory);
+    ASSERT_EQ(0u, underlying.GetCurrentOutstandingAllocations());
+}
+
+TEST(ArenaMemorySystemTest, LargeAllocationsBypassArena)
+{
+    BaseTestMemorySystem underlying;
+    ArenaMemorySystem arenaSystem(&underlying, 1024);
+    {
+        ScopedArena scope(arenaSystem);
+        void* large = arenaSystem.AllocateMemory(512, 1);
+        void* overAligned = arenaSystem.AllocateMemory(16, 512);
+        ASSERT_EQ(0u, reinterpret_cast<uintptr_t>(overAligned) % 512);
+        ASSERT_EQ(0u, arenaSystem.GetArenaAllocationCount());
+
+        void* small = arenaSystem.AllocateMemory(16, 1);
+        void* aligned = arenaSystem.AllocateMemory(16, 64);
+        ASSERT_EQ(0u, reinterpret_cast<uintptr_t>(aligned) % 64);
+        ASSERT_EQ(2u, arenaSystem.GetArenaAllocationCount());
+
+        arenaSystem.FreeMemory(overAligned);
+
+        arenaSystem.FreeMemory(large);
+        arenaSystem.FreeMemory(aligned);
+        arenaSystem.FreeMemory(small);
+    }
+    ASSERT_EQ(0u, underlying.GetCurrentOutstandingAllocations());
+}
+
+TEST(ArenaMemorySystemTest, ScopesAreThreadLocalAndNest)
+{
+    BaseTestMemorySystem underlying;
+    ArenaMemorySystem arenaSystem(&underlying);
+    void* outer = nullptr;
+    void* inner = nullptr;
+    void* otherThread = nullptr;
+    {
+        ScopedArena outerScope(arenaSystem);
+        outer = arenaSystem.AllocateMemory(32, 1);
+        {
+            ScopedArena innerScope(arenaSystem);
+            inner = arenaSystem.AllocateMemory(32, 1);
+            std::thread([&] { otherThread = arenaSystem.AllocateMemory(32, 1); }).join();
+        }
+        ASSERT_EQ(2u, arenaSystem.GetArenaAllocationCount());
+        ASSERT_EQ(2u, arenaSystem.GetArenaBlockCount());
+    }
+
+    // frees may come from any thread
+    std::thread([&] { arenaSystem.FreeMemory(inner); }).join();
+    arenaSystem.FreeMemory(outer);
+    arenaSystem.FreeMemory(otherThread);
+    ASSERT_EQ(0u, underlying.GetCurrentOutstandingAllocations());
+}
+
+TEST(ArenaMemorySystemTest, RequestLikeWorkloadUsesFewerUnderlyingAllocations)
+{
+    BaseTestMemorySystem underlying;
+    ArenaMemorySystem arenaSystem(&underlying);
+
+    uint64_t before = underlying.GetTotalAllocationCount();
+    SimulateRequest(arenaSystem, 1);
+    uint64_t withoutArena = underlying.GetTotalAllocationCount() - before;
+
+    before = underlying.GetTotalAllocationCount();
+    {
+        ScopedArena scope(arenaSystem);
+        SimulateRequest(arenaSystem, 1);
+    }
+    uint64_t withArena = underlying.GetTotalAllocationCount() - before;
+
+    ASSERT_LT(withArena * 4, withoutArena);
+    ASSERT_EQ(0u, underlying.GetCurrentOutstandingAllocations());
+}
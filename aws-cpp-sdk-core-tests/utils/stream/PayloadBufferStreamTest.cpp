@@ -0,0 +1,63 @@
+
+/*
+* Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+*
+* Licensed under the Apache License, Version 2.0 (the "License").
+* You may not use this file except in compliance with the License.
+* A copy of the License is located at
+*
+*  http://aws.amazon.com/apache2.0
+*
+* or in the "license" file accompanying this file. This file is distributed
+* on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+* express or implied. See the License for the specific language governing
+* permissions and limitations under the License.
+*/
+
+#include <aws/external/gtest.h>
+
+#include <aws/core/utils/stream/PayloadBufferStream.h>
+
+using namespace Aws::Utils::Stream;
+
+TEST(PayloadBufferStreamTest, TestReadAndSeek)
+{
+    PayloadBufferStream stream;
+    stream.GetBuffer().append("{\"Key\":\"Value\"}");
+
+    stream.seekg(0, stream.end);
+    ASSERT_EQ(15, static_cast<int>(stream.tellg()));
+    stream.seekg(0, stream.beg);
+
+    Aws::String contents((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+    ASSERT_EQ("{\"Key\":\"Value\"}", contents);
+
+    stream.clear();
+    stream.seekg(2);
+    char key[4] = {};
+    stream.read(key, 3);
+    ASSERT_STREQ("Key", key);
+    stream.seekg(1, stream.cur);
+    ASSERT_EQ(':', stream.get());
+
+    stream.seekg(16);
+    ASSERT_TRUE(stream.fail());
+}
+
+TEST(PayloadBufferStreamTest, TestBuffersAreReusedWithTheirCapacity)
+{
+    size_t capacity = 0;
+    const char* data = nullptr;
+    {
+        PayloadBufferStream stream;
+        stream.GetBuffer().reserve(4096);
+        stream.GetBuffer().append("payload");
+        capacity = stream.GetBuffer().capacity();
+        data = stream.GetBuffer().c_str();
+    }
+
+    PayloadBufferStream stream;
+    ASSERT_TRUE(stream.GetBuffer().empty());
+    ASSERT_EQ(capacity, stream.GetBuffer().capacity());
+    ASSERT_EQ(data, stream.GetBuffer().c_str());
+}
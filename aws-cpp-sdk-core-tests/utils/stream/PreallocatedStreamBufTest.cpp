@@ -180,3 +180,24 @@ TEST(PreallocatedStreamBufTest, TestZeroLengthSeekFromEnd)
     // could check ch == 0 but I don't think the standard guarantees that
     ASSERT_TRUE(ioStream.eof());
 }
+
+//read a range of a buffer the stream buf does not own, without copying it. Writes must not touch it.
+TEST(PreallocatedStreamBufTest, TestReadOnlyViewOfRange)
+{
+    PreallocatedStreamBuf streamBuf(reinterpret_cast<const uint8_t*>(bufferStr) + 5, 10);
+    ASSERT_EQ(nullptr, streamBuf.GetBuffer());
+    Aws::IOStream ioStream(&streamBuf);
+
+    Aws::String contents((std::istreambuf_iterator<char>(ioStream)), std::istreambuf_iterator<char>());
+    ASSERT_EQ("is an inte", contents);
+
+    ioStream.clear();
+    ioStream.seekg(3, std::ios_base::beg);
+    char ch = 0;
+    ioStream.get(ch);
+    ASSERT_EQ('a', ch);
+
+    ioStream.write(replacementBuf, 4);
+    ASSERT_TRUE(ioStream.bad());
+    ASSERT_STREQ("This is an internal buffer.", bufferStr);
+}
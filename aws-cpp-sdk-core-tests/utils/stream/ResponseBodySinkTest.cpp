@@ -0,0 +1,127 @@
+/*
+* Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+*
+* Licensed under the Apache License, Version 2.0 (the "License").
+* You may not use this file except in compliance with the License.
+* A copy of the License is located at
+*
+*  http://aws.amazon.com/apache2.0
+*
+* or in the "license" file accompanying this file. This file is distributed
+* on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+* express or implied. See the License for the specific language governing
+* permissions and limitations under the License.
+*/
+
+#include <aws/external/gtest.h>
+#include <aws/core/utils/stream/ContiguousBodySink.h>
+#include <aws/core/utils/stream/ChunkedBodySink.h>
+#include <aws/core/utils/json/JsonSerializer.h>
+#include <aws/core/utils/memory/stl/AWSString.h>
+#include <aws/core/utils/memory/stl/AWSStreamFwd.h>
+#include <cstring>
+
+using namespace Aws::Utils;
+using namespace Aws::Utils::Stream;
+
+static const char* SINK_TEST_TAG = "ResponseBodySinkTest";
+static const char bodyStr[] = "{\"TableNames\":[\"table1\",\"table2\"]}";
+
+TEST(ResponseBodySinkTest, ContiguousSinkAppendsInPlace)
+{
+    ContiguousBodySink sink;
+    sink.Reserve(strlen(bodyStr));
+    size_t capacity = sink.GetCapacity();
+    ASSERT_GE(capacity, strlen(bodyStr));
+
+    ASSERT_EQ(10u, sink.Append(bodyStr, 10));
+    ASSERT_EQ(strlen(bodyStr) - 10, sink.Append(bodyStr + 10, strlen(bodyStr) - 10));
+    //the reserved buffer was big enough, it must not have been reallocated.
+    ASSERT_EQ(capacity, sink.GetCapacity());
+    ASSERT_EQ(strlen(bodyStr), sink.GetSize());
+
+    const char* data = nullptr;
+    ASSERT_TRUE(sink.GetContiguousData(data));
+    ASSERT_EQ(0, memcmp(bodyStr, data, strlen(bodyStr)));
+
+    Json::JsonValue json(data, sink.GetSize());
+    ASSERT_TRUE(json.WasParseSuccessful());
+    ASSERT_EQ(2u, json.GetArray("TableNames").GetLength());
+}
+
+TEST(ResponseBodySinkTest, ContiguousSinkStreamReadAndSeek)
+{
+    ResponseBodySinkStream stream(Aws::New<ContiguousBodySink>(SINK_TEST_TAG));
+    stream.GetSink()->Append(bodyStr, strlen(bodyStr));
+    ASSERT_EQ(static_cast<std::streamoff>(strlen(bodyStr)), static_cast<std::streamoff>(stream.tellp()));
+
+    Aws::String body((Aws::IStreamBufIterator(stream)), Aws::IStreamBufIterator());
+    ASSERT_STREQ(bodyStr, body.c_str());
+
+    stream.clear();
+    stream.seekg(2, std::ios_base::beg);
+    char readBuf[11] = {};
+    stream.read(readBuf, 10);
+    ASSERT_EQ(10, stream.gcount());
+    ASSERT_EQ(0, memcmp(bodyStr + 2, readBuf, 10));
+
+    //writes through the stream land after the appended data.
+    stream << "tail";
+    ASSERT_EQ(strlen(bodyStr) + 4, stream.GetSink()->GetSize());
+}
+
+TEST(ResponseBodySinkTest, FixedBufferSinkRejectsOverflow)
+{
+    char buffer[16];
+    FixedBufferBodySink sink(buffer, sizeof(buffer));
+    sink.Reserve(1024);
+
+    ASSERT_EQ(sizeof(buffer), sink.Append(bodyStr, strlen(bodyStr)));
+    ASSERT_EQ(0u, sink.Append(bodyStr, 1));
+    ASSERT_EQ(sizeof(buffer), sink.GetSize());
+
+    const char* data = nullptr;
+    ASSERT_TRUE(sink.GetContiguousData(data));
+    ASSERT_EQ(buffer, data);
+    ASSERT_EQ(0, memcmp(bodyStr, buffer, sizeof(buffer)));
+}
+
+TEST(ResponseBodySinkTest, ChunkedSinkScattersOverPooledChunks)
+{
+    auto pool = Aws::MakeShared<BodyChunkPool>(SINK_TEST_TAG, 8, 8);
+    const char* lastChunk = nullptr;
+    {
+        ChunkedBodySink sink(pool);
+        ASSERT_EQ(strlen(bodyStr), sink.Append(bodyStr, strlen(bodyStr)));
+        ASSERT_EQ(strlen(bodyStr), sink.GetSize());
+
+        const char* data = nullptr;
+        ASSERT_FALSE(sink.GetContiguousData(data));
+
+        auto chunks = sink.GetChunks();
+        ASSERT_EQ((strlen(bodyStr) + 7) / 8, chunks.size());
+        Aws::String gathered;
+        for (auto& chunk : chunks)
+        {
+            gathered.append(chunk.first, chunk.second);
+        }
+        ASSERT_STREQ(bodyStr, gathered.c_str());
+        lastChunk = chunks.back().first;
+
+        Aws::IOStream stream(&sink);
+        Aws::String body((Aws::IStreamBufIterator(stream)), Aws::IStreamBufIterator());
+        ASSERT_STREQ(bodyStr, body.c_str());
+
+        stream.clear();
+        stream.seekg(-6, std::ios_base::end);
+        char readBuf[7] = {};
+        stream.read(readBuf, 6);
+        ASSERT_STREQ(bodyStr + strlen(bodyStr) - 6, readBuf);
+        ASSERT_EQ(static_cast<std::streamoff>(strlen(bodyStr)), static_cast<std::streamoff>(stream.tellp()));
+    }
+
+    //chunks go back to the pool when the sink goes away.
+    char* reused = pool->Acquire();
+    ASSERT_EQ(lastChunk, reused);
+    pool->Release(reused);
+}
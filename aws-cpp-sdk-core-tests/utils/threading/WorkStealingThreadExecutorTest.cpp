@@ -0,0 +1,114 @@
+/*
+* Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+*
+* Licensed under the Apache License, Version 2.0 (the "License").
+* You may not use this file except in compliance with the License.
+* A copy of the License is located at
+*
+*  http://aws.amazon.com/apache2.0
+*
+* or in the "license" file accompanying this file. This file is distributed
+* on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+* express or implied. See the License for the specific language governing
+* permissions and limitations under the License.
+*/
+
+#include <aws/external/gtest.h>
+#include <aws/core/utils/threading/Executor.h>
+#include <aws/core/utils/threading/Semaphore.h>
+#include <aws/core/utils/memory/stl/AWSString.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+using namespace Aws::Utils::Threading;
+
+TEST(WorkStealingThreadExecutor, RunsEverySubmittedTask)
+{
+    static const int TASK_COUNT = 10000;
+    std::atomic<int> completed(0);
+    Semaphore done(0, 1);
+    {
+        WorkStealingThreadExecutor exec(4);
+        for (int i = 0; i < TASK_COUNT; ++i)
+        {
+            ASSERT_TRUE(exec.Submit([&] { if (++completed == TASK_COUNT) done.Release(); }));
+        }
+        done.WaitOne();
+    }
+    ASSERT_EQ(TASK_COUNT, completed.load());
+}
+
+TEST(WorkStealingThreadExecutor, TasksSubmittedFromWorkersAreStolenByIdleWorkers)
+{
+    static const int CHILD_COUNT = 64;
+    std::atomic<int> completed(0);
+    std::atomic<bool> release(false);
+    Semaphore done(0, 1);
+    {
+        WorkStealingThreadExecutor exec(4);
+        // the parent task queues every child on its own worker's deque and then keeps that worker busy, so the children can only
+        // run by being stolen.
+        exec.Submit([&] {
+            for (int i = 0; i < CHILD_COUNT; ++i)
+            {
+                exec.Submit([&] { if (++completed == CHILD_COUNT) done.Release(); });
+            }
+            while (!release)
+            {
+                std::this_thread::yield();
+            }
+        });
+        done.WaitOne();
+        release = true;
+    }
+    ASSERT_EQ(CHILD_COUNT, completed.load());
+}
+
+TEST(WorkStealingThreadExecutor, RejectsWhenQueueIsFull)
+{
+    Semaphore blocker(0, 2);
+    Semaphore started(0, 2);
+    std::atomic<int> completed(0);
+    {
+        WorkStealingThreadExecutor exec(2, OverflowPolicy::REJECT_IMMEDIATELY);
+        ASSERT_TRUE(exec.Submit([&] { started.Release(); blocker.WaitOne(); ++completed; }));
+        ASSERT_TRUE(exec.Submit([&] { started.Release(); blocker.WaitOne(); ++completed; }));
+        started.WaitOne();
+        started.WaitOne();
+
+        ASSERT_TRUE(exec.Submit([&] { ++completed; }));
+        ASSERT_TRUE(exec.Submit([&] { ++completed; }));
+        ASSERT_FALSE(exec.Submit([&] { ++completed; }));
+
+        blocker.ReleaseAll();
+        while (completed < 4)
+        {
+            std::this_thread::yield();
+        }
+    }
+    ASSERT_EQ(4, completed.load());
+}
+
+TEST(WorkStealingThreadExecutor, DropsQueuedTasksOnDestruction)
+{
+    Semaphore blocker(0, 1);
+    Semaphore started(0, 1);
+    std::atomic<int> completed(0);
+    std::thread releaser;
+    {
+        WorkStealingThreadExecutor exec(1, OverflowPolicy::QUEUE_TASKS_EVENLY_ACCROSS_THREADS, true);
+        exec.Submit([&] { started.Release(); blocker.WaitOne(); });
+        started.WaitOne();
+        for (int i = 0; i < 100; ++i)
+        {
+            // large enough captures that the tasks own heap memory, which the memory system checks is released.
+            Aws::String payload(256, 'x');
+            exec.Submit([&completed, payload] { ++completed; });
+        }
+        // the only worker is released after the destructor below has stopped it, so it must drop the queued tasks rather than run them.
+        releaser = std::thread([&blocker] { std::this_thread::sleep_for(std::chrono::milliseconds(100)); blocker.Release(); });
+    }
+    releaser.join();
+    ASSERT_EQ(0, completed.load());
+}
@@ -0,0 +1,269 @@
+
+/*
+* Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+*
+* Licensed under the Apache License, Version 2.0 (the "License").
+* You may not use this file except in compliance with the License.
+* A copy of the License is located at
+*
+*  http://aws.amazon.com/apache2.0
+*
+* or in the "license" file accompanying this file. This file is distributed
+* on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+* express or implied. See the License for the specific language governing
+* permissions and limitations under the License.
+*/
+
+#include <aws/external/gtest.h>
+
+#include <aws/core/utils/xml/XmlReader.h>
+#include <aws/core/utils/DateTime.h>
+#include <aws/core/utils/memory/stl/AWSStringStream.h>
+
+using namespace Aws::Utils::Xml;
+using namespace Aws::Utils;
+
+namespace XmlReaderTestModel
+{
+    enum class StorageClass
+    {
+        NOT_SET,
+        STANDARD,
+        GLACIER
+    };
+
+    inline bool ReadXml(XmlReader& reader, StorageClass& value)
+    {
+        Aws::String name;
+        if (!Aws::Utils::Xml::ReadXml(reader, name))
+        {
+            return false;
+        }
+        value = name == "STANDARD" ? StorageClass::STANDARD : name == "GLACIER" ? StorageClass::GLACIER : StorageClass::NOT_SET;
+        return true;
+    }
+
+    // laid out the way the generator emits structures.
+    class Object
+    {
+    public:
+        Object() : m_size(0), m_storageClass(StorageClass::NOT_SET), m_keyHasBeenSet(false), m_sizeHasBeenSet(false) {}
+
+        bool Deserialize(XmlReader& reader)
+        {
+            Aws::String name;
+            while (reader.NextChild(name))
+            {
+                bool read = true;
+                if (name == "Key")
+                {
+                    read = ReadXml(reader, m_key);
+                    m_keyHasBeenSet = true;
+                }
+                else if (name == "Size")
+                {
+                    read = ReadXml(reader, m_size);
+                    m_sizeHasBeenSet = true;
+                }
+                else if (name == "LastModified") read = ReadXml(reader, m_lastModified);
+                else if (name == "StorageClass") read = ReadXml(reader, m_storageClass);
+                else read = reader.SkipElement();
+
+                if (!read)
+                {
+                    return false;
+                }
+            }
+            return !reader.HasError();
+        }
+
+        Aws::String m_key;
+        long long m_size;
+        DateTime m_lastModified;
+        StorageClass m_storageClass;
+        bool m_keyHasBeenSet;
+        bool m_sizeHasBeenSet;
+    };
+
+    class ListResult
+    {
+    public:
+        ListResult() : m_keyCount(0), m_truncated(false), m_ratio(0.0) {}
+
+        bool Deserialize(XmlReader& reader)
+        {
+            Aws::String name;
+            while (reader.NextChild(name))
+            {
+                bool read = true;
+                if (name == "Name") read = ReadXml(reader, m_name);
+                else if (name == "KeyCount") read = ReadXml(reader, m_keyCount);
+                else if (name == "IsTruncated") read = ReadXml(reader, m_truncated);
+                else if (name == "Ratio") read = ReadXml(reader, m_ratio);
+                else if (name == "Token") read = ReadXml(reader, m_token);
+                else if (name == "Contents") read = ReadXmlListItem(reader, m_contents);
+                else if (name == "Prefixes") read = ReadXmlList(reader, m_prefixes, "member");
+                else if (name == "Tags") read = ReadXmlMap(reader, m_tags, "entry", "key", "value");
+                else if (name == "Attribute") read = ReadXmlMapEntry(reader, m_attributes, "Name", "Value");
+                else read = reader.SkipElement();
+
+                if (!read)
+                {
+                    return false;
+                }
+            }
+            return !reader.HasError();
+        }
+
+        Aws::String m_name;
+        int m_keyCount;
+        bool m_truncated;
+        double m_ratio;
+        ByteBuffer m_token;
+        Aws::Vector<Object> m_contents;
+        Aws::Vector<Aws::String> m_prefixes;
+        Aws::Map<Aws::String, int> m_tags;
+        Aws::Map<Aws::String, Aws::String> m_attributes;
+    };
+
+    // reads the document element the way the generated result constructors do.
+    inline bool ReadDocument(XmlReader& reader, ListResult& result, const char* rootName)
+    {
+        Aws::String name;
+        if (!reader.NextChild(name) || name != rootName)
+        {
+            return false;
+        }
+        return ReadXml(reader, result);
+    }
+}
+
+using namespace XmlReaderTestModel;
+
+static const char* LIST_XML =
+    "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+    "<!-- listing -->\n"
+    "<ListBucketResult xmlns=\"http://s3.amazonaws.com/doc/2006-03-01/\">\n"
+    "  <Name> bucket </Name>\n"
+    "  <KeyCount>2</KeyCount>\n"
+    "  <IsTruncated>true</IsTruncated>\n"
+    "  <Ratio>0.25</Ratio>\n"
+    "  <Token>aGVsbG8=</Token>\n"
+    "  <Unknown a=\"x>y\" b='/>'><Nested><Deeper>1</Deeper></Nested><Empty/></Unknown>\n"
+    "  <Contents><Key>a&amp;b &lt;c&gt; &#65;&#x42;&#xe9;</Key><Size>9007199254740993</Size>"
+    "<LastModified>2016-06-17T19:54:44.000Z</LastModified><StorageClass>GLACIER</StorageClass></Contents>\n"
+    "  <Contents><Key><![CDATA[raw <text> & more]]></Key><StorageClass/></Contents>\n"
+    "  <Prefixes><member>one/</member><!-- skipped --><other>x</other><member>two/</member></Prefixes>\n"
+    "  <Tags><entry><key>red</key><value>1</value></entry><entry><value>2</value><key>green</key></entry></Tags>\n"
+    "  <Attribute><Name>Policy</Name><Value>{}</Value></Attribute>\n"
+    "  <Attribute><Name>Arn</Name><Value/></Attribute>\n"
+    "</ListBucketResult>\n";
+
+TEST(XmlReaderTest, TestReadGeneratedStyleStructure)
+{
+    XmlReader reader(LIST_XML, strlen(LIST_XML));
+    ListResult result;
+    ASSERT_TRUE(ReadDocument(reader, result, "ListBucketResult")) << reader.GetErrorMessage();
+    ASSERT_FALSE(reader.HasError());
+
+    ASSERT_EQ("bucket", result.m_name);
+    ASSERT_EQ(2, result.m_keyCount);
+    ASSERT_TRUE(result.m_truncated);
+    ASSERT_DOUBLE_EQ(0.25, result.m_ratio);
+    ASSERT_EQ(5u, result.m_token.GetLength());
+    ASSERT_EQ('h', result.m_token[0]);
+
+    ASSERT_EQ(2u, result.m_contents.size());
+    ASSERT_EQ("a&b <c> AB\xC3\xA9", result.m_contents[0].m_key);
+    ASSERT_EQ(9007199254740993LL, result.m_contents[0].m_size);
+    ASSERT_EQ(1466193284000LL, result.m_contents[0].m_lastModified.Millis());
+    ASSERT_EQ(StorageClass::GLACIER, result.m_contents[0].m_storageClass);
+    ASSERT_EQ("raw <text> & more", result.m_contents[1].m_key);
+    ASSERT_FALSE(result.m_contents[1].m_sizeHasBeenSet);
+    ASSERT_EQ(StorageClass::NOT_SET, result.m_contents[1].m_storageClass);
+
+    ASSERT_EQ(2u, result.m_prefixes.size());
+    ASSERT_EQ("one/", result.m_prefixes[0]);
+    ASSERT_EQ("two/", result.m_prefixes[1]);
+
+    ASSERT_EQ(2u, result.m_tags.size());
+    ASSERT_EQ(1, result.m_tags["red"]);
+    ASSERT_EQ(2, result.m_tags["green"]);
+
+    ASSERT_EQ(2u, result.m_attributes.size());
+    ASSERT_EQ("{}", result.m_attributes["Policy"]);
+    ASSERT_EQ("", result.m_attributes["Arn"]);
+
+    Aws::String name;
+    ASSERT_FALSE(reader.NextChild(name));
+    ASSERT_FALSE(reader.HasError());
+}
+
+TEST(XmlReaderTest, TestStreamInputMatchesBufferInput)
+{
+    // large enough to straddle several refills of the reader's chunk buffer.
+    Aws::StringStream xml;
+    xml << "<ListBucketResult>";
+    for (int i = 0; i < 2000; ++i)
+    {
+        xml << "<Contents><Key>key&#233;&amp;-" << i << "</Key><!-- c --><Size>" << i << "</Size></Contents>";
+    }
+    xml << "</ListBucketResult>";
+
+    ListResult result;
+    XmlReader reader(xml);
+    ASSERT_TRUE(ReadDocument(reader, result, "ListBucketResult")) << reader.GetErrorMessage();
+
+    ASSERT_EQ(2000u, result.m_contents.size());
+    ASSERT_EQ("key\xC3\xA9&-1999", result.m_contents[1999].m_key);
+    ASSERT_EQ(1999, result.m_contents[1999].m_size);
+}
+
+TEST(XmlReaderTest, TestMixedContentKeepsOnlyText)
+{
+    const char* xml = "<Message>before <b>bold <i>nested</i></b>after<?pi x?></Message>";
+    XmlReader reader(xml, strlen(xml));
+    Aws::String name, text;
+    ASSERT_TRUE(reader.NextChild(name));
+    ASSERT_EQ("Message", name);
+    ASSERT_TRUE(reader.ReadText(text));
+    ASSERT_EQ("before after", text);
+    ASSERT_FALSE(reader.NextChild(name));
+    ASSERT_FALSE(reader.HasError());
+}
+
+TEST(XmlReaderTest, TestMalformedInputLatchesError)
+{
+    const char* inputs[] = {
+        "<ListBucketResult><Name>x</Nam></ListBucketResult>",
+        "<ListBucketResult><Name>x</Name>",
+        "<ListBucketResult><Contents><Key>x</Key></ListBucketResult>",
+        "<ListBucketResult><Name>a &bogus; b</Name></ListBucketResult>",
+        "<ListBucketResult><Name>a &#xZZ; b</Name></ListBucketResult>",
+        "<ListBucketResult><Unknown a=\"x></Unknown></ListBucketResult>",
+        "<ListBucketResult><Name><![CDATA[open</Name></ListBucketResult>",
+        "<ListBucketResult><!-- unterminated </ListBucketResult>",
+        "<ListBucketResult></>"
+    };
+
+    for (const char* input : inputs)
+    {
+        XmlReader reader(input, strlen(input));
+        ListResult result;
+        ASSERT_FALSE(ReadDocument(reader, result, "ListBucketResult") && !reader.HasError()) << input;
+        ASSERT_TRUE(reader.HasError()) << input;
+        ASSERT_FALSE(reader.GetErrorMessage().empty());
+
+        Aws::String name;
+        ASSERT_FALSE(reader.NextChild(name));
+    }
+}
+
+TEST(XmlReaderTest, TestErrorReportsOffset)
+{
+    const char* xml = "<A><B>1</C></A>";
+    XmlReader reader(xml, strlen(xml));
+    ListResult result;
+    ASSERT_FALSE(ReadDocument(reader, result, "A"));
+    ASSERT_STREQ("Expected matching end tag at offset 11", reader.GetErrorMessage().c_str());
+}
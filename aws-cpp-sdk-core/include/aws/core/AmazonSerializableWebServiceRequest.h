@@ -31,7 +31,7 @@ namespace Aws
     static const char* AMZN_XML_CONTENT_TYPE = "application/xml";
 
     /**
-     * High-level abstraction over AWS requests. GetBody() calls SerializePayload() and uses a stringbuf under the hood.
+     * High-level abstraction over AWS requests. GetBody() calls AppendSerializedPayload() and serves the result from a pooled buffer.
      * This is for payloads such as query, xml, or json
      */
     class AWS_CORE_API AmazonSerializableWebServiceRequest : public AmazonWebServiceRequest
@@ -56,7 +56,13 @@ namespace Aws
         virtual Aws::String SerializePayload() const = 0;
 
         /**
-         * Loads serialized payload into string buf and returns the stream
+         * Appends the serialized payload to payload, which may be a reused buffer with capacity left over from an earlier request.
+         * Defaults to SerializePayload(); override to serialize straight into the buffer.
+         */
+        virtual void AppendSerializedPayload(Aws::String& payload) const;
+
+        /**
+         * Serializes the payload into a pooled buffer and returns a stream over it, or nullptr if the payload is empty
          */
         std::shared_ptr<Aws::IOStream> GetBody() const override;
     };
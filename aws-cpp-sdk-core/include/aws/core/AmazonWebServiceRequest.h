@@ -24,6 +24,7 @@
 #include <aws/core/http/HttpRequest.h>
 #include <aws/core/utils/memory/stl/AWSStreamFwd.h>
 #include <aws/core/utils/stream/ResponseStream.h>
+#include <aws/core/utils/stream/ResponseBodySink.h>
 #include <aws/core/auth/AWSAuthSigner.h>
 
 namespace Aws
@@ -81,9 +82,18 @@ namespace Aws
          */
         const Aws::IOStreamFactory& GetResponseStreamFactory() const { return m_responseStreamFactory; }
         /**
-         * Set the response stream factory.
+         * Set the response stream factory. This replaces the default response body sink, the response is written to the streams it creates.
          */
-        void SetResponseStreamFactory(const Aws::IOStreamFactory& factory) { m_responseStreamFactory = AWS_BUILD_FUNCTION(factory); }
+        void SetResponseStreamFactory(const Aws::IOStreamFactory& factory) { m_responseStreamFactory = AWS_BUILD_FUNCTION(factory); m_responseBodySinkFactory = nullptr; }
+        /**
+         * Retrieves the factory for the sink the response body is written into. Defaults to a ContiguousBodySink.
+         */
+        const Aws::Utils::Stream::ResponseBodySinkFactory& GetResponseBodySinkFactory() const { return m_responseBodySinkFactory; }
+        /**
+         * Set the factory for the sink the response body is written into, e.g. a FixedBufferBodySink or a ChunkedBodySink.
+         * Takes precedence over the response stream factory.
+         */
+        void SetResponseBodySinkFactory(const Aws::Utils::Stream::ResponseBodySinkFactory& factory) { m_responseBodySinkFactory = factory; }
         /**
          * Register closure for data recieved event.
          */
@@ -148,6 +158,7 @@ namespace Aws
 
     private:
         Aws::IOStreamFactory m_responseStreamFactory;
+        Aws::Utils::Stream::ResponseBodySinkFactory m_responseBodySinkFactory;
 
         Aws::Http::DataReceivedEventHandler m_onDataReceived;
         Aws::Http::DataSentEventHandler m_onDataSent;
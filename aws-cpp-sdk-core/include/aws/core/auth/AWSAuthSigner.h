@@ -34,6 +34,7 @@ namespace Aws
     {
         class HttpClientFactory;
         class HttpRequest;
+        class URI;
     } // namespace Http
 
     namespace Utils
@@ -78,6 +79,12 @@ namespace Aws
              */
             virtual bool SignRequest(Aws::Http::HttpRequest& request, bool signBody) const { AWS_UNREFERENCED_PARAM(signBody); return SignRequest(request); }
 
+            /**
+             * True if SignRequest(request, signBody) will compute the sha256 of a non empty body sent to uri. A caller reading the body anyway
+             * can compute it in the same pass and hand it over with HttpRequest::SetContentBodyDigest. The default signer never hashes the body.
+             */
+            virtual bool HashesPayload(const Aws::Http::URI& uri, bool signBody) const { AWS_UNREFERENCED_PARAM(uri); AWS_UNREFERENCED_PARAM(signBody); return false; }
+
             /**
              * Takes a request and signs the URI based on the HttpMethod, URI and other info from the request.
              * The URI can then be used in a normal HTTP call until expiration.
@@ -101,6 +108,11 @@ namespace Aws
              */
             virtual const char* GetName() const = 0;
 
+            /**
+             * Returns the name of the service requests are signed for, or an empty string if the signer is not bound to a service.
+             */
+            virtual const char* GetServiceName() const { return ""; }
+
             /**
              * This handles detection of clock skew between clients and the server and adjusts the clock so that the next request will not
              * fail on the timestamp check.
@@ -145,6 +157,11 @@ namespace Aws
              */
             const char* GetName() const override { return Aws::Auth::SIGV4_SIGNER; }
 
+            /**
+             * Returns the service name the signer was initialized with.
+             */
+            const char* GetServiceName() const override { return m_serviceName.c_str(); }
+
             /**
              * Signs the request itself based on info in the request and uri.
              * Uses AWS Auth V4 signing method with SHA256 HMAC algorithm.
@@ -158,6 +175,11 @@ namespace Aws
             */
             bool SignRequest(Aws::Http::HttpRequest& request, bool signBody) const override;
 
+            /**
+            * True if the payload of a request to uri is signed and not sent aws-chunked, see SetPayloadSigningChunkSize.
+            */
+            bool HashesPayload(const Aws::Http::URI& uri, bool signBody) const override;
+
             /**
             * Takes a request and signs the URI based on the HttpMethod, URI and other info from the request.
             * the region the signer was initialized with will be used for the signature.
@@ -183,34 +205,67 @@ namespace Aws
             */
             bool PresignRequest(Aws::Http::HttpRequest& request, const char* region, const char* serviceName, long long expirationInSeconds = 0) const override;
 
+            /**
+            * When chunkSize is non zero, requests with a content-length whose payload would be signed are signed with STREAMING-AWS4-HMAC-SHA256-PAYLOAD
+            * instead of hashing the whole body up front. The body is then sent aws-chunked and each chunk is signed as the http client reads it,
+            * so the payload is only read once and doesn't need to be seekable. Only Amazon S3 accepts aws-chunked bodies.
+            * Set this before sharing the signer between threads. Defaults to 0, disabled.
+            */
+            void SetPayloadSigningChunkSize(size_t chunkSize) { m_payloadSigningChunkSize = chunkSize; }
+
+            /**
+            * Chunk size used for streaming payload signing, 0 if disabled.
+            */
+            size_t GetPayloadSigningChunkSize() const { return m_payloadSigningChunkSize; }
+
         protected:
             bool m_includeSha256HashHeader;
 
         private:
-            Aws::String GenerateSignature(const Aws::Auth::AWSCredentials& credentials, const Aws::String& stringToSign, const Aws::String& simpleDate) const;
+            struct CanonicalRequestBuffers;
+            static const size_t CANONICAL_REQUEST_BUFFER_SLOTS = 16;
+
+            bool SignRequestWithBuffers(Aws::Http::HttpRequest& request, bool signBody, CanonicalRequestBuffers& buffers) const;
+            void AppendCanonicalHeaders(const Aws::Http::HttpRequest& request, CanonicalRequestBuffers& buffers) const;
+            CanonicalRequestBuffers* AcquireCanonicalRequestBuffers() const;
+            void ReleaseCanonicalRequestBuffers(CanonicalRequestBuffers* buffers) const;
+            class DerivedKeyCache;
+
+            Aws::String GenerateSignature(const Aws::Auth::AWSCredentials& credentials, const Aws::String& stringToSign, const Aws::String& simpleDate,
+                const Aws::String& region, const Aws::String& serviceName) const;
             Aws::String ComputePayloadHash(Aws::Http::HttpRequest&) const;
-            Aws::String GenerateStringToSign(const Aws::String& dateValue, const Aws::String& simpleDate, const Aws::String& canonicalRequestHash) const;
-            const Aws::Utils::ByteBuffer& ComputeLongLivedHash(const Aws::String& secretKey, const Aws::String& simpleDate) const;
+            Aws::String GenerateStringToSign(const Aws::String& dateValue, const Aws::String& simpleDate, const Aws::String& credentialScopeSuffix,
+                const Aws::String& canonicalRequestHash) const;
+            Aws::Utils::ByteBuffer ComputeLongLivedHash(const Aws::String& secretKey, const Aws::String& simpleDate,
+                const Aws::String& region, const Aws::String& serviceName) const;
+            Aws::Utils::ByteBuffer DeriveSigningKey(const Aws::String& secretKey, const Aws::String& simpleDate,
+                const Aws::String& region, const Aws::String& serviceName) const;
 
             bool ShouldSignHeader(const Aws::String& header) const;
+            bool ShouldStreamPayload(const Aws::Http::HttpRequest& request) const;
+            void PrepareStreamingPayloadHeaders(Aws::Http::HttpRequest& request) const;
+            void AttachStreamingPayload(Aws::Http::HttpRequest& request, const Aws::Auth::AWSCredentials& credentials,
+                const Aws::String& dateValue, const Aws::String& simpleDate, const Aws::String& seedSignature) const;
 
             std::shared_ptr<Auth::AWSCredentialsProvider> m_credentialsProvider;
             Aws::String m_serviceName;
             Aws::String m_region;
+            //"/<region>/<service>/aws4_request", the part of the credential scope that never changes.
+            Aws::String m_credentialScopeSuffix;
             Aws::UniquePtr<Aws::Utils::Crypto::Sha256> m_hash;
             Aws::UniquePtr<Aws::Utils::Crypto::Sha256HMAC> m_HMAC;
 
             Aws::Set<Aws::String> m_unsignedHeaders;
 
-            //these next four fields are ONLY for caching purposes and do not change
-            //the logical state of the signer. They are marked mutable so the
-            //interface can remain const.
-            mutable Aws::Utils::ByteBuffer m_partialSignature;
-            mutable Aws::String m_currentDateStr;
-            mutable Aws::String m_currentSecretKey;
-            mutable std::mutex m_partialSignatureLock;
+            //derived signing keys, keyed by secret key, date, region and service. Lookups take no lock, see DerivedKeyCache.
+            //this is ONLY for caching purposes and does not change the logical state of the signer.
+            Aws::UniquePtr<DerivedKeyCache> m_derivedKeys;
+            //canonical request buffers are reused between requests so that steady state signing doesn't allocate them.
+            //a thread takes a buffer out of a slot for the duration of a SignRequest call and puts it back afterwards.
+            mutable std::atomic<CanonicalRequestBuffers*> m_canonicalRequestBuffers[CANONICAL_REQUEST_BUFFER_SLOTS];
             bool m_signPayloads;
             bool m_urlEscapePath;
+            size_t m_payloadSigningChunkSize;
         };
 
 
@@ -0,0 +1,120 @@
+
+/*
+* Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+*
+* Licensed under the Apache License, Version 2.0 (the "License").
+* You may not use this file except in compliance with the License.
+* A copy of the License is located at
+*
+*  http://aws.amazon.com/apache2.0
+*
+* or in the "license" file accompanying this file. This file is distributed
+* on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+* express or implied. See the License for the specific language governing
+* permissions and limitations under the License.
+*/
+
+#pragma once
+
+#include <aws/core/Core_EXPORTS.h>
+#include <aws/core/utils/Array.h>
+#include <aws/core/utils/memory/AWSMemory.h>
+#include <aws/core/utils/memory/stl/AWSStreamFwd.h>
+#include <aws/core/utils/memory/stl/AWSString.h>
+#include <streambuf>
+
+namespace Aws
+{
+    namespace Utils
+    {
+        namespace Crypto
+        {
+            class Sha256;
+            class Sha256HMAC;
+        } // namespace Crypto
+    } // namespace Utils
+
+    namespace Client
+    {
+        /**
+         * Read only streambuf that encodes a payload stream with the aws-chunked content encoding used by
+         * STREAMING-AWS4-HMAC-SHA256-PAYLOAD signing. The payload is read one chunk at a time, and each chunk is hashed and signed,
+         * chained off the previous chunk's signature starting from the seed signature of the request, as it is pulled by the http client.
+         * The payload is therefore only read once and does not need to be seekable. A final zero length chunk terminates the body.
+         *
+         * This streambuf is not seekable.
+         */
+        class AWS_CORE_API AWSChunkedPayloadStreamBuf : public std::streambuf
+        {
+        public:
+            /**
+             * payload, stream to read the raw payload from.
+             * signingKey, the derived sigv4 signing key the seed signature was computed with.
+             * dateValue, the x-amz-date value of the request.
+             * scope, the credential scope of the request (date/region/service/aws4_request).
+             * seedSignature, the signature of the request headers.
+             * chunkSize, payload bytes per chunk. Only the last data chunk may be shorter, S3 requires at least 8KB.
+             */
+            AWSChunkedPayloadStreamBuf(const std::shared_ptr<Aws::IOStream>& payload, const Aws::Utils::ByteBuffer& signingKey,
+                const Aws::String& dateValue, const Aws::String& scope, const Aws::String& seedSignature, size_t chunkSize);
+
+            ~AWSChunkedPayloadStreamBuf();
+
+            AWSChunkedPayloadStreamBuf(const AWSChunkedPayloadStreamBuf&) = delete;
+            AWSChunkedPayloadStreamBuf& operator=(const AWSChunkedPayloadStreamBuf&) = delete;
+
+            /**
+             * Number of raw payload bytes that have been read out of this buffer so far, excluding chunk framing.
+             */
+            long long GetPayloadBytesSent() const;
+
+            /**
+             * Size of the aws-chunked encoding of a payload of payloadLength bytes, this is the content-length to send.
+             */
+            static long long ComputeEncodedLength(long long payloadLength, size_t chunkSize);
+
+        protected:
+            int_type underflow() override;
+
+        private:
+            bool EncodeNextChunk();
+
+            std::shared_ptr<Aws::IOStream> m_payload;
+            Aws::Utils::ByteBuffer m_signingKey;
+            Aws::String m_stringToSignPrefix;
+            Aws::String m_previousSignature;
+            Aws::Utils::Array<char> m_buffer;
+            Aws::UniquePtr<Aws::Utils::Crypto::Sha256> m_hash;
+            Aws::UniquePtr<Aws::Utils::Crypto::Sha256HMAC> m_HMAC;
+            size_t m_chunkSize;
+            char* m_chunkData;
+            size_t m_chunkLength;
+            long long m_payloadSentBeforeChunk;
+            bool m_finalChunkSent;
+        };
+
+        /**
+         * IOStream over an AWSChunkedPayloadStreamBuf. This is the content body the signer attaches to requests it signs with
+         * STREAMING-AWS4-HMAC-SHA256-PAYLOAD.
+         */
+        class AWS_CORE_API AWSChunkedPayloadStream : public Aws::IOStream
+        {
+        public:
+            using Base = Aws::IOStream;
+
+            AWSChunkedPayloadStream(const std::shared_ptr<Aws::IOStream>& payload, const Aws::Utils::ByteBuffer& signingKey,
+                const Aws::String& dateValue, const Aws::String& scope, const Aws::String& seedSignature, size_t chunkSize);
+
+            AWSChunkedPayloadStream(const AWSChunkedPayloadStream&) = delete;
+            AWSChunkedPayloadStream& operator=(const AWSChunkedPayloadStream&) = delete;
+
+            /**
+             * Number of raw payload bytes that have been read out of this stream so far, excluding chunk framing.
+             */
+            inline long long GetPayloadBytesSent() const { return m_buf.GetPayloadBytesSent(); }
+
+        private:
+            AWSChunkedPayloadStreamBuf m_buf;
+        };
+    } // namespace Client
+} // namespace Aws
@@ -24,6 +24,8 @@
 #include <aws/core/internal/AWSHttpResourceClient.h>
 #include <memory>
 #include <mutex>
+#include <atomic>
+#include <cstdint>
 
 namespace Aws
 {
@@ -37,6 +39,9 @@ namespace Aws
     {
         static int REFRESH_THRESHOLD = 1000 * 60 * 15;
         static int EXPIRATION_GRACE_PERIOD = 5 * 1000;
+        static int BACKGROUND_REFRESH_PREFETCH_WINDOW = 1000 * 60 * 5;
+
+        class AWSCredentialsRefreshScheduler;
 
         /**
          * Simple data object around aws credentials
@@ -128,6 +133,16 @@ namespace Aws
                 m_sessionToken = sessionToken;
             }
 
+            inline bool operator==(const AWSCredentials& other) const
+            {
+                return m_accessKeyId == other.m_accessKeyId && m_secretKey == other.m_secretKey && m_sessionToken == other.m_sessionToken;
+            }
+
+            inline bool operator!=(const AWSCredentials& other) const
+            {
+                return !(*this == other);
+            }
+
         private:
             Aws::String m_accessKeyId;
             Aws::String m_secretKey;
@@ -145,7 +160,7 @@ namespace Aws
              * Initializes provider. Sets last Loaded time count to 0, forcing a refresh on the
              * first call to GetAWSCredentials.
              */
-            AWSCredentialsProvider() : m_lastLoadedMs(0)
+            AWSCredentialsProvider() : m_lastLoadedMs(0), m_credentialsVersion(0)
             {
             }
 
@@ -156,6 +171,19 @@ namespace Aws
              */
             virtual AWSCredentials GetAWSCredentials() = 0;
 
+            /**
+             * Returns the current credentials as an immutable snapshot that callers can hold on to instead of copying the credentials, never null.
+             * The same snapshot is handed out for as long as the credentials do not change. The default implementation compares the result of
+             * GetAWSCredentials with the last snapshot; providers that keep their credentials around override it to skip the copy.
+             */
+            virtual std::shared_ptr<const AWSCredentials> GetAWSCredentialsSnapshot();
+
+            /**
+             * Incremented every time GetAWSCredentialsSnapshot starts handing out a new snapshot, so callers can tell whether whatever they
+             * derived from the credentials is still current.
+             */
+            inline uint64_t GetAWSCredentialsVersion() const { return m_credentialsVersion.load(); }
+
         protected:
             /**
              * The default implementation keeps up with the cache times and lets you know if it's time to refresh your internal caching
@@ -163,8 +191,20 @@ namespace Aws
              */
             virtual bool IsTimeToRefresh(long reloadFrequency);
 
+            /**
+             * Atomically replaces the current snapshot and bumps the credentials version.
+             */
+            void PublishAWSCredentialsSnapshot(const std::shared_ptr<const AWSCredentials>& snapshot);
+
+            /**
+             * Atomically loads the current snapshot, null until one has been published.
+             */
+            inline std::shared_ptr<const AWSCredentials> LoadAWSCredentialsSnapshot() const { return std::atomic_load(&m_credentialsSnapshot); }
+
         private:
             long long m_lastLoadedMs;
+            std::shared_ptr<const AWSCredentials> m_credentialsSnapshot;
+            std::atomic<uint64_t> m_credentialsVersion;
         };
 
         /**
@@ -174,10 +214,17 @@ namespace Aws
         class AWS_CORE_API AnonymousAWSCredentialsProvider : public AWSCredentialsProvider
         {
         public:
+            AnonymousAWSCredentialsProvider();
+
             /**
              * Returns empty credentials object.
              */
             inline AWSCredentials GetAWSCredentials() override { return AWSCredentials("", ""); }
+
+            /**
+             * Returns a snapshot of empty credentials.
+             */
+            inline std::shared_ptr<const AWSCredentials> GetAWSCredentialsSnapshot() override { return LoadAWSCredentialsSnapshot(); }
         };
 
         /**
@@ -191,30 +238,28 @@ namespace Aws
             /**
              * Initializes object from awsAccessKeyId, awsSecretAccessKey, and sessionToken parameters. sessionToken parameter is defaulted to empty.
              */
-            inline SimpleAWSCredentialsProvider(const Aws::String& awsAccessKeyId, const Aws::String& awsSecretAccessKey, const Aws::String& sessionToken = "")
-                : m_accessKeyId(awsAccessKeyId), m_secretAccessKey(awsSecretAccessKey), m_sessionToken(sessionToken)
-            { }
+            SimpleAWSCredentialsProvider(const Aws::String& awsAccessKeyId, const Aws::String& awsSecretAccessKey, const Aws::String& sessionToken = "");
 
             /**
             * Initializes object from credentials object. everything is copied.
             */
-            inline SimpleAWSCredentialsProvider(const AWSCredentials& credentials)
-                : m_accessKeyId(credentials.GetAWSAccessKeyId()), m_secretAccessKey(credentials.GetAWSSecretKey()),
-                m_sessionToken(credentials.GetSessionToken())
-            { }
+            SimpleAWSCredentialsProvider(const AWSCredentials& credentials);
 
             /**
              * Returns the credentials this object was initialized with as an AWSCredentials object.
              */
             inline AWSCredentials GetAWSCredentials() override
             {
-                return AWSCredentials(m_accessKeyId, m_secretAccessKey, m_sessionToken);
+                return *LoadAWSCredentialsSnapshot();
             }
 
-        private:
-            Aws::String m_accessKeyId;
-            Aws::String m_secretAccessKey;
-            Aws::String m_sessionToken;
+            /**
+             * Returns the credentials this object was initialized with, without copying them.
+             */
+            inline std::shared_ptr<const AWSCredentials> GetAWSCredentialsSnapshot() override
+            {
+                return LoadAWSCredentialsSnapshot();
+            }
         };
 
         /**
@@ -231,6 +276,75 @@ namespace Aws
             AWSCredentials GetAWSCredentials() override;
         };
 
+        /**
+         * Base class for providers that load credentials from a source that is slow to query and whose credentials need to be refreshed.
+         * The loaded credentials are kept as an immutable snapshot which a refresh swaps as a whole, so readers never wait on a refresh
+         * while the current credentials are still usable.
+         *
+         * By default refreshes happen lazily in GetAWSCredentials: the first caller to find the credentials due for refresh reloads them,
+         * other callers keep getting the previous snapshot until it expires. After EnableBackgroundRefresh, an AWSCredentialsRefreshScheduler
+         * reloads the credentials ahead of time and request threads only read the snapshot.
+         */
+        class AWS_CORE_API RefreshingAWSCredentialsProvider : public AWSCredentialsProvider
+        {
+        public:
+            virtual ~RefreshingAWSCredentialsProvider();
+
+            /**
+             * Returns a copy of the current credentials, see GetAWSCredentialsSnapshot.
+             */
+            AWSCredentials GetAWSCredentials() override;
+
+            /**
+             * Returns the current credentials snapshot, refreshing it first if it is due and no other thread is refreshing it already.
+             * Only blocks when there are no usable credentials yet.
+             */
+            std::shared_ptr<const AWSCredentials> GetAWSCredentialsSnapshot() override;
+
+            /**
+             * Hands the refreshes of this provider to scheduler. Credentials are reloaded prefetchWindowMs before they would be due for
+             * refresh, or halfway there when they are shorter lived than that. The first load is started right away.
+             */
+            void EnableBackgroundRefresh(const std::shared_ptr<AWSCredentialsRefreshScheduler>& scheduler,
+                    long prefetchWindowMs = BACKGROUND_REFRESH_PREFETCH_WINDOW);
+
+            /**
+             * Goes back to lazy refreshes. Waits for a background refresh of this provider that is in progress.
+             */
+            void DisableBackgroundRefresh();
+
+        protected:
+            /**
+             * refreshRateMs is the longest credentials are used before reloading them, retryIntervalMs the time to wait after a failed load
+             * and expirationWindowMs how long before their expiration credentials are reloaded.
+             */
+            RefreshingAWSCredentialsProvider(long refreshRateMs, long retryIntervalMs, long expirationWindowMs = EXPIRATION_GRACE_PERIOD);
+
+            /**
+             * Loads fresh credentials from the source, returns false if they could not be loaded. Set expiration if the credentials expire,
+             * leave it at the epoch otherwise. Never called concurrently for the same provider.
+             *
+             * Subclasses must call DisableBackgroundRefresh from their destructor so that no refresh runs against a partially destroyed object.
+             */
+            virtual bool FetchCredentials(AWSCredentials& credentials, Aws::Utils::DateTime& expiration) = 0;
+
+        private:
+            bool Refresh();
+            int64_t RefreshInBackground();
+
+            std::atomic<int64_t> m_nextRefreshMs;
+            std::atomic<int64_t> m_expirationMs;
+            std::mutex m_refreshMutex;
+            std::shared_ptr<AWSCredentialsRefreshScheduler> m_scheduler;
+            std::mutex m_schedulerMutex;
+            long m_refreshRateMs;
+            long m_retryIntervalMs;
+            long m_expirationWindowMs;
+            std::atomic<int64_t> m_prefetchWindowMs;
+
+            friend class AWSCredentialsRefreshScheduler;
+        };
+
         /**
         * Reads credentials profile from the default Profile Config File. Refreshes at set interval for credential rotation.
         * Looks for environment variables AWS_SHARED_CREDENTIALS_FILE and AWS_PROFILE. If they aren't found, then it defaults
@@ -238,7 +352,7 @@ namespace Aws
         * Optionally a user can specify the profile and it will override the environment variable
         * and defaults. To alter the file this pulls from, then the user should alter the AWS_SHARED_CREDENTIALS_FILE variable.
         */
-        class AWS_CORE_API ProfileConfigFileAWSCredentialsProvider : public AWSCredentialsProvider
+        class AWS_CORE_API ProfileConfigFileAWSCredentialsProvider : public RefreshingAWSCredentialsProvider
         {
         public:
 
@@ -253,10 +367,7 @@ namespace Aws
             */
             ProfileConfigFileAWSCredentialsProvider(const char* profile, long refreshRateMs = REFRESH_THRESHOLD);
 
-            /**
-            * Retrieves the credentials if found, otherwise returns empty credential set.
-            */
-            AWSCredentials GetAWSCredentials() override;
+            ~ProfileConfigFileAWSCredentialsProvider();
 
             /**
              * Returns the fullpath of the calculated config profile file
@@ -273,25 +384,23 @@ namespace Aws
              */
             static Aws::String GetProfileDirectory();
 
-        private:
-
+        protected:
             /**
-            * Checks to see if the refresh interval has expired and reparses the file if it has.
+            * Reparses the files and looks the profile up. Credentials of a profile that is not found are empty.
             */
-            void RefreshIfExpired();
+            bool FetchCredentials(AWSCredentials& credentials, Aws::Utils::DateTime& expiration) override;
 
+        private:
             Aws::String m_profileToUse;
             std::shared_ptr<Aws::Config::AWSProfileConfigLoader> m_configFileLoader;
             std::shared_ptr<Aws::Config::AWSProfileConfigLoader> m_credentialsFileLoader;
-            mutable std::mutex m_reloadMutex;
-            long m_loadFrequencyMs;
         };
 
         /**
         * Credentials provider implementation that loads credentials from the Amazon
         * EC2 Instance Metadata Service.
         */
-        class AWS_CORE_API InstanceProfileCredentialsProvider : public AWSCredentialsProvider
+        class AWS_CORE_API InstanceProfileCredentialsProvider : public RefreshingAWSCredentialsProvider
         {
         public:
             /**
@@ -306,17 +415,16 @@ namespace Aws
              */
             InstanceProfileCredentialsProvider(const std::shared_ptr<Aws::Config::EC2InstanceProfileConfigLoader>&, long refreshRateMs = REFRESH_THRESHOLD);
 
+            ~InstanceProfileCredentialsProvider();
+
+        protected:
             /**
-            * Retrieves the credentials if found, otherwise returns empty credential set.
+            * Pulls the credentials from the EC2 instance metadata service.
             */
-            AWSCredentials GetAWSCredentials() override;
+            bool FetchCredentials(AWSCredentials& credentials, Aws::Utils::DateTime& expiration) override;
 
         private:
-            void RefreshIfExpired();
-
             std::shared_ptr<Aws::Config::AWSProfileConfigLoader> m_ec2MetadataConfigLoader;
-            long m_loadFrequencyMs;
-            mutable std::mutex m_reloadMutex;
         };
 
         /**
@@ -39,6 +39,11 @@ namespace Aws
              */
             virtual AWSCredentials GetAWSCredentials();
 
+            /**
+             * Same as GetAWSCredentials, hands out the snapshot of the first provider that has non-empty credentials.
+             */
+            std::shared_ptr<const AWSCredentials> GetAWSCredentialsSnapshot() override;
+
         protected:
             /**
              * This class is only allowed to be initialized by subclasses.
@@ -0,0 +1,68 @@
+/*
+* Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+*
+* Licensed under the Apache License, Version 2.0 (the "License").
+* You may not use this file except in compliance with the License.
+* A copy of the License is located at
+*
+*  http://aws.amazon.com/apache2.0
+*
+* or in the "license" file accompanying this file. This file is distributed
+* on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+* express or implied. See the License for the specific language governing
+* permissions and limitations under the License.
+*/
+
+#pragma once
+
+#include <aws/core/Core_EXPORTS.h>
+#include <aws/core/utils/memory/stl/AWSMap.h>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <cstdint>
+
+namespace Aws
+{
+    namespace Auth
+    {
+        class RefreshingAWSCredentialsProvider;
+
+        /**
+         * Runs the refreshes of RefreshingAWSCredentialsProviders on one background thread, ahead of the point where request threads would
+         * have to refresh them. A single scheduler can serve any number of providers; providers keep it alive for as long as they use it.
+         */
+        class AWS_CORE_API AWSCredentialsRefreshScheduler
+        {
+        public:
+            AWSCredentialsRefreshScheduler();
+            ~AWSCredentialsRefreshScheduler();
+
+            AWSCredentialsRefreshScheduler(const AWSCredentialsRefreshScheduler&) = delete;
+            AWSCredentialsRefreshScheduler& operator=(const AWSCredentialsRefreshScheduler&) = delete;
+
+            /**
+             * Schedules the next background refresh of provider at dueMs, milliseconds since the epoch, replacing any refresh already scheduled.
+             */
+            void Schedule(RefreshingAWSCredentialsProvider* provider, int64_t dueMs);
+
+            /**
+             * Removes provider from the schedule. If provider is being refreshed right now, waits for that refresh to finish, so provider
+             * is never touched by the scheduler once this returns.
+             */
+            void Cancel(RefreshingAWSCredentialsProvider* provider);
+
+        private:
+            void Run();
+
+            Aws::Map<RefreshingAWSCredentialsProvider*, int64_t> m_dueTimes;
+            RefreshingAWSCredentialsProvider* m_refreshing;
+            bool m_refreshCancelled;
+            bool m_continue;
+            std::mutex m_lock;
+            std::condition_variable m_signal;
+            std::thread m_thread;
+        };
+
+    } // namespace Auth
+} // namespace Aws
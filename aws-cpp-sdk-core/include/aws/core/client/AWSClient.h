@@ -23,6 +23,10 @@
 #include <aws/core/utils/crypto/Hash.h>
 #include <memory>
 #include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
 
 namespace Aws
 {
@@ -82,9 +86,12 @@ namespace Aws
         class AWSAuthSigner;
         struct ClientConfiguration;
         class RetryStrategy;
+        struct RequestAttemptMetrics;
+        class RequestMetricsCollector;
 
         typedef Utils::Outcome<std::shared_ptr<Aws::Http::HttpResponse>, AWSError<CoreErrors>> HttpResponseOutcome;
         typedef Utils::Outcome<AmazonWebServiceResult<Utils::Stream::ResponseStream>, AWSError<CoreErrors>> StreamOutcome;
+        typedef std::function<void(const HttpResponseOutcome&)> HttpResponseOutcomeReceivedHandler;
 
         /**
          * Abstract AWS Client. Contains most of the functionality necessary to build an http request, get it signed, and send it accross the wire.
@@ -156,11 +163,14 @@ namespace Aws
             /**
              * Calls AttemptOnRequest until it either, succeeds, runs out of retries from the retry strategy,
              * or encounters and error that is not retryable.
+             * When a request metrics collector is configured every attempt is reported to it, except that with finalAttemptMetrics set
+             * the last attempt is copied there instead, so the caller can add the payload parse time before reporting it.
              */
             HttpResponseOutcome AttemptExhaustively(const Aws::Http::URI& uri,
                 const Aws::AmazonWebServiceRequest& request,
                 Http::HttpMethod httpMethod,
-                const char* signerName) const;
+                const char* signerName,
+                RequestAttemptMetrics* finalAttemptMetrics = nullptr) const;
 
             /**
              * Calls AttemptOnRequest until it either, succeeds, runs out of retries from the retry strategy,
@@ -169,16 +179,36 @@ namespace Aws
             HttpResponseOutcome AttemptExhaustively(const Aws::Http::URI& uri, 
                     Http::HttpMethod httpMethod,
                     const char* signerName,
-                    const char* requestName = nullptr) const;
+                    const char* requestName = nullptr,
+                    RequestAttemptMetrics* finalAttemptMetrics = nullptr) const;
+
+            /**
+             * Asynchronous version of AttemptExhaustively. The request is sent with HttpClient::MakeRequestAsync and retries are scheduled
+             * with HttpClient::RetryRequestSleepAsync, so with an event driven http client no thread waits on the request.
+             * onCompleted is invoked exactly once, on whichever thread finished the last attempt.
+             */
+            void AttemptExhaustivelyAsync(const Aws::Http::URI& uri,
+                const std::shared_ptr<const Aws::AmazonWebServiceRequest>& request,
+                Http::HttpMethod httpMethod,
+                const char* signerName,
+                const HttpResponseOutcomeReceivedHandler& onCompleted) const;
+
+            /**
+             * Disables request processing and blocks until every attempt started with AttemptExhaustivelyAsync has invoked its handler.
+             * The attempts call back into this client from the http client's threads, so this runs from the destructors of the
+             * subclasses implementing BuildAWSError, before any of the state those attempts use is torn down.
+             */
+            void ShutdownAsyncAttempts();
 
             /**
              * Constructs and Http Request from the uri and AmazonWebServiceRequest object. Signs the request, sends it accross the wire
-             * then reports the http response.
+             * then reports the http response. If metrics is set, the timings of the attempt are recorded into it.
              */
             HttpResponseOutcome AttemptOneRequest(const Aws::Http::URI& uri,
                 const Aws::AmazonWebServiceRequest& request,
                 Http::HttpMethod httpMethod,
-                const char* signerName) const;
+                const char* signerName,
+                RequestAttemptMetrics* metrics = nullptr) const;
 
             /**
             * Constructs and Http Request from the uri and AmazonWebServiceRequest object. Signs the request, sends it accross the wire
@@ -187,7 +217,8 @@ namespace Aws
             HttpResponseOutcome AttemptOneRequest(const Aws::Http::URI& uri, 
                     Http::HttpMethod httpMethod,
                     const char* signerName,
-                    const char* requestName = nullptr) const;
+                    const char* requestName = nullptr,
+                    RequestAttemptMetrics* metrics = nullptr) const;
 
             /**
              * This is used for structureless response payloads (file streams, binary data etc...). It calls AttemptExhaustively, but upon
@@ -213,10 +244,11 @@ namespace Aws
             virtual AWSError<CoreErrors> BuildAWSError(const std::shared_ptr<Aws::Http::HttpResponse>& response) const = 0;
 
             /**
-             * Transforms the AmazonWebServicesResult object into an HttpRequest.
+             * Transforms the AmazonWebServicesResult object into an HttpRequest. If hashPayload is true the signer will hash the body, so its
+             * sha256 is computed along with its Content-MD5.
              */
             virtual void BuildHttpRequest(const Aws::AmazonWebServiceRequest& request,
-                const std::shared_ptr<Aws::Http::HttpRequest>& httpRequest) const;
+                const std::shared_ptr<Aws::Http::HttpRequest>& httpRequest, bool hashPayload = false) const;
 
             /**
              *  Gets the underlying ErrorMarshaller for subclasses to use.
@@ -231,10 +263,30 @@ namespace Aws
              */
             Aws::Client::AWSAuthSigner* GetSignerByName(const char* name) const;
 
+            /**
+             * Gets the request metrics collector from the configuration, nullptr if none was set.
+             */
+            const std::shared_ptr<RequestMetricsCollector>& GetRequestMetricsCollector() const
+            {
+                return m_requestMetricsCollector;
+            }
+
         private:
+            std::shared_ptr<Aws::Http::HttpRequest> BuildAndSignHttpRequest(const Aws::Http::URI& uri,
+                const Aws::AmazonWebServiceRequest& request, Http::HttpMethod httpMethod, const char* signerName,
+                RequestAttemptMetrics* metrics = nullptr) const;
+            HttpResponseOutcome BuildHttpResponseOutcome(const std::shared_ptr<Aws::Http::HttpResponse>& httpResponse) const;
+            bool PrepareRetry(HttpResponseOutcome& outcome, const Aws::AmazonWebServiceRequest& request, const char* signerName,
+                long retries, long& sleepMillis) const;
+            void AttemptAsync(const Aws::Http::URI& uri, const std::shared_ptr<const Aws::AmazonWebServiceRequest>& request,
+                Http::HttpMethod httpMethod, const char* signerName, long retries, std::chrono::microseconds retrySleepTime,
+                const AWSError<CoreErrors>& lastError, const HttpResponseOutcomeReceivedHandler& onCompleted) const;
+            void RequestBookkeeping(const HttpResponseOutcome& outcome, long retries, const AWSError<CoreErrors>& lastError) const;
+            void ReportRequestAttempt(const RequestAttemptMetrics* metrics, RequestAttemptMetrics* finalAttemptMetrics) const;
+            void FinishAsyncAttempt() const;
             void AddHeadersToRequest(const std::shared_ptr<Aws::Http::HttpRequest>& httpRequest, const Http::HeaderValueCollection& headerValues) const;
             void AddContentBodyToRequest(const std::shared_ptr<Aws::Http::HttpRequest>& httpRequest,
-                                         const std::shared_ptr<Aws::IOStream>& body, bool needsContentMd5 = false) const;
+                                         const std::shared_ptr<Aws::IOStream>& body, bool needsContentMd5 = false, bool hashPayload = false) const;
             void AddCommonHeaders(Aws::Http::HttpRequest& httpRequest) const;
             void InitializeGlobalStatics();
             void CleanupGlobalStatics();
@@ -248,11 +300,15 @@ namespace Aws
             std::shared_ptr<Aws::Utils::RateLimits::RateLimiterInterface> m_writeRateLimiter;
             std::shared_ptr<Aws::Utils::RateLimits::RateLimiterInterface> m_readRateLimiter;
             Aws::String m_userAgent;
-            std::shared_ptr<Aws::Utils::Crypto::Hash> m_hash;
+            std::shared_ptr<RequestMetricsCollector> m_requestMetricsCollector;
+            mutable std::mutex m_asyncAttemptsLock;
+            mutable std::condition_variable m_asyncAttemptsSignal;
+            mutable size_t m_asyncAttemptsInFlight;
             static std::atomic<int> s_refCount;
         };
 
         typedef Utils::Outcome<AmazonWebServiceResult<Utils::Json::JsonValue>, AWSError<CoreErrors>> JsonOutcome;
+        typedef std::function<void(const JsonOutcome&)> JsonOutcomeReceivedHandler;
 
         /**
          *  AWSClient that handles marshalling json response bodies. You would inherit from this class
@@ -277,7 +333,7 @@ namespace Aws
                     const Aws::Map<Aws::String, std::shared_ptr<Aws::Client::AWSAuthSigner>>& signerMap,
                     const std::shared_ptr<AWSErrorMarshaller>& errorMarshaller);
 
-            virtual ~AWSJsonClient() = default;
+            virtual ~AWSJsonClient();
 
         protected:
             /**
@@ -296,6 +352,17 @@ namespace Aws
                 Http::HttpMethod method = Http::HttpMethod::HTTP_POST,
                 const char* signerName = Aws::Auth::SIGV4_SIGNER) const;
 
+            /**
+             * Asynchronous version of MakeRequest. Calls AttemptExhaustivelyAsync and hands the parsed Json document or error to onCompleted.
+             *
+             * method defaults to POST
+             */
+            void MakeRequestAsync(const Aws::Http::URI& uri,
+                const std::shared_ptr<const Aws::AmazonWebServiceRequest>& request,
+                const JsonOutcomeReceivedHandler& onCompleted,
+                Http::HttpMethod method = Http::HttpMethod::HTTP_POST,
+                const char* signerName = Aws::Auth::SIGV4_SIGNER) const;
+
             /**
              * Returns a Json document or an error from the request. Does some marshalling json and raw streams,
              * then just calls AttemptExhaustively.
@@ -309,6 +376,7 @@ namespace Aws
         };
 
         typedef Utils::Outcome<AmazonWebServiceResult<Utils::Xml::XmlDocument>, AWSError<CoreErrors>> XmlOutcome;
+        typedef std::function<void(const XmlOutcome&)> XmlOutcomeReceivedHandler;
 
         /**
         *  AWSClient that handles marshalling xml response bodies. You would inherit from this class
@@ -328,7 +396,7 @@ namespace Aws
                 const Aws::Map<Aws::String, std::shared_ptr<Aws::Client::AWSAuthSigner>>& signerMap,
                 const std::shared_ptr<AWSErrorMarshaller>& errorMarshaller);
 
-            virtual ~AWSXMLClient() = default;
+            virtual ~AWSXMLClient();
 
         protected:
             /**
@@ -347,6 +415,16 @@ namespace Aws
                 Http::HttpMethod method = Http::HttpMethod::HTTP_POST,
                 const char* signerName = Aws::Auth::SIGV4_SIGNER) const;
 
+            /**
+             * Asynchronous version of MakeRequest. Calls AttemptExhaustivelyAsync and hands the parsed xml document or error to onCompleted.
+             *
+             * method defaults to POST
+             */
+            void MakeRequestAsync(const Aws::Http::URI& uri,
+                const std::shared_ptr<const Aws::AmazonWebServiceRequest>& request,
+                const XmlOutcomeReceivedHandler& onCompleted,
+                Http::HttpMethod method = Http::HttpMethod::HTTP_POST,
+                const char* signerName = Aws::Auth::SIGV4_SIGNER) const;
 
             /**
              * Returns an xml document or an error from the request. Does some marshalling xml and raw streams,
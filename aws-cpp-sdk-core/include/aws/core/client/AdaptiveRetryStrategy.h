@@ -0,0 +1,120 @@
+/*
+  * Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+  * 
+  * Licensed under the Apache License, Version 2.0 (the "License").
+  * You may not use this file except in compliance with the License.
+  * A copy of the License is located at
+  * 
+  *  http://aws.amazon.com/apache2.0
+  * 
+  * or in the "license" file accompanying this file. This file is distributed
+  * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+  * express or implied. See the License for the specific language governing
+  * permissions and limitations under the License.
+  */
+
+#pragma once
+
+#include <aws/core/Core_EXPORTS.h>
+#include <aws/core/client/StandardRetryStrategy.h>
+#include <chrono>
+#include <mutex>
+
+namespace Aws
+{
+namespace Client
+{
+
+/**
+ * Client side send rate limiter driven by throttling responses. It stays disabled until the first throttling response, then caps the
+ * send rate like a CUBIC congestion window: every throttling response cuts the rate to 70% of the rate measured at the time, successes
+ * grow it back along a cubic curve centered on the rate that got throttled last. Sending requires a token, tokens refill at that rate.
+ */
+class AWS_CORE_API RetryTokenBucket
+{
+public:
+    RetryTokenBucket();
+
+    /**
+     * Takes amount tokens. Unless fastFail is set, waits for the tokens to refill if there are not enough, otherwise returns false right away.
+     * Always succeeds while the bucket is disabled.
+     */
+    bool Acquire(double amount = 1, bool fastFail = false);
+
+    /**
+     * Adjusts the send rate after a response, throttled or not.
+     */
+    void UpdateClientSendingRate(bool isThrottlingResponse);
+
+    /**
+     * Same as above, with the time of the response given by the caller.
+     */
+    void UpdateClientSendingRate(bool isThrottlingResponse, std::chrono::steady_clock::time_point now);
+
+    bool IsEnabled() const;
+    /**
+     * Current send rate limit, in requests per second.
+     */
+    double GetFillRate() const;
+    /**
+     * Smoothed send rate actually observed, in requests per second.
+     */
+    double GetMeasuredSendRate() const;
+
+private:
+    bool Acquire(double amount, bool fastFail, std::chrono::steady_clock::time_point now);
+    double ToSeconds(std::chrono::steady_clock::time_point now) const;
+    void Refill(double now);
+    void UpdateMeasuredRate(double now);
+    void UpdateRate(double newRate, double now);
+    void CalculateTimeWindow();
+    double CubicSuccess(double now) const;
+    double CubicThrottle(double rateToUse) const;
+
+    mutable std::mutex m_lock;
+    std::chrono::steady_clock::time_point m_epoch;
+    double m_fillRate;
+    double m_maxCapacity;
+    double m_currentCapacity;
+    double m_lastTimestamp;
+    double m_measuredTxRate;
+    double m_lastTxRateBucket;
+    double m_requestCount;
+    double m_lastMaxRate;
+    double m_lastThrottleTime;
+    double m_timeWindow;
+    bool m_enabled;
+};
+
+/**
+ * StandardRetryStrategy that additionally limits the rate at which the client sends requests once the service starts throttling, with a
+ * RetryTokenBucket. Every attempt waits for a send token, so during a throttling storm all threads of the client slow down together
+ * instead of each retrying on its own schedule.
+ */
+class AWS_CORE_API AdaptiveRetryStrategy : public StandardRetryStrategy
+{
+public:
+    AdaptiveRetryStrategy(long maxRetries = 3, long scaleFactor = 25, long maxBackoffMs = 20000);
+    AdaptiveRetryStrategy(const std::shared_ptr<RetryQuotaContainer>& retryQuotaContainer, long maxRetries = 3, long scaleFactor = 25,
+            long maxBackoffMs = 20000);
+
+    void GetSendToken() override;
+    bool HasSendToken() override;
+
+    void RequestBookkeeping(const HttpResponseOutcome& httpResponseOutcome) override;
+    void RequestBookkeeping(const HttpResponseOutcome& httpResponseOutcome, const AWSError<CoreErrors>& lastError) override;
+
+    const RetryTokenBucket& GetRetryTokenBucket() const { return m_retryTokenBucket; }
+
+    /**
+     * Whether error means the service is throttling the client: the throttling core errors, http 429, or one of the throttling
+     * exception names services use, e.g. ProvisionedThroughputExceededException.
+     */
+    static bool IsThrottlingError(const AWSError<CoreErrors>& error);
+
+private:
+    RetryTokenBucket m_retryTokenBucket;
+};
+
+} // namespace Client
+} // namespace Aws
@@ -40,6 +40,7 @@ namespace Aws
     namespace Client
     {
         class RetryStrategy; // forward declare
+        class RequestMetricsCollector;
 
         /**
           * This mutable structure is used to configure any of the AWS clients.
@@ -78,7 +79,12 @@ namespace Aws
              */
             long connectTimeoutMs;
             /**
-             * Strategy to use in case of failed requests. Default is DefaultRetryStrategy (e.g. exponential backoff)
+             * Idle connections are closed after this long without being used. 0 keeps them open until the server closes them. Default 60000 ms.
+             */
+            long connectionIdleTimeoutMs;
+            /**
+             * Strategy to use in case of failed requests. Default is DefaultRetryStrategy (e.g. exponential backoff).
+             * StandardRetryStrategy adds jitter and a retry quota, AdaptiveRetryStrategy also limits the send rate while the service throttles.
              */
             std::shared_ptr<RetryStrategy> retryStrategy;
             /**
@@ -142,6 +148,22 @@ namespace Aws
              * If set to true the http stack will follow 300 redirect codes.
              */
             bool followRedirects;
+            /**
+             * Number of event loop threads used by event driven http clients (e.g. TransferLibType::CURL_MULTI_CLIENT). Each loop multiplexes
+             * all of its in flight requests, so one is enough for most processes. Default 1.
+             */
+            unsigned httpEventLoopThreads;
+            /**
+             * Receives a latency breakdown (signing, connection acquire, dns, connect, tls, first byte, transfer, parse, retry sleep) of every
+             * request attempt. See HistogramRequestMetricsCollector for a built in aggregator. Default is none, which costs nothing.
+             */
+            std::shared_ptr<RequestMetricsCollector> requestMetricsCollector;
+            /**
+             * When non zero, clients whose service accepts aws-chunked payloads (Amazon S3) sign request bodies chunk by chunk as they are sent,
+             * chunkSize bytes at a time, instead of reading the whole body up front to hash it. See AWSAuthV4Signer::SetPayloadSigningChunkSize.
+             * Default 0, disabled.
+             */
+            size_t payloadSigningChunkSize;
         };
 
     } // namespace Client
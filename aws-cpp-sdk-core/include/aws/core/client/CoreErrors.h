@@ -53,6 +53,7 @@ namespace Aws
             INVALID_SIGNATURE = 21,
             SIGNATURE_DOES_NOT_MATCH = 22,
             INVALID_ACCESS_KEY_ID = 23,
+            CLIENT_SIGNING_FAILURE = 24, // Client failed to sign the request
             NETWORK_CONNECTION = 99, // General failure to send message to service 
 
             // These are needed for logical reasons
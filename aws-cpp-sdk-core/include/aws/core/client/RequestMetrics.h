@@ -0,0 +1,139 @@
+/*
+* Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+*
+* Licensed under the Apache License, Version 2.0 (the "License").
+* You may not use this file except in compliance with the License.
+* A copy of the License is located at
+*
+*  http://aws.amazon.com/apache2.0
+*
+* or in the "license" file accompanying this file. This file is distributed
+* on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+* express or implied. See the License for the specific language governing
+* permissions and limitations under the License.
+*/
+
+#pragma once
+
+#include <aws/core/Core_EXPORTS.h>
+#include <aws/core/http/HttpResponse.h>
+#include <aws/core/utils/Histogram.h>
+#include <atomic>
+#include <chrono>
+
+namespace Aws
+{
+    namespace Client
+    {
+        /**
+         * Latency breakdown of one attempt of a service call. Retries are reported as separate attempts of the same request.
+         */
+        struct AWS_CORE_API RequestAttemptMetrics
+        {
+            RequestAttemptMetrics();
+
+            /**
+             * Name of the operation, e.g. "PutObject", and of the service it was sent to, e.g. "s3". Both point to strings that live as
+             * long as the client; serviceName is the signing name and may be empty for unsigned clients.
+             */
+            const char* requestName;
+            const char* serviceName;
+            /**
+             * 0 for the first attempt, n for the nth retry.
+             */
+            long attempt;
+            /**
+             * REQUEST_NOT_MADE when no response was received at all.
+             */
+            Aws::Http::HttpResponseCode responseCode;
+            bool success;
+
+            /**
+             * Time the retry strategy made the client wait before this attempt, 0 for the first attempt.
+             */
+            std::chrono::microseconds retrySleepTime;
+            /**
+             * Time spent signing the request.
+             */
+            std::chrono::microseconds signingTime;
+            /**
+             * Connection acquire, dns, connect, tls, first byte and body transfer timings plus byte counts, as reported by the http client.
+             */
+            Aws::Http::HttpTransferMetrics transferMetrics;
+            /**
+             * Time spent parsing the response payload into a document. Only measured where the client parses, i.e. for Json and Xml
+             * requests returning a document. Results that parse the raw response stream themselves report 0.
+             */
+            std::chrono::microseconds payloadParseTime;
+            /**
+             * Wall time of the attempt, from building the http request until the payload was parsed, excluding retrySleepTime.
+             */
+            std::chrono::microseconds totalTime;
+        };
+
+        /**
+         * Receives the latency breakdown of every request attempt made by clients that have it set on their ClientConfiguration.
+         * OnAttemptCompleted is called synchronously on the thread that completed the attempt (for async calls this may be the http
+         * client's event loop), concurrently from many threads, so implementations must be thread safe and cheap.
+         */
+        class AWS_CORE_API RequestMetricsCollector
+        {
+        public:
+            virtual ~RequestMetricsCollector() = default;
+
+            virtual void OnAttemptCompleted(const RequestAttemptMetrics& metrics) = 0;
+        };
+
+        /**
+         * Phases of a request attempt HistogramRequestMetricsCollector keeps a histogram for.
+         */
+        enum class RequestMetricsPhase
+        {
+            RETRY_SLEEP,
+            SIGNING,
+            CONNECTION_ACQUIRE,
+            DNS_LOOKUP,
+            CONNECT,
+            TLS_HANDSHAKE,
+            TIME_TO_FIRST_BYTE,
+            TRANSFER,
+            PAYLOAD_PARSE,
+            TOTAL,
+            PHASE_COUNT
+        };
+
+        /**
+         * Collector aggregating all attempts into one latency histogram (in microseconds) per phase, without locks or allocations.
+         * Share one instance across clients for a process wide view, or give each client its own for a per service view.
+         */
+        class AWS_CORE_API HistogramRequestMetricsCollector : public RequestMetricsCollector
+        {
+        public:
+            HistogramRequestMetricsCollector();
+
+            void OnAttemptCompleted(const RequestAttemptMetrics& metrics) override;
+
+            const Aws::Utils::Histogram& GetHistogram(RequestMetricsPhase phase) const { return m_histograms[static_cast<size_t>(phase)]; }
+
+            uint64_t GetAttemptCount() const { return m_attempts.load(std::memory_order_relaxed); }
+            uint64_t GetFailedAttemptCount() const { return m_failedAttempts.load(std::memory_order_relaxed); }
+            uint64_t GetRetryCount() const { return m_retries.load(std::memory_order_relaxed); }
+            uint64_t GetBytesSent() const { return m_bytesSent.load(std::memory_order_relaxed); }
+            uint64_t GetBytesReceived() const { return m_bytesReceived.load(std::memory_order_relaxed); }
+
+            /**
+             * Clears all histograms and counters.
+             */
+            void Reset();
+
+        private:
+            Aws::Utils::Histogram m_histograms[static_cast<size_t>(RequestMetricsPhase::PHASE_COUNT)];
+            std::atomic<uint64_t> m_attempts;
+            std::atomic<uint64_t> m_failedAttempts;
+            std::atomic<uint64_t> m_retries;
+            std::atomic<uint64_t> m_bytesSent;
+            std::atomic<uint64_t> m_bytesReceived;
+        };
+
+    } // namespace Client
+} // namespace Aws
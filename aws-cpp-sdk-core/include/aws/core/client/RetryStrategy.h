@@ -16,9 +16,22 @@
 #pragma once
 
 #include <aws/core/Core_EXPORTS.h>
+#include <aws/core/utils/UnreferencedParam.h>
+#include <memory>
 
 namespace Aws
 {
+    namespace Utils
+    {
+        template<typename R, typename E>
+        class Outcome;
+    } // namespace Utils
+
+    namespace Http
+    {
+        class HttpResponse;
+    } // namespace Http
+
     namespace Client
     {
 
@@ -26,6 +39,8 @@ namespace Aws
         template<typename ERROR_TYPE>
         class AWSError;
 
+        typedef Utils::Outcome<std::shared_ptr<Aws::Http::HttpResponse>, AWSError<CoreErrors>> HttpResponseOutcome;
+
         /**
          * Interface for defining a Retry Strategy. Override this class to provide your own custom retry behavior.
          */
@@ -43,6 +58,29 @@ namespace Aws
              */
             virtual long CalculateDelayBeforeNextRetry(const AWSError<CoreErrors>& error, long attemptedRetries) const = 0;
 
+            /**
+             * Called before every attempt, blocks until the strategy lets the request be sent. Strategies that limit the client's
+             * send rate override this, the default sends right away.
+             */
+            virtual void GetSendToken() {}
+
+            /**
+             * Non blocking version of GetSendToken. Takes a send token and returns true if one is available right now.
+             */
+            virtual bool HasSendToken() { return true; }
+
+            /**
+             * Called with the outcome of the first attempt of every request.
+             */
+            virtual void RequestBookkeeping(const HttpResponseOutcome& /*httpResponseOutcome*/) {}
+
+            /**
+             * Called with the outcome of every retried attempt, lastError is the error that caused the retry.
+             */
+            virtual void RequestBookkeeping(const HttpResponseOutcome& httpResponseOutcome, const AWSError<CoreErrors>& /*lastError*/)
+            {
+                RequestBookkeeping(httpResponseOutcome);
+            }
         };
 
     } // namespace Client
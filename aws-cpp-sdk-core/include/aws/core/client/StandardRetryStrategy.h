@@ -0,0 +1,114 @@
+/*
+  * Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+  * 
+  * Licensed under the Apache License, Version 2.0 (the "License").
+  * You may not use this file except in compliance with the License.
+  * A copy of the License is located at
+  * 
+  *  http://aws.amazon.com/apache2.0
+  * 
+  * or in the "license" file accompanying this file. This file is distributed
+  * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+  * express or implied. See the License for the specific language governing
+  * permissions and limitations under the License.
+  */
+
+#pragma once
+
+#include <aws/core/Core_EXPORTS.h>
+#include <aws/core/client/RetryStrategy.h>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <random>
+
+namespace Aws
+{
+namespace Client
+{
+
+/**
+ * Retry budget shared by all requests of the clients using it. Every retry costs tokens from the quota and every request that succeeds
+ * pays some back, so while a service keeps failing the clients quickly stop retrying instead of multiplying the load on it.
+ */
+class AWS_CORE_API RetryQuotaContainer
+{
+public:
+    virtual ~RetryQuotaContainer() = default;
+
+    /**
+     * Takes the cost of retrying error from the quota. Returns false, taking nothing, if the quota can not cover it.
+     */
+    virtual bool AcquireRetryQuota(const AWSError<CoreErrors>& error) = 0;
+
+    /**
+     * Pays capacityAmount back into the quota.
+     */
+    virtual void ReleaseRetryQuota(int capacityAmount) = 0;
+
+    /**
+     * Pays the cost of retrying lastError back into the quota, once the retry succeeded.
+     */
+    virtual void ReleaseRetryQuota(const AWSError<CoreErrors>& lastError) = 0;
+
+    virtual int GetRetryQuota() const = 0;
+};
+
+/**
+ * Lock free RetryQuotaContainer. A retry costs retryCost tokens, or timeoutRetryCost if the previous attempt never got a response.
+ * The quota never grows beyond initialQuota.
+ */
+class AWS_CORE_API DefaultRetryQuotaContainer : public RetryQuotaContainer
+{
+public:
+    DefaultRetryQuotaContainer(int initialQuota = 500, int retryCost = 5, int timeoutRetryCost = 10);
+
+    bool AcquireRetryQuota(const AWSError<CoreErrors>& error) override;
+    void ReleaseRetryQuota(int capacityAmount) override;
+    void ReleaseRetryQuota(const AWSError<CoreErrors>& lastError) override;
+    int GetRetryQuota() const override { return m_retryQuota.load(std::memory_order_relaxed); }
+
+private:
+    int GetRetryCost(const AWSError<CoreErrors>& error) const;
+
+    std::atomic<int> m_retryQuota;
+    int m_maxQuota;
+    int m_retryCost;
+    int m_timeoutRetryCost;
+};
+
+/**
+ * Retry strategy with full jitter and a retry quota. The delay before retry n is drawn uniformly from
+ * [0, min(maxBackoffMs, scaleFactor * 2^n)], so clients that failed together do not retry in lockstep, and retries stop once the
+ * quota shared through the RetryQuotaContainer is used up. Requests succeeding on the first attempt refill the quota by 1 token,
+ * requests succeeding on a retry refund what the retry cost.
+ */
+class AWS_CORE_API StandardRetryStrategy : public RetryStrategy
+{
+public:
+    StandardRetryStrategy(long maxRetries = 3, long scaleFactor = 25, long maxBackoffMs = 20000);
+    StandardRetryStrategy(const std::shared_ptr<RetryQuotaContainer>& retryQuotaContainer, long maxRetries = 3, long scaleFactor = 25,
+            long maxBackoffMs = 20000);
+
+    bool ShouldRetry(const AWSError<CoreErrors>& error, long attemptedRetries) const override;
+
+    long CalculateDelayBeforeNextRetry(const AWSError<CoreErrors>& error, long attemptedRetries) const override;
+
+    void RequestBookkeeping(const HttpResponseOutcome& httpResponseOutcome) override;
+    void RequestBookkeeping(const HttpResponseOutcome& httpResponseOutcome, const AWSError<CoreErrors>& lastError) override;
+
+    const std::shared_ptr<RetryQuotaContainer>& GetRetryQuotaContainer() const { return m_retryQuotaContainer; }
+
+protected:
+    std::shared_ptr<RetryQuotaContainer> m_retryQuotaContainer;
+    long m_maxRetries;
+    long m_scaleFactor;
+    long m_maxBackoffMs;
+
+private:
+    mutable std::mutex m_randomLock;
+    mutable std::minstd_rand m_random;
+};
+
+} // namespace Client
+} // namespace Aws
@@ -21,6 +21,8 @@
 #include <atomic>
 #include <mutex>
 #include <condition_variable>
+#include <functional>
+#include <chrono>
 
 namespace Aws
 {
@@ -37,6 +39,11 @@ namespace Aws
         class HttpRequest;
         class HttpResponse;
 
+        /**
+         * Invoked once an asynchronous request has finished. response is nullptr if the request could not be made or failed at the transport level.
+         */
+        typedef std::function<void(const std::shared_ptr<HttpRequest>&, const std::shared_ptr<HttpResponse>&)> RequestCompletedEventHandler;
+
         /**
           * Abstract HttpClient. All it does is make HttpRequests and return their response.
           */
@@ -53,10 +60,20 @@ namespace Aws
                 Aws::Utils::RateLimits::RateLimiterInterface* readLimiter = nullptr,
                 Aws::Utils::RateLimits::RateLimiterInterface* writeLimiter = nullptr) const = 0;
 
+            /**
+             * Takes an http request, makes it, and invokes onCompleted with the response once the request has finished.
+             * The default implementation calls MakeRequest on the calling thread. Event driven implementations return immediately
+             * and invoke onCompleted from their own thread, so onCompleted should not block.
+             */
+            virtual void MakeRequestAsync(const std::shared_ptr<HttpRequest>& request,
+                const RequestCompletedEventHandler& onCompleted,
+                Aws::Utils::RateLimits::RateLimiterInterface* readLimiter = nullptr,
+                Aws::Utils::RateLimits::RateLimiterInterface* writeLimiter = nullptr) const;
+
             /**
              * Stops all requests in progress and prevents any others from initiating.
              */
-            void DisableRequestProcessing();
+            virtual void DisableRequestProcessing();
             /**
              * Enables/ReEnables request processing.
              */
@@ -69,6 +86,13 @@ namespace Aws
              * Sleeps current thread for sleepTime.
              */
             void RetryRequestSleep(std::chrono::milliseconds sleepTime);
+            /**
+             * Invokes fn once sleepTime has elapsed or request processing has been disabled. The default implementation sleeps
+             * the current thread, event driven implementations schedule fn without blocking the caller.
+             * fn is passed true when the sleep was cancelled, i.e. request processing is disabled or the client is shutting down,
+             * in which case the request should be failed rather than retried.
+             */
+            virtual void RetryRequestSleepAsync(std::chrono::milliseconds sleepTime, const std::function<void(bool)>& fn);
 
             bool ContinueRequest(const Aws::Http::HttpRequest&) const;
 
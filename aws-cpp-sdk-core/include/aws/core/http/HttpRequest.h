@@ -19,9 +19,12 @@
 
 #include <aws/core/http/URI.h>
 #include <aws/core/http/HttpTypes.h>
+#include <aws/core/utils/crypto/MultiDigest.h>
 #include <aws/core/utils/memory/AWSMemory.h>
+#include <aws/core/utils/memory/stl/AWSMap.h>
 #include <aws/core/utils/memory/stl/AWSStreamFwd.h>
 #include <aws/core/utils/stream/ResponseStream.h>
+#include <aws/core/utils/stream/ResponseBodySink.h>
 #include <memory>
 #include <functional>
 
@@ -380,12 +383,42 @@ namespace Aws
             inline const DataSentEventHandler& GetDataSentEventHandler() const { return m_onDataSent; }
 
             inline const ContinueRequestHandler& GetContinueRequestHandler() const { return m_continueRequest; }
+            /**
+             * Sets the factory for the sink the response body is written into. When set, it takes precedence over the response stream factory.
+             */
+            inline void SetResponseBodySinkFactory(const Aws::Utils::Stream::ResponseBodySinkFactory& factory) { m_responseBodySinkFactory = factory; }
+            /**
+             * Gets the factory for the sink the response body is written into.
+             */
+            inline const Aws::Utils::Stream::ResponseBodySinkFactory& GetResponseBodySinkFactory() const { return m_responseBodySinkFactory; }
+            /**
+             * Keeps a digest of the content body so that later stages hashing the same body, such as the signer computing the payload
+             * sha256, can reuse it instead of reading the body again. Implementations clear the digests when a new body is added.
+             */
+            inline void SetContentBodyDigest(Aws::Utils::Crypto::DigestAlgorithm algorithm, const Aws::Utils::ByteBuffer& digest)
+            {
+                m_contentBodyDigests[algorithm] = digest;
+            }
+            /**
+             * Gets a digest kept with SetContentBodyDigest, or an empty buffer if there is none for algorithm.
+             */
+            inline Aws::Utils::ByteBuffer GetContentBodyDigest(Aws::Utils::Crypto::DigestAlgorithm algorithm) const
+            {
+                auto digest = m_contentBodyDigests.find(algorithm);
+                return digest == m_contentBodyDigests.end() ? Aws::Utils::ByteBuffer() : digest->second;
+            }
+            /**
+             * Drops all digests kept with SetContentBodyDigest.
+             */
+            inline void ClearContentBodyDigests() { m_contentBodyDigests.clear(); }
         private:
             URI m_uri;
             HttpMethod m_method;
             DataReceivedEventHandler m_onDataReceived;
             DataSentEventHandler m_onDataSent;
             ContinueRequestHandler m_continueRequest;
+            Aws::Utils::Stream::ResponseBodySinkFactory m_responseBodySinkFactory;
+            Aws::Map<Aws::Utils::Crypto::DigestAlgorithm, Aws::Utils::ByteBuffer> m_contentBodyDigests;
         };
 
     } // namespace Http
@@ -20,6 +20,7 @@
 #include <aws/core/http/HttpTypes.h>
 #include <aws/core/utils/memory/AWSMemory.h>
 #include <aws/core/utils/memory/stl/AWSStreamFwd.h>
+#include <chrono>
 
 namespace Aws
 {
@@ -114,6 +115,36 @@ namespace Aws
             NETWORK_CONNECT_TIMEOUT = 599
         };
 
+        /**
+         * Timings and byte counts of one http exchange, as far as the http client implementation is able to report them. Phases the
+         * client does not measure, or that did not happen (e.g. dns lookup and connect on a reused connection), are left at zero.
+         */
+        struct AWS_CORE_API HttpTransferMetrics
+        {
+            HttpTransferMetrics() :
+                connectionAcquireTime(0), dnsLookupTime(0), connectTime(0), tlsHandshakeTime(0),
+                timeToFirstByte(0), transferTime(0), bytesSent(0), bytesReceived(0)
+            {}
+
+            /**
+             * Time spent waiting for a connection handle from the pool.
+             */
+            std::chrono::microseconds connectionAcquireTime;
+            std::chrono::microseconds dnsLookupTime;
+            std::chrono::microseconds connectTime;
+            std::chrono::microseconds tlsHandshakeTime;
+            /**
+             * Time from the connection being ready until the first response byte arrived, i.e. sending the request plus server time.
+             */
+            std::chrono::microseconds timeToFirstByte;
+            /**
+             * Time from the first response byte until the response body was completely received.
+             */
+            std::chrono::microseconds transferTime;
+            long long bytesSent;
+            long long bytesReceived;
+        };
+
         /**
          * Abstract class for representing an Http Response.
          */
@@ -163,6 +194,10 @@ namespace Aws
              * Gets the response body of the response.
              */
             virtual Aws::IOStream& GetResponseBody() const = 0;
+            /**
+             * Gets the sink the response body is written into, or nullptr if the body is a plain stream.
+             */
+            virtual Utils::Stream::ResponseBodySink* GetResponseBodySink() const { return nullptr; }
             /**
              * Gives full control of the memory of the ResponseBody over to the caller. At this point, it is the caller's
              * responsibility to clean up this object.
@@ -176,6 +211,14 @@ namespace Aws
              * Sets the content type header on the http response object.
              */
             virtual void SetContentType(const Aws::String& contentType) { AddHeader("content-type", contentType); };
+            /**
+             * Gets the timings the http client recorded while making this response.
+             */
+            inline const HttpTransferMetrics& GetTransferMetrics() const { return transferMetrics; }
+            /**
+             * Sets the timings of the exchange. Called by the http client implementation.
+             */
+            inline void SetTransferMetrics(const HttpTransferMetrics& metrics) { transferMetrics = metrics; }
 
         private:
             HttpResponse(const HttpResponse&);
@@ -183,6 +226,7 @@ namespace Aws
 
             const HttpRequest& httpRequest;
             HttpResponseCode responseCode;
+            HttpTransferMetrics transferMetrics;
         };
 
 
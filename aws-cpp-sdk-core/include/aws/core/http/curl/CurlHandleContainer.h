@@ -15,8 +15,16 @@
 
 #pragma once
 
-#include <aws/core/utils/ResourceManager.h>
+#include <aws/core/Core_EXPORTS.h>
+#include <aws/core/utils/memory/stl/AWSMap.h>
+#include <aws/core/utils/memory/stl/AWSString.h>
+#include <aws/core/utils/memory/stl/AWSVector.h>
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
 #include <utility>
 #include <curl/curl.h>
 
@@ -26,30 +34,74 @@ namespace Http
 {
 
 /**
-  * Simple Connection pool manager for Curl. It maintains connections in a thread safe manner. You
-  * can call into acquire a handle, then put it back when finished. It is assumed that reusing an already
-  * initialized handle is preferable (especially for synchronous clients). The pool doubles in capacity as
-  * needed up to the maximum amount of connections.
+  * Pool of curl easy handles. Idle handles are kept per endpoint (host:port), since a curl handle keeps the connections and tls sessions
+  * of the endpoints it last talked to; handing it back out for the same endpoint skips the tcp and tls handshakes. The idle lists are
+  * spread over a fixed number of shards keyed by endpoint, so threads talking to different endpoints don't contend, and the pool size
+  * and counters are atomics. Threads only block once every handle in the pool is in use.
   */
-class CurlHandleContainer
+class AWS_CORE_API CurlHandleContainer
 {
 public:
     /**
-      * Initializes an empty stack of CURL handles. If you are only making synchronous calls via your http client
-      * then a small size is best. For async support, a good value would be 6 * number of Processors.   *
+      * Initializes an empty pool of CURL handles. If you are only making synchronous calls via your http client
+      * then a small size is best. For async support, a good value would be 6 * number of Processors.
+      * Handles idle for longer than idleTimeout ms are cleaned up, closing their connections. 0 keeps idle handles forever.
       */
-    CurlHandleContainer(unsigned maxSize = 50, long requestTimeout = 3000, long connectTimeout = 1000);
+    CurlHandleContainer(unsigned maxSize = 50, long requestTimeout = 3000, long connectTimeout = 1000, long idleTimeout = 60000);
     ~CurlHandleContainer();
 
     /**
       * Blocks until a curl handle from the pool is available for use.
       */
     CURL* AcquireCurlHandle();
+    /**
+      * Blocks until a curl handle from the pool is available for use. Prefers a handle that was last used against endpoint, then a
+      * new handle if the pool can still grow, then an idle handle of some other endpoint.
+      */
+    CURL* AcquireCurlHandle(const Aws::String& endpoint);
     /**
       * Returns a handle to the pool for reuse. It is imperative that this is called
       * after you are finished with the handle.
       */
     void ReleaseCurlHandle(CURL* handle);
+    /**
+      * Returns a handle to the pool for reuse by later requests to endpoint.
+      */
+    void ReleaseCurlHandle(CURL* handle, const Aws::String& endpoint);
+
+    /**
+      * Takes up to count handles without blocking and calls connect on all of them concurrently, then releases them for endpoint.
+      * connect is expected to make a cheap request to endpoint so that the handles hold an open connection (and tls session) before
+      * the first real request. Returns the number of handles for which connect returned true.
+      */
+    unsigned Warmup(const Aws::String& endpoint, unsigned count, const std::function<bool(CURL*)>& connect);
+
+    /**
+      * Cleans up every idle handle that has been idle for longer than the idle timeout. This also happens as handles are released,
+      * call it to trim the pool of endpoints that are no longer being used. Returns the number of handles cleaned up.
+      */
+    size_t EvictIdleHandles();
+
+    /**
+      * Number of acquisitions that got an idle handle of the requested endpoint.
+      */
+    inline uint64_t GetHitCount() const { return m_hits.load(); }
+    /**
+      * Number of acquisitions that had to create a handle or repurpose one of another endpoint.
+      */
+    inline uint64_t GetMissCount() const { return m_misses.load(); }
+    /**
+      * Number of new connections curl had to open for requests made with handles from this pool.
+      */
+    inline uint64_t GetHandshakeCount() const { return m_handshakes.load(); }
+    /**
+      * Number of handles cleaned up because they were idle for too long.
+      */
+    inline uint64_t GetEvictionCount() const { return m_evictions.load(); }
+    /**
+      * Current number of handles owned by the pool, idle or in use.
+      */
+    inline unsigned GetPoolSize() const { return m_poolSize.load(); }
 
 private:
     CurlHandleContainer(const CurlHandleContainer&) = delete;
@@ -57,15 +109,45 @@ private:
     CurlHandleContainer(const CurlHandleContainer&&) = delete;
     const CurlHandleContainer& operator = (const CurlHandleContainer&&) = delete;
 
-    bool CheckAndGrowPool();
+    typedef std::chrono::steady_clock::time_point TimePoint;
+
+    struct IdleHandle
+    {
+        CURL* handle;
+        TimePoint idleSince;
+    };
+
+    struct Shard
+    {
+        std::mutex lock;
+        Aws::Map<Aws::String, Aws::Vector<IdleHandle>> idleHandles;
+    };
+
+    static const size_t SHARD_COUNT = 16;
+
+    Shard& GetShard(const Aws::String& endpoint);
+    CURL* TryAcquire(const Aws::String& endpoint);
+    CURL* TryAcquireIdle(Shard& shard, const Aws::String& endpoint);
+    CURL* TryAcquireAnyIdle();
+    CURL* TryCreateHandle();
+    void CollectExpiredHandles(Shard& shard, TimePoint now, Aws::Vector<CURL*>& expired);
+    void EvictHandles(const Aws::Vector<CURL*>& handles);
+    void NotifyWaiters();
     void SetDefaultOptionsOnHandle(CURL* handle);
 
-    Aws::Utils::ExclusiveOwnershipResourceManager<CURL*> m_handleContainer;
+    Shard m_shards[SHARD_COUNT];
     unsigned m_maxPoolSize;
     unsigned long m_requestTimeout;
     unsigned long m_connectTimeout;
-    unsigned m_poolSize;
-    std::mutex m_containerLock;
+    std::chrono::milliseconds m_idleTimeout;
+    std::atomic<unsigned> m_poolSize;
+    std::atomic<unsigned> m_waiters;
+    std::mutex m_waitLock;
+    std::condition_variable m_handleReleased;
+    std::atomic<uint64_t> m_hits;
+    std::atomic<uint64_t> m_misses;
+    std::atomic<uint64_t> m_handshakes;
+    std::atomic<uint64_t> m_evictions;
 };
 
 } // namespace Http
@@ -18,18 +18,65 @@
 
 #include <aws/core/Core_EXPORTS.h>
 #include <aws/core/http/HttpClient.h>
+#include <aws/core/http/HttpResponse.h>
+#include <aws/core/http/URI.h>
 #include <aws/core/http/curl/CurlHandleContainer.h>
 #include <aws/core/client/ClientConfiguration.h>
 #include <aws/core/utils/memory/stl/AWSString.h>
 #include <atomic>
+#include <chrono>
+#include <functional>
 
 namespace Aws
 {
 namespace Http
 {
 
+//State handed to the curl write and header callbacks for a single request.
+struct CurlWriteCallbackContext
+{
+    CurlWriteCallbackContext(const HttpClient* client,
+                             HttpRequest* request,
+                             HttpResponse* response,
+                             Aws::Utils::RateLimits::RateLimiterInterface* rateLimiter) :
+        m_client(client),
+        m_request(request),
+        m_response(response),
+        m_bodySink(response ? response->GetResponseBodySink() : nullptr),
+        m_rateLimiter(rateLimiter),
+        m_numBytesResponseReceived(0)
+    {}
+
+    const HttpClient* m_client;
+    HttpRequest* m_request;
+    HttpResponse* m_response;
+    //when set, the body is appended straight into the sink instead of going through the response stream.
+    Aws::Utils::Stream::ResponseBodySink* m_bodySink;
+    Aws::Utils::RateLimits::RateLimiterInterface* m_rateLimiter;
+    int64_t m_numBytesResponseReceived;
+    //when set, the rate limiter pauses the transfer until m_resumeTime and asks this to resume it then, instead of sleeping the thread.
+    std::function<void(std::chrono::milliseconds)> m_scheduleResume;
+    std::chrono::steady_clock::time_point m_resumeTime;
+};
+
+//State handed to the curl read callback for a single request.
+struct CurlReadCallbackContext
+{
+    CurlReadCallbackContext(const HttpClient* client, HttpRequest* request, Aws::Utils::RateLimits::RateLimiterInterface* limiter) :
+        m_client(client),
+        m_rateLimiter(limiter),
+        m_request(request)
+    {}
+
+    const HttpClient* m_client;
+    Aws::Utils::RateLimits::RateLimiterInterface* m_rateLimiter;
+    HttpRequest* m_request;
+    //see CurlWriteCallbackContext.
+    std::function<void(std::chrono::milliseconds)> m_scheduleResume;
+    std::chrono::steady_clock::time_point m_resumeTime;
+};
 
-//Curl implementation of an http client. Right now it is only synchronous.
+//Curl implementation of an http client. Each request is driven by curl_easy_perform on the calling thread.
 class AWS_CORE_API CurlHttpClient: public HttpClient
 {
 public:
@@ -40,13 +87,34 @@ public:
     CurlHttpClient(const Aws::Client::ClientConfiguration& clientConfig);
     //Makes request and receives response synchronously
     std::shared_ptr<HttpResponse> MakeRequest(HttpRequest& request, Aws::Utils::RateLimits::RateLimiterInterface* readLimiter = nullptr,
-            Aws::Utils::RateLimits::RateLimiterInterface* writeLimiter = nullptr) const;
+            Aws::Utils::RateLimits::RateLimiterInterface* writeLimiter = nullptr) const override;
+
+    //Opens up to count connections to the endpoint of url with HEAD requests, so the first requests to it skip the tcp and tls handshakes.
+    //Returns the number of connections established.
+    unsigned WarmupConnections(const Aws::String& url, unsigned count) const;
+    //Returns the handle pool, e.g. to read its hit/miss/handshake counters.
+    const CurlHandleContainer& GetCurlHandleContainer() const { return m_curlHandleContainer; }
 
     static void InitGlobalState();
     static void CleanupGlobalState();
 
-private:
+protected:
+    //Returns the host:port key the handle pool groups idle handles by.
+    static Aws::String GetEndpointKey(const URI& uri);
+    //Returns the url to send the request to, with the path uri encoded.
+    static Aws::String BuildRequestUrl(const HttpRequest& request);
+    //Builds the curl header list for the request. The caller owns the list and must free it with curl_slist_free_all.
+    static struct curl_slist* BuildHeaderList(const HttpRequest& request);
+    //Sets method, url, headers, callbacks, tls and proxy options for request on connectionHandle.
+    void ConfigureConnectionHandle(CURL* connectionHandle, HttpRequest& request, const Aws::String& url, struct curl_slist* headers,
+            CurlWriteCallbackContext& writeContext, CurlReadCallbackContext& readContext) const;
+    //Fills in response code and content type once curl has finished with connectionHandle. Resets response on transport errors.
+    void FinalizeResponse(CURL* connectionHandle, CURLcode curlResponseCode, HttpRequest& request,
+            std::shared_ptr<HttpResponse>& response, const CurlWriteCallbackContext& writeContext) const;
+
     mutable CurlHandleContainer m_curlHandleContainer;
+
+private:
     bool m_isUsingProxy;
     Aws::String m_proxyUserName;
     Aws::String m_proxyPassword;
@@ -0,0 +1,99 @@
+/*
+  * Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+  *
+  * Licensed under the Apache License, Version 2.0 (the "License").
+  * You may not use this file except in compliance with the License.
+  * A copy of the License is located at
+  *
+  *  http://aws.amazon.com/apache2.0
+  *
+  * or in the "license" file accompanying this file. This file is distributed
+  * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+  * express or implied. See the License for the specific language governing
+  * permissions and limitations under the License.
+  */
+
+
+#pragma once
+
+#include <aws/core/Core_EXPORTS.h>
+#include <aws/core/http/curl/CurlHttpClient.h>
+#include <aws/core/utils/memory/stl/AWSVector.h>
+#include <atomic>
+
+namespace Aws
+{
+namespace Http
+{
+
+class CurlEventLoop;
+
+/**
+ * Event driven curl implementation of an http client. Requests are handed to one of a small number of event loop threads, each of which
+ * multiplexes all of its in flight transfers over curl_multi_socket_action. MakeRequestAsync returns immediately and completes on the event
+ * loop thread, so no thread is parked on a socket for the duration of a request. MakeRequest submits to the event loop and waits.
+ *
+ * Completion handlers run on the event loop thread and must not block. Rate limited transfers are paused on the event loop and resumed from
+ * a timer rather than sleeping it. Only available on posix platforms.
+ *
+ * The requests AWSClient sends with AttemptExhaustivelyAsync, e.g. through the MakeRequestAsync overloads of AWSJsonClient and AWSXMLClient,
+ * complete on the event loop. Generated service *Async operations still run the blocking MakeRequest on the client executor, which keeps
+ * that executor thread waiting on the event loop for the duration of the request.
+ */
+class AWS_CORE_API CurlMultiHttpClient : public CurlHttpClient
+{
+public:
+
+    using Base = CurlHttpClient;
+
+    /**
+     * Starts clientConfig.httpEventLoopThreads event loops. maxConnections bounds the number of open connections per event loop,
+     * additional requests are queued by curl until a connection frees up.
+     */
+    CurlMultiHttpClient(const Aws::Client::ClientConfiguration& clientConfig);
+    ~CurlMultiHttpClient();
+
+    CurlMultiHttpClient(const CurlMultiHttpClient&) = delete;
+    CurlMultiHttpClient& operator=(const CurlMultiHttpClient&) = delete;
+
+    /**
+     * Submits the request to an event loop and blocks until it completes.
+     */
+    std::shared_ptr<HttpResponse> MakeRequest(HttpRequest& request, Aws::Utils::RateLimits::RateLimiterInterface* readLimiter = nullptr,
+            Aws::Utils::RateLimits::RateLimiterInterface* writeLimiter = nullptr) const override;
+
+    /**
+     * Submits the request to an event loop and returns immediately. onCompleted is invoked on the event loop thread.
+     */
+    void MakeRequestAsync(const std::shared_ptr<HttpRequest>& request, const RequestCompletedEventHandler& onCompleted,
+            Aws::Utils::RateLimits::RateLimiterInterface* readLimiter = nullptr,
+            Aws::Utils::RateLimits::RateLimiterInterface* writeLimiter = nullptr) const override;
+
+    /**
+     * Schedules fn on an event loop timer instead of sleeping the calling thread. fn is cancelled right away if request processing
+     * is disabled.
+     */
+    void RetryRequestSleepAsync(std::chrono::milliseconds sleepTime, const std::function<void(bool)>& fn) override;
+
+    /**
+     * Besides refusing new requests, aborts the transfers in flight and cancels the pending retry timers on every event loop.
+     */
+    void DisableRequestProcessing() override;
+
+private:
+    void SubmitRequest(HttpRequest& request, const std::shared_ptr<HttpRequest>& requestOwner,
+            std::function<void(const std::shared_ptr<HttpResponse>&)>&& onCompleted,
+            Aws::Utils::RateLimits::RateLimiterInterface* readLimiter,
+            Aws::Utils::RateLimits::RateLimiterInterface* writeLimiter) const;
+    CurlEventLoop* GetNextEventLoop() const;
+    bool IsEventLoopThread() const;
+
+    Aws::Vector<CurlEventLoop*> m_eventLoops;
+    mutable std::atomic<size_t> m_nextEventLoop;
+    long m_requestTimeout;
+    long m_connectTimeout;
+};
+
+} // namespace Http
+} // namespace Aws
+
@@ -61,7 +61,7 @@ namespace Aws
                 /**                 
                  * Adds a content body stream to the request. This stream will be used to send the body to the endpoint.
                  */               
-                virtual inline void AddContentBody(const std::shared_ptr<Aws::IOStream>& strContent) override { bodyStream = strContent; }
+                virtual inline void AddContentBody(const std::shared_ptr<Aws::IOStream>& strContent) override { ClearContentBodyDigests(); bodyStream = strContent; }
                 /**
                  * Gets the content body stream that will be used for this request.
                  */
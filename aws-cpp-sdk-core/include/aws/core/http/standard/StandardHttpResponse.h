@@ -20,6 +20,7 @@
 #include <aws/core/http/HttpResponse.h>
 #include <aws/core/utils/memory/stl/AWSMap.h>
 #include <aws/core/utils/stream/ResponseStream.h>
+#include <aws/core/utils/stream/ResponseBodySink.h>
 #include <aws/core/utils/memory/stl/AWSString.h>
 
 namespace Aws
@@ -38,11 +39,7 @@ namespace Aws
                 /**
                  * Initializes an http response with the originalRequest and the response code.
                  */
-                StandardHttpResponse(const HttpRequest& originatingRequest) :
-                    HttpResponse(originatingRequest),
-                    headerMap(),
-                    bodyStream(originatingRequest.GetResponseStreamFactory())
-                {}
+                StandardHttpResponse(const HttpRequest& originatingRequest);
 
                 ~StandardHttpResponse() = default;
 
@@ -66,7 +63,11 @@ namespace Aws
                  * Gives full control of the memory of the ResponseBody over to the caller. At this point, it is the caller's
                  * responsibility to clean up this object.
                  */
-                inline Utils::Stream::ResponseStream&& SwapResponseStreamOwnership() { return std::move(bodyStream); }
+                inline Utils::Stream::ResponseStream&& SwapResponseStreamOwnership() { bodySink = nullptr; return std::move(bodyStream); }
+                /**
+                 * Gets the sink the response body is written into, or nullptr if the originating request had no sink factory.
+                 */
+                inline Utils::Stream::ResponseBodySink* GetResponseBodySink() const { return bodySink; }
                 /**
                  * Adds a header to the http response object.
                  */
@@ -77,6 +78,7 @@ namespace Aws
 
                 Aws::Map<Aws::String, Aws::String> headerMap;
                 Utils::Stream::ResponseStream bodyStream;
+                Utils::Stream::ResponseBodySink* bodySink;
             };
 
         } // namespace Standard
@@ -19,6 +19,7 @@
 #include <aws/core/utils/memory/stl/AWSString.h>
 #include <aws/core/utils/memory/stl/AWSMap.h>
 #include <functional>
+#include <cstdint>
 
 namespace Aws
 {
@@ -232,5 +233,125 @@ namespace FileSystem
         std::shared_ptr<Directory> m_dir;
     };
 
+    /**
+     * Read only memory mapping of an entire file. The mapping is released when the object is destroyed, so pointers obtained from
+     * GetData() must not outlive it. If the file cannot be opened or mapped, the bool operator returns false. An empty file is valid
+     * with a null data pointer and a length of 0.
+     */
+    class AWS_CORE_API MappedFile
+    {
+    public:
+        /**
+         * Maps the file at fileName for reading.
+         */
+        MappedFile(const char* fileName);
+        ~MappedFile();
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        /**
+         * If the file was mapped successfully.
+         */
+        operator bool() const { return m_isValid; }
+
+        /**
+         * Start of the mapped file contents.
+         */
+        const unsigned char* GetData() const { return static_cast<const unsigned char*>(m_data); }
+
+        /**
+         * Size of the mapped file in bytes.
+         */
+        size_t GetLength() const { return m_length; }
+
+    private:
+        void* m_data;
+        size_t m_length;
+        bool m_isValid;
+    };
+
+    /**
+     * A file opened for positioned writes. Every write names its own offset and no file position is shared, so writes to
+     * different ranges can be issued from several threads at once without locking. If the file cannot be opened, the bool
+     * operator returns false.
+     */
+    class AWS_CORE_API PositionedWriteFile
+    {
+    public:
+        /**
+         * Opens or creates the file at fileName for writing. If truncate is set, existing contents are discarded.
+         */
+        PositionedWriteFile(const char* fileName, bool truncate);
+        ~PositionedWriteFile();
+
+        PositionedWriteFile(const PositionedWriteFile&) = delete;
+        PositionedWriteFile& operator=(const PositionedWriteFile&) = delete;
+
+        /**
+         * If the file was opened successfully.
+         */
+        operator bool() const { return m_isValid; }
+
+        /**
+         * Reserves disk space for length bytes and extends the file to at least that size. Falls back to only setting
+         * the size where the platform cannot reserve space.
+         */
+        bool Preallocate(uint64_t length);
+
+        /**
+         * Writes length bytes from data at offset, retrying short writes. Thread safe for concurrent calls.
+         */
+        bool WriteAt(const unsigned char* data, size_t length, uint64_t offset);
+
+        /**
+         * Flushes written data to the storage device.
+         */
+        bool Sync();
+
+    private:
+#ifdef _WIN32
+        void* m_handle;
+#else
+        int m_fd;
+#endif
+        bool m_isValid;
+    };
+
+    /**
+     * A file opened for positioned reads. Every read names its own offset and no file position is shared, so different ranges
+     * can be read from several threads at once without locking. If the file cannot be opened, the bool operator returns false.
+     */
+    class AWS_CORE_API PositionedReadFile
+    {
+    public:
+        /**
+         * Opens the file at fileName for reading.
+         */
+        PositionedReadFile(const char* fileName);
+        ~PositionedReadFile();
+
+        PositionedReadFile(const PositionedReadFile&) = delete;
+        PositionedReadFile& operator=(const PositionedReadFile&) = delete;
+
+        /**
+         * If the file was opened successfully.
+         */
+        operator bool() const { return m_isValid; }
+
+        /**
+         * Reads length bytes at offset into data, retrying short reads. Fails if the file ends first. Thread safe for concurrent calls.
+         */
+        bool ReadAt(unsigned char* data, size_t length, uint64_t offset) const;
+
+    private:
+#ifdef _WIN32
+        void* m_handle;
+#else
+        int m_fd;
+#endif
+        bool m_isValid;
+    };
+
 } // namespace FileSystem
 } // namespace Aws
@@ -0,0 +1,32 @@
+/*
+  * Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+  *
+  * Licensed under the Apache License, Version 2.0 (the "License").
+  * You may not use this file except in compliance with the License.
+  * A copy of the License is located at
+  *
+  *  http://aws.amazon.com/apache2.0
+  *
+  * or in the "license" file accompanying this file. This file is distributed
+  * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+  * express or implied. See the License for the specific language governing
+  * permissions and limitations under the License.
+  */
+
+#pragma once
+
+#include <aws/core/Core_EXPORTS.h>
+#include <cstddef>
+
+namespace Aws
+{
+namespace Thread
+{
+
+    /*
+    * Restricts the calling thread to run on the given cpu core. Returns false where the platform has no affinity support or the call fails.
+    */
+    AWS_CORE_API bool PinCurrentThreadToCore(size_t core);
+
+} // namespace Thread
+} // namespace Aws
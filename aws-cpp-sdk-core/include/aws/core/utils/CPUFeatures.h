@@ -0,0 +1,56 @@
+/*
+* Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+*
+* Licensed under the Apache License, Version 2.0 (the "License").
+* You may not use this file except in compliance with the License.
+* A copy of the License is located at
+*
+*  http://aws.amazon.com/apache2.0
+*
+* or in the "license" file accompanying this file. This file is distributed
+* on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+* express or implied. See the License for the specific language governing
+* permissions and limitations under the License.
+*/
+
+#pragma once
+
+#include <aws/core/Core_EXPORTS.h>
+
+/**
+ * AWS_X86_SIMD is defined when building for x86 with a compiler that can emit SSSE3 and AVX2 code for individual functions, without
+ * raising the baseline of the whole library. Functions using those instruction sets are marked AWS_TARGET_SSSE3 / AWS_TARGET_AVX2 and
+ * must only be called after checking CPUFeatures.
+ */
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__clang__) || (defined(__GNUC__) && __GNUC__ >= 5))
+#define AWS_X86_SIMD 1
+#define AWS_TARGET_SSSE3 __attribute__((target("ssse3")))
+#define AWS_TARGET_AVX2 __attribute__((target("avx2")))
+#elif defined(_MSC_VER) && _MSC_VER >= 1800 && (defined(_M_X64) || defined(_M_IX86))
+#define AWS_X86_SIMD 1
+#define AWS_TARGET_SSSE3
+#define AWS_TARGET_AVX2
+#endif
+
+namespace Aws
+{
+    namespace Utils
+    {
+        /**
+         * Runtime detection of the vector instruction sets used by the SIMD code paths (base64 and hex codecs). The cpu is queried once.
+         * Everything reports false on other architectures and compilers.
+         */
+        class AWS_CORE_API CPUFeatures
+        {
+        public:
+            static bool HasSSSE3();
+            static bool HasAVX2();
+
+            /**
+             * Turns the SIMD code paths off (or back on) for the whole process, e.g. to compare them against the scalar ones.
+             */
+            static void SetSIMDEnabled(bool enabled);
+        };
+
+    } // namespace Utils
+} // namespace Aws
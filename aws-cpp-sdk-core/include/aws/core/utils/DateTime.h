@@ -27,7 +27,8 @@ namespace Aws
         {
             RFC822, //for http headers
             ISO_8601, //for query and xml payloads
-            AutoDetect
+            AutoDetect,
+            ISO_8601_BASIC //compact form without separators, e.g. 20021002T080509Z, used by sigv4
         };
 
         enum class Month
@@ -143,6 +144,20 @@ namespace Aws
             */
             Aws::String ToGmtString(const char* formatStr) const;
 
+            /**
+             * Writes dateTime as a GMT time string in one of the fixed formats to buffer, null terminated, without allocating and without
+             * going through strftime. Returns the length written, or 0 if the buffer is too small (see the *_LENGTH constants) or the year
+             * does not fit in four digits.
+             */
+            size_t ToGmtString(DateFormat format, char* buffer, size_t bufferSize) const;
+
+            /**
+             * Lengths of the fixed formats written by ToGmtString(DateFormat, char*, size_t), not counting the null terminator.
+             */
+            static const size_t RFC822_LENGTH = 29;
+            static const size_t ISO_8601_LENGTH = 20;
+            static const size_t ISO_8601_BASIC_LENGTH = 16;
+
             /**
              * Get the representation of this datetime as seconds.milliseconds since epoch
              */
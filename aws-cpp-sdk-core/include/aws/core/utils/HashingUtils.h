@@ -52,6 +52,30 @@ namespace Aws
             */
             static ByteBuffer HexDecode(const Aws::String& str);
 
+            /**
+            * Base64 encodes length bytes of data into output, which needs room for Base64::CalculateBase64EncodedLength(length) chars.
+            * No null terminator is written. Returns the number of chars written.
+            */
+            static size_t Base64Encode(const unsigned char* data, size_t length, char* output);
+
+            /**
+            * Base64 decodes length chars of encoded into output, which needs room for
+            * Base64::CalculateBase64DecodedLength(encoded, length) bytes. Returns the number of bytes written.
+            */
+            static size_t Base64Decode(const char* encoded, size_t length, unsigned char* output);
+
+            /**
+            * Lower case hex encodes length bytes of data into output, which needs room for 2 * length chars. No null terminator is
+            * written. Returns the number of chars written.
+            */
+            static size_t HexEncode(const unsigned char* data, size_t length, char* output);
+
+            /**
+            * Hex decodes length chars of str (no 0x prefix) into output, which needs room for length / 2 bytes. Returns the number of
+            * bytes written, or 0 if length is odd or str holds anything but hex digits.
+            */
+            static size_t HexDecode(const char* str, size_t length, unsigned char* output);
+
             /**
             * Calculates a SHA256 HMAC digest (not hex encoded)
             */
@@ -74,6 +98,7 @@ namespace Aws
 
             /**
             * Calculates a SHA256 Tree Hash digest on a stream (the entire stream is read, not hex encoded.)
+            * See Crypto::Sha256TreeHash to hash leaves in parallel, memory map files or get part tree hashes as well.
             */
             static ByteBuffer CalculateSHA256TreeHash(Aws::IOStream& stream);
 
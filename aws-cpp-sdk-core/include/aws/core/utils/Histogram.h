@@ -0,0 +1,94 @@
+/*
+* Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+*
+* Licensed under the Apache License, Version 2.0 (the "License").
+* You may not use this file except in compliance with the License.
+* A copy of the License is located at
+*
+*  http://aws.amazon.com/apache2.0
+*
+* or in the "license" file accompanying this file. This file is distributed
+* on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+* express or implied. See the License for the specific language governing
+* permissions and limitations under the License.
+*/
+
+#pragma once
+
+#include <aws/core/Core_EXPORTS.h>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace Aws
+{
+    namespace Utils
+    {
+        /**
+         * Fixed size, lock free histogram of non negative integer values, in the spirit of HdrHistogram. Values below 128 are counted
+         * exactly, above that every power of two range is split into 64 linear buckets, so any value is reported with at most 1/64th
+         * (about 1.6%) relative error. Values above GetHighestTrackableValue() are counted in the last bucket.
+         *
+         * Record() is a handful of relaxed atomic increments and may be called from any number of threads at once. Queries run
+         * concurrently with Record() and see a consistent enough view for monitoring, but not an atomic snapshot.
+         */
+        class AWS_CORE_API Histogram
+        {
+        public:
+            Histogram();
+
+            Histogram(const Histogram&) = delete;
+            Histogram& operator=(const Histogram&) = delete;
+
+            /**
+             * Counts one occurrence of value. Negative values are counted as zero.
+             */
+            void Record(int64_t value);
+
+            /**
+             * Number of values recorded since construction or the last Reset().
+             */
+            uint64_t GetCount() const { return m_count.load(std::memory_order_relaxed); }
+
+            /**
+             * Smallest and largest value recorded, 0 if nothing was recorded.
+             */
+            int64_t GetMin() const;
+            int64_t GetMax() const { return m_max.load(std::memory_order_relaxed); }
+
+            /**
+             * Exact mean of the recorded values, 0 if nothing was recorded.
+             */
+            double GetMean() const;
+
+            /**
+             * Returns the value below which percentile percent (0 - 100) of the recorded values fall, e.g. 99.9 for the p999.
+             * The result is the upper bound of the bucket the percentile falls into, capped at GetMax().
+             */
+            int64_t GetValueAtPercentile(double percentile) const;
+
+            /**
+             * Clears all counts. Values recorded concurrently with Reset() may or may not survive it.
+             */
+            void Reset();
+
+            static int64_t GetHighestTrackableValue();
+
+        private:
+            static size_t BucketIndex(int64_t value);
+            static int64_t BucketUpperBound(size_t index);
+
+            static const size_t SUB_BUCKET_BITS = 6;
+            static const size_t SUB_BUCKET_COUNT = 1 << SUB_BUCKET_BITS;
+            static const size_t MAX_VALUE_BITS = 36;
+            static const size_t BUCKET_COUNT = (MAX_VALUE_BITS - SUB_BUCKET_BITS + 1) * SUB_BUCKET_COUNT;
+
+            std::atomic<uint64_t> m_buckets[BUCKET_COUNT];
+            std::atomic<uint64_t> m_count;
+            std::atomic<int64_t> m_sum;
+            std::atomic<int64_t> m_min;
+            std::atomic<int64_t> m_max;
+        };
+
+    } // namespace Utils
+} // namespace Aws
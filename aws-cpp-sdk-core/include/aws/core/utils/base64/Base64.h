@@ -58,19 +58,35 @@ namespace Aws
                 */
                 ByteBuffer Decode(const Aws::String&) const;
 
+                /**
+                * Encode length bytes of data into output, which must have room for CalculateBase64EncodedLength(length) chars. No null
+                * terminator is written. Returns the number of chars written.
+                */
+                size_t Encode(const unsigned char* data, size_t length, char* output) const;
+
+                /**
+                * Decode length chars of input into output, which must have room for CalculateBase64DecodedLength(input, length) bytes.
+                * Returns the number of bytes written.
+                */
+                size_t Decode(const char* input, size_t length, unsigned char* output) const;
+
                 /**
                 * Calculates the required length of a base64 buffer after decoding the
                 * input string.
                 */
                 static size_t CalculateBase64DecodedLength(const Aws::String& b64input);
+                static size_t CalculateBase64DecodedLength(const char* b64input, size_t length);
                 /**
                 * Calculates the length of an encoded base64 string based on the buffer being encoded
                 */
                 static size_t CalculateBase64EncodedLength(const ByteBuffer& buffer);
+                static size_t CalculateBase64EncodedLength(size_t length);
 
             private:
                 char m_mimeBase64EncodingTable[64];
                 uint8_t m_mimeBase64DecodingTable[256];
+                //the vectorized codecs have the standard alphabet built in, custom tables always take the scalar path.
+                bool m_isStandardTable;
 
             };
 
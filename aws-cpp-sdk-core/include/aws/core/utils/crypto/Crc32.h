@@ -0,0 +1,75 @@
+/*
+* Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+*
+* Licensed under the Apache License, Version 2.0 (the "License").
+* You may not use this file except in compliance with the License.
+* A copy of the License is located at
+*
+*  http://aws.amazon.com/apache2.0
+*
+* or in the "license" file accompanying this file. This file is distributed
+* on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+* express or implied. See the License for the specific language governing
+* permissions and limitations under the License.
+*/
+
+#pragma once
+
+#include <aws/core/Core_EXPORTS.h>
+#include <aws/core/utils/crypto/Hash.h>
+
+namespace Aws
+{
+    namespace Utils
+    {
+        namespace Crypto
+        {
+            /**
+             * CRC32 (IEEE 802.3, as used by zlib and the x-amz-crc32 header) checksum. This is a software implementation and does not
+             * depend on the crypto library. The 4 byte result is big endian.
+             */
+            class AWS_CORE_API Crc32 : public Hash
+            {
+            public:
+                Crc32();
+                virtual ~Crc32() = default;
+
+                /**
+                * Calculates the CRC32 of str
+                */
+                virtual HashResult Calculate(const Aws::String& str) override;
+
+                /**
+                * Calculates the CRC32 of a stream (the entire stream is read)
+                */
+                virtual HashResult Calculate(Aws::IStream& stream) override;
+
+                /**
+                * Calculates the CRC32 of length bytes of data
+                */
+                virtual HashResult Calculate(const unsigned char* data, size_t length) override;
+
+                virtual bool IsIncremental() const override { return true; }
+
+                /**
+                * Adds length bytes of data to the CRC32 returned by GetHash()
+                */
+                virtual void Update(const unsigned char* data, size_t length) override;
+
+                /**
+                * Returns the CRC32 of the data passed to Update() since the last call
+                */
+                virtual HashResult GetHash() override;
+
+                /**
+                * Continues crc, the CRC32 of some preceding data (0 for none), over length bytes of data.
+                */
+                static uint32_t Checksum(uint32_t crc, const unsigned char* data, size_t length);
+
+            private:
+                uint32_t m_crc;
+            };
+
+        } // namespace Crypto
+    } // namespace Utils
+} // namespace Aws
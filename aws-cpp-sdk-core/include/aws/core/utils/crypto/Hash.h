@@ -46,6 +46,30 @@ namespace Aws
                 */
                 virtual HashResult Calculate(Aws::IStream& stream) = 0;
 
+                /**
+                * Calculates a Hash digest on length bytes of data. The default implementation copies data into a string, implementations
+                * should hash the buffer in place.
+                */
+                virtual HashResult Calculate(const unsigned char* data, size_t length);
+
+                /**
+                * True if the implementation overrides Update() and GetHash() to hash data as it comes. Callers should fall back to
+                * Calculate() otherwise.
+                */
+                virtual bool IsIncremental() const { return false; }
+
+                /**
+                * Adds length bytes of data to a digest computed over several calls. Only meaningful if IsIncremental(), the default
+                * implementation ignores the data.
+                */
+                virtual void Update(const unsigned char* data, size_t length);
+
+                /**
+                * Returns the digest of everything passed to Update() since the last call and starts over. The default implementation
+                * always fails.
+                */
+                virtual HashResult GetHash();
+
                 // when hashing streams, this is the size of our internal buffer we read the stream into
                 static const uint32_t INTERNAL_HASH_STREAM_BUFFER_SIZE = 8192;
             };
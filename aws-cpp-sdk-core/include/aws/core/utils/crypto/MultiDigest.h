@@ -0,0 +1,97 @@
+/*
+* Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+*
+* Licensed under the Apache License, Version 2.0 (the "License").
+* You may not use this file except in compliance with the License.
+* A copy of the License is located at
+*
+*  http://aws.amazon.com/apache2.0
+*
+* or in the "license" file accompanying this file. This file is distributed
+* on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+* express or implied. See the License for the specific language governing
+* permissions and limitations under the License.
+*/
+
+#pragma once
+
+#include <aws/core/Core_EXPORTS.h>
+#include <aws/core/utils/Array.h>
+#include <aws/core/utils/crypto/HashResult.h>
+#include <aws/core/utils/memory/stl/AWSStreamFwd.h>
+#include <aws/core/utils/memory/stl/AWSVector.h>
+#include <memory>
+
+namespace Aws
+{
+    namespace Utils
+    {
+        namespace Crypto
+        {
+            class Hash;
+
+            /**
+             * Digests MultiDigest can compute.
+             */
+            enum class DigestAlgorithm
+            {
+                MD5,
+                SHA256,
+                CRC32
+            };
+
+            /**
+             * Computes several digests of the same data in one pass, so a request body that needs a Content-MD5, a payload SHA256 and a
+             * checksum is read once instead of once per digest. Hashes that are not incremental (see Hash::IsIncremental) are computed
+             * with their own Calculate call instead. Not thread safe, use one instance per thread.
+             */
+            class AWS_CORE_API MultiDigest
+            {
+            public:
+                /**
+                 * Adds algorithm to the digests computed by Calculate. Adding an algorithm twice has no effect.
+                 */
+                void AddAlgorithm(DigestAlgorithm algorithm);
+
+                /**
+                 * True if algorithm was added.
+                 */
+                bool HasAlgorithm(DigestAlgorithm algorithm) const;
+
+                /**
+                 * Reads the entire stream once, feeding every digest, then restores the read position. Returns false if the stream
+                 * could not be read or a digest failed.
+                 */
+                bool Calculate(Aws::IStream& stream);
+
+                /**
+                 * Digests length bytes of data. Returns false if a digest failed.
+                 */
+                bool Calculate(const unsigned char* data, size_t length);
+
+                /**
+                 * Digest of algorithm from the last Calculate, empty if the algorithm was not added or failed.
+                 */
+                const ByteBuffer& GetDigest(DigestAlgorithm algorithm) const;
+
+                // when digesting streams, this is the size of the buffer the stream is read into
+                static const size_t STREAM_BUFFER_SIZE = 64 * 1024;
+
+            private:
+                struct Digest
+                {
+                    DigestAlgorithm algorithm;
+                    std::shared_ptr<Hash> hash;
+                    ByteBuffer result;
+                };
+
+                bool FinishDigests();
+                static bool SetResult(Digest& digest, HashResult&& hashResult);
+
+                Aws::Vector<Digest> m_digests;
+                ByteBuffer m_emptyDigest;
+            };
+
+        } // namespace Crypto
+    } // namespace Utils
+} // namespace Aws
@@ -64,6 +64,26 @@ namespace Aws
                 */
                 virtual HashResult Calculate(Aws::IStream& stream) override;
 
+                /**
+                * Calculates a SHA256 digest on length bytes of data
+                */
+                virtual HashResult Calculate(const unsigned char* data, size_t length) override;
+
+                /**
+                * True if the underlying implementation digests data passed to Update() as it comes
+                */
+                virtual bool IsIncremental() const override;
+
+                /**
+                * Adds length bytes of data to the SHA256 digest returned by GetHash()
+                */
+                virtual void Update(const unsigned char* data, size_t length) override;
+
+                /**
+                * Returns the SHA256 digest of the data passed to Update() since the last call
+                */
+                virtual HashResult GetHash() override;
+
             private:
 
                 std::shared_ptr< Hash > m_hashImpl;
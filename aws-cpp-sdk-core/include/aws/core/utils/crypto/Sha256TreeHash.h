@@ -0,0 +1,83 @@
+/*
+* Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+*
+* Licensed under the Apache License, Version 2.0 (the "License").
+* You may not use this file except in compliance with the License.
+* A copy of the License is located at
+*
+*  http://aws.amazon.com/apache2.0
+*
+* or in the "license" file accompanying this file. This file is distributed
+* on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+* express or implied. See the License for the specific language governing
+* permissions and limitations under the License.
+*/
+
+#pragma once
+
+#include <aws/core/Core_EXPORTS.h>
+#include <aws/core/utils/Array.h>
+#include <aws/core/utils/memory/stl/AWSVector.h>
+
+namespace Aws
+{
+    namespace Utils
+    {
+        namespace Threading
+        {
+            class Executor;
+        }
+
+        namespace Crypto
+        {
+            /**
+             * Result of a SHA256 tree hash. Part tree hashes are only filled in when a part size was given.
+             */
+            struct AWS_CORE_API TreeHashResult
+            {
+                ByteBuffer archiveTreeHash;
+                Aws::Vector<ByteBuffer> partTreeHashes;
+            };
+
+            /**
+             * Computes the SHA256 tree hash used by Amazon Glacier (http://docs.aws.amazon.com/amazonglacier/latest/dev/checksum-calculations.html).
+             * The 1 MB leaves are hashed in parallel on an executor, with the calling thread helping out, and both the tree hash of every
+             * part of a multipart upload and the tree hash of the whole archive are reduced from the same leaf hashes, so the data is read once.
+             * Files are memory mapped rather than read through a stream.
+             */
+            class AWS_CORE_API Sha256TreeHash
+            {
+            public:
+                static const size_t LEAF_SIZE = 1024 * 1024;
+
+                /**
+                 * Leaves are hashed on up to concurrency tasks of executor besides the calling thread. With no executor or a concurrency of 0,
+                 * everything is hashed on the calling thread. The executor must outlive the hasher.
+                 */
+                Sha256TreeHash(Threading::Executor* executor = nullptr, size_t concurrency = 0);
+
+                /**
+                 * Tree hashes length bytes of data. If partSize is not 0, the tree hash of each partSize sized part is computed as well. Glacier
+                 * requires partSize to be LEAF_SIZE times a power of two; it must at least be a multiple of LEAF_SIZE, otherwise no part tree
+                 * hashes are computed.
+                 */
+                TreeHashResult Calculate(const unsigned char* data, size_t length, size_t partSize = 0) const;
+
+                /**
+                 * Same as Calculate, over the memory mapped contents of fileName. Returns an empty result if the file cannot be mapped.
+                 */
+                TreeHashResult CalculateFile(const char* fileName, size_t partSize = 0) const;
+
+                /**
+                 * Reduces the hashes in [begin, end) of leafHashes to their tree hash by hashing adjacent pairs level by level.
+                 */
+                static ByteBuffer ComputeTreeHash(const Aws::Vector<ByteBuffer>& leafHashes, size_t begin, size_t end);
+
+            private:
+                Threading::Executor* m_executor;
+                size_t m_concurrency;
+            };
+
+        } // namespace Crypto
+    } // namespace Utils
+} // namespace Aws
@@ -70,6 +70,10 @@ namespace Aws
                  * Calculates a Hash on str.
                  */
                 HashResult Calculate(const Aws::String& str);
+                /**
+                 * Calculates a Hash on length bytes of data.
+                 */
+                HashResult Calculate(const unsigned char* data, size_t length);
                 /**
                  * Calculates an HMAC on toHash using secret
                  */
@@ -78,6 +82,14 @@ namespace Aws
                  * Calculates a Hash on the stream without loading the entire stream into memory at once.
                  */
                 HashResult Calculate(Aws::IStream& stream);
+                /**
+                 * Adds length bytes of data to the hash returned by GetHash().
+                 */
+                void Update(const unsigned char* data, size_t length);
+                /**
+                 * Returns the hash of the data passed to Update() since the last call.
+                 */
+                HashResult GetHash();
 
             private:
 
@@ -94,6 +106,11 @@ namespace Aws
                 DWORD m_hashObjectLength;
                 PBYTE m_hashObject;
 
+                // Update() keeps its hash handle open across calls, so it gets its own hash object
+                PBYTE m_updateHashObject;
+                BCryptHashContext* m_updateContext;
+                bool m_updateFailed;
+
                 //I'm 99% sure the algorithm handle for windows is not thread safe, but I can't 
                 //prove or disprove that theory. Therefore, we have to lock to be safe.
                 std::mutex m_algorithmMutex;
@@ -119,6 +136,20 @@ namespace Aws
                  * Calculates a md5 hash on the stream without loading the entire stream into memory at once.
                  */
                 virtual HashResult Calculate(Aws::IStream& stream) override;
+                /**
+                 * Calculates md5 hash on length bytes of data.
+                 */
+                virtual HashResult Calculate(const unsigned char* data, size_t length) override;
+
+                virtual bool IsIncremental() const override { return true; }
+                /**
+                 * Adds length bytes of data to the md5 hash returned by GetHash().
+                 */
+                virtual void Update(const unsigned char* data, size_t length) override;
+                /**
+                 * Returns the md5 hash of the data passed to Update() since the last call.
+                 */
+                virtual HashResult GetHash() override;
 
             private:
                 BCryptHashImpl m_impl;
@@ -144,6 +175,20 @@ namespace Aws
                  * Calculates a sha256 hash on the stream without loading the entire stream into memory at once.
                  */
                 virtual HashResult Calculate(Aws::IStream& stream) override;
+                /**
+                 * Calculates sha256 hash on length bytes of data.
+                 */
+                virtual HashResult Calculate(const unsigned char* data, size_t length) override;
+
+                virtual bool IsIncremental() const override { return true; }
+                /**
+                 * Adds length bytes of data to the sha256 hash returned by GetHash().
+                 */
+                virtual void Update(const unsigned char* data, size_t length) override;
+                /**
+                 * Returns the sha256 hash of the data passed to Update() since the last call.
+                 */
+                virtual HashResult GetHash() override;
 
             private:
                 BCryptHashImpl m_impl;
@@ -19,6 +19,7 @@
 #include <aws/core/utils/crypto/HMAC.h>
 #include <aws/core/utils/crypto/SecureRandom.h>
 #include <aws/core/utils/crypto/Cipher.h>
+#include <CommonCrypto/CommonDigest.h>
 
 struct _CCCryptor;
 
@@ -58,25 +59,49 @@ namespace Aws
             {
             public:
 
-                MD5CommonCryptoImpl() {}
+                MD5CommonCryptoImpl() : m_isUpdating(false) {}
                 virtual ~MD5CommonCryptoImpl() {}
 
                 virtual HashResult Calculate(const Aws::String& str) override;
 
                 virtual HashResult Calculate(Aws::IStream& stream) override;
 
+                virtual HashResult Calculate(const unsigned char* data, size_t length) override;
+
+                virtual bool IsIncremental() const override { return true; }
+
+                virtual void Update(const unsigned char* data, size_t length) override;
+
+                virtual HashResult GetHash() override;
+
+            private:
+                CC_MD5_CTX m_md5;
+                bool m_isUpdating;
+
             };
 
             class Sha256CommonCryptoImpl : public Hash
             {
             public:
 
-                Sha256CommonCryptoImpl() {}
+                Sha256CommonCryptoImpl() : m_isUpdating(false) {}
                 virtual ~Sha256CommonCryptoImpl() {}
 
                 virtual HashResult Calculate(const Aws::String& str) override;
 
                 virtual HashResult Calculate(Aws::IStream& stream) override;
+
+                virtual HashResult Calculate(const unsigned char* data, size_t length) override;
+
+                virtual bool IsIncremental() const override { return true; }
+
+                virtual void Update(const unsigned char* data, size_t length) override;
+
+                virtual HashResult GetHash() override;
+
+            private:
+                CC_SHA256_CTX m_sha256;
+                bool m_isUpdating;
             };
 
             class Sha256HMACCommonCryptoImpl : public HMAC
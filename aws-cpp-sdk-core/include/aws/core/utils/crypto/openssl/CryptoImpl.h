@@ -69,28 +69,55 @@ namespace Aws
             {
             public:
 
-                MD5OpenSSLImpl()
+                MD5OpenSSLImpl() : m_ctx(nullptr)
                 { }
 
-                virtual ~MD5OpenSSLImpl() = default;
+                virtual ~MD5OpenSSLImpl();
+
+                MD5OpenSSLImpl(const MD5OpenSSLImpl&) = delete;
+                MD5OpenSSLImpl& operator=(const MD5OpenSSLImpl&) = delete;
 
                 virtual HashResult Calculate(const Aws::String& str) override;
 
                 virtual HashResult Calculate(Aws::IStream& stream) override;
 
+                virtual HashResult Calculate(const unsigned char* data, size_t length) override;
+
+                virtual bool IsIncremental() const override { return true; }
+
+                virtual void Update(const unsigned char* data, size_t length) override;
+
+                virtual HashResult GetHash() override;
+
+            private:
+                EVP_MD_CTX* m_ctx;
             };
 
             class Sha256OpenSSLImpl : public Hash
             {
             public:
-                Sha256OpenSSLImpl()
+                Sha256OpenSSLImpl() : m_ctx(nullptr)
                 { }
 
-                virtual ~Sha256OpenSSLImpl() = default;
+                virtual ~Sha256OpenSSLImpl();
+
+                Sha256OpenSSLImpl(const Sha256OpenSSLImpl&) = delete;
+                Sha256OpenSSLImpl& operator=(const Sha256OpenSSLImpl&) = delete;
 
                 virtual HashResult Calculate(const Aws::String& str) override;
 
                 virtual HashResult Calculate(Aws::IStream& stream) override;
+
+                virtual HashResult Calculate(const unsigned char* data, size_t length) override;
+
+                virtual bool IsIncremental() const override { return true; }
+
+                virtual void Update(const unsigned char* data, size_t length) override;
+
+                virtual HashResult GetHash() override;
+
+            private:
+                EVP_MD_CTX* m_ctx;
             };
 
             class Sha256HMACOpenSSLImpl : public HMAC
@@ -0,0 +1,251 @@
+
+/*
+* Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+*
+* Licensed under the Apache License, Version 2.0 (the "License").
+* You may not use this file except in compliance with the License.
+* A copy of the License is located at
+*
+*  http://aws.amazon.com/apache2.0
+*
+* or in the "license" file accompanying this file. This file is distributed
+* on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+* express or implied. See the License for the specific language governing
+* permissions and limitations under the License.
+*/
+
+#pragma once
+
+#include <aws/core/Core_EXPORTS.h>
+
+#include <aws/core/utils/Array.h>
+#include <aws/core/utils/json/JsonSerializer.h>
+#include <aws/core/utils/memory/stl/AWSStreamFwd.h>
+#include <aws/core/utils/memory/stl/AWSString.h>
+#include <aws/core/utils/memory/stl/AWSVector.h>
+#include <aws/core/utils/memory/stl/AWSMap.h>
+
+#include <utility>
+
+namespace Aws
+{
+    namespace Utils
+    {
+        class DateTime;
+
+        namespace Json
+        {
+            /**
+             * Forward only pull reader over a json document. Values are read straight into the caller's objects as the input is scanned,
+             * no document tree is built. Every read returns false and latches an error on malformed input or on a value of the wrong type;
+             * once an error is latched all further reads fail.
+             *
+             * Objects are read with StartObject() followed by NextMember() until it returns false; NextMember() leaves the reader positioned at
+             * the member's value, which must be read or skipped before the next call. Arrays are read the same way with StartArray() and NextElement().
+             */
+            class AWS_CORE_API JsonReader
+            {
+            public:
+                /**
+                 * Reads length bytes of json at data, without copying them. data must outlive the reader.
+                 */
+                JsonReader(const char* data, size_t length);
+
+                /**
+                 * Reads json from stream, pulling it through the stream's buffer a chunk at a time.
+                 */
+                JsonReader(Aws::IStream& stream);
+
+                JsonReader(const JsonReader&) = delete;
+                JsonReader& operator=(const JsonReader&) = delete;
+
+                /**
+                 * Consumes the opening brace of an object.
+                 */
+                bool StartObject();
+
+                /**
+                 * Returns true and sets key if the current object has another member, false once the closing brace has been consumed
+                 * or on error.
+                 */
+                bool NextMember(Aws::String& key);
+
+                /**
+                 * Consumes the opening bracket of an array.
+                 */
+                bool StartArray();
+
+                /**
+                 * Returns true if the current array has another element, false once the closing bracket has been consumed or on error.
+                 */
+                bool NextElement();
+
+                bool ReadString(Aws::String& value);
+                bool ReadInteger(int& value);
+                bool ReadInt64(long long& value);
+                bool ReadDouble(double& value);
+                bool ReadBool(bool& value);
+
+                /**
+                 * Consumes a null and returns true if it is the next value. Returns false, consuming nothing, for any other value.
+                 */
+                bool ReadNull();
+
+                /**
+                 * Reads the next value, whatever its type, into a document tree.
+                 */
+                bool ReadValue(JsonValue& value);
+
+                /**
+                 * Consumes the next value, whatever its type, without materializing it.
+                 */
+                bool SkipValue();
+
+                inline bool HasError() const { return m_hasError; }
+
+                inline const Aws::String& GetErrorMessage() const { return m_errorMessage; }
+
+            private:
+                static const size_t CHUNK_SIZE = 4096;
+
+                int PeekChar();
+                int GetChar();
+                int PeekToken();
+                bool Refill();
+                bool Expect(char expected, const char* what);
+                bool ReadScalar(char* token, size_t capacity, size_t& length, const char* what);
+                bool ReadEscape(Aws::String& value);
+                bool ReadHex4(unsigned& codePoint);
+                bool SkipString();
+                bool SetError(const char* what);
+
+                const char* m_current;
+                const char* m_end;
+                Aws::IStream* m_stream;
+                Aws::String* m_capture;
+                size_t m_offset;
+                bool m_afterOpen;
+                bool m_hasError;
+                Aws::String m_errorMessage;
+                char m_chunk[CHUNK_SIZE];
+            };
+
+            AWS_CORE_API bool ReadJson(JsonReader& reader, Aws::String& value);
+            AWS_CORE_API bool ReadJson(JsonReader& reader, int& value);
+            AWS_CORE_API bool ReadJson(JsonReader& reader, long long& value);
+            AWS_CORE_API bool ReadJson(JsonReader& reader, double& value);
+            AWS_CORE_API bool ReadJson(JsonReader& reader, bool& value);
+
+            /**
+             * Blobs are base64 encoded strings.
+             */
+            AWS_CORE_API bool ReadJson(JsonReader& reader, ByteBuffer& value);
+
+            /**
+             * Timestamps are seconds since the epoch.
+             */
+            AWS_CORE_API bool ReadJson(JsonReader& reader, Aws::Utils::DateTime& value);
+            AWS_CORE_API bool ReadJson(JsonReader& reader, JsonValue& value);
+
+            /**
+             * Converts an object member name into a map key. Enumerations provide their own overload next to their mapper.
+             */
+            inline bool ReadJsonKey(const Aws::String& key, Aws::String& value)
+            {
+                value = key;
+                return true;
+            }
+
+            template<typename T>
+            bool ReadJson(JsonReader& reader, Aws::Vector<T>& value);
+
+            template<typename K, typename T>
+            bool ReadJson(JsonReader& reader, Aws::Map<K, T>& value);
+
+            /**
+             * Generated structures read themselves through Deserialize(JsonReader&).
+             */
+            template<typename T>
+            auto ReadJsonObject(JsonReader& reader, T& value, int) -> decltype(value.Deserialize(reader))
+            {
+                return reader.ReadNull() || value.Deserialize(reader);
+            }
+
+            /**
+             * Anything else that can be built from a JsonValue is read through a document tree of just that value.
+             */
+            template<typename T>
+            auto ReadJsonObject(JsonReader& reader, T& value, long) -> decltype(value = T(std::declval<const JsonValue&>()), bool())
+            {
+                JsonValue json;
+                if (!reader.ReadValue(json))
+                {
+                    return false;
+                }
+                value = T(json);
+                return true;
+            }
+
+            template<typename T>
+            auto ReadJson(JsonReader& reader, T& value) -> decltype(ReadJsonObject(reader, value, 0))
+            {
+                return ReadJsonObject(reader, value, 0);
+            }
+
+            template<typename T>
+            bool ReadJson(JsonReader& reader, Aws::Vector<T>& value)
+            {
+                value.clear();
+                if (reader.ReadNull())
+                {
+                    return true;
+                }
+
+                if (!reader.StartArray())
+                {
+                    return false;
+                }
+
+                while (reader.NextElement())
+                {
+                    T element;
+                    if (!ReadJson(reader, element))
+                    {
+                        return false;
+                    }
+                    value.push_back(std::move(element));
+                }
+
+                return !reader.HasError();
+            }
+
+            template<typename K, typename T>
+            bool ReadJson(JsonReader& reader, Aws::Map<K, T>& value)
+            {
+                value.clear();
+                if (reader.ReadNull())
+                {
+                    return true;
+                }
+
+                if (!reader.StartObject())
+                {
+                    return false;
+                }
+
+                Aws::String name;
+                while (reader.NextMember(name))
+                {
+                    K key;
+                    if (!ReadJsonKey(name, key) || !ReadJson(reader, value[key]))
+                    {
+                        return false;
+                    }
+                }
+
+                return !reader.HasError();
+            }
+        } // namespace Json
+    } // namespace Utils
+} // namespace Aws
+
@@ -52,6 +52,11 @@ namespace Aws
                 */
                 JsonValue(Aws::IStream& istream);
 
+                /**
+                * Constructs a json object from length bytes of json at data, without copying them first
+                */
+                JsonValue(const char* data, size_t length);
+
                 /**
                 * Copy Constructor
                 */
@@ -0,0 +1,166 @@
+
+/*
+* Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+*
+* Licensed under the Apache License, Version 2.0 (the "License").
+* You may not use this file except in compliance with the License.
+* A copy of the License is located at
+*
+*  http://aws.amazon.com/apache2.0
+*
+* or in the "license" file accompanying this file. This file is distributed
+* on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+* express or implied. See the License for the specific language governing
+* permissions and limitations under the License.
+*/
+
+#pragma once
+
+#include <aws/core/Core_EXPORTS.h>
+
+#include <aws/core/utils/Array.h>
+#include <aws/core/utils/json/JsonSerializer.h>
+#include <aws/core/utils/memory/stl/AWSString.h>
+#include <aws/core/utils/memory/stl/AWSVector.h>
+#include <aws/core/utils/memory/stl/AWSMap.h>
+
+namespace Aws
+{
+    namespace Utils
+    {
+        class DateTime;
+
+        namespace Json
+        {
+            /**
+             * Forward only json writer that appends compact json straight onto the end of a caller supplied string, without building a
+             * JsonValue tree first. Separators are inserted automatically; the caller is responsible for balancing Start and End calls and
+             * for writing a Key() before each value inside an object.
+             */
+            class AWS_CORE_API JsonWriter
+            {
+            public:
+                /**
+                 * Appends to output. Whatever output already holds is kept, so a reused buffer should be cleared first.
+                 */
+                JsonWriter(Aws::String& output);
+
+                JsonWriter(const JsonWriter&) = delete;
+                JsonWriter& operator=(const JsonWriter&) = delete;
+
+                void StartObject();
+                void EndObject();
+                void StartArray();
+                void EndArray();
+
+                void Key(const char* key);
+                void Key(const Aws::String& key);
+
+                void String(const char* value);
+                void String(const Aws::String& value);
+                void Integer(int value);
+                void Int64(long long value);
+
+                /**
+                 * Non finite values have no json representation and are written as null.
+                 */
+                void Double(double value);
+                void Bool(bool value);
+                void Null();
+
+                /**
+                 * Writes json, which must already be a complete serialized value, verbatim.
+                 */
+                void RawValue(const Aws::String& json);
+
+                inline const Aws::String& GetOutput() const { return m_output; }
+
+            private:
+                void BeginValue();
+                void AppendEscaped(const char* value, size_t length);
+
+                Aws::String& m_output;
+                bool m_needsSeparator;
+            };
+
+            AWS_CORE_API void WriteJson(JsonWriter& writer, const Aws::String& value);
+            AWS_CORE_API void WriteJson(JsonWriter& writer, int value);
+            AWS_CORE_API void WriteJson(JsonWriter& writer, long long value);
+            AWS_CORE_API void WriteJson(JsonWriter& writer, double value);
+            AWS_CORE_API void WriteJson(JsonWriter& writer, bool value);
+
+            /**
+             * Blobs are written as base64 encoded strings.
+             */
+            AWS_CORE_API void WriteJson(JsonWriter& writer, const ByteBuffer& value);
+
+            /**
+             * Timestamps are written as seconds since the epoch.
+             */
+            AWS_CORE_API void WriteJson(JsonWriter& writer, const Aws::Utils::DateTime& value);
+            AWS_CORE_API void WriteJson(JsonWriter& writer, const JsonValue& value);
+
+            /**
+             * Writes a map key as an object member name. Enumerations provide their own overload next to their mapper.
+             */
+            inline void WriteJsonKey(JsonWriter& writer, const Aws::String& key)
+            {
+                writer.Key(key);
+            }
+
+            template<typename T>
+            void WriteJson(JsonWriter& writer, const Aws::Vector<T>& value);
+
+            template<typename K, typename T>
+            void WriteJson(JsonWriter& writer, const Aws::Map<K, T>& value);
+
+            /**
+             * Generated structures write themselves through Serialize(JsonWriter&).
+             */
+            template<typename T>
+            auto WriteJsonObject(JsonWriter& writer, const T& value, int) -> decltype(value.Serialize(writer))
+            {
+                value.Serialize(writer);
+            }
+
+            /**
+             * Anything else that can produce a JsonValue is written through a document tree of just that value.
+             */
+            template<typename T>
+            auto WriteJsonObject(JsonWriter& writer, const T& value, long) -> decltype(value.Jsonize(), void())
+            {
+                WriteJson(writer, value.Jsonize());
+            }
+
+            template<typename T>
+            auto WriteJson(JsonWriter& writer, const T& value) -> decltype(WriteJsonObject(writer, value, 0))
+            {
+                WriteJsonObject(writer, value, 0);
+            }
+
+            template<typename T>
+            void WriteJson(JsonWriter& writer, const Aws::Vector<T>& value)
+            {
+                writer.StartArray();
+                for (const auto& element : value)
+                {
+                    WriteJson(writer, element);
+                }
+                writer.EndArray();
+            }
+
+            template<typename K, typename T>
+            void WriteJson(JsonWriter& writer, const Aws::Map<K, T>& value)
+            {
+                writer.StartObject();
+                for (const auto& entry : value)
+                {
+                    WriteJsonKey(writer, entry.first);
+                    WriteJson(writer, entry.second);
+                }
+                writer.EndObject();
+            }
+        } // namespace Json
+    } // namespace Utils
+} // namespace Aws
+
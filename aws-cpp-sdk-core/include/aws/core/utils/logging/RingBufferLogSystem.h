@@ -0,0 +1,151 @@
+/*
+  * Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+  *
+  * Licensed under the Apache License, Version 2.0 (the "License").
+  * You may not use this file except in compliance with the License.
+  * A copy of the License is located at
+  *
+  *  http://aws.amazon.com/apache2.0
+  *
+  * or in the "license" file accompanying this file. This file is distributed
+  * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+  * express or implied. See the License for the specific language governing
+  * permissions and limitations under the License.
+  */
+
+#pragma once
+
+#include <aws/core/Core_EXPORTS.h>
+
+#include <aws/core/utils/logging/LogSystemInterface.h>
+#include <aws/core/utils/logging/LogLevel.h>
+#include <aws/core/utils/memory/stl/AWSString.h>
+#include <aws/core/utils/memory/stl/AWSVector.h>
+#include <aws/core/utils/memory/stl/AWSStreamFwd.h>
+
+#include <thread>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <condition_variable>
+
+namespace Aws
+{
+    namespace Utils
+    {
+        namespace Logging
+        {
+            /**
+             * What a logging thread does when its ring buffer is full.
+             */
+            enum class RingBufferOverflowPolicy
+            {
+                /**
+                 * Discard the statement and count it in GetDroppedCount(). Logging never waits on the output.
+                 */
+                DROP,
+                /**
+                 * Wait for the drainer to free a record and count the wait in GetBlockedCount(). No statement is lost.
+                 */
+                BLOCK
+            };
+
+            /**
+             * Logger for high statement rates. Statements are written as fixed size binary records (timestamp, level, thread id, tag and
+             * message text) into one of several bounded lock-free ring buffers, picked by the logging thread's id, and a single background
+             * thread formats them into "[LEVEL] timestamp tag [threadid] message" lines and writes them out. Logging a statement takes no
+             * lock and, unless the message is longer than a record holds, no allocation.
+             *
+             * Statements from one thread come out in order; statements from different threads are only ordered within a ring.
+             */
+            class AWS_CORE_API RingBufferLogSystem : public LogSystemInterface
+            {
+            public:
+                using Base = LogSystemInterface;
+
+                /**
+                 * Initializes the logging system to write to the supplied logfile output. recordsPerRing is rounded up to a power of two, two at least.
+                 * Creates the drainer thread on construction.
+                 */
+                RingBufferLogSystem(LogLevel logLevel, const std::shared_ptr<Aws::OStream>& logFile,
+                        RingBufferOverflowPolicy overflowPolicy = RingBufferOverflowPolicy::DROP, size_t recordsPerRing = 256);
+                /**
+                 * Initializes the logging system to write to a computed file path filenamePrefix + "timestamp.log", rolled every hour.
+                 * Creates the drainer thread on construction.
+                 */
+                RingBufferLogSystem(LogLevel logLevel, const Aws::String& filenamePrefix,
+                        RingBufferOverflowPolicy overflowPolicy = RingBufferOverflowPolicy::DROP, size_t recordsPerRing = 256);
+                virtual ~RingBufferLogSystem();
+
+                RingBufferLogSystem(const RingBufferLogSystem&) = delete;
+                RingBufferLogSystem& operator=(const RingBufferLogSystem&) = delete;
+
+                /**
+                 * Gets the currently configured log level.
+                 */
+                virtual LogLevel GetLogLevel(void) const override { return m_logLevel; }
+                /**
+                 * Set a new log level. This has the immediate effect of changing the log output to the new level.
+                 */
+                void SetLogLevel(LogLevel logLevel) { m_logLevel.store(logLevel); }
+
+                /**
+                 * Formats the statement straight into a ring buffer record. Don't use this, it's unsafe. See LogStream
+                 */
+                virtual void Log(LogLevel logLevel, const char* tag, const char* formatStr, ...) override;
+
+                /**
+                 * Copies the stream's contents into a ring buffer record.
+                 */
+                virtual void LogStream(LogLevel logLevel, const char* tag, const Aws::OStringStream& messageStream) override;
+
+                /**
+                 * Statements discarded because their ring was full, under RingBufferOverflowPolicy::DROP.
+                 */
+                size_t GetDroppedCount() const { return m_droppedCount.load(); }
+
+                /**
+                 * Statements that had to wait for room in their ring, under RingBufferOverflowPolicy::BLOCK.
+                 */
+                size_t GetBlockedCount() const { return m_blockedCount.load(); }
+
+                /**
+                 * Statements too long for a record, whose text was moved to the heap instead.
+                 */
+                size_t GetSpilledCount() const { return m_spilledCount.load(); }
+
+                static const size_t MAX_TAG_LENGTH = 63;
+                static const size_t INLINE_MESSAGE_LENGTH = 384;
+
+            private:
+                struct LogRecord;
+                class LogRing;
+
+                void Start(const std::shared_ptr<Aws::OStream>& logFile, const Aws::String& filenamePrefix, bool rollLog);
+                LogRecord* ClaimRecord(LogRing*& ring);
+                void PublishRecord(LogRing* ring, LogRecord* record);
+                void DrainLoop(std::shared_ptr<Aws::OStream> log, Aws::String filenamePrefix, bool rollLog);
+                size_t DrainRings(Aws::OStream& log);
+                void WriteRecord(Aws::OStream& log, LogRecord& record);
+
+                std::atomic<LogLevel> m_logLevel;
+                RingBufferOverflowPolicy m_overflowPolicy;
+                size_t m_recordsPerRing;
+                Aws::Vector<LogRing*> m_rings;
+                std::atomic<size_t> m_droppedCount;
+                std::atomic<size_t> m_blockedCount;
+                std::atomic<size_t> m_spilledCount;
+
+                std::mutex m_signalMutex;
+                std::condition_variable m_signal;
+                std::atomic<bool> m_drainerWaiting;
+                std::atomic<bool> m_stopLogging;
+                std::thread m_drainerThread;
+
+                int64_t m_lastTimestampSecond;
+                Aws::String m_lastTimestamp;
+            };
+
+        } // namespace Logging
+    } // namespace Utils
+} // namespace Aws
@@ -0,0 +1,111 @@
+/*
+* Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+*
+* Licensed under the Apache License, Version 2.0 (the "License").
+* You may not use this file except in compliance with the License.
+* A copy of the License is located at
+*
+*  http://aws.amazon.com/apache2.0
+*
+* or in the "license" file accompanying this file. This file is distributed
+* on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+* express or implied. See the License for the specific language governing
+* permissions and limitations under the License.
+*/
+
+#pragma once
+
+#include <aws/core/Core_EXPORTS.h>
+#include <aws/core/utils/memory/MemorySystemInterface.h>
+
+#include <atomic>
+#include <cstdint>
+
+namespace Aws
+{
+    namespace Utils
+    {
+        namespace Memory
+        {
+            class Arena;
+
+            /**
+             * Memory system that bump allocates out of per-request arenas. It decorates another memory system (or malloc/free when none is
+             * given): while a ScopedArena for this system is alive on a thread, small allocations made on that thread are carved out of
+             * blocks owned by the arena instead of going to the underlying system one by one. Everything else is forwarded.
+             *
+             * Each allocation carries a small header so FreeMemory can tell arena memory from heap memory, which means this system must be
+             * installed before the first allocation (i.e. passed to InitAPI as memoryManager) and stay installed until ShutdownAPI.
+             * Arena memory is released when the scope has ended and every allocation made from it has been freed, from whatever thread, so
+             * a result that outlives its scope remains valid; it just keeps the arena's blocks alive.
+             */
+            class AWS_CORE_API ArenaMemorySystem : public MemorySystemInterface
+            {
+            public:
+                /**
+                 * underlyingSystem may be nullptr, in which case malloc/free are used. blockSize is the size of each block the arenas grab
+                 * from the underlying system; allocations larger than a quarter of it bypass the arena.
+                 */
+                ArenaMemorySystem(MemorySystemInterface* underlyingSystem = nullptr, std::size_t blockSize = DEFAULT_BLOCK_SIZE);
+
+                ArenaMemorySystem(const ArenaMemorySystem&) = delete;
+                ArenaMemorySystem& operator=(const ArenaMemorySystem&) = delete;
+
+                void Begin() override;
+                void End() override;
+
+                void* AllocateMemory(std::size_t blockSize, std::size_t alignment, const char *allocationTag = nullptr) override;
+                void FreeMemory(void* memoryPtr) override;
+
+                std::size_t GetBlockSize() const { return m_blockSize; }
+
+                /**
+                 * Number of allocations served from an arena.
+                 */
+                uint64_t GetArenaAllocationCount() const { return m_arenaAllocations.load(std::memory_order_relaxed); }
+
+                /**
+                 * Number of arena blocks requested from the underlying system.
+                 */
+                uint64_t GetArenaBlockCount() const { return m_arenaBlocks.load(std::memory_order_relaxed); }
+
+                static const std::size_t DEFAULT_BLOCK_SIZE = 16 * 1024;
+
+            private:
+                void* UnderlyingAllocate(std::size_t blockSize, std::size_t alignment, const char* allocationTag);
+                void UnderlyingFree(void* memoryPtr);
+
+                MemorySystemInterface* m_underlyingSystem;
+                std::size_t m_blockSize;
+                std::atomic<uint64_t> m_arenaAllocations;
+                std::atomic<uint64_t> m_arenaBlocks;
+
+                friend class Arena;
+                friend class ScopedArena;
+            };
+
+            /**
+             * Routes the allocations of the current thread to a fresh arena of memorySystem for the lifetime of this object. Wrap a
+             * synchronous service call, including the processing of its outcome, in one of these to have its request, http request,
+             * http response and parsed result bump allocated and given back in a handful of frees. Work done on other threads, such as
+             * async calls and executor tasks, is not covered. Scopes may be nested; the innermost one wins.
+             *
+             * Objects that live well past the scope (caches, clients created inside it) pin the arena's blocks, so avoid creating them here.
+             */
+            class AWS_CORE_API ScopedArena
+            {
+            public:
+                ScopedArena(ArenaMemorySystem& memorySystem);
+                ~ScopedArena();
+
+                ScopedArena(const ScopedArena&) = delete;
+                ScopedArena& operator=(const ScopedArena&) = delete;
+
+            private:
+                Arena* m_arena;
+                Arena* m_previousArena;
+            };
+
+        } // namespace Memory
+    } // namespace Utils
+} // namespace Aws
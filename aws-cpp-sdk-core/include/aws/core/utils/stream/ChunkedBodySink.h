@@ -0,0 +1,106 @@
+
+/*
+* Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+*
+* Licensed under the Apache License, Version 2.0 (the "License").
+* You may not use this file except in compliance with the License.
+* A copy of the License is located at
+*
+*  http://aws.amazon.com/apache2.0
+*
+* or in the "license" file accompanying this file. This file is distributed
+* on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+* express or implied. See the License for the specific language governing
+* permissions and limitations under the License.
+*/
+
+#pragma once
+
+#include <aws/core/Core_EXPORTS.h>
+#include <aws/core/utils/stream/ResponseBodySink.h>
+#include <aws/core/utils/memory/stl/AWSVector.h>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+namespace Aws
+{
+namespace Utils
+{
+namespace Stream
+{
+    /**
+     * Pool of fixed size buffers shared by chunked body sinks, so that large bodies don't need one big allocation per response.
+     * Keeps at most maxPooledChunks free chunks around, extra ones are freed.
+     */
+    class AWS_CORE_API BodyChunkPool
+    {
+    public:
+        BodyChunkPool(size_t chunkSize = 64 * 1024, size_t maxPooledChunks = 256);
+        ~BodyChunkPool();
+
+        BodyChunkPool(const BodyChunkPool&) = delete;
+        BodyChunkPool& operator=(const BodyChunkPool&) = delete;
+
+        /**
+         * Returns a chunk of GetChunkSize() bytes, from the pool if one is free.
+         */
+        char* Acquire();
+        /**
+         * Returns a chunk acquired from this pool.
+         */
+        void Release(char* chunk);
+
+        inline size_t GetChunkSize() const { return m_chunkSize; }
+
+    private:
+        size_t m_chunkSize;
+        size_t m_maxPooledChunks;
+        Aws::Vector<char*> m_freeChunks;
+        std::mutex m_lock;
+    };
+
+    /**
+     * Response body sink that scatters the body over chunks from a BodyChunkPool. The chunks go back to the pool when the sink is
+     * destroyed. Consumers can walk the chunks with GetChunks(), or read the body as a stream.
+     */
+    class AWS_CORE_API ChunkedBodySink : public ResponseBodySink
+    {
+    public:
+        ChunkedBodySink(const std::shared_ptr<BodyChunkPool>& pool);
+        virtual ~ChunkedBodySink();
+
+        ChunkedBodySink(const ChunkedBodySink&) = delete;
+        ChunkedBodySink& operator=(const ChunkedBodySink&) = delete;
+
+        size_t Append(const char* data, size_t length) override;
+        inline size_t GetSize() const override { return m_size; }
+        bool GetContiguousData(const char*& data) const override;
+
+        /**
+         * Returns the chunks holding the body, in order, with the number of bytes used in each.
+         */
+        Aws::Vector<std::pair<const char*, size_t>> GetChunks() const;
+
+    protected:
+        std::streampos seekoff(std::streamoff off, std::ios_base::seekdir dir, std::ios_base::openmode which = std::ios_base::in | std::ios_base::out) override;
+        std::streampos seekpos(std::streampos pos, std::ios_base::openmode which = std::ios_base::in | std::ios_base::out) override;
+
+        int overflow(int c = EOF) override;
+        int underflow() override;
+
+        std::streamsize xsputn(const char* s, std::streamsize n) override;
+
+    private:
+        size_t GetReadPosition() const;
+        void SetReadPosition(size_t position);
+
+        std::shared_ptr<BodyChunkPool> m_pool;
+        Aws::Vector<char*> m_chunks;
+        size_t m_size;
+        size_t m_readChunk;
+    };
+
+}
+}
+}
@@ -0,0 +1,92 @@
+
+/*
+* Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+*
+* Licensed under the Apache License, Version 2.0 (the "License").
+* You may not use this file except in compliance with the License.
+* A copy of the License is located at
+*
+*  http://aws.amazon.com/apache2.0
+*
+* or in the "license" file accompanying this file. This file is distributed
+* on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+* express or implied. See the License for the specific language governing
+* permissions and limitations under the License.
+*/
+
+#pragma once
+
+#include <aws/core/Core_EXPORTS.h>
+#include <aws/core/utils/stream/ResponseBodySink.h>
+
+namespace Aws
+{
+namespace Utils
+{
+namespace Stream
+{
+    /**
+     * Response body sink that keeps the body in a single growable buffer. The buffer is sized from the content-length up front, so
+     * it is allocated once, and the body can be handed to the payload parsers in place.
+     */
+    class AWS_CORE_API ContiguousBodySink : public ResponseBodySink
+    {
+    public:
+        using base = ResponseBodySink;
+
+        ContiguousBodySink();
+
+        ContiguousBodySink(const ContiguousBodySink&) = delete;
+        ContiguousBodySink& operator=(const ContiguousBodySink&) = delete;
+
+        virtual ~ContiguousBodySink();
+
+        void Reserve(size_t expectedSize) override;
+        size_t Append(const char* data, size_t length) override;
+        size_t GetSize() const override;
+        bool GetContiguousData(const char*& data) const override;
+
+        inline size_t GetCapacity() const { return m_capacity; }
+
+    protected:
+        /**
+         * Writes into buffer instead of allocating one. The buffer is never grown nor freed.
+         */
+        ContiguousBodySink(char* buffer, size_t capacity);
+
+        std::streampos seekoff(std::streamoff off, std::ios_base::seekdir dir, std::ios_base::openmode which = std::ios_base::in | std::ios_base::out) override;
+        std::streampos seekpos(std::streampos pos, std::ios_base::openmode which = std::ios_base::in | std::ios_base::out) override;
+
+        int overflow(int c = EOF) override;
+        int underflow() override;
+
+        std::streamsize xsputn(const char* s, std::streamsize n) override;
+
+    private:
+        bool EnsureCapacity(size_t capacity);
+        void UpdateSize() const;
+
+        char* m_buffer;
+        size_t m_capacity;
+        mutable size_t m_size;
+        bool m_ownsBuffer;
+    };
+
+    /**
+     * Response body sink that writes into a caller supplied buffer. The transfer fails if the body doesn't fit.
+     * The buffer must outlive the sink.
+     */
+    class AWS_CORE_API FixedBufferBodySink : public ContiguousBodySink
+    {
+    public:
+        FixedBufferBodySink(char* buffer, size_t capacity) : ContiguousBodySink(buffer, capacity) {}
+    };
+
+    /**
+     * Creates a ContiguousBodySink, the default response body sink of service requests.
+     */
+    AWS_CORE_API ResponseBodySink* DefaultResponseBodySinkFactoryMethod();
+
+}
+}
+}
@@ -0,0 +1,80 @@
+
+/*
+* Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+*
+* Licensed under the Apache License, Version 2.0 (the "License").
+* You may not use this file except in compliance with the License.
+* A copy of the License is located at
+*
+*  http://aws.amazon.com/apache2.0
+*
+* or in the "license" file accompanying this file. This file is distributed
+* on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+* express or implied. See the License for the specific language governing
+* permissions and limitations under the License.
+*/
+
+#pragma once
+
+#include <aws/core/Core_EXPORTS.h>
+#include <aws/core/utils/memory/stl/AWSStreamFwd.h>
+#include <aws/core/utils/memory/stl/AWSString.h>
+#include <streambuf>
+
+namespace Aws
+{
+namespace Utils
+{
+namespace Stream
+{
+    /**
+     * Read only, seekable streambuf over a request payload buffer taken from a process wide pool. The payload is serialized straight into
+     * GetBuffer() and must be complete before the first read. The buffer goes back to the pool, keeping its capacity, when the streambuf
+     * is destroyed, so steady state request serialization doesn't allocate.
+     */
+    class AWS_CORE_API PayloadBufferStreamBuf : public std::streambuf
+    {
+    public:
+        PayloadBufferStreamBuf();
+        virtual ~PayloadBufferStreamBuf();
+
+        PayloadBufferStreamBuf(const PayloadBufferStreamBuf&) = delete;
+        PayloadBufferStreamBuf& operator=(const PayloadBufferStreamBuf&) = delete;
+
+        inline Aws::String& GetBuffer() { return *m_buffer; }
+
+    protected:
+        std::streampos seekoff(std::streamoff off, std::ios_base::seekdir dir, std::ios_base::openmode which = std::ios_base::in | std::ios_base::out) override;
+        std::streampos seekpos(std::streampos pos, std::ios_base::openmode which = std::ios_base::in | std::ios_base::out) override;
+
+        int underflow() override;
+
+    private:
+        Aws::String* m_buffer;
+    };
+
+    /**
+     * iostream over a PayloadBufferStreamBuf.
+     */
+    class AWS_CORE_API PayloadBufferStream : public Aws::IOStream
+    {
+    public:
+        PayloadBufferStream();
+
+        PayloadBufferStream(const PayloadBufferStream&) = delete;
+        PayloadBufferStream& operator=(const PayloadBufferStream&) = delete;
+
+        inline Aws::String& GetBuffer() { return m_streamBuf.GetBuffer(); }
+
+    private:
+        PayloadBufferStreamBuf m_streamBuf;
+    };
+
+    /**
+     * Frees the buffers held by the pool. Called from Aws::ShutdownAPI.
+     */
+    AWS_CORE_API void CleanupPayloadBufferPool();
+
+}
+}
+}
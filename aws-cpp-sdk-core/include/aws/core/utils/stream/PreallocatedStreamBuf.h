@@ -41,6 +41,12 @@ namespace Aws
                  */
                 PreallocatedStreamBuf(Aws::Utils::Array<uint8_t>* buffer, std::size_t lengthToRead);
 
+                /**
+                 * Initialize a read only stream buffer viewing length bytes at data, e.g. a range of a memory mapped file. Nothing is
+                 * copied and data must outlive the stream buffer. Writes to the stream fail and GetBuffer() returns nullptr.
+                 */
+                PreallocatedStreamBuf(const uint8_t* data, std::size_t length);
+
                 PreallocatedStreamBuf(const PreallocatedStreamBuf&) = delete;
                 PreallocatedStreamBuf& operator=(const PreallocatedStreamBuf&) = delete;
 
@@ -59,6 +65,7 @@ namespace Aws
 
             private:
                 Aws::Utils::Array<uint8_t>* m_underlyingBuffer;
+                char* m_begin;
                 std::size_t m_lengthToRead;
             };
         }
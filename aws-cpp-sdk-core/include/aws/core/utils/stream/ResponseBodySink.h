@@ -0,0 +1,86 @@
+
+/*
+* Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+*
+* Licensed under the Apache License, Version 2.0 (the "License").
+* You may not use this file except in compliance with the License.
+* A copy of the License is located at
+*
+*  http://aws.amazon.com/apache2.0
+*
+* or in the "license" file accompanying this file. This file is distributed
+* on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+* express or implied. See the License for the specific language governing
+* permissions and limitations under the License.
+*/
+
+#pragma once
+
+#include <aws/core/Core_EXPORTS.h>
+#include <aws/core/utils/UnreferencedParam.h>
+#include <aws/core/utils/memory/stl/AWSStreamFwd.h>
+#include <functional>
+#include <streambuf>
+
+namespace Aws
+{
+namespace Utils
+{
+namespace Stream
+{
+    /**
+     * Destination for the body of an http response. The http client appends the payload straight into the sink as it comes off the
+     * wire, without going through the iostream layer, and tells it the expected size up front when the response has a content-length.
+     * A sink is also a streambuf, so the response body can still be read through HttpResponse::GetResponseBody() as usual.
+     */
+    class AWS_CORE_API ResponseBodySink : public std::streambuf
+    {
+    public:
+        virtual ~ResponseBodySink() = default;
+
+        /**
+         * Hint that expectedSize bytes are about to be appended, e.g. from the content-length header.
+         */
+        virtual void Reserve(size_t expectedSize) { AWS_UNREFERENCED_PARAM(expectedSize); }
+
+        /**
+         * Appends length bytes to the end of the body. Returns the number of bytes taken, anything less than length aborts the transfer.
+         */
+        virtual size_t Append(const char* data, size_t length) = 0;
+
+        /**
+         * Number of bytes in the body.
+         */
+        virtual size_t GetSize() const = 0;
+
+        /**
+         * If the whole body is held in one buffer, points data at it and returns true, so that it can be consumed in place.
+         */
+        virtual bool GetContiguousData(const char*& data) const { AWS_UNREFERENCED_PARAM(data); return false; }
+    };
+
+    typedef std::function<ResponseBodySink*(void)> ResponseBodySinkFactory;
+
+    /**
+     * IOStream over a response body sink. Takes ownership of the sink.
+     */
+    class AWS_CORE_API ResponseBodySinkStream : public Aws::IOStream
+    {
+    public:
+        using Base = Aws::IOStream;
+
+        ResponseBodySinkStream(ResponseBodySink* sink);
+        virtual ~ResponseBodySinkStream();
+
+        ResponseBodySinkStream(const ResponseBodySinkStream&) = delete;
+        ResponseBodySinkStream& operator=(const ResponseBodySinkStream&) = delete;
+
+        inline ResponseBodySink* GetSink() const { return m_sink; }
+
+    private:
+        ResponseBodySink* m_sink;
+    };
+
+}
+}
+}
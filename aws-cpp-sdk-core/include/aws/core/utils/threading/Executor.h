@@ -24,6 +24,7 @@
 #include <functional>
 #include <future>
 #include <mutex>
+#include <condition_variable>
 #include <atomic>
 
 namespace Aws
@@ -123,6 +124,53 @@ namespace Aws
                 friend class ThreadTask;
             };
 
+            /**
+            * Thread Pool Executor where every worker owns a task deque. Workers run their own tasks newest first and, once out of work,
+            * steal the oldest tasks from the other workers, so submitters and workers do not all contend on one lock. Tasks submitted
+            * from a worker thread go to that worker's deque, others are spread round robin. Tasks are moved into reused slots of the
+            * deques rather than copied to the heap one by one.
+            *
+            * With pinThreadsToCores, worker i is pinned to core i modulo the number of cores, where the platform supports it.
+            * Tasks still queued when the executor is destroyed are dropped, as with PooledThreadExecutor.
+            */
+            class AWS_CORE_API WorkStealingThreadExecutor : public Executor
+            {
+            public:
+                WorkStealingThreadExecutor(size_t poolSize, OverflowPolicy overflowPolicy = OverflowPolicy::QUEUE_TASKS_EVENLY_ACCROSS_THREADS,
+                        bool pinThreadsToCores = false);
+                ~WorkStealingThreadExecutor();
+
+                /**
+                * Rule of 5 stuff.
+                * Don't copy or move
+                */
+                WorkStealingThreadExecutor(const WorkStealingThreadExecutor&) = delete;
+                WorkStealingThreadExecutor& operator =(const WorkStealingThreadExecutor&) = delete;
+                WorkStealingThreadExecutor(WorkStealingThreadExecutor&&) = delete;
+                WorkStealingThreadExecutor& operator =(WorkStealingThreadExecutor&&) = delete;
+
+            protected:
+                bool SubmitToThread(std::function<void()>&&) override;
+
+            private:
+                class Worker;
+
+                void WorkerLoop(size_t index);
+                bool PopTask(size_t index, std::function<void()>& task);
+                size_t GetSubmittingWorker();
+
+                Aws::Vector<Worker*> m_workers;
+                std::mutex m_idleLock;
+                std::condition_variable m_idleSignal;
+                std::atomic<size_t> m_idleWorkers;
+                std::atomic<size_t> m_pendingTasks;
+                std::atomic<size_t> m_nextWorker;
+                std::atomic<bool> m_continue;
+                size_t m_poolSize;
+                OverflowPolicy m_overflowPolicy;
+                bool m_pinThreadsToCores;
+            };
+
 
         } // namespace Threading
     } // namespace Utils
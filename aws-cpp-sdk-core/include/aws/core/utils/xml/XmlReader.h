@@ -0,0 +1,238 @@
+
+/*
+* Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+*
+* Licensed under the Apache License, Version 2.0 (the "License").
+* You may not use this file except in compliance with the License.
+* A copy of the License is located at
+*
+*  http://aws.amazon.com/apache2.0
+*
+* or in the "license" file accompanying this file. This file is distributed
+* on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+* express or implied. See the License for the specific language governing
+* permissions and limitations under the License.
+*/
+
+#pragma once
+
+#include <aws/core/Core_EXPORTS.h>
+
+#include <aws/core/utils/Array.h>
+#include <aws/core/utils/memory/stl/AWSStreamFwd.h>
+#include <aws/core/utils/memory/stl/AWSString.h>
+#include <aws/core/utils/memory/stl/AWSVector.h>
+#include <aws/core/utils/memory/stl/AWSMap.h>
+
+#include <utility>
+
+namespace Aws
+{
+    namespace Utils
+    {
+        class DateTime;
+
+        namespace Xml
+        {
+            /**
+             * Forward only pull parser over an xml document. Elements are visited in document order and their text is read straight into
+             * the caller's objects as the input is scanned, no DOM is built. Attributes, comments, processing instructions and doctypes are
+             * skipped. Every read returns false and latches an error on malformed input; once an error is latched all further reads fail.
+             *
+             * The reader is always positioned inside an element, starting with the document itself. NextChild() enters the next child
+             * element, which must then be consumed with ReadText(), SkipElement() or NextChild() calls until it returns false.
+             */
+            class AWS_CORE_API XmlReader
+            {
+            public:
+                /**
+                 * Reads length bytes of xml at data, without copying them. data must outlive the reader.
+                 */
+                XmlReader(const char* data, size_t length);
+
+                /**
+                 * Reads xml from stream, pulling it through the stream's buffer a chunk at a time.
+                 */
+                XmlReader(Aws::IStream& stream);
+
+                XmlReader(const XmlReader&) = delete;
+                XmlReader& operator=(const XmlReader&) = delete;
+
+                /**
+                 * Enters the next child element of the current element and sets name to its tag name. Returns false once the current
+                 * element's end tag has been consumed, or on error. Text between child elements is ignored.
+                 */
+                bool NextChild(Aws::String& name);
+
+                /**
+                 * Reads the text content of the current element, entities and CDATA sections decoded, and consumes its end tag.
+                 * Child elements are skipped.
+                 */
+                bool ReadText(Aws::String& text);
+
+                /**
+                 * Consumes the rest of the current element, children included.
+                 */
+                bool SkipElement();
+
+                inline bool HasError() const { return m_hasError; }
+
+                inline const Aws::String& GetErrorMessage() const { return m_errorMessage; }
+
+            private:
+                static const size_t CHUNK_SIZE = 4096;
+
+                int PeekChar();
+                int GetChar();
+                bool Refill();
+                bool SkipPast(const char* terminator);
+                bool SkipMarkup();
+                bool ReadName(Aws::String& name);
+                bool ReadStartTag(Aws::String& name);
+                bool ReadEndTag();
+                bool ReadEntity(Aws::String& text);
+                void LeaveElement();
+                bool SetError(const char* what);
+
+                const char* m_current;
+                const char* m_end;
+                Aws::IStream* m_stream;
+                size_t m_offset;
+                size_t m_depth;
+                bool m_emptyElement;
+                bool m_hasError;
+                Aws::String m_errorMessage;
+                Aws::String m_endTagName;
+                Aws::Vector<Aws::String> m_openElements;
+                char m_chunk[CHUNK_SIZE];
+            };
+
+            /**
+             * Text values are trimmed of surrounding whitespace, as with XmlNode.
+             */
+            AWS_CORE_API bool ReadXml(XmlReader& reader, Aws::String& value);
+            AWS_CORE_API bool ReadXml(XmlReader& reader, int& value);
+            AWS_CORE_API bool ReadXml(XmlReader& reader, long long& value);
+            AWS_CORE_API bool ReadXml(XmlReader& reader, double& value);
+            AWS_CORE_API bool ReadXml(XmlReader& reader, bool& value);
+
+            /**
+             * Blobs are base64 encoded text.
+             */
+            AWS_CORE_API bool ReadXml(XmlReader& reader, ByteBuffer& value);
+
+            /**
+             * Timestamps are ISO 8601 text.
+             */
+            AWS_CORE_API bool ReadXml(XmlReader& reader, Aws::Utils::DateTime& value);
+
+            /**
+             * Generated structures read themselves through Deserialize(XmlReader&).
+             */
+            template<typename T>
+            auto ReadXml(XmlReader& reader, T& value) -> decltype(value.Deserialize(reader))
+            {
+                return value.Deserialize(reader);
+            }
+
+            /**
+             * Reads a wrapped list, a container element holding one itemName element per item. Other children are skipped.
+             */
+            template<typename T>
+            bool ReadXmlList(XmlReader& reader, Aws::Vector<T>& value, const char* itemName)
+            {
+                Aws::String name;
+                while (reader.NextChild(name))
+                {
+                    if (name == itemName)
+                    {
+                        T item;
+                        if (!ReadXml(reader, item))
+                        {
+                            return false;
+                        }
+                        value.push_back(std::move(item));
+                    }
+                    else if (!reader.SkipElement())
+                    {
+                        return false;
+                    }
+                }
+                return !reader.HasError();
+            }
+
+            /**
+             * Reads one item of a flattened list, whose items appear directly in the parent element.
+             */
+            template<typename T>
+            bool ReadXmlListItem(XmlReader& reader, Aws::Vector<T>& value)
+            {
+                T item;
+                if (!ReadXml(reader, item))
+                {
+                    return false;
+                }
+                value.push_back(std::move(item));
+                return true;
+            }
+
+            /**
+             * Reads one map entry element holding a keyName and a valueName child.
+             */
+            template<typename K, typename T>
+            bool ReadXmlMapEntry(XmlReader& reader, Aws::Map<K, T>& value, const char* keyName, const char* valueName)
+            {
+                K key;
+                T item;
+                Aws::String name;
+                while (reader.NextChild(name))
+                {
+                    bool read = true;
+                    if (name == keyName)
+                    {
+                        read = ReadXml(reader, key);
+                    }
+                    else if (name == valueName)
+                    {
+                        read = ReadXml(reader, item);
+                    }
+                    else
+                    {
+                        read = reader.SkipElement();
+                    }
+
+                    if (!read)
+                    {
+                        return false;
+                    }
+                }
+
+                if (reader.HasError())
+                {
+                    return false;
+                }
+                value[std::move(key)] = std::move(item);
+                return true;
+            }
+
+            /**
+             * Reads a wrapped map, a container element holding one entryName element per entry.
+             */
+            template<typename K, typename T>
+            bool ReadXmlMap(XmlReader& reader, Aws::Map<K, T>& value, const char* entryName, const char* keyName, const char* valueName)
+            {
+                Aws::String name;
+                while (reader.NextChild(name))
+                {
+                    bool read = name == entryName ? ReadXmlMapEntry(reader, value, keyName, valueName) : reader.SkipElement();
+                    if (!read)
+                    {
+                        return false;
+                    }
+                }
+                return !reader.HasError();
+            }
+        } // namespace Xml
+    } // namespace Utils
+} // namespace Aws
+
@@ -199,6 +199,10 @@ namespace Aws
                 */
                 static XmlDocument CreateFromXmlString(const Aws::String&);
                 /**
+                * Parses length bytes of xml at data into an XMLDocument
+                */
+                static XmlDocument CreateFromXmlBuffer(const char* data, size_t length);
+                /**
                 * Creates an empty document with root node name
                 */
                 static XmlDocument CreateWithRootNode(const Aws::String&);
@@ -14,21 +14,24 @@
   */
 
 #include <aws/core/AmazonSerializableWebServiceRequest.h>
-#include <aws/core/utils/memory/stl/AWSStringStream.h>
+#include <aws/core/utils/stream/PayloadBufferStream.h>
 
 using namespace Aws;
 
+void AmazonSerializableWebServiceRequest::AppendSerializedPayload(Aws::String& payload) const
+{
+    payload.append(SerializePayload());
+}
+
 std::shared_ptr<Aws::IOStream> AmazonSerializableWebServiceRequest::GetBody() const
 {
-    Aws::String&& payload = SerializePayload();
-    std::shared_ptr<Aws::IOStream> payloadBody;
+    auto payloadBody = Aws::MakeShared<Aws::Utils::Stream::PayloadBufferStream>("AmazonSerializableWebServiceRequest");
+    AppendSerializedPayload(payloadBody->GetBuffer());
 
-    if (!payload.empty())
+    if (payloadBody->GetBuffer().empty())
     {
-      payloadBody = Aws::MakeShared<Aws::StringStream>("AmazonSerializableWebServiceRequest");
-      *payloadBody << payload;
+        return nullptr;
     }
 
     return payloadBody;
 }
-
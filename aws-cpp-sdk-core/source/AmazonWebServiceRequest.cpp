@@ -16,11 +16,13 @@
 #include <aws/core/AmazonWebServiceRequest.h>
 #include <aws/core/utils/memory/stl/AWSStringStream.h>
 #include <aws/core/utils/memory/stl/AWSFunction.h>
+#include <aws/core/utils/stream/ContiguousBodySink.h>
 
 using namespace Aws;
 
 AmazonWebServiceRequest::AmazonWebServiceRequest() :
     m_responseStreamFactory(AWS_BUILD_FUNCTION(Aws::Utils::Stream::DefaultResponseStreamFactoryMethod)),
+    m_responseBodySinkFactory(Aws::Utils::Stream::DefaultResponseBodySinkFactoryMethod),
     m_onDataReceived(nullptr),
     m_onDataSent(nullptr)
 {
@@ -17,6 +17,7 @@
 #include <aws/core/Aws.h>
 #include <aws/core/utils/logging/AWSLogging.h>
 #include <aws/core/utils/logging/DefaultLogSystem.h>
+#include <aws/core/utils/stream/PayloadBufferStream.h>
 
 namespace Aws
 {
@@ -103,6 +104,7 @@ namespace Aws
     {
         Aws::Http::CleanupHttp();
         Aws::Utils::Crypto::CleanupCrypto();
+        Aws::Utils::Stream::CleanupPayloadBufferPool();
 
         if(options.loggingOptions.logLevel != Aws::Utils::Logging::LogLevel::Off)
         {
@@ -15,6 +15,7 @@
 
 #include <aws/core/auth/AWSAuthSigner.h>
 
+#include <aws/core/auth/AWSChunkedPayloadStream.h>
 #include <aws/core/auth/AWSCredentialsProvider.h>
 #include <aws/core/client/ClientConfiguration.h>
 #include <aws/core/http/HttpRequest.h>
@@ -25,11 +26,15 @@
 #include <aws/core/utils/StringUtils.h>
 #include <aws/core/utils/logging/LogMacros.h>
 #include <aws/core/utils/memory/AWSMemory.h>
+#include <aws/core/utils/memory/stl/AWSVector.h>
 #include <aws/core/utils/crypto/Sha256.h>
 #include <aws/core/utils/crypto/Sha256HMAC.h>
 
+#include <algorithm>
+#include <cctype>
 #include <cstdio>
 #include <iomanip>
+#include <limits>
 #include <math.h>
 #include <string.h>
 
@@ -51,9 +56,12 @@ static const char* X_AMZ_SIGNED_HEADERS = "X-Amz-SignedHeaders";
 static const char* X_AMZ_ALGORITHM = "X-Amz-Algorithm";
 static const char* X_AMZ_CREDENTIAL = "X-Amz-Credential";
 static const char* UNSIGNED_PAYLOAD = "UNSIGNED-PAYLOAD";
+static const char* STREAMING_PAYLOAD = "STREAMING-AWS4-HMAC-SHA256-PAYLOAD";
+static const char* AWS_CHUNKED = "aws-chunked";
+static const char* CONTENT_ENCODING = "content-encoding";
+static const char* X_AMZ_DECODED_CONTENT_LENGTH = "x-amz-decoded-content-length";
 static const char* X_AMZ_SIGNATURE = "X-Amz-Signature";
 static const char* SIGNING_KEY = "AWS4";
-static const char* LONG_DATE_FORMAT_STR = "%Y%m%dT%H%M%SZ";
 static const char* SIMPLE_DATE_FORMAT_STR = "%Y%m%d";
 static const char* EMPTY_STRING_SHA256 = "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855";
 
@@ -68,67 +76,304 @@ namespace Aws
     }
 }
 
-static Aws::String CanonicalizeRequestSigningString(HttpRequest& request, bool urlEscapePath)
+static const int64_t NO_FORMATTED_SECOND = std::numeric_limits<int64_t>::min();
+
+struct AWSAuthV4Signer::CanonicalRequestBuffers
 {
-    request.CanonicalizeRequest();
-    Aws::StringStream signingStringStream;
-    signingStringStream << HttpMethodMapper::GetNameForHttpMethod(request.GetMethod());
+    CanonicalRequestBuffers() : formattedSecond(NO_FORMATTED_SECOND) {}
 
-    //double encode paths unless explicitly stated otherwise (for s3 compatibility)
-    URI uriCpy = request.GetUri();
-    uriCpy.SetPath(uriCpy.GetURLEncodedPath());
+    Aws::String canonicalRequest;
+    Aws::String signedHeaders;
+    Aws::String scratch;
+    //x-amz-date and the credential scope date for the second in formattedSecond, consecutive signatures mostly land in the same one.
+    int64_t formattedSecond;
+    Aws::String longDate;
+    Aws::String simpleDate;
+};
+
+static const size_t SIMPLE_DATE_LENGTH = 8;
+
+static inline bool IsSpace(char c)
+{
+    return ::isspace(static_cast<unsigned char>(c)) != 0;
+}
+
+static void TrimRange(const char*& begin, const char*& end)
+{
+    while (begin < end && IsSpace(*begin))
+    {
+        ++begin;
+    }
+
+    while (end > begin && IsSpace(*(end - 1)))
+    {
+        --end;
+    }
+}
+
+//same output as URI::URLEncodePath, but appended in place rather than through split segments and a string stream.
+static void AppendURLEncodedPath(Aws::String& out, const Aws::String& path)
+{
+    static const char HEX_DIGITS[] = "0123456789ABCDEF";
+
+    const size_t length = path.length();
+    size_t i = 0;
+    while (i < length)
+    {
+        while (i < length && path[i] == '/')
+        {
+            ++i;
+        }
+
+        if (i == length)
+        {
+            break;
+        }
+
+        out.push_back('/');
+        for (; i < length && path[i] != '/'; ++i)
+        {
+            int c = path[i];
+            if (c >= 0 && (isalnum(c) || c == '-' || c == '_' || c == '.' || c == '~'))
+            {
+                out.push_back(static_cast<char>(c));
+            }
+            else
+            {
+                unsigned char unsafe = static_cast<unsigned char>(c);
+                out.push_back('%');
+                out.push_back(HEX_DIGITS[unsafe >> 4]);
+                out.push_back(HEX_DIGITS[unsafe & 0x0F]);
+            }
+        }
+    }
 
-    signingStringStream << NEWLINE << (urlEscapePath ? uriCpy.GetURLEncodedPath() : uriCpy.GetPath()) << NEWLINE;
+    //if the last character was also a slash, then add that back here.
+    if (length > 0 && path[length - 1] == '/')
+    {
+        out.push_back('/');
+    }
+}
 
-    if (request.GetQueryString().size() > 1 && request.GetQueryString().find("=") != std::string::npos)
+//appends "<method>\n<canonical uri>\n<canonical query>\n" to out. scratch is clobbered.
+static void AppendCanonicalRequestLine(Aws::String& out, Aws::String& scratch, HttpRequest& request, bool urlEscapePath)
+{
+    //only query strings with parameters get reordered, don't bother building the parameter collection otherwise.
+    if (request.GetQueryString().find('=') != Aws::String::npos)
     {
-        signingStringStream << request.GetQueryString().substr(1) << NEWLINE;
+        request.CanonicalizeRequest();
     }
-    else if (request.GetQueryString().size() > 1)
+
+    out.append(HttpMethodMapper::GetNameForHttpMethod(request.GetMethod()));
+    out.append(NEWLINE);
+
+    //double encode paths unless explicitly stated otherwise (for s3 compatibility)
+    scratch.clear();
+    AppendURLEncodedPath(scratch, request.GetUri().GetPath());
+    if (urlEscapePath)
     {
-        signingStringStream << request.GetQueryString().substr(1) << "=" << NEWLINE;
+        AppendURLEncodedPath(out, scratch);
     }
     else
     {
-        signingStringStream << NEWLINE;
+        out.append(scratch);
     }
+    out.append(NEWLINE);
 
-    return signingStringStream.str();
+    const Aws::String& queryString = request.GetQueryString();
+    if (queryString.size() > 1)
+    {
+        out.append(queryString, 1, Aws::String::npos);
+        if (queryString.find('=') == Aws::String::npos)
+        {
+            out.append(EQ);
+        }
+    }
+    out.append(NEWLINE);
 }
 
-static Http::HeaderValueCollection CanonicalizeHeaders(Http::HeaderValueCollection&& headers)
+//trims the value, joins multiline values as line1,line2,etc... and collapses duplicate spaces, appending the result to out.
+static void AppendCanonicalHeaderValue(Aws::String& out, const Aws::String& value)
 {
-    Http::HeaderValueCollection canonicalHeaders;
-    for (const auto& header : headers)
+    const char* begin = value.c_str();
+    const char* end = begin + value.length();
+    TrimRange(begin, end);
+
+    const size_t valueStart = out.length();
+    bool firstLine = true;
+    while (begin < end)
+    {
+        const char* lineEnd = std::find(begin, end, '\n');
+        if (lineEnd != begin)
+        {
+            const char* lineBegin = begin;
+            const char* trimmedLineEnd = lineEnd;
+            if (!firstLine)
+            {
+                TrimRange(lineBegin, trimmedLineEnd);
+                out.push_back(',');
+            }
+
+            for (const char* c = lineBegin; c < trimmedLineEnd; ++c)
+            {
+                if (*c == ' ' && out.length() > valueStart && out.back() == ' ')
+                {
+                    continue;
+                }
+                out.push_back(*c);
+            }
+            firstLine = false;
+        }
+
+        begin = lineEnd == end ? end : lineEnd + 1;
+    }
+}
+
+static bool HeaderNameNeedsTrim(const Aws::String& headerName)
+{
+    return !headerName.empty() && (IsSpace(headerName.front()) || IsSpace(headerName.back()));
+}
+
+/**
+ * Holds derived signing keys for several (secret key, date, region, service) tuples. Readers look keys up in a snapshot, which is never modified once published, without
+ * taking a lock. Inserting copies the snapshot, adds the key and publishes the copy. Old snapshots are freed as soon as no reader is
+ * inside the cache, which readers announce through m_readers for the duration of a lookup.
+ */
+class AWSAuthV4Signer::DerivedKeyCache
+{
+public:
+    struct DerivedKey
     {
-        auto trimmedHeaderName = StringUtils::Trim(header.first.c_str());
-        auto trimmedHeaderValue = StringUtils::Trim(header.second.c_str());
+        Aws::String secretKey;
+        Aws::String simpleDate;
+        Aws::String region;
+        Aws::String serviceName;
+        ByteBuffer signingKey;
+    };
+
+    typedef Aws::Vector<DerivedKey> Snapshot;
+
+    //keys from previous days are dropped first, past this the oldest keys go.
+    static const size_t MAX_KEYS = 64;
+
+    /**
+     * Keeps the snapshot it looked the key up in alive for as long as it is in scope.
+     */
+    class Reader
+    {
+    public:
+        Reader(DerivedKeyCache& cache) : m_cache(cache)
+        {
+            m_cache.m_readers.fetch_add(1);
+            m_snapshot = m_cache.m_snapshot.load();
+        }
+
+        ~Reader()
+        {
+            if (m_cache.m_readers.fetch_sub(1) == 1 && m_cache.m_hasRetiredSnapshots.load())
+            {
+                m_cache.TryReclaimRetiredSnapshots();
+            }
+        }
 
-        //multiline gets converted to line1,line2,etc...
-        auto headerMultiLine = StringUtils::SplitOnLine(trimmedHeaderValue);
-        Aws::String headerValue = headerMultiLine[0];
+        Reader(const Reader&) = delete;
+        Reader& operator=(const Reader&) = delete;
 
-        if (headerMultiLine.size() > 1)
+        const ByteBuffer* Find(const Aws::String& secretKey, const Aws::String& simpleDate, const Aws::String& region, const Aws::String& serviceName) const
         {
-            for(size_t i = 1; i < headerMultiLine.size(); ++i)
+            for (const auto& key : *m_snapshot)
             {
-                headerValue += ",";
-                headerValue += StringUtils::Trim(headerMultiLine[i].c_str());
+                if (key.simpleDate == simpleDate && key.region == region && key.serviceName == serviceName && key.secretKey == secretKey)
+                {
+                    return &key.signingKey;
+                }
             }
+
+            return nullptr;
         }
 
-        //duplicate spaces need to be converted to one.
-        Aws::String::iterator new_end =
-            std::unique(headerValue.begin(), headerValue.end(),
-                [=](char lhs, char rhs) { return (lhs == rhs) && (lhs == ' '); }
-        );
-        headerValue.erase(new_end, headerValue.end());
+    private:
+        DerivedKeyCache& m_cache;
+        const Snapshot* m_snapshot;
+    };
+
+    DerivedKeyCache() : m_snapshot(Aws::New<Snapshot>(v4LogTag)), m_readers(0), m_hasRetiredSnapshots(false) {}
 
-        canonicalHeaders[trimmedHeaderName] = headerValue;       
+    ~DerivedKeyCache()
+    {
+        Aws::Delete(m_snapshot.load());
+        for (auto snapshot : m_retiredSnapshots)
+        {
+            Aws::Delete(snapshot);
+        }
     }
 
-    return canonicalHeaders;
-}
+    void Insert(DerivedKey&& derivedKey)
+    {
+        std::lock_guard<std::mutex> locker(m_writeLock);
+        Snapshot* current = m_snapshot.load();
+        Snapshot* updated = Aws::New<Snapshot>(v4LogTag);
+        updated->reserve(current->size() + 1);
+        for (const auto& key : *current)
+        {
+            //a concurrent miss on the same key may have beaten us to it.
+            if (key.simpleDate == derivedKey.simpleDate && key.region == derivedKey.region &&
+                key.serviceName == derivedKey.serviceName && key.secretKey == derivedKey.secretKey)
+            {
+                Aws::Delete(updated);
+                return;
+            }
+
+            if (key.simpleDate >= derivedKey.simpleDate)
+            {
+                updated->push_back(key);
+            }
+        }
+
+        if (updated->size() >= MAX_KEYS)
+        {
+            updated->erase(updated->begin(), updated->begin() + (updated->size() - MAX_KEYS + 1));
+        }
+        updated->push_back(std::move(derivedKey));
+
+        m_snapshot.store(updated);
+        m_retiredSnapshots.push_back(current);
+        m_hasRetiredSnapshots.store(true);
+        ReclaimRetiredSnapshots();
+    }
+
+private:
+    void TryReclaimRetiredSnapshots()
+    {
+        std::unique_lock<std::mutex> locker(m_writeLock, std::try_to_lock);
+        if (locker.owns_lock())
+        {
+            ReclaimRetiredSnapshots();
+        }
+    }
+
+    //must hold m_writeLock. A reader that could still see a retired snapshot entered before it was replaced, so it is still counted.
+    void ReclaimRetiredSnapshots()
+    {
+        if (m_readers.load() != 0)
+        {
+            return;
+        }
+
+        for (auto snapshot : m_retiredSnapshots)
+        {
+            Aws::Delete(snapshot);
+        }
+        m_retiredSnapshots.clear();
+        m_hasRetiredSnapshots.store(false);
+    }
+
+    std::atomic<Snapshot*> m_snapshot;
+    std::atomic<size_t> m_readers;
+    std::atomic<bool> m_hasRetiredSnapshots;
+    std::mutex m_writeLock;
+    Aws::Vector<Snapshot*> m_retiredSnapshots;
+};
 
 AWSAuthV4Signer::AWSAuthV4Signer(const std::shared_ptr<Auth::AWSCredentialsProvider>& credentialsProvider,
     const char* serviceName, const Aws::String& region, bool signPayloads, bool urlEscapePath) :
@@ -136,25 +381,75 @@ AWSAuthV4Signer::AWSAuthV4Signer(const std::shared_ptr<Auth::AWSCredentialsProvi
     m_credentialsProvider(credentialsProvider),
     m_serviceName(serviceName),
     m_region(region),
+    m_credentialScopeSuffix("/" + region + "/" + serviceName + "/" + AWS4_REQUEST),
     m_hash(Aws::MakeUnique<Aws::Utils::Crypto::Sha256>(v4LogTag)),
     m_HMAC(Aws::MakeUnique<Aws::Utils::Crypto::Sha256HMAC>(v4LogTag)),
     m_unsignedHeaders({"user-agent", "x-amzn-trace-id"}),
+    m_derivedKeys(Aws::MakeUnique<DerivedKeyCache>(v4LogTag)),
     m_signPayloads(signPayloads),
-    m_urlEscapePath(urlEscapePath)
+    m_urlEscapePath(urlEscapePath),
+    m_payloadSigningChunkSize(0)
 {
+    for (auto& slot : m_canonicalRequestBuffers)
+    {
+        slot.store(nullptr);
+    }
+
     //go ahead and warm up the signing cache.
-    ComputeLongLivedHash(credentialsProvider->GetAWSCredentials().GetAWSSecretKey(), DateTime::CalculateGmtTimestampAsString(SIMPLE_DATE_FORMAT_STR));
+    ComputeLongLivedHash(credentialsProvider->GetAWSCredentialsSnapshot()->GetAWSSecretKey(), DateTime::CalculateGmtTimestampAsString(SIMPLE_DATE_FORMAT_STR),
+        m_region, m_serviceName);
 }
 
 AWSAuthV4Signer::~AWSAuthV4Signer()
 {
-    // empty destructor in .cpp file to keep from needing the implementation of (AWSCredentialsProvider, Sha256, Sha256HMAC) in the header file 
+    for (auto& slot : m_canonicalRequestBuffers)
+    {
+        Aws::Delete(slot.exchange(nullptr));
+    }
+}
+
+AWSAuthV4Signer::CanonicalRequestBuffers* AWSAuthV4Signer::AcquireCanonicalRequestBuffers() const
+{
+    for (auto& slot : m_canonicalRequestBuffers)
+    {
+        CanonicalRequestBuffers* buffers = slot.exchange(nullptr);
+        if (buffers)
+        {
+            buffers->canonicalRequest.clear();
+            buffers->signedHeaders.clear();
+            return buffers;
+        }
+    }
+
+    return Aws::New<CanonicalRequestBuffers>(v4LogTag);
+}
+
+void AWSAuthV4Signer::ReleaseCanonicalRequestBuffers(CanonicalRequestBuffers* buffers) const
+{
+    for (auto& slot : m_canonicalRequestBuffers)
+    {
+        CanonicalRequestBuffers* empty = nullptr;
+        if (slot.compare_exchange_strong(empty, buffers))
+        {
+            return;
+        }
+    }
+
+    Aws::Delete(buffers);
 }
 
 
 bool AWSAuthV4Signer::ShouldSignHeader(const Aws::String& header) const
 {
-    return m_unsignedHeaders.find(Aws::Utils::StringUtils::ToLower(header.c_str())) == m_unsignedHeaders.cend();
+    for (const auto& unsignedHeader : m_unsignedHeaders)
+    {
+        if (StringUtils::CaselessCompare(header.c_str(), unsignedHeader.c_str()))
+        {
+            return false;
+        }
+    }
+
+    return true;
 }
 
 bool AWSAuthV4Signer::SignRequest(Aws::Http::HttpRequest& request) const
@@ -164,7 +459,57 @@ bool AWSAuthV4Signer::SignRequest(Aws::Http::HttpRequest& request) const
 
 bool AWSAuthV4Signer::SignRequest(Aws::Http::HttpRequest& request, bool signBody) const
 {
-    AWSCredentials credentials = m_credentialsProvider->GetAWSCredentials();
+    CanonicalRequestBuffers* buffers = AcquireCanonicalRequestBuffers();
+    bool signedRequest = SignRequestWithBuffers(request, signBody, *buffers);
+    ReleaseCanonicalRequestBuffers(buffers);
+    return signedRequest;
+}
+
+void AWSAuthV4Signer::AppendCanonicalHeaders(const Aws::Http::HttpRequest& request, CanonicalRequestBuffers& buffers) const
+{
+    Http::HeaderValueCollection headers = request.GetHeaders();
+    //header names are normally stored trimmed already, re-key them only when they aren't since trimming can change their order.
+    for (const auto& header : headers)
+    {
+        if (HeaderNameNeedsTrim(header.first))
+        {
+            Http::HeaderValueCollection trimmedHeaders;
+            for (const auto& untrimmedHeader : headers)
+            {
+                trimmedHeaders[StringUtils::Trim(untrimmedHeader.first.c_str())] = untrimmedHeader.second;
+            }
+            headers.swap(trimmedHeaders);
+            break;
+        }
+    }
+
+    for (const auto& header : headers)
+    {
+        if(ShouldSignHeader(header.first))
+        {
+            buffers.canonicalRequest.append(header.first).append(":");
+            AppendCanonicalHeaderValue(buffers.canonicalRequest, header.second);
+            buffers.canonicalRequest.append(NEWLINE);
+
+            if (!buffers.signedHeaders.empty())
+            {
+                buffers.signedHeaders.append(";");
+            }
+            buffers.signedHeaders.append(header.first);
+        }
+    }
+}
+
+bool AWSAuthV4Signer::HashesPayload(const Aws::Http::URI& uri, bool signBody) const
+{
+    return (signBody || uri.GetScheme() != Http::Scheme::HTTPS) && m_payloadSigningChunkSize == 0;
+}
+
+bool AWSAuthV4Signer::SignRequestWithBuffers(Aws::Http::HttpRequest& request, bool signBody, CanonicalRequestBuffers& buffers) const
+{
+    //hold on to the provider's snapshot rather than copying the credentials for every request.
+    auto credentialsSnapshot = m_credentialsProvider->GetAWSCredentialsSnapshot();
+    const AWSCredentials& credentials = *credentialsSnapshot;
 
     //don't sign anonymous requests
     if (credentials.GetAWSAccessKeyId().empty() || credentials.GetAWSSecretKey().empty())
@@ -177,13 +522,24 @@ bool AWSAuthV4Signer::SignRequest(Aws::Http::HttpRequest& request, bool signBody
         request.SetAwsSessionToken(credentials.GetSessionToken());
     }
 
+    bool streamPayload = false;
     Aws::String payloadHash(UNSIGNED_PAYLOAD);
     if(signBody || request.GetUri().GetScheme() != Http::Scheme::HTTPS)
     {
-        payloadHash.assign(ComputePayloadHash(request));
-        if (payloadHash.empty())
+        if (ShouldStreamPayload(request))
         {
-            return false;
+            //the payload is signed chunk by chunk as it is sent, see AttachStreamingPayload.
+            streamPayload = true;
+            payloadHash.assign(STREAMING_PAYLOAD);
+            PrepareStreamingPayloadHeaders(request);
+        }
+        else
+        {
+            payloadHash.assign(ComputePayloadHash(request));
+            if (payloadHash.empty())
+            {
+                return false;
+            }
         }
     }
     else
@@ -192,42 +548,34 @@ bool AWSAuthV4Signer::SignRequest(Aws::Http::HttpRequest& request, bool signBody
                 << " http scheme=" << Http::SchemeMapper::ToString(request.GetUri().GetScheme()));
     }
 
-    if(m_includeSha256HashHeader)
+    if(m_includeSha256HashHeader || streamPayload)
     {
         request.SetHeaderValue("x-amz-content-sha256", payloadHash);
     }
 
     //calculate date header to use in internal signature (this also goes into date header).
     DateTime now = GetSigningTimestamp();
-    Aws::String dateHeaderValue = now.ToGmtString(LONG_DATE_FORMAT_STR);
-    request.SetHeaderValue(AWS_DATE_HEADER, dateHeaderValue);
-
-    Aws::StringStream headersStream;
-    Aws::StringStream signedHeadersStream;
-
-    for (const auto& header : CanonicalizeHeaders(request.GetHeaders()))
+    int64_t nowMillis = now.Millis();
+    int64_t nowSecond = nowMillis / 1000 - (nowMillis % 1000 < 0 ? 1 : 0);
+    if (nowSecond != buffers.formattedSecond)
     {
-        if(ShouldSignHeader(header.first))
-        {
-            headersStream << header.first.c_str() << ":" << header.second.c_str() << NEWLINE;
-            signedHeadersStream << header.first.c_str() << ";";
-        }
+        char formattedDate[DateTime::ISO_8601_BASIC_LENGTH + 1];
+        size_t length = now.ToGmtString(DateFormat::ISO_8601_BASIC, formattedDate, sizeof(formattedDate));
+        buffers.longDate.assign(formattedDate, length);
+        buffers.simpleDate.assign(formattedDate, length < SIMPLE_DATE_LENGTH ? length : SIMPLE_DATE_LENGTH);
+        buffers.formattedSecond = length > 0 ? nowSecond : NO_FORMATTED_SECOND;
     }
+    const Aws::String& dateHeaderValue = buffers.longDate;
+    request.SetHeaderValue(AWS_DATE_HEADER, dateHeaderValue);
 
-    Aws::String canonicalHeadersString = headersStream.str();
-    AWS_LOGSTREAM_DEBUG(v4LogTag, "Canonical Header String: " << canonicalHeadersString);
+    //the canonical request is built in place: request line, canonical headers, signed headers and finally the payload hash.
+    Aws::String& canonicalRequestString = buffers.canonicalRequest;
+    AppendCanonicalRequestLine(canonicalRequestString, buffers.scratch, request, m_urlEscapePath);
+    AppendCanonicalHeaders(request, buffers);
 
-    //calculate signed headers parameter
-    Aws::String signedHeadersValue = signedHeadersStream.str();
-    //remove that last semi-colon
-    signedHeadersValue.erase(signedHeadersValue.length() - 1);
+    const Aws::String& signedHeadersValue = buffers.signedHeaders;
     AWS_LOGSTREAM_DEBUG(v4LogTag, "Signed Headers value:" << signedHeadersValue);
 
-    //generate generalized canonicalized request string.
-    Aws::String canonicalRequestString = CanonicalizeRequestSigningString(request, m_urlEscapePath);
-
-    //append v4 stuff to the canonical request string.
-    canonicalRequestString.append(canonicalHeadersString);
     canonicalRequestString.append(NEWLINE);
     canonicalRequestString.append(signedHeadersValue);
     canonicalRequestString.append(NEWLINE);
@@ -245,17 +593,26 @@ bool AWSAuthV4Signer::SignRequest(Aws::Http::HttpRequest& request, bool signBody
 
     auto sha256Digest = hashResult.GetResult();
     Aws::String cannonicalRequestHash = HashingUtils::HexEncode(sha256Digest);
-    Aws::String simpleDate = now.ToGmtString(SIMPLE_DATE_FORMAT_STR);
+    const Aws::String& simpleDate = buffers.simpleDate;
 
-    Aws::String stringToSign = GenerateStringToSign(dateHeaderValue, simpleDate, cannonicalRequestHash);
-    auto finalSignature = GenerateSignature(credentials, stringToSign, simpleDate);
+    Aws::String stringToSign = GenerateStringToSign(dateHeaderValue, simpleDate, m_credentialScopeSuffix, cannonicalRequestHash);
+    auto finalSignature = GenerateSignature(credentials, stringToSign, simpleDate, m_region, m_serviceName);
 
-    Aws::StringStream ss;
-    ss << AWS_HMAC_SHA256 << " " << CREDENTIAL << EQ << credentials.GetAWSAccessKeyId() << "/" << simpleDate
-        << "/" << m_region << "/" << m_serviceName << "/" << AWS4_REQUEST << ", " << SIGNED_HEADERS << EQ
-        << signedHeadersValue << ", " << SIGNATURE << EQ << finalSignature;
+    if (streamPayload)
+    {
+        if (finalSignature.empty())
+        {
+            return false;
+        }
+        AttachStreamingPayload(request, credentials, dateHeaderValue, simpleDate, finalSignature);
+    }
+
+    Aws::String awsAuthString;
+    awsAuthString.reserve(256 + signedHeadersValue.length());
+    awsAuthString.append(AWS_HMAC_SHA256).append(" ").append(CREDENTIAL).append(EQ).append(credentials.GetAWSAccessKeyId())
+        .append("/").append(simpleDate).append(m_credentialScopeSuffix).append(", ").append(SIGNED_HEADERS).append(EQ)
+        .append(signedHeadersValue).append(", ").append(SIGNATURE).append(EQ).append(finalSignature);
 
-    auto awsAuthString = ss.str();
     AWS_LOGSTREAM_DEBUG(v4LogTag, "Signing request with: " << awsAuthString);
     request.SetAwsAuthorization(awsAuthString);
 
@@ -274,7 +631,9 @@ bool AWSAuthV4Signer::PresignRequest(Aws::Http::HttpRequest& request, const char
 
 bool AWSAuthV4Signer::PresignRequest(Aws::Http::HttpRequest& request, const char* region, const char* serviceName, long long expirationTimeInSeconds) const
 {
-    AWSCredentials credentials = m_credentialsProvider->GetAWSCredentials();
+    //hold on to the provider's snapshot rather than copying the credentials for every request.
+    auto credentialsSnapshot = m_credentialsProvider->GetAWSCredentialsSnapshot();
+    const AWSCredentials& credentials = *credentialsSnapshot;
 
     //don't sign anonymous requests
     if (credentials.GetAWSAccessKeyId().empty() || credentials.GetAWSSecretKey().empty())
@@ -293,7 +652,7 @@ bool AWSAuthV4Signer::PresignRequest(Aws::Http::HttpRequest& request, const char
 
     //calculate date header to use in internal signature (this also goes into date header).
     DateTime now = GetSigningTimestamp();
-    Aws::String dateQueryValue = now.ToGmtString(LONG_DATE_FORMAT_STR);
+    Aws::String dateQueryValue = now.ToGmtString(DateFormat::ISO_8601_BASIC);
     request.AddQueryStringParameter(Http::AWS_DATE_HEADER, dateQueryValue);
 
     Aws::StringStream ss;
@@ -309,7 +668,7 @@ bool AWSAuthV4Signer::PresignRequest(Aws::Http::HttpRequest& request, const char
 
     AWS_LOGSTREAM_DEBUG(v4LogTag, "Signed Headers value: " << signedHeadersValue);
 
-    Aws::String simpleDate = now.ToGmtString(SIMPLE_DATE_FORMAT_STR);
+    Aws::String simpleDate = dateQueryValue.substr(0, SIMPLE_DATE_LENGTH);
     ss << credentials.GetAWSAccessKeyId() << "/" << simpleDate
         << "/" << region << "/" << serviceName << "/" << AWS4_REQUEST;
 
@@ -318,7 +677,9 @@ bool AWSAuthV4Signer::PresignRequest(Aws::Http::HttpRequest& request, const char
     ss.str("");
 
     //generate generalized canonicalized request string.
-    Aws::String canonicalRequestString = CanonicalizeRequestSigningString(request, m_urlEscapePath);
+    Aws::String canonicalRequestString;
+    Aws::String pathScratch;
+    AppendCanonicalRequestLine(canonicalRequestString, pathScratch, request, m_urlEscapePath);
 
     //append v4 stuff to the canonical request string.
     canonicalRequestString.append(canonicalHeadersString);
@@ -339,9 +700,11 @@ bool AWSAuthV4Signer::PresignRequest(Aws::Http::HttpRequest& request, const char
     auto sha256Digest = hashResult.GetResult();
     auto cannonicalRequestHash = HashingUtils::HexEncode(sha256Digest);
 
-    auto stringToSign = GenerateStringToSign(dateQueryValue, simpleDate, cannonicalRequestHash);
+    Aws::String credentialScopeSuffix("/");
+    credentialScopeSuffix.append(region).append("/").append(serviceName).append("/").append(AWS4_REQUEST);
+    auto stringToSign = GenerateStringToSign(dateQueryValue, simpleDate, credentialScopeSuffix, cannonicalRequestHash);
 
-    auto finalSigningHash = GenerateSignature(credentials, stringToSign, simpleDate);
+    auto finalSigningHash = GenerateSignature(credentials, stringToSign, simpleDate, region, serviceName);
     if (finalSigningHash.empty())
     {
         return false;
@@ -353,14 +716,25 @@ bool AWSAuthV4Signer::PresignRequest(Aws::Http::HttpRequest& request, const char
     return true;
 }
 
-Aws::String AWSAuthV4Signer::GenerateSignature(const AWSCredentials& credentials, const Aws::String& stringToSign, const Aws::String& simpleDate) const
+Aws::String AWSAuthV4Signer::GenerateSignature(const AWSCredentials& credentials, const Aws::String& stringToSign, const Aws::String& simpleDate,
+    const Aws::String& region, const Aws::String& serviceName) const
 {
     AWS_LOGSTREAM_DEBUG(v4LogTag, "Final String to sign: " << stringToSign);
 
-    Aws::StringStream ss;
+    //the reader keeps the cached key alive while we sign with it.
+    DerivedKeyCache::Reader reader(*m_derivedKeys);
+    const ByteBuffer* cachedKey = reader.Find(credentials.GetAWSSecretKey(), simpleDate, region, serviceName);
+    ByteBuffer derivedKey;
+    if (!cachedKey)
+    {
+        derivedKey = ComputeLongLivedHash(credentials.GetAWSSecretKey(), simpleDate, region, serviceName);
+    }
+    const ByteBuffer& partialSignature = cachedKey ? *cachedKey : derivedKey;
+    if (partialSignature.GetLength() == 0)
+    {
+        return "";
+    }
 
-    auto& partialSignature = ComputeLongLivedHash(credentials.GetAWSSecretKey(), simpleDate);
-        
     auto hashResult = m_HMAC->Calculate(ByteBuffer((unsigned char*)stringToSign.c_str(), stringToSign.length()), partialSignature);
     if (!hashResult.IsSuccess())
     {
@@ -385,6 +759,15 @@ Aws::String AWSAuthV4Signer::ComputePayloadHash(Aws::Http::HttpRequest& request)
         return EMPTY_STRING_SHA256;
     }
 
+    //the client may already have hashed the body along with its other digests, see AWSClient::AddContentBodyToRequest.
+    ByteBuffer computedDigest = request.GetContentBodyDigest(Crypto::DigestAlgorithm::SHA256);
+    if (computedDigest.GetLength() > 0)
+    {
+        Aws::String payloadHash(HashingUtils::HexEncode(computedDigest));
+        AWS_LOGSTREAM_DEBUG(v4LogTag, "Using sha256 " << payloadHash << " computed with the other content body digests.");
+        return payloadHash;
+    }
+
     //compute hash on payload if it exists.
     auto hashResult =  m_hash->Calculate(*request.GetContentBody());
 
@@ -407,74 +790,133 @@ Aws::String AWSAuthV4Signer::ComputePayloadHash(Aws::Http::HttpRequest& request)
     return payloadHash;
 }
 
-Aws::String AWSAuthV4Signer::GenerateStringToSign(const Aws::String& dateValue, const Aws::String& simpleDate, const Aws::String& canonicalRequestHash) const
+bool AWSAuthV4Signer::ShouldStreamPayload(const Aws::Http::HttpRequest& request) const
 {
-    //generate the actual string we will use in signing the final request.
-    Aws::StringStream ss;
-
-    ss << AWS_HMAC_SHA256 << NEWLINE << dateValue << NEWLINE << simpleDate << "/" << m_region << "/"
-        << m_serviceName << "/" << AWS4_REQUEST << NEWLINE << canonicalRequestHash;
+    if (m_payloadSigningChunkSize == 0 || !request.GetContentBody() || !request.HasHeader(Http::CONTENT_LENGTH_HEADER))
+    {
+        return false;
+    }
 
-    return ss.str();
+    return StringUtils::ConvertToInt64(request.GetHeaderValue(Http::CONTENT_LENGTH_HEADER).c_str()) > 0;
 }
 
-const Aws::Utils::Array<unsigned char>& AWSAuthV4Signer::ComputeLongLivedHash(const Aws::String& secretKey, const Aws::String& simpleDate) const
+void AWSAuthV4Signer::PrepareStreamingPayloadHeaders(Aws::Http::HttpRequest& request) const
 {
-    //only compute this once and use it until either the credentials change, or the date changes.
-    if (m_currentDateStr != simpleDate || m_currentSecretKey != secretKey)
+    Aws::String decodedLength = request.GetHeaderValue(Http::CONTENT_LENGTH_HEADER);
+    request.SetHeaderValue(X_AMZ_DECODED_CONTENT_LENGTH, decodedLength);
+    request.SetContentLength(StringUtils::to_string(AWSChunkedPayloadStreamBuf::ComputeEncodedLength(
+        StringUtils::ConvertToInt64(decodedLength.c_str()), m_payloadSigningChunkSize)));
+
+    //aws-chunked has to be the first content encoding, the service strips it before storing the object.
+    Aws::String contentEncoding(AWS_CHUNKED);
+    if (request.HasHeader(CONTENT_ENCODING))
     {
-        std::lock_guard<std::mutex> locker(m_partialSignatureLock);
-        if (m_currentDateStr != simpleDate || m_currentSecretKey != secretKey)
-        {
-            m_currentSecretKey = secretKey;
-            m_currentDateStr = simpleDate;
-
-            //now we do the complicated part of deriving a signing key.
-            Aws::String signingKey(SIGNING_KEY);
-            
-            signingKey.append(m_currentSecretKey);
+        contentEncoding.append(",").append(request.GetHeaderValue(CONTENT_ENCODING));
+    }
+    request.SetHeaderValue(CONTENT_ENCODING, contentEncoding);
+}
 
-            //we use digest only for the derivation process.
-            auto hashResult = m_HMAC->Calculate(ByteBuffer((unsigned char*)simpleDate.c_str(), simpleDate.length()),
-                ByteBuffer((unsigned char*)signingKey.c_str(), signingKey.length()));
+void AWSAuthV4Signer::AttachStreamingPayload(Aws::Http::HttpRequest& request, const AWSCredentials& credentials,
+    const Aws::String& dateValue, const Aws::String& simpleDate, const Aws::String& seedSignature) const
+{
+    auto chunkedPayload = Aws::MakeShared<AWSChunkedPayloadStream>(v4LogTag, request.GetContentBody(),
+        ComputeLongLivedHash(credentials.GetAWSSecretKey(), simpleDate, m_region, m_serviceName), dateValue, simpleDate + m_credentialScopeSuffix,
+        seedSignature, m_payloadSigningChunkSize);
 
-            if (!hashResult.IsSuccess())
+    //the http client reports encoded bytes, progress listeners expect payload bytes.
+    auto sentHandler = request.GetDataSentEventHandler();
+    if (sentHandler)
+    {
+        long long reportedBytes = 0;
+        request.SetDataSentEventHandler([chunkedPayload, sentHandler, reportedBytes](const HttpRequest* sentRequest, long long) mutable
+        {
+            long long payloadBytes = chunkedPayload->GetPayloadBytesSent();
+            if (payloadBytes > reportedBytes)
             {
-                AWS_LOGSTREAM_ERROR(v4LogTag, "Failed to hmac (sha256) date string \"" << simpleDate << "\"");
-                m_partialSignature = ByteBuffer();
-                return m_partialSignature;
+                sentHandler(sentRequest, payloadBytes - reportedBytes);
+                reportedBytes = payloadBytes;
             }
+        });
+    }
 
-            auto kDate = hashResult.GetResult();
-            hashResult = m_HMAC->Calculate(ByteBuffer((unsigned char*)m_region.c_str(), m_region.length()), kDate);
-            if (!hashResult.IsSuccess())
-            {
-                AWS_LOGSTREAM_ERROR(v4LogTag, "Failed to hmac (sha256) region string \"" << m_region << "\"");
-                m_partialSignature = ByteBuffer();
-                return m_partialSignature;
-            }
+    request.AddContentBody(chunkedPayload);
+    AWS_LOGSTREAM_DEBUG(v4LogTag, "Streaming payload in " << m_payloadSigningChunkSize << " byte aws-chunked chunks, seed signature " << seedSignature);
+}
 
-            auto kRegion = hashResult.GetResult();
-            hashResult = m_HMAC->Calculate(ByteBuffer((unsigned char*)m_serviceName.c_str(), m_serviceName.length()), kRegion);
-            if (!hashResult.IsSuccess())
-            {
-                AWS_LOGSTREAM_ERROR(v4LogTag, "Failed to hmac (sha256) service string \"" << m_serviceName << "\"");
-                m_partialSignature = ByteBuffer();
-                return m_partialSignature;
-            }
+Aws::String AWSAuthV4Signer::GenerateStringToSign(const Aws::String& dateValue, const Aws::String& simpleDate, const Aws::String& credentialScopeSuffix,
+    const Aws::String& canonicalRequestHash) const
+{
+    //generate the actual string we will use in signing the final request.
+    Aws::String stringToSign;
+    stringToSign.reserve(64 + dateValue.length() + simpleDate.length() + credentialScopeSuffix.length() + canonicalRequestHash.length());
+    stringToSign.append(AWS_HMAC_SHA256).append(NEWLINE).append(dateValue).append(NEWLINE).append(simpleDate)
+        .append(credentialScopeSuffix).append(NEWLINE).append(canonicalRequestHash);
 
-            auto kService = hashResult.GetResult();
-            hashResult = m_HMAC->Calculate(ByteBuffer((unsigned char*)AWS4_REQUEST, strlen(AWS4_REQUEST)), kService);
-            if (!hashResult.IsSuccess())
-            {
-                AWS_LOGSTREAM_ERROR(v4LogTag, "Unable to hmac (sha256) request string \"" << AWS4_REQUEST << "\"");
-                m_partialSignature = ByteBuffer();
-                return m_partialSignature;
-            }
+    return stringToSign;
+}
 
-            m_partialSignature = hashResult.GetResult();
+Aws::Utils::ByteBuffer AWSAuthV4Signer::ComputeLongLivedHash(const Aws::String& secretKey, const Aws::String& simpleDate,
+    const Aws::String& region, const Aws::String& serviceName) const
+{
+    //only compute this once per secret key, date, region and service.
+    {
+        DerivedKeyCache::Reader reader(*m_derivedKeys);
+        const ByteBuffer* cachedKey = reader.Find(secretKey, simpleDate, region, serviceName);
+        if (cachedKey)
+        {
+            return *cachedKey;
         }
     }
 
-    return m_partialSignature;
+    ByteBuffer signingKey = DeriveSigningKey(secretKey, simpleDate, region, serviceName);
+    if (signingKey.GetLength() > 0)
+    {
+        m_derivedKeys->Insert(DerivedKeyCache::DerivedKey { secretKey, simpleDate, region, serviceName, signingKey });
+    }
+
+    return signingKey;
+}
+
+Aws::Utils::ByteBuffer AWSAuthV4Signer::DeriveSigningKey(const Aws::String& secretKey, const Aws::String& simpleDate,
+    const Aws::String& region, const Aws::String& serviceName) const
+{
+    //now we do the complicated part of deriving a signing key.
+    Aws::String signingKey(SIGNING_KEY);
+    signingKey.append(secretKey);
+
+    //we use digest only for the derivation process.
+    auto hashResult = m_HMAC->Calculate(ByteBuffer((unsigned char*)simpleDate.c_str(), simpleDate.length()),
+        ByteBuffer((unsigned char*)signingKey.c_str(), signingKey.length()));
+
+    if (!hashResult.IsSuccess())
+    {
+        AWS_LOGSTREAM_ERROR(v4LogTag, "Failed to hmac (sha256) date string \"" << simpleDate << "\"");
+        return ByteBuffer();
+    }
+
+    auto kDate = hashResult.GetResult();
+    hashResult = m_HMAC->Calculate(ByteBuffer((unsigned char*)region.c_str(), region.length()), kDate);
+    if (!hashResult.IsSuccess())
+    {
+        AWS_LOGSTREAM_ERROR(v4LogTag, "Failed to hmac (sha256) region string \"" << region << "\"");
+        return ByteBuffer();
+    }
+
+    auto kRegion = hashResult.GetResult();
+    hashResult = m_HMAC->Calculate(ByteBuffer((unsigned char*)serviceName.c_str(), serviceName.length()), kRegion);
+    if (!hashResult.IsSuccess())
+    {
+        AWS_LOGSTREAM_ERROR(v4LogTag, "Failed to hmac (sha256) service string \"" << serviceName << "\"");
+        return ByteBuffer();
+    }
+
+    auto kService = hashResult.GetResult();
+    hashResult = m_HMAC->Calculate(ByteBuffer((unsigned char*)AWS4_REQUEST, strlen(AWS4_REQUEST)), kService);
+    if (!hashResult.IsSuccess())
+    {
+        AWS_LOGSTREAM_ERROR(v4LogTag, "Unable to hmac (sha256) request string \"" << AWS4_REQUEST << "\"");
+        return ByteBuffer();
+    }
+
+    return hashResult.GetResult();
 }
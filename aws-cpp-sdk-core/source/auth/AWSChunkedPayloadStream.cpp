@@ -0,0 +1,172 @@
+
+/*
+* Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+*
+* Licensed under the Apache License, Version 2.0 (the "License").
+* You may not use this file except in compliance with the License.
+* A copy of the License is located at
+*
+*  http://aws.amazon.com/apache2.0
+*
+* or in the "license" file accompanying this file. This file is distributed
+* on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+* express or implied. See the License for the specific language governing
+* permissions and limitations under the License.
+*/
+
+#include <aws/core/auth/AWSChunkedPayloadStream.h>
+#include <aws/core/utils/HashingUtils.h>
+#include <aws/core/utils/Outcome.h>
+#include <aws/core/utils/logging/LogMacros.h>
+#include <aws/core/utils/memory/stl/AWSStringStream.h>
+#include <aws/core/utils/crypto/Sha256.h>
+#include <aws/core/utils/crypto/Sha256HMAC.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+using namespace Aws::Client;
+using namespace Aws::Utils;
+
+static const char* CHUNKED_PAYLOAD_LOG_TAG = "AWSChunkedPayloadStream";
+static const char* AWS_HMAC_SHA256_PAYLOAD = "AWS4-HMAC-SHA256-PAYLOAD";
+static const char* EMPTY_STRING_SHA256 = "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855";
+static const char CHUNK_SIGNATURE[] = ";chunk-signature=";
+static const char CRLF[] = "\r\n";
+static const size_t SIGNATURE_LENGTH = 64;
+static const size_t CHUNK_SIGNATURE_LENGTH = sizeof(CHUNK_SIGNATURE) - 1;
+static const size_t CRLF_LENGTH = sizeof(CRLF) - 1;
+//hex encoded 64 bit size + ;chunk-signature= + signature + crlf
+static const size_t MAX_CHUNK_HEADER_LENGTH = 16 + CHUNK_SIGNATURE_LENGTH + SIGNATURE_LENGTH + CRLF_LENGTH;
+
+static size_t HexLength(long long value)
+{
+    size_t length = 1;
+    while (value >>= 4)
+    {
+        ++length;
+    }
+
+    return length;
+}
+
+static long long EncodedChunkLength(long long chunkLength)
+{
+    return static_cast<long long>(HexLength(chunkLength) + CHUNK_SIGNATURE_LENGTH + SIGNATURE_LENGTH + CRLF_LENGTH) + chunkLength + CRLF_LENGTH;
+}
+
+AWSChunkedPayloadStreamBuf::AWSChunkedPayloadStreamBuf(const std::shared_ptr<Aws::IOStream>& payload, const ByteBuffer& signingKey,
+    const Aws::String& dateValue, const Aws::String& scope, const Aws::String& seedSignature, size_t chunkSize) :
+    m_payload(payload),
+    m_signingKey(signingKey),
+    m_previousSignature(seedSignature),
+    m_buffer(MAX_CHUNK_HEADER_LENGTH + chunkSize + CRLF_LENGTH),
+    m_hash(Aws::MakeUnique<Crypto::Sha256>(CHUNKED_PAYLOAD_LOG_TAG)),
+    m_HMAC(Aws::MakeUnique<Crypto::Sha256HMAC>(CHUNKED_PAYLOAD_LOG_TAG)),
+    m_chunkSize(chunkSize),
+    m_chunkData(m_buffer.GetUnderlyingData() + MAX_CHUNK_HEADER_LENGTH),
+    m_chunkLength(0),
+    m_payloadSentBeforeChunk(0),
+    m_finalChunkSent(false)
+{
+    assert(chunkSize > 0);
+    m_stringToSignPrefix.append(AWS_HMAC_SHA256_PAYLOAD).append("\n").append(dateValue).append("\n").append(scope).append("\n");
+    setg(m_chunkData, m_chunkData, m_chunkData);
+}
+
+AWSChunkedPayloadStreamBuf::~AWSChunkedPayloadStreamBuf()
+{
+    // empty destructor in .cpp file to keep from needing the implementation of (Sha256, Sha256HMAC) in the header file
+}
+
+long long AWSChunkedPayloadStreamBuf::ComputeEncodedLength(long long payloadLength, size_t chunkSize)
+{
+    long long fullChunks = payloadLength / static_cast<long long>(chunkSize);
+    long long remainder = payloadLength % static_cast<long long>(chunkSize);
+
+    long long encodedLength = fullChunks * EncodedChunkLength(static_cast<long long>(chunkSize));
+    if (remainder > 0)
+    {
+        encodedLength += EncodedChunkLength(remainder);
+    }
+
+    return encodedLength + EncodedChunkLength(0);
+}
+
+long long AWSChunkedPayloadStreamBuf::GetPayloadBytesSent() const
+{
+    //only the bytes between the chunk header and the trailing crlf are payload.
+    long long sentOfChunk = std::min(std::max(gptr() - m_chunkData, static_cast<std::ptrdiff_t>(0)), static_cast<std::ptrdiff_t>(m_chunkLength));
+    return m_payloadSentBeforeChunk + sentOfChunk;
+}
+
+AWSChunkedPayloadStreamBuf::int_type AWSChunkedPayloadStreamBuf::underflow()
+{
+    if (gptr() < egptr())
+    {
+        return traits_type::to_int_type(*gptr());
+    }
+
+    if (m_finalChunkSent || !EncodeNextChunk())
+    {
+        return traits_type::eof();
+    }
+
+    return traits_type::to_int_type(*gptr());
+}
+
+bool AWSChunkedPayloadStreamBuf::EncodeNextChunk()
+{
+    m_payloadSentBeforeChunk += static_cast<long long>(m_chunkLength);
+    m_chunkLength = 0;
+
+    if (m_payload && m_payload->good())
+    {
+        m_payload->read(m_chunkData, static_cast<std::streamsize>(m_chunkSize));
+        m_chunkLength = static_cast<size_t>(m_payload->gcount());
+    }
+
+    Aws::String chunkHash(EMPTY_STRING_SHA256);
+    if (m_chunkLength > 0)
+    {
+        //hashed in place, right out of the frame buffer the chunk was read into.
+        auto hashResult = m_hash->Calculate(reinterpret_cast<const unsigned char*>(m_chunkData), m_chunkLength);
+        if (!hashResult.IsSuccess())
+        {
+            AWS_LOGSTREAM_ERROR(CHUNKED_PAYLOAD_LOG_TAG, "Unable to hash (sha256) chunk of " << m_chunkLength << " bytes");
+            return false;
+        }
+        chunkHash = HashingUtils::HexEncode(hashResult.GetResult());
+    }
+
+    Aws::String stringToSign(m_stringToSignPrefix);
+    stringToSign.append(m_previousSignature).append("\n").append(EMPTY_STRING_SHA256).append("\n").append(chunkHash);
+
+    auto signResult = m_HMAC->Calculate(ByteBuffer(reinterpret_cast<const unsigned char*>(stringToSign.c_str()), stringToSign.length()), m_signingKey);
+    if (!signResult.IsSuccess())
+    {
+        AWS_LOGSTREAM_ERROR(CHUNKED_PAYLOAD_LOG_TAG, "Unable to hmac (sha256) chunk string to sign \"" << stringToSign << "\"");
+        return false;
+    }
+    m_previousSignature = HashingUtils::HexEncode(signResult.GetResult());
+
+    //the header is written right in front of the chunk data so the whole frame goes out of a single buffer.
+    Aws::StringStream header;
+    header << std::hex << m_chunkLength << CHUNK_SIGNATURE << m_previousSignature << CRLF;
+    Aws::String headerStr = header.str();
+    char* frameBegin = m_chunkData - headerStr.length();
+    memcpy(frameBegin, headerStr.c_str(), headerStr.length());
+    memcpy(m_chunkData + m_chunkLength, CRLF, CRLF_LENGTH);
+
+    m_finalChunkSent = m_chunkLength == 0;
+    setg(frameBegin, frameBegin, m_chunkData + m_chunkLength + CRLF_LENGTH);
+    return true;
+}
+
+AWSChunkedPayloadStream::AWSChunkedPayloadStream(const std::shared_ptr<Aws::IOStream>& payload, const ByteBuffer& signingKey,
+    const Aws::String& dateValue, const Aws::String& scope, const Aws::String& seedSignature, size_t chunkSize) :
+    Base(&m_buf),
+    m_buf(payload, signingKey, dateValue, scope, seedSignature, chunkSize)
+{
+}
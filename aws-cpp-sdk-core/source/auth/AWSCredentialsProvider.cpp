@@ -15,6 +15,7 @@
 
 
 #include <aws/core/auth/AWSCredentialsProvider.h>
+#include <aws/core/auth/AWSCredentialsRefreshScheduler.h>
 
 #include <aws/core/config/AWSProfileConfigLoader.h>
 #include <aws/core/platform/Environment.h>
@@ -28,6 +29,8 @@
 #include <fstream>
 #include <string.h>
 #include <climits>
+#include <limits>
+#include <algorithm>
 
 
 using namespace Aws::Utils;
@@ -68,6 +71,43 @@ bool AWSCredentialsProvider::IsTimeToRefresh(long reloadFrequency)
     return false;
 }
 
+static const char* PROVIDER_LOG_TAG = "AWSCredentialsProvider";
+
+std::shared_ptr<const AWSCredentials> AWSCredentialsProvider::GetAWSCredentialsSnapshot()
+{
+    auto credentials = GetAWSCredentials();
+    auto snapshot = LoadAWSCredentialsSnapshot();
+    if (!snapshot || *snapshot != credentials)
+    {
+        snapshot = Aws::MakeShared<AWSCredentials>(PROVIDER_LOG_TAG, std::move(credentials));
+        PublishAWSCredentialsSnapshot(snapshot);
+    }
+
+    return snapshot;
+}
+
+void AWSCredentialsProvider::PublishAWSCredentialsSnapshot(const std::shared_ptr<const AWSCredentials>& snapshot)
+{
+    std::atomic_store(&m_credentialsSnapshot, snapshot);
+    ++m_credentialsVersion;
+}
+
+AnonymousAWSCredentialsProvider::AnonymousAWSCredentialsProvider()
+{
+    PublishAWSCredentialsSnapshot(Aws::MakeShared<AWSCredentials>(PROVIDER_LOG_TAG, "", ""));
+}
+
+SimpleAWSCredentialsProvider::SimpleAWSCredentialsProvider(const Aws::String& awsAccessKeyId, const Aws::String& awsSecretAccessKey,
+        const Aws::String& sessionToken)
+{
+    PublishAWSCredentialsSnapshot(Aws::MakeShared<AWSCredentials>(PROVIDER_LOG_TAG, awsAccessKeyId, awsSecretAccessKey, sessionToken));
+}
+
+SimpleAWSCredentialsProvider::SimpleAWSCredentialsProvider(const AWSCredentials& credentials)
+{
+    PublishAWSCredentialsSnapshot(Aws::MakeShared<AWSCredentials>(PROVIDER_LOG_TAG, credentials));
+}
+
 
 static const char* ENVIRONMENT_LOG_TAG = "EnvironmentAWSCredentialsProvider";
 
@@ -102,6 +142,136 @@ AWSCredentials EnvironmentAWSCredentialsProvider::GetAWSCredentials()
     return credentials;
 }
 
+static const char* REFRESHING_LOG_TAG = "RefreshingAWSCredentialsProvider";
+//failed background refreshes are retried at most this often.
+static const int64_t MIN_BACKGROUND_RETRY_INTERVAL_MS = 1000;
+
+RefreshingAWSCredentialsProvider::RefreshingAWSCredentialsProvider(long refreshRateMs, long retryIntervalMs, long expirationWindowMs) :
+    m_nextRefreshMs(0),
+    m_expirationMs(0),
+    m_refreshRateMs(refreshRateMs),
+    m_retryIntervalMs(retryIntervalMs),
+    m_expirationWindowMs(expirationWindowMs),
+    m_prefetchWindowMs(0)
+{
+    PublishAWSCredentialsSnapshot(Aws::MakeShared<AWSCredentials>(REFRESHING_LOG_TAG));
+}
+
+RefreshingAWSCredentialsProvider::~RefreshingAWSCredentialsProvider()
+{
+    DisableBackgroundRefresh();
+}
+
+AWSCredentials RefreshingAWSCredentialsProvider::GetAWSCredentials()
+{
+    return *GetAWSCredentialsSnapshot();
+}
+
+std::shared_ptr<const AWSCredentials> RefreshingAWSCredentialsProvider::GetAWSCredentialsSnapshot()
+{
+    auto now = DateTime::CurrentTimeMillis();
+    if (now >= m_nextRefreshMs.load())
+    {
+        if (now >= m_expirationMs.load())
+        {
+            //nothing usable to hand out, wait for whoever is refreshing.
+            std::lock_guard<std::mutex> locker(m_refreshMutex);
+            if (DateTime::CurrentTimeMillis() >= m_nextRefreshMs.load())
+            {
+                Refresh();
+            }
+        }
+        else
+        {
+            std::unique_lock<std::mutex> locker(m_refreshMutex, std::try_to_lock);
+            if (locker.owns_lock() && DateTime::CurrentTimeMillis() >= m_nextRefreshMs.load())
+            {
+                Refresh();
+            }
+        }
+    }
+
+    return LoadAWSCredentialsSnapshot();
+}
+
+void RefreshingAWSCredentialsProvider::EnableBackgroundRefresh(const std::shared_ptr<AWSCredentialsRefreshScheduler>& scheduler, long prefetchWindowMs)
+{
+    std::lock_guard<std::mutex> locker(m_schedulerMutex);
+    if (m_scheduler)
+    {
+        m_scheduler->Cancel(this);
+    }
+
+    m_prefetchWindowMs = prefetchWindowMs;
+    m_scheduler = scheduler;
+    if (m_scheduler)
+    {
+        m_scheduler->Schedule(this, DateTime::CurrentTimeMillis());
+    }
+}
+
+void RefreshingAWSCredentialsProvider::DisableBackgroundRefresh()
+{
+    std::lock_guard<std::mutex> locker(m_schedulerMutex);
+    if (m_scheduler)
+    {
+        m_scheduler->Cancel(this);
+        m_scheduler = nullptr;
+    }
+}
+
+bool RefreshingAWSCredentialsProvider::Refresh()
+{
+    AWSCredentials credentials;
+    DateTime expiration;
+    auto now = DateTime::CurrentTimeMillis();
+
+    if (!FetchCredentials(credentials, expiration))
+    {
+        AWS_LOGSTREAM_DEBUG(REFRESHING_LOG_TAG, "Failed to load credentials, retrying in " << m_retryIntervalMs << " ms.");
+        m_nextRefreshMs = now + m_retryIntervalMs;
+        return false;
+    }
+
+    auto nextRefreshMs = now + m_refreshRateMs;
+    auto expirationMs = (std::numeric_limits<int64_t>::max)();
+    if (expiration.Millis() > 0)
+    {
+        expirationMs = expiration.Millis();
+        nextRefreshMs = (std::min)(nextRefreshMs, expirationMs - m_expirationWindowMs);
+    }
+
+    PublishAWSCredentialsSnapshot(Aws::MakeShared<AWSCredentials>(REFRESHING_LOG_TAG, std::move(credentials)));
+    m_expirationMs = expirationMs;
+    m_nextRefreshMs = nextRefreshMs;
+    return true;
+}
+
+int64_t RefreshingAWSCredentialsProvider::RefreshInBackground()
+{
+    bool refreshed = true;
+    {
+        std::lock_guard<std::mutex> locker(m_refreshMutex);
+        auto prefetchWindowMs = m_prefetchWindowMs.load();
+        auto now = DateTime::CurrentTimeMillis();
+        auto nextRefreshMs = m_nextRefreshMs.load();
+        if (nextRefreshMs - now <= prefetchWindowMs)
+        {
+            refreshed = Refresh();
+        }
+    }
+
+    auto now = DateTime::CurrentTimeMillis();
+    auto untilRefreshMs = m_nextRefreshMs.load() - now;
+    if (!refreshed || untilRefreshMs <= 0)
+    {
+        return now + (std::max)(static_cast<int64_t>(m_retryIntervalMs), MIN_BACKGROUND_RETRY_INTERVAL_MS);
+    }
+
+    //prefetch, but never spend more than half of the remaining lifetime of the credentials waiting for the refresh.
+    return now + untilRefreshMs - (std::min)(m_prefetchWindowMs.load(), untilRefreshMs / 2);
+}
+
 static Aws::String GetBaseDirectory()
 {
     return Aws::FileSystem::GetHomeDirectory();
@@ -144,9 +314,9 @@ static const char* PROFILE_LOG_TAG = "ProfileConfigFileAWSCredentialsProvider";
 
 
 ProfileConfigFileAWSCredentialsProvider::ProfileConfigFileAWSCredentialsProvider(long refreshRateMs) :
+        RefreshingAWSCredentialsProvider(refreshRateMs, refreshRateMs),
         m_configFileLoader(Aws::MakeShared<Aws::Config::AWSConfigFileProfileConfigLoader>(PROFILE_LOG_TAG, GetConfigProfileFilename(), true)),
-        m_credentialsFileLoader(Aws::MakeShared<Aws::Config::AWSConfigFileProfileConfigLoader>(PROFILE_LOG_TAG, GetCredentialsProfileFilename())),
-        m_loadFrequencyMs(refreshRateMs)
+        m_credentialsFileLoader(Aws::MakeShared<Aws::Config::AWSConfigFileProfileConfigLoader>(PROFILE_LOG_TAG, GetCredentialsProfileFilename()))
 {
     auto profileFromVar = Aws::Environment::GetEnv(AWS_PROFILE_ENVIRONMENT_VARIABLE);
     if (!profileFromVar.empty())
@@ -164,55 +334,53 @@ ProfileConfigFileAWSCredentialsProvider::ProfileConfigFileAWSCredentialsProvider
 }
 
 ProfileConfigFileAWSCredentialsProvider::ProfileConfigFileAWSCredentialsProvider(const char* profile, long refreshRateMs) :
+        RefreshingAWSCredentialsProvider(refreshRateMs, refreshRateMs),
         m_profileToUse(profile),
         m_configFileLoader(Aws::MakeShared<Aws::Config::AWSConfigFileProfileConfigLoader>(PROFILE_LOG_TAG, GetConfigProfileFilename(), true)),
-        m_credentialsFileLoader(Aws::MakeShared<Aws::Config::AWSConfigFileProfileConfigLoader>(PROFILE_LOG_TAG, GetCredentialsProfileFilename())),
-        m_loadFrequencyMs(refreshRateMs)
+        m_credentialsFileLoader(Aws::MakeShared<Aws::Config::AWSConfigFileProfileConfigLoader>(PROFILE_LOG_TAG, GetCredentialsProfileFilename()))
 {
     AWS_LOGSTREAM_INFO(PROFILE_LOG_TAG, "Setting provider to read credentials from " <<  GetCredentialsProfileFilename() << " for credentials file"
                                       << " and " <<  GetConfigProfileFilename() << " for the config file "
                                       << ", for use with profile " << m_profileToUse);
 }
 
-AWSCredentials ProfileConfigFileAWSCredentialsProvider::GetAWSCredentials()
+ProfileConfigFileAWSCredentialsProvider::~ProfileConfigFileAWSCredentialsProvider()
 {
-    RefreshIfExpired();
+    DisableBackgroundRefresh();
+}
+
+bool ProfileConfigFileAWSCredentialsProvider::FetchCredentials(AWSCredentials& credentials, DateTime& expiration)
+{
+    AWS_UNREFERENCED_PARAM(expiration);
+
+    //fall-back to config file.
+    if(!m_credentialsFileLoader->Load())
+    {
+        m_configFileLoader->Load();
+    }
+
     auto credsFileProfileIter = m_credentialsFileLoader->GetProfiles().find(m_profileToUse);
 
     if(credsFileProfileIter != m_credentialsFileLoader->GetProfiles().end())
     {
-        return credsFileProfileIter->second.GetCredentials();
+        credentials = credsFileProfileIter->second.GetCredentials();
+        return true;
     }
 
     auto configFileProfileIter = m_configFileLoader->GetProfiles().find(m_profileToUse);
     if(configFileProfileIter != m_configFileLoader->GetProfiles().end())
     {
-        return configFileProfileIter->second.GetCredentials();
+        credentials = configFileProfileIter->second.GetCredentials();
     }
 
-    return AWSCredentials();
-}
-
-
-void ProfileConfigFileAWSCredentialsProvider::RefreshIfExpired()
-{
-    std::lock_guard<std::mutex> locker(m_reloadMutex);
-
-    if (IsTimeToRefresh(m_loadFrequencyMs))
-    {
-        //fall-back to config file.
-        if(!m_credentialsFileLoader->Load())
-        {
-            m_configFileLoader->Load();
-        }
-    }
+    return true;
 }
 
 static const char* INSTANCE_LOG_TAG = "InstanceProfileCredentialsProvider";
 
 InstanceProfileCredentialsProvider::InstanceProfileCredentialsProvider(long refreshRateMs) :
-        m_ec2MetadataConfigLoader(Aws::MakeShared<Aws::Config::EC2InstanceProfileConfigLoader>(INSTANCE_LOG_TAG)),
-        m_loadFrequencyMs(refreshRateMs)
+        RefreshingAWSCredentialsProvider(refreshRateMs, refreshRateMs),
+        m_ec2MetadataConfigLoader(Aws::MakeShared<Aws::Config::EC2InstanceProfileConfigLoader>(INSTANCE_LOG_TAG))
 {
     AWS_LOGSTREAM_INFO(INSTANCE_LOG_TAG, "Creating Instance with default EC2MetadataClient and refresh rate " << refreshRateMs);
 }
@@ -220,37 +388,36 @@ InstanceProfileCredentialsProvider::InstanceProfileCredentialsProvider(long refr
 
 InstanceProfileCredentialsProvider::InstanceProfileCredentialsProvider(const std::shared_ptr<Aws::Config::EC2InstanceProfileConfigLoader>& loader,
                                                                        long refreshRateMs) :
-        m_ec2MetadataConfigLoader(loader),
-        m_loadFrequencyMs(refreshRateMs)
+        RefreshingAWSCredentialsProvider(refreshRateMs, refreshRateMs),
+        m_ec2MetadataConfigLoader(loader)
 {
     AWS_LOGSTREAM_INFO(INSTANCE_LOG_TAG, "Creating Instance with injected EC2MetadataClient and refresh rate " << refreshRateMs);
 }
 
 
-AWSCredentials InstanceProfileCredentialsProvider::GetAWSCredentials()
+InstanceProfileCredentialsProvider::~InstanceProfileCredentialsProvider()
 {
-    RefreshIfExpired();
-    auto profileIter = m_ec2MetadataConfigLoader->GetProfiles().find(Aws::Config::INSTANCE_PROFILE_KEY);
-
-    if(profileIter != m_ec2MetadataConfigLoader->GetProfiles().end())
-    {
-        return profileIter->second.GetCredentials();
-    }
-
-    return AWSCredentials();
+    DisableBackgroundRefresh();
 }
 
-
-void InstanceProfileCredentialsProvider::RefreshIfExpired()
+bool InstanceProfileCredentialsProvider::FetchCredentials(AWSCredentials& credentials, DateTime& expiration)
 {
-    AWS_LOGSTREAM_DEBUG(INSTANCE_LOG_TAG, "Checking if latest credential pull has expired.");
+    AWS_UNREFERENCED_PARAM(expiration);
 
-    std::lock_guard<std::mutex> locker(m_reloadMutex);
-    if (IsTimeToRefresh(m_loadFrequencyMs))
+    AWS_LOGSTREAM_INFO(INSTANCE_LOG_TAG, "Credentials are due for refresh, attempting to repull from EC2 Metadata Service.");
+    if (!m_ec2MetadataConfigLoader->Load())
+    {
+        return false;
+    }
+
+    auto profileIter = m_ec2MetadataConfigLoader->GetProfiles().find(Aws::Config::INSTANCE_PROFILE_KEY);
+    if(profileIter == m_ec2MetadataConfigLoader->GetProfiles().end())
     {
-        AWS_LOGSTREAM_INFO(INSTANCE_LOG_TAG, "Credentials have expired attempting to repull from EC2 Metadata Service.");
-        m_ec2MetadataConfigLoader->Load();
+        return false;
     }
+
+    credentials = profileIter->second.GetCredentials();
+    return true;
 }
 
 static const char* TASK_ROLE_LOG_TAG = "TaskRoleCredentialsProvider";
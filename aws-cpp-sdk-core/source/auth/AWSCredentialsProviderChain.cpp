@@ -21,18 +21,41 @@ using namespace Aws::Auth;
 
 static const char* AWS_ECS_CREDENTIALS_ENVIRONMENT_VARIABLE = "AWS_CONTAINER_CREDENTIALS_RELATIVE_URI";
 
+static const char* CredentialsProviderChainTag = "AWSCredentialsProviderChain";
+
 AWSCredentials AWSCredentialsProviderChain::GetAWSCredentials()
 {
-    for (auto credentialsProvider : m_providerChain)
+    return *GetAWSCredentialsSnapshot();
+}
+
+std::shared_ptr<const AWSCredentials> AWSCredentialsProviderChain::GetAWSCredentialsSnapshot()
+{
+    std::shared_ptr<const AWSCredentials> credentials;
+    for (const auto& credentialsProvider : m_providerChain)
     {
-        AWSCredentials credentials = credentialsProvider->GetAWSCredentials();
-        if (!credentials.GetAWSAccessKeyId().empty() && !credentials.GetAWSSecretKey().empty())
+        credentials = credentialsProvider->GetAWSCredentialsSnapshot();
+        if (!credentials->GetAWSAccessKeyId().empty() && !credentials->GetAWSSecretKey().empty())
         {
-            return credentials;
+            break;
         }
+        credentials = nullptr;
     }
 
-    return AWSCredentials("", "");
+    auto snapshot = LoadAWSCredentialsSnapshot();
+    if (!credentials)
+    {
+        if (snapshot && snapshot->GetAWSAccessKeyId().empty() && snapshot->GetAWSSecretKey().empty())
+        {
+            return snapshot;
+        }
+        credentials = Aws::MakeShared<AWSCredentials>(CredentialsProviderChainTag, "", "");
+    }
+
+    if (credentials != snapshot)
+    {
+        PublishAWSCredentialsSnapshot(credentials);
+    }
+    return credentials;
 }
 
 static const char* DefaultCredentialsProviderChainTag = "DefaultAWSCredentialsProviderChain";
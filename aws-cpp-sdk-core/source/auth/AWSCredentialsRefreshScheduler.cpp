@@ -0,0 +1,105 @@
+/*
+* Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+*
+* Licensed under the Apache License, Version 2.0 (the "License").
+* You may not use this file except in compliance with the License.
+* A copy of the License is located at
+*
+*  http://aws.amazon.com/apache2.0
+*
+* or in the "license" file accompanying this file. This file is distributed
+* on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+* express or implied. See the License for the specific language governing
+* permissions and limitations under the License.
+*/
+
+#include <aws/core/auth/AWSCredentialsRefreshScheduler.h>
+#include <aws/core/auth/AWSCredentialsProvider.h>
+#include <aws/core/utils/DateTime.h>
+
+using namespace Aws::Auth;
+using namespace Aws::Utils;
+
+AWSCredentialsRefreshScheduler::AWSCredentialsRefreshScheduler() :
+    m_refreshing(nullptr),
+    m_refreshCancelled(false),
+    m_continue(true)
+{
+    m_thread = std::thread(&AWSCredentialsRefreshScheduler::Run, this);
+}
+
+AWSCredentialsRefreshScheduler::~AWSCredentialsRefreshScheduler()
+{
+    {
+        std::lock_guard<std::mutex> locker(m_lock);
+        m_continue = false;
+        m_dueTimes.clear();
+    }
+    m_signal.notify_all();
+    m_thread.join();
+}
+
+void AWSCredentialsRefreshScheduler::Schedule(RefreshingAWSCredentialsProvider* provider, int64_t dueMs)
+{
+    {
+        std::lock_guard<std::mutex> locker(m_lock);
+        m_dueTimes[provider] = dueMs;
+    }
+    m_signal.notify_all();
+}
+
+void AWSCredentialsRefreshScheduler::Cancel(RefreshingAWSCredentialsProvider* provider)
+{
+    std::unique_lock<std::mutex> locker(m_lock);
+    m_dueTimes.erase(provider);
+    if (m_refreshing == provider)
+    {
+        m_refreshCancelled = true;
+        m_signal.wait(locker, [this, provider] { return m_refreshing != provider; });
+    }
+}
+
+void AWSCredentialsRefreshScheduler::Run()
+{
+    std::unique_lock<std::mutex> locker(m_lock);
+    while (m_continue)
+    {
+        if (m_dueTimes.empty())
+        {
+            m_signal.wait(locker);
+            continue;
+        }
+
+        auto next = m_dueTimes.begin();
+        for (auto iter = m_dueTimes.begin(); iter != m_dueTimes.end(); ++iter)
+        {
+            if (iter->second < next->second)
+            {
+                next = iter;
+            }
+        }
+
+        auto now = DateTime::CurrentTimeMillis();
+        if (next->second > now)
+        {
+            m_signal.wait_for(locker, std::chrono::milliseconds(next->second - now));
+            continue;
+        }
+
+        auto provider = next->first;
+        m_dueTimes.erase(next);
+        m_refreshing = provider;
+        m_refreshCancelled = false;
+        locker.unlock();
+
+        auto nextDueMs = provider->RefreshInBackground();
+
+        locker.lock();
+        if (!m_refreshCancelled && m_continue)
+        {
+            m_dueTimes[provider] = nextDueMs;
+        }
+        m_refreshing = nullptr;
+        m_signal.notify_all();
+    }
+}
@@ -20,6 +20,7 @@
 #include <aws/core/client/AWSErrorMarshaller.h>
 #include <aws/core/client/ClientConfiguration.h>
 #include <aws/core/client/CoreErrors.h>
+#include <aws/core/client/RequestMetrics.h>
 #include <aws/core/client/RetryStrategy.h>
 #include <aws/core/http/HttpClient.h>
 #include <aws/core/http/HttpClientFactory.h>
@@ -33,16 +34,16 @@
 #include <aws/core/utils/logging/LogMacros.h>
 #include <aws/core/Globals.h>
 #include <aws/core/utils/EnumParseOverflowContainer.h>
-#include <aws/core/utils/crypto/MD5.h>
+#include <aws/core/utils/crypto/MultiDigest.h>
 #include <thread>
 #include <aws/core/utils/HashingUtils.h>
-#include <aws/core/utils/crypto/Factories.h>
 #include <aws/core/http/URI.h>
 
 using namespace Aws;
 using namespace Aws::Client;
 using namespace Aws::Http;
 using namespace Aws::Utils;
+using namespace Aws::Utils::Crypto;
 using namespace Aws::Utils::Json;
 using namespace Aws::Utils::Xml;
 
@@ -50,6 +51,7 @@ static const int SUCCESS_RESPONSE_MIN = 200;
 static const int SUCCESS_RESPONSE_MAX = 299;
 
 static const char* AWS_CLIENT_LOG_TAG = "AWSClient";
+static const std::chrono::milliseconds SEND_TOKEN_POLL_INTERVAL(10);
 //4 Minutes
 static const std::chrono::milliseconds TIME_DIFF_MAX = std::chrono::minutes(4); 
 //-4 Minutes
@@ -57,6 +59,46 @@ static const std::chrono::milliseconds TIME_DIFF_MIN = std::chrono::minutes(-4);
 
 std::atomic<int> AWSClient::s_refCount(0);
 
+//the clock is only read for attempts whose metrics are collected, the others carry a default time_point that measures as no time.
+static std::chrono::steady_clock::time_point MetricsTimestamp(bool collecting)
+{
+    return collecting ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point();
+}
+
+static std::chrono::microseconds MicrosecondsSince(std::chrono::steady_clock::time_point start)
+{
+    if (start == std::chrono::steady_clock::time_point())
+    {
+        return std::chrono::microseconds(0);
+    }
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+}
+
+static void RecordAttemptOutcome(RequestAttemptMetrics* metrics, const std::shared_ptr<HttpResponse>& httpResponse,
+    const HttpResponseOutcome& outcome, std::chrono::steady_clock::time_point attemptStart)
+{
+    if (!metrics)
+    {
+        return;
+    }
+
+    metrics->success = outcome.IsSuccess();
+    metrics->responseCode = httpResponse ? httpResponse->GetResponseCode() : HttpResponseCode::REQUEST_NOT_MADE;
+    metrics->transferMetrics = httpResponse ? httpResponse->GetTransferMetrics() : HttpTransferMetrics();
+    metrics->payloadParseTime = std::chrono::microseconds(0);
+    metrics->totalTime = MicrosecondsSince(attemptStart);
+}
+
+static HttpResponseOutcome CancelledRequestOutcome()
+{
+    return HttpResponseOutcome(AWSError<CoreErrors>(CoreErrors::NETWORK_CONNECTION, "", "Request processing was disabled before the request could be sent", false));
+}
+
+static HttpResponseOutcome SigningFailedOutcome()
+{
+    return HttpResponseOutcome(AWSError<CoreErrors>(CoreErrors::CLIENT_SIGNING_FAILURE, "", "SDK failed to sign the request", false));
+}
+
 static CoreErrors GuessBodylessErrorType(Aws::Http::HttpResponseCode responseCode)
 {
     switch (responseCode)
@@ -118,7 +160,8 @@ AWSClient::AWSClient(const Aws::Client::ClientConfiguration& configuration,
     m_writeRateLimiter(configuration.writeRateLimiter),
     m_readRateLimiter(configuration.readRateLimiter),
     m_userAgent(configuration.userAgent),
-    m_hash(Aws::Utils::Crypto::CreateMD5Implementation())
+    m_requestMetricsCollector(configuration.requestMetricsCollector),
+    m_asyncAttemptsInFlight(0)
 {
     if (signer) 
     {
@@ -138,7 +181,8 @@ AWSClient::AWSClient(const Aws::Client::ClientConfiguration& configuration,
     m_writeRateLimiter(configuration.writeRateLimiter),
     m_readRateLimiter(configuration.readRateLimiter),
     m_userAgent(configuration.userAgent),
-    m_hash(Aws::Utils::Crypto::CreateMD5Implementation())
+    m_requestMetricsCollector(configuration.requestMetricsCollector),
+    m_asyncAttemptsInFlight(0)
 {
     InitializeGlobalStatics();
 }
@@ -146,9 +190,34 @@ AWSClient::AWSClient(const Aws::Client::ClientConfiguration& configuration,
 
 AWSClient::~AWSClient()
 {
+    ShutdownAsyncAttempts();
     CleanupGlobalStatics();
 }
 
+void AWSClient::ShutdownAsyncAttempts()
+{
+    std::unique_lock<std::mutex> locker(m_asyncAttemptsLock);
+    if (m_asyncAttemptsInFlight == 0)
+    {
+        return;
+    }
+
+    AWS_LOGSTREAM_DEBUG(AWS_CLIENT_LOG_TAG, "Cancelling " << m_asyncAttemptsInFlight << " async requests still in flight.");
+    locker.unlock();
+    m_httpClient->DisableRequestProcessing();
+    locker.lock();
+    m_asyncAttemptsSignal.wait(locker, [this]() { return m_asyncAttemptsInFlight == 0; });
+}
+
+void AWSClient::FinishAsyncAttempt() const
+{
+    std::lock_guard<std::mutex> locker(m_asyncAttemptsLock);
+    if (--m_asyncAttemptsInFlight == 0)
+    {
+        m_asyncAttemptsSignal.notify_all();
+    }
+}
+
 void AWSClient::DisableRequestProcessing() 
 { 
     m_httpClient->DisableRequestProcessing(); 
@@ -174,100 +243,278 @@ Aws::Client::AWSAuthSigner* AWSClient::GetSignerByName(const char* name) const
     }
 }
 
+void AWSClient::RequestBookkeeping(const HttpResponseOutcome& outcome, long retries, const AWSError<CoreErrors>& lastError) const
+{
+    if (retries == 0)
+    {
+        m_retryStrategy->RequestBookkeeping(outcome);
+    }
+    else
+    {
+        m_retryStrategy->RequestBookkeeping(outcome, lastError);
+    }
+}
+
+void AWSClient::ReportRequestAttempt(const RequestAttemptMetrics* metrics, RequestAttemptMetrics* finalAttemptMetrics) const
+{
+    if (!metrics)
+    {
+        return;
+    }
+
+    if (finalAttemptMetrics)
+    {
+        *finalAttemptMetrics = *metrics;
+        return;
+    }
+
+    m_requestMetricsCollector->OnAttemptCompleted(*metrics);
+}
+
 HttpResponseOutcome AWSClient::AttemptExhaustively(const Aws::Http::URI& uri,
     const Aws::AmazonWebServiceRequest& request,
     HttpMethod method,
-    const char* signerName) const
+    const char* signerName,
+    RequestAttemptMetrics* finalAttemptMetrics) const
 {
+    RequestAttemptMetrics attemptMetrics;
+    RequestAttemptMetrics* metrics = m_requestMetricsCollector ? &attemptMetrics : nullptr;
+    AWSError<CoreErrors> lastError;
     for (long retries = 0;; retries++)
     {
-        HttpResponseOutcome outcome = AttemptOneRequest(uri, request, method, signerName);
+        m_retryStrategy->GetSendToken();
+        attemptMetrics.attempt = retries;
+        HttpResponseOutcome outcome = AttemptOneRequest(uri, request, method, signerName, metrics);
+        RequestBookkeeping(outcome, retries, lastError);
         if (outcome.IsSuccess())
         {
             AWS_LOGSTREAM_TRACE(AWS_CLIENT_LOG_TAG, "Request successful returning.");
+            ReportRequestAttempt(metrics, finalAttemptMetrics);
             return outcome;
         }
         else if (!m_httpClient->IsRequestProcessingEnabled())
         {
             AWS_LOGSTREAM_TRACE(AWS_CLIENT_LOG_TAG, "Request was cancelled externally.");
+            ReportRequestAttempt(metrics, finalAttemptMetrics);
             return outcome;
         }
         else
         {
-            long sleepMillis = m_retryStrategy->CalculateDelayBeforeNextRetry(outcome.GetError(), retries);
-            auto signer = GetSignerByName(signerName);
-
-            //detect clock skew and try to correct.            
-            AWS_LOGSTREAM_WARN(AWS_CLIENT_LOG_TAG, "If the signature check failed. This could be because of a time skew. Attempting to adjust the signer.");
-            const Http::HeaderValueCollection& headers = outcome.GetError().GetResponseHeaders();
-            auto awsDateHeaderIter = headers.find(StringUtils::ToLower(Http::AWS_DATE_HEADER));
-            auto dateHeaderIter = headers.find(StringUtils::ToLower(Http::DATE_HEADER));
-
-            DateTime serverTime;
-            if (awsDateHeaderIter != headers.end())
+            long sleepMillis = 0;
+            if (!PrepareRetry(outcome, request, signerName, retries, sleepMillis))
             {
-                serverTime = DateTime(awsDateHeaderIter->second.c_str(), DateFormat::AutoDetect);
-            }
-            else if (dateHeaderIter != headers.end())
-            {
-                serverTime = DateTime(dateHeaderIter->second.c_str(), DateFormat::AutoDetect);
+                ReportRequestAttempt(metrics, finalAttemptMetrics);
+                return outcome;
             }
+            ReportRequestAttempt(metrics, nullptr);
+            lastError = outcome.GetError();
 
-            if (!serverTime.WasParseSuccessful() || serverTime == DateTime())
-            {
-               AWS_LOGSTREAM_DEBUG(AWS_CLIENT_LOG_TAG, "Date header was not found in the response, can't attempt to detect clock skew");
-               serverTime = signer->GetSigningTimestamp();
-            }
+            auto sleepStart = MetricsTimestamp(metrics != nullptr);
+            m_httpClient->RetryRequestSleep(std::chrono::milliseconds(sleepMillis));
+            attemptMetrics.retrySleepTime = MicrosecondsSince(sleepStart);
+        }
+    }
+}
 
-            AWS_LOGSTREAM_DEBUG(AWS_CLIENT_LOG_TAG, "Server time is " << serverTime.ToGmtString(DateFormat::RFC822) << ", while client time is " << DateTime::Now().ToGmtString(DateFormat::RFC822));
-            auto diff = DateTime::Diff(serverTime, signer->GetSigningTimestamp());
-            //only try again if clock skew was the cause of the error.
-            if(diff >= TIME_DIFF_MAX || diff <= TIME_DIFF_MIN)
-            {
-                diff = DateTime::Diff(serverTime, DateTime::Now());
-                AWS_LOGSTREAM_INFO(AWS_CLIENT_LOG_TAG, "Computed time difference as " << diff.count() << " milliseconds. Adjusting signer with the skew.");
-                signer->SetClockSkew(diff);
-                auto newError = AWSError<CoreErrors>(
-                        outcome.GetError().GetErrorType(), outcome.GetError().GetExceptionName(), outcome.GetError().GetMessage(), true);
-                newError.SetResponseHeaders(outcome.GetError().GetResponseHeaders());
-                newError.SetResponseCode(outcome.GetError().GetResponseCode());
-                outcome = newError;
-                //don't sleep at all if clock skew was the problem.
-                sleepMillis = 0;
-            }
+void AWSClient::AttemptExhaustivelyAsync(const Aws::Http::URI& uri,
+    const std::shared_ptr<const Aws::AmazonWebServiceRequest>& request,
+    HttpMethod method,
+    const char* signerName,
+    const HttpResponseOutcomeReceivedHandler& onCompleted) const
+{
+    {
+        std::lock_guard<std::mutex> locker(m_asyncAttemptsLock);
+        ++m_asyncAttemptsInFlight;
+    }
 
-            if (!m_retryStrategy->ShouldRetry(outcome.GetError(), retries)) return outcome;
+    //the attempt stops being tracked before the caller's handler runs, so a handler that releases the client does not wait on itself.
+    AttemptAsync(uri, request, method, signerName, 0, std::chrono::microseconds(0), AWSError<CoreErrors>(),
+        [this, onCompleted](const HttpResponseOutcome& outcome)
+    {
+        FinishAsyncAttempt();
+        onCompleted(outcome);
+    });
+}
 
-            AWS_LOGSTREAM_WARN(AWS_CLIENT_LOG_TAG, "Request failed, now waiting " << sleepMillis << " ms before attempting again.");
-            if(request.GetBody())
+//the parse time of async requests is not measured, the result is handed to the caller's handler right after the attempt is reported.
+void AWSClient::AttemptAsync(const Aws::Http::URI& uri,
+    const std::shared_ptr<const Aws::AmazonWebServiceRequest>& request,
+    HttpMethod method,
+    const char* signerName,
+    long retries,
+    std::chrono::microseconds retrySleepTime,
+    const AWSError<CoreErrors>& lastError,
+    const HttpResponseOutcomeReceivedHandler& onCompleted) const
+{
+    //waiting for a send token would block the event loop, so poll for it on a timer instead.
+    if (!m_retryStrategy->HasSendToken())
+    {
+        auto pollStart = MetricsTimestamp(m_requestMetricsCollector != nullptr);
+        m_httpClient->RetryRequestSleepAsync(SEND_TOKEN_POLL_INTERVAL,
+            [this, uri, request, method, signerName, retries, retrySleepTime, lastError, onCompleted, pollStart](bool cancelled)
+        {
+            if (cancelled)
             {
-                request.GetBody()->clear();
-                request.GetBody()->seekg(0);
+                AWS_LOGSTREAM_TRACE(AWS_CLIENT_LOG_TAG, "Request was cancelled while waiting for a send token.");
+                onCompleted(CancelledRequestOutcome());
+                return;
             }
+            AttemptAsync(uri, request, method, signerName, retries, retrySleepTime + MicrosecondsSince(pollStart), lastError, onCompleted);
+        });
+        return;
+    }
+
+    auto attemptStart = MetricsTimestamp(m_requestMetricsCollector != nullptr);
+    std::shared_ptr<RequestAttemptMetrics> metrics;
+    if (m_requestMetricsCollector)
+    {
+        metrics = Aws::MakeShared<RequestAttemptMetrics>(AWS_CLIENT_LOG_TAG);
+        metrics->attempt = retries;
+        metrics->retrySleepTime = retrySleepTime;
+    }
+
+    std::shared_ptr<HttpRequest> httpRequest = BuildAndSignHttpRequest(uri, *request, method, signerName, metrics.get());
+    if (!httpRequest)
+    {
+        HttpResponseOutcome outcome = SigningFailedOutcome();
+        RecordAttemptOutcome(metrics.get(), nullptr, outcome, attemptStart);
+        ReportRequestAttempt(metrics.get(), nullptr);
+        onCompleted(outcome);
+        return;
+    }
+
+    auto onResponse = [this, uri, request, method, signerName, retries, lastError, onCompleted, metrics, attemptStart](const std::shared_ptr<HttpRequest>&,
+        const std::shared_ptr<HttpResponse>& httpResponse)
+    {
+        HttpResponseOutcome outcome = BuildHttpResponseOutcome(httpResponse);
+        RequestBookkeeping(outcome, retries, lastError);
+        RecordAttemptOutcome(metrics.get(), httpResponse, outcome, attemptStart);
+        ReportRequestAttempt(metrics.get(), nullptr);
+        if (outcome.IsSuccess())
+        {
+            AWS_LOGSTREAM_TRACE(AWS_CLIENT_LOG_TAG, "Request successful returning.");
+            onCompleted(outcome);
+            return;
+        }
+        else if (!m_httpClient->IsRequestProcessingEnabled())
+        {
+            AWS_LOGSTREAM_TRACE(AWS_CLIENT_LOG_TAG, "Request was cancelled externally.");
+            onCompleted(outcome);
+            return;
+        }
+
+        long sleepMillis = 0;
+        if (!PrepareRetry(outcome, *request, signerName, retries, sleepMillis))
+        {
+            onCompleted(outcome);
+            return;
+        }
 
-            if (request.GetRequestRetryHandler())
+        auto sleepStart = MetricsTimestamp(metrics != nullptr);
+        AWSError<CoreErrors> retriedError = outcome.GetError();
+        m_httpClient->RetryRequestSleepAsync(std::chrono::milliseconds(sleepMillis),
+            [this, uri, request, method, signerName, retries, retriedError, onCompleted, sleepStart](bool cancelled)
+        {
+            if (cancelled)
             {
-                request.GetRequestRetryHandler()(request);
+                AWS_LOGSTREAM_TRACE(AWS_CLIENT_LOG_TAG, "Request was cancelled while waiting to be retried.");
+                onCompleted(CancelledRequestOutcome());
+                return;
             }
+            AttemptAsync(uri, request, method, signerName, retries + 1, MicrosecondsSince(sleepStart), retriedError, onCompleted);
+        });
+    };
 
-            m_httpClient->RetryRequestSleep(std::chrono::milliseconds(sleepMillis));
-        }
+    m_httpClient->MakeRequestAsync(httpRequest, onResponse, m_readRateLimiter.get(), m_writeRateLimiter.get());
+}
+
+bool AWSClient::PrepareRetry(HttpResponseOutcome& outcome, const Aws::AmazonWebServiceRequest& request, const char* signerName,
+    long retries, long& sleepMillis) const
+{
+    sleepMillis = m_retryStrategy->CalculateDelayBeforeNextRetry(outcome.GetError(), retries);
+    auto signer = GetSignerByName(signerName);
+
+    //detect clock skew and try to correct.            
+    AWS_LOGSTREAM_WARN(AWS_CLIENT_LOG_TAG, "If the signature check failed. This could be because of a time skew. Attempting to adjust the signer.");
+    const Http::HeaderValueCollection& headers = outcome.GetError().GetResponseHeaders();
+    auto awsDateHeaderIter = headers.find(StringUtils::ToLower(Http::AWS_DATE_HEADER));
+    auto dateHeaderIter = headers.find(StringUtils::ToLower(Http::DATE_HEADER));
+
+    DateTime serverTime;
+    if (awsDateHeaderIter != headers.end())
+    {
+        serverTime = DateTime(awsDateHeaderIter->second.c_str(), DateFormat::AutoDetect);
     }
+    else if (dateHeaderIter != headers.end())
+    {
+        serverTime = DateTime(dateHeaderIter->second.c_str(), DateFormat::AutoDetect);
+    }
+
+    if (!serverTime.WasParseSuccessful() || serverTime == DateTime())
+    {
+       AWS_LOGSTREAM_DEBUG(AWS_CLIENT_LOG_TAG, "Date header was not found in the response, can't attempt to detect clock skew");
+       serverTime = signer->GetSigningTimestamp();
+    }
+
+    AWS_LOGSTREAM_DEBUG(AWS_CLIENT_LOG_TAG, "Server time is " << serverTime.ToGmtString(DateFormat::RFC822) << ", while client time is " << DateTime::Now().ToGmtString(DateFormat::RFC822));
+    auto diff = DateTime::Diff(serverTime, signer->GetSigningTimestamp());
+    //only try again if clock skew was the cause of the error.
+    if(diff >= TIME_DIFF_MAX || diff <= TIME_DIFF_MIN)
+    {
+        diff = DateTime::Diff(serverTime, DateTime::Now());
+        AWS_LOGSTREAM_INFO(AWS_CLIENT_LOG_TAG, "Computed time difference as " << diff.count() << " milliseconds. Adjusting signer with the skew.");
+        signer->SetClockSkew(diff);
+        auto newError = AWSError<CoreErrors>(
+                outcome.GetError().GetErrorType(), outcome.GetError().GetExceptionName(), outcome.GetError().GetMessage(), true);
+        newError.SetResponseHeaders(outcome.GetError().GetResponseHeaders());
+        newError.SetResponseCode(outcome.GetError().GetResponseCode());
+        outcome = newError;
+        //don't sleep at all if clock skew was the problem.
+        sleepMillis = 0;
+    }
+
+    if (!m_retryStrategy->ShouldRetry(outcome.GetError(), retries)) return false;
+
+    AWS_LOGSTREAM_WARN(AWS_CLIENT_LOG_TAG, "Request failed, now waiting " << sleepMillis << " ms before attempting again.");
+    if(request.GetBody())
+    {
+        request.GetBody()->clear();
+        request.GetBody()->seekg(0);
+    }
+
+    if (request.GetRequestRetryHandler())
+    {
+        request.GetRequestRetryHandler()(request);
+    }
+
+    return true;
 }
 
-HttpResponseOutcome AWSClient::AttemptExhaustively(const Aws::Http::URI& uri, HttpMethod method, const char* signerName, const char* requestName) const
+HttpResponseOutcome AWSClient::AttemptExhaustively(const Aws::Http::URI& uri, HttpMethod method, const char* signerName, const char* requestName,
+    RequestAttemptMetrics* finalAttemptMetrics) const
 {
+    RequestAttemptMetrics attemptMetrics;
+    RequestAttemptMetrics* metrics = m_requestMetricsCollector ? &attemptMetrics : nullptr;
+    AWSError<CoreErrors> lastError;
     for (long retries = 0;; retries++)
     {
-        HttpResponseOutcome outcome = AttemptOneRequest(uri, method, signerName, requestName);
+        m_retryStrategy->GetSendToken();
+        attemptMetrics.attempt = retries;
+        HttpResponseOutcome outcome = AttemptOneRequest(uri, method, signerName, requestName, metrics);
+        RequestBookkeeping(outcome, retries, lastError);
         if (outcome.IsSuccess() || !m_retryStrategy->ShouldRetry(outcome.GetError(), retries))
         {
+            ReportRequestAttempt(metrics, finalAttemptMetrics);
             return outcome;
         }
         else
         {
+            ReportRequestAttempt(metrics, nullptr);
+            lastError = outcome.GetError();
             long sleepMillis = m_retryStrategy->CalculateDelayBeforeNextRetry(outcome.GetError(), retries);
+            auto sleepStart = MetricsTimestamp(metrics != nullptr);
             m_httpClient->RetryRequestSleep(std::chrono::milliseconds(sleepMillis));
+            attemptMetrics.retrySleepTime = MicrosecondsSince(sleepStart);
         }
     }
 }
@@ -281,24 +528,37 @@ static bool DoesResponseGenerateError(const std::shared_ptr<HttpResponse>& respo
 
 }
 
-HttpResponseOutcome AWSClient::AttemptOneRequest(const Aws::Http::URI& uri,
+std::shared_ptr<HttpRequest> AWSClient::BuildAndSignHttpRequest(const Aws::Http::URI& uri,
     const Aws::AmazonWebServiceRequest& request,
     HttpMethod method,
-    const char* signerName) const
+    const char* signerName,
+    RequestAttemptMetrics* metrics) const
 {
     std::shared_ptr<HttpRequest> httpRequest(CreateHttpRequest(uri, method, request.GetResponseStreamFactory()));
-    BuildHttpRequest(request, httpRequest);
     auto signer = GetSignerByName(signerName);
-    if (!signer->SignRequest(*httpRequest, request.SignBody()))
+    BuildHttpRequest(request, httpRequest, signer->HashesPayload(uri, request.SignBody()));
+    auto signingStart = MetricsTimestamp(metrics != nullptr);
+    bool signingSucceeded = signer->SignRequest(*httpRequest, request.SignBody());
+    if (metrics)
+    {
+        metrics->signingTime = MicrosecondsSince(signingStart);
+        //GetServiceRequestName() predates const correctness on requests, it only ever returns a literal.
+        metrics->requestName = const_cast<Aws::AmazonWebServiceRequest&>(request).GetServiceRequestName();
+        metrics->serviceName = signer->GetServiceName();
+    }
+
+    if (!signingSucceeded)
     {
         AWS_LOGSTREAM_ERROR(AWS_CLIENT_LOG_TAG, "Request signing failed. Returning error.");
-        return HttpResponseOutcome(); // TODO: make a real error when error revamp reaches branch (SIGNING_ERROR)
+        return nullptr;
     }
 
     AWS_LOGSTREAM_DEBUG(AWS_CLIENT_LOG_TAG, "Request Successfully signed");
-    std::shared_ptr<HttpResponse> httpResponse(
-        m_httpClient->MakeRequest(*httpRequest, m_readRateLimiter.get(), m_writeRateLimiter.get()));
+    return httpRequest;
+}
 
+HttpResponseOutcome AWSClient::BuildHttpResponseOutcome(const std::shared_ptr<HttpResponse>& httpResponse) const
+{
     if (DoesResponseGenerateError(httpResponse))
     {
         AWS_LOGSTREAM_DEBUG(AWS_CLIENT_LOG_TAG, "Request returned error. Attempting to generate appropriate error codes from response");
@@ -310,16 +570,50 @@ HttpResponseOutcome AWSClient::AttemptOneRequest(const Aws::Http::URI& uri,
     return HttpResponseOutcome(httpResponse);
 }
 
-HttpResponseOutcome AWSClient::AttemptOneRequest(const Aws::Http::URI& uri, HttpMethod method, const char* signerName, const char* requestName) const
+HttpResponseOutcome AWSClient::AttemptOneRequest(const Aws::Http::URI& uri,
+    const Aws::AmazonWebServiceRequest& request,
+    HttpMethod method,
+    const char* signerName,
+    RequestAttemptMetrics* metrics) const
 {
-    AWS_UNREFERENCED_PARAM(requestName);
+    auto attemptStart = MetricsTimestamp(metrics != nullptr);
+    std::shared_ptr<HttpRequest> httpRequest = BuildAndSignHttpRequest(uri, request, method, signerName, metrics);
+    if (!httpRequest)
+    {
+        HttpResponseOutcome outcome = SigningFailedOutcome();
+        RecordAttemptOutcome(metrics, nullptr, outcome, attemptStart);
+        return outcome;
+    }
+
+    std::shared_ptr<HttpResponse> httpResponse(
+        m_httpClient->MakeRequest(*httpRequest, m_readRateLimiter.get(), m_writeRateLimiter.get()));
+
+    HttpResponseOutcome outcome = BuildHttpResponseOutcome(httpResponse);
+    RecordAttemptOutcome(metrics, httpResponse, outcome, attemptStart);
+    return outcome;
+}
 
+HttpResponseOutcome AWSClient::AttemptOneRequest(const Aws::Http::URI& uri, HttpMethod method, const char* signerName, const char* requestName,
+    RequestAttemptMetrics* metrics) const
+{
+    auto attemptStart = MetricsTimestamp(metrics != nullptr);
     std::shared_ptr<HttpRequest> httpRequest(CreateHttpRequest(uri, method, Aws::Utils::Stream::DefaultResponseStreamFactoryMethod));
     auto signer = GetSignerByName(signerName);
-    if (!signer->SignRequest(*httpRequest))
+    auto signingStart = MetricsTimestamp(metrics != nullptr);
+    bool signingSucceeded = signer->SignRequest(*httpRequest);
+    if (metrics)
+    {
+        metrics->signingTime = MicrosecondsSince(signingStart);
+        metrics->requestName = requestName ? requestName : "";
+        metrics->serviceName = signer->GetServiceName();
+    }
+
+    if (!signingSucceeded)
     {
         AWS_LOGSTREAM_ERROR(AWS_CLIENT_LOG_TAG, "Request signing failed. Returning error.");
-        return HttpResponseOutcome(); // TODO: make a real error when error revamp reaches branch (SIGNING_ERROR)
+        HttpResponseOutcome outcome = SigningFailedOutcome();
+        RecordAttemptOutcome(metrics, nullptr, outcome, attemptStart);
+        return outcome;
     }
 
     //user agent and headers like that shouldn't be signed for the sake of compatibility with proxies which MAY mutate that header.
@@ -329,15 +623,9 @@ HttpResponseOutcome AWSClient::AttemptOneRequest(const Aws::Http::URI& uri, Http
     std::shared_ptr<HttpResponse> httpResponse(
         m_httpClient->MakeRequest(*httpRequest, m_readRateLimiter.get(), m_writeRateLimiter.get()));
 
-    if (DoesResponseGenerateError(httpResponse))
-    {
-        AWS_LOGSTREAM_DEBUG(AWS_CLIENT_LOG_TAG, "Request returned error. Attempting to generate appropriate error codes from response");
-        return HttpResponseOutcome(BuildAWSError(httpResponse));
-    }
-
-    AWS_LOGSTREAM_DEBUG(AWS_CLIENT_LOG_TAG, "Request returned successful response.");
-
-    return HttpResponseOutcome(httpResponse);
+    HttpResponseOutcome outcome = BuildHttpResponseOutcome(httpResponse);
+    RecordAttemptOutcome(metrics, httpResponse, outcome, attemptStart);
+    return outcome;
 }
 
 StreamOutcome AWSClient::MakeRequestWithUnparsedResponse(const Aws::Http::URI& uri,
@@ -383,7 +671,7 @@ void AWSClient::AddHeadersToRequest(const std::shared_ptr<Aws::Http::HttpRequest
 }
 
 void AWSClient::AddContentBodyToRequest(const std::shared_ptr<Aws::Http::HttpRequest>& httpRequest,
-    const std::shared_ptr<Aws::IOStream>& body, bool needsContentMd5) const
+    const std::shared_ptr<Aws::IOStream>& body, bool needsContentMd5, bool hashPayload) const
 {
     httpRequest->AddContentBody(body);
 
@@ -422,30 +710,40 @@ void AWSClient::AddContentBodyToRequest(const std::shared_ptr<Aws::Http::HttpReq
         AWS_LOGSTREAM_TRACE(AWS_CLIENT_LOG_TAG, "Found body, and content-md5 needs to be set" <<
             ", attempting to compute content-md5");
 
-        //changing the internal state of the hash computation is not a logical state
-        //change as far as constness goes for this class. Due to the platform specificness
-        //of hash computations, we can't control the fact that computing a hash mutates
-        //state on some platforms such as windows (but that isn't a concern of this class.
-        auto md5HashResult = const_cast<AWSClient*>(this)->m_hash->Calculate(*body);
+        //when the signer is going to hash the same body with sha256 to sign the payload, compute both digests in one read of the body
+        //and keep the sha256 on the request for the signer.
+        MultiDigest digests;
+        digests.AddAlgorithm(DigestAlgorithm::MD5);
+        if (hashPayload)
+        {
+            digests.AddAlgorithm(DigestAlgorithm::SHA256);
+        }
+        bool digestsComputed = digests.Calculate(*body);
         body->clear();
-        if (md5HashResult.IsSuccess())
+        if (digestsComputed)
         {
-            httpRequest->SetHeaderValue(Http::CONTENT_MD5_HEADER, HashingUtils::Base64Encode(md5HashResult.GetResult()));
+            httpRequest->SetHeaderValue(Http::CONTENT_MD5_HEADER, HashingUtils::Base64Encode(digests.GetDigest(DigestAlgorithm::MD5)));
+            httpRequest->SetContentBodyDigest(DigestAlgorithm::MD5, digests.GetDigest(DigestAlgorithm::MD5));
+            if (hashPayload)
+            {
+                httpRequest->SetContentBodyDigest(DigestAlgorithm::SHA256, digests.GetDigest(DigestAlgorithm::SHA256));
+            }
         }
     }
 }
 
 void AWSClient::BuildHttpRequest(const Aws::AmazonWebServiceRequest& request,
-    const std::shared_ptr<HttpRequest>& httpRequest) const
+    const std::shared_ptr<HttpRequest>& httpRequest, bool hashPayload) const
 {
     //do headers first since the request likely will set content-length as it's own header.
     AddHeadersToRequest(httpRequest, request.GetHeaders());
-    AddContentBodyToRequest(httpRequest, request.GetBody(), request.ShouldComputeContentMd5());
+    AddContentBodyToRequest(httpRequest, request.GetBody(), request.ShouldComputeContentMd5(), hashPayload);
 
     // Pass along handlers for processing data sent/received in bytes
     httpRequest->SetDataReceivedEventHandler(request.GetDataReceivedEventHandler());
     httpRequest->SetDataSentEventHandler(request.GetDataSentEventHandler());
     httpRequest->SetContinueRequestHandle(request.GetContinueRequestHandler());
+    httpRequest->SetResponseBodySinkFactory(request.GetResponseBodySinkFactory());
 
     request.AddQueryStringParameters(httpRequest->GetUri());
 }
@@ -549,6 +847,57 @@ std::shared_ptr<Aws::Http::HttpRequest> AWSClient::ConvertToRequestForPresigning
 
 
 ////////////////////////////////////////////////////////////////////////////
+//withholds the final attempt from AttemptExhaustively and reports it, payload parse time included, when MakeRequest returns.
+class FinalAttemptReporter
+{
+public:
+    FinalAttemptReporter(const std::shared_ptr<RequestMetricsCollector>& collector) : m_collector(collector.get()) {}
+
+    ~FinalAttemptReporter()
+    {
+        if (m_collector)
+        {
+            m_metrics.payloadParseTime = MicrosecondsSince(m_parseStart);
+            m_metrics.totalTime += m_metrics.payloadParseTime;
+            m_collector->OnAttemptCompleted(m_metrics);
+        }
+    }
+
+    RequestAttemptMetrics* GetMetrics() { return m_collector ? &m_metrics : nullptr; }
+
+    void StartPayloadParse() { m_parseStart = MetricsTimestamp(m_collector != nullptr); }
+
+private:
+    RequestMetricsCollector* m_collector;
+    RequestAttemptMetrics m_metrics;
+    std::chrono::steady_clock::time_point m_parseStart;
+};
+
+//parses the body in place when the response was written into a contiguous sink, otherwise reads it from the body stream.
+static JsonValue ParseJsonBody(const HttpResponse& httpResponse)
+{
+    const char* data = nullptr;
+    auto bodySink = httpResponse.GetResponseBodySink();
+    if (bodySink && bodySink->GetContiguousData(data))
+    {
+        return JsonValue(data, bodySink->GetSize());
+    }
+
+    return JsonValue(httpResponse.GetResponseBody());
+}
+
+static XmlDocument ParseXmlBody(const HttpResponse& httpResponse)
+{
+    const char* data = nullptr;
+    auto bodySink = httpResponse.GetResponseBodySink();
+    if (bodySink && bodySink->GetContiguousData(data))
+    {
+        return XmlDocument::CreateFromXmlBuffer(data, bodySink->GetSize());
+    }
+
+    return XmlDocument::CreateFromXmlStream(httpResponse.GetResponseBody());
+}
+
 AWSJsonClient::AWSJsonClient(const Aws::Client::ClientConfiguration& configuration,
     const std::shared_ptr<Aws::Client::AWSAuthSigner>& signer,
     const std::shared_ptr<AWSErrorMarshaller>& errorMarshaller) :
@@ -563,13 +912,20 @@ AWSJsonClient::AWSJsonClient(const Aws::Client::ClientConfiguration& configurati
 {
 }
 
+AWSJsonClient::~AWSJsonClient()
+{
+    ShutdownAsyncAttempts();
+}
+
 
 JsonOutcome AWSJsonClient::MakeRequest(const Aws::Http::URI& uri,
     const Aws::AmazonWebServiceRequest& request,
     Http::HttpMethod method,
     const char* signerName) const
 {
-    HttpResponseOutcome httpOutcome(BASECLASS::AttemptExhaustively(uri, request, method, signerName));
+    FinalAttemptReporter finalAttempt(GetRequestMetricsCollector());
+    HttpResponseOutcome httpOutcome(BASECLASS::AttemptExhaustively(uri, request, method, signerName, finalAttempt.GetMetrics()));
+    finalAttempt.StartPayloadParse();
     if (!httpOutcome.IsSuccess())
     {
         return JsonOutcome(httpOutcome.GetError());
@@ -577,7 +933,7 @@ JsonOutcome AWSJsonClient::MakeRequest(const Aws::Http::URI& uri,
 
     if (httpOutcome.GetResult()->GetResponseBody().tellp() > 0)
         //this is stupid, but gcc doesn't pick up the covariant on the dereference so we have to give it a little hint.
-        return JsonOutcome(AmazonWebServiceResult<JsonValue>(JsonValue(httpOutcome.GetResult()->GetResponseBody()),
+        return JsonOutcome(AmazonWebServiceResult<JsonValue>(ParseJsonBody(*httpOutcome.GetResult()),
         httpOutcome.GetResult()->GetHeaders(),
         httpOutcome.GetResult()->GetResponseCode()));
 
@@ -585,12 +941,39 @@ JsonOutcome AWSJsonClient::MakeRequest(const Aws::Http::URI& uri,
         return JsonOutcome(AmazonWebServiceResult<JsonValue>(JsonValue(), httpOutcome.GetResult()->GetHeaders()));
 }
 
+void AWSJsonClient::MakeRequestAsync(const Aws::Http::URI& uri,
+    const std::shared_ptr<const Aws::AmazonWebServiceRequest>& request,
+    const JsonOutcomeReceivedHandler& onCompleted,
+    Http::HttpMethod method,
+    const char* signerName) const
+{
+    BASECLASS::AttemptExhaustivelyAsync(uri, request, method, signerName, [onCompleted](const HttpResponseOutcome& httpOutcome)
+    {
+        if (!httpOutcome.IsSuccess())
+        {
+            onCompleted(JsonOutcome(httpOutcome.GetError()));
+        }
+        else if (httpOutcome.GetResult()->GetResponseBody().tellp() > 0)
+        {
+            onCompleted(JsonOutcome(AmazonWebServiceResult<JsonValue>(ParseJsonBody(*httpOutcome.GetResult()),
+                httpOutcome.GetResult()->GetHeaders(),
+                httpOutcome.GetResult()->GetResponseCode())));
+        }
+        else
+        {
+            onCompleted(JsonOutcome(AmazonWebServiceResult<JsonValue>(JsonValue(), httpOutcome.GetResult()->GetHeaders())));
+        }
+    });
+}
+
 JsonOutcome AWSJsonClient::MakeRequest(const Aws::Http::URI& uri,
     Http::HttpMethod method,
     const char* signerName,
     const char* requestName) const
 {
-    HttpResponseOutcome httpOutcome(BASECLASS::AttemptExhaustively(uri, method, signerName, requestName));
+    FinalAttemptReporter finalAttempt(GetRequestMetricsCollector());
+    HttpResponseOutcome httpOutcome(BASECLASS::AttemptExhaustively(uri, method, signerName, requestName, finalAttempt.GetMetrics()));
+    finalAttempt.StartPayloadParse();
     if (!httpOutcome.IsSuccess())
     {
         return JsonOutcome(httpOutcome.GetError());
@@ -598,7 +981,7 @@ JsonOutcome AWSJsonClient::MakeRequest(const Aws::Http::URI& uri,
 
     if (httpOutcome.GetResult()->GetResponseBody().tellp() > 0)
     {
-        JsonValue jsonValue(httpOutcome.GetResult()->GetResponseBody());
+        JsonValue jsonValue(ParseJsonBody(*httpOutcome.GetResult()));
         if (!jsonValue.WasParseSuccessful())
         {
             return JsonOutcome(AWSError<CoreErrors>(CoreErrors::UNKNOWN, "Json Parser Error", jsonValue.GetErrorMessage(), false));
@@ -670,12 +1053,19 @@ AWSXMLClient::AWSXMLClient(const Aws::Client::ClientConfiguration& configuration
 {
 }
 
+AWSXMLClient::~AWSXMLClient()
+{
+    ShutdownAsyncAttempts();
+}
+
 XmlOutcome AWSXMLClient::MakeRequest(const Aws::Http::URI& uri,
     const Aws::AmazonWebServiceRequest& request,
     Http::HttpMethod method,
     const char* signerName) const
 {
-    HttpResponseOutcome httpOutcome(BASECLASS::AttemptExhaustively(uri, request, method, signerName));
+    FinalAttemptReporter finalAttempt(GetRequestMetricsCollector());
+    HttpResponseOutcome httpOutcome(BASECLASS::AttemptExhaustively(uri, request, method, signerName, finalAttempt.GetMetrics()));
+    finalAttempt.StartPayloadParse();
     if (!httpOutcome.IsSuccess())
     {
         return XmlOutcome(httpOutcome.GetError());
@@ -683,7 +1073,7 @@ XmlOutcome AWSXMLClient::MakeRequest(const Aws::Http::URI& uri,
 
     if (httpOutcome.GetResult()->GetResponseBody().tellp() > 0)
     {
-        XmlDocument xmlDoc = XmlDocument::CreateFromXmlStream(httpOutcome.GetResult()->GetResponseBody());
+        XmlDocument xmlDoc = ParseXmlBody(*httpOutcome.GetResult());
 
         if (!xmlDoc.WasParseSuccessful())
         {
@@ -698,12 +1088,48 @@ XmlOutcome AWSXMLClient::MakeRequest(const Aws::Http::URI& uri,
     return XmlOutcome(AmazonWebServiceResult<XmlDocument>(XmlDocument(), httpOutcome.GetResult()->GetHeaders()));
 }
 
+void AWSXMLClient::MakeRequestAsync(const Aws::Http::URI& uri,
+    const std::shared_ptr<const Aws::AmazonWebServiceRequest>& request,
+    const XmlOutcomeReceivedHandler& onCompleted,
+    Http::HttpMethod method,
+    const char* signerName) const
+{
+    BASECLASS::AttemptExhaustivelyAsync(uri, request, method, signerName, [onCompleted](const HttpResponseOutcome& httpOutcome)
+    {
+        if (!httpOutcome.IsSuccess())
+        {
+            onCompleted(XmlOutcome(httpOutcome.GetError()));
+            return;
+        }
+
+        if (httpOutcome.GetResult()->GetResponseBody().tellp() > 0)
+        {
+            XmlDocument xmlDoc = ParseXmlBody(*httpOutcome.GetResult());
+
+            if (!xmlDoc.WasParseSuccessful())
+            {
+                AWS_LOGSTREAM_ERROR(AWS_CLIENT_LOG_TAG, "Xml parsing for error failed with message " << xmlDoc.GetErrorMessage().c_str());
+                onCompleted(XmlOutcome(AWSError<CoreErrors>(CoreErrors::UNKNOWN, "Xml Parse Error", xmlDoc.GetErrorMessage(), false)));
+                return;
+            }
+
+            onCompleted(XmlOutcome(AmazonWebServiceResult<XmlDocument>(std::move(xmlDoc),
+                httpOutcome.GetResult()->GetHeaders(), httpOutcome.GetResult()->GetResponseCode())));
+            return;
+        }
+
+        onCompleted(XmlOutcome(AmazonWebServiceResult<XmlDocument>(XmlDocument(), httpOutcome.GetResult()->GetHeaders())));
+    });
+}
+
 XmlOutcome AWSXMLClient::MakeRequest(const Aws::Http::URI& uri,
     Http::HttpMethod method,
     const char* signerName,
     const char* requestName) const
 {
-    HttpResponseOutcome httpOutcome(BASECLASS::AttemptExhaustively(uri, method, signerName, requestName));
+    FinalAttemptReporter finalAttempt(GetRequestMetricsCollector());
+    HttpResponseOutcome httpOutcome(BASECLASS::AttemptExhaustively(uri, method, signerName, requestName, finalAttempt.GetMetrics()));
+    finalAttempt.StartPayloadParse();
     if (!httpOutcome.IsSuccess())
     {
         return XmlOutcome(httpOutcome.GetError());
@@ -712,7 +1138,7 @@ XmlOutcome AWSXMLClient::MakeRequest(const Aws::Http::URI& uri,
     if (httpOutcome.GetResult()->GetResponseBody().tellp() > 0)
     {
         return XmlOutcome(AmazonWebServiceResult<XmlDocument>(
-            XmlDocument::CreateFromXmlStream(httpOutcome.GetResult()->GetResponseBody()),
+            ParseXmlBody(*httpOutcome.GetResult()),
             httpOutcome.GetResult()->GetHeaders(), httpOutcome.GetResult()->GetResponseCode()));
     }
 
@@ -0,0 +1,254 @@
+/*
+  * Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+  * 
+  * Licensed under the Apache License, Version 2.0 (the "License").
+  * You may not use this file except in compliance with the License.
+  * A copy of the License is located at
+  * 
+  *  http://aws.amazon.com/apache2.0
+  * 
+  * or in the "license" file accompanying this file. This file is distributed
+  * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+  * express or implied. See the License for the specific language governing
+  * permissions and limitations under the License.
+  */
+
+#include <aws/core/client/AdaptiveRetryStrategy.h>
+
+#include <aws/core/client/AWSError.h>
+#include <aws/core/client/CoreErrors.h>
+#include <aws/core/http/HttpResponse.h>
+#include <aws/core/utils/Outcome.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <thread>
+
+using namespace Aws;
+using namespace Aws::Client;
+
+static const double MIN_FILL_RATE = 0.5;
+static const double MIN_CAPACITY = 1;
+static const double SMOOTH = 0.8;
+static const double BETA = 0.7;
+static const double SCALE_CONSTANT = 0.4;
+
+static const char* THROTTLING_EXCEPTIONS[] =
+{
+    "Throttling",
+    "ThrottlingException",
+    "ThrottledException",
+    "RequestThrottledException",
+    "TooManyRequestsException",
+    "ProvisionedThroughputExceededException",
+    "TransactionInProgressException",
+    "RequestLimitExceeded",
+    "BandwidthLimitExceeded",
+    "LimitExceededException",
+    "RequestThrottled",
+    "SlowDown",
+    "PriorRequestNotComplete",
+    "EC2ThrottledException"
+};
+
+RetryTokenBucket::RetryTokenBucket() :
+    m_epoch(std::chrono::steady_clock::now()),
+    m_fillRate(0),
+    m_maxCapacity(0),
+    m_currentCapacity(0),
+    m_lastTimestamp(0),
+    m_measuredTxRate(0),
+    m_lastTxRateBucket(0),
+    m_requestCount(0),
+    m_lastMaxRate(0),
+    m_lastThrottleTime(0),
+    m_timeWindow(0),
+    m_enabled(false)
+{
+}
+
+double RetryTokenBucket::ToSeconds(std::chrono::steady_clock::time_point now) const
+{
+    return std::chrono::duration<double>(now - m_epoch).count();
+}
+
+bool RetryTokenBucket::Acquire(double amount, bool fastFail)
+{
+    return Acquire(amount, fastFail, std::chrono::steady_clock::now());
+}
+
+bool RetryTokenBucket::Acquire(double amount, bool fastFail, std::chrono::steady_clock::time_point now)
+{
+    double waitSeconds = 0;
+    {
+        std::lock_guard<std::mutex> locker(m_lock);
+        if (!m_enabled)
+        {
+            return true;
+        }
+
+        Refill(ToSeconds(now));
+        if (amount > m_currentCapacity)
+        {
+            if (fastFail)
+            {
+                return false;
+            }
+            waitSeconds = (amount - m_currentCapacity) / m_fillRate;
+        }
+        //waiters go into debt, so the next one queues up behind them instead of racing them for the refill.
+        m_currentCapacity -= amount;
+    }
+
+    if (waitSeconds > 0)
+    {
+        std::this_thread::sleep_for(std::chrono::duration<double>(waitSeconds));
+    }
+    return true;
+}
+
+void RetryTokenBucket::UpdateClientSendingRate(bool isThrottlingResponse)
+{
+    UpdateClientSendingRate(isThrottlingResponse, std::chrono::steady_clock::now());
+}
+
+void RetryTokenBucket::UpdateClientSendingRate(bool isThrottlingResponse, std::chrono::steady_clock::time_point now)
+{
+    std::lock_guard<std::mutex> locker(m_lock);
+    double seconds = ToSeconds(now);
+    UpdateMeasuredRate(seconds);
+
+    double calculatedRate = 0;
+    if (isThrottlingResponse)
+    {
+        double rateToUse = m_enabled ? (std::min)(m_measuredTxRate, m_fillRate) : m_measuredTxRate;
+        m_lastMaxRate = rateToUse;
+        CalculateTimeWindow();
+        m_lastThrottleTime = seconds;
+        calculatedRate = CubicThrottle(rateToUse);
+        m_enabled = true;
+    }
+    else
+    {
+        CalculateTimeWindow();
+        calculatedRate = CubicSuccess(seconds);
+    }
+
+    UpdateRate((std::min)(calculatedRate, 2 * m_measuredTxRate), seconds);
+}
+
+bool RetryTokenBucket::IsEnabled() const
+{
+    std::lock_guard<std::mutex> locker(m_lock);
+    return m_enabled;
+}
+
+double RetryTokenBucket::GetFillRate() const
+{
+    std::lock_guard<std::mutex> locker(m_lock);
+    return m_fillRate;
+}
+
+double RetryTokenBucket::GetMeasuredSendRate() const
+{
+    std::lock_guard<std::mutex> locker(m_lock);
+    return m_measuredTxRate;
+}
+
+void RetryTokenBucket::Refill(double now)
+{
+    double fillAmount = (std::max)(now - m_lastTimestamp, 0.0) * m_fillRate;
+    m_currentCapacity = (std::min)(m_maxCapacity, m_currentCapacity + fillAmount);
+    m_lastTimestamp = (std::max)(now, m_lastTimestamp);
+}
+
+//the send rate is measured over half second buckets and smoothed exponentially.
+void RetryTokenBucket::UpdateMeasuredRate(double now)
+{
+    double timeBucket = std::floor(now * 2) / 2;
+    m_requestCount += 1;
+    if (timeBucket > m_lastTxRateBucket)
+    {
+        double currentRate = m_requestCount / (timeBucket - m_lastTxRateBucket);
+        m_measuredTxRate = currentRate * SMOOTH + m_measuredTxRate * (1 - SMOOTH);
+        m_requestCount = 0;
+        m_lastTxRateBucket = timeBucket;
+    }
+}
+
+void RetryTokenBucket::UpdateRate(double newRate, double now)
+{
+    Refill(now);
+    m_fillRate = (std::max)(newRate, MIN_FILL_RATE);
+    m_maxCapacity = (std::max)(newRate, MIN_CAPACITY);
+    m_currentCapacity = (std::min)(m_currentCapacity, m_maxCapacity);
+}
+
+//time it takes the cubic curve to climb back to the rate that was last throttled.
+void RetryTokenBucket::CalculateTimeWindow()
+{
+    m_timeWindow = std::cbrt(m_lastMaxRate * (1 - BETA) / SCALE_CONSTANT);
+}
+
+double RetryTokenBucket::CubicSuccess(double now) const
+{
+    double elapsed = now - m_lastThrottleTime;
+    return SCALE_CONSTANT * std::pow(elapsed - m_timeWindow, 3) + m_lastMaxRate;
+}
+
+double RetryTokenBucket::CubicThrottle(double rateToUse) const
+{
+    return rateToUse * BETA;
+}
+
+AdaptiveRetryStrategy::AdaptiveRetryStrategy(long maxRetries, long scaleFactor, long maxBackoffMs) :
+    StandardRetryStrategy(maxRetries, scaleFactor, maxBackoffMs)
+{
+}
+
+AdaptiveRetryStrategy::AdaptiveRetryStrategy(const std::shared_ptr<RetryQuotaContainer>& retryQuotaContainer, long maxRetries, long scaleFactor,
+        long maxBackoffMs) :
+    StandardRetryStrategy(retryQuotaContainer, maxRetries, scaleFactor, maxBackoffMs)
+{
+}
+
+void AdaptiveRetryStrategy::GetSendToken()
+{
+    m_retryTokenBucket.Acquire();
+}
+
+bool AdaptiveRetryStrategy::HasSendToken()
+{
+    return m_retryTokenBucket.Acquire(1, true);
+}
+
+void AdaptiveRetryStrategy::RequestBookkeeping(const HttpResponseOutcome& httpResponseOutcome)
+{
+    StandardRetryStrategy::RequestBookkeeping(httpResponseOutcome);
+    m_retryTokenBucket.UpdateClientSendingRate(!httpResponseOutcome.IsSuccess() && IsThrottlingError(httpResponseOutcome.GetError()));
+}
+
+void AdaptiveRetryStrategy::RequestBookkeeping(const HttpResponseOutcome& httpResponseOutcome, const AWSError<CoreErrors>& lastError)
+{
+    StandardRetryStrategy::RequestBookkeeping(httpResponseOutcome, lastError);
+    m_retryTokenBucket.UpdateClientSendingRate(!httpResponseOutcome.IsSuccess() && IsThrottlingError(httpResponseOutcome.GetError()));
+}
+
+bool AdaptiveRetryStrategy::IsThrottlingError(const AWSError<CoreErrors>& error)
+{
+    if (error.GetErrorType() == CoreErrors::THROTTLING || error.GetErrorType() == CoreErrors::SLOW_DOWN ||
+        error.GetResponseCode() == Aws::Http::HttpResponseCode::TOO_MANY_REQUESTS)
+    {
+        return true;
+    }
+
+    const char* exceptionName = error.GetExceptionName().c_str();
+    for (const char* throttlingException : THROTTLING_EXCEPTIONS)
+    {
+        if (strcmp(exceptionName, throttlingException) == 0)
+        {
+            return true;
+        }
+    }
+    return false;
+}
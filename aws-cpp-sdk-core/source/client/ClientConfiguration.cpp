@@ -44,6 +44,7 @@ ClientConfiguration::ClientConfiguration() :
     maxConnections(25), 
     requestTimeoutMs(3000), 
     connectTimeoutMs(1000),
+    connectionIdleTimeoutMs(60000),
     retryStrategy(Aws::MakeShared<DefaultRetryStrategy>(CLIENT_CONFIGURATION_ALLOCATION_TAG)),
     proxyScheme(Aws::Http::Scheme::HTTP),
     proxyPort(0),
@@ -52,7 +53,9 @@ ClientConfiguration::ClientConfiguration() :
     writeRateLimiter(nullptr),
     readRateLimiter(nullptr),
     httpLibOverride(Aws::Http::TransferLibType::DEFAULT_CLIENT),
-    followRedirects(true)
+    followRedirects(true),
+    httpEventLoopThreads(1),
+    payloadSigningChunkSize(0)
 {
 }
 
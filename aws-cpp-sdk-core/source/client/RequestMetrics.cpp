@@ -0,0 +1,81 @@
+/*
+* Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+*
+* Licensed under the Apache License, Version 2.0 (the "License").
+* You may not use this file except in compliance with the License.
+* A copy of the License is located at
+*
+*  http://aws.amazon.com/apache2.0
+*
+* or in the "license" file accompanying this file. This file is distributed
+* on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+* express or implied. See the License for the specific language governing
+* permissions and limitations under the License.
+*/
+
+#include <aws/core/client/RequestMetrics.h>
+
+using namespace Aws::Client;
+using namespace Aws::Http;
+
+RequestAttemptMetrics::RequestAttemptMetrics() :
+    requestName(""),
+    serviceName(""),
+    attempt(0),
+    responseCode(HttpResponseCode::REQUEST_NOT_MADE),
+    success(false),
+    retrySleepTime(0),
+    signingTime(0),
+    payloadParseTime(0),
+    totalTime(0)
+{
+}
+
+HistogramRequestMetricsCollector::HistogramRequestMetricsCollector() :
+    m_attempts(0),
+    m_failedAttempts(0),
+    m_retries(0),
+    m_bytesSent(0),
+    m_bytesReceived(0)
+{
+}
+
+void HistogramRequestMetricsCollector::OnAttemptCompleted(const RequestAttemptMetrics& metrics)
+{
+    const HttpTransferMetrics& transfer = metrics.transferMetrics;
+    if (metrics.attempt > 0)
+    {
+        m_retries.fetch_add(1, std::memory_order_relaxed);
+        m_histograms[static_cast<size_t>(RequestMetricsPhase::RETRY_SLEEP)].Record(metrics.retrySleepTime.count());
+    }
+    m_histograms[static_cast<size_t>(RequestMetricsPhase::SIGNING)].Record(metrics.signingTime.count());
+    m_histograms[static_cast<size_t>(RequestMetricsPhase::CONNECTION_ACQUIRE)].Record(transfer.connectionAcquireTime.count());
+    m_histograms[static_cast<size_t>(RequestMetricsPhase::DNS_LOOKUP)].Record(transfer.dnsLookupTime.count());
+    m_histograms[static_cast<size_t>(RequestMetricsPhase::CONNECT)].Record(transfer.connectTime.count());
+    m_histograms[static_cast<size_t>(RequestMetricsPhase::TLS_HANDSHAKE)].Record(transfer.tlsHandshakeTime.count());
+    m_histograms[static_cast<size_t>(RequestMetricsPhase::TIME_TO_FIRST_BYTE)].Record(transfer.timeToFirstByte.count());
+    m_histograms[static_cast<size_t>(RequestMetricsPhase::TRANSFER)].Record(transfer.transferTime.count());
+    m_histograms[static_cast<size_t>(RequestMetricsPhase::PAYLOAD_PARSE)].Record(metrics.payloadParseTime.count());
+    m_histograms[static_cast<size_t>(RequestMetricsPhase::TOTAL)].Record(metrics.totalTime.count());
+
+    m_bytesSent.fetch_add(static_cast<uint64_t>(transfer.bytesSent), std::memory_order_relaxed);
+    m_bytesReceived.fetch_add(static_cast<uint64_t>(transfer.bytesReceived), std::memory_order_relaxed);
+    if (!metrics.success)
+    {
+        m_failedAttempts.fetch_add(1, std::memory_order_relaxed);
+    }
+    m_attempts.fetch_add(1, std::memory_order_relaxed);
+}
+
+void HistogramRequestMetricsCollector::Reset()
+{
+    for (auto& histogram : m_histograms)
+    {
+        histogram.Reset();
+    }
+    m_attempts.store(0, std::memory_order_relaxed);
+    m_failedAttempts.store(0, std::memory_order_relaxed);
+    m_retries.store(0, std::memory_order_relaxed);
+    m_bytesSent.store(0, std::memory_order_relaxed);
+    m_bytesReceived.store(0, std::memory_order_relaxed);
+}
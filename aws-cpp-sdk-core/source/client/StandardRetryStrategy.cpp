@@ -0,0 +1,126 @@
+/*
+  * Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+  * 
+  * Licensed under the Apache License, Version 2.0 (the "License").
+  * You may not use this file except in compliance with the License.
+  * A copy of the License is located at
+  * 
+  *  http://aws.amazon.com/apache2.0
+  * 
+  * or in the "license" file accompanying this file. This file is distributed
+  * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+  * express or implied. See the License for the specific language governing
+  * permissions and limitations under the License.
+  */
+
+#include <aws/core/client/StandardRetryStrategy.h>
+
+#include <aws/core/client/AWSError.h>
+#include <aws/core/client/CoreErrors.h>
+#include <aws/core/utils/Outcome.h>
+#include <aws/core/utils/memory/AWSMemory.h>
+#include <algorithm>
+
+using namespace Aws;
+using namespace Aws::Client;
+
+static const char* STANDARD_RETRY_STRATEGY_TAG = "StandardRetryStrategy";
+static const int NO_RETRY_INCREMENT = 1;
+//2^30 times any sane scale factor is already far beyond any max backoff.
+static const long MAX_BACKOFF_SHIFT = 30;
+
+DefaultRetryQuotaContainer::DefaultRetryQuotaContainer(int initialQuota, int retryCost, int timeoutRetryCost) :
+    m_retryQuota(initialQuota),
+    m_maxQuota(initialQuota),
+    m_retryCost(retryCost),
+    m_timeoutRetryCost(timeoutRetryCost)
+{
+}
+
+int DefaultRetryQuotaContainer::GetRetryCost(const AWSError<CoreErrors>& error) const
+{
+    return error.GetErrorType() == CoreErrors::NETWORK_CONNECTION ? m_timeoutRetryCost : m_retryCost;
+}
+
+bool DefaultRetryQuotaContainer::AcquireRetryQuota(const AWSError<CoreErrors>& error)
+{
+    int cost = GetRetryCost(error);
+    int quota = m_retryQuota.load(std::memory_order_relaxed);
+    do
+    {
+        if (quota < cost)
+        {
+            return false;
+        }
+    } while (!m_retryQuota.compare_exchange_weak(quota, quota - cost, std::memory_order_relaxed));
+
+    return true;
+}
+
+void DefaultRetryQuotaContainer::ReleaseRetryQuota(int capacityAmount)
+{
+    int quota = m_retryQuota.load(std::memory_order_relaxed);
+    while (quota < m_maxQuota && !m_retryQuota.compare_exchange_weak(quota, (std::min)(quota + capacityAmount, m_maxQuota), std::memory_order_relaxed));
+}
+
+void DefaultRetryQuotaContainer::ReleaseRetryQuota(const AWSError<CoreErrors>& lastError)
+{
+    ReleaseRetryQuota(GetRetryCost(lastError));
+}
+
+StandardRetryStrategy::StandardRetryStrategy(long maxRetries, long scaleFactor, long maxBackoffMs) :
+    StandardRetryStrategy(Aws::MakeShared<DefaultRetryQuotaContainer>(STANDARD_RETRY_STRATEGY_TAG), maxRetries, scaleFactor, maxBackoffMs)
+{
+}
+
+StandardRetryStrategy::StandardRetryStrategy(const std::shared_ptr<RetryQuotaContainer>& retryQuotaContainer, long maxRetries, long scaleFactor,
+        long maxBackoffMs) :
+    m_retryQuotaContainer(retryQuotaContainer),
+    m_maxRetries(maxRetries),
+    m_scaleFactor(scaleFactor),
+    m_maxBackoffMs(maxBackoffMs),
+    m_random(std::random_device()())
+{
+}
+
+bool StandardRetryStrategy::ShouldRetry(const AWSError<CoreErrors>& error, long attemptedRetries) const
+{
+    if (!error.ShouldRetry() || attemptedRetries >= m_maxRetries)
+    {
+        return false;
+    }
+
+    return m_retryQuotaContainer->AcquireRetryQuota(error);
+}
+
+long StandardRetryStrategy::CalculateDelayBeforeNextRetry(const AWSError<CoreErrors>& error, long attemptedRetries) const
+{
+    AWS_UNREFERENCED_PARAM(error);
+
+    long shift = (std::min)((std::max)(attemptedRetries, 0L), MAX_BACKOFF_SHIFT);
+    long long ceiling = (std::min)(static_cast<long long>(m_scaleFactor) << shift, static_cast<long long>(m_maxBackoffMs));
+    if (ceiling <= 0)
+    {
+        return 0;
+    }
+
+    std::uniform_int_distribution<long long> distribution(0, ceiling);
+    std::lock_guard<std::mutex> locker(m_randomLock);
+    return static_cast<long>(distribution(m_random));
+}
+
+void StandardRetryStrategy::RequestBookkeeping(const HttpResponseOutcome& httpResponseOutcome)
+{
+    if (httpResponseOutcome.IsSuccess())
+    {
+        m_retryQuotaContainer->ReleaseRetryQuota(NO_RETRY_INCREMENT);
+    }
+}
+
+void StandardRetryStrategy::RequestBookkeeping(const HttpResponseOutcome& httpResponseOutcome, const AWSError<CoreErrors>& lastError)
+{
+    if (httpResponseOutcome.IsSuccess())
+    {
+        m_retryQuotaContainer->ReleaseRetryQuota(lastError);
+    }
+}
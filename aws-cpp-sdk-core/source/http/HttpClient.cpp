@@ -15,6 +15,7 @@
 
 #include <aws/core/http/HttpClient.h>
 #include <aws/core/http/HttpRequest.h>
+#include <aws/core/http/HttpResponse.h>
 
 using namespace Aws;
 using namespace Aws::Http;
@@ -48,6 +49,22 @@ void HttpClient::RetryRequestSleep(std::chrono::milliseconds sleepTime)
     m_requestProcessingSignal.wait_for(signalLocker, sleepTime, [this](){ return m_disableRequestProcessing.load() == true; });
 }
 
+void HttpClient::RetryRequestSleepAsync(std::chrono::milliseconds sleepTime, const std::function<void(bool)>& fn)
+{
+    if (IsRequestProcessingEnabled())
+    {
+        RetryRequestSleep(sleepTime);
+    }
+    fn(!IsRequestProcessingEnabled());
+}
+
+void HttpClient::MakeRequestAsync(const std::shared_ptr<HttpRequest>& request, const RequestCompletedEventHandler& onCompleted,
+    Aws::Utils::RateLimits::RateLimiterInterface* readLimiter, Aws::Utils::RateLimits::RateLimiterInterface* writeLimiter) const
+{
+    std::shared_ptr<HttpResponse> response = MakeRequest(*request, readLimiter, writeLimiter);
+    onCompleted(request, response);
+}
+
 bool HttpClient::ContinueRequest(const Aws::Http::HttpRequest& request) const
 {
     if (request.GetContinueRequestHandler())
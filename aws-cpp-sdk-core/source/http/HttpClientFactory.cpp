@@ -16,7 +16,9 @@
 #include <aws/core/http/HttpClientFactory.h>
 
 #if ENABLE_CURL_CLIENT
+#include <aws/core/client/ClientConfiguration.h>
 #include <aws/core/http/curl/CurlHttpClient.h>
+#include <aws/core/http/curl/CurlMultiHttpClient.h>
 #include <signal.h>
 
 #elif ENABLE_WINDOWS_CLIENT
@@ -82,6 +84,12 @@ namespace Aws
                 }
 #endif                
 #elif ENABLE_CURL_CLIENT
+#if !defined(_WIN32)
+                if (clientConfiguration.httpLibOverride == TransferLibType::CURL_MULTI_CLIENT)
+                {
+                    return Aws::MakeShared<CurlMultiHttpClient>(HTTP_CLIENT_FACTORY_ALLOCATION_TAG, clientConfiguration);
+                }
+#endif
     return Aws::MakeShared<CurlHttpClient>(HTTP_CLIENT_FACTORY_ALLOCATION_TAG, clientConfiguration);
 #else
                 // When neither of these clients is enabled, gcc gives a warning (converted
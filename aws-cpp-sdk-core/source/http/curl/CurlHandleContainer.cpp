@@ -14,19 +14,23 @@
   */
 
 #include <aws/core/http/curl/CurlHandleContainer.h>
+#include <aws/core/utils/HashingUtils.h>
 #include <aws/core/utils/logging/LogMacros.h>
 
 #include <algorithm>
+#include <thread>
 
 using namespace Aws::Utils::Logging;
 using namespace Aws::Http;
 
 static const char* CURL_HANDLE_CONTAINER_TAG = "CurlHandleContainer";
+static const char* DEFAULT_ENDPOINT = "";
 
 
-CurlHandleContainer::CurlHandleContainer(unsigned maxSize, long requestTimeout, long connectTimeout) :
+CurlHandleContainer::CurlHandleContainer(unsigned maxSize, long requestTimeout, long connectTimeout, long idleTimeout) :
                 m_maxPoolSize(maxSize), m_requestTimeout(requestTimeout), m_connectTimeout(connectTimeout),
-                m_poolSize(0)
+                m_idleTimeout(idleTimeout > 0 ? idleTimeout : 0), m_poolSize(0), m_waiters(0),
+                m_hits(0), m_misses(0), m_handshakes(0), m_evictions(0)
 {
     AWS_LOGSTREAM_INFO(CURL_HANDLE_CONTAINER_TAG, "Initializing CurlHandleContainer with size " << maxSize);
 }
@@ -34,77 +38,313 @@ CurlHandleContainer::CurlHandleContainer(unsigned maxSize, long requestTimeout,
 CurlHandleContainer::~CurlHandleContainer()
 {
     AWS_LOGSTREAM_INFO(CURL_HANDLE_CONTAINER_TAG, "Cleaning up CurlHandleContainer.");
-    for (CURL* handle : m_handleContainer.ShutdownAndWait(m_poolSize))
+    std::unique_lock<std::mutex> locker(m_waitLock);
+    ++m_waiters;
+
+    //wait for all acquired handles to be released.
+    for (;;)
     {
-        AWS_LOGSTREAM_DEBUG(CURL_HANDLE_CONTAINER_TAG, "Cleaning up " << handle);
-        curl_easy_cleanup(handle);
+        for (auto& shard : m_shards)
+        {
+            std::lock_guard<std::mutex> shardLocker(shard.lock);
+            for (auto& idleHandles : shard.idleHandles)
+            {
+                for (auto& idleHandle : idleHandles.second)
+                {
+                    AWS_LOGSTREAM_DEBUG(CURL_HANDLE_CONTAINER_TAG, "Cleaning up " << idleHandle.handle);
+                    curl_easy_cleanup(idleHandle.handle);
+                    --m_poolSize;
+                }
+            }
+            shard.idleHandles.clear();
+        }
+
+        if (m_poolSize.load() == 0)
+        {
+            break;
+        }
+
+        m_handleReleased.wait(locker);
     }
+
+    --m_waiters;
 }
 
 CURL* CurlHandleContainer::AcquireCurlHandle()
 {
-    AWS_LOGSTREAM_DEBUG(CURL_HANDLE_CONTAINER_TAG, "Attempting to acquire curl connection.");
+    return AcquireCurlHandle(DEFAULT_ENDPOINT);
+}
 
-    if(!m_handleContainer.HasResourcesAvailable())
+CURL* CurlHandleContainer::AcquireCurlHandle(const Aws::String& endpoint)
+{
+    AWS_LOGSTREAM_DEBUG(CURL_HANDLE_CONTAINER_TAG, "Attempting to acquire curl connection for " << endpoint);
+
+    CURL* handle = TryAcquire(endpoint);
+    if (!handle)
     {
-        AWS_LOGSTREAM_DEBUG(CURL_HANDLE_CONTAINER_TAG, "No current connections available in pool. Attempting to create new connections.");
-        CheckAndGrowPool();
+        AWS_LOGSTREAM_DEBUG(CURL_HANDLE_CONTAINER_TAG, "No current connections available in pool. Waiting for one to be released.");
+        //waiters are registered under m_waitLock before the last check, and releasing threads take m_waitLock before notifying,
+        //so a handle released between the check and the wait can't be missed.
+        std::unique_lock<std::mutex> locker(m_waitLock);
+        ++m_waiters;
+        while (!(handle = TryAcquire(endpoint)))
+        {
+            m_handleReleased.wait(locker);
+        }
+        --m_waiters;
+        AWS_LOGSTREAM_INFO(CURL_HANDLE_CONTAINER_TAG, "Connection has been released. Continuing.");
     }
 
-    CURL* handle = m_handleContainer.Acquire();
-    AWS_LOGSTREAM_INFO(CURL_HANDLE_CONTAINER_TAG, "Connection has been released. Continuing.");
     AWS_LOGSTREAM_DEBUG(CURL_HANDLE_CONTAINER_TAG, "Returning connection handle " << handle);
     return handle;
 }
 
 void CurlHandleContainer::ReleaseCurlHandle(CURL* handle)
+{
+    ReleaseCurlHandle(handle, DEFAULT_ENDPOINT);
+}
+
+void CurlHandleContainer::ReleaseCurlHandle(CURL* handle, const Aws::String& endpoint)
 {
     if (handle)
     {
+        //reset clears the info of the last transfer, so read the number of connections it had to open first.
+        long connects = 0;
+        if (curl_easy_getinfo(handle, CURLINFO_NUM_CONNECTS, &connects) == CURLE_OK && connects > 0)
+        {
+            m_handshakes += static_cast<uint64_t>(connects);
+        }
+
+        //curl_easy_reset keeps the handle's connection cache and tls sessions alive, that's what makes the handle worth keeping per endpoint.
         curl_easy_reset(handle);
         SetDefaultOptionsOnHandle(handle);
-        AWS_LOGSTREAM_DEBUG(CURL_HANDLE_CONTAINER_TAG, "Releasing curl handle " << handle);
-        m_handleContainer.Release(handle);
+        AWS_LOGSTREAM_DEBUG(CURL_HANDLE_CONTAINER_TAG, "Releasing curl handle " << handle << " for " << endpoint);
+
+        Aws::Vector<CURL*> expired;
+        Shard& shard = GetShard(endpoint);
+        {
+            std::lock_guard<std::mutex> locker(shard.lock);
+            auto now = std::chrono::steady_clock::now();
+            CollectExpiredHandles(shard, now, expired);
+            IdleHandle idleHandle = { handle, now };
+            shard.idleHandles[endpoint].push_back(idleHandle);
+        }
+
+        EvictHandles(expired);
+        NotifyWaiters();
         AWS_LOGSTREAM_DEBUG(CURL_HANDLE_CONTAINER_TAG, "Notified waiting threads.");
     }
 }
 
-bool CurlHandleContainer::CheckAndGrowPool()
+unsigned CurlHandleContainer::Warmup(const Aws::String& endpoint, unsigned count, const std::function<bool(CURL*)>& connect)
+{
+    Aws::Vector<CURL*> handles;
+    while (handles.size() < count)
+    {
+        CURL* handle = TryAcquire(endpoint);
+        if (!handle)
+        {
+            break;
+        }
+        handles.push_back(handle);
+    }
+
+    AWS_LOGSTREAM_INFO(CURL_HANDLE_CONTAINER_TAG, "Warming up " << handles.size() << " connections to " << endpoint);
+
+    //every handle needs its own connection, so they have to connect at the same time.
+    std::atomic<unsigned> connected(0);
+    Aws::Vector<std::thread> threads;
+    for (size_t i = 1; i < handles.size(); ++i)
+    {
+        CURL* handle = handles[i];
+        threads.emplace_back([&connect, &connected, handle]() { if (connect(handle)) { ++connected; } });
+    }
+
+    if (!handles.empty() && connect(handles[0]))
+    {
+        ++connected;
+    }
+
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    for (CURL* handle : handles)
+    {
+        ReleaseCurlHandle(handle, endpoint);
+    }
+
+    return connected.load();
+}
+
+size_t CurlHandleContainer::EvictIdleHandles()
+{
+    Aws::Vector<CURL*> expired;
+    auto now = std::chrono::steady_clock::now();
+    for (auto& shard : m_shards)
+    {
+        std::lock_guard<std::mutex> locker(shard.lock);
+        CollectExpiredHandles(shard, now, expired);
+    }
+
+    EvictHandles(expired);
+    return expired.size();
+}
+
+CurlHandleContainer::Shard& CurlHandleContainer::GetShard(const Aws::String& endpoint)
+{
+    return m_shards[static_cast<unsigned>(Aws::Utils::HashingUtils::HashString(endpoint.c_str())) % SHARD_COUNT];
+}
+
+CURL* CurlHandleContainer::TryAcquire(const Aws::String& endpoint)
+{
+    CURL* handle = TryAcquireIdle(GetShard(endpoint), endpoint);
+    if (handle)
+    {
+        ++m_hits;
+        return handle;
+    }
+
+    handle = TryCreateHandle();
+    if (!handle)
+    {
+        AWS_LOGSTREAM_DEBUG(CURL_HANDLE_CONTAINER_TAG, "Pool cannot be grown any further, looking for an idle connection of another endpoint.");
+        handle = TryAcquireAnyIdle();
+    }
+
+    if (handle)
+    {
+        ++m_misses;
+    }
+
+    return handle;
+}
+
+CURL* CurlHandleContainer::TryAcquireIdle(Shard& shard, const Aws::String& endpoint)
+{
+    CURL* handle = nullptr;
+    Aws::Vector<CURL*> expired;
+    {
+        std::lock_guard<std::mutex> locker(shard.lock);
+        CollectExpiredHandles(shard, std::chrono::steady_clock::now(), expired);
+        auto idleHandles = shard.idleHandles.find(endpoint);
+        if (idleHandles != shard.idleHandles.end() && !idleHandles->second.empty())
+        {
+            //most recently used first, its connection is the least likely to have been closed by the server.
+            handle = idleHandles->second.back().handle;
+            idleHandles->second.pop_back();
+        }
+    }
+
+    EvictHandles(expired);
+    return handle;
+}
+
+CURL* CurlHandleContainer::TryAcquireAnyIdle()
 {
-    std::lock_guard<std::mutex> locker(m_containerLock);
-    if (m_poolSize < m_maxPoolSize)
+    for (auto& shard : m_shards)
     {
-        unsigned multiplier = m_poolSize > 0 ? m_poolSize : 1;
-        unsigned amountToAdd = (std::min)(multiplier * 2, m_maxPoolSize - m_poolSize);
-        AWS_LOGSTREAM_DEBUG(CURL_HANDLE_CONTAINER_TAG, "attempting to grow pool size by " << amountToAdd);
+        std::lock_guard<std::mutex> locker(shard.lock);
+        for (auto idleHandles = shard.idleHandles.begin(); idleHandles != shard.idleHandles.end(); ++idleHandles)
+        {
+            if (!idleHandles->second.empty())
+            {
+                //least recently used, it's the least likely to be asked for by its own endpoint.
+                CURL* handle = idleHandles->second.front().handle;
+                idleHandles->second.erase(idleHandles->second.begin());
+                if (idleHandles->second.empty())
+                {
+                    shard.idleHandles.erase(idleHandles);
+                }
+                return handle;
+            }
+        }
+    }
+
+    return nullptr;
+}
 
-        unsigned actuallyAdded = 0;
-        for (unsigned i = 0; i < amountToAdd; ++i)
+CURL* CurlHandleContainer::TryCreateHandle()
+{
+    unsigned poolSize = m_poolSize.load();
+    while (poolSize < m_maxPoolSize)
+    {
+        if (m_poolSize.compare_exchange_weak(poolSize, poolSize + 1))
         {
             CURL* curlHandle = curl_easy_init();
-
             if (curlHandle)
             {
                 SetDefaultOptionsOnHandle(curlHandle);
-                m_handleContainer.Release(curlHandle);
-                ++actuallyAdded;
-            }
-            else
-            {
-                AWS_LOGSTREAM_ERROR(CURL_HANDLE_CONTAINER_TAG, "curl_easy_init failed to allocate.");
-                break;
+                AWS_LOGSTREAM_INFO(CURL_HANDLE_CONTAINER_TAG, "Pool grown to " << poolSize + 1);
+                return curlHandle;
             }
+
+            AWS_LOGSTREAM_ERROR(CURL_HANDLE_CONTAINER_TAG, "curl_easy_init failed to allocate.");
+            --m_poolSize;
+            return nullptr;
+        }
+    }
+
+    return nullptr;
+}
+
+void CurlHandleContainer::CollectExpiredHandles(Shard& shard, TimePoint now, Aws::Vector<CURL*>& expired)
+{
+    if (m_idleTimeout.count() == 0)
+    {
+        return;
+    }
+
+    for (auto idleHandles = shard.idleHandles.begin(); idleHandles != shard.idleHandles.end();)
+    {
+        //handles are appended as they are released, so the expired ones are at the front.
+        auto& handles = idleHandles->second;
+        auto firstLive = std::find_if(handles.begin(), handles.end(),
+            [&](const IdleHandle& idleHandle) { return now - idleHandle.idleSince <= m_idleTimeout; });
+        for (auto idleHandle = handles.begin(); idleHandle != firstLive; ++idleHandle)
+        {
+            expired.push_back(idleHandle->handle);
+        }
+        handles.erase(handles.begin(), firstLive);
+
+        if (handles.empty())
+        {
+            idleHandles = shard.idleHandles.erase(idleHandles);
+        }
+        else
+        {
+            ++idleHandles;
         }
+    }
+}
 
-        AWS_LOGSTREAM_INFO(CURL_HANDLE_CONTAINER_TAG, "Pool grown by " << actuallyAdded);
-        m_poolSize += actuallyAdded;
+void CurlHandleContainer::EvictHandles(const Aws::Vector<CURL*>& handles)
+{
+    if (handles.empty())
+    {
+        return;
+    }
 
-        return actuallyAdded > 0;
+    for (CURL* handle : handles)
+    {
+        AWS_LOGSTREAM_DEBUG(CURL_HANDLE_CONTAINER_TAG, "Cleaning up idle handle " << handle);
+        curl_easy_cleanup(handle);
+        --m_poolSize;
+        ++m_evictions;
     }
 
-    AWS_LOGSTREAM_INFO(CURL_HANDLE_CONTAINER_TAG, "Pool cannot be grown any further, already at max size.");
+    //the pool has room to grow again.
+    NotifyWaiters();
+}
 
-    return false;
+void CurlHandleContainer::NotifyWaiters()
+{
+    if (m_waiters.load() > 0)
+    {
+        std::lock_guard<std::mutex> locker(m_waitLock);
+        m_handleReleased.notify_all();
+    }
 }
 
 void CurlHandleContainer::SetDefaultOptionsOnHandle(CURL* handle)
@@ -15,11 +15,14 @@
 
 #include <aws/core/http/curl/CurlHttpClient.h>
 #include <aws/core/http/HttpRequest.h>
+#include <aws/core/http/HttpClientFactory.h>
 #include <aws/core/http/standard/StandardHttpResponse.h>
 #include <aws/core/utils/StringUtils.h>
 #include <aws/core/utils/logging/LogMacros.h>
 #include <aws/core/utils/ratelimiter/RateLimiterInterface.h>
 #include <cassert>
+#include <cerrno>
+#include <cstdlib>
 #include <algorithm>
 
 
@@ -127,40 +130,23 @@ static char* strdup_callback(const char* str)
 
 #endif
 
-struct CurlWriteCallbackContext
-{
-    CurlWriteCallbackContext(const CurlHttpClient* client,
-                             HttpRequest* request, 
-                             HttpResponse* response, 
-                             Aws::Utils::RateLimits::RateLimiterInterface* rateLimiter) :
-        m_client(client),
-        m_request(request),
-        m_response(response),
-        m_rateLimiter(rateLimiter),
-        m_numBytesResponseReceived(0)
-    {}
-
-    const CurlHttpClient* m_client;
-    HttpRequest* m_request;
-    HttpResponse* m_response;
-    Aws::Utils::RateLimits::RateLimiterInterface* m_rateLimiter;
-    int64_t m_numBytesResponseReceived;
-};
-
-struct CurlReadCallbackContext
-{
-    CurlReadCallbackContext(const CurlHttpClient* client, HttpRequest* request, Aws::Utils::RateLimits::RateLimiterInterface* limiter) :
-        m_client(client),
-        m_rateLimiter(limiter),
-        m_request(request)
-    {}
-
-    const CurlHttpClient* m_client;
-    Aws::Utils::RateLimits::RateLimiterInterface* m_rateLimiter;
-    HttpRequest* m_request;
-};
-
 static const char* CURL_HTTP_CLIENT_TAG = "CurlHttpClient";
+//content-length only sizes the first allocation of a body sink, larger bodies grow the sink as they arrive.
+static const long long MAX_BODY_SINK_RESERVATION = 4 * 1024 * 1024;
+
+//returns 0, meaning don't reserve, for a content-length that is missing, malformed or not positive.
+static size_t GetBodySinkReservation(const Aws::String& contentLength)
+{
+    const char* begin = contentLength.c_str();
+    char* end = nullptr;
+    errno = 0;
+    long long length = std::strtoll(begin, &end, 10);
+    if (errno != 0 || end == begin || *end != '\0' || length <= 0)
+    {
+        return 0;
+    }
+    return static_cast<size_t>((std::min)(length, MAX_BODY_SINK_RESERVATION));
+}
 
 void SetOptCodeForHttpMethod(CURL* requestHandle, const HttpRequest& request)
 {
@@ -290,7 +276,8 @@ int CurlDebugCallback(CURL *handle, curl_infotype type, char *data, size_t size,
 
 CurlHttpClient::CurlHttpClient(const ClientConfiguration& clientConfig) :
     Base(),   
-    m_curlHandleContainer(clientConfig.maxConnections, clientConfig.requestTimeoutMs, clientConfig.connectTimeoutMs),
+    m_curlHandleContainer(clientConfig.maxConnections, clientConfig.requestTimeoutMs, clientConfig.connectTimeoutMs,
+        clientConfig.connectionIdleTimeoutMs),
     m_isUsingProxy(!clientConfig.proxyHost.empty()), m_proxyUserName(clientConfig.proxyUserName),
     m_proxyPassword(clientConfig.proxyPassword), m_proxyScheme(SchemeMapper::ToString(clientConfig.proxyScheme)), m_proxyHost(clientConfig.proxyHost),
     m_proxyPort(clientConfig.proxyPort), m_verifySSL(clientConfig.verifySSL), m_caPath(clientConfig.caPath),
@@ -299,22 +286,23 @@ CurlHttpClient::CurlHttpClient(const ClientConfiguration& clientConfig) :
 }
 
 
-std::shared_ptr<HttpResponse> CurlHttpClient::MakeRequest(HttpRequest& request, Aws::Utils::RateLimits::RateLimiterInterface* readLimiter,
-                                                          Aws::Utils::RateLimits::RateLimiterInterface* writeLimiter) const
+Aws::String CurlHttpClient::GetEndpointKey(const URI& uri)
+{
+    return uri.GetAuthority() + ":" + StringUtils::to_string(uri.GetPort());
+}
+
+Aws::String CurlHttpClient::BuildRequestUrl(const HttpRequest& request)
 {
     //handle uri encoding at last second. Otherwise, the signer and the http layer will mismatch.
     URI uri = request.GetUri();
     uri.SetPath(URI::URLEncodePath(uri.GetPath()));
-    Aws::String url = uri.GetURIString();
+    return uri.GetURIString();
+}
 
-    AWS_LOGSTREAM_TRACE(CURL_HTTP_CLIENT_TAG, "Making request to " << url);
+struct curl_slist* CurlHttpClient::BuildHeaderList(const HttpRequest& request)
+{
     struct curl_slist* headers = NULL;
 
-    if (writeLimiter != nullptr)
-    {
-        writeLimiter->ApplyAndPayForCost(request.GetSize());
-    }
-
     Aws::StringStream headerStream;
     HeaderValueCollection requestHeaders = request.GetHeaders();
 
@@ -339,138 +327,227 @@ std::shared_ptr<HttpResponse> CurlHttpClient::MakeRequest(HttpRequest& request,
         headers = curl_slist_append(headers, "content-type:");
     }
 
-    std::shared_ptr<HttpResponse> response(nullptr);
-    CURL* connectionHandle = m_curlHandleContainer.AcquireCurlHandle();
+    return headers;
+}
 
-    if (connectionHandle)
+void CurlHttpClient::ConfigureConnectionHandle(CURL* connectionHandle, HttpRequest& request, const Aws::String& url, struct curl_slist* headers,
+        CurlWriteCallbackContext& writeContext, CurlReadCallbackContext& readContext) const
+{
+    if (headers)
     {
-        AWS_LOGSTREAM_DEBUG(CURL_HTTP_CLIENT_TAG, "Obtained connection handle " << connectionHandle);
-
-        if (headers)
-        {
-            curl_easy_setopt(connectionHandle, CURLOPT_HTTPHEADER, headers);
-        }
-
-        response = Aws::MakeShared<StandardHttpResponse>(CURL_HTTP_CLIENT_TAG, request);
-        CurlWriteCallbackContext writeContext(this, &request, response.get(), readLimiter);
-        CurlReadCallbackContext readContext(this, &request, writeLimiter);
+        curl_easy_setopt(connectionHandle, CURLOPT_HTTPHEADER, headers);
+    }
 
-        SetOptCodeForHttpMethod(connectionHandle, request);
+    SetOptCodeForHttpMethod(connectionHandle, request);
 
-        curl_easy_setopt(connectionHandle, CURLOPT_URL, url.c_str());
-        curl_easy_setopt(connectionHandle, CURLOPT_WRITEFUNCTION, &CurlHttpClient::WriteData);
-        curl_easy_setopt(connectionHandle, CURLOPT_WRITEDATA, &writeContext);
-        curl_easy_setopt(connectionHandle, CURLOPT_HEADERFUNCTION, &CurlHttpClient::WriteHeader);
-        curl_easy_setopt(connectionHandle, CURLOPT_HEADERDATA, response.get());
+    curl_easy_setopt(connectionHandle, CURLOPT_URL, url.c_str());
+    curl_easy_setopt(connectionHandle, CURLOPT_WRITEFUNCTION, &CurlHttpClient::WriteData);
+    curl_easy_setopt(connectionHandle, CURLOPT_WRITEDATA, &writeContext);
+    curl_easy_setopt(connectionHandle, CURLOPT_HEADERFUNCTION, &CurlHttpClient::WriteHeader);
+    curl_easy_setopt(connectionHandle, CURLOPT_HEADERDATA, writeContext.m_response);
 
-        //we only want to override the default path if someone has explicitly told us to.
-        if(!m_caPath.empty())
-        {
-            curl_easy_setopt(connectionHandle, CURLOPT_CAPATH, m_caPath.c_str());
-        }
-        if(!m_caFile.empty())
-        {
-            curl_easy_setopt(connectionHandle, CURLOPT_CAINFO, m_caFile.c_str());
-        }
+    //we only want to override the default path if someone has explicitly told us to.
+    if(!m_caPath.empty())
+    {
+        curl_easy_setopt(connectionHandle, CURLOPT_CAPATH, m_caPath.c_str());
+    }
+    if(!m_caFile.empty())
+    {
+        curl_easy_setopt(connectionHandle, CURLOPT_CAINFO, m_caFile.c_str());
+    }
 
-	// only set by android test builds because the emulator is missing a cert needed for aws services
+// only set by android test builds because the emulator is missing a cert needed for aws services
 #ifdef TEST_CERT_PATH
-	curl_easy_setopt(connectionHandle, CURLOPT_CAPATH, TEST_CERT_PATH);
+    curl_easy_setopt(connectionHandle, CURLOPT_CAPATH, TEST_CERT_PATH);
 #endif // TEST_CERT_PATH
 
-        if (m_verifySSL)
-        {
-            curl_easy_setopt(connectionHandle, CURLOPT_SSL_VERIFYPEER, 1L);
-            curl_easy_setopt(connectionHandle, CURLOPT_SSL_VERIFYHOST, 2L);
+    if (m_verifySSL)
+    {
+        curl_easy_setopt(connectionHandle, CURLOPT_SSL_VERIFYPEER, 1L);
+        curl_easy_setopt(connectionHandle, CURLOPT_SSL_VERIFYHOST, 2L);
 
 #if LIBCURL_VERSION_MAJOR >= 7
 #if LIBCURL_VERSION_MINOR >= 34
-            curl_easy_setopt(connectionHandle, CURLOPT_SSLVERSION, CURL_SSLVERSION_TLSv1);
+        curl_easy_setopt(connectionHandle, CURLOPT_SSLVERSION, CURL_SSLVERSION_TLSv1);
 #endif //LIBCURL_VERSION_MINOR
 #endif //LIBCURL_VERSION_MAJOR
-        }
-        else
-        {
-            curl_easy_setopt(connectionHandle, CURLOPT_SSL_VERIFYPEER, 0L);
-            curl_easy_setopt(connectionHandle, CURLOPT_SSL_VERIFYHOST, 0L);
-        }
+    }
+    else
+    {
+        curl_easy_setopt(connectionHandle, CURLOPT_SSL_VERIFYPEER, 0L);
+        curl_easy_setopt(connectionHandle, CURLOPT_SSL_VERIFYHOST, 0L);
+    }
 
-        if (m_allowRedirects)
-        {
-            curl_easy_setopt(connectionHandle, CURLOPT_FOLLOWLOCATION, 1L);
-        }
-        else
-        {
-            curl_easy_setopt(connectionHandle, CURLOPT_FOLLOWLOCATION, 0L);
-        }
-        //curl_easy_setopt(connectionHandle, CURLOPT_VERBOSE, 1);
-        //curl_easy_setopt(connectionHandle, CURLOPT_DEBUGFUNCTION, CurlDebugCallback);
+    if (m_allowRedirects)
+    {
+        curl_easy_setopt(connectionHandle, CURLOPT_FOLLOWLOCATION, 1L);
+    }
+    else
+    {
+        curl_easy_setopt(connectionHandle, CURLOPT_FOLLOWLOCATION, 0L);
+    }
+    //curl_easy_setopt(connectionHandle, CURLOPT_VERBOSE, 1);
+    //curl_easy_setopt(connectionHandle, CURLOPT_DEBUGFUNCTION, CurlDebugCallback);
 
-        if (m_isUsingProxy)
-        {
-            Aws::StringStream ss;
-            ss << m_proxyScheme << "://" << m_proxyHost;
-            curl_easy_setopt(connectionHandle, CURLOPT_PROXY, ss.str().c_str());
-            curl_easy_setopt(connectionHandle, CURLOPT_PROXYPORT, (long) m_proxyPort);
-            curl_easy_setopt(connectionHandle, CURLOPT_PROXYUSERNAME, m_proxyUserName.c_str());
-            curl_easy_setopt(connectionHandle, CURLOPT_PROXYPASSWORD, m_proxyPassword.c_str());
-        }
-        else
-        {
-            curl_easy_setopt(connectionHandle, CURLOPT_PROXY, "");
-        }
+    if (m_isUsingProxy)
+    {
+        Aws::StringStream ss;
+        ss << m_proxyScheme << "://" << m_proxyHost;
+        curl_easy_setopt(connectionHandle, CURLOPT_PROXY, ss.str().c_str());
+        curl_easy_setopt(connectionHandle, CURLOPT_PROXYPORT, (long) m_proxyPort);
+        curl_easy_setopt(connectionHandle, CURLOPT_PROXYUSERNAME, m_proxyUserName.c_str());
+        curl_easy_setopt(connectionHandle, CURLOPT_PROXYPASSWORD, m_proxyPassword.c_str());
+    }
+    else
+    {
+        curl_easy_setopt(connectionHandle, CURLOPT_PROXY, "");
+    }
 
-        if (request.GetContentBody())
-        {
-            curl_easy_setopt(connectionHandle, CURLOPT_READFUNCTION, &CurlHttpClient::ReadBody);
-            curl_easy_setopt(connectionHandle, CURLOPT_READDATA, &readContext);
-        }
+    if (request.GetContentBody())
+    {
+        curl_easy_setopt(connectionHandle, CURLOPT_READFUNCTION, &CurlHttpClient::ReadBody);
+        curl_easy_setopt(connectionHandle, CURLOPT_READDATA, &readContext);
+    }
+}
 
-        CURLcode curlResponseCode = curl_easy_perform(connectionHandle);
-        bool shouldContinueRequest = ContinueRequest(request);
-        if (curlResponseCode != CURLE_OK && shouldContinueRequest)
-        {
-            response = nullptr;
-            AWS_LOGSTREAM_ERROR(CURL_HTTP_CLIENT_TAG, "Curl returned error code " << curlResponseCode);
-        }
-        else if(!shouldContinueRequest)
+//curl reports every phase as the time elapsed since the start of the transfer, so each phase is the difference to the previous one.
+//phases that did not happen (e.g. connect on a reused connection, tls on plain http) report zero.
+static void RecordTransferMetrics(CURL* connectionHandle, HttpResponse& response)
+{
+    HttpTransferMetrics metrics = response.GetTransferMetrics();
+#if LIBCURL_VERSION_NUM >= 0x073d00
+    curl_off_t nameLookupMicros = 0, connectMicros = 0, appConnectMicros = 0, startTransferMicros = 0, totalMicros = 0;
+    curl_off_t uploadedBytes = 0, downloadedBytes = 0;
+    curl_easy_getinfo(connectionHandle, CURLINFO_NAMELOOKUP_TIME_T, &nameLookupMicros);
+    curl_easy_getinfo(connectionHandle, CURLINFO_CONNECT_TIME_T, &connectMicros);
+    curl_easy_getinfo(connectionHandle, CURLINFO_APPCONNECT_TIME_T, &appConnectMicros);
+    curl_easy_getinfo(connectionHandle, CURLINFO_STARTTRANSFER_TIME_T, &startTransferMicros);
+    curl_easy_getinfo(connectionHandle, CURLINFO_TOTAL_TIME_T, &totalMicros);
+    curl_easy_getinfo(connectionHandle, CURLINFO_SIZE_UPLOAD_T, &uploadedBytes);
+    curl_easy_getinfo(connectionHandle, CURLINFO_SIZE_DOWNLOAD_T, &downloadedBytes);
+    long long nameLookup = static_cast<long long>(nameLookupMicros);
+    long long connect = static_cast<long long>(connectMicros);
+    long long appConnect = static_cast<long long>(appConnectMicros);
+    long long startTransfer = static_cast<long long>(startTransferMicros);
+    long long total = static_cast<long long>(totalMicros);
+    long long uploaded = static_cast<long long>(uploadedBytes);
+    long long downloaded = static_cast<long long>(downloadedBytes);
+#else
+    double nameLookupSeconds = 0, connectSeconds = 0, appConnectSeconds = 0, startTransferSeconds = 0, totalSeconds = 0;
+    double uploadedBytes = 0, downloadedBytes = 0;
+    curl_easy_getinfo(connectionHandle, CURLINFO_NAMELOOKUP_TIME, &nameLookupSeconds);
+    curl_easy_getinfo(connectionHandle, CURLINFO_CONNECT_TIME, &connectSeconds);
+    curl_easy_getinfo(connectionHandle, CURLINFO_APPCONNECT_TIME, &appConnectSeconds);
+    curl_easy_getinfo(connectionHandle, CURLINFO_STARTTRANSFER_TIME, &startTransferSeconds);
+    curl_easy_getinfo(connectionHandle, CURLINFO_TOTAL_TIME, &totalSeconds);
+    curl_easy_getinfo(connectionHandle, CURLINFO_SIZE_UPLOAD, &uploadedBytes);
+    curl_easy_getinfo(connectionHandle, CURLINFO_SIZE_DOWNLOAD, &downloadedBytes);
+    long long nameLookup = static_cast<long long>(nameLookupSeconds * 1000000);
+    long long connect = static_cast<long long>(connectSeconds * 1000000);
+    long long appConnect = static_cast<long long>(appConnectSeconds * 1000000);
+    long long startTransfer = static_cast<long long>(startTransferSeconds * 1000000);
+    long long total = static_cast<long long>(totalSeconds * 1000000);
+    long long uploaded = static_cast<long long>(uploadedBytes);
+    long long downloaded = static_cast<long long>(downloadedBytes);
+#endif
+    long long connected = (std::max)(nameLookup, connect);
+    long long secured = appConnect > 0 ? (std::max)(connected, appConnect) : connected;
+    long long firstByte = (std::max)(secured, startTransfer);
+
+    metrics.dnsLookupTime = std::chrono::microseconds(nameLookup);
+    metrics.connectTime = std::chrono::microseconds(connected - nameLookup);
+    metrics.tlsHandshakeTime = std::chrono::microseconds(secured - connected);
+    metrics.timeToFirstByte = std::chrono::microseconds(startTransfer > 0 ? firstByte - secured : 0);
+    metrics.transferTime = std::chrono::microseconds(startTransfer > 0 ? (std::max)(total, firstByte) - firstByte : 0);
+    metrics.bytesSent = uploaded;
+    metrics.bytesReceived = downloaded;
+    response.SetTransferMetrics(metrics);
+}
+
+void CurlHttpClient::FinalizeResponse(CURL* connectionHandle, CURLcode curlResponseCode, HttpRequest& request,
+        std::shared_ptr<HttpResponse>& response, const CurlWriteCallbackContext& writeContext) const
+{
+    bool shouldContinueRequest = ContinueRequest(request);
+    if (curlResponseCode != CURLE_OK && shouldContinueRequest)
+    {
+        response = nullptr;
+        AWS_LOGSTREAM_ERROR(CURL_HTTP_CLIENT_TAG, "Curl returned error code " << curlResponseCode);
+    }
+    else if(!shouldContinueRequest)
+    {
+        response->SetResponseCode(HttpResponseCode::REQUEST_NOT_MADE);
+    }
+    else
+    {
+        long responseCode;
+        curl_easy_getinfo(connectionHandle, CURLINFO_RESPONSE_CODE, &responseCode);
+        response->SetResponseCode(static_cast<HttpResponseCode>(responseCode));
+        AWS_LOGSTREAM_DEBUG(CURL_HTTP_CLIENT_TAG, "Returned http response code " << responseCode);
+        RecordTransferMetrics(connectionHandle, *response);
+
+        char* contentType = nullptr;
+        curl_easy_getinfo(connectionHandle, CURLINFO_CONTENT_TYPE, &contentType);
+        if (contentType)
         {
-            response->SetResponseCode(HttpResponseCode::REQUEST_NOT_MADE);
+            response->SetContentType(contentType);
+            AWS_LOGSTREAM_DEBUG(CURL_HTTP_CLIENT_TAG, "Returned content type " << contentType);
         }
-        else
+
+        if (request.GetMethod() != HttpMethod::HTTP_HEAD &&
+            writeContext.m_client->IsRequestProcessingEnabled() &&
+            response->HasHeader(Aws::Http::CONTENT_LENGTH_HEADER))
         {
-            long responseCode;
-            curl_easy_getinfo(connectionHandle, CURLINFO_RESPONSE_CODE, &responseCode);
-            response->SetResponseCode(static_cast<HttpResponseCode>(responseCode));
-            AWS_LOGSTREAM_DEBUG(CURL_HTTP_CLIENT_TAG, "Returned http response code " << responseCode);
-
-            char* contentType = nullptr;
-            curl_easy_getinfo(connectionHandle, CURLINFO_CONTENT_TYPE, &contentType);
-            if (contentType)
+            const Aws::String& contentLength = response->GetHeader(Aws::Http::CONTENT_LENGTH_HEADER);
+            int64_t numBytesResponseReceived = writeContext.m_numBytesResponseReceived;
+            AWS_LOGSTREAM_TRACE(CURL_HTTP_CLIENT_TAG, "Response content-length header: " << contentLength);
+            AWS_LOGSTREAM_TRACE(CURL_HTTP_CLIENT_TAG, "Response body length: " << numBytesResponseReceived);
+            if (StringUtils::ConvertToInt64(contentLength.c_str()) != numBytesResponseReceived)
             {
-                response->SetContentType(contentType);
-                AWS_LOGSTREAM_DEBUG(CURL_HTTP_CLIENT_TAG, "Returned content type " << contentType);
+                response = nullptr;
+                AWS_LOGSTREAM_ERROR(CURL_HTTP_CLIENT_TAG, "Response body length doesn't match the content-length header.");
             }
+        }
 
-            if (request.GetMethod() != HttpMethod::HTTP_HEAD &&
-                writeContext.m_client->IsRequestProcessingEnabled() &&
-                response->HasHeader(Aws::Http::CONTENT_LENGTH_HEADER))
-            {
-                const Aws::String& contentLength = response->GetHeader(Aws::Http::CONTENT_LENGTH_HEADER);
-                int64_t numBytesResponseReceived = writeContext.m_numBytesResponseReceived;
-                AWS_LOGSTREAM_TRACE(CURL_HTTP_CLIENT_TAG, "Response content-length header: " << contentLength);
-                AWS_LOGSTREAM_TRACE(CURL_HTTP_CLIENT_TAG, "Response body length: " << numBytesResponseReceived);
-                if (StringUtils::ConvertToInt64(contentLength.c_str()) != numBytesResponseReceived)
-                {
-                    response = nullptr;
-                    AWS_LOGSTREAM_ERROR(CURL_HTTP_CLIENT_TAG, "Response body length doesn't match the content-length header.");
-                }
-            }
+        AWS_LOGSTREAM_DEBUG(CURL_HTTP_CLIENT_TAG, "Releasing curl handle " << connectionHandle);
+    }
+}
 
-            AWS_LOGSTREAM_DEBUG(CURL_HTTP_CLIENT_TAG, "Releasing curl handle " << connectionHandle);
-        }
+std::shared_ptr<HttpResponse> CurlHttpClient::MakeRequest(HttpRequest& request, Aws::Utils::RateLimits::RateLimiterInterface* readLimiter,
+                                                          Aws::Utils::RateLimits::RateLimiterInterface* writeLimiter) const
+{
+    Aws::String url = BuildRequestUrl(request);
+
+    AWS_LOGSTREAM_TRACE(CURL_HTTP_CLIENT_TAG, "Making request to " << url);
+
+    if (writeLimiter != nullptr)
+    {
+        writeLimiter->ApplyAndPayForCost(request.GetSize());
+    }
+
+    struct curl_slist* headers = BuildHeaderList(request);
+
+    std::shared_ptr<HttpResponse> response(nullptr);
+    const Aws::String endpoint = GetEndpointKey(request.GetUri());
+    auto acquireStart = std::chrono::steady_clock::now();
+    CURL* connectionHandle = m_curlHandleContainer.AcquireCurlHandle(endpoint);
+
+    if (connectionHandle)
+    {
+        AWS_LOGSTREAM_DEBUG(CURL_HTTP_CLIENT_TAG, "Obtained connection handle " << connectionHandle);
 
-        m_curlHandleContainer.ReleaseCurlHandle(connectionHandle);
+        response = Aws::MakeShared<StandardHttpResponse>(CURL_HTTP_CLIENT_TAG, request);
+        HttpTransferMetrics transferMetrics;
+        transferMetrics.connectionAcquireTime = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - acquireStart);
+        response->SetTransferMetrics(transferMetrics);
+        CurlWriteCallbackContext writeContext(this, &request, response.get(), readLimiter);
+        CurlReadCallbackContext readContext(this, &request, writeLimiter);
+
+        ConfigureConnectionHandle(connectionHandle, request, url, headers, writeContext, readContext);
+
+        CURLcode curlResponseCode = curl_easy_perform(connectionHandle);
+        FinalizeResponse(connectionHandle, curlResponseCode, request, response, writeContext);
+
+        m_curlHandleContainer.ReleaseCurlHandle(connectionHandle, endpoint);
         //go ahead and flush the response body stream
         if(response)
         {
@@ -486,6 +563,71 @@ std::shared_ptr<HttpResponse> CurlHttpClient::MakeRequest(HttpRequest& request,
     return response;
 }
 
+unsigned CurlHttpClient::WarmupConnections(const Aws::String& url, unsigned count) const
+{
+    URI uri(url);
+    return m_curlHandleContainer.Warmup(GetEndpointKey(uri), count, [this, &uri](CURL* connectionHandle)
+    {
+        auto request = CreateHttpRequest(uri, HttpMethod::HTTP_HEAD, Aws::Utils::Stream::DefaultResponseStreamFactoryMethod);
+        auto response = Aws::MakeShared<StandardHttpResponse>(CURL_HTTP_CLIENT_TAG, *request);
+        CurlWriteCallbackContext writeContext(this, request.get(), response.get(), nullptr);
+        CurlReadCallbackContext readContext(this, request.get(), nullptr);
+        struct curl_slist* headers = BuildHeaderList(*request);
+
+        ConfigureConnectionHandle(connectionHandle, *request, BuildRequestUrl(*request), headers, writeContext, readContext);
+        CURLcode curlResponseCode = curl_easy_perform(connectionHandle);
+        if (curlResponseCode != CURLE_OK)
+        {
+            AWS_LOGSTREAM_WARN(CURL_HTTP_CLIENT_TAG, "Warming up connection to " << uri.GetAuthority() << " failed with curl error code " << curlResponseCode);
+        }
+
+        if (headers)
+        {
+            curl_slist_free_all(headers);
+        }
+
+        return curlResponseCode == CURLE_OK;
+    });
+}
+
+//Transfers with a resume scheduler stay paused until the rate limiter delay they were charged has passed.
+static bool IsPausedByRateLimit(const std::function<void(std::chrono::milliseconds)>& scheduleResume, std::chrono::steady_clock::time_point resumeTime)
+{
+    if (!scheduleResume)
+    {
+        return false;
+    }
+
+    auto now = std::chrono::steady_clock::now();
+    if (now >= resumeTime)
+    {
+        return false;
+    }
+
+    scheduleResume(std::chrono::duration_cast<std::chrono::milliseconds>(resumeTime - now) + std::chrono::milliseconds(1));
+    return true;
+}
+
+static void PayForRateLimit(Aws::Utils::RateLimits::RateLimiterInterface* rateLimiter, const std::function<void(std::chrono::milliseconds)>& scheduleResume,
+        std::chrono::steady_clock::time_point& resumeTime, int64_t cost)
+{
+    if (!rateLimiter)
+    {
+        return;
+    }
+
+    if (!scheduleResume)
+    {
+        rateLimiter->ApplyAndPayForCost(cost);
+        return;
+    }
+
+    auto delay = rateLimiter->ApplyCost(cost);
+    if (delay.count() > 0)
+    {
+        resumeTime = std::chrono::steady_clock::now() + delay;
+    }
+}
 
 size_t CurlHttpClient::WriteData(char* ptr, size_t size, size_t nmemb, void* userdata)
 {
@@ -493,20 +635,35 @@ size_t CurlHttpClient::WriteData(char* ptr, size_t size, size_t nmemb, void* use
     {
         CurlWriteCallbackContext* context = reinterpret_cast<CurlWriteCallbackContext*>(userdata);
 
-        const CurlHttpClient* client = context->m_client;
+        const HttpClient* client = context->m_client;
         if(!client->ContinueRequest(*context->m_request) || !client->IsRequestProcessingEnabled())
         {
             return 0;
         }
 
+        //curl hands the same data in again once the transfer is resumed.
+        if (IsPausedByRateLimit(context->m_scheduleResume, context->m_resumeTime))
+        {
+            return CURL_WRITEFUNC_PAUSE;
+        }
+
         HttpResponse* response = context->m_response;
         size_t sizeToWrite = size * nmemb;
-        if (context->m_rateLimiter)
+        PayForRateLimit(context->m_rateLimiter, context->m_scheduleResume, context->m_resumeTime, static_cast<int64_t>(sizeToWrite));
+
+        if (context->m_bodySink)
         {
-            context->m_rateLimiter->ApplyAndPayForCost(static_cast<int64_t>(sizeToWrite));
+            size_t written = context->m_bodySink->Append(ptr, sizeToWrite);
+            if (written != sizeToWrite)
+            {
+                AWS_LOGSTREAM_ERROR(CURL_HTTP_CLIENT_TAG, "Response body sink only took " << written << " of " << sizeToWrite << " bytes, aborting.");
+                return written;
+            }
+        }
+        else
+        {
+            response->GetResponseBody().write(ptr, static_cast<std::streamsize>(sizeToWrite));
         }
-
-        response->GetResponseBody().write(ptr, static_cast<std::streamsize>(sizeToWrite));
         auto& receivedHandler = context->m_request->GetDataReceivedEventHandler();
         if (receivedHandler)
         {
@@ -541,6 +698,19 @@ size_t CurlHttpClient::WriteHeader(char* ptr, size_t size, size_t nmemb, void* u
 
 
             response->AddHeader(headerName, headerValue);
+
+            //size the body sink up front. HEAD responses carry the content-length of a body they don't have.
+            //the reservation is parsed without exceptions and capped, since this runs inside curl's C callback.
+            auto bodySink = response->GetResponseBodySink();
+            if (bodySink && response->GetOriginatingRequest().GetMethod() != HttpMethod::HTTP_HEAD &&
+                StringUtils::CaselessCompare(headerName.c_str(), Http::CONTENT_LENGTH_HEADER))
+            {
+                size_t reservation = GetBodySinkReservation(headerValue);
+                if (reservation > 0)
+                {
+                    bodySink->Reserve(reservation);
+                }
+            }
         }
 
         return size * nmemb;
@@ -557,12 +727,17 @@ size_t CurlHttpClient::ReadBody(char* ptr, size_t size, size_t nmemb, void* user
         return 0;
     }
 
-    const CurlHttpClient* client = context->m_client;
+    const HttpClient* client = context->m_client;
     if(!client->ContinueRequest(*context->m_request) || !client->IsRequestProcessingEnabled())
     {
         return CURL_READFUNC_ABORT;
     }
 
+    if (IsPausedByRateLimit(context->m_scheduleResume, context->m_resumeTime))
+    {
+        return CURL_READFUNC_PAUSE;
+    }
+
     HttpRequest* request = context->m_request;
     std::shared_ptr<Aws::IOStream> ioStream = request->GetContentBody();
 
@@ -577,10 +752,7 @@ size_t CurlHttpClient::ReadBody(char* ptr, size_t size, size_t nmemb, void* user
             sentHandler(request, static_cast<long long>(amountRead));
         }
 
-        if (context->m_rateLimiter)
-        {
-            context->m_rateLimiter->ApplyAndPayForCost(static_cast<int64_t>(amountRead));
-        }
+        PayForRateLimit(context->m_rateLimiter, context->m_scheduleResume, context->m_resumeTime, static_cast<int64_t>(amountRead));
 
         return amountRead;
     }
@@ -0,0 +1,678 @@
+/*
+  * Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+  *
+  * Licensed under the Apache License, Version 2.0 (the "License").
+  * You may not use this file except in compliance with the License.
+  * A copy of the License is located at
+  *
+  *  http://aws.amazon.com/apache2.0
+  *
+  * or in the "license" file accompanying this file. This file is distributed
+  * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+  * express or implied. See the License for the specific language governing
+  * permissions and limitations under the License.
+  */
+
+#include <aws/core/http/curl/CurlMultiHttpClient.h>
+#include <aws/core/http/HttpRequest.h>
+#include <aws/core/http/standard/StandardHttpResponse.h>
+#include <aws/core/utils/logging/LogMacros.h>
+#include <aws/core/utils/memory/stl/AWSMap.h>
+#include <aws/core/utils/ratelimiter/RateLimiterInterface.h>
+#include <aws/core/utils/UnreferencedParam.h>
+
+#if !defined(_WIN32)
+
+#include <poll.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+using namespace Aws::Client;
+using namespace Aws::Http;
+using namespace Aws::Http::Standard;
+using namespace Aws::Utils::Logging;
+
+static const char* CURL_MULTI_HTTP_CLIENT_TAG = "CurlMultiHttpClient";
+
+namespace Aws
+{
+namespace Http
+{
+
+/**
+ * Single threaded reactor around a curl multi handle. Sockets and timeouts requested by curl are polled on the loop thread and fed back
+ * through curl_multi_socket_action. Other threads only ever touch the submission queues, which are drained after a write to the wakeup pipe.
+ */
+class CurlEventLoop
+{
+public:
+    typedef std::function<void(CURL*)> ConfigureHandleFn;
+    typedef std::function<void(CURL*, CURLcode)> TransferCompletedFn;
+    typedef std::function<void(bool)> TimerFn;
+
+    CurlEventLoop(long maxConnections) :
+        m_multiHandle(curl_multi_init()),
+        m_curlTimeoutSet(false),
+        m_maxIdleHandles(static_cast<size_t>((std::max)(maxConnections, 1L))),
+        m_cancelRequested(false),
+        m_continue(true)
+    {
+        m_wakeupPipe[0] = m_wakeupPipe[1] = -1;
+        if (pipe(m_wakeupPipe) == 0)
+        {
+            fcntl(m_wakeupPipe[0], F_SETFL, fcntl(m_wakeupPipe[0], F_GETFL) | O_NONBLOCK);
+            fcntl(m_wakeupPipe[1], F_SETFL, fcntl(m_wakeupPipe[1], F_GETFL) | O_NONBLOCK);
+        }
+        else
+        {
+            AWS_LOGSTREAM_ERROR(CURL_MULTI_HTTP_CLIENT_TAG, "Failed to create event loop wakeup pipe, errno " << errno);
+        }
+
+        curl_multi_setopt(m_multiHandle, CURLMOPT_SOCKETFUNCTION, &CurlEventLoop::SocketCallback);
+        curl_multi_setopt(m_multiHandle, CURLMOPT_SOCKETDATA, this);
+        curl_multi_setopt(m_multiHandle, CURLMOPT_TIMERFUNCTION, &CurlEventLoop::TimerCallback);
+        curl_multi_setopt(m_multiHandle, CURLMOPT_TIMERDATA, this);
+#if LIBCURL_VERSION_NUM >= 0x071e00
+        curl_multi_setopt(m_multiHandle, CURLMOPT_MAX_TOTAL_CONNECTIONS, maxConnections);
+#endif
+
+        m_thread = std::thread(std::bind(&CurlEventLoop::Run, this));
+    }
+
+    ~CurlEventLoop()
+    {
+        m_continue = false;
+        Wakeup();
+        m_thread.join();
+
+        // anything still queued, in flight or waiting on a timer is failed so that waiters are released.
+        AddPendingTransfers();
+        CancelAll();
+
+        for (CURL* handle : m_idleHandles)
+        {
+            curl_easy_cleanup(handle);
+        }
+
+        curl_multi_cleanup(m_multiHandle);
+        close(m_wakeupPipe[0]);
+        close(m_wakeupPipe[1]);
+    }
+
+    /**
+     * Queues a transfer. configure is invoked on the loop thread with a freshly reset easy handle, onCompleted is invoked on the loop thread
+     * once curl is finished with it.
+     */
+    void AddTransfer(ConfigureHandleFn&& configure, TransferCompletedFn&& onCompleted)
+    {
+        {
+            std::lock_guard<std::mutex> locker(m_submissionLock);
+            m_pendingTransfers.emplace_back(std::move(configure), std::move(onCompleted));
+        }
+        Wakeup();
+    }
+
+    /**
+     * Invokes fn(false) on the loop thread once delay has elapsed, or fn(true) if the timer is cancelled first.
+     */
+    void Schedule(std::chrono::milliseconds delay, TimerFn&& fn)
+    {
+        {
+            std::lock_guard<std::mutex> locker(m_submissionLock);
+            m_pendingTimers.emplace_back(std::chrono::steady_clock::now() + delay, std::move(fn));
+        }
+        Wakeup();
+    }
+
+    /**
+     * Asks the loop thread to abort every transfer in flight and to cancel every timer that has been scheduled so far.
+     */
+    void RequestCancel()
+    {
+        m_cancelRequested = true;
+        Wakeup();
+    }
+
+    std::thread::id GetThreadId() const { return m_thread.get_id(); }
+
+private:
+    typedef std::chrono::steady_clock::time_point TimePoint;
+
+    void Run()
+    {
+        Aws::Vector<struct pollfd> pollFds;
+        while (m_continue)
+        {
+            pollFds.clear();
+            struct pollfd wakeupFd = { m_wakeupPipe[0], POLLIN, 0 };
+            pollFds.push_back(wakeupFd);
+            for (auto& socket : m_sockets)
+            {
+                struct pollfd socketFd = { socket.first, socket.second, 0 };
+                pollFds.push_back(socketFd);
+            }
+
+            int ready = poll(pollFds.data(), static_cast<nfds_t>(pollFds.size()), ComputePollTimeout());
+            if (ready < 0 && errno != EINTR)
+            {
+                AWS_LOGSTREAM_ERROR(CURL_MULTI_HTTP_CLIENT_TAG, "poll failed with errno " << errno);
+            }
+
+            if (pollFds[0].revents & POLLIN)
+            {
+                DrainWakeupPipe();
+            }
+
+            AddPendingTransfers();
+            if (m_cancelRequested.exchange(false))
+            {
+                CancelAll();
+            }
+
+            int runningHandles = 0;
+            for (size_t i = 1; ready > 0 && i < pollFds.size(); ++i)
+            {
+                short revents = pollFds[i].revents;
+                if (!revents)
+                {
+                    continue;
+                }
+
+                int flags = 0;
+                if (revents & POLLIN)
+                {
+                    flags |= CURL_CSELECT_IN;
+                }
+                if (revents & POLLOUT)
+                {
+                    flags |= CURL_CSELECT_OUT;
+                }
+                if (revents & (POLLERR | POLLHUP | POLLNVAL))
+                {
+                    flags |= CURL_CSELECT_ERR;
+                }
+                curl_multi_socket_action(m_multiHandle, pollFds[i].fd, flags, &runningHandles);
+            }
+
+            if (m_curlTimeoutSet && std::chrono::steady_clock::now() >= m_curlTimeout)
+            {
+                m_curlTimeoutSet = false;
+                curl_multi_socket_action(m_multiHandle, CURL_SOCKET_TIMEOUT, 0, &runningHandles);
+            }
+
+            ProcessCompletedTransfers();
+            RunDueTimers();
+        }
+    }
+
+    int ComputePollTimeout() const
+    {
+        bool hasDeadline = m_curlTimeoutSet;
+        TimePoint deadline = m_curlTimeout;
+        if (!m_timers.empty() && (!hasDeadline || m_timers.begin()->first < deadline))
+        {
+            deadline = m_timers.begin()->first;
+            hasDeadline = true;
+        }
+
+        if (!hasDeadline)
+        {
+            return -1;
+        }
+
+        auto now = std::chrono::steady_clock::now();
+        if (deadline <= now)
+        {
+            return 0;
+        }
+
+        // round up so that we never spin on a sub millisecond deadline.
+        auto waitMs = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - now).count() + 1;
+        return static_cast<int>((std::min)(waitMs, static_cast<decltype(waitMs)>(60000)));
+    }
+
+    void AddPendingTransfers()
+    {
+        Aws::Vector<std::pair<ConfigureHandleFn, TransferCompletedFn>> transfers;
+        Aws::Vector<std::pair<TimePoint, TimerFn>> timers;
+        {
+            std::lock_guard<std::mutex> locker(m_submissionLock);
+            transfers.swap(m_pendingTransfers);
+            timers.swap(m_pendingTimers);
+        }
+
+        for (auto& timer : timers)
+        {
+            m_timers.emplace(timer.first, std::move(timer.second));
+        }
+
+        for (auto& transfer : transfers)
+        {
+            CURL* handle = AcquireHandle();
+            if (!handle)
+            {
+                AWS_LOGSTREAM_ERROR(CURL_MULTI_HTTP_CLIENT_TAG, "curl_easy_init failed to allocate.");
+                transfer.second(nullptr, CURLE_OUT_OF_MEMORY);
+                continue;
+            }
+
+            transfer.first(handle);
+            m_activeTransfers.emplace(handle, std::move(transfer.second));
+            CURLMcode code = curl_multi_add_handle(m_multiHandle, handle);
+            if (code != CURLM_OK)
+            {
+                AWS_LOGSTREAM_ERROR(CURL_MULTI_HTTP_CLIENT_TAG, "curl_multi_add_handle failed with code " << code);
+                CompleteTransfer(handle, CURLE_FAILED_INIT);
+            }
+        }
+    }
+
+    void ProcessCompletedTransfers()
+    {
+        int messagesInQueue = 0;
+        CURLMsg* message = nullptr;
+        while ((message = curl_multi_info_read(m_multiHandle, &messagesInQueue)) != nullptr)
+        {
+            if (message->msg == CURLMSG_DONE)
+            {
+                CURL* handle = message->easy_handle;
+                CURLcode result = message->data.result;
+                curl_multi_remove_handle(m_multiHandle, handle);
+                CompleteTransfer(handle, result);
+            }
+        }
+    }
+
+    void CompleteTransfer(CURL* handle, CURLcode result)
+    {
+        auto transfer = m_activeTransfers.find(handle);
+        if (transfer != m_activeTransfers.end())
+        {
+            TransferCompletedFn onCompleted = std::move(transfer->second);
+            m_activeTransfers.erase(transfer);
+            onCompleted(handle, result);
+        }
+        ReleaseHandle(handle);
+    }
+
+    void RunDueTimers()
+    {
+        auto now = std::chrono::steady_clock::now();
+        while (!m_timers.empty() && m_timers.begin()->first <= now)
+        {
+            TimerFn fn = std::move(m_timers.begin()->second);
+            m_timers.erase(m_timers.begin());
+            fn(false);
+        }
+    }
+
+    void CancelAll()
+    {
+        Aws::Vector<CURL*> handles;
+        for (auto& transfer : m_activeTransfers)
+        {
+            handles.push_back(transfer.first);
+        }
+        for (CURL* handle : handles)
+        {
+            curl_multi_remove_handle(m_multiHandle, handle);
+            CompleteTransfer(handle, CURLE_ABORTED_BY_CALLBACK);
+        }
+
+        Aws::MultiMap<TimePoint, TimerFn> timers;
+        timers.swap(m_timers);
+        for (auto& timer : timers)
+        {
+            timer.second(true);
+        }
+    }
+
+    CURL* AcquireHandle()
+    {
+        if (!m_idleHandles.empty())
+        {
+            CURL* handle = m_idleHandles.back();
+            m_idleHandles.pop_back();
+            return handle;
+        }
+        return curl_easy_init();
+    }
+
+    void ReleaseHandle(CURL* handle)
+    {
+        if (m_idleHandles.size() < m_maxIdleHandles)
+        {
+            curl_easy_reset(handle);
+            m_idleHandles.push_back(handle);
+        }
+        else
+        {
+            curl_easy_cleanup(handle);
+        }
+    }
+
+    void Wakeup()
+    {
+        char signal = 1;
+        if (write(m_wakeupPipe[1], &signal, 1) < 0 && errno != EAGAIN)
+        {
+            AWS_LOGSTREAM_ERROR(CURL_MULTI_HTTP_CLIENT_TAG, "Failed to signal event loop, errno " << errno);
+        }
+    }
+
+    void DrainWakeupPipe()
+    {
+        char buffer[64];
+        while (read(m_wakeupPipe[0], buffer, sizeof(buffer)) > 0)
+        {
+        }
+    }
+
+    static int SocketCallback(CURL* easy, curl_socket_t socket, int what, void* userp, void* socketp)
+    {
+        AWS_UNREFERENCED_PARAM(easy);
+        AWS_UNREFERENCED_PARAM(socketp);
+
+        CurlEventLoop* eventLoop = reinterpret_cast<CurlEventLoop*>(userp);
+        switch (what)
+        {
+            case CURL_POLL_REMOVE:
+                eventLoop->m_sockets.erase(socket);
+                break;
+            case CURL_POLL_IN:
+                eventLoop->m_sockets[socket] = POLLIN;
+                break;
+            case CURL_POLL_OUT:
+                eventLoop->m_sockets[socket] = POLLOUT;
+                break;
+            case CURL_POLL_INOUT:
+                eventLoop->m_sockets[socket] = POLLIN | POLLOUT;
+                break;
+            default:
+                break;
+        }
+        return 0;
+    }
+
+    static int TimerCallback(CURLM* multi, long timeoutMs, void* userp)
+    {
+        AWS_UNREFERENCED_PARAM(multi);
+
+        CurlEventLoop* eventLoop = reinterpret_cast<CurlEventLoop*>(userp);
+        if (timeoutMs < 0)
+        {
+            eventLoop->m_curlTimeoutSet = false;
+        }
+        else
+        {
+            eventLoop->m_curlTimeoutSet = true;
+            eventLoop->m_curlTimeout = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+        }
+        return 0;
+    }
+
+    CURLM* m_multiHandle;
+    int m_wakeupPipe[2];
+
+    std::mutex m_submissionLock;
+    Aws::Vector<std::pair<ConfigureHandleFn, TransferCompletedFn>> m_pendingTransfers;
+    Aws::Vector<std::pair<TimePoint, TimerFn>> m_pendingTimers;
+
+    // only touched from the loop thread.
+    Aws::Map<curl_socket_t, short> m_sockets;
+    Aws::Map<CURL*, TransferCompletedFn> m_activeTransfers;
+    Aws::MultiMap<TimePoint, TimerFn> m_timers;
+    Aws::Vector<CURL*> m_idleHandles;
+    TimePoint m_curlTimeout;
+    bool m_curlTimeoutSet;
+    size_t m_maxIdleHandles;
+
+    std::atomic<bool> m_cancelRequested;
+    std::atomic<bool> m_continue;
+    std::thread m_thread;
+};
+
+} // namespace Http
+} // namespace Aws
+
+//Everything curl needs to drive a single request. Lives until the completion callback has run.
+struct CurlMultiRequestState
+{
+    CurlMultiRequestState(const HttpClient* client, HttpRequest& request, const std::shared_ptr<HttpRequest>& requestOwner,
+                          Aws::Utils::RateLimits::RateLimiterInterface* readLimiter,
+                          Aws::Utils::RateLimits::RateLimiterInterface* writeLimiter) :
+        m_request(request),
+        m_requestOwner(requestOwner),
+        m_response(Aws::MakeShared<StandardHttpResponse>(CURL_MULTI_HTTP_CLIENT_TAG, request)),
+        m_writeContext(client, &request, m_response.get(), readLimiter),
+        m_readContext(client, &request, writeLimiter),
+        m_headers(nullptr),
+        m_connectionHandle(nullptr)
+    {}
+
+    ~CurlMultiRequestState()
+    {
+        if (m_headers)
+        {
+            curl_slist_free_all(m_headers);
+        }
+    }
+
+    HttpRequest& m_request;
+    std::shared_ptr<HttpRequest> m_requestOwner;
+    std::shared_ptr<HttpResponse> m_response;
+    CurlWriteCallbackContext m_writeContext;
+    CurlReadCallbackContext m_readContext;
+    struct curl_slist* m_headers;
+    Aws::String m_url;
+    //the handle driving the request while it is in flight, so resume timers can tell whether it is still this request's.
+    CURL* m_connectionHandle;
+};
+
+CurlMultiHttpClient::CurlMultiHttpClient(const ClientConfiguration& clientConfig) :
+    Base(clientConfig),
+    m_nextEventLoop(0),
+    m_requestTimeout(clientConfig.requestTimeoutMs),
+    m_connectTimeout(clientConfig.connectTimeoutMs)
+{
+    unsigned eventLoopCount = (std::max)(clientConfig.httpEventLoopThreads, 1u);
+    AWS_LOGSTREAM_INFO(CURL_MULTI_HTTP_CLIENT_TAG, "Starting " << eventLoopCount << " curl event loops.");
+    for (unsigned i = 0; i < eventLoopCount; ++i)
+    {
+        m_eventLoops.push_back(Aws::New<CurlEventLoop>(CURL_MULTI_HTTP_CLIENT_TAG, static_cast<long>(clientConfig.maxConnections)));
+    }
+}
+
+CurlMultiHttpClient::~CurlMultiHttpClient()
+{
+    //handlers failed during shutdown must not queue retries onto loops that are being torn down.
+    HttpClient::DisableRequestProcessing();
+    for (CurlEventLoop* eventLoop : m_eventLoops)
+    {
+        Aws::Delete(eventLoop);
+    }
+}
+
+std::shared_ptr<HttpResponse> CurlMultiHttpClient::MakeRequest(HttpRequest& request, Aws::Utils::RateLimits::RateLimiterInterface* readLimiter,
+                                                               Aws::Utils::RateLimits::RateLimiterInterface* writeLimiter) const
+{
+    //waiting on the loop from the loop itself would never complete, so fall back to driving the request with curl_easy_perform.
+    if (IsEventLoopThread())
+    {
+        return Base::MakeRequest(request, readLimiter, writeLimiter);
+    }
+
+    std::mutex completionLock;
+    std::condition_variable completionSignal;
+    bool completed = false;
+    std::shared_ptr<HttpResponse> response;
+
+    SubmitRequest(request, nullptr, [&](const std::shared_ptr<HttpResponse>& completedResponse)
+    {
+        std::lock_guard<std::mutex> locker(completionLock);
+        response = completedResponse;
+        completed = true;
+        completionSignal.notify_one();
+    }, readLimiter, writeLimiter);
+
+    std::unique_lock<std::mutex> locker(completionLock);
+    completionSignal.wait(locker, [&]() { return completed; });
+    return response;
+}
+
+void CurlMultiHttpClient::MakeRequestAsync(const std::shared_ptr<HttpRequest>& request, const RequestCompletedEventHandler& onCompleted,
+                                           Aws::Utils::RateLimits::RateLimiterInterface* readLimiter,
+                                           Aws::Utils::RateLimits::RateLimiterInterface* writeLimiter) const
+{
+    SubmitRequest(*request, request, [request, onCompleted](const std::shared_ptr<HttpResponse>& response)
+    {
+        onCompleted(request, response);
+    }, readLimiter, writeLimiter);
+}
+
+void CurlMultiHttpClient::RetryRequestSleepAsync(std::chrono::milliseconds sleepTime, const std::function<void(bool)>& fn)
+{
+    if (!IsRequestProcessingEnabled())
+    {
+        fn(true);
+        return;
+    }
+
+    //processing may get disabled after the timer was queued but before the loop picked it up, so check again when it fires.
+    GetNextEventLoop()->Schedule(sleepTime, [this, fn](bool cancelled)
+    {
+        fn(cancelled || !IsRequestProcessingEnabled());
+    });
+}
+
+void CurlMultiHttpClient::DisableRequestProcessing()
+{
+    Base::DisableRequestProcessing();
+    for (CurlEventLoop* eventLoop : m_eventLoops)
+    {
+        eventLoop->RequestCancel();
+    }
+}
+
+void CurlMultiHttpClient::SubmitRequest(HttpRequest& request, const std::shared_ptr<HttpRequest>& requestOwner,
+                                        std::function<void(const std::shared_ptr<HttpResponse>&)>&& onCompleted,
+                                        Aws::Utils::RateLimits::RateLimiterInterface* readLimiter,
+                                        Aws::Utils::RateLimits::RateLimiterInterface* writeLimiter) const
+{
+    auto state = Aws::MakeShared<CurlMultiRequestState>(CURL_MULTI_HTTP_CLIENT_TAG, this, request, requestOwner, readLimiter, writeLimiter);
+    state->m_url = BuildRequestUrl(request);
+
+    AWS_LOGSTREAM_TRACE(CURL_MULTI_HTTP_CLIENT_TAG, "Submitting request to " << state->m_url);
+
+    //this may run on the event loop itself, e.g. for a retry, so the write limiter delays the transfer on a loop timer instead of sleeping.
+    std::chrono::milliseconds submitDelay(0);
+    if (writeLimiter != nullptr)
+    {
+        submitDelay = writeLimiter->ApplyCost(request.GetSize());
+    }
+
+    state->m_headers = BuildHeaderList(request);
+
+    CurlEventLoop* eventLoop = GetNextEventLoop();
+    long connectTimeout = m_connectTimeout;
+    long requestTimeout = m_requestTimeout;
+    auto submitted = std::chrono::steady_clock::now();
+    auto configure = [this, state, eventLoop, connectTimeout, requestTimeout, submitted](CURL* connectionHandle)
+    {
+        state->m_connectionHandle = connectionHandle;
+        if (state->m_writeContext.m_rateLimiter || state->m_readContext.m_rateLimiter)
+        {
+            //throttled transfers are paused by their callbacks and resumed from a loop timer.
+            std::weak_ptr<CurlMultiRequestState> weakState = state;
+            auto scheduleResume = [eventLoop, weakState, connectionHandle](std::chrono::milliseconds delay)
+            {
+                eventLoop->Schedule(delay, [weakState, connectionHandle](bool cancelled)
+                {
+                    auto pausedState = weakState.lock();
+                    if (!cancelled && pausedState && pausedState->m_connectionHandle == connectionHandle)
+                    {
+                        curl_easy_pause(connectionHandle, CURLPAUSE_CONT);
+                    }
+                });
+            };
+            state->m_writeContext.m_scheduleResume = scheduleResume;
+            state->m_readContext.m_scheduleResume = scheduleResume;
+        }
+
+        //the wait for the event loop to pick the transfer up and hand it a handle stands in for the connection pool wait.
+        HttpTransferMetrics transferMetrics;
+        transferMetrics.connectionAcquireTime = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - submitted);
+        state->m_response->SetTransferMetrics(transferMetrics);
+
+        //same defaults CurlHandleContainer applies to its handles.
+        curl_easy_setopt(connectionHandle, CURLOPT_NOSIGNAL, 1L);
+        curl_easy_setopt(connectionHandle, CURLOPT_TIMEOUT_MS, 0L);
+        curl_easy_setopt(connectionHandle, CURLOPT_CONNECTTIMEOUT_MS, connectTimeout);
+        curl_easy_setopt(connectionHandle, CURLOPT_LOW_SPEED_LIMIT, 1L);
+        curl_easy_setopt(connectionHandle, CURLOPT_LOW_SPEED_TIME, requestTimeout / 1000);
+
+        ConfigureConnectionHandle(connectionHandle, state->m_request, state->m_url, state->m_headers, state->m_writeContext, state->m_readContext);
+    };
+
+    auto completed = [this, state, onCompleted](CURL* connectionHandle, CURLcode curlResponseCode)
+    {
+        state->m_connectionHandle = nullptr;
+        std::shared_ptr<HttpResponse> response = state->m_response;
+        if (connectionHandle)
+        {
+            FinalizeResponse(connectionHandle, curlResponseCode, state->m_request, response, state->m_writeContext);
+        }
+        else
+        {
+            response = nullptr;
+        }
+
+        //go ahead and flush the response body stream
+        if (response)
+        {
+            response->GetResponseBody().flush();
+        }
+        onCompleted(response);
+    };
+
+    if (submitDelay.count() > 0)
+    {
+        eventLoop->Schedule(submitDelay, [eventLoop, configure, completed](bool cancelled) mutable
+        {
+            if (cancelled)
+            {
+                completed(nullptr, CURLE_ABORTED_BY_CALLBACK);
+                return;
+            }
+            eventLoop->AddTransfer(std::move(configure), std::move(completed));
+        });
+        return;
+    }
+
+    eventLoop->AddTransfer(std::move(configure), std::move(completed));
+}
+
+CurlEventLoop* CurlMultiHttpClient::GetNextEventLoop() const
+{
+    return m_eventLoops[m_nextEventLoop++ % m_eventLoops.size()];
+}
+
+bool CurlMultiHttpClient::IsEventLoopThread() const
+{
+    auto currentThread = std::this_thread::get_id();
+    for (CurlEventLoop* eventLoop : m_eventLoops)
+    {
+        if (eventLoop->GetThreadId() == currentThread)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+#endif // !defined(_WIN32)
@@ -24,6 +24,25 @@ using namespace Aws::Http;
 using namespace Aws::Http::Standard;
 using namespace Aws::Utils;
 
+static const char* STANDARD_HTTP_RESPONSE_TAG = "StandardHttpResponse";
+
+StandardHttpResponse::StandardHttpResponse(const HttpRequest& originatingRequest) :
+    HttpResponse(originatingRequest),
+    headerMap(),
+    bodyStream(),
+    bodySink(nullptr)
+{
+    const auto& sinkFactory = originatingRequest.GetResponseBodySinkFactory();
+    if (sinkFactory)
+    {
+        bodySink = sinkFactory();
+        bodyStream = Stream::ResponseStream(Aws::New<Stream::ResponseBodySinkStream>(STANDARD_HTTP_RESPONSE_TAG, bodySink));
+    }
+    else
+    {
+        bodyStream = Stream::ResponseStream(originatingRequest.GetResponseStreamFactory());
+    }
+}
 
 HeaderValueCollection StandardHttpResponse::GetHeaders() const
 {
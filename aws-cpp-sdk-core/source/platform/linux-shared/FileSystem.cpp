@@ -23,11 +23,14 @@
 #include <unistd.h>
 #include <pwd.h>
 #include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
 #include <dirent.h>
 #include <errno.h>
 #include <climits>
 
 #include <cassert>
+#include <cstdint>
 
 namespace Aws
 {
@@ -273,5 +276,216 @@ std::shared_ptr<Directory> OpenDirectory(const Aws::String& path, const Aws::Str
     return Aws::MakeShared<PosixDirectory>(FILE_SYSTEM_UTILS_LOG_TAG, path, relativePath);
 }
 
+
+MappedFile::MappedFile(const char* fileName) :
+    m_data(nullptr),
+    m_length(0),
+    m_isValid(false)
+{
+    int fd = open(fileName, O_RDONLY);
+    if (fd == -1)
+    {
+        AWS_LOGSTREAM_ERROR(FILE_SYSTEM_UTILS_LOG_TAG, "Unable to open file " << fileName << " for mapping, errno: " << errno);
+        return;
+    }
+
+    struct stat fileStat;
+    if (fstat(fd, &fileStat) == 0 && static_cast<uint64_t>(fileStat.st_size) <= static_cast<uint64_t>(SIZE_MAX))
+    {
+        m_length = static_cast<size_t>(fileStat.st_size);
+        if (m_length == 0)
+        {
+            m_isValid = true;
+        }
+        else
+        {
+            void* data = mmap(nullptr, m_length, PROT_READ, MAP_SHARED, fd, 0);
+            if (data != MAP_FAILED)
+            {
+                m_data = data;
+                m_isValid = true;
+            }
+        }
+    }
+
+    if (!m_isValid)
+    {
+        AWS_LOGSTREAM_ERROR(FILE_SYSTEM_UTILS_LOG_TAG, "Unable to map file " << fileName << ", errno: " << errno);
+        m_length = 0;
+    }
+
+    // the mapping stays valid after the descriptor is closed
+    close(fd);
+}
+
+MappedFile::~MappedFile()
+{
+    if (m_data)
+    {
+        munmap(m_data, m_length);
+    }
+}
+
+PositionedWriteFile::PositionedWriteFile(const char* fileName, bool truncate) :
+    m_fd(-1),
+    m_isValid(false)
+{
+    m_fd = open(fileName, O_WRONLY | O_CREAT | (truncate ? O_TRUNC : 0), S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH);
+    if (m_fd == -1)
+    {
+        AWS_LOGSTREAM_ERROR(FILE_SYSTEM_UTILS_LOG_TAG, "Unable to open file " << fileName << " for writing, errno: " << errno);
+        return;
+    }
+
+    m_isValid = true;
+}
+
+PositionedWriteFile::~PositionedWriteFile()
+{
+    if (m_fd != -1)
+    {
+        close(m_fd);
+    }
+}
+
+bool PositionedWriteFile::Preallocate(uint64_t length)
+{
+    if (!m_isValid)
+    {
+        return false;
+    }
+
+#if defined(__linux__)
+    int result = posix_fallocate(m_fd, 0, static_cast<off_t>(length));
+    if (result == 0)
+    {
+        return true;
+    }
+    // file systems without fallocate support report EOPNOTSUPP or EINVAL, fall back to extending the file
+    AWS_LOGSTREAM_DEBUG(FILE_SYSTEM_UTILS_LOG_TAG, "posix_fallocate failed, errno: " << result << ", extending the file instead");
+#endif
+
+    // never shrink the file, only extend it
+    struct stat fileStat;
+    if (fstat(m_fd, &fileStat) == 0 && static_cast<uint64_t>(fileStat.st_size) >= length)
+    {
+        return true;
+    }
+
+    if (ftruncate(m_fd, static_cast<off_t>(length)) != 0)
+    {
+        AWS_LOGSTREAM_ERROR(FILE_SYSTEM_UTILS_LOG_TAG, "Unable to extend file to " << length << " bytes, errno: " << errno);
+        return false;
+    }
+
+    return true;
+}
+
+bool PositionedWriteFile::WriteAt(const unsigned char* data, size_t length, uint64_t offset)
+{
+    if (!m_isValid)
+    {
+        return false;
+    }
+
+    while (length > 0)
+    {
+        ssize_t written = pwrite(m_fd, data, length, static_cast<off_t>(offset));
+        if (written < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+
+            AWS_LOGSTREAM_ERROR(FILE_SYSTEM_UTILS_LOG_TAG, "Positioned write of " << length << " bytes at offset " << offset << " failed, errno: " << errno);
+            return false;
+        }
+
+        data += written;
+        length -= static_cast<size_t>(written);
+        offset += static_cast<uint64_t>(written);
+    }
+
+    return true;
+}
+
+bool PositionedWriteFile::Sync()
+{
+    if (!m_isValid)
+    {
+        return false;
+    }
+
+#if defined(__linux__)
+    if (fdatasync(m_fd) != 0)
+#else
+    if (fsync(m_fd) != 0)
+#endif
+    {
+        AWS_LOGSTREAM_ERROR(FILE_SYSTEM_UTILS_LOG_TAG, "Unable to sync file, errno: " << errno);
+        return false;
+    }
+
+    return true;
+}
+
+PositionedReadFile::PositionedReadFile(const char* fileName) :
+    m_fd(-1),
+    m_isValid(false)
+{
+    m_fd = open(fileName, O_RDONLY);
+    if (m_fd == -1)
+    {
+        AWS_LOGSTREAM_ERROR(FILE_SYSTEM_UTILS_LOG_TAG, "Unable to open file " << fileName << " for reading, errno: " << errno);
+        return;
+    }
+
+    m_isValid = true;
+}
+
+PositionedReadFile::~PositionedReadFile()
+{
+    if (m_fd != -1)
+    {
+        close(m_fd);
+    }
+}
+
+bool PositionedReadFile::ReadAt(unsigned char* data, size_t length, uint64_t offset) const
+{
+    if (!m_isValid)
+    {
+        return false;
+    }
+
+    while (length > 0)
+    {
+        ssize_t bytesRead = pread(m_fd, data, length, static_cast<off_t>(offset));
+        if (bytesRead < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+
+            AWS_LOGSTREAM_ERROR(FILE_SYSTEM_UTILS_LOG_TAG, "Positioned read of " << length << " bytes at offset " << offset << " failed, errno: " << errno);
+            return false;
+        }
+
+        if (bytesRead == 0)
+        {
+            AWS_LOGSTREAM_ERROR(FILE_SYSTEM_UTILS_LOG_TAG, "File ended " << length << " bytes short of a positioned read at offset " << offset);
+            return false;
+        }
+
+        data += bytesRead;
+        length -= static_cast<size_t>(bytesRead);
+        offset += static_cast<uint64_t>(bytesRead);
+    }
+
+    return true;
+}
+
 } // namespace FileSystem
 } // namespace Aws
@@ -18,6 +18,7 @@
 #include <aws/core/utils/logging/LogMacros.h>
 #include <aws/core/utils/StringUtils.h>
 #include <cassert>
+#include <cstdint>
 #include <iostream>
 #include <Userenv.h>
 
@@ -307,5 +308,211 @@ std::shared_ptr<Directory> OpenDirectory(const Aws::String& path, const Aws::Str
     return Aws::MakeShared<User32Directory>(FILE_SYSTEM_UTILS_LOG_TAG, path, relativePath);
 }
 
+
+MappedFile::MappedFile(const char* fileName) :
+    m_data(nullptr),
+    m_length(0),
+    m_isValid(false)
+{
+    HANDLE file = CreateFileW(Aws::Utils::StringUtils::ToWString(fileName).c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+            FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        AWS_LOGSTREAM_ERROR(FILE_SYSTEM_UTILS_LOG_TAG, "Unable to open file " << fileName << " for mapping, error code: " << GetLastError());
+        return;
+    }
+
+    LARGE_INTEGER fileSize;
+    if (GetFileSizeEx(file, &fileSize) && static_cast<uint64_t>(fileSize.QuadPart) <= static_cast<uint64_t>(SIZE_MAX))
+    {
+        m_length = static_cast<size_t>(fileSize.QuadPart);
+        if (m_length == 0)
+        {
+            m_isValid = true;
+        }
+        else
+        {
+            HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (mapping)
+            {
+                m_data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+                m_isValid = m_data != nullptr;
+                // the view keeps the mapping alive
+                CloseHandle(mapping);
+            }
+        }
+    }
+
+    if (!m_isValid)
+    {
+        AWS_LOGSTREAM_ERROR(FILE_SYSTEM_UTILS_LOG_TAG, "Unable to map file " << fileName << ", error code: " << GetLastError());
+        m_length = 0;
+    }
+
+    CloseHandle(file);
+}
+
+MappedFile::~MappedFile()
+{
+    if (m_data)
+    {
+        UnmapViewOfFile(m_data);
+    }
+}
+
+PositionedWriteFile::PositionedWriteFile(const char* fileName, bool truncate) :
+    m_handle(INVALID_HANDLE_VALUE),
+    m_isValid(false)
+{
+    HANDLE file = CreateFileW(Aws::Utils::StringUtils::ToWString(fileName).c_str(), GENERIC_WRITE, FILE_SHARE_READ, nullptr,
+            truncate ? CREATE_ALWAYS : OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        AWS_LOGSTREAM_ERROR(FILE_SYSTEM_UTILS_LOG_TAG, "Unable to open file " << fileName << " for writing, error code: " << GetLastError());
+        return;
+    }
+
+    m_handle = file;
+    m_isValid = true;
+}
+
+PositionedWriteFile::~PositionedWriteFile()
+{
+    if (m_handle != INVALID_HANDLE_VALUE)
+    {
+        CloseHandle(m_handle);
+    }
+}
+
+bool PositionedWriteFile::Preallocate(uint64_t length)
+{
+    if (!m_isValid)
+    {
+        return false;
+    }
+
+    // never shrink the file, only extend it
+    LARGE_INTEGER fileSize;
+    if (GetFileSizeEx(m_handle, &fileSize) && static_cast<uint64_t>(fileSize.QuadPart) >= length)
+    {
+        return true;
+    }
+
+    // setting the end of file allocates the space, the file position is not used by WriteAt
+    LARGE_INTEGER newSize;
+    newSize.QuadPart = static_cast<LONGLONG>(length);
+    if (!SetFilePointerEx(m_handle, newSize, nullptr, FILE_BEGIN) || !SetEndOfFile(m_handle))
+    {
+        AWS_LOGSTREAM_ERROR(FILE_SYSTEM_UTILS_LOG_TAG, "Unable to extend file to " << length << " bytes, error code: " << GetLastError());
+        return false;
+    }
+
+    return true;
+}
+
+bool PositionedWriteFile::WriteAt(const unsigned char* data, size_t length, uint64_t offset)
+{
+    if (!m_isValid)
+    {
+        return false;
+    }
+
+    while (length > 0)
+    {
+        OVERLAPPED overlapped = {};
+        overlapped.Offset = static_cast<DWORD>(offset & 0xFFFFFFFF);
+        overlapped.OffsetHigh = static_cast<DWORD>(offset >> 32);
+
+        DWORD toWrite = static_cast<DWORD>(length > MAXDWORD ? MAXDWORD : length);
+        DWORD written = 0;
+        if (!WriteFile(m_handle, data, toWrite, &written, &overlapped))
+        {
+            AWS_LOGSTREAM_ERROR(FILE_SYSTEM_UTILS_LOG_TAG, "Positioned write of " << length << " bytes at offset " << offset << " failed, error code: " << GetLastError());
+            return false;
+        }
+
+        data += written;
+        length -= written;
+        offset += written;
+    }
+
+    return true;
+}
+
+bool PositionedWriteFile::Sync()
+{
+    if (!m_isValid)
+    {
+        return false;
+    }
+
+    if (!FlushFileBuffers(m_handle))
+    {
+        AWS_LOGSTREAM_ERROR(FILE_SYSTEM_UTILS_LOG_TAG, "Unable to sync file, error code: " << GetLastError());
+        return false;
+    }
+
+    return true;
+}
+
+PositionedReadFile::PositionedReadFile(const char* fileName) :
+    m_handle(INVALID_HANDLE_VALUE),
+    m_isValid(false)
+{
+    HANDLE file = CreateFileW(Aws::Utils::StringUtils::ToWString(fileName).c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr,
+            OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        AWS_LOGSTREAM_ERROR(FILE_SYSTEM_UTILS_LOG_TAG, "Unable to open file " << fileName << " for reading, error code: " << GetLastError());
+        return;
+    }
+
+    m_handle = file;
+    m_isValid = true;
+}
+
+PositionedReadFile::~PositionedReadFile()
+{
+    if (m_handle != INVALID_HANDLE_VALUE)
+    {
+        CloseHandle(m_handle);
+    }
+}
+
+bool PositionedReadFile::ReadAt(unsigned char* data, size_t length, uint64_t offset) const
+{
+    if (!m_isValid)
+    {
+        return false;
+    }
+
+    while (length > 0)
+    {
+        OVERLAPPED overlapped = {};
+        overlapped.Offset = static_cast<DWORD>(offset & 0xFFFFFFFF);
+        overlapped.OffsetHigh = static_cast<DWORD>(offset >> 32);
+
+        DWORD toRead = static_cast<DWORD>(length > MAXDWORD ? MAXDWORD : length);
+        DWORD bytesRead = 0;
+        if (!ReadFile(m_handle, data, toRead, &bytesRead, &overlapped) && GetLastError() != ERROR_HANDLE_EOF)
+        {
+            AWS_LOGSTREAM_ERROR(FILE_SYSTEM_UTILS_LOG_TAG, "Positioned read of " << length << " bytes at offset " << offset << " failed, error code: " << GetLastError());
+            return false;
+        }
+
+        if (bytesRead == 0)
+        {
+            AWS_LOGSTREAM_ERROR(FILE_SYSTEM_UTILS_LOG_TAG, "File ended " << length << " bytes short of a positioned read at offset " << offset);
+            return false;
+        }
+
+        data += bytesRead;
+        length -= bytesRead;
+        offset += bytesRead;
+    }
+
+    return true;
+}
+
 } // namespace FileSystem
 } // namespace Aws
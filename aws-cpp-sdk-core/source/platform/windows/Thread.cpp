@@ -0,0 +1,36 @@
+/*
+  * Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+  *
+  * Licensed under the Apache License, Version 2.0 (the "License").
+  * You may not use this file except in compliance with the License.
+  * A copy of the License is located at
+  *
+  *  http://aws.amazon.com/apache2.0
+  *
+  * or in the "license" file accompanying this file. This file is distributed
+  * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+  * express or implied. See the License for the specific language governing
+  * permissions and limitations under the License.
+  */
+
+#include <aws/core/platform/Thread.h>
+
+#include <windows.h>
+
+namespace Aws
+{
+namespace Thread
+{
+
+bool PinCurrentThreadToCore(size_t core)
+{
+    if (core >= sizeof(DWORD_PTR) * 8)
+    {
+        return false;
+    }
+
+    return SetThreadAffinityMask(GetCurrentThread(), static_cast<DWORD_PTR>(1) << core) != 0;
+}
+
+} // namespace Thread
+} // namespace Aws
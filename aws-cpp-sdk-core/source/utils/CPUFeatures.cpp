@@ -0,0 +1,92 @@
+/*
+* Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+*
+* Licensed under the Apache License, Version 2.0 (the "License").
+* You may not use this file except in compliance with the License.
+* A copy of the License is located at
+*
+*  http://aws.amazon.com/apache2.0
+*
+* or in the "license" file accompanying this file. This file is distributed
+* on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+* express or implied. See the License for the specific language governing
+* permissions and limitations under the License.
+*/
+
+#include <aws/core/utils/CPUFeatures.h>
+
+#include <atomic>
+
+#if defined(AWS_X86_SIMD) && defined(_MSC_VER)
+#include <intrin.h>
+#include <immintrin.h>
+#endif
+
+using namespace Aws::Utils;
+
+static const int FEATURE_SSSE3 = 1;
+static const int FEATURE_AVX2 = 2;
+static const int FEATURES_UNKNOWN = -1;
+
+static std::atomic<int> s_features(FEATURES_UNKNOWN);
+static std::atomic<bool> s_simdEnabled(true);
+
+static int DetectFeatures()
+{
+    int features = 0;
+#if defined(AWS_X86_SIMD) && defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    int maxLeaf = info[0];
+    __cpuid(info, 1);
+    bool ssse3 = (info[2] & (1 << 9)) != 0;
+    //avx2 also needs the os to save the ymm registers.
+    bool osSavesYmm = (info[2] & (1 << 27)) != 0 && (info[2] & (1 << 28)) != 0 && (_xgetbv(0) & 6) == 6;
+    bool avx2 = false;
+    if (maxLeaf >= 7)
+    {
+        __cpuidex(info, 7, 0);
+        avx2 = osSavesYmm && (info[1] & (1 << 5)) != 0;
+    }
+    features |= ssse3 ? FEATURE_SSSE3 : 0;
+    features |= avx2 ? FEATURE_AVX2 : 0;
+#elif defined(AWS_X86_SIMD)
+    __builtin_cpu_init();
+    features |= __builtin_cpu_supports("ssse3") ? FEATURE_SSSE3 : 0;
+    features |= __builtin_cpu_supports("avx2") ? FEATURE_AVX2 : 0;
+#endif
+    return features;
+}
+
+static bool HasFeature(int feature)
+{
+    if (!s_simdEnabled.load(std::memory_order_relaxed))
+    {
+        return false;
+    }
+
+    int features = s_features.load(std::memory_order_relaxed);
+    if (features == FEATURES_UNKNOWN)
+    {
+        //detection is idempotent, racing threads just store the same value.
+        features = DetectFeatures();
+        s_features.store(features, std::memory_order_relaxed);
+    }
+
+    return (features & feature) != 0;
+}
+
+bool CPUFeatures::HasSSSE3()
+{
+    return HasFeature(FEATURE_SSSE3);
+}
+
+bool CPUFeatures::HasAVX2()
+{
+    return HasFeature(FEATURE_AVX2);
+}
+
+void CPUFeatures::SetSIMDEnabled(bool enabled)
+{
+    s_simdEnabled.store(enabled, std::memory_order_relaxed);
+}
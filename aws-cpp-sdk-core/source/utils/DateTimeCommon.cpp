@@ -27,6 +27,10 @@ static const char* CLASS_TAG = "DateTime";
 static const char* RFC822_DATE_FORMAT_STR_MINUS_Z = "%a, %d %b %Y %H:%M:%S";
 static const char* RFC822_DATE_FORMAT_STR_WITH_Z = "%a, %d %b %Y %H:%M:%S %Z";
 static const char* ISO_8601_LONG_DATE_FORMAT_STR = "%Y-%m-%dT%H:%M:%SZ";
+static const char* ISO_8601_BASIC_DATE_FORMAT_STR = "%Y%m%dT%H%M%SZ";
+static const char* WEEK_DAY_NAMES[] = { "Sun", "Mon", "Tue", "Wed", "Thu", "Fri", "Sat" };
+static const char* MONTH_NAMES[] = { "Jan", "Feb", "Mar", "Apr", "May", "Jun", "Jul", "Aug", "Sep", "Oct", "Nov", "Dec" };
+static const int64_t SECONDS_PER_DAY = 86400;
 
 using namespace Aws::Utils;
 
@@ -481,6 +485,155 @@ static bool IsUtcTimeZone(const char* str)
     
 }
 
+//Days since 1970-01-01 of the proleptic gregorian date year-month-day, month 1-12. Works in whole 400 year eras so it needs neither
+//gmtime/timegm nor a std::tm, see http://howardhinnant.github.io/date_algorithms.html
+static int64_t DaysFromCivil(int64_t year, unsigned month, unsigned day)
+{
+    year -= month <= 2 ? 1 : 0;
+    const int64_t era = (year >= 0 ? year : year - 399) / 400;
+    const unsigned yearOfEra = static_cast<unsigned>(year - era * 400);
+    const unsigned dayOfYear = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+    const unsigned dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+    return era * 146097 + static_cast<int64_t>(dayOfEra) - 719468;
+}
+
+//Inverse of DaysFromCivil.
+static void CivilFromDays(int64_t days, int64_t& year, unsigned& month, unsigned& day)
+{
+    days += 719468;
+    const int64_t era = (days >= 0 ? days : days - 146096) / 146097;
+    const unsigned dayOfEra = static_cast<unsigned>(days - era * 146097);
+    const unsigned yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+    const unsigned dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+    const unsigned shiftedMonth = (5 * dayOfYear + 2) / 153;
+    day = dayOfYear - (153 * shiftedMonth + 2) / 5 + 1;
+    month = shiftedMonth < 10 ? shiftedMonth + 3 : shiftedMonth - 9;
+    year = static_cast<int64_t>(yearOfEra) + era * 400 + (month <= 2 ? 1 : 0);
+}
+
+static inline char* WriteDigits(char* out, unsigned value, int digits)
+{
+    for (int i = digits - 1; i >= 0; --i)
+    {
+        out[i] = static_cast<char>('0' + value % 10);
+        value /= 10;
+    }
+    return out + digits;
+}
+
+//Reads exactly digits decimal digits, returns false if any of them is not a digit.
+static inline bool ReadDigits(const char* in, int digits, unsigned& value)
+{
+    value = 0;
+    for (int i = 0; i < digits; ++i)
+    {
+        unsigned digit = static_cast<unsigned>(in[i] - '0');
+        if (digit > 9)
+        {
+            return false;
+        }
+        value = value * 10 + digit;
+    }
+    return true;
+}
+
+static bool IsCanonicalTime(unsigned month, unsigned day, unsigned hour, unsigned minute, unsigned second)
+{
+    return month >= 1 && month <= 12 && day >= 1 && day <= 31 && hour <= 23 && minute <= 59 && second <= 59;
+}
+
+static int64_t ToEpochSeconds(unsigned year, unsigned month, unsigned day, unsigned hour, unsigned minute, unsigned second)
+{
+    return DaysFromCivil(year, month, day) * SECONDS_PER_DAY + hour * 3600 + minute * 60 + second;
+}
+
+//Strict single pass parse of the canonical "%Y-%m-%dT%H:%M:%SZ" and "%Y-%m-%dT%H:%M:%S.<fraction>Z" forms, which is what services send.
+//Anything else, including out of range fields that timegm would normalize, is left to ISO_8601DateParser. Like that parser, the
+//fraction is dropped.
+static bool TryParseCanonicalISO_8601(const char* timestamp, int64_t& epochSeconds)
+{
+    unsigned year, month, day, hour, minute, second;
+    if (!ReadDigits(timestamp, 4, year) || timestamp[4] != '-' || !ReadDigits(timestamp + 5, 2, month) || timestamp[7] != '-' ||
+        !ReadDigits(timestamp + 8, 2, day) || timestamp[10] != 'T' || !ReadDigits(timestamp + 11, 2, hour) || timestamp[13] != ':' ||
+        !ReadDigits(timestamp + 14, 2, minute) || timestamp[16] != ':' || !ReadDigits(timestamp + 17, 2, second))
+    {
+        return false;
+    }
+
+    const char* end = timestamp + 19;
+    if (*end == '.')
+    {
+        ++end;
+        const char* fractionStart = end;
+        while (*end >= '0' && *end <= '9')
+        {
+            ++end;
+        }
+        if (end == fractionStart)
+        {
+            return false;
+        }
+    }
+
+    if (end[0] != 'Z' || end[1] != '\0' || !IsCanonicalTime(month, day, hour, minute, second))
+    {
+        return false;
+    }
+
+    epochSeconds = ToEpochSeconds(year, month, day, hour, minute, second);
+    return true;
+}
+
+//Strict parse of the compact "%Y%m%dT%H%M%SZ" form, there is no state machine behind this one.
+static bool TryParseISO_8601Basic(const char* timestamp, int64_t& epochSeconds)
+{
+    unsigned year, month, day, hour, minute, second;
+    if (!ReadDigits(timestamp, 4, year) || !ReadDigits(timestamp + 4, 2, month) || !ReadDigits(timestamp + 6, 2, day) ||
+        timestamp[8] != 'T' || !ReadDigits(timestamp + 9, 2, hour) || !ReadDigits(timestamp + 11, 2, minute) ||
+        !ReadDigits(timestamp + 13, 2, second) || timestamp[15] != 'Z' || timestamp[16] != '\0' ||
+        !IsCanonicalTime(month, day, hour, minute, second))
+    {
+        return false;
+    }
+
+    epochSeconds = ToEpochSeconds(year, month, day, hour, minute, second);
+    return true;
+}
+
+//Strict parse of the canonical "%a, %d %b %Y %H:%M:%S GMT" form. Anything else goes through RFC822DateParser.
+static bool TryParseCanonicalRFC822(const char* timestamp, int64_t& epochSeconds)
+{
+    if (strlen(timestamp) != DateTime::RFC822_LENGTH || timestamp[3] != ',' || timestamp[4] != ' ' || timestamp[7] != ' ' ||
+        timestamp[11] != ' ' || timestamp[16] != ' ' || timestamp[19] != ':' || timestamp[22] != ':' || timestamp[25] != ' ' ||
+        strcmp(timestamp + 26, "GMT") != 0)
+    {
+        return false;
+    }
+
+    bool validWeekDay = false;
+    for (auto weekDay : WEEK_DAY_NAMES)
+    {
+        validWeekDay = validWeekDay || strncmp(timestamp, weekDay, 3) == 0;
+    }
+
+    unsigned month = 0;
+    for (unsigned i = 0; i < 12 && month == 0; ++i)
+    {
+        month = strncmp(timestamp + 8, MONTH_NAMES[i], 3) == 0 ? i + 1 : 0;
+    }
+
+    unsigned year, day, hour, minute, second;
+    if (!validWeekDay || month == 0 || !ReadDigits(timestamp + 5, 2, day) || !ReadDigits(timestamp + 12, 4, year) ||
+        !ReadDigits(timestamp + 17, 2, hour) || !ReadDigits(timestamp + 20, 2, minute) || !ReadDigits(timestamp + 23, 2, second) ||
+        !IsCanonicalTime(month, day, hour, minute, second))
+    {
+        return false;
+    }
+
+    epochSeconds = ToEpochSeconds(year, month, day, hour, minute, second);
+    return true;
+}
+
 class DateParser
 {
 public:
@@ -863,6 +1016,10 @@ private:
     int m_state;
 };
 
+const size_t DateTime::RFC822_LENGTH;
+const size_t DateTime::ISO_8601_LENGTH;
+const size_t DateTime::ISO_8601_BASIC_LENGTH;
+
 DateTime::DateTime(const std::chrono::system_clock::time_point& timepointToAssign) : m_time(timepointToAssign), m_valid(true)
 {   
 }
@@ -962,6 +1119,8 @@ Aws::String DateTime::ToLocalTimeString(DateFormat format) const
     {
     case DateFormat::ISO_8601:
         return ToLocalTimeString(ISO_8601_LONG_DATE_FORMAT_STR);
+    case DateFormat::ISO_8601_BASIC:
+        return ToLocalTimeString(ISO_8601_BASIC_DATE_FORMAT_STR);
     case DateFormat::RFC822:
         return ToLocalTimeString(RFC822_DATE_FORMAT_STR_WITH_Z);   
     default:
@@ -981,10 +1140,20 @@ Aws::String DateTime::ToLocalTimeString(const char* formatStr) const
 
 Aws::String DateTime::ToGmtString(DateFormat format) const
 {
+    char formattedString[RFC822_LENGTH + 1];
+    size_t length = ToGmtString(format, formattedString, sizeof(formattedString));
+    if (length > 0)
+    {
+        return Aws::String(formattedString, length);
+    }
+
+    //only years that don't fit in four digits get here.
     switch (format)
     {
     case DateFormat::ISO_8601:
         return ToGmtString(ISO_8601_LONG_DATE_FORMAT_STR);
+    case DateFormat::ISO_8601_BASIC:
+        return ToGmtString(ISO_8601_BASIC_DATE_FORMAT_STR);
     case DateFormat::RFC822:
     {
         //Windows erronously drops the local timezone in for %Z
@@ -1007,6 +1176,99 @@ Aws::String DateTime::ToGmtString(const char* formatStr) const
     return formattedString;
 }
 
+size_t DateTime::ToGmtString(DateFormat format, char* buffer, size_t bufferSize) const
+{
+    int64_t millis = Millis();
+    int64_t seconds = millis / 1000 - (millis % 1000 < 0 ? 1 : 0);
+    int64_t days = seconds / SECONDS_PER_DAY - (seconds % SECONDS_PER_DAY < 0 ? 1 : 0);
+    unsigned secondOfDay = static_cast<unsigned>(seconds - days * SECONDS_PER_DAY);
+
+    int64_t year;
+    unsigned month, day;
+    CivilFromDays(days, year, month, day);
+    if (year < 0 || year > 9999)
+    {
+        return 0;
+    }
+
+    unsigned hour = secondOfDay / 3600;
+    unsigned minute = secondOfDay / 60 % 60;
+    unsigned second = secondOfDay % 60;
+    char* out = buffer;
+
+    switch (format)
+    {
+    case DateFormat::ISO_8601:
+        if (bufferSize <= ISO_8601_LENGTH)
+        {
+            return 0;
+        }
+        out = WriteDigits(out, static_cast<unsigned>(year), 4);
+        *out++ = '-';
+        out = WriteDigits(out, month, 2);
+        *out++ = '-';
+        out = WriteDigits(out, day, 2);
+        *out++ = 'T';
+        out = WriteDigits(out, hour, 2);
+        *out++ = ':';
+        out = WriteDigits(out, minute, 2);
+        *out++ = ':';
+        out = WriteDigits(out, second, 2);
+        *out++ = 'Z';
+        break;
+    case DateFormat::ISO_8601_BASIC:
+        if (bufferSize <= ISO_8601_BASIC_LENGTH)
+        {
+            return 0;
+        }
+        out = WriteDigits(out, static_cast<unsigned>(year), 4);
+        out = WriteDigits(out, month, 2);
+        out = WriteDigits(out, day, 2);
+        *out++ = 'T';
+        out = WriteDigits(out, hour, 2);
+        out = WriteDigits(out, minute, 2);
+        out = WriteDigits(out, second, 2);
+        *out++ = 'Z';
+        break;
+    case DateFormat::RFC822:
+    {
+        if (bufferSize <= RFC822_LENGTH)
+        {
+            return 0;
+        }
+        //1970-01-01 was a Thursday.
+        const char* weekDay = WEEK_DAY_NAMES[(days % 7 + 11) % 7];
+        const char* monthName = MONTH_NAMES[month - 1];
+        *out++ = weekDay[0];
+        *out++ = weekDay[1];
+        *out++ = weekDay[2];
+        *out++ = ',';
+        *out++ = ' ';
+        out = WriteDigits(out, day, 2);
+        *out++ = ' ';
+        *out++ = monthName[0];
+        *out++ = monthName[1];
+        *out++ = monthName[2];
+        *out++ = ' ';
+        out = WriteDigits(out, static_cast<unsigned>(year), 4);
+        *out++ = ' ';
+        out = WriteDigits(out, hour, 2);
+        *out++ = ':';
+        out = WriteDigits(out, minute, 2);
+        *out++ = ':';
+        out = WriteDigits(out, second, 2);
+        memcpy(out, " GMT", 4);
+        out += 4;
+        break;
+    }
+    default:
+        return 0;
+    }
+
+    *out = '\0';
+    return static_cast<size_t>(out - buffer);
+}
+
 double DateTime::SecondsWithMSPrecision() const
 {
     std::chrono::duration<double, std::chrono::seconds::period> timestamp(m_time.time_since_epoch());
@@ -1106,6 +1368,38 @@ std::chrono::milliseconds DateTime::Diff(const DateTime& a, const DateTime& b)
 
 void DateTime::ConvertTimestampStringToTimePoint(const char* timestamp, DateFormat format)
 {  
+    //the canonical forms are by far the most common, parse them without the state machines, std::tm and timegm.
+    int64_t epochSeconds = 0;
+    bool fastPathParsed = false;
+    switch (format)
+    {
+    case DateFormat::RFC822:
+        fastPathParsed = TryParseCanonicalRFC822(timestamp, epochSeconds);
+        break;
+    case DateFormat::ISO_8601:
+        fastPathParsed = TryParseCanonicalISO_8601(timestamp, epochSeconds);
+        break;
+    case DateFormat::ISO_8601_BASIC:
+        m_valid = TryParseISO_8601Basic(timestamp, epochSeconds);
+        if (m_valid)
+        {
+            m_time = std::chrono::system_clock::time_point(std::chrono::seconds(epochSeconds));
+        }
+        return;
+    case DateFormat::AutoDetect:
+        fastPathParsed = TryParseCanonicalRFC822(timestamp, epochSeconds) || TryParseCanonicalISO_8601(timestamp, epochSeconds);
+        break;
+    default:
+        break;
+    }
+
+    if (fastPathParsed)
+    {
+        m_valid = true;
+        m_time = std::chrono::system_clock::time_point(std::chrono::seconds(epochSeconds));
+        return;
+    }
+
     std::tm timeStruct;
     bool isUtc = true;
 
@@ -18,12 +18,17 @@
 #include <aws/core/utils/base64/Base64.h>
 #include <aws/core/utils/crypto/Sha256.h>
 #include <aws/core/utils/crypto/Sha256HMAC.h>
+#include <aws/core/utils/crypto/Sha256TreeHash.h>
 #include <aws/core/utils/crypto/MD5.h>
 #include <aws/core/utils/Outcome.h>
 #include <aws/core/utils/memory/stl/AWSStringStream.h>
 #include <aws/core/utils/memory/stl/AWSList.h>
+#include <aws/core/utils/CPUFeatures.h>
 
-#include <iomanip>
+
+#ifdef AWS_X86_SIMD
+#include <immintrin.h>
+#endif
 
 using namespace Aws::Utils;
 using namespace Aws::Utils::Base64;
@@ -45,6 +50,16 @@ ByteBuffer HashingUtils::Base64Decode(const Aws::String& encodedMessage)
     return s_base64.Decode(encodedMessage);
 }
 
+size_t HashingUtils::Base64Encode(const unsigned char* data, size_t length, char* output)
+{
+    return s_base64.Encode(data, length, output);
+}
+
+size_t HashingUtils::Base64Decode(const char* encoded, size_t length, unsigned char* output)
+{
+    return s_base64.Decode(encoded, length, output);
+}
+
 ByteBuffer HashingUtils::CalculateSHA256HMAC(const ByteBuffer& toSign, const ByteBuffer& secret)
 {
     Sha256HMAC hash;
@@ -98,21 +113,8 @@ static ByteBuffer TreeHashFinalCompute(Aws::List<ByteBuffer>& input)
 
 ByteBuffer HashingUtils::CalculateSHA256TreeHash(const Aws::String& str)
 {
-    Sha256 hash;
-    if (str.size() == 0)
-    {
-        return hash.Calculate(str).GetResult();
-    }
-
-    Aws::List<ByteBuffer> input;
-    size_t pos = 0;
-    while (pos < str.size())
-    {
-        input.push_back(hash.Calculate(Aws::String(str, pos, TREE_HASH_ONE_MB)).GetResult());
-        pos += TREE_HASH_ONE_MB;
-    }
-
-    return TreeHashFinalCompute(input);
+    Sha256TreeHash treeHash;
+    return treeHash.Calculate(reinterpret_cast<const unsigned char*>(str.c_str()), str.size()).archiveTreeHash;
 }
 
 ByteBuffer HashingUtils::CalculateSHA256TreeHash(Aws::IOStream& stream)
@@ -146,17 +148,134 @@ ByteBuffer HashingUtils::CalculateSHA256TreeHash(Aws::IOStream& stream)
     return TreeHashFinalCompute(input);
 }
 
-Aws::String HashingUtils::HexEncode(const ByteBuffer& message)
+static const char HEX_DIGITS[] = "0123456789abcdef";
+
+#ifdef AWS_X86_SIMD
+AWS_TARGET_SSSE3 static size_t HexEncodeSSSE3(const unsigned char* data, size_t length, char* output)
 {
-    Aws::StringStream ss;
+    const __m128i digits = _mm_loadu_si128(reinterpret_cast<const __m128i*>(HEX_DIGITS));
+    const __m128i nibbleMask = _mm_set1_epi8(0x0f);
 
-    for (unsigned i = 0; i < message.GetLength(); ++i)
+    size_t consumed = 0;
+    for (; consumed + 16 <= length; consumed += 16, output += 32)
     {
-        ss << std::hex << std::setw(2) << std::setfill('0')
-            << (unsigned int) message[i];
+        const __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + consumed));
+        const __m128i hiChars = _mm_shuffle_epi8(digits, _mm_and_si128(_mm_srli_epi16(in, 4), nibbleMask));
+        const __m128i loChars = _mm_shuffle_epi8(digits, _mm_and_si128(in, nibbleMask));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output), _mm_unpacklo_epi8(hiChars, loChars));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output + 16), _mm_unpackhi_epi8(hiChars, loChars));
     }
+    return consumed;
+}
+
+AWS_TARGET_AVX2 static size_t HexEncodeAVX2(const unsigned char* data, size_t length, char* output)
+{
+    const __m256i digits = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(HEX_DIGITS)));
+    const __m256i nibbleMask = _mm256_set1_epi8(0x0f);
 
-    return ss.str();
+    size_t consumed = 0;
+    for (; consumed + 32 <= length; consumed += 32, output += 64)
+    {
+        const __m256i in = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + consumed));
+        const __m256i hiChars = _mm256_shuffle_epi8(digits, _mm256_and_si256(_mm256_srli_epi16(in, 4), nibbleMask));
+        const __m256i loChars = _mm256_shuffle_epi8(digits, _mm256_and_si256(in, nibbleMask));
+        //unpacking works within 128 bit lanes, put the lanes back in order.
+        const __m256i low = _mm256_unpacklo_epi8(hiChars, loChars);
+        const __m256i high = _mm256_unpackhi_epi8(hiChars, loChars);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(output), _mm256_permute2x128_si256(low, high, 0x20));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(output + 32), _mm256_permute2x128_si256(low, high, 0x31));
+    }
+    return consumed;
+}
+
+//Nibble values of 16 hex digits, either case. Returns false if any of them isn't a hex digit.
+AWS_TARGET_SSSE3 static inline bool HexNibblesSSSE3(__m128i chars, __m128i& nibbles)
+{
+    const __m128i digits = _mm_sub_epi8(chars, _mm_set1_epi8('0'));
+    const __m128i isDigit = _mm_cmpeq_epi8(_mm_min_epu8(digits, _mm_set1_epi8(9)), digits);
+    const __m128i letters = _mm_sub_epi8(_mm_or_si128(chars, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+    const __m128i isLetter = _mm_cmpeq_epi8(_mm_min_epu8(letters, _mm_set1_epi8(5)), letters);
+    nibbles = _mm_or_si128(_mm_and_si128(isDigit, digits), _mm_and_si128(isLetter, _mm_add_epi8(letters, _mm_set1_epi8(10))));
+    return _mm_movemask_epi8(_mm_or_si128(isDigit, isLetter)) == 0xFFFF;
+}
+
+AWS_TARGET_SSSE3 static size_t HexDecodeSSSE3(const char* str, size_t length, unsigned char* output)
+{
+    //multiplies the high nibble of each pair by 16 and adds the low one.
+    const __m128i pairWeights = _mm_set1_epi16(0x0110);
+
+    size_t consumed = 0;
+    for (; consumed + 32 <= length; consumed += 32, output += 16)
+    {
+        __m128i first, second;
+        if (!HexNibblesSSSE3(_mm_loadu_si128(reinterpret_cast<const __m128i*>(str + consumed)), first) ||
+            !HexNibblesSSSE3(_mm_loadu_si128(reinterpret_cast<const __m128i*>(str + consumed + 16)), second))
+        {
+            break;
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output),
+            _mm_packus_epi16(_mm_maddubs_epi16(first, pairWeights), _mm_maddubs_epi16(second, pairWeights)));
+    }
+    return consumed;
+}
+
+AWS_TARGET_AVX2 static inline bool HexNibblesAVX2(__m256i chars, __m256i& nibbles)
+{
+    const __m256i digits = _mm256_sub_epi8(chars, _mm256_set1_epi8('0'));
+    const __m256i isDigit = _mm256_cmpeq_epi8(_mm256_min_epu8(digits, _mm256_set1_epi8(9)), digits);
+    const __m256i letters = _mm256_sub_epi8(_mm256_or_si256(chars, _mm256_set1_epi8(0x20)), _mm256_set1_epi8('a'));
+    const __m256i isLetter = _mm256_cmpeq_epi8(_mm256_min_epu8(letters, _mm256_set1_epi8(5)), letters);
+    nibbles = _mm256_or_si256(_mm256_and_si256(isDigit, digits), _mm256_and_si256(isLetter, _mm256_add_epi8(letters, _mm256_set1_epi8(10))));
+    return _mm256_movemask_epi8(_mm256_or_si256(isDigit, isLetter)) == -1;
+}
+
+AWS_TARGET_AVX2 static size_t HexDecodeAVX2(const char* str, size_t length, unsigned char* output)
+{
+    const __m256i pairWeights = _mm256_set1_epi16(0x0110);
+
+    size_t consumed = 0;
+    for (; consumed + 64 <= length; consumed += 64, output += 32)
+    {
+        __m256i first, second;
+        if (!HexNibblesAVX2(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(str + consumed)), first) ||
+            !HexNibblesAVX2(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(str + consumed + 32)), second))
+        {
+            break;
+        }
+        //packing works within 128 bit lanes, put the quarters back in order.
+        const __m256i packed = _mm256_packus_epi16(_mm256_maddubs_epi16(first, pairWeights), _mm256_maddubs_epi16(second, pairWeights));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(output), _mm256_permute4x64_epi64(packed, 0xD8));
+    }
+    return consumed;
+}
+#endif // AWS_X86_SIMD
+
+static inline int HexNibble(char c)
+{
+    if (c >= '0' && c <= '9')
+    {
+        return c - '0';
+    }
+    if (c >= 'a' && c <= 'f')
+    {
+        return c - 'a' + 10;
+    }
+    if (c >= 'A' && c <= 'F')
+    {
+        return c - 'A' + 10;
+    }
+    return -1;
+}
+
+Aws::String HashingUtils::HexEncode(const ByteBuffer& message)
+{
+    Aws::String encoded(message.GetLength() * 2, '\0');
+    if (!encoded.empty())
+    {
+        HexEncode(message.GetUnderlyingData(), message.GetLength(), &encoded[0]);
+    }
+
+    return encoded;
 }
 
 ByteBuffer HashingUtils::HexDecode(const Aws::String& str)
@@ -180,41 +299,70 @@ ByteBuffer HashingUtils::HexDecode(const Aws::String& str)
     }
 
     ByteBuffer hexBuffer(strLength / 2);
-    size_t bufferIndex = 0;
+    if (strLength > 0 && HexDecode(str.c_str() + readIndex, strLength, hexBuffer.GetUnderlyingData()) == 0)
+    {
+        //contains non-hex characters
+        assert(0);
+        return ByteBuffer();
+    }
+
+    return hexBuffer;
+}
 
-    for (size_t i = readIndex; i < str.length(); i += 2)
+size_t HashingUtils::HexEncode(const unsigned char* data, size_t length, char* output)
+{
+    size_t i = 0;
+#ifdef AWS_X86_SIMD
+    if (CPUFeatures::HasAVX2())
     {
-        if(!isalnum(str[i]) || !isalnum(str[i + 1]))
-        {
-            //contains non-hex characters
-            assert(0);
-        }
+        i = HexEncodeAVX2(data, length, output);
+    }
+    else if (CPUFeatures::HasSSSE3())
+    {
+        i = HexEncodeSSSE3(data, length, output);
+    }
+#endif
 
-        char firstChar = str[i];
-        uint8_t distance = firstChar - '0';
+    for (; i < length; ++i)
+    {
+        output[i * 2] = HEX_DIGITS[data[i] >> 4];
+        output[i * 2 + 1] = HEX_DIGITS[data[i] & 0x0f];
+    }
 
-        if(isalpha(firstChar))
-        {
-            firstChar = static_cast<char>(toupper(firstChar));
-            distance = firstChar - 'A' + 10;
-        }
+    return length * 2;
+}
 
-        unsigned char val = distance * 16;
+size_t HashingUtils::HexDecode(const char* str, size_t length, unsigned char* output)
+{
+    if (length % 2 != 0)
+    {
+        return 0;
+    }
 
-        char secondChar = str[i + 1];
-        distance = secondChar - '0';
+    size_t i = 0;
+#ifdef AWS_X86_SIMD
+    if (CPUFeatures::HasAVX2())
+    {
+        i = HexDecodeAVX2(str, length, output);
+    }
+    else if (CPUFeatures::HasSSSE3())
+    {
+        i = HexDecodeSSSE3(str, length, output);
+    }
+#endif
 
-        if(isalpha(secondChar))
+    for (; i < length; i += 2)
+    {
+        int high = HexNibble(str[i]);
+        int low = HexNibble(str[i + 1]);
+        if (high < 0 || low < 0)
         {
-            secondChar = static_cast<char>(toupper(secondChar));
-            distance = secondChar - 'A' + 10;
+            return 0;
         }
-
-        val += distance;
-        hexBuffer[bufferIndex++] = val;
+        output[i / 2] = static_cast<unsigned char>(high << 4 | low);
     }
 
-    return hexBuffer;
+    return length / 2;
 }
 
 ByteBuffer HashingUtils::CalculateMD5(const Aws::String& str)
@@ -0,0 +1,133 @@
+/*
+* Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+*
+* Licensed under the Apache License, Version 2.0 (the "License").
+* You may not use this file except in compliance with the License.
+* A copy of the License is located at
+*
+*  http://aws.amazon.com/apache2.0
+*
+* or in the "license" file accompanying this file. This file is distributed
+* on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+* express or implied. See the License for the specific language governing
+* permissions and limitations under the License.
+*/
+
+#include <aws/core/utils/Histogram.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+using namespace Aws::Utils;
+
+Histogram::Histogram() :
+    m_count(0),
+    m_sum(0),
+    m_min((std::numeric_limits<int64_t>::max)()),
+    m_max(0)
+{
+    for (auto& bucket : m_buckets)
+    {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+}
+
+int64_t Histogram::GetHighestTrackableValue()
+{
+    return (static_cast<int64_t>(1) << MAX_VALUE_BITS) - 1;
+}
+
+size_t Histogram::BucketIndex(int64_t value)
+{
+    uint64_t unsignedValue = static_cast<uint64_t>((std::min)(value, GetHighestTrackableValue()));
+    if (unsignedValue < 2 * SUB_BUCKET_COUNT)
+    {
+        return static_cast<size_t>(unsignedValue);
+    }
+
+    size_t highestBit = 0;
+    for (uint64_t remaining = unsignedValue >> 1; remaining; remaining >>= 1)
+    {
+        ++highestBit;
+    }
+
+    size_t shift = highestBit - SUB_BUCKET_BITS;
+    return shift * SUB_BUCKET_COUNT + static_cast<size_t>(unsignedValue >> shift);
+}
+
+int64_t Histogram::BucketUpperBound(size_t index)
+{
+    if (index < 2 * SUB_BUCKET_COUNT)
+    {
+        return static_cast<int64_t>(index);
+    }
+
+    size_t shift = index / SUB_BUCKET_COUNT - 1;
+    int64_t subBucket = static_cast<int64_t>(index - shift * SUB_BUCKET_COUNT);
+    return ((subBucket + 1) << shift) - 1;
+}
+
+void Histogram::Record(int64_t value)
+{
+    value = (std::max)(value, static_cast<int64_t>(0));
+    m_buckets[BucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+    m_sum.fetch_add(value, std::memory_order_relaxed);
+
+    int64_t currentMin = m_min.load(std::memory_order_relaxed);
+    while (value < currentMin && !m_min.compare_exchange_weak(currentMin, value, std::memory_order_relaxed));
+    int64_t currentMax = m_max.load(std::memory_order_relaxed);
+    while (value > currentMax && !m_max.compare_exchange_weak(currentMax, value, std::memory_order_relaxed));
+
+    //counted last so a reader that sees the count also finds the value in its bucket.
+    m_count.fetch_add(1, std::memory_order_release);
+}
+
+int64_t Histogram::GetMin() const
+{
+    int64_t min = m_min.load(std::memory_order_relaxed);
+    return min == (std::numeric_limits<int64_t>::max)() ? 0 : min;
+}
+
+double Histogram::GetMean() const
+{
+    uint64_t count = GetCount();
+    return count ? static_cast<double>(m_sum.load(std::memory_order_relaxed)) / count : 0.0;
+}
+
+int64_t Histogram::GetValueAtPercentile(double percentile) const
+{
+    uint64_t count = m_count.load(std::memory_order_acquire);
+    if (count == 0)
+    {
+        return 0;
+    }
+
+    percentile = (std::min)((std::max)(percentile, 0.0), 100.0);
+    uint64_t target = static_cast<uint64_t>(std::ceil(percentile / 100.0 * count));
+    target = (std::max)(target, static_cast<uint64_t>(1));
+
+    uint64_t seen = 0;
+    for (size_t i = 0; i < BUCKET_COUNT; ++i)
+    {
+        seen += m_buckets[i].load(std::memory_order_relaxed);
+        if (seen >= target)
+        {
+            //the last bucket also holds every value beyond the trackable range, only the max knows how far they went.
+            return i == BUCKET_COUNT - 1 ? GetMax() : (std::min)(BucketUpperBound(i), GetMax());
+        }
+    }
+
+    return GetMax();
+}
+
+void Histogram::Reset()
+{
+    for (auto& bucket : m_buckets)
+    {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+    m_sum.store(0, std::memory_order_relaxed);
+    m_min.store((std::numeric_limits<int64_t>::max)(), std::memory_order_relaxed);
+    m_max.store(0, std::memory_order_relaxed);
+    m_count.store(0, std::memory_order_release);
+}
@@ -14,13 +14,148 @@
   */
 
 #include <aws/core/utils/base64/Base64.h>
+#include <aws/core/utils/CPUFeatures.h>
 #include <cstring>
 
+#ifdef AWS_X86_SIMD
+#include <immintrin.h>
+#endif
+
 using namespace Aws::Utils::Base64;
+using namespace Aws::Utils;
 
 static const uint8_t SENTINEL_VALUE = 255;
 static const char BASE64_ENCODING_TABLE_MIME[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
 
+#ifdef AWS_X86_SIMD
+//The vectorized codecs follow Wojciech Mula and Daniel Lemire, "Faster Base64 Encoding and Decoding Using AVX2 Instructions".
+//Each kernel handles whole blocks and returns how much input it consumed; the scalar loops finish the tail, padding included.
+
+//12 input bytes become 16 sextets, one per byte lane: shuffle the 3 byte groups into 4 byte lanes, then shift the sextets into place.
+AWS_TARGET_SSSE3 static inline __m128i SplitSextets(__m128i in)
+{
+    in = _mm_shuffle_epi8(in, _mm_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10));
+    const __m128i t0 = _mm_mulhi_epu16(_mm_and_si128(in, _mm_set1_epi32(0x0fc0fc00)), _mm_set1_epi32(0x04000040));
+    const __m128i t1 = _mm_mullo_epi16(_mm_and_si128(in, _mm_set1_epi32(0x003f03f0)), _mm_set1_epi32(0x01000010));
+    return _mm_or_si128(t0, t1);
+}
+
+//maps sextets to the standard alphabet by adding a per range offset picked with a shuffle.
+AWS_TARGET_SSSE3 static inline __m128i SextetsToAscii(__m128i sextets)
+{
+    __m128i range = _mm_subs_epu8(sextets, _mm_set1_epi8(51));
+    range = _mm_or_si128(range, _mm_and_si128(_mm_cmpgt_epi8(_mm_set1_epi8(26), sextets), _mm_set1_epi8(13)));
+    const __m128i offsets = _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+        '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0);
+    return _mm_add_epi8(sextets, _mm_shuffle_epi8(offsets, range));
+}
+
+AWS_TARGET_SSSE3 static size_t EncodeSSSE3(const unsigned char* data, size_t length, char* output)
+{
+    size_t consumed = 0;
+    //each step reads 16 bytes but only consumes 12.
+    for (; consumed + 16 <= length; consumed += 12, output += 16)
+    {
+        __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + consumed));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output), SextetsToAscii(SplitSextets(in)));
+    }
+    return consumed;
+}
+
+AWS_TARGET_AVX2 static size_t EncodeAVX2(const unsigned char* data, size_t length, char* output)
+{
+    const __m256i shuffle = _mm256_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10,
+        1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10);
+    const __m256i offsets = _mm256_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+        '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0,
+        'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+        '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0);
+
+    size_t consumed = 0;
+    //each step consumes 24 bytes, 12 per 128 bit lane, and reads up to 28.
+    for (; consumed + 28 <= length; consumed += 24, output += 32)
+    {
+        const unsigned char* in = data + consumed;
+        __m256i block = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in))),
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + 12)), 1);
+        block = _mm256_shuffle_epi8(block, shuffle);
+        const __m256i t0 = _mm256_mulhi_epu16(_mm256_and_si256(block, _mm256_set1_epi32(0x0fc0fc00)), _mm256_set1_epi32(0x04000040));
+        const __m256i t1 = _mm256_mullo_epi16(_mm256_and_si256(block, _mm256_set1_epi32(0x003f03f0)), _mm256_set1_epi32(0x01000010));
+        const __m256i sextets = _mm256_or_si256(t0, t1);
+
+        __m256i range = _mm256_subs_epu8(sextets, _mm256_set1_epi8(51));
+        range = _mm256_or_si256(range, _mm256_and_si256(_mm256_cmpgt_epi8(_mm256_set1_epi8(26), sextets), _mm256_set1_epi8(13)));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(output), _mm256_add_epi8(sextets, _mm256_shuffle_epi8(offsets, range)));
+    }
+    return consumed;
+}
+
+//Stops at the first block holding anything outside the standard alphabet (padding included) and leaves it to the scalar loop.
+AWS_TARGET_SSSE3 static size_t DecodeSSSE3(const char* input, size_t length, unsigned char* output)
+{
+    const __m128i lutLo = _mm_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+    const __m128i lutHi = _mm_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+    const __m128i lutRoll = _mm_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+    const __m128i nibbleMask = _mm_set1_epi8(0x0f);
+
+    size_t consumed = 0;
+    //each step writes 16 bytes of which 12 are output, the 8 chars left over guarantee at least 4 more output bytes.
+    for (; consumed + 24 <= length; consumed += 16, output += 12)
+    {
+        const __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + consumed));
+        const __m128i hiNibbles = _mm_and_si128(_mm_srli_epi32(in, 4), nibbleMask);
+        const __m128i loBits = _mm_shuffle_epi8(lutLo, _mm_and_si128(in, nibbleMask));
+        const __m128i hiBits = _mm_shuffle_epi8(lutHi, hiNibbles);
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(loBits, hiBits), _mm_setzero_si128())) != 0xFFFF)
+        {
+            break;
+        }
+
+        const __m128i roll = _mm_shuffle_epi8(lutRoll, _mm_add_epi8(_mm_cmpeq_epi8(in, _mm_set1_epi8(0x2F)), hiNibbles));
+        const __m128i sextets = _mm_add_epi8(in, roll);
+        const __m128i pairs = _mm_maddubs_epi16(sextets, _mm_set1_epi32(0x01400140));
+        const __m128i packed = _mm_madd_epi16(pairs, _mm_set1_epi32(0x00011000));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output),
+            _mm_shuffle_epi8(packed, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1)));
+    }
+    return consumed;
+}
+
+AWS_TARGET_AVX2 static size_t DecodeAVX2(const char* input, size_t length, unsigned char* output)
+{
+    const __m256i lutLo = _mm256_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A,
+        0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+    const __m256i lutHi = _mm256_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+        0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+    const __m256i lutRoll = _mm256_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+    const __m256i packShuffle = _mm256_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+        2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+    const __m256i nibbleMask = _mm256_set1_epi8(0x0f);
+
+    size_t consumed = 0;
+    //each step writes 32 bytes of which 24 are output, the 16 chars left over guarantee at least 8 more output bytes.
+    for (; consumed + 48 <= length; consumed += 32, output += 24)
+    {
+        const __m256i in = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input + consumed));
+        const __m256i hiNibbles = _mm256_and_si256(_mm256_srli_epi32(in, 4), nibbleMask);
+        const __m256i loBits = _mm256_shuffle_epi8(lutLo, _mm256_and_si256(in, nibbleMask));
+        const __m256i hiBits = _mm256_shuffle_epi8(lutHi, hiNibbles);
+        if (_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_and_si256(loBits, hiBits), _mm256_setzero_si256())) != -1)
+        {
+            break;
+        }
+
+        const __m256i roll = _mm256_shuffle_epi8(lutRoll, _mm256_add_epi8(_mm256_cmpeq_epi8(in, _mm256_set1_epi8(0x2F)), hiNibbles));
+        const __m256i sextets = _mm256_add_epi8(in, roll);
+        const __m256i pairs = _mm256_maddubs_epi16(sextets, _mm256_set1_epi32(0x01400140));
+        const __m256i packed = _mm256_shuffle_epi8(_mm256_madd_epi16(pairs, _mm256_set1_epi32(0x00011000)), packShuffle);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(output), _mm256_permutevar8x32_epi32(packed, _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 7, 7)));
+    }
+    return consumed;
+}
+#endif // AWS_X86_SIMD
+
 namespace Aws
 {
 namespace Utils
@@ -43,6 +178,7 @@ Base64::Base64(const char *encodingTable)
     }
 
     memcpy(m_mimeBase64EncodingTable, encodingTable, encodingTableLength);
+    m_isStandardTable = memcmp(m_mimeBase64EncodingTable, BASE64_ENCODING_TABLE_MIME, 64) == 0;
 
     memset((void *)m_mimeBase64DecodingTable, 0, 256);
 
@@ -57,82 +193,136 @@ Base64::Base64(const char *encodingTable)
 
 Aws::String Base64::Encode(const Aws::Utils::ByteBuffer& buffer) const
 {
-    size_t bufferLength = buffer.GetLength();
-    size_t blockCount = (bufferLength + 2) / 3;
-    size_t remainderCount = (bufferLength % 3);
+    Aws::String outputString(CalculateBase64EncodedLength(buffer), '\0');
+    if (!outputString.empty())
+    {
+        Encode(buffer.GetUnderlyingData(), buffer.GetLength(), &outputString[0]);
+    }
+
+    return outputString;
+}
 
-    Aws::String outputString;
-    outputString.reserve(CalculateBase64EncodedLength(buffer));
+Aws::Utils::ByteBuffer Base64::Decode(const Aws::String& str) const
+{
+    Aws::Utils::ByteBuffer buffer(CalculateBase64DecodedLength(str));
+    Decode(str.c_str(), str.length(), buffer.GetUnderlyingData());
+    return buffer;
+}
 
-    for(size_t i = 0; i < bufferLength; i += 3 )
+size_t Base64::Encode(const unsigned char* data, size_t length, char* output) const
+{
+    size_t i = 0;
+    char* out = output;
+
+#ifdef AWS_X86_SIMD
+    if (m_isStandardTable)
     {
-        uint32_t block = buffer[ i ];
+        size_t consumed = 0;
+        if (CPUFeatures::HasAVX2())
+        {
+            consumed = EncodeAVX2(data, length, out);
+        }
+        else if (CPUFeatures::HasSSSE3())
+        {
+            consumed = EncodeSSSE3(data, length, out);
+        }
+        i = consumed;
+        out += consumed / 3 * 4;
+    }
+#endif
+
+    for(; i < length; i += 3 )
+    {
+        uint32_t block = data[ i ];
 
         block <<= 8;
-        if (i + 1 < bufferLength)
+        if (i + 1 < length)
         {
-            block = block | buffer[ i + 1 ];
+            block = block | data[ i + 1 ];
         }
 
         block <<= 8;
-        if (i + 2 < bufferLength)
+        if (i + 2 < length)
         {
-            block = block | buffer[ i + 2 ];
+            block = block | data[ i + 2 ];
         }
 
-        outputString.push_back(m_mimeBase64EncodingTable[(block >> 18) & 0x3F]);
-        outputString.push_back(m_mimeBase64EncodingTable[(block >> 12) & 0x3F]);
-        outputString.push_back(m_mimeBase64EncodingTable[(block >> 6) & 0x3F]);
-        outputString.push_back(m_mimeBase64EncodingTable[block & 0x3F]);
+        *out++ = m_mimeBase64EncodingTable[(block >> 18) & 0x3F];
+        *out++ = m_mimeBase64EncodingTable[(block >> 12) & 0x3F];
+        *out++ = m_mimeBase64EncodingTable[(block >> 6) & 0x3F];
+        *out++ = m_mimeBase64EncodingTable[block & 0x3F];
     }
 
+    size_t remainderCount = length % 3;
     if(remainderCount > 0)
     {
-        outputString[blockCount * 4 - 1] = '=';
+        *(out - 1) = '=';
         if(remainderCount == 1)
         {
-            outputString[blockCount * 4 - 2] = '=';
+            *(out - 2) = '=';
         }
     }
 
-    return outputString;
+    return static_cast<size_t>(out - output);
 }
 
-Aws::Utils::ByteBuffer Base64::Decode(const Aws::String& str) const
+size_t Base64::Decode(const char* input, size_t length, unsigned char* output) const
 {
-    size_t decodedLength = CalculateBase64DecodedLength(str);
-
-    Aws::Utils::ByteBuffer buffer(decodedLength);
+    size_t decodedLength = CalculateBase64DecodedLength(input, length);
+    size_t stringIndex = 0;
+    size_t bufferIndex = 0;
 
-    const char* rawString = str.c_str();
-    size_t blockCount = str.length() / 4;
-    for(size_t i = 0; i < blockCount; ++i)
+#ifdef AWS_X86_SIMD
+    if (m_isStandardTable)
     {
-        size_t stringIndex = i * 4;
+        size_t consumed = 0;
+        if (CPUFeatures::HasAVX2())
+        {
+            consumed = DecodeAVX2(input, length, output);
+        }
+        else if (CPUFeatures::HasSSSE3())
+        {
+            consumed = DecodeSSSE3(input, length, output);
+        }
+        stringIndex = consumed;
+        bufferIndex = consumed / 4 * 3;
+    }
+#endif
 
-        uint32_t value1 = m_mimeBase64DecodingTable[uint32_t(rawString[stringIndex])];
-        uint32_t value2 = m_mimeBase64DecodingTable[uint32_t(rawString[++stringIndex])];
-        uint32_t value3 = m_mimeBase64DecodingTable[uint32_t(rawString[++stringIndex])];
-        uint32_t value4 = m_mimeBase64DecodingTable[uint32_t(rawString[++stringIndex])];
+    //bufferIndex is bounded by decodedLength so malformed input can't write past the end of output.
+    for(; stringIndex + 4 <= length && bufferIndex < decodedLength; stringIndex += 4)
+    {
+        uint32_t value1 = m_mimeBase64DecodingTable[uint8_t(input[stringIndex])];
+        uint32_t value2 = m_mimeBase64DecodingTable[uint8_t(input[stringIndex + 1])];
+        uint32_t value3 = m_mimeBase64DecodingTable[uint8_t(input[stringIndex + 2])];
+        uint32_t value4 = m_mimeBase64DecodingTable[uint8_t(input[stringIndex + 3])];
 
-        size_t bufferIndex = i * 3;
-        buffer[bufferIndex] = static_cast<uint8_t>((value1 << 2) | ((value2 >> 4) & 0x03));
-        if(value3 != SENTINEL_VALUE)
+        output[bufferIndex++] = static_cast<uint8_t>((value1 << 2) | ((value2 >> 4) & 0x03));
+        if(value3 != SENTINEL_VALUE && bufferIndex < decodedLength)
         {
-            buffer[++bufferIndex] = static_cast<uint8_t>(((value2 << 4) & 0xF0) | ((value3 >> 2) & 0x0F));
-            if(value4 != SENTINEL_VALUE)
+            output[bufferIndex++] = static_cast<uint8_t>(((value2 << 4) & 0xF0) | ((value3 >> 2) & 0x0F));
+            if(value4 != SENTINEL_VALUE && bufferIndex < decodedLength)
             {
-                buffer[++bufferIndex] = static_cast<uint8_t>((value3 & 0x03) << 6 | value4);
+                output[bufferIndex++] = static_cast<uint8_t>((value3 & 0x03) << 6 | value4);
             }
         }
     }
 
-    return buffer;
+    if (bufferIndex < decodedLength)
+    {
+        memset(output + bufferIndex, 0, decodedLength - bufferIndex);
+    }
+
+    return decodedLength;
 }
 
 size_t Base64::CalculateBase64DecodedLength(const Aws::String& b64input)
 {
-    size_t len = b64input.length();
+    return CalculateBase64DecodedLength(b64input.c_str(), b64input.length());
+}
+
+size_t Base64::CalculateBase64DecodedLength(const char* b64input, size_t len)
+{
     if(len == 0)
     {
         return 0;
@@ -140,19 +330,25 @@ size_t Base64::CalculateBase64DecodedLength(const Aws::String& b64input)
 
     size_t padding = 0;
 
-    if (b64input[len - 1] == '=' && b64input[len - 2] == '=') //last two chars are =
+    if (len >= 2 && b64input[len - 1] == '=' && b64input[len - 2] == '=') //last two chars are =
         padding = 2;
     else if (b64input[len - 1] == '=') //last char is =
         padding = 1;
 
-    return (len * 3 / 4 - padding);
+    size_t unpaddedLength = len * 3 / 4;
+    return unpaddedLength > padding ? unpaddedLength - padding : 0;
 }
 
 size_t Base64::CalculateBase64EncodedLength(const Aws::Utils::ByteBuffer& buffer)
 {
-    return 4 * ((buffer.GetLength() + 2) / 3);
+    return CalculateBase64EncodedLength(buffer.GetLength());
+}
+
+size_t Base64::CalculateBase64EncodedLength(size_t length)
+{
+    return 4 * ((length + 2) / 3);
 }
 
 } // namespace Base64
 } // namespace Utils
-} // namespace Aws
\ No newline at end of file
+} // namespace Aws
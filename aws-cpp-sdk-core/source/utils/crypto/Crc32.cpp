@@ -0,0 +1,144 @@
+/*
+* Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+*
+* Licensed under the Apache License, Version 2.0 (the "License").
+* You may not use this file except in compliance with the License.
+* A copy of the License is located at
+*
+*  http://aws.amazon.com/apache2.0
+*
+* or in the "license" file accompanying this file. This file is distributed
+* on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+* express or implied. See the License for the specific language governing
+* permissions and limitations under the License.
+*/
+
+#include <aws/core/utils/crypto/Crc32.h>
+#include <aws/core/utils/Outcome.h>
+
+#include <istream>
+
+using namespace Aws::Utils;
+using namespace Aws::Utils::Crypto;
+
+namespace
+{
+    const uint32_t CRC32_POLYNOMIAL = 0xEDB88320;
+
+    /**
+     * Slicing-by-8 tables: table[0] is the classic byte at a time table, table[k][b] is the crc of b followed by k zero bytes.
+     * Built at static initialization, before anything can hash.
+     */
+    struct Crc32Tables
+    {
+        Crc32Tables()
+        {
+            for (uint32_t b = 0; b < 256; ++b)
+            {
+                uint32_t crc = b;
+                for (int bit = 0; bit < 8; ++bit)
+                {
+                    crc = (crc >> 1) ^ (CRC32_POLYNOMIAL & (0 - (crc & 1)));
+                }
+                table[0][b] = crc;
+            }
+
+            for (uint32_t b = 0; b < 256; ++b)
+            {
+                for (size_t k = 1; k < 8; ++k)
+                {
+                    table[k][b] = (table[k - 1][b] >> 8) ^ table[0][table[k - 1][b] & 0xFF];
+                }
+            }
+        }
+
+        uint32_t table[8][256];
+    };
+
+    const Crc32Tables s_crc32Tables;
+}
+
+Crc32::Crc32() : m_crc(0)
+{
+}
+
+uint32_t Crc32::Checksum(uint32_t crc, const unsigned char* data, size_t length)
+{
+    const uint32_t (&t)[8][256] = s_crc32Tables.table;
+    crc = ~crc;
+
+    for (; length >= 8; data += 8, length -= 8)
+    {
+        uint32_t low = crc ^ (static_cast<uint32_t>(data[0]) | static_cast<uint32_t>(data[1]) << 8 |
+            static_cast<uint32_t>(data[2]) << 16 | static_cast<uint32_t>(data[3]) << 24);
+        crc = t[7][low & 0xFF] ^ t[6][(low >> 8) & 0xFF] ^ t[5][(low >> 16) & 0xFF] ^ t[4][low >> 24] ^
+            t[3][data[4]] ^ t[2][data[5]] ^ t[1][data[6]] ^ t[0][data[7]];
+    }
+
+    for (; length > 0; ++data, --length)
+    {
+        crc = (crc >> 8) ^ t[0][(crc ^ *data) & 0xFF];
+    }
+
+    return ~crc;
+}
+
+static HashResult ToHashResult(uint32_t crc)
+{
+    ByteBuffer hash(4);
+    hash[0] = static_cast<unsigned char>(crc >> 24);
+    hash[1] = static_cast<unsigned char>(crc >> 16);
+    hash[2] = static_cast<unsigned char>(crc >> 8);
+    hash[3] = static_cast<unsigned char>(crc);
+    return HashResult(std::move(hash));
+}
+
+HashResult Crc32::Calculate(const Aws::String& str)
+{
+    return Calculate(reinterpret_cast<const unsigned char*>(str.c_str()), str.size());
+}
+
+HashResult Crc32::Calculate(const unsigned char* data, size_t length)
+{
+    return ToHashResult(Checksum(0, data, length));
+}
+
+HashResult Crc32::Calculate(Aws::IStream& stream)
+{
+    auto currentPos = stream.tellg();
+    if (currentPos == std::streampos(std::streamoff(-1)))
+    {
+        currentPos = 0;
+        stream.clear();
+    }
+    stream.seekg(0, stream.beg);
+
+    uint32_t crc = 0;
+    unsigned char streamBuffer[INTERNAL_HASH_STREAM_BUFFER_SIZE];
+    while (stream.good())
+    {
+        stream.read(reinterpret_cast<char*>(streamBuffer), INTERNAL_HASH_STREAM_BUFFER_SIZE);
+        auto bytesRead = stream.gcount();
+        if (bytesRead > 0)
+        {
+            crc = Checksum(crc, streamBuffer, static_cast<size_t>(bytesRead));
+        }
+    }
+
+    stream.clear();
+    stream.seekg(currentPos, stream.beg);
+
+    return ToHashResult(crc);
+}
+
+void Crc32::Update(const unsigned char* data, size_t length)
+{
+    m_crc = Checksum(m_crc, data, length);
+}
+
+HashResult Crc32::GetHash()
+{
+    uint32_t crc = m_crc;
+    m_crc = 0;
+    return ToHashResult(crc);
+}
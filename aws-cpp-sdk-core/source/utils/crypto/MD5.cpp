@@ -38,4 +38,24 @@ HashResult MD5::Calculate(const Aws::String& str)
 HashResult MD5::Calculate(Aws::IStream& stream)
 {
     return m_hashImpl->Calculate(stream);
-}
\ No newline at end of file
+}
+
+HashResult MD5::Calculate(const unsigned char* data, size_t length)
+{
+    return m_hashImpl->Calculate(data, length);
+}
+
+bool MD5::IsIncremental() const
+{
+    return m_hashImpl->IsIncremental();
+}
+
+void MD5::Update(const unsigned char* data, size_t length)
+{
+    m_hashImpl->Update(data, length);
+}
+
+HashResult MD5::GetHash()
+{
+    return m_hashImpl->GetHash();
+}
@@ -0,0 +1,161 @@
+/*
+* Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+*
+* Licensed under the Apache License, Version 2.0 (the "License").
+* You may not use this file except in compliance with the License.
+* A copy of the License is located at
+*
+*  http://aws.amazon.com/apache2.0
+*
+* or in the "license" file accompanying this file. This file is distributed
+* on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+* express or implied. See the License for the specific language governing
+* permissions and limitations under the License.
+*/
+
+#include <aws/core/utils/crypto/MultiDigest.h>
+#include <aws/core/utils/crypto/Crc32.h>
+#include <aws/core/utils/crypto/Factories.h>
+#include <aws/core/utils/crypto/Hash.h>
+#include <aws/core/utils/memory/AWSMemory.h>
+#include <aws/core/utils/Outcome.h>
+
+#include <istream>
+
+using namespace Aws::Utils;
+using namespace Aws::Utils::Crypto;
+
+static const char* MULTI_DIGEST_LOG_TAG = "MultiDigest";
+
+const size_t MultiDigest::STREAM_BUFFER_SIZE;
+
+void MultiDigest::AddAlgorithm(DigestAlgorithm algorithm)
+{
+    if (HasAlgorithm(algorithm))
+    {
+        return;
+    }
+
+    Digest digest;
+    digest.algorithm = algorithm;
+    switch (algorithm)
+    {
+        case DigestAlgorithm::MD5:
+            digest.hash = CreateMD5Implementation();
+            break;
+        case DigestAlgorithm::SHA256:
+            digest.hash = CreateSha256Implementation();
+            break;
+        case DigestAlgorithm::CRC32:
+            digest.hash = Aws::MakeShared<Crc32>(MULTI_DIGEST_LOG_TAG);
+            break;
+    }
+    m_digests.push_back(std::move(digest));
+}
+
+bool MultiDigest::HasAlgorithm(DigestAlgorithm algorithm) const
+{
+    for (const auto& digest : m_digests)
+    {
+        if (digest.algorithm == algorithm)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool MultiDigest::Calculate(Aws::IStream& stream)
+{
+    auto currentPos = stream.tellg();
+    if (currentPos == std::streampos(std::streamoff(-1)))
+    {
+        currentPos = 0;
+        stream.clear();
+    }
+    stream.seekg(0, stream.beg);
+
+    Array<unsigned char> streamBuffer(STREAM_BUFFER_SIZE);
+    while (stream.good())
+    {
+        stream.read(reinterpret_cast<char*>(streamBuffer.GetUnderlyingData()), STREAM_BUFFER_SIZE);
+        auto bytesRead = stream.gcount();
+        if (bytesRead > 0)
+        {
+            for (auto& digest : m_digests)
+            {
+                if (digest.hash->IsIncremental())
+                {
+                    digest.hash->Update(streamBuffer.GetUnderlyingData(), static_cast<size_t>(bytesRead));
+                }
+            }
+        }
+    }
+    bool readWholeStream = !stream.bad();
+
+    stream.clear();
+    stream.seekg(currentPos, stream.beg);
+
+    bool success = FinishDigests() && readWholeStream;
+
+    //a hash that can't be updated a chunk at a time streams the body on its own rather than having it buffered for it
+    for (auto& digest : m_digests)
+    {
+        if (!digest.hash->IsIncremental())
+        {
+            success = SetResult(digest, digest.hash->Calculate(stream)) && success;
+            stream.clear();
+            stream.seekg(currentPos, stream.beg);
+        }
+    }
+    return success;
+}
+
+bool MultiDigest::Calculate(const unsigned char* data, size_t length)
+{
+    bool success = true;
+    for (auto& digest : m_digests)
+    {
+        if (digest.hash->IsIncremental())
+        {
+            digest.hash->Update(data, length);
+        }
+        else
+        {
+            success = SetResult(digest, digest.hash->Calculate(data, length)) && success;
+        }
+    }
+    return FinishDigests() && success;
+}
+
+const ByteBuffer& MultiDigest::GetDigest(DigestAlgorithm algorithm) const
+{
+    for (const auto& digest : m_digests)
+    {
+        if (digest.algorithm == algorithm)
+        {
+            return digest.result;
+        }
+    }
+    return m_emptyDigest;
+}
+
+bool MultiDigest::FinishDigests()
+{
+    bool success = true;
+    for (auto& digest : m_digests)
+    {
+        if (digest.hash->IsIncremental())
+        {
+            success = SetResult(digest, digest.hash->GetHash()) && success;
+        }
+    }
+    return success;
+}
+
+bool MultiDigest::SetResult(Digest& digest, HashResult&& hashResult)
+{
+    bool success = hashResult.IsSuccess();
+    digest.result = success ? hashResult.GetResultWithOwnership() : ByteBuffer();
+    return success;
+}
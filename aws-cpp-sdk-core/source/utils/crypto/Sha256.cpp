@@ -37,4 +37,24 @@ HashResult Sha256::Calculate(const Aws::String& str)
 HashResult Sha256::Calculate(Aws::IStream& stream)
 {
     return m_hashImpl->Calculate(stream);
-}
\ No newline at end of file
+}
+
+HashResult Sha256::Calculate(const unsigned char* data, size_t length)
+{
+    return m_hashImpl->Calculate(data, length);
+}
+
+bool Sha256::IsIncremental() const
+{
+    return m_hashImpl->IsIncremental();
+}
+
+void Sha256::Update(const unsigned char* data, size_t length)
+{
+    m_hashImpl->Update(data, length);
+}
+
+HashResult Sha256::GetHash()
+{
+    return m_hashImpl->GetHash();
+}
@@ -0,0 +1,180 @@
+/*
+* Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+*
+* Licensed under the Apache License, Version 2.0 (the "License").
+* You may not use this file except in compliance with the License.
+* A copy of the License is located at
+*
+*  http://aws.amazon.com/apache2.0
+*
+* or in the "license" file accompanying this file. This file is distributed
+* on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+* express or implied. See the License for the specific language governing
+* permissions and limitations under the License.
+*/
+
+#include <aws/core/utils/crypto/Sha256TreeHash.h>
+#include <aws/core/utils/crypto/Sha256.h>
+#include <aws/core/utils/threading/Executor.h>
+#include <aws/core/utils/memory/AWSMemory.h>
+#include <aws/core/utils/logging/LogMacros.h>
+#include <aws/core/platform/FileSystem.h>
+#include <aws/core/utils/Outcome.h>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+
+using namespace Aws::Utils;
+using namespace Aws::Utils::Crypto;
+
+static const char* TREE_HASH_LOG_TAG = "Sha256TreeHash";
+
+const size_t Sha256TreeHash::LEAF_SIZE;
+
+namespace
+{
+    /**
+     * Shared between the calling thread and the executor tasks. Leaves are claimed from nextLeaf, so a task which only starts after all
+     * leaves were claimed does nothing and never touches the data, which may be gone by then.
+     */
+    struct LeafHashJob
+    {
+        LeafHashJob(const unsigned char* jobData, size_t jobLength, size_t jobLeafCount) :
+            data(jobData),
+            length(jobLength),
+            leafCount(jobLeafCount),
+            leafHashes(jobLeafCount),
+            nextLeaf(0),
+            hashedLeaves(0)
+        {
+        }
+
+        const unsigned char* data;
+        size_t length;
+        size_t leafCount;
+        Aws::Vector<ByteBuffer> leafHashes;
+        std::atomic<size_t> nextLeaf;
+        size_t hashedLeaves;
+        std::mutex hashedLeavesLock;
+        std::condition_variable hashedLeavesSignal;
+    };
+
+    void HashLeaves(LeafHashJob& job)
+    {
+        size_t leaf = job.nextLeaf++;
+        if (leaf >= job.leafCount)
+        {
+            return;
+        }
+
+        Sha256 hash;
+        size_t hashed = 0;
+        for (; leaf < job.leafCount; leaf = job.nextLeaf++)
+        {
+            size_t offset = leaf * Sha256TreeHash::LEAF_SIZE;
+            size_t leafLength = (std::min)(Sha256TreeHash::LEAF_SIZE, job.length - offset);
+            job.leafHashes[leaf] = hash.Calculate(job.data + offset, leafLength).GetResultWithOwnership();
+            ++hashed;
+        }
+
+        std::lock_guard<std::mutex> locker(job.hashedLeavesLock);
+        job.hashedLeaves += hashed;
+        if (job.hashedLeaves == job.leafCount)
+        {
+            job.hashedLeavesSignal.notify_all();
+        }
+    }
+}
+
+Sha256TreeHash::Sha256TreeHash(Threading::Executor* executor, size_t concurrency) :
+    m_executor(executor),
+    m_concurrency(executor ? concurrency : 0)
+{
+}
+
+TreeHashResult Sha256TreeHash::Calculate(const unsigned char* data, size_t length, size_t partSize) const
+{
+    // an empty input still has one (empty) leaf
+    size_t leafCount = length == 0 ? 1 : (length + LEAF_SIZE - 1) / LEAF_SIZE;
+    auto job = Aws::MakeShared<LeafHashJob>(TREE_HASH_LOG_TAG, data, length, leafCount);
+
+    size_t tasks = (std::min)(m_concurrency, leafCount - 1);
+    for (size_t i = 0; i < tasks; ++i)
+    {
+        if (!m_executor->Submit([job]() { HashLeaves(*job); }))
+        {
+            break;
+        }
+    }
+
+    HashLeaves(*job);
+    {
+        std::unique_lock<std::mutex> locker(job->hashedLeavesLock);
+        job->hashedLeavesSignal.wait(locker, [&job]() { return job->hashedLeaves == job->leafCount; });
+    }
+
+    TreeHashResult result;
+    result.archiveTreeHash = ComputeTreeHash(job->leafHashes, 0, leafCount);
+
+    if (partSize > 0 && partSize % LEAF_SIZE != 0)
+    {
+        AWS_LOGSTREAM_ERROR(TREE_HASH_LOG_TAG, "Part size " << partSize << " is not a multiple of " << LEAF_SIZE << ", skipping part tree hashes.");
+    }
+    else if (partSize > 0)
+    {
+        size_t leavesPerPart = partSize / LEAF_SIZE;
+        size_t partCount = (leafCount + leavesPerPart - 1) / leavesPerPart;
+        result.partTreeHashes.reserve(partCount);
+        for (size_t part = 0; part < partCount; ++part)
+        {
+            size_t begin = part * leavesPerPart;
+            result.partTreeHashes.push_back(ComputeTreeHash(job->leafHashes, begin, (std::min)(begin + leavesPerPart, leafCount)));
+        }
+    }
+
+    return result;
+}
+
+TreeHashResult Sha256TreeHash::CalculateFile(const char* fileName, size_t partSize) const
+{
+    Aws::FileSystem::MappedFile file(fileName);
+    if (!file)
+    {
+        return TreeHashResult();
+    }
+
+    return Calculate(file.GetData(), file.GetLength(), partSize);
+}
+
+ByteBuffer Sha256TreeHash::ComputeTreeHash(const Aws::Vector<ByteBuffer>& leafHashes, size_t begin, size_t end)
+{
+    if (begin >= end)
+    {
+        return ByteBuffer();
+    }
+
+    Aws::Vector<ByteBuffer> level(leafHashes.begin() + begin, leafHashes.begin() + end);
+    Sha256 hash;
+    Aws::String pair;
+    while (level.size() > 1)
+    {
+        size_t reduced = 0;
+        for (size_t i = 0; i + 1 < level.size(); i += 2)
+        {
+            pair.assign(reinterpret_cast<const char*>(level[i].GetUnderlyingData()), level[i].GetLength());
+            pair.append(reinterpret_cast<const char*>(level[i + 1].GetUnderlyingData()), level[i + 1].GetLength());
+            level[reduced++] = hash.Calculate(pair).GetResultWithOwnership();
+        }
+
+        // an odd node out is promoted to the next level as is
+        if (level.size() % 2 == 1)
+        {
+            level[reduced++] = std::move(level.back());
+        }
+        level.resize(reduced);
+    }
+
+    return std::move(level.front());
+}
@@ -128,6 +128,9 @@ namespace Aws
                 m_hashBuffer(nullptr),
                 m_hashObjectLength(0),
                 m_hashObject(nullptr),
+                m_updateHashObject(nullptr),
+                m_updateContext(nullptr),
+                m_updateFailed(false),
                 m_algorithmMutex()
             {
                 NTSTATUS status = BCryptOpenAlgorithmProvider(&m_algorithmHandle, algorithmName, MS_PRIMITIVE_PROVIDER, isHMAC ? BCRYPT_ALG_HANDLE_HMAC_FLAG : 0);
@@ -166,10 +169,19 @@ namespace Aws
                     AWS_LOGSTREAM_ERROR(logTag, "Error allocating hash object.");
                     return;
                 }
+
+                m_updateHashObject = Aws::NewArray<BYTE>(m_hashObjectLength, logTag);
+                if (!m_updateHashObject)
+                {
+                    AWS_LOGSTREAM_ERROR(logTag, "Error allocating hash object.");
+                    return;
+                }
             }
 
             BCryptHashImpl::~BCryptHashImpl()
             {
+                Aws::Delete(m_updateContext);
+                Aws::DeleteArray(m_updateHashObject);
                 Aws::DeleteArray(m_hashObject);
                 Aws::DeleteArray(m_hashBuffer);
 
@@ -199,6 +211,11 @@ namespace Aws
             }
 
             HashResult BCryptHashImpl::Calculate(const Aws::String& str)
+            {
+                return Calculate(reinterpret_cast<const unsigned char*>(str.c_str()), str.length());
+            }
+
+            HashResult BCryptHashImpl::Calculate(const unsigned char* data, size_t length)
             {
                 if (!IsValid())
                 {
@@ -214,7 +231,7 @@ namespace Aws
                     return HashResult();
                 }
 
-                return HashData(context, (PBYTE)str.c_str(), static_cast<ULONG>(str.length()));
+                return HashData(context, (PBYTE)data, static_cast<ULONG>(length));
             }
 
             HashResult BCryptHashImpl::Calculate(const ByteBuffer& toHash, const ByteBuffer& secret)
@@ -238,7 +255,8 @@ namespace Aws
 
             bool BCryptHashImpl::IsValid() const
             {
-                return m_hashBuffer != nullptr && m_hashBufferLength > 0 && m_hashObject != nullptr && m_hashObjectLength > 0;
+                return m_hashBuffer != nullptr && m_hashBufferLength > 0 && m_hashObject != nullptr && m_hashObjectLength > 0 &&
+                    m_updateHashObject != nullptr;
             }
 
             bool BCryptHashImpl::HashStream(Aws::IStream& stream)
@@ -310,6 +328,78 @@ namespace Aws
                 return HashResult(ByteBuffer(m_hashBuffer, m_hashBufferLength));
             }
 
+            void BCryptHashImpl::Update(const unsigned char* data, size_t length)
+            {
+                if (!IsValid())
+                {
+                    return;
+                }
+
+                std::lock_guard<std::mutex> locker(m_algorithmMutex);
+
+                if (m_updateFailed)
+                {
+                    return;
+                }
+
+                if (!m_updateContext)
+                {
+                    m_updateContext = Aws::New<BCryptHashContext>(logTag, m_algorithmHandle, m_updateHashObject, m_hashObjectLength);
+                    if (!m_updateContext->IsValid())
+                    {
+                        AWS_LOGSTREAM_ERROR(logTag, "Error creating hash handle.");
+                        m_updateFailed = true;
+                        return;
+                    }
+                }
+
+                NTSTATUS status = BCryptHashData(m_updateContext->m_hashHandle, (PBYTE)data, static_cast<ULONG>(length), 0);
+                if (!NT_SUCCESS(status))
+                {
+                    AWS_LOGSTREAM_ERROR(logTag, "Error computing hash.");
+                    m_updateFailed = true;
+                }
+            }
+
+            HashResult BCryptHashImpl::GetHash()
+            {
+                if (!IsValid())
+                {
+                    return HashResult();
+                }
+
+                std::lock_guard<std::mutex> locker(m_algorithmMutex);
+
+                BCryptHashContext* context = m_updateContext;
+                bool failed = m_updateFailed;
+                m_updateContext = nullptr;
+                m_updateFailed = false;
+
+                if (!context)
+                {
+                    // nothing was passed to Update(), this is the hash of no data
+                    context = Aws::New<BCryptHashContext>(logTag, m_algorithmHandle, m_updateHashObject, m_hashObjectLength);
+                    failed = !context->IsValid();
+                }
+
+                HashResult result;
+                if (failed)
+                {
+                    AWS_LOGSTREAM_ERROR(logTag, "Error computing hash.");
+                }
+                else if (NT_SUCCESS(BCryptFinishHash(context->m_hashHandle, m_hashBuffer, m_hashBufferLength, 0)))
+                {
+                    result = HashResult(ByteBuffer(m_hashBuffer, m_hashBufferLength));
+                }
+                else
+                {
+                    AWS_LOGSTREAM_ERROR(logTag, "Error obtaining computed hash");
+                }
+
+                Aws::Delete(context);
+                return result;
+            }
+
             MD5BcryptImpl::MD5BcryptImpl() :
                 m_impl(BCRYPT_MD5_ALGORITHM, false)
             {
@@ -325,6 +415,21 @@ namespace Aws
                 return m_impl.Calculate(stream);
             }
 
+            HashResult MD5BcryptImpl::Calculate(const unsigned char* data, size_t length)
+            {
+                return m_impl.Calculate(data, length);
+            }
+
+            void MD5BcryptImpl::Update(const unsigned char* data, size_t length)
+            {
+                m_impl.Update(data, length);
+            }
+
+            HashResult MD5BcryptImpl::GetHash()
+            {
+                return m_impl.GetHash();
+            }
+
             Sha256BcryptImpl::Sha256BcryptImpl() :
                 m_impl(BCRYPT_SHA256_ALGORITHM, false)
             {
@@ -340,6 +445,21 @@ namespace Aws
                 return m_impl.Calculate(stream);
             }
 
+            HashResult Sha256BcryptImpl::Calculate(const unsigned char* data, size_t length)
+            {
+                return m_impl.Calculate(data, length);
+            }
+
+            void Sha256BcryptImpl::Update(const unsigned char* data, size_t length)
+            {
+                m_impl.Update(data, length);
+            }
+
+            HashResult Sha256BcryptImpl::GetHash()
+            {
+                return m_impl.GetHash();
+            }
+
             Sha256HMACBcryptImpl::Sha256HMACBcryptImpl() :
                 m_impl(BCRYPT_SHA256_ALGORITHM, true)
             {
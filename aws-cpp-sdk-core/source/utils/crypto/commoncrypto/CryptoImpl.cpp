@@ -76,8 +76,37 @@ namespace Aws
 
             HashResult MD5CommonCryptoImpl::Calculate(const Aws::String& str)
             {
+                return Calculate(reinterpret_cast<const unsigned char*>(str.c_str()), str.length());
+            }
+
+            HashResult MD5CommonCryptoImpl::Calculate(const unsigned char* data, size_t length)
+            {
+                ByteBuffer hash(CC_MD5_DIGEST_LENGTH);
+                CC_MD5(data, static_cast<CC_LONG>(length), hash.GetUnderlyingData());
+
+                return HashResult(std::move(hash));
+            }
+
+            void MD5CommonCryptoImpl::Update(const unsigned char* data, size_t length)
+            {
+                if (!m_isUpdating)
+                {
+                    CC_MD5_Init(&m_md5);
+                    m_isUpdating = true;
+                }
+                CC_MD5_Update(&m_md5, data, static_cast<CC_LONG>(length));
+            }
+
+            HashResult MD5CommonCryptoImpl::GetHash()
+            {
+                if (!m_isUpdating)
+                {
+                    CC_MD5_Init(&m_md5);
+                }
+                m_isUpdating = false;
+
                 ByteBuffer hash(CC_MD5_DIGEST_LENGTH);
-                CC_MD5(str.c_str(), static_cast<CC_LONG>(str.length()), hash.GetUnderlyingData());
+                CC_MD5_Final(hash.GetUnderlyingData(), &m_md5);
 
                 return HashResult(std::move(hash));
             }
@@ -113,8 +142,37 @@ namespace Aws
 
             HashResult Sha256CommonCryptoImpl::Calculate(const Aws::String& str)
             {
+                return Calculate(reinterpret_cast<const unsigned char*>(str.c_str()), str.length());
+            }
+
+            HashResult Sha256CommonCryptoImpl::Calculate(const unsigned char* data, size_t length)
+            {
+                ByteBuffer hash(CC_SHA256_DIGEST_LENGTH);
+                CC_SHA256(data, static_cast<CC_LONG>(length), hash.GetUnderlyingData());
+
+                return HashResult(std::move(hash));
+            }
+
+            void Sha256CommonCryptoImpl::Update(const unsigned char* data, size_t length)
+            {
+                if (!m_isUpdating)
+                {
+                    CC_SHA256_Init(&m_sha256);
+                    m_isUpdating = true;
+                }
+                CC_SHA256_Update(&m_sha256, data, static_cast<CC_LONG>(length));
+            }
+
+            HashResult Sha256CommonCryptoImpl::GetHash()
+            {
+                if (!m_isUpdating)
+                {
+                    CC_SHA256_Init(&m_sha256);
+                }
+                m_isUpdating = false;
+
                 ByteBuffer hash(CC_SHA256_DIGEST_LENGTH);
-                CC_SHA256(str.c_str(), static_cast<CC_LONG>(str.length()), hash.GetUnderlyingData());
+                CC_SHA256_Final(hash.GetUnderlyingData(), &m_sha256);
 
                 return HashResult(std::move(hash));
             }
@@ -147,13 +147,87 @@ namespace Aws
                 EVP_MD_CTX *m_ctx;
             };
 
+            /**
+             * Incremental digest helpers shared by the MD5 and SHA256 implementations. The context is created by the first Update and
+             * destroyed by GetHash, so an idle hash holds no openssl state.
+             */
+            static void UpdateDigest(EVP_MD_CTX*& ctx, const EVP_MD* md, bool allowNonFips, const unsigned char* data, size_t length)
+            {
+                if (!ctx)
+                {
+                    ctx = EVP_MD_CTX_create();
+                    if (allowNonFips)
+                    {
+                        EVP_MD_CTX_set_flags(ctx, EVP_MD_CTX_FLAG_NON_FIPS_ALLOW);
+                    }
+                    EVP_DigestInit_ex(ctx, md, nullptr);
+                }
+                EVP_DigestUpdate(ctx, data, length);
+            }
+
+            static HashResult FinishDigest(EVP_MD_CTX*& ctx, const EVP_MD* md, bool allowNonFips)
+            {
+                if (!ctx)
+                {
+                    UpdateDigest(ctx, md, allowNonFips, nullptr, 0);
+                }
+
+                ByteBuffer hash(EVP_MD_size(md));
+                EVP_DigestFinal(ctx, hash.GetUnderlyingData(), nullptr);
+                EVP_MD_CTX_destroy(ctx);
+                ctx = nullptr;
+
+                return HashResult(std::move(hash));
+            }
+
+            MD5OpenSSLImpl::~MD5OpenSSLImpl()
+            {
+                if (m_ctx)
+                {
+                    EVP_MD_CTX_destroy(m_ctx);
+                }
+            }
+
+            void MD5OpenSSLImpl::Update(const unsigned char* data, size_t length)
+            {
+                UpdateDigest(m_ctx, EVP_md5(), true, data, length);
+            }
+
+            HashResult MD5OpenSSLImpl::GetHash()
+            {
+                return FinishDigest(m_ctx, EVP_md5(), true);
+            }
+
+            Sha256OpenSSLImpl::~Sha256OpenSSLImpl()
+            {
+                if (m_ctx)
+                {
+                    EVP_MD_CTX_destroy(m_ctx);
+                }
+            }
+
+            void Sha256OpenSSLImpl::Update(const unsigned char* data, size_t length)
+            {
+                UpdateDigest(m_ctx, EVP_sha256(), false, data, length);
+            }
+
+            HashResult Sha256OpenSSLImpl::GetHash()
+            {
+                return FinishDigest(m_ctx, EVP_sha256(), false);
+            }
+
             HashResult MD5OpenSSLImpl::Calculate(const Aws::String& str)
+            {
+                return Calculate(reinterpret_cast<const unsigned char*>(str.c_str()), str.size());
+            }
+
+            HashResult MD5OpenSSLImpl::Calculate(const unsigned char* data, size_t length)
             {
                 OpensslCtxRAIIGuard guard;
                 auto ctx = guard.getResource();
                 EVP_MD_CTX_set_flags(ctx, EVP_MD_CTX_FLAG_NON_FIPS_ALLOW);
                 EVP_DigestInit_ex(ctx, EVP_md5(), nullptr);
-                EVP_DigestUpdate(ctx, str.c_str(), str.size());
+                EVP_DigestUpdate(ctx, data, length);
 
                 ByteBuffer hash(EVP_MD_size(EVP_md5()));
                 EVP_DigestFinal(ctx, hash.GetUnderlyingData(), nullptr);
@@ -198,11 +272,16 @@ namespace Aws
             }
 
             HashResult Sha256OpenSSLImpl::Calculate(const Aws::String& str)
+            {
+                return Calculate(reinterpret_cast<const unsigned char*>(str.c_str()), str.size());
+            }
+
+            HashResult Sha256OpenSSLImpl::Calculate(const unsigned char* data, size_t length)
             {
                 OpensslCtxRAIIGuard guard;
                 auto ctx = guard.getResource();
                 EVP_DigestInit_ex(ctx, EVP_sha256(), nullptr);
-                EVP_DigestUpdate(ctx, str.c_str(), str.size());
+                EVP_DigestUpdate(ctx, data, length);
 
                 ByteBuffer hash(EVP_MD_size(EVP_sha256()));
                 EVP_DigestFinal(ctx, hash.GetUnderlyingData(), nullptr);
@@ -0,0 +1,649 @@
+
+/*
+* Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+*
+* Licensed under the Apache License, Version 2.0 (the "License").
+* You may not use this file except in compliance with the License.
+* A copy of the License is located at
+*
+*  http://aws.amazon.com/apache2.0
+*
+* or in the "license" file accompanying this file. This file is distributed
+* on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+* express or implied. See the License for the specific language governing
+* permissions and limitations under the License.
+*/
+
+#include <aws/core/utils/json/JsonReader.h>
+#include <aws/core/utils/DateTime.h>
+#include <aws/core/utils/HashingUtils.h>
+#include <aws/core/utils/StringUtils.h>
+
+#include <clocale>
+#include <cstdlib>
+#include <cstring>
+
+using namespace Aws::Utils;
+using namespace Aws::Utils::Json;
+
+static const int END_OF_INPUT = -1;
+static const size_t MAX_SCALAR_LENGTH = 64;
+
+static bool IsScalarChar(int c)
+{
+    return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '-' || c == '+' || c == '.';
+}
+
+// strtod honours the C locale's decimal point while json always uses '.', so the token is rewritten to the locale's before parsing.
+static double ParseDouble(char* token, char** end)
+{
+    const char* decimalPoint = std::localeconv()->decimal_point;
+    if (decimalPoint && decimalPoint[0] != '.' && decimalPoint[0] != '\0' && decimalPoint[1] == '\0')
+    {
+        char* dot = std::strchr(token, '.');
+        if (dot)
+        {
+            *dot = decimalPoint[0];
+        }
+    }
+    return std::strtod(token, end);
+}
+
+static int HexValue(int c)
+{
+    if (c >= '0' && c <= '9')
+    {
+        return c - '0';
+    }
+    if (c >= 'a' && c <= 'f')
+    {
+        return c - 'a' + 10;
+    }
+    if (c >= 'A' && c <= 'F')
+    {
+        return c - 'A' + 10;
+    }
+    return -1;
+}
+
+static void AppendUtf8(Aws::String& value, unsigned codePoint)
+{
+    if (codePoint < 0x80)
+    {
+        value.push_back(static_cast<char>(codePoint));
+    }
+    else if (codePoint < 0x800)
+    {
+        value.push_back(static_cast<char>(0xC0 | (codePoint >> 6)));
+        value.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+    }
+    else if (codePoint < 0x10000)
+    {
+        value.push_back(static_cast<char>(0xE0 | (codePoint >> 12)));
+        value.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+        value.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+    }
+    else
+    {
+        value.push_back(static_cast<char>(0xF0 | (codePoint >> 18)));
+        value.push_back(static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F)));
+        value.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+        value.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+    }
+}
+
+JsonReader::JsonReader(const char* data, size_t length) :
+    m_current(data),
+    m_end(data + length),
+    m_stream(nullptr),
+    m_capture(nullptr),
+    m_offset(0),
+    m_afterOpen(false),
+    m_hasError(false)
+{
+}
+
+JsonReader::JsonReader(Aws::IStream& stream) :
+    m_current(m_chunk),
+    m_end(m_chunk),
+    m_stream(&stream),
+    m_capture(nullptr),
+    m_offset(0),
+    m_afterOpen(false),
+    m_hasError(false)
+{
+}
+
+bool JsonReader::Refill()
+{
+    if (!m_stream || !m_stream->rdbuf())
+    {
+        return false;
+    }
+
+    std::streamsize read = m_stream->rdbuf()->sgetn(m_chunk, CHUNK_SIZE);
+    m_current = m_chunk;
+    m_end = m_chunk + (read > 0 ? read : 0);
+    return m_current != m_end;
+}
+
+int JsonReader::PeekChar()
+{
+    if (m_current == m_end && !Refill())
+    {
+        return END_OF_INPUT;
+    }
+    return static_cast<unsigned char>(*m_current);
+}
+
+int JsonReader::GetChar()
+{
+    int c = PeekChar();
+    if (c != END_OF_INPUT)
+    {
+        if (m_capture)
+        {
+            m_capture->push_back(*m_current);
+        }
+        ++m_current;
+        ++m_offset;
+    }
+    return c;
+}
+
+int JsonReader::PeekToken()
+{
+    if (m_hasError)
+    {
+        return END_OF_INPUT;
+    }
+
+    for (;;)
+    {
+        int c = PeekChar();
+        if (c != ' ' && c != '\t' && c != '\n' && c != '\r')
+        {
+            return c;
+        }
+        GetChar();
+    }
+}
+
+bool JsonReader::SetError(const char* what)
+{
+    if (!m_hasError)
+    {
+        m_hasError = true;
+        m_errorMessage = "Expected ";
+        m_errorMessage.append(what);
+        m_errorMessage.append(" at offset ");
+        m_errorMessage.append(StringUtils::to_string(m_offset));
+    }
+    return false;
+}
+
+bool JsonReader::Expect(char expected, const char* what)
+{
+    if (PeekToken() != expected)
+    {
+        return SetError(what);
+    }
+    GetChar();
+    return true;
+}
+
+bool JsonReader::StartObject()
+{
+    if (!Expect('{', "object"))
+    {
+        return false;
+    }
+    m_afterOpen = true;
+    return true;
+}
+
+bool JsonReader::NextMember(Aws::String& key)
+{
+    int c = PeekToken();
+    if (c == '}')
+    {
+        GetChar();
+        m_afterOpen = false;
+        return false;
+    }
+
+    if (!m_afterOpen)
+    {
+        if (c != ',')
+        {
+            return SetError("',' or '}'");
+        }
+        GetChar();
+    }
+    m_afterOpen = false;
+
+    return ReadString(key) && Expect(':', "':'");
+}
+
+bool JsonReader::StartArray()
+{
+    if (!Expect('[', "array"))
+    {
+        return false;
+    }
+    m_afterOpen = true;
+    return true;
+}
+
+bool JsonReader::NextElement()
+{
+    int c = PeekToken();
+    if (c == ']')
+    {
+        GetChar();
+        m_afterOpen = false;
+        return false;
+    }
+
+    if (!m_afterOpen)
+    {
+        if (c != ',')
+        {
+            return SetError("',' or ']'");
+        }
+        GetChar();
+    }
+    m_afterOpen = false;
+
+    return !m_hasError;
+}
+
+bool JsonReader::ReadString(Aws::String& value)
+{
+    if (!Expect('"', "string"))
+    {
+        return false;
+    }
+
+    value.clear();
+    for (;;)
+    {
+        if (m_current == m_end && !Refill())
+        {
+            return SetError("closing '\"'");
+        }
+
+        // copy the run up to the next quote or escape in one go rather than a character at a time.
+        const char* run = m_current;
+        while (run != m_end && *run != '"' && *run != '\\')
+        {
+            ++run;
+        }
+        value.append(m_current, run);
+        if (m_capture)
+        {
+            m_capture->append(m_current, run);
+        }
+        m_offset += static_cast<size_t>(run - m_current);
+        m_current = run;
+
+        if (run == m_end)
+        {
+            continue;
+        }
+
+        if (GetChar() == '"')
+        {
+            return true;
+        }
+
+        if (!ReadEscape(value))
+        {
+            return false;
+        }
+    }
+}
+
+bool JsonReader::ReadHex4(unsigned& codePoint)
+{
+    codePoint = 0;
+    for (int i = 0; i < 4; ++i)
+    {
+        int digit = HexValue(GetChar());
+        if (digit < 0)
+        {
+            return SetError("hex digit");
+        }
+        codePoint = (codePoint << 4) | static_cast<unsigned>(digit);
+    }
+    return true;
+}
+
+bool JsonReader::ReadEscape(Aws::String& value)
+{
+    int c = GetChar();
+    switch (c)
+    {
+        case '"':
+        case '\\':
+        case '/':
+            value.push_back(static_cast<char>(c));
+            return true;
+        case 'b':
+            value.push_back('\b');
+            return true;
+        case 'f':
+            value.push_back('\f');
+            return true;
+        case 'n':
+            value.push_back('\n');
+            return true;
+        case 'r':
+            value.push_back('\r');
+            return true;
+        case 't':
+            value.push_back('\t');
+            return true;
+        case 'u':
+        {
+            unsigned codePoint = 0;
+            if (!ReadHex4(codePoint))
+            {
+                return false;
+            }
+
+            if (codePoint >= 0xD800 && codePoint <= 0xDBFF)
+            {
+                unsigned lowSurrogate = 0;
+                if (GetChar() != '\\' || GetChar() != 'u' || !ReadHex4(lowSurrogate) || lowSurrogate < 0xDC00 || lowSurrogate > 0xDFFF)
+                {
+                    return SetError("low surrogate");
+                }
+                codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (lowSurrogate - 0xDC00);
+            }
+            else if (codePoint >= 0xDC00 && codePoint <= 0xDFFF)
+            {
+                return SetError("high surrogate");
+            }
+
+            AppendUtf8(value, codePoint);
+            return true;
+        }
+        default:
+            return SetError("escape sequence");
+    }
+}
+
+bool JsonReader::SkipString()
+{
+    if (!Expect('"', "string"))
+    {
+        return false;
+    }
+
+    for (;;)
+    {
+        int c = GetChar();
+        if (c == '"')
+        {
+            return true;
+        }
+        if (c == END_OF_INPUT || (c == '\\' && GetChar() == END_OF_INPUT))
+        {
+            return SetError("closing '\"'");
+        }
+    }
+}
+
+bool JsonReader::ReadScalar(char* token, size_t capacity, size_t& length, const char* what)
+{
+    length = 0;
+    if (PeekToken() == END_OF_INPUT)
+    {
+        return SetError(what);
+    }
+
+    while (IsScalarChar(PeekChar()))
+    {
+        if (length + 1 == capacity)
+        {
+            return SetError(what);
+        }
+        token[length++] = static_cast<char>(GetChar());
+    }
+    token[length] = '\0';
+
+    return length > 0 || SetError(what);
+}
+
+bool JsonReader::ReadInt64(long long& value)
+{
+    char token[MAX_SCALAR_LENGTH];
+    size_t length = 0;
+    if (!ReadScalar(token, sizeof(token), length, "integer"))
+    {
+        return false;
+    }
+
+    char* end = nullptr;
+    value = std::strtoll(token, &end, 10);
+    if (end != token + length)
+    {
+        // integers sent in exponent or fractional notation.
+        double asDouble = ParseDouble(token, &end);
+        if (end != token + length)
+        {
+            return SetError("integer");
+        }
+        value = static_cast<long long>(asDouble);
+    }
+    return true;
+}
+
+bool JsonReader::ReadInteger(int& value)
+{
+    long long asInt64 = 0;
+    if (!ReadInt64(asInt64))
+    {
+        return false;
+    }
+    value = static_cast<int>(asInt64);
+    return true;
+}
+
+bool JsonReader::ReadDouble(double& value)
+{
+    char token[MAX_SCALAR_LENGTH];
+    size_t length = 0;
+    if (!ReadScalar(token, sizeof(token), length, "number"))
+    {
+        return false;
+    }
+
+    char* end = nullptr;
+    value = ParseDouble(token, &end);
+    return end == token + length || SetError("number");
+}
+
+bool JsonReader::ReadBool(bool& value)
+{
+    char token[MAX_SCALAR_LENGTH];
+    size_t length = 0;
+    if (!ReadScalar(token, sizeof(token), length, "boolean"))
+    {
+        return false;
+    }
+
+    if (std::strcmp(token, "true") == 0)
+    {
+        value = true;
+        return true;
+    }
+    if (std::strcmp(token, "false") == 0)
+    {
+        value = false;
+        return true;
+    }
+    return SetError("boolean");
+}
+
+bool JsonReader::ReadNull()
+{
+    if (PeekToken() != 'n')
+    {
+        return false;
+    }
+
+    char token[MAX_SCALAR_LENGTH];
+    size_t length = 0;
+    if (!ReadScalar(token, sizeof(token), length, "null") || std::strcmp(token, "null") != 0)
+    {
+        return SetError("null");
+    }
+    return true;
+}
+
+bool JsonReader::SkipValue()
+{
+    size_t depth = 0;
+    do
+    {
+        int c = PeekToken();
+        switch (c)
+        {
+            case '{':
+            case '[':
+                GetChar();
+                ++depth;
+                break;
+            case '}':
+            case ']':
+                if (depth == 0)
+                {
+                    return SetError("value");
+                }
+                GetChar();
+                --depth;
+                break;
+            case ',':
+            case ':':
+                if (depth == 0)
+                {
+                    return SetError("value");
+                }
+                GetChar();
+                break;
+            case '"':
+                if (!SkipString())
+                {
+                    return false;
+                }
+                break;
+            case END_OF_INPUT:
+                return SetError("value");
+            default:
+            {
+                char token[MAX_SCALAR_LENGTH];
+                size_t length = 0;
+                if (!ReadScalar(token, sizeof(token), length, "value"))
+                {
+                    return false;
+                }
+                break;
+            }
+        }
+    } while (depth > 0);
+
+    return true;
+}
+
+bool JsonReader::ReadValue(JsonValue& value)
+{
+    if (PeekToken() == END_OF_INPUT)
+    {
+        return SetError("value");
+    }
+
+    Aws::String captured;
+    m_capture = &captured;
+    bool skipped = SkipValue();
+    m_capture = nullptr;
+    if (!skipped)
+    {
+        return false;
+    }
+
+    value = JsonValue(captured);
+    return value.WasParseSuccessful() || SetError("value");
+}
+
+namespace Aws
+{
+    namespace Utils
+    {
+        namespace Json
+        {
+            bool ReadJson(JsonReader& reader, Aws::String& value)
+            {
+                return reader.ReadNull() || reader.ReadString(value);
+            }
+
+            bool ReadJson(JsonReader& reader, int& value)
+            {
+                return reader.ReadNull() || reader.ReadInteger(value);
+            }
+
+            bool ReadJson(JsonReader& reader, long long& value)
+            {
+                return reader.ReadNull() || reader.ReadInt64(value);
+            }
+
+            bool ReadJson(JsonReader& reader, double& value)
+            {
+                return reader.ReadNull() || reader.ReadDouble(value);
+            }
+
+            bool ReadJson(JsonReader& reader, bool& value)
+            {
+                return reader.ReadNull() || reader.ReadBool(value);
+            }
+
+            bool ReadJson(JsonReader& reader, ByteBuffer& value)
+            {
+                if (reader.ReadNull())
+                {
+                    return true;
+                }
+
+                Aws::String encoded;
+                if (!reader.ReadString(encoded))
+                {
+                    return false;
+                }
+                value = HashingUtils::Base64Decode(encoded);
+                return true;
+            }
+
+            bool ReadJson(JsonReader& reader, DateTime& value)
+            {
+                if (reader.ReadNull())
+                {
+                    return true;
+                }
+
+                double secondsSinceEpoch = 0.0;
+                if (!reader.ReadDouble(secondsSinceEpoch))
+                {
+                    return false;
+                }
+                value = secondsSinceEpoch;
+                return true;
+            }
+
+            bool ReadJson(JsonReader& reader, JsonValue& value)
+            {
+                return reader.ReadValue(value);
+            }
+        } // namespace Json
+    } // namespace Utils
+} // namespace Aws
@@ -44,6 +44,17 @@ JsonValue::JsonValue(Aws::IStream& istream) : m_wasParseSuccessful(true)
     }
 }
 
+JsonValue::JsonValue(const char* data, size_t length) : m_wasParseSuccessful(true)
+{
+    Aws::External::Json::Reader reader;
+
+    if (!reader.parse(data, data + length, m_value))
+    {
+        m_wasParseSuccessful = false;
+        m_errorMessage = reader.getFormattedErrorMessages();
+    }
+}
+
 JsonValue::JsonValue(const JsonValue& value) : 
     m_value(value.m_value), 
     m_wasParseSuccessful(value.m_wasParseSuccessful), 
@@ -0,0 +1,259 @@
+
+/*
+* Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+*
+* Licensed under the Apache License, Version 2.0 (the "License").
+* You may not use this file except in compliance with the License.
+* A copy of the License is located at
+*
+*  http://aws.amazon.com/apache2.0
+*
+* or in the "license" file accompanying this file. This file is distributed
+* on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+* express or implied. See the License for the specific language governing
+* permissions and limitations under the License.
+*/
+
+#include <aws/core/utils/json/JsonWriter.h>
+#include <aws/core/utils/DateTime.h>
+#include <aws/core/utils/HashingUtils.h>
+
+#include <clocale>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+using namespace Aws::Utils;
+using namespace Aws::Utils::Json;
+
+static const char HEX_DIGITS[] = "0123456789abcdef";
+
+JsonWriter::JsonWriter(Aws::String& output) :
+    m_output(output),
+    m_needsSeparator(false)
+{
+}
+
+void JsonWriter::BeginValue()
+{
+    if (m_needsSeparator)
+    {
+        m_output.push_back(',');
+    }
+    m_needsSeparator = true;
+}
+
+void JsonWriter::StartObject()
+{
+    BeginValue();
+    m_output.push_back('{');
+    m_needsSeparator = false;
+}
+
+void JsonWriter::EndObject()
+{
+    m_output.push_back('}');
+    m_needsSeparator = true;
+}
+
+void JsonWriter::StartArray()
+{
+    BeginValue();
+    m_output.push_back('[');
+    m_needsSeparator = false;
+}
+
+void JsonWriter::EndArray()
+{
+    m_output.push_back(']');
+    m_needsSeparator = true;
+}
+
+void JsonWriter::Key(const char* key)
+{
+    BeginValue();
+    AppendEscaped(key, std::strlen(key));
+    m_output.push_back(':');
+    m_needsSeparator = false;
+}
+
+void JsonWriter::Key(const Aws::String& key)
+{
+    BeginValue();
+    AppendEscaped(key.c_str(), key.size());
+    m_output.push_back(':');
+    m_needsSeparator = false;
+}
+
+void JsonWriter::String(const char* value)
+{
+    BeginValue();
+    AppendEscaped(value, std::strlen(value));
+}
+
+void JsonWriter::String(const Aws::String& value)
+{
+    BeginValue();
+    AppendEscaped(value.c_str(), value.size());
+}
+
+void JsonWriter::Integer(int value)
+{
+    Int64(value);
+}
+
+void JsonWriter::Int64(long long value)
+{
+    BeginValue();
+    char digits[24];
+    int length = std::snprintf(digits, sizeof(digits), "%lld", value);
+    m_output.append(digits, static_cast<size_t>(length));
+}
+
+void JsonWriter::Double(double value)
+{
+    if (!std::isfinite(value))
+    {
+        Null();
+        return;
+    }
+
+    BeginValue();
+    // same precision the json-cpp writer uses, so values round trip exactly.
+    char digits[32];
+    int length = std::snprintf(digits, sizeof(digits), "%.17g", value);
+    size_t start = m_output.size();
+    m_output.append(digits, static_cast<size_t>(length));
+
+    // snprintf writes the C locale's decimal point, e.g. "1,5" under de_DE, json always uses '.'.
+    const char* decimalPoint = std::localeconv()->decimal_point;
+    if (decimalPoint && decimalPoint[0] != '\0' && std::strcmp(decimalPoint, ".") != 0)
+    {
+        size_t position = m_output.find(decimalPoint, start);
+        if (position != Aws::String::npos)
+        {
+            m_output.replace(position, std::strlen(decimalPoint), 1, '.');
+        }
+    }
+}
+
+void JsonWriter::Bool(bool value)
+{
+    BeginValue();
+    m_output.append(value ? "true" : "false");
+}
+
+void JsonWriter::Null()
+{
+    BeginValue();
+    m_output.append("null");
+}
+
+void JsonWriter::RawValue(const Aws::String& json)
+{
+    BeginValue();
+    m_output.append(json);
+}
+
+void JsonWriter::AppendEscaped(const char* value, size_t length)
+{
+    m_output.push_back('"');
+
+    const char* end = value + length;
+    while (value != end)
+    {
+        // copy the run up to the next character that needs escaping in one go rather than a character at a time.
+        const char* run = value;
+        while (run != end && *run != '"' && *run != '\\' && static_cast<unsigned char>(*run) >= 0x20)
+        {
+            ++run;
+        }
+        m_output.append(value, run);
+        if (run == end)
+        {
+            break;
+        }
+
+        char c = *run;
+        m_output.push_back('\\');
+        switch (c)
+        {
+            case '"':
+            case '\\':
+                m_output.push_back(c);
+                break;
+            case '\b':
+                m_output.push_back('b');
+                break;
+            case '\f':
+                m_output.push_back('f');
+                break;
+            case '\n':
+                m_output.push_back('n');
+                break;
+            case '\r':
+                m_output.push_back('r');
+                break;
+            case '\t':
+                m_output.push_back('t');
+                break;
+            default:
+                m_output.append("u00");
+                m_output.push_back(HEX_DIGITS[(c >> 4) & 0x0F]);
+                m_output.push_back(HEX_DIGITS[c & 0x0F]);
+                break;
+        }
+        value = run + 1;
+    }
+
+    m_output.push_back('"');
+}
+
+namespace Aws
+{
+    namespace Utils
+    {
+        namespace Json
+        {
+            void WriteJson(JsonWriter& writer, const Aws::String& value)
+            {
+                writer.String(value);
+            }
+
+            void WriteJson(JsonWriter& writer, int value)
+            {
+                writer.Integer(value);
+            }
+
+            void WriteJson(JsonWriter& writer, long long value)
+            {
+                writer.Int64(value);
+            }
+
+            void WriteJson(JsonWriter& writer, double value)
+            {
+                writer.Double(value);
+            }
+
+            void WriteJson(JsonWriter& writer, bool value)
+            {
+                writer.Bool(value);
+            }
+
+            void WriteJson(JsonWriter& writer, const ByteBuffer& value)
+            {
+                writer.String(HashingUtils::Base64Encode(value));
+            }
+
+            void WriteJson(JsonWriter& writer, const DateTime& value)
+            {
+                writer.Double(value.SecondsWithMSPrecision());
+            }
+
+            void WriteJson(JsonWriter& writer, const JsonValue& value)
+            {
+                writer.RawValue(value.WriteCompact(false));
+            }
+        } // namespace Json
+    } // namespace Utils
+} // namespace Aws
@@ -0,0 +1,469 @@
+/*
+  * Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+  * 
+  * Licensed under the Apache License, Version 2.0 (the "License").
+  * You may not use this file except in compliance with the License.
+  * A copy of the License is located at
+  * 
+  *  http://aws.amazon.com/apache2.0
+  * 
+  * or in the "license" file accompanying this file. This file is distributed
+  * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+  * express or implied. See the License for the specific language governing
+  * permissions and limitations under the License.
+  */
+
+#include <aws/core/utils/logging/RingBufferLogSystem.h>
+
+#include <aws/core/utils/DateTime.h>
+#include <aws/core/utils/memory/AWSMemory.h>
+
+#include <fstream>
+#include <cstdarg>
+#include <cstring>
+#include <stdio.h>
+#include <chrono>
+
+using namespace Aws::Utils;
+using namespace Aws::Utils::Logging;
+
+static const char* AllocationTag = "RingBufferLogSystem";
+static const size_t MAX_RING_COUNT = 64;
+static const std::chrono::milliseconds DRAIN_INTERVAL(100);
+
+struct RingBufferLogSystem::LogRecord
+{
+    LogRecord() : m_sequence(0), m_position(0), m_timestamp(0), m_level(LogLevel::Off), m_length(0), m_spilled(nullptr) {}
+
+    std::atomic<size_t> m_sequence;
+    size_t m_position;
+    int64_t m_timestamp;
+    std::thread::id m_threadId;
+    LogLevel m_level;
+    size_t m_length;
+    Aws::String* m_spilled;
+    char m_tag[MAX_TAG_LENGTH + 1];
+    char m_message[INLINE_MESSAGE_LENGTH];
+};
+
+/**
+ * Bounded multi producer, single consumer queue of records. Every record carries a sequence number saying whether it is free for
+ * the producer claiming that position or published for the consumer, so producers only contend on the enqueue position.
+ */
+class RingBufferLogSystem::LogRing
+{
+public:
+    LogRing(size_t capacity) : m_records(capacity), m_mask(capacity - 1), m_enqueuePosition(0), m_dequeuePosition(0)
+    {
+        for (size_t i = 0; i < capacity; ++i)
+        {
+            m_records[i].m_sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    LogRecord* TryClaim()
+    {
+        size_t position = m_enqueuePosition.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            LogRecord& record = m_records[position & m_mask];
+            size_t sequence = record.m_sequence.load(std::memory_order_acquire);
+            if (sequence == position)
+            {
+                if (m_enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                {
+                    record.m_position = position;
+                    return &record;
+                }
+            }
+            else if (sequence < position)
+            {
+                // the record still holds the statement from one lap ago, the ring is full.
+                return nullptr;
+            }
+            else
+            {
+                position = m_enqueuePosition.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    void Publish(LogRecord* record)
+    {
+        record->m_sequence.store(record->m_position + 1, std::memory_order_release);
+    }
+
+    LogRecord* Peek()
+    {
+        LogRecord& record = m_records[m_dequeuePosition & m_mask];
+        return record.m_sequence.load(std::memory_order_acquire) == m_dequeuePosition + 1 ? &record : nullptr;
+    }
+
+    void Release(LogRecord* record)
+    {
+        record->m_sequence.store(m_dequeuePosition + m_mask + 1, std::memory_order_release);
+        ++m_dequeuePosition;
+    }
+
+    size_t GetCapacity() const { return m_mask + 1; }
+
+private:
+    Aws::Vector<LogRecord> m_records;
+    size_t m_mask;
+    std::atomic<size_t> m_enqueuePosition;
+    // keeps the producers' position and the drainer's position off the same cache line.
+    char m_padding[64];
+    size_t m_dequeuePosition;
+};
+
+static std::shared_ptr<Aws::OFStream> MakeDefaultLogFile(const Aws::String& filenamePrefix)
+{
+    Aws::String newFileName = filenamePrefix + DateTime::CalculateLocalTimestampAsString("%Y-%m-%d-%H") + ".log";
+    return Aws::MakeShared<Aws::OFStream>(AllocationTag, newFileName.c_str(), Aws::OFStream::out | Aws::OFStream::app);
+}
+
+static size_t RoundUpToPowerOfTwo(size_t value)
+{
+    size_t result = 1;
+    while (result < value)
+    {
+        result <<= 1;
+    }
+    return result;
+}
+
+static int FormatStatement(char* buffer, size_t bufferSize, const char* formatStr, va_list args)
+{
+#ifdef WIN32
+    va_list lengthArgs;
+    va_copy(lengthArgs, args);
+    const int requiredLength = _vscprintf(formatStr, lengthArgs);
+    va_end(lengthArgs);
+    vsnprintf_s(buffer, bufferSize, _TRUNCATE, formatStr, args);
+    return requiredLength;
+#else
+    return vsnprintf(buffer, bufferSize, formatStr, args);
+#endif // WIN32
+}
+
+static const char* GetLevelPrefix(LogLevel logLevel)
+{
+    switch(logLevel)
+    {
+        case LogLevel::Error:
+            return "[ERROR] ";
+        case LogLevel::Fatal:
+            return "[FATAL] ";
+        case LogLevel::Warn:
+            return "[WARN] ";
+        case LogLevel::Info:
+            return "[INFO] ";
+        case LogLevel::Debug:
+            return "[DEBUG] ";
+        case LogLevel::Trace:
+            return "[TRACE] ";
+        default:
+            return "[UNKOWN] ";
+    }
+}
+
+RingBufferLogSystem::RingBufferLogSystem(LogLevel logLevel, const std::shared_ptr<Aws::OStream>& logFile,
+        RingBufferOverflowPolicy overflowPolicy, size_t recordsPerRing) :
+    m_logLevel(logLevel),
+    m_overflowPolicy(overflowPolicy),
+    m_recordsPerRing(RoundUpToPowerOfTwo(recordsPerRing > 2 ? recordsPerRing : 2)),
+    m_droppedCount(0),
+    m_blockedCount(0),
+    m_spilledCount(0),
+    m_drainerWaiting(false),
+    m_stopLogging(false),
+    m_lastTimestampSecond(-1)
+{
+    Start(logFile, "", false);
+}
+
+RingBufferLogSystem::RingBufferLogSystem(LogLevel logLevel, const Aws::String& filenamePrefix,
+        RingBufferOverflowPolicy overflowPolicy, size_t recordsPerRing) :
+    m_logLevel(logLevel),
+    m_overflowPolicy(overflowPolicy),
+    m_recordsPerRing(RoundUpToPowerOfTwo(recordsPerRing > 2 ? recordsPerRing : 2)),
+    m_droppedCount(0),
+    m_blockedCount(0),
+    m_spilledCount(0),
+    m_drainerWaiting(false),
+    m_stopLogging(false),
+    m_lastTimestampSecond(-1)
+{
+    Start(MakeDefaultLogFile(filenamePrefix), filenamePrefix, true);
+}
+
+RingBufferLogSystem::~RingBufferLogSystem()
+{
+    {
+        std::lock_guard<std::mutex> locker(m_signalMutex);
+        m_stopLogging.store(true);
+    }
+    m_signal.notify_one();
+    m_drainerThread.join();
+
+    for (auto ring : m_rings)
+    {
+        Aws::Delete(ring);
+    }
+}
+
+void RingBufferLogSystem::Start(const std::shared_ptr<Aws::OStream>& logFile, const Aws::String& filenamePrefix, bool rollLog)
+{
+    unsigned cores = std::thread::hardware_concurrency();
+    size_t ringCount = RoundUpToPowerOfTwo(cores > 0 ? cores : 1);
+    ringCount = ringCount < MAX_RING_COUNT ? ringCount : MAX_RING_COUNT;
+    for (size_t i = 0; i < ringCount; ++i)
+    {
+        m_rings.push_back(Aws::New<LogRing>(AllocationTag, m_recordsPerRing));
+    }
+
+    m_drainerThread = std::thread(&RingBufferLogSystem::DrainLoop, this, logFile, filenamePrefix, rollLog);
+}
+
+RingBufferLogSystem::LogRecord* RingBufferLogSystem::ClaimRecord(LogRing*& ring)
+{
+    // thread ids are often aligned pointers, so mix the bits before picking a ring.
+    uint64_t hash = static_cast<uint64_t>(std::hash<std::thread::id>()(std::this_thread::get_id()));
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+    ring = m_rings[static_cast<size_t>(hash) & (m_rings.size() - 1)];
+
+    bool counted = false;
+    for (;;)
+    {
+        LogRecord* record = ring->TryClaim();
+        if (record)
+        {
+            record->m_timestamp = DateTime::CurrentTimeMillis();
+            record->m_threadId = std::this_thread::get_id();
+            record->m_spilled = nullptr;
+            return record;
+        }
+
+        if (m_overflowPolicy == RingBufferOverflowPolicy::DROP || m_stopLogging.load())
+        {
+            ++m_droppedCount;
+            return nullptr;
+        }
+
+        if (!counted)
+        {
+            ++m_blockedCount;
+            counted = true;
+        }
+
+        {
+            std::lock_guard<std::mutex> locker(m_signalMutex);
+            m_signal.notify_one();
+        }
+        std::this_thread::yield();
+    }
+}
+
+void RingBufferLogSystem::PublishRecord(LogRing* ring, LogRecord* record)
+{
+    ring->Publish(record);
+
+    // pairs with the fence in DrainLoop, either the drainer sees this record before sleeping or this thread sees it waiting.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (m_drainerWaiting.load(std::memory_order_relaxed))
+    {
+        std::lock_guard<std::mutex> locker(m_signalMutex);
+        m_signal.notify_one();
+    }
+}
+
+static void CopyTag(char* destination, const char* tag, size_t maxLength)
+{
+    size_t length = 0;
+    if (tag)
+    {
+        while (length < maxLength && tag[length] != '\0')
+        {
+            ++length;
+        }
+        std::memcpy(destination, tag, length);
+    }
+    destination[length] = '\0';
+}
+
+void RingBufferLogSystem::Log(LogLevel logLevel, const char* tag, const char* formatStr, ...)
+{
+    LogRing* ring = nullptr;
+    LogRecord* record = ClaimRecord(ring);
+    if (!record)
+    {
+        return;
+    }
+
+    record->m_level = logLevel;
+    CopyTag(record->m_tag, tag, MAX_TAG_LENGTH);
+
+    std::va_list args;
+    va_start(args, formatStr);
+
+    va_list inlineArgs; //unfortunately you cannot consume a va_list twice
+    va_copy(inlineArgs, args);
+    int length = FormatStatement(record->m_message, INLINE_MESSAGE_LENGTH, formatStr, inlineArgs);
+    va_end(inlineArgs);
+
+    if (length < 0)
+    {
+        length = 0;
+    }
+    else if (static_cast<size_t>(length) >= INLINE_MESSAGE_LENGTH)
+    {
+        record->m_spilled = Aws::New<Aws::String>(AllocationTag, static_cast<size_t>(length) + 1, '\0');
+        FormatStatement(&(*record->m_spilled)[0], static_cast<size_t>(length) + 1, formatStr, args);
+        record->m_spilled->resize(static_cast<size_t>(length));
+        ++m_spilledCount;
+    }
+    record->m_length = static_cast<size_t>(length);
+
+    va_end(args);
+
+    PublishRecord(ring, record);
+}
+
+//reads the text written to a string stream's buffer in place, str() would first copy it to a new string.
+class PutAreaReader : public std::streambuf
+{
+public:
+    static const char* Begin(const std::streambuf& buffer) { return (buffer.*&PutAreaReader::pbase)(); }
+    static const char* End(const std::streambuf& buffer) { return (buffer.*&PutAreaReader::pptr)(); }
+};
+
+void RingBufferLogSystem::LogStream(LogLevel logLevel, const char* tag, const Aws::OStringStream& messageStream)
+{
+    LogRing* ring = nullptr;
+    LogRecord* record = ClaimRecord(ring);
+    if (!record)
+    {
+        return;
+    }
+
+    record->m_level = logLevel;
+    CopyTag(record->m_tag, tag, MAX_TAG_LENGTH);
+
+    const std::streambuf* messageBuffer = messageStream.rdbuf();
+    const char* message = PutAreaReader::Begin(*messageBuffer);
+    size_t length = message ? static_cast<size_t>(PutAreaReader::End(*messageBuffer) - message) : 0;
+    record->m_length = length;
+    if (length < INLINE_MESSAGE_LENGTH)
+    {
+        if (length > 0)
+        {
+            std::memcpy(record->m_message, message, length);
+        }
+    }
+    else
+    {
+        record->m_spilled = Aws::New<Aws::String>(AllocationTag, message, length);
+        ++m_spilledCount;
+    }
+
+    PublishRecord(ring, record);
+}
+
+void RingBufferLogSystem::DrainLoop(std::shared_ptr<Aws::OStream> log, Aws::String filenamePrefix, bool rollLog)
+{
+    int32_t lastRolledHour = DateTime::CalculateCurrentHour();
+
+    for (;;)
+    {
+        bool stopping = m_stopLogging.load();
+
+        if (rollLog)
+        {
+            int32_t currentHour = DateTime::CalculateCurrentHour();
+            if (currentHour != lastRolledHour)
+            {
+                log = MakeDefaultLogFile(filenamePrefix);
+                lastRolledHour = currentHour;
+            }
+        }
+
+        if (DrainRings(*log) > 0)
+        {
+            log->flush();
+            continue;
+        }
+
+        // stopping was read before the last drain came up empty, so everything logged before the destructor ran is written.
+        if (stopping)
+        {
+            break;
+        }
+
+        std::unique_lock<std::mutex> locker(m_signalMutex);
+        m_drainerWaiting.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        bool pending = false;
+        for (auto ring : m_rings)
+        {
+            pending = pending || ring->Peek() != nullptr;
+        }
+
+        if (!pending && !m_stopLogging.load())
+        {
+            m_signal.wait_for(locker, DRAIN_INTERVAL);
+        }
+        m_drainerWaiting.store(false, std::memory_order_relaxed);
+    }
+}
+
+size_t RingBufferLogSystem::DrainRings(Aws::OStream& log)
+{
+    size_t drained = 0;
+    for (auto ring : m_rings)
+    {
+        // at most one lap per ring, so one busy thread can not keep the others waiting.
+        for (size_t i = 0; i < ring->GetCapacity(); ++i)
+        {
+            LogRecord* record = ring->Peek();
+            if (!record)
+            {
+                break;
+            }
+
+            WriteRecord(log, *record);
+            if (record->m_spilled)
+            {
+                Aws::Delete(record->m_spilled);
+                record->m_spilled = nullptr;
+            }
+            ring->Release(record);
+            ++drained;
+        }
+    }
+    return drained;
+}
+
+void RingBufferLogSystem::WriteRecord(Aws::OStream& log, LogRecord& record)
+{
+    // formatting the local time is the expensive part of the prefix and only changes once a second.
+    int64_t second = record.m_timestamp / 1000;
+    if (second != m_lastTimestampSecond)
+    {
+        m_lastTimestamp = DateTime(second * 1000).ToLocalTimeString("%Y-%m-%d %H:%M:%S");
+        m_lastTimestampSecond = second;
+    }
+
+    log << GetLevelPrefix(record.m_level) << m_lastTimestamp << " " << record.m_tag << " [" << record.m_threadId << "] ";
+    if (record.m_spilled)
+    {
+        log.write(record.m_spilled->c_str(), static_cast<std::streamsize>(record.m_spilled->size()));
+    }
+    else
+    {
+        log.write(record.m_message, static_cast<std::streamsize>(record.m_length));
+    }
+    log << '\n';
+}
@@ -0,0 +1,265 @@
+/*
+* Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+*
+* Licensed under the Apache License, Version 2.0 (the "License").
+* You may not use this file except in compliance with the License.
+* A copy of the License is located at
+*
+*  http://aws.amazon.com/apache2.0
+*
+* or in the "license" file accompanying this file. This file is distributed
+* on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+* express or implied. See the License for the specific language governing
+* permissions and limitations under the License.
+*/
+
+#include <aws/core/utils/memory/ArenaMemorySystem.h>
+
+#include <cstdlib>
+#include <new>
+
+#if defined(_MSC_VER) && _MSC_VER < 1900
+#define AWS_ARENA_THREAD_LOCAL __declspec(thread)
+#else
+#define AWS_ARENA_THREAD_LOCAL thread_local
+#endif
+
+using namespace Aws::Utils::Memory;
+
+namespace Aws
+{
+    namespace Utils
+    {
+        namespace Memory
+        {
+            /**
+             * Sits right in front of every pointer handed out by ArenaMemorySystem. arena is nullptr for memory that came from the
+             * underlying system, in which case offset is the distance back to the start of the underlying allocation.
+             */
+            struct AllocationHeader
+            {
+                Arena* arena;
+                std::size_t offset;
+            };
+
+            static const std::size_t HEADER_SPACE = 16;
+            static_assert(sizeof(AllocationHeader) <= HEADER_SPACE, "Allocation header does not fit in the space reserved for it");
+
+            static char* AlignUp(char* ptr, std::size_t alignment)
+            {
+                uintptr_t value = reinterpret_cast<uintptr_t>(ptr);
+                return ptr + ((alignment - value % alignment) % alignment);
+            }
+
+            static AllocationHeader* GetHeader(void* memoryPtr)
+            {
+                return reinterpret_cast<AllocationHeader*>(static_cast<char*>(memoryPtr) - HEADER_SPACE);
+            }
+
+            /**
+             * A chain of blocks bump allocated by the thread that owns the scope. The scope holds one reference and every live allocation
+             * another, so the blocks go back to the underlying system once the scope has ended and the last allocation is freed.
+             */
+            class Arena
+            {
+            public:
+                Arena(ArenaMemorySystem& owner) : m_owner(owner), m_blocks(nullptr), m_cursor(nullptr), m_end(nullptr), m_references(1)
+                {
+                }
+
+                ArenaMemorySystem& GetOwner() const { return m_owner; }
+
+                void* Allocate(std::size_t blockSize, std::size_t alignment)
+                {
+                    char* userMemory = m_cursor ? AlignUp(m_cursor + HEADER_SPACE, alignment) : nullptr;
+                    if (!userMemory || userMemory + blockSize > m_end)
+                    {
+                        if (!GrowBlocks())
+                        {
+                            return nullptr;
+                        }
+                        userMemory = AlignUp(m_cursor + HEADER_SPACE, alignment);
+                    }
+
+                    m_cursor = userMemory + blockSize;
+                    AllocationHeader* header = GetHeader(userMemory);
+                    header->arena = this;
+                    header->offset = 0;
+                    m_references.fetch_add(1, std::memory_order_relaxed);
+                    m_owner.m_arenaAllocations.fetch_add(1, std::memory_order_relaxed);
+                    return userMemory;
+                }
+
+                void Release()
+                {
+                    if (m_references.fetch_sub(1, std::memory_order_acq_rel) != 1)
+                    {
+                        return;
+                    }
+
+                    ArenaMemorySystem& owner = m_owner;
+                    Block* block = m_blocks;
+                    while (block)
+                    {
+                        Block* next = block->next;
+                        owner.UnderlyingFree(block);
+                        block = next;
+                    }
+
+                    this->~Arena();
+                    owner.UnderlyingFree(this);
+                }
+
+            private:
+                struct Block
+                {
+                    Block* next;
+                };
+
+                bool GrowBlocks()
+                {
+                    void* rawBlock = m_owner.UnderlyingAllocate(m_owner.m_blockSize, HEADER_SPACE, "ArenaBlock");
+                    if (!rawBlock)
+                    {
+                        return false;
+                    }
+
+                    Block* block = static_cast<Block*>(rawBlock);
+                    block->next = m_blocks;
+                    m_blocks = block;
+                    m_cursor = static_cast<char*>(rawBlock) + sizeof(Block);
+                    m_end = static_cast<char*>(rawBlock) + m_owner.m_blockSize;
+                    m_owner.m_arenaBlocks.fetch_add(1, std::memory_order_relaxed);
+                    return true;
+                }
+
+                ArenaMemorySystem& m_owner;
+                Block* m_blocks;
+                char* m_cursor;
+                char* m_end;
+                std::atomic<size_t> m_references;
+            };
+
+            static AWS_ARENA_THREAD_LOCAL Arena* s_currentArena = nullptr;
+
+        } // namespace Memory
+    } // namespace Utils
+} // namespace Aws
+
+const std::size_t ArenaMemorySystem::DEFAULT_BLOCK_SIZE;
+
+ArenaMemorySystem::ArenaMemorySystem(MemorySystemInterface* underlyingSystem, std::size_t blockSize) :
+    m_underlyingSystem(underlyingSystem),
+    m_blockSize(blockSize),
+    m_arenaAllocations(0),
+    m_arenaBlocks(0)
+{
+}
+
+void ArenaMemorySystem::Begin()
+{
+    if (m_underlyingSystem)
+    {
+        m_underlyingSystem->Begin();
+    }
+}
+
+void ArenaMemorySystem::End()
+{
+    if (m_underlyingSystem)
+    {
+        m_underlyingSystem->End();
+    }
+}
+
+void* ArenaMemorySystem::AllocateMemory(std::size_t blockSize, std::size_t alignment, const char* allocationTag)
+{
+    if (alignment < HEADER_SPACE)
+    {
+        alignment = HEADER_SPACE;
+    }
+
+    Arena* arena = s_currentArena;
+    if (arena && &arena->GetOwner() == this && blockSize <= m_blockSize / 4 && alignment <= m_blockSize / 4)
+    {
+        void* arenaMemory = arena->Allocate(blockSize, alignment);
+        if (arenaMemory)
+        {
+            return arenaMemory;
+        }
+    }
+
+    // Leave room for the header plus enough slack to align the user pointer regardless of what the underlying system gives back.
+    char* rawMemory = static_cast<char*>(UnderlyingAllocate(blockSize + HEADER_SPACE + alignment - 1, alignment, allocationTag));
+    if (!rawMemory)
+    {
+        return nullptr;
+    }
+
+    char* userMemory = AlignUp(rawMemory + HEADER_SPACE, alignment);
+    AllocationHeader* header = GetHeader(userMemory);
+    header->arena = nullptr;
+    header->offset = static_cast<std::size_t>(userMemory - rawMemory);
+    return userMemory;
+}
+
+void ArenaMemorySystem::FreeMemory(void* memoryPtr)
+{
+    if (!memoryPtr)
+    {
+        return;
+    }
+
+    AllocationHeader* header = GetHeader(memoryPtr);
+    if (header->arena)
+    {
+        header->arena->Release();
+    }
+    else
+    {
+        UnderlyingFree(static_cast<char*>(memoryPtr) - header->offset);
+    }
+}
+
+void* ArenaMemorySystem::UnderlyingAllocate(std::size_t blockSize, std::size_t alignment, const char* allocationTag)
+{
+    if (m_underlyingSystem)
+    {
+        return m_underlyingSystem->AllocateMemory(blockSize, alignment, allocationTag);
+    }
+
+    return malloc(blockSize);
+}
+
+void ArenaMemorySystem::UnderlyingFree(void* memoryPtr)
+{
+    if (m_underlyingSystem)
+    {
+        m_underlyingSystem->FreeMemory(memoryPtr);
+    }
+    else
+    {
+        free(memoryPtr);
+    }
+}
+
+ScopedArena::ScopedArena(ArenaMemorySystem& memorySystem) :
+    m_arena(nullptr),
+    m_previousArena(s_currentArena)
+{
+    void* rawArena = memorySystem.UnderlyingAllocate(sizeof(Arena), HEADER_SPACE, "ScopedArena");
+    if (rawArena)
+    {
+        m_arena = new (rawArena) Arena(memorySystem);
+        s_currentArena = m_arena;
+    }
+}
+
+ScopedArena::~ScopedArena()
+{
+    s_currentArena = m_previousArena;
+    if (m_arena)
+    {
+        m_arena->Release();
+    }
+}
@@ -0,0 +1,242 @@
+
+/*
+* Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+*
+* Licensed under the Apache License, Version 2.0 (the "License").
+* You may not use this file except in compliance with the License.
+* A copy of the License is located at
+*
+*  http://aws.amazon.com/apache2.0
+*
+* or in the "license" file accompanying this file. This file is distributed
+* on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+* express or implied. See the License for the specific language governing
+* permissions and limitations under the License.
+*/
+
+#include <aws/core/utils/stream/ChunkedBodySink.h>
+#include <aws/core/utils/memory/AWSMemory.h>
+
+#include <algorithm>
+#include <cstring>
+
+namespace Aws
+{
+namespace Utils
+{
+namespace Stream
+{
+
+static const char* CHUNKED_BODY_SINK_ALLOCATION_TAG = "ChunkedBodySink";
+
+BodyChunkPool::BodyChunkPool(size_t chunkSize, size_t maxPooledChunks) :
+    m_chunkSize(chunkSize),
+    m_maxPooledChunks(maxPooledChunks)
+{
+}
+
+BodyChunkPool::~BodyChunkPool()
+{
+    for (char* chunk : m_freeChunks)
+    {
+        Aws::DeleteArray<char>(chunk);
+    }
+}
+
+char* BodyChunkPool::Acquire()
+{
+    {
+        std::lock_guard<std::mutex> locker(m_lock);
+        if (!m_freeChunks.empty())
+        {
+            char* chunk = m_freeChunks.back();
+            m_freeChunks.pop_back();
+            return chunk;
+        }
+    }
+
+    return Aws::NewArray<char>(m_chunkSize, CHUNKED_BODY_SINK_ALLOCATION_TAG);
+}
+
+void BodyChunkPool::Release(char* chunk)
+{
+    {
+        std::lock_guard<std::mutex> locker(m_lock);
+        if (m_freeChunks.size() < m_maxPooledChunks)
+        {
+            m_freeChunks.push_back(chunk);
+            return;
+        }
+    }
+
+    Aws::DeleteArray<char>(chunk);
+}
+
+ChunkedBodySink::ChunkedBodySink(const std::shared_ptr<BodyChunkPool>& pool) :
+    m_pool(pool),
+    m_size(0),
+    m_readChunk(0)
+{
+    //no put area, every write goes through xsputn/overflow.
+    setp(nullptr, nullptr);
+    setg(nullptr, nullptr, nullptr);
+}
+
+ChunkedBodySink::~ChunkedBodySink()
+{
+    for (char* chunk : m_chunks)
+    {
+        m_pool->Release(chunk);
+    }
+}
+
+size_t ChunkedBodySink::Append(const char* data, size_t length)
+{
+    return static_cast<size_t>(xsputn(data, static_cast<std::streamsize>(length)));
+}
+
+bool ChunkedBodySink::GetContiguousData(const char*& data) const
+{
+    if (m_chunks.size() > 1)
+    {
+        return false;
+    }
+
+    data = m_chunks.empty() ? nullptr : m_chunks.front();
+    return true;
+}
+
+Aws::Vector<std::pair<const char*, size_t>> ChunkedBodySink::GetChunks() const
+{
+    Aws::Vector<std::pair<const char*, size_t>> chunks;
+    size_t chunkSize = m_pool->GetChunkSize();
+    for (size_t i = 0; i < m_chunks.size(); ++i)
+    {
+        chunks.emplace_back(m_chunks[i], (std::min)(chunkSize, m_size - i * chunkSize));
+    }
+
+    return chunks;
+}
+
+std::streampos ChunkedBodySink::seekoff(std::streamoff off, std::ios_base::seekdir dir, std::ios_base::openmode which)
+{
+    if (which == std::ios_base::out)
+    {
+        //the body can only be appended to, the put position is always the end.
+        return (dir == std::ios_base::cur || dir == std::ios_base::end) && off == 0 ? std::streampos(m_size) : std::streampos(std::streamoff(-1));
+    }
+
+    if (dir == std::ios_base::beg)
+    {
+        return seekpos(off, which);
+    }
+    else if (dir == std::ios_base::end)
+    {
+        return seekpos(static_cast<std::streamoff>(m_size) + off, which);
+    }
+    else if (dir == std::ios_base::cur)
+    {
+        return seekpos(static_cast<std::streamoff>(GetReadPosition()) + off, which);
+    }
+
+    return std::streamoff(-1);
+}
+
+std::streampos ChunkedBodySink::seekpos(std::streampos pos, std::ios_base::openmode which)
+{
+    if (pos < 0 || static_cast<size_t>(pos) > m_size || (which & std::ios_base::out && static_cast<size_t>(pos) != m_size))
+    {
+        return std::streamoff(-1);
+    }
+
+    if (which & std::ios_base::in)
+    {
+        SetReadPosition(static_cast<size_t>(pos));
+    }
+
+    return pos;
+}
+
+int ChunkedBodySink::overflow(int c)
+{
+    auto endOfFile = std::char_traits<char>::eof();
+    if (c == endOfFile)
+    {
+        return endOfFile;
+    }
+
+    char value = std::char_traits<char>::to_char_type(c);
+    return xsputn(&value, 1) == 1 ? c : endOfFile;
+}
+
+int ChunkedBodySink::underflow()
+{
+    SetReadPosition(GetReadPosition());
+    if (gptr() == nullptr || gptr() >= egptr())
+    {
+        return std::char_traits<char>::eof();
+    }
+
+    return std::char_traits<char>::to_int_type(*gptr());
+}
+
+std::streamsize ChunkedBodySink::xsputn(const char* s, std::streamsize n)
+{
+    size_t readPosition = GetReadPosition();
+    size_t chunkSize = m_pool->GetChunkSize();
+    size_t written = 0;
+    size_t length = static_cast<size_t>(n);
+    while (written < length)
+    {
+        size_t offsetInChunk = m_size % chunkSize;
+        if (offsetInChunk == 0 && m_size / chunkSize == m_chunks.size())
+        {
+            char* chunk = m_pool->Acquire();
+            if (chunk == nullptr)
+            {
+                break;
+            }
+            m_chunks.push_back(chunk);
+        }
+
+        size_t copySize = (std::min)(length - written, chunkSize - offsetInChunk);
+        std::memcpy(m_chunks[m_size / chunkSize] + offsetInChunk, s + written, copySize);
+        written += copySize;
+        m_size += copySize;
+    }
+
+    //the readable part of the current chunk may have grown.
+    SetReadPosition(readPosition);
+    return static_cast<std::streamsize>(written);
+}
+
+size_t ChunkedBodySink::GetReadPosition() const
+{
+    if (gptr() == nullptr)
+    {
+        return m_readChunk * m_pool->GetChunkSize();
+    }
+
+    return m_readChunk * m_pool->GetChunkSize() + static_cast<size_t>(gptr() - eback());
+}
+
+void ChunkedBodySink::SetReadPosition(size_t position)
+{
+    size_t chunkSize = m_pool->GetChunkSize();
+    m_readChunk = position / chunkSize;
+    if (m_readChunk >= m_chunks.size())
+    {
+        setg(nullptr, nullptr, nullptr);
+        return;
+    }
+
+    //once a chunk is read to its end, move on to the next one.
+    size_t chunkStart = m_readChunk * chunkSize;
+    size_t chunkLength = (std::min)(chunkSize, m_size - chunkStart);
+    char* chunk = m_chunks[m_readChunk];
+    setg(chunk, chunk + (position - chunkStart), chunk + chunkLength);
+}
+
+}
+}
+}
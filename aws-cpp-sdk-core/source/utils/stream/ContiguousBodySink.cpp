@@ -0,0 +1,238 @@
+
+/*
+* Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+*
+* Licensed under the Apache License, Version 2.0 (the "License").
+* You may not use this file except in compliance with the License.
+* A copy of the License is located at
+*
+*  http://aws.amazon.com/apache2.0
+*
+* or in the "license" file accompanying this file. This file is distributed
+* on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+* express or implied. See the License for the specific language governing
+* permissions and limitations under the License.
+*/
+
+#include <aws/core/utils/stream/ContiguousBodySink.h>
+#include <aws/core/utils/memory/AWSMemory.h>
+
+#include <algorithm>
+#include <cstring>
+
+namespace Aws
+{
+namespace Utils
+{
+namespace Stream
+{
+
+static const size_t MIN_GROWTH_SIZE = 1024;
+static const char* CONTIGUOUS_BODY_SINK_ALLOCATION_TAG = "ContiguousBodySink";
+
+ContiguousBodySink::ContiguousBodySink() :
+    m_buffer(nullptr),
+    m_capacity(0),
+    m_size(0),
+    m_ownsBuffer(true)
+{
+    setp(nullptr, nullptr);
+    setg(nullptr, nullptr, nullptr);
+}
+
+ContiguousBodySink::ContiguousBodySink(char* buffer, size_t capacity) :
+    m_buffer(buffer),
+    m_capacity(capacity),
+    m_size(0),
+    m_ownsBuffer(false)
+{
+    setp(m_buffer, m_buffer + m_capacity);
+    setg(m_buffer, m_buffer, m_buffer);
+}
+
+ContiguousBodySink::~ContiguousBodySink()
+{
+    if (m_ownsBuffer && m_buffer)
+    {
+        Aws::Free(m_buffer);
+    }
+
+    m_buffer = nullptr;
+    m_capacity = 0;
+}
+
+void ContiguousBodySink::Reserve(size_t expectedSize)
+{
+    UpdateSize();
+    EnsureCapacity(m_size + expectedSize);
+}
+
+size_t ContiguousBodySink::Append(const char* data, size_t length)
+{
+    UpdateSize();
+    if (pptr() != m_buffer + m_size)
+    {
+        setp(m_buffer + m_size, m_buffer + m_capacity);
+    }
+
+    return static_cast<size_t>(xsputn(data, static_cast<std::streamsize>(length)));
+}
+
+size_t ContiguousBodySink::GetSize() const
+{
+    UpdateSize();
+    return m_size;
+}
+
+bool ContiguousBodySink::GetContiguousData(const char*& data) const
+{
+    data = m_buffer;
+    return true;
+}
+
+std::streampos ContiguousBodySink::seekoff(std::streamoff off, std::ios_base::seekdir dir, std::ios_base::openmode which)
+{
+    UpdateSize();
+    if (dir == std::ios_base::beg)
+    {
+        return seekpos(off, which);
+    }
+    else if (dir == std::ios_base::end)
+    {
+        return seekpos(static_cast<std::streamoff>(m_size) + off, which);
+    }
+    else if (dir == std::ios_base::cur)
+    {
+        if (which == std::ios_base::in)
+        {
+            return seekpos((gptr() - m_buffer) + off, which);
+        }
+        else if (which == std::ios_base::out)
+        {
+            return seekpos((pptr() - m_buffer) + off, which);
+        }
+    }
+
+    return std::streamoff(-1);
+}
+
+std::streampos ContiguousBodySink::seekpos(std::streampos pos, std::ios_base::openmode which)
+{
+    UpdateSize();
+    if (pos < 0 || static_cast<size_t>(pos) > m_size)
+    {
+        return std::streamoff(-1);
+    }
+
+    if (which & std::ios_base::in)
+    {
+        setg(m_buffer, m_buffer + static_cast<size_t>(pos), m_buffer + m_size);
+    }
+
+    if (which & std::ios_base::out)
+    {
+        setp(m_buffer + static_cast<size_t>(pos), m_buffer + m_capacity);
+    }
+
+    return pos;
+}
+
+int ContiguousBodySink::overflow(int c)
+{
+    auto endOfFile = std::char_traits<char>::eof();
+    if (c == endOfFile)
+    {
+        return endOfFile;
+    }
+
+    char value = std::char_traits<char>::to_char_type(c);
+    return xsputn(&value, 1) == 1 ? c : endOfFile;
+}
+
+int ContiguousBodySink::underflow()
+{
+    UpdateSize();
+    char* readPosition = gptr() ? gptr() : m_buffer;
+    setg(m_buffer, readPosition, m_buffer + m_size);
+
+    if (readPosition == nullptr || readPosition >= egptr())
+    {
+        return std::char_traits<char>::eof();
+    }
+
+    return std::char_traits<char>::to_int_type(*readPosition);
+}
+
+std::streamsize ContiguousBodySink::xsputn(const char* s, std::streamsize n)
+{
+    size_t writePosition = static_cast<size_t>(pptr() - m_buffer);
+    size_t writeCount = static_cast<size_t>(n);
+    if (!EnsureCapacity(writePosition + writeCount))
+    {
+        writeCount = m_capacity - writePosition;
+    }
+
+    if (writeCount > 0)
+    {
+        std::memcpy(m_buffer + writePosition, s, writeCount);
+        //setp rather than pbump, which only takes an int.
+        setp(m_buffer + writePosition + writeCount, m_buffer + m_capacity);
+        UpdateSize();
+        setg(m_buffer, gptr() ? gptr() : m_buffer, m_buffer + m_size);
+    }
+
+    return static_cast<std::streamsize>(writeCount);
+}
+
+bool ContiguousBodySink::EnsureCapacity(size_t capacity)
+{
+    if (capacity <= m_capacity)
+    {
+        return true;
+    }
+
+    if (!m_ownsBuffer)
+    {
+        return false;
+    }
+
+    size_t newCapacity = (std::max)(capacity, (std::max)(m_capacity * 2, MIN_GROWTH_SIZE));
+    //Malloc rather than NewArray, a body too large for memory is a short write that fails the transfer, not an exception thrown out of
+    //the http client's write callback.
+    char* newBuffer = static_cast<char*>(Aws::Malloc(CONTIGUOUS_BODY_SINK_ALLOCATION_TAG, newCapacity));
+    if (newBuffer == nullptr)
+    {
+        return false;
+    }
+
+    UpdateSize();
+    size_t readPosition = static_cast<size_t>(gptr() - m_buffer);
+    size_t writePosition = static_cast<size_t>(pptr() - m_buffer);
+    if (m_buffer)
+    {
+        std::memcpy(newBuffer, m_buffer, m_size);
+        Aws::Free(m_buffer);
+    }
+
+    m_buffer = newBuffer;
+    m_capacity = newCapacity;
+    setp(m_buffer + writePosition, m_buffer + m_capacity);
+    setg(m_buffer, m_buffer + readPosition, m_buffer + m_size);
+
+    return true;
+}
+
+ResponseBodySink* DefaultResponseBodySinkFactoryMethod()
+{
+    return Aws::New<ContiguousBodySink>(CONTIGUOUS_BODY_SINK_ALLOCATION_TAG);
+}
+
+void ContiguousBodySink::UpdateSize() const
+{
+    //writes through the put area only move pptr, so the size is its high water mark.
+    m_size = (std::max)(m_size, static_cast<size_t>(pptr() - m_buffer));
+}
+
+}
+}
+}
@@ -0,0 +1,152 @@
+
+/*
+* Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+*
+* Licensed under the Apache License, Version 2.0 (the "License").
+* You may not use this file except in compliance with the License.
+* A copy of the License is located at
+*
+*  http://aws.amazon.com/apache2.0
+*
+* or in the "license" file accompanying this file. This file is distributed
+* on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+* express or implied. See the License for the specific language governing
+* permissions and limitations under the License.
+*/
+
+#include <aws/core/utils/stream/PayloadBufferStream.h>
+#include <aws/core/utils/memory/AWSMemory.h>
+#include <aws/core/utils/memory/stl/AWSVector.h>
+
+#include <mutex>
+
+using namespace Aws::Utils::Stream;
+
+static const char* PAYLOAD_BUFFER_POOL_TAG = "PayloadBufferPool";
+static const size_t MAX_POOLED_BUFFERS = 16;
+// buffers that grew past this are freed rather than pinned in the pool for the life of the process.
+static const size_t MAX_POOLED_CAPACITY = 1024 * 1024;
+
+static std::mutex s_poolMutex;
+static Aws::Vector<Aws::String*>* s_pool = nullptr;
+
+static Aws::String* AcquirePayloadBuffer()
+{
+    {
+        std::lock_guard<std::mutex> locker(s_poolMutex);
+        if (s_pool && !s_pool->empty())
+        {
+            Aws::String* buffer = s_pool->back();
+            s_pool->pop_back();
+            return buffer;
+        }
+    }
+
+    return Aws::New<Aws::String>(PAYLOAD_BUFFER_POOL_TAG);
+}
+
+static void ReleasePayloadBuffer(Aws::String* buffer)
+{
+    buffer->clear();
+    if (buffer->capacity() <= MAX_POOLED_CAPACITY)
+    {
+        std::lock_guard<std::mutex> locker(s_poolMutex);
+        if (!s_pool)
+        {
+            s_pool = Aws::New<Aws::Vector<Aws::String*>>(PAYLOAD_BUFFER_POOL_TAG);
+            s_pool->reserve(MAX_POOLED_BUFFERS);
+        }
+
+        if (s_pool->size() < MAX_POOLED_BUFFERS)
+        {
+            s_pool->push_back(buffer);
+            return;
+        }
+    }
+
+    Aws::Delete(buffer);
+}
+
+namespace Aws
+{
+namespace Utils
+{
+namespace Stream
+{
+    void CleanupPayloadBufferPool()
+    {
+        std::lock_guard<std::mutex> locker(s_poolMutex);
+        if (s_pool)
+        {
+            for (auto buffer : *s_pool)
+            {
+                Aws::Delete(buffer);
+            }
+            Aws::Delete(s_pool);
+            s_pool = nullptr;
+        }
+    }
+
+    PayloadBufferStreamBuf::PayloadBufferStreamBuf() :
+        m_buffer(AcquirePayloadBuffer())
+    {
+    }
+
+    PayloadBufferStreamBuf::~PayloadBufferStreamBuf()
+    {
+        ReleasePayloadBuffer(m_buffer);
+    }
+
+    int PayloadBufferStreamBuf::underflow()
+    {
+        size_t position = eback() ? static_cast<size_t>(gptr() - eback()) : 0;
+        if (position >= m_buffer->size())
+        {
+            return EOF;
+        }
+
+        char* data = &(*m_buffer)[0];
+        setg(data, data + position, data + m_buffer->size());
+        return static_cast<unsigned char>(*gptr());
+    }
+
+    std::streampos PayloadBufferStreamBuf::seekoff(std::streamoff off, std::ios_base::seekdir dir, std::ios_base::openmode which)
+    {
+        if (!(which & std::ios_base::in))
+        {
+            return std::streamoff(-1);
+        }
+
+        std::streamoff base = 0;
+        if (dir == std::ios_base::cur)
+        {
+            base = eback() ? static_cast<std::streamoff>(gptr() - eback()) : 0;
+        }
+        else if (dir == std::ios_base::end)
+        {
+            base = static_cast<std::streamoff>(m_buffer->size());
+        }
+
+        std::streamoff position = base + off;
+        if (position < 0 || position > static_cast<std::streamoff>(m_buffer->size()))
+        {
+            return std::streamoff(-1);
+        }
+
+        char* data = &(*m_buffer)[0];
+        setg(data, data + position, data + m_buffer->size());
+        return position;
+    }
+
+    std::streampos PayloadBufferStreamBuf::seekpos(std::streampos pos, std::ios_base::openmode which)
+    {
+        return seekoff(std::streamoff(pos), std::ios_base::beg, which);
+    }
+
+    PayloadBufferStream::PayloadBufferStream() :
+        Aws::IOStream(&m_streamBuf)
+    {
+    }
+}
+}
+}
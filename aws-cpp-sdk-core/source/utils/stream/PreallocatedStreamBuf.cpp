@@ -24,13 +24,19 @@ namespace Aws
         namespace Stream
         {
             PreallocatedStreamBuf::PreallocatedStreamBuf(Aws::Utils::Array<uint8_t>* buffer, std::size_t lengthToRead) :
-                m_underlyingBuffer(buffer), m_lengthToRead(lengthToRead)
+                m_underlyingBuffer(buffer), m_begin(reinterpret_cast<char*>(buffer->GetUnderlyingData())), m_lengthToRead(lengthToRead)
             {
                 assert(m_lengthToRead <= m_underlyingBuffer->GetLength());
-                char* end = reinterpret_cast<char*>(m_underlyingBuffer->GetUnderlyingData() + m_lengthToRead);
-                char* begin = reinterpret_cast<char*>(m_underlyingBuffer->GetUnderlyingData());
-                setp(begin, end);
-                setg(begin, begin, end);
+                char* end = m_begin + m_lengthToRead;
+                setp(m_begin, end);
+                setg(m_begin, m_begin, end);
+            }
+
+            PreallocatedStreamBuf::PreallocatedStreamBuf(const uint8_t* data, std::size_t length) :
+                // the get area needs a non const pointer, there is no put area so the data is never written
+                m_underlyingBuffer(nullptr), m_begin(reinterpret_cast<char*>(const_cast<uint8_t*>(data))), m_lengthToRead(length)
+            {
+                setg(m_begin, m_begin, m_begin + m_lengthToRead);
             }
 
             PreallocatedStreamBuf::pos_type PreallocatedStreamBuf::seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which)
@@ -47,11 +53,11 @@ namespace Aws
                 {
                     if(which == std::ios_base::in)
                     { 
-                        return seekpos((gptr() - (char*)m_underlyingBuffer->GetUnderlyingData()) + off, which);
+                        return seekpos((gptr() - m_begin) + off, which);
                     }
                     else
                     {
-                        return seekpos((pptr() - (char*)m_underlyingBuffer->GetUnderlyingData()) + off, which);
+                        return seekpos((pptr() - m_begin) + off, which);
                     }
                 }
 
@@ -66,17 +72,16 @@ namespace Aws
                     return pos_type(off_type(-1));
                 }
 
-                char* end = reinterpret_cast<char*>(m_underlyingBuffer->GetUnderlyingData() + m_lengthToRead);
-                char* begin = reinterpret_cast<char*>(m_underlyingBuffer->GetUnderlyingData());
+                char* end = m_begin + m_lengthToRead;
 
                 if (which == std::ios_base::in)
                 {
-                    setg(begin, begin + static_cast<size_t>(pos), end);                    
+                    setg(m_begin, m_begin + static_cast<size_t>(pos), end);
                 }
 
-                if (which == std::ios_base::out)
+                if (which == std::ios_base::out && m_underlyingBuffer)
                 {
-                    setp(begin + static_cast<size_t>(pos), end);
+                    setp(m_begin + static_cast<size_t>(pos), end);
                 }
 
                 return pos;
@@ -0,0 +1,34 @@
+
+/*
+* Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+*
+* Licensed under the Apache License, Version 2.0 (the "License").
+* You may not use this file except in compliance with the License.
+* A copy of the License is located at
+*
+*  http://aws.amazon.com/apache2.0
+*
+* or in the "license" file accompanying this file. This file is distributed
+* on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+* express or implied. See the License for the specific language governing
+* permissions and limitations under the License.
+*/
+
+#include <aws/core/utils/stream/ResponseBodySink.h>
+#include <aws/core/utils/memory/AWSMemory.h>
+
+using namespace Aws::Utils::Stream;
+
+ResponseBodySinkStream::ResponseBodySinkStream(ResponseBodySink* sink) :
+    Base(sink),
+    m_sink(sink)
+{
+}
+
+ResponseBodySinkStream::~ResponseBodySinkStream()
+{
+    if (m_sink)
+    {
+        Aws::Delete(m_sink);
+    }
+}
@@ -15,10 +15,13 @@
 
 #include <aws/core/utils/threading/Executor.h>
 #include <aws/core/utils/threading/ThreadTask.h>
+#include <aws/core/platform/Thread.h>
 #include <thread>
 #include <cassert>
 
 static const char* POOLED_CLASS_TAG = "PooledThreadExecutor";
+static const char* WORK_STEALING_CLASS_TAG = "WorkStealingThreadExecutor";
+static const size_t INITIAL_DEQUE_CAPACITY = 64;
 
 using namespace Aws::Utils::Threading;
 
@@ -161,3 +164,191 @@ bool PooledThreadExecutor::HasTasks()
     std::lock_guard<std::mutex> locker(m_queueLock);
     return m_tasks.size() > 0;
 }
+
+/**
+ * A worker thread and its task deque. The deque is a growable ring of std::function slots, tasks are moved in and out of the slots
+ * so a slot's storage is reused from one task to the next. The owner pops from the back, thieves take from the front.
+ */
+class WorkStealingThreadExecutor::Worker
+{
+public:
+    Worker() : m_slots(INITIAL_DEQUE_CAPACITY), m_head(0), m_count(0) {}
+
+    void PushBack(std::function<void()>&& task)
+    {
+        if (m_count == m_slots.size())
+        {
+            Grow();
+        }
+        m_slots[(m_head + m_count) & (m_slots.size() - 1)] = std::move(task);
+        ++m_count;
+    }
+
+    bool PopBack(std::function<void()>& task)
+    {
+        if (m_count == 0)
+        {
+            return false;
+        }
+        --m_count;
+        task = std::move(m_slots[(m_head + m_count) & (m_slots.size() - 1)]);
+        return true;
+    }
+
+    bool PopFront(std::function<void()>& task)
+    {
+        if (m_count == 0)
+        {
+            return false;
+        }
+        task = std::move(m_slots[m_head]);
+        m_head = (m_head + 1) & (m_slots.size() - 1);
+        --m_count;
+        return true;
+    }
+
+    std::mutex m_lock;
+    std::thread m_thread;
+
+private:
+    void Grow()
+    {
+        Aws::Vector<std::function<void()>> slots(m_slots.size() * 2);
+        for (size_t i = 0; i < m_count; ++i)
+        {
+            slots[i] = std::move(m_slots[(m_head + i) & (m_slots.size() - 1)]);
+        }
+        m_slots.swap(slots);
+        m_head = 0;
+    }
+
+    Aws::Vector<std::function<void()>> m_slots;
+    size_t m_head;
+    size_t m_count;
+};
+
+WorkStealingThreadExecutor::WorkStealingThreadExecutor(size_t poolSize, OverflowPolicy overflowPolicy, bool pinThreadsToCores) :
+    m_idleWorkers(0), m_pendingTasks(0), m_nextWorker(0), m_continue(true), m_poolSize(poolSize > 0 ? poolSize : 1),
+    m_overflowPolicy(overflowPolicy), m_pinThreadsToCores(pinThreadsToCores)
+{
+    // every deque has to exist before the first worker starts looking for work to steal.
+    for (size_t index = 0; index < m_poolSize; ++index)
+    {
+        m_workers.push_back(Aws::New<Worker>(WORK_STEALING_CLASS_TAG));
+    }
+
+    for (size_t index = 0; index < m_poolSize; ++index)
+    {
+        m_workers[index]->m_thread = std::thread(&WorkStealingThreadExecutor::WorkerLoop, this, index);
+    }
+}
+
+WorkStealingThreadExecutor::~WorkStealingThreadExecutor()
+{
+    m_continue = false;
+    {
+        std::lock_guard<std::mutex> locker(m_idleLock);
+        m_idleSignal.notify_all();
+    }
+
+    for (auto worker : m_workers)
+    {
+        worker->m_thread.join();
+    }
+
+    for (auto worker : m_workers)
+    {
+        Aws::Delete(worker);
+    }
+}
+
+bool WorkStealingThreadExecutor::SubmitToThread(std::function<void()>&& fn)
+{
+    // counted before the task is visible, so an idle worker never sleeps while a task it could run is queued.
+    size_t pending = m_pendingTasks.fetch_add(1);
+    if (m_overflowPolicy == OverflowPolicy::REJECT_IMMEDIATELY && pending >= m_poolSize)
+    {
+        m_pendingTasks.fetch_sub(1);
+        return false;
+    }
+
+    Worker* worker = m_workers[GetSubmittingWorker()];
+    {
+        std::lock_guard<std::mutex> locker(worker->m_lock);
+        worker->PushBack(std::move(fn));
+    }
+
+    if (m_idleWorkers.load() > 0)
+    {
+        std::lock_guard<std::mutex> locker(m_idleLock);
+        m_idleSignal.notify_one();
+    }
+
+    return true;
+}
+
+size_t WorkStealingThreadExecutor::GetSubmittingWorker()
+{
+    auto threadId = std::this_thread::get_id();
+    for (size_t index = 0; index < m_poolSize; ++index)
+    {
+        if (m_workers[index]->m_thread.get_id() == threadId)
+        {
+            return index;
+        }
+    }
+
+    return m_nextWorker.fetch_add(1) % m_poolSize;
+}
+
+bool WorkStealingThreadExecutor::PopTask(size_t index, std::function<void()>& task)
+{
+    {
+        Worker* own = m_workers[index];
+        std::lock_guard<std::mutex> locker(own->m_lock);
+        if (own->PopBack(task))
+        {
+            m_pendingTasks.fetch_sub(1);
+            return true;
+        }
+    }
+
+    // a busy victim is skipped rather than waited on, the pending count brings this worker back around if it missed a task.
+    for (size_t offset = 1; offset < m_poolSize; ++offset)
+    {
+        Worker* victim = m_workers[(index + offset) % m_poolSize];
+        std::unique_lock<std::mutex> locker(victim->m_lock, std::try_to_lock);
+        if (locker.owns_lock() && victim->PopFront(task))
+        {
+            m_pendingTasks.fetch_sub(1);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void WorkStealingThreadExecutor::WorkerLoop(size_t index)
+{
+    if (m_pinThreadsToCores)
+    {
+        unsigned cores = std::thread::hardware_concurrency();
+        Aws::Thread::PinCurrentThreadToCore(cores > 0 ? index % cores : index);
+    }
+
+    std::function<void()> task;
+    while (m_continue)
+    {
+        if (PopTask(index, task))
+        {
+            task();
+            task = nullptr;
+            continue;
+        }
+
+        std::unique_lock<std::mutex> locker(m_idleLock);
+        ++m_idleWorkers;
+        m_idleSignal.wait(locker, [this] { return !m_continue || m_pendingTasks.load() > 0; });
+        --m_idleWorkers;
+    }
+}
@@ -0,0 +1,616 @@
+
+/*
+* Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+*
+* Licensed under the Apache License, Version 2.0 (the "License").
+* You may not use this file except in compliance with the License.
+* A copy of the License is located at
+*
+*  http://aws.amazon.com/apache2.0
+*
+* or in the "license" file accompanying this file. This file is distributed
+* on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+* express or implied. See the License for the specific language governing
+* permissions and limitations under the License.
+*/
+
+#include <aws/core/utils/xml/XmlReader.h>
+#include <aws/core/utils/DateTime.h>
+#include <aws/core/utils/HashingUtils.h>
+#include <aws/core/utils/StringUtils.h>
+
+#include <cstdlib>
+#include <cstring>
+
+using namespace Aws::Utils;
+using namespace Aws::Utils::Xml;
+
+static const int END_OF_INPUT = -1;
+static const size_t MAX_ENTITY_LENGTH = 10;
+
+static bool IsWhitespace(int c)
+{
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+static bool IsNameChar(int c)
+{
+    return c != END_OF_INPUT && !IsWhitespace(c) && c != '/' && c != '>' && c != '=';
+}
+
+static void AppendUtf8(Aws::String& value, unsigned long codePoint)
+{
+    if (codePoint < 0x80)
+    {
+        value.push_back(static_cast<char>(codePoint));
+    }
+    else if (codePoint < 0x800)
+    {
+        value.push_back(static_cast<char>(0xC0 | (codePoint >> 6)));
+        value.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+    }
+    else if (codePoint < 0x10000)
+    {
+        value.push_back(static_cast<char>(0xE0 | (codePoint >> 12)));
+        value.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+        value.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+    }
+    else
+    {
+        value.push_back(static_cast<char>(0xF0 | (codePoint >> 18)));
+        value.push_back(static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F)));
+        value.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+        value.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+    }
+}
+
+static void TrimInPlace(Aws::String& value)
+{
+    size_t end = value.size();
+    while (end > 0 && IsWhitespace(static_cast<unsigned char>(value[end - 1])))
+    {
+        --end;
+    }
+    size_t begin = 0;
+    while (begin < end && IsWhitespace(static_cast<unsigned char>(value[begin])))
+    {
+        ++begin;
+    }
+    value.erase(end);
+    value.erase(0, begin);
+}
+
+XmlReader::XmlReader(const char* data, size_t length) :
+    m_current(data),
+    m_end(data + length),
+    m_stream(nullptr),
+    m_offset(0),
+    m_depth(0),
+    m_emptyElement(false),
+    m_hasError(false)
+{
+}
+
+XmlReader::XmlReader(Aws::IStream& stream) :
+    m_current(m_chunk),
+    m_end(m_chunk),
+    m_stream(&stream),
+    m_offset(0),
+    m_depth(0),
+    m_emptyElement(false),
+    m_hasError(false)
+{
+}
+
+bool XmlReader::Refill()
+{
+    if (!m_stream || !m_stream->rdbuf())
+    {
+        return false;
+    }
+
+    std::streamsize read = m_stream->rdbuf()->sgetn(m_chunk, CHUNK_SIZE);
+    m_current = m_chunk;
+    m_end = m_chunk + (read > 0 ? read : 0);
+    return m_current != m_end;
+}
+
+int XmlReader::PeekChar()
+{
+    if (m_current == m_end && !Refill())
+    {
+        return END_OF_INPUT;
+    }
+    return static_cast<unsigned char>(*m_current);
+}
+
+int XmlReader::GetChar()
+{
+    int c = PeekChar();
+    if (c != END_OF_INPUT)
+    {
+        ++m_current;
+        ++m_offset;
+    }
+    return c;
+}
+
+bool XmlReader::SetError(const char* what)
+{
+    if (!m_hasError)
+    {
+        m_hasError = true;
+        m_errorMessage = "Expected ";
+        m_errorMessage.append(what);
+        m_errorMessage.append(" at offset ");
+        m_errorMessage.append(StringUtils::to_string(m_offset));
+    }
+    return false;
+}
+
+bool XmlReader::SkipPast(const char* terminator)
+{
+    size_t length = std::strlen(terminator);
+    char window[4] = {};
+    size_t seen = 0;
+    for (;;)
+    {
+        int c = GetChar();
+        if (c == END_OF_INPUT)
+        {
+            return SetError(terminator);
+        }
+
+        // slide a window over the last few characters so overlapping prefixes such as "--->" still match.
+        std::memmove(window, window + 1, length - 1);
+        window[length - 1] = static_cast<char>(c);
+        if (++seen >= length && std::memcmp(window, terminator, length) == 0)
+        {
+            return true;
+        }
+    }
+}
+
+bool XmlReader::SkipMarkup()
+{
+    // positioned just after '<', at a '?' or '!'.
+    if (GetChar() == '?')
+    {
+        return SkipPast("?>");
+    }
+
+    int c = PeekChar();
+    if (c == '-')
+    {
+        return SkipPast("-->");
+    }
+    if (c == '[')
+    {
+        return SkipPast("]]>");
+    }
+    return SkipPast(">");
+}
+
+bool XmlReader::ReadName(Aws::String& name)
+{
+    name.clear();
+    while (IsNameChar(PeekChar()))
+    {
+        name.push_back(static_cast<char>(GetChar()));
+    }
+    return !name.empty() || SetError("name");
+}
+
+bool XmlReader::ReadStartTag(Aws::String& name)
+{
+    if (!ReadName(name))
+    {
+        return false;
+    }
+
+    bool selfClosing = false;
+    for (;;)
+    {
+        int c = GetChar();
+        if (c == '>')
+        {
+            break;
+        }
+        if (c == END_OF_INPUT)
+        {
+            return SetError("'>'");
+        }
+        if (c == '"' || c == '\'')
+        {
+            int quote = c;
+            do
+            {
+                c = GetChar();
+            } while (c != quote && c != END_OF_INPUT);
+            if (c == END_OF_INPUT)
+            {
+                return SetError("closing quote");
+            }
+        }
+        else if (c == '/')
+        {
+            if (GetChar() != '>')
+            {
+                return SetError("'>'");
+            }
+            selfClosing = true;
+            break;
+        }
+    }
+
+    if (m_openElements.size() <= m_depth)
+    {
+        m_openElements.push_back(name);
+    }
+    else
+    {
+        m_openElements[m_depth].assign(name);
+    }
+    ++m_depth;
+    m_emptyElement = selfClosing;
+    return true;
+}
+
+bool XmlReader::ReadEndTag()
+{
+    // positioned just after "</".
+    if (!ReadName(m_endTagName))
+    {
+        return false;
+    }
+    while (IsWhitespace(PeekChar()))
+    {
+        GetChar();
+    }
+    if (GetChar() != '>')
+    {
+        return SetError("'>'");
+    }
+    if (m_depth == 0 || m_openElements[m_depth - 1] != m_endTagName)
+    {
+        return SetError("matching end tag");
+    }
+    --m_depth;
+    return true;
+}
+
+void XmlReader::LeaveElement()
+{
+    m_emptyElement = false;
+    --m_depth;
+}
+
+bool XmlReader::ReadEntity(Aws::String& text)
+{
+    // positioned just after '&'.
+    char entity[MAX_ENTITY_LENGTH + 1];
+    size_t length = 0;
+    for (;;)
+    {
+        int c = GetChar();
+        if (c == ';')
+        {
+            break;
+        }
+        if (c == END_OF_INPUT || length == MAX_ENTITY_LENGTH)
+        {
+            return SetError("entity");
+        }
+        entity[length++] = static_cast<char>(c);
+    }
+    entity[length] = '\0';
+
+    if (std::strcmp(entity, "lt") == 0)
+    {
+        text.push_back('<');
+    }
+    else if (std::strcmp(entity, "gt") == 0)
+    {
+        text.push_back('>');
+    }
+    else if (std::strcmp(entity, "amp") == 0)
+    {
+        text.push_back('&');
+    }
+    else if (std::strcmp(entity, "quot") == 0)
+    {
+        text.push_back('"');
+    }
+    else if (std::strcmp(entity, "apos") == 0)
+    {
+        text.push_back('\'');
+    }
+    else if (length > 1 && entity[0] == '#')
+    {
+        bool hex = entity[1] == 'x' || entity[1] == 'X';
+        const char* digits = entity + (hex ? 2 : 1);
+        char* end = nullptr;
+        unsigned long codePoint = std::strtoul(digits, &end, hex ? 16 : 10);
+        if (end == digits || *end != '\0' || codePoint == 0 || codePoint > 0x10FFFF)
+        {
+            return SetError("character reference");
+        }
+        AppendUtf8(text, codePoint);
+    }
+    else
+    {
+        return SetError("entity");
+    }
+    return true;
+}
+
+bool XmlReader::NextChild(Aws::String& name)
+{
+    if (m_hasError)
+    {
+        return false;
+    }
+
+    if (m_emptyElement)
+    {
+        LeaveElement();
+        return false;
+    }
+
+    for (;;)
+    {
+        // text between elements is of no interest here, scan straight to the next tag.
+        for (;;)
+        {
+            if (m_current == m_end && !Refill())
+            {
+                return m_depth == 0 ? false : SetError("end tag");
+            }
+            const char* tag = static_cast<const char*>(std::memchr(m_current, '<', static_cast<size_t>(m_end - m_current)));
+            const char* stop = tag ? tag : m_end;
+            m_offset += static_cast<size_t>(stop - m_current);
+            m_current = stop;
+            if (tag)
+            {
+                break;
+            }
+        }
+
+        GetChar();
+        int c = PeekChar();
+        if (c == '/')
+        {
+            GetChar();
+            ReadEndTag();
+            return false;
+        }
+        if (c == '?' || c == '!')
+        {
+            if (!SkipMarkup())
+            {
+                return false;
+            }
+            continue;
+        }
+        return ReadStartTag(name);
+    }
+}
+
+bool XmlReader::ReadText(Aws::String& text)
+{
+    text.clear();
+    if (m_hasError)
+    {
+        return false;
+    }
+
+    if (m_emptyElement)
+    {
+        LeaveElement();
+        return true;
+    }
+
+    if (m_depth == 0)
+    {
+        return SetError("element");
+    }
+
+    for (;;)
+    {
+        if (m_current == m_end && !Refill())
+        {
+            return SetError("end tag");
+        }
+
+        // copy the run up to the next tag or entity in one go rather than a character at a time.
+        const char* run = m_current;
+        while (run != m_end && *run != '<' && *run != '&')
+        {
+            ++run;
+        }
+        text.append(m_current, run);
+        m_offset += static_cast<size_t>(run - m_current);
+        m_current = run;
+        if (run == m_end)
+        {
+            continue;
+        }
+
+        if (GetChar() == '&')
+        {
+            if (!ReadEntity(text))
+            {
+                return false;
+            }
+            continue;
+        }
+
+        int c = PeekChar();
+        if (c == '/')
+        {
+            GetChar();
+            return ReadEndTag();
+        }
+
+        if (c == '!')
+        {
+            GetChar();
+            if (PeekChar() == '[')
+            {
+                const char* cdata = "[CDATA[";
+                for (const char* expected = cdata; *expected; ++expected)
+                {
+                    if (GetChar() != *expected)
+                    {
+                        return SetError("CDATA section");
+                    }
+                }
+
+                size_t start = text.size();
+                for (;;)
+                {
+                    int next = GetChar();
+                    if (next == END_OF_INPUT)
+                    {
+                        return SetError("]]>");
+                    }
+                    text.push_back(static_cast<char>(next));
+                    if (text.size() - start >= 3 && text.compare(text.size() - 3, 3, "]]>") == 0)
+                    {
+                        text.erase(text.size() - 3);
+                        break;
+                    }
+                }
+            }
+            else if (!SkipPast(PeekChar() == '-' ? "-->" : ">"))
+            {
+                return false;
+            }
+            continue;
+        }
+
+        if (c == '?')
+        {
+            if (!SkipMarkup())
+            {
+                return false;
+            }
+            continue;
+        }
+
+        // mixed content, the child element is skipped and only the text around it kept.
+        if (!ReadStartTag(m_endTagName) || !SkipElement())
+        {
+            return false;
+        }
+    }
+}
+
+bool XmlReader::SkipElement()
+{
+    if (m_hasError)
+    {
+        return false;
+    }
+
+    if (m_depth == 0)
+    {
+        return SetError("element");
+    }
+
+    size_t targetDepth = m_depth - 1;
+    Aws::String name;
+    while (m_depth > targetDepth)
+    {
+        if (!NextChild(name) && m_hasError)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+namespace Aws
+{
+    namespace Utils
+    {
+        namespace Xml
+        {
+            bool ReadXml(XmlReader& reader, Aws::String& value)
+            {
+                if (!reader.ReadText(value))
+                {
+                    return false;
+                }
+                TrimInPlace(value);
+                return true;
+            }
+
+            bool ReadXml(XmlReader& reader, int& value)
+            {
+                Aws::String text;
+                if (!ReadXml(reader, text))
+                {
+                    return false;
+                }
+                value = StringUtils::ConvertToInt32(text.c_str());
+                return true;
+            }
+
+            bool ReadXml(XmlReader& reader, long long& value)
+            {
+                Aws::String text;
+                if (!ReadXml(reader, text))
+                {
+                    return false;
+                }
+                value = StringUtils::ConvertToInt64(text.c_str());
+                return true;
+            }
+
+            bool ReadXml(XmlReader& reader, double& value)
+            {
+                Aws::String text;
+                if (!ReadXml(reader, text))
+                {
+                    return false;
+                }
+                value = StringUtils::ConvertToDouble(text.c_str());
+                return true;
+            }
+
+            bool ReadXml(XmlReader& reader, bool& value)
+            {
+                Aws::String text;
+                if (!ReadXml(reader, text))
+                {
+                    return false;
+                }
+                value = StringUtils::ConvertToBool(text.c_str());
+                return true;
+            }
+
+            bool ReadXml(XmlReader& reader, ByteBuffer& value)
+            {
+                Aws::String text;
+                if (!ReadXml(reader, text))
+                {
+                    return false;
+                }
+                value = HashingUtils::Base64Decode(text);
+                return true;
+            }
+
+            bool ReadXml(XmlReader& reader, DateTime& value)
+            {
+                Aws::String text;
+                if (!ReadXml(reader, text))
+                {
+                    return false;
+                }
+                value = DateTime(text.c_str(), DateFormat::ISO_8601);
+                return true;
+            }
+        } // namespace Xml
+    } // namespace Utils
+} // namespace Aws
@@ -218,6 +218,13 @@ XmlDocument XmlDocument::CreateFromXmlString(const Aws::String& xmlText)
     return xmlDocument;
 }
 
+XmlDocument XmlDocument::CreateFromXmlBuffer(const char* data, size_t length)
+{
+    XmlDocument xmlDocument;
+    xmlDocument.m_doc->Parse(data, length);
+    return xmlDocument;
+}
+
 XmlDocument XmlDocument::CreateWithRootNode(const Aws::String& rootNodeName)
 {
     XmlDocument xmlDocument;
@@ -20,6 +20,8 @@
 #include <aws/core/utils/DateTime.h>
 #include <aws/external/gtest.h>
 
+#include <thread>
+
 using namespace Aws::Auth;
 using namespace Aws::STS;
 using namespace Aws::Utils;
@@ -19,8 +19,6 @@
 #include <aws/core/auth/AWSCredentialsProvider.h>
 
 #include <memory>
-#include <mutex>
-#include <atomic>
 
 namespace Aws
 {
@@ -37,9 +35,10 @@ namespace Aws
         static const int DEFAULT_CREDS_LOAD_FREQ_SECONDS = 900;
 
         /**
-         * Credentials provider for STS Assume Role
+         * Credentials provider for STS Assume Role. Credentials are renewed a minute before they expire, see RefreshingAWSCredentialsProvider
+         * to renew them from a background thread instead.
          */
-        class AWS_IDENTITY_MANAGEMENT_API STSAssumeRoleCredentialsProvider : public AWSCredentialsProvider
+        class AWS_IDENTITY_MANAGEMENT_API STSAssumeRoleCredentialsProvider : public RefreshingAWSCredentialsProvider
         {
         public:
             /**
@@ -58,19 +57,17 @@ namespace Aws
                 const Aws::String& externalId = Aws::String(), int loadFrequency = DEFAULT_CREDS_LOAD_FREQ_SECONDS, 
                 const std::shared_ptr<Aws::STS::STSClient>& stsClient = nullptr);
 
-            AWSCredentials GetAWSCredentials() override;
+            ~STSAssumeRoleCredentialsProvider();
 
-        private:
-            void LoadCredentialsFromSTS();
+        protected:
+            bool FetchCredentials(AWSCredentials& credentials, Aws::Utils::DateTime& expiration) override;
 
+        private:
             std::shared_ptr<Aws::STS::STSClient> m_stsClient;
-            AWSCredentials m_cachedCredentials;
             Aws::String m_roleArn;
             Aws::String m_sessionName;
             Aws::String m_externalId;
-            std::atomic<int64_t> m_expiry;
-            std::mutex m_credsMutex;
-            std::atomic<int> m_loadFrequency;
+            int m_loadFrequency;
         };
     }
 }
\ No newline at end of file
@@ -32,9 +32,11 @@ namespace Aws
 
         STSAssumeRoleCredentialsProvider::STSAssumeRoleCredentialsProvider(const Aws::String& roleArn, const Aws::String& sessionName,
             const Aws::String& externalId, int loadFrequency, const std::shared_ptr<Aws::STS::STSClient>& stsClient) :
+            //failed loads are retried on the next call, as there may be no credentials to fall back on.
+            RefreshingAWSCredentialsProvider(loadFrequency * 1000L, 0, ACCOUNT_FOR_LATENCY * 1000L),
             m_stsClient(stsClient == nullptr ? Aws::MakeShared<Aws::STS::STSClient>(CLASS_TAG) : stsClient),
             m_roleArn(roleArn), m_sessionName(sessionName), m_externalId(externalId),
-            m_expiry(0), m_loadFrequency(loadFrequency)            
+            m_loadFrequency(loadFrequency)
         {
             if (sessionName.empty())
             {   
@@ -45,53 +47,37 @@ namespace Aws
             AWS_LOGSTREAM_INFO(CLASS_TAG, "Role ARN set to: " << m_roleArn << ". Session Name set to: " << m_sessionName);
         }
 
-        AWSCredentials STSAssumeRoleCredentialsProvider::GetAWSCredentials()
+        STSAssumeRoleCredentialsProvider::~STSAssumeRoleCredentialsProvider()
         {
-            LoadCredentialsFromSTS();
-            std::lock_guard<std::mutex> locker(m_credsMutex);
-            return m_cachedCredentials;
+            DisableBackgroundRefresh();
         }
 
-        void STSAssumeRoleCredentialsProvider::LoadCredentialsFromSTS()
+        bool STSAssumeRoleCredentialsProvider::FetchCredentials(AWSCredentials& credentials, DateTime& expiration)
         {
-            //standard check lock check
-            auto diffSeconds = static_cast<int>(DateTime::Now().SecondsWithMSPrecision() - DateTime(m_expiry.load()).SecondsWithMSPrecision());
-            if (diffSeconds > 0 - ACCOUNT_FOR_LATENCY)
+            AWS_LOGSTREAM_INFO(CLASS_TAG, "Credentials are due for refresh, assuming role " << m_roleArn);
+            Model::AssumeRoleRequest assumeRoleRequest;
+            assumeRoleRequest.WithRoleArn(m_roleArn)
+                .WithRoleSessionName(m_sessionName)
+                .WithDurationSeconds(m_loadFrequency);
+
+            if (!m_externalId.empty())
             {
-                AWS_LOGSTREAM_DEBUG(CLASS_TAG, "Credentials have expired with diff of " << diffSeconds << " since last credentials pull.");
-                AWS_LOGSTREAM_TRACE(CLASS_TAG, "Grabbing lock.");
-                std::lock_guard<std::mutex> locker(m_credsMutex);
-                AWS_LOGSTREAM_TRACE(CLASS_TAG, "Lock acquired. Checking expiration again.");
-                diffSeconds = static_cast<int>(DateTime::Now().SecondsWithMSPrecision() - DateTime(m_expiry.load()).SecondsWithMSPrecision());
-                if (diffSeconds > 0 - ACCOUNT_FOR_LATENCY)
-                {
-                    AWS_LOGSTREAM_INFO(CLASS_TAG, "Credentials have expired with diff of " << diffSeconds << " since last credentials pull.");
-                    Model::AssumeRoleRequest assumeRoleRequest;
-                    assumeRoleRequest.WithRoleArn(m_roleArn)
-                        .WithRoleSessionName(m_sessionName)
-                        .WithDurationSeconds(m_loadFrequency);
+                assumeRoleRequest.SetExternalId(m_externalId);
+            }
 
-                    if (!m_externalId.empty())
-                    {
-                        assumeRoleRequest.SetExternalId(m_externalId);
-                    }
+            auto assumeRoleOutcome = m_stsClient->AssumeRole(assumeRoleRequest);
+            if (!assumeRoleOutcome.IsSuccess())
+            {
+                AWS_LOGSTREAM_ERROR(CLASS_TAG, "Credentials refresh failed with error " << assumeRoleOutcome.GetError().GetExceptionName()
+                        << " message: " << assumeRoleOutcome.GetError().GetMessage());
+                return false;
+            }
 
-                    auto assumeRoleOutcome = m_stsClient->AssumeRole(assumeRoleRequest);
-                    if (assumeRoleOutcome.IsSuccess())
-                    {
-                        const auto& stsCredentials = assumeRoleOutcome.GetResult().GetCredentials();
-                        m_cachedCredentials = AWSCredentials(stsCredentials.GetAccessKeyId(), stsCredentials.GetSecretAccessKey(), stsCredentials.GetSessionToken());
-                        m_expiry = stsCredentials.GetExpiration().Millis();
-                        AWS_LOGSTREAM_DEBUG(CLASS_TAG, "Credentials refreshed with new expiry " << 
-                            DateTime(m_expiry.load()).ToGmtString(DateFormat::ISO_8601));
-                    }
-                    else
-                    {
-                        AWS_LOGSTREAM_ERROR(CLASS_TAG, "Credentials refresh failed with error " << assumeRoleOutcome.GetError().GetExceptionName()
-                                << " message: " << assumeRoleOutcome.GetError().GetMessage());
-                    }
-                }
-            }            
+            const auto& stsCredentials = assumeRoleOutcome.GetResult().GetCredentials();
+            credentials = AWSCredentials(stsCredentials.GetAccessKeyId(), stsCredentials.GetSecretAccessKey(), stsCredentials.GetSessionToken());
+            expiration = stsCredentials.GetExpiration();
+            AWS_LOGSTREAM_DEBUG(CLASS_TAG, "Credentials refreshed with new expiry " << expiration.ToGmtString(DateFormat::ISO_8601));
+            return true;
         }
     }
 }
\ No newline at end of file
@@ -156,6 +156,8 @@ void S3Client::init(const ClientConfiguration& config)
         m_baseUri = config.endpointOverride;
     }
     m_scheme = SchemeMapper::ToString(config.scheme);
+    //only s3 accepts aws-chunked payloads, so the payload signing chunk size is applied here rather than by every client.
+    static_cast<AWSAuthV4Signer*>(GetSignerByName(Aws::Auth::SIGV4_SIGNER))->SetPayloadSigningChunkSize(config.payloadSigningChunkSize);
 }
 
 AbortMultipartUploadOutcome S3Client::AbortMultipartUpload(const AbortMultipartUploadRequest& request) const
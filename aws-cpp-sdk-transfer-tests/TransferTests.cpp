@@ -22,7 +22,10 @@
 #include <aws/s3/model/ListMultipartUploadsRequest.h>
 #include <aws/s3/model/GetObjectRequest.h>
 #include <aws/s3/model/HeadObjectRequest.h>
+#include <aws/s3/model/PutObjectRequest.h>
 #include <aws/s3/model/DeleteObjectRequest.h>
+#include <aws/s3/model/UploadPartRequest.h>
+#include <aws/core/auth/AWSCredentialsProvider.h>
 #include <aws/core/client/ClientConfiguration.h>
 #include <aws/core/utils/ratelimiter/DefaultRateLimiter.h>
 #include <aws/s3/model/HeadBucketRequest.h>
@@ -36,11 +39,20 @@
 #include <aws/core/utils/UUID.h>
 #include <aws/core/platform/Platform.h>
 #include <aws/testing/TestingEnvironment.h>
+#include <aws/testing/mocks/http/MockHttpClient.h>
+#include <aws/core/http/standard/StandardHttpResponse.h>
 
 #include <aws/transfer/TransferManager.h>
+#include <aws/transfer/PartConcurrencyTuner.h>
+#include <aws/transfer/DirectoryTransferProgress.h>
+#include <aws/transfer/TransferJournal.h>
 #include <iostream>
 #include <fstream>
 #include <time.h>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <future>
 
 #include <aws/core/utils/logging/LogMacros.h>
 
@@ -70,6 +82,7 @@ static const char* CONTENT_FILE_KEY = "ContentFileKey";
 
 static const char* BIG_TEST_FILE_NAME = "BigTransferTestFile.txt";
 static const char* BIG_FILE_KEY = "BigFileKey";
+static const char* STREAMING_FILE_KEY = "StreamingFileKey";
 
 #ifdef _MSC_VER
 static const wchar_t* UNICODE_TEST_FILE_NAME = L"测试文件.txt";
@@ -79,6 +92,9 @@ static const char* UNICODE_FILE_KEY = "UnicodeFileKey";
 static const char* CANCEL_TEST_FILE_NAME = "CancelTestFile.txt";
 static const char* CANCEL_FILE_KEY = "CancelFileKey";
 
+static const char* RESUME_TEST_FILE_NAME = "ResumeTestFile.txt";
+static const char* RESUME_FILE_KEY = "ResumeFileKey";
+
 static const char* TEST_BUCKET_NAME_BASE = "transferintegrationtest";
 static const unsigned SMALL_TEST_SIZE = MB5 / 2;
 static const unsigned MEDIUM_TEST_SIZE = MB5 * 3 / 2;
@@ -677,7 +693,7 @@ TEST_F(TransferTests, TransferManager_DirectoryUploadAndDownloadTest)
     transferManagerConfig.transferInitiatedCallback = transferInitCallback;
     auto transferManager = TransferManager::Create(transferManagerConfig);
 
-    transferManager->UploadDirectory(uploadDir, GetTestBucketName(), "nestedTest", Aws::Map<Aws::String, Aws::String>());
+    auto uploadProgress = transferManager->UploadDirectory(uploadDir, GetTestBucketName(), "nestedTest", Aws::Map<Aws::String, Aws::String>());
 
     {
         std::unique_lock<std::mutex> locker(semaphoreLock);
@@ -712,9 +728,17 @@ TEST_F(TransferTests, TransferManager_DirectoryUploadAndDownloadTest)
             "binary/octet-stream",
             Aws::Map<Aws::String, Aws::String>());
     }  
+
+    uploadProgress->WaitUntilFinished();
+    ASSERT_TRUE(uploadProgress->IsFinished());
+    ASSERT_EQ(3u, uploadProgress->GetFilesDiscovered());
+    ASSERT_EQ(3u, uploadProgress->GetFilesCompleted());
+    ASSERT_EQ(0u, uploadProgress->GetFilesFailed());
+    ASSERT_EQ(0u, uploadProgress->GetFilesInFlight());
+    ASSERT_EQ(uploadProgress->GetBytesDiscovered(), uploadProgress->GetBytesTransferred());
     
     auto downloadDir = Aws::FileSystem::Join(GetTestFilesDirectory(), "dirDownload");
-    transferManager->DownloadToDirectory(downloadDir, GetTestBucketName(), "nestedTest");
+    auto downloadProgress = transferManager->DownloadToDirectory(downloadDir, GetTestBucketName(), "nestedTest");
 
     {
         std::unique_lock<std::mutex> locker(semaphoreLock);
@@ -734,6 +758,14 @@ TEST_F(TransferTests, TransferManager_DirectoryUploadAndDownloadTest)
         EXPECT_EQ(TransferStatus::COMPLETED, handle->GetStatus());
     }
 
+    downloadProgress->WaitUntilFinished();
+    ASSERT_TRUE(downloadProgress->IsFinished());
+    ASSERT_EQ(3u, downloadProgress->GetFilesDiscovered());
+    ASSERT_EQ(3u, downloadProgress->GetFilesCompleted());
+    ASSERT_EQ(0u, downloadProgress->GetFilesFailed());
+    ASSERT_EQ(0u, downloadProgress->GetFilesInFlight());
+    ASSERT_EQ(uploadProgress->GetBytesDiscovered(), downloadProgress->GetBytesDiscovered());
+
     Aws::FileSystem::DirectoryTree uploadTree(uploadDir);
     Aws::FileSystem::DirectoryTree downloadTree(downloadDir);
     ASSERT_EQ(uploadTree, downloadTree);
@@ -869,6 +901,121 @@ TEST_F(TransferTests, TransferManager_BigTest)
                        Aws::Map<Aws::String, Aws::String>());
 }
 
+TEST_F(TransferTests, TransferManager_StreamingDownloadTest)
+{
+    Aws::String bigTestFileName = MakeFilePath( BIG_TEST_FILE_NAME );
+    ScopedTestFile testFile(bigTestFileName, BIG_TEST_SIZE, testString);
+
+    if (EmptyBucket(GetTestBucketName()))
+    {
+        WaitForBucketToEmpty(GetTestBucketName());
+    }
+
+    TransferManagerConfiguration transferManagerConfig(m_executor.get());
+    transferManagerConfig.s3Client = m_s3Client;
+    transferManagerConfig.downloadReadAheadParts = 2;
+
+    auto transferManager = TransferManager::Create(transferManagerConfig);
+    std::shared_ptr<TransferHandle> uploadPtr = transferManager->UploadFile(bigTestFileName, GetTestBucketName(), STREAMING_FILE_KEY, "text/plain", Aws::Map<Aws::String, Aws::String>());
+    uploadPtr->WaitUntilFinished();
+    ASSERT_EQ(TransferStatus::COMPLETED, uploadPtr->GetStatus());
+
+    Aws::String downloadedContents;
+    std::atomic<unsigned> deliveries(0);
+    std::atomic<bool> concurrentDelivery(false);
+    std::atomic<bool> delivering(false);
+    auto consumer = [&](const unsigned char* data, std::size_t length)
+    {
+        if (delivering.exchange(true))
+        {
+            concurrentDelivery = true;
+        }
+        downloadedContents.append(reinterpret_cast<const char*>(data), length);
+        ++deliveries;
+        delivering = false;
+        return true;
+    };
+
+    std::shared_ptr<TransferHandle> requestPtr = transferManager->DownloadToConsumer(GetTestBucketName(), STREAMING_FILE_KEY, consumer);
+    requestPtr->WaitUntilFinished();
+
+    size_t retries = 0;
+    //just make sure we don't fail because a part failed. (e.g. network problems or interuptions)
+    while (requestPtr->GetStatus() == TransferStatus::FAILED && retries++ < 5)
+    {
+        transferManager->RetryDownload(requestPtr);
+        requestPtr->WaitUntilFinished();
+    }
+
+    ASSERT_EQ(TransferStatus::COMPLETED, requestPtr->GetStatus());
+    ASSERT_TRUE(requestPtr->IsStreamingDownload());
+    ASSERT_EQ(PARTS_IN_BIG_TEST, requestPtr->GetCompletedParts().size());
+    ASSERT_EQ(PARTS_IN_BIG_TEST, deliveries.load());
+    ASSERT_FALSE(concurrentDelivery.load());
+
+    Aws::IFStream fileStream(bigTestFileName.c_str(), std::ios_base::in | std::ios_base::binary);
+    Aws::StringStream fileContents;
+    fileContents << fileStream.rdbuf();
+    ASSERT_EQ(fileContents.str().size(), downloadedContents.size());
+    ASSERT_TRUE(fileContents.str() == downloadedContents);
+
+    HeadObjectRequest headObjectRequest;
+    headObjectRequest.WithBucket(GetTestBucketName())
+        .WithKey(STREAMING_FILE_KEY);
+    auto headObjectOutcome = m_s3Client->HeadObject(headObjectRequest);
+    ASSERT_TRUE(headObjectOutcome.IsSuccess());
+    ASSERT_EQ(headObjectOutcome.GetResult().GetETag(), requestPtr->GetObjectETag());
+}
+
+// The parts of a streaming download behind an overwrite of the object must fail rather than splice the new object onto the old one.
+TEST_F(TransferTests, TransferManager_StreamingDownloadOfChangedObjectTest)
+{
+    Aws::String bigTestFileName = MakeFilePath( BIG_TEST_FILE_NAME );
+    ScopedTestFile testFile(bigTestFileName, BIG_TEST_SIZE, testString);
+
+    if (EmptyBucket(GetTestBucketName()))
+    {
+        WaitForBucketToEmpty(GetTestBucketName());
+    }
+
+    TransferManagerConfiguration transferManagerConfig(m_executor.get());
+    transferManagerConfig.s3Client = m_s3Client;
+    transferManagerConfig.downloadReadAheadParts = 1;
+
+    auto transferManager = TransferManager::Create(transferManagerConfig);
+    std::shared_ptr<TransferHandle> uploadPtr = transferManager->UploadFile(bigTestFileName, GetTestBucketName(), STREAMING_FILE_KEY, "text/plain", Aws::Map<Aws::String, Aws::String>());
+    uploadPtr->WaitUntilFinished();
+    ASSERT_EQ(TransferStatus::COMPLETED, uploadPtr->GetStatus());
+
+    std::atomic<bool> overwritten(false);
+    auto consumer = [&](const unsigned char*, std::size_t)
+    {
+        if (!overwritten.exchange(true))
+        {
+            PutObjectRequest putObjectRequest;
+            putObjectRequest.WithBucket(GetTestBucketName())
+                .WithKey(STREAMING_FILE_KEY);
+            auto body = Aws::MakeShared<Aws::StringStream>(ALLOCATION_TAG);
+            *body << CONTENT_TEST_FILE_TEXT;
+            putObjectRequest.SetBody(body);
+            EXPECT_TRUE(m_s3Client->PutObject(putObjectRequest).IsSuccess());
+        }
+        return true;
+    };
+
+    std::shared_ptr<TransferHandle> requestPtr = transferManager->DownloadToConsumer(GetTestBucketName(), STREAMING_FILE_KEY, consumer);
+    requestPtr->WaitUntilFinished();
+    ASSERT_TRUE(overwritten.load());
+    ASSERT_EQ(TransferStatus::FAILED, requestPtr->GetStatus());
+    ASSERT_EQ(HttpResponseCode::PRECONDITION_FAILED, requestPtr->GetLastError().GetResponseCode());
+
+    // a retry stays pinned to the object the download started with
+    transferManager->RetryDownload(requestPtr);
+    requestPtr->WaitUntilFinished();
+    ASSERT_EQ(TransferStatus::FAILED, requestPtr->GetStatus());
+    ASSERT_EQ(HttpResponseCode::PRECONDITION_FAILED, requestPtr->GetLastError().GetResponseCode());
+}
+
 #ifdef _MSC_VER
 TEST_F(TransferTests, TransferManager_UnicodeFileNameTest)
 {
@@ -1158,6 +1305,113 @@ TEST_F(TransferTests, TransferManager_AbortAndRetryUploadTest)
                        Aws::Map<Aws::String, Aws::String>());
 }
 
+// The first transfer manager stands in for a process that stopped mid upload, the second one resumes the upload from its journal.
+TEST_F(TransferTests, TransferManager_ResumeUploadFromJournalTest)
+{
+    Aws::String resumeTestFileName = MakeFilePath( RESUME_TEST_FILE_NAME );
+    ScopedTestFile testFile(resumeTestFileName, CANCEL_TEST_SIZE, testString);
+    Aws::String journalDirectory = Aws::FileSystem::Join(GetTestFilesDirectory(), "journal");
+    ASSERT_TRUE(Aws::FileSystem::CreateDirectoryIfNotExists(journalDirectory.c_str()));
+
+    ListMultipartUploadsRequest listMultipartRequest;
+    listMultipartRequest.WithBucket(GetTestBucketName());
+
+    if (EmptyBucket(GetTestBucketName()))
+    {
+        WaitForBucketToEmpty(GetTestBucketName());
+    }
+
+    Aws::String multipartId;
+    {
+        TransferManagerConfiguration transferManagerConfig(m_executor.get());
+        transferManagerConfig.s3Client = m_s3Client;
+        transferManagerConfig.journalDirectory = journalDirectory;
+        transferManagerConfig.transferStatusUpdatedCallback =
+            [](const TransferManager*, const std::shared_ptr<const TransferHandle>& handle)
+            {
+                if (handle->GetCompletedParts().size() >= 3 && handle->GetStatus() != TransferStatus::CANCELED)
+                {
+                    std::const_pointer_cast<TransferHandle>(handle)->Cancel();
+                }
+            };
+        auto transferManager = TransferManager::Create(transferManagerConfig);
+
+        auto requestPtr = transferManager->UploadFile(resumeTestFileName, GetTestBucketName(), RESUME_FILE_KEY, "text/plain", Aws::Map<Aws::String, Aws::String>());
+        requestPtr->WaitUntilFinished();
+
+        //if this is the case, the request actually failed before we could cancel it and we need to try again.
+        while (requestPtr->GetCompletedParts().size() < 3u)
+        {
+            requestPtr = transferManager->RetryUpload(resumeTestFileName, requestPtr);
+            requestPtr->WaitUntilFinished();
+        }
+
+        ASSERT_EQ(TransferStatus::CANCELED, requestPtr->GetStatus());
+        multipartId = requestPtr->GetMultiPartId();
+    }
+
+    // the object's parts must not be reused if S3 holds a different ETag for them, or if the file changed since they were sent
+    {
+        TransferJournal journal(journalDirectory, TransferDirection::UPLOAD, GetTestBucketName(), RESUME_FILE_KEY, resumeTestFileName);
+        ASSERT_TRUE(journal.HasTransfer());
+        ASSERT_EQ(multipartId, journal.GetMultipartId());
+        ASSERT_LE(3u, journal.GetCompletedParts().size());
+
+        auto completedParts = journal.GetCompletedParts();
+        auto part = completedParts.begin();
+        part->second.eTag = "\"00000000000000000000000000000000\"";
+        ++part;
+        const TransferJournal::Part& changedPart = part->second;
+        ASSERT_TRUE(journal.Rewrite(journal.GetBytesTotalSize(), journal.GetPartSize(), multipartId, "", completedParts));
+
+#ifdef _MSC_VER
+        Aws::FStream file(Aws::Utils::StringUtils::ToWString(resumeTestFileName.c_str()).c_str(), std::ios_base::in | std::ios_base::out | std::ios_base::binary);
+#else
+        Aws::FStream file(resumeTestFileName.c_str(), std::ios_base::in | std::ios_base::out | std::ios_base::binary);
+#endif
+        ASSERT_TRUE(file.good());
+        file.seekp(static_cast<std::streamoff>(changedPart.rangeBegin));
+        file << "Changed since it was sent";
+        ASSERT_TRUE(file.good());
+    }
+
+    TransferManagerConfiguration transferManagerConfig(m_executor.get());
+    transferManagerConfig.s3Client = m_s3Client;
+    transferManagerConfig.journalDirectory = journalDirectory;
+    auto transferManager = TransferManager::Create(transferManagerConfig);
+
+    auto requestPtr = transferManager->UploadFile(resumeTestFileName, GetTestBucketName(), RESUME_FILE_KEY, "text/plain", Aws::Map<Aws::String, Aws::String>());
+    requestPtr->WaitUntilFinished();
+
+    size_t retries = 0;
+    //just make sure we don't fail because an upload part failed. (e.g. network problems or interuptions)
+    while (requestPtr->GetStatus() == TransferStatus::FAILED && retries++ < 5)
+    {
+        transferManager->RetryUpload(resumeTestFileName, requestPtr);
+        requestPtr->WaitUntilFinished();
+    }
+
+    ASSERT_EQ(TransferStatus::COMPLETED, requestPtr->GetStatus());
+    ASSERT_EQ(multipartId, requestPtr->GetMultiPartId());
+    ASSERT_EQ(30u, requestPtr->GetCompletedParts().size());
+    ASSERT_EQ(requestPtr->GetBytesTotalSize(), requestPtr->GetBytesTransferred());
+
+    ListMultipartUploadsOutcome listMultipartOutcome = m_s3Client->ListMultipartUploads(listMultipartRequest);
+    EXPECT_TRUE(listMultipartOutcome.IsSuccess());
+    ASSERT_EQ(0u, listMultipartOutcome.GetResult().GetUploads().size());
+
+    TransferJournal journal(journalDirectory, TransferDirection::UPLOAD, GetTestBucketName(), RESUME_FILE_KEY, resumeTestFileName);
+    ASSERT_FALSE(journal.HasTransfer());
+
+    // a reused part with a stale ETag fails the completion of the upload, one with stale data fails this comparison
+    VerifyUploadedFile(*transferManager,
+                       resumeTestFileName,
+                       GetTestBucketName(),
+                       RESUME_FILE_KEY,
+                       "text/plain",
+                       Aws::Map<Aws::String, Aws::String>());
+}
+
 TEST_F(TransferTests, TransferManager_MultiPartContentTest)
 {
     Aws::String multiPartContentFileName = MakeFilePath( MULTI_PART_CONTENT_FILE );
@@ -1423,6 +1677,479 @@ TEST_F(TransferTests, TransferManager_CancelAndRetryDownloadTest)
         ASSERT_TRUE(AreFilesSame(MakeDownloadFileName(cancelTestFileName), cancelTestFileName));
     }
 }
+
+TEST(UploadPartSizeTest, TestSmallFilesUseTheMinimumPartSize)
+{
+    ASSERT_EQ(MB5, TransferManager::CalculateUploadPartSize(0, MB5));
+    ASSERT_EQ(MB5, TransferManager::CalculateUploadPartSize(1024, MB5));
+    ASSERT_EQ(MB5, TransferManager::CalculateUploadPartSize(MB5 - 1, MB5));
+}
+
+TEST(UploadPartSizeTest, TestPartsGrowPastTenThousandParts)
+{
+    static const uint64_t MB = 1024 * 1024;
+    static const uint64_t MAX_PARTS = 10000;
+
+    ASSERT_EQ(MB5, TransferManager::CalculateUploadPartSize(MAX_PARTS * MB5, MB5));
+    ASSERT_EQ(6 * MB, TransferManager::CalculateUploadPartSize(MAX_PARTS * MB5 + 1, MB5));
+    // exact multiples of 1 MB are not rounded up any further
+    ASSERT_EQ(7 * MB, TransferManager::CalculateUploadPartSize(MAX_PARTS * 7 * MB, MB5));
+    ASSERT_EQ(8 * MB, TransferManager::CalculateUploadPartSize(MAX_PARTS * 7 * MB + 1, MB5));
+    ASSERT_GE(MAX_PARTS, (MAX_PARTS * 7 * MB + 1 + 8 * MB - 1) / (8 * MB));
+}
+
+TEST(UploadPartBufferTest, TestLargePartsTakeTheirShareOfThePool)
+{
+    ClientConfiguration clientConfig;
+    Aws::Utils::Threading::DefaultExecutor executor;
+    TransferManagerConfiguration transferConfig(&executor);
+    transferConfig.s3Client = Aws::MakeShared<S3Client>(ALLOCATION_TAG, Aws::Auth::AWSCredentials("akid", "secret"), clientConfig);
+    transferConfig.transferBufferMaxHeapSize = 3 * MB5;
+    transferConfig.bufferSize = MB5;
+    auto transferManager = TransferManager::Create(transferConfig);
+
+    // a part of two and a bit buffers holds all three pooled buffers' worth of memory
+    auto largeBuffer = transferManager->AcquirePartBuffer(2 * MB5 + 1);
+    ASSERT_EQ(2 * MB5 + 1, largeBuffer->GetLength());
+
+    std::atomic<bool> acquired(false);
+    std::thread waiter([&]()
+    {
+        auto buffer = transferManager->AcquirePartBuffer(MB5);
+        acquired = true;
+        transferManager->ReleasePartBuffer(buffer);
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    ASSERT_FALSE(acquired.load());
+
+    transferManager->ReleasePartBuffer(largeBuffer);
+    waiter.join();
+    ASSERT_TRUE(acquired.load());
+
+    // a part larger than the whole pool takes all of it
+    auto hugeBuffer = transferManager->AcquirePartBuffer(4 * MB5);
+    ASSERT_EQ(4 * MB5, hugeBuffer->GetLength());
+    transferManager->ReleasePartBuffer(hugeBuffer);
+
+    Aws::Vector<Aws::Utils::Array<uint8_t>*> pooledBuffers;
+    for (int i = 0; i < 3; ++i)
+    {
+        pooledBuffers.push_back(transferManager->AcquirePartBuffer(MB5));
+        ASSERT_EQ(MB5, pooledBuffers.back()->GetLength());
+    }
+    for (auto buffer : pooledBuffers)
+    {
+        transferManager->ReleasePartBuffer(buffer);
+    }
+}
+
+TEST(PartConcurrencyTunerTest, TestLimitFollowsThroughput)
+{
+    static const uint64_t MB = 1024 * 1024;
+    PartConcurrencyTuner tuner(1, 3);
+    auto now = std::chrono::steady_clock::now();
+
+    // the first window always probes upwards
+    tuner.AcquirePart(now);
+    now += std::chrono::seconds(1);
+    tuner.ReleasePart(MB, true, now);
+    ASSERT_EQ(2u, tuner.GetLimit());
+
+    // twice the throughput with two parts, keep growing
+    tuner.AcquirePart(now);
+    tuner.AcquirePart(now);
+    now += std::chrono::seconds(1);
+    tuner.ReleasePart(MB, true, now);
+    tuner.ReleasePart(MB, true, now);
+    ASSERT_EQ(3u, tuner.GetLimit());
+
+    // a third part gains nothing, turn around
+    for (unsigned i = 0; i < 3; ++i)
+    {
+        tuner.AcquirePart(now);
+    }
+    ASSERT_EQ(3u, tuner.GetInFlight());
+    now += std::chrono::seconds(1);
+    for (unsigned i = 0; i < 3; ++i)
+    {
+        tuner.ReleasePart(2 * MB / 3, true, now);
+    }
+    ASSERT_EQ(2u, tuner.GetLimit());
+    ASSERT_EQ(0u, tuner.GetInFlight());
+}
+
+TEST(PartConcurrencyTunerTest, TestFailuresHalveTheLimitWithinBounds)
+{
+    PartConcurrencyTuner tuner(8, 4);
+    ASSERT_EQ(4u, tuner.GetLimit());
+
+    tuner.AcquirePart();
+    tuner.ReleasePart(0, false);
+    ASSERT_EQ(2u, tuner.GetLimit());
+
+    tuner.AcquirePart();
+    tuner.ReleasePart(0, false);
+    tuner.AcquirePart();
+    tuner.ReleasePart(0, false);
+    ASSERT_EQ(1u, tuner.GetLimit());
+
+    // canceled parts neither fail nor count as throughput
+    tuner.AcquirePart();
+    tuner.CancelPart();
+    ASSERT_EQ(1u, tuner.GetLimit());
+    ASSERT_EQ(0u, tuner.GetInFlight());
+}
+
+TEST(PartConcurrencyTunerTest, TestAcquireWaitsForASlot)
+{
+    PartConcurrencyTuner tuner(1, 1);
+    tuner.AcquirePart();
+
+    std::atomic<bool> acquired(false);
+    std::thread waiter([&tuner, &acquired] { tuner.AcquirePart(); acquired = true; });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    ASSERT_FALSE(acquired.load());
+
+    tuner.CancelPart();
+    waiter.join();
+    ASSERT_TRUE(acquired.load());
+    ASSERT_EQ(1u, tuner.GetInFlight());
+    tuner.CancelPart();
+}
+
+TEST(DirectoryTransferProgressTest, TestCountsFilesAsTheyFinish)
+{
+    DirectoryTransferProgress progress(2);
+    auto first = Aws::MakeShared<TransferHandle>(ALLOCATION_TAG, "bucket", "first", 10);
+    auto second = Aws::MakeShared<TransferHandle>(ALLOCATION_TAG, "bucket", "second", 20);
+
+    progress.AddDiscoveredFile(10);
+    progress.AddDiscoveredFile(20);
+    progress.AddTransfer(first);
+    progress.AddTransfer(second);
+    ASSERT_EQ(2u, progress.GetFilesDiscovered());
+    ASSERT_EQ(30u, progress.GetBytesDiscovered());
+    ASSERT_EQ(2u, progress.GetFilesInFlight());
+    ASSERT_FALSE(progress.HasFreeSlot());
+
+    first->UpdateStatus(TransferStatus::COMPLETED);
+    ASSERT_TRUE(progress.HasFreeSlot());
+    ASSERT_EQ(1u, progress.GetFilesCompleted());
+    ASSERT_EQ(10u, progress.GetBytesTransferred());
+    progress.SetListingComplete();
+    ASSERT_FALSE(progress.IsFinished());
+
+    std::thread finisher([&second, &progress] { second->UpdateStatus(TransferStatus::FAILED); progress.NotifyTransferFinished(); });
+    progress.WaitUntilFinished();
+    finisher.join();
+    ASSERT_TRUE(progress.IsFinished());
+    ASSERT_EQ(1u, progress.GetFilesCompleted());
+    ASSERT_EQ(1u, progress.GetFilesFailed());
+    ASSERT_EQ(0u, progress.GetFilesInFlight());
+}
+
+TEST(TransferJournalTest, TestPartsSurviveReopeningAndTornRecords)
+{
+    Aws::String journalDirectory = Aws::FileSystem::CreateTempFilePath();
+    ASSERT_TRUE(Aws::FileSystem::CreateDirectoryIfNotExists(journalDirectory.c_str()));
+    Aws::String key = "journaled key/with spaces";
+    Aws::String filePath = "/tmp/journaled file";
+
+    Aws::String journalPath;
+    {
+        TransferJournal journal(journalDirectory, TransferDirection::UPLOAD, "bucket", key, filePath);
+        ASSERT_FALSE(journal.HasTransfer());
+        ASSERT_TRUE(journal.Rewrite(3 * MB5, MB5, "upload id", ""));
+
+        unsigned char data[] = { 1, 2, 3, 4 };
+        TransferJournal::Part part;
+        part.partId = 2;
+        part.rangeBegin = MB5;
+        part.sizeInBytes = MB5;
+        part.eTag = "\"etag 2\"";
+        part.checksum = TransferJournal::CalculateChecksum(0, data, sizeof(data));
+        ASSERT_TRUE(journal.RecordCompletedPart(part));
+        journalPath = journal.GetPath();
+    }
+
+    // a record cut short by a crash is ignored
+    {
+        Aws::OFStream journalFile(journalPath.c_str(), std::ios_base::out | std::ios_base::app | std::ios_base::binary);
+        journalFile << "part 3 ";
+    }
+
+    {
+        TransferJournal journal(journalDirectory, TransferDirection::UPLOAD, "bucket", key, filePath);
+        ASSERT_TRUE(journal.HasTransfer());
+        ASSERT_EQ(3 * MB5, journal.GetBytesTotalSize());
+        ASSERT_EQ(MB5, journal.GetPartSize());
+        ASSERT_STREQ("upload id", journal.GetMultipartId().c_str());
+        ASSERT_EQ(1u, journal.GetCompletedParts().size());
+        const auto& part = journal.GetCompletedParts().at(2);
+        ASSERT_EQ(MB5, part.rangeBegin);
+        ASSERT_STREQ("\"etag 2\"", part.eTag.c_str());
+        unsigned char data[] = { 1, 2, 3, 4 };
+        ASSERT_EQ(TransferJournal::CalculateChecksum(0, data, sizeof(data)), part.checksum);
+
+        // another transfer does not pick up this journal
+        TransferJournal otherJournal(journalDirectory, TransferDirection::DOWNLOAD, "bucket", key, filePath);
+        ASSERT_FALSE(otherJournal.HasTransfer());
+
+        journal.Remove();
+    }
+
+    TransferJournal removedJournal(journalDirectory, TransferDirection::UPLOAD, "bucket", key, filePath);
+    ASSERT_FALSE(removedJournal.HasTransfer());
+    Aws::FileSystem::DeepDeleteDirectory(journalDirectory.c_str());
+}
+
+// hands its data out 4KB at a time and counts every byte handed out, including bytes read again after seeking back.
+class ReadCountingStreamBuf : public std::streambuf
+{
+public:
+    ReadCountingStreamBuf(const Aws::String& data) : m_data(data), m_bytesRead(0) {}
+
+    size_t GetBytesRead() const { return m_bytesRead; }
+
+protected:
+    int_type underflow() override
+    {
+        if (gptr() < egptr())
+        {
+            return traits_type::to_int_type(*gptr());
+        }
+
+        size_t pos = egptr() ? static_cast<size_t>(egptr() - &m_data[0]) : 0;
+        if (pos >= m_data.size())
+        {
+            return traits_type::eof();
+        }
+
+        size_t length = (std::min)(static_cast<size_t>(4096), m_data.size() - pos);
+        setg(&m_data[0] + pos, &m_data[0] + pos, &m_data[0] + pos + length);
+        m_bytesRead += length;
+        return traits_type::to_int_type(*gptr());
+    }
+
+    pos_type seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which) override
+    {
+        off_type current = gptr() ? static_cast<off_type>(gptr() - &m_data[0]) : 0;
+        off_type base = dir == std::ios_base::beg ? 0 : (dir == std::ios_base::cur ? current : static_cast<off_type>(m_data.size()));
+        off_type pos = base + off;
+        if (!(which & std::ios_base::in) || pos < 0 || pos > static_cast<off_type>(m_data.size()))
+        {
+            return pos_type(off_type(-1));
+        }
+
+        setg(&m_data[0] + pos, &m_data[0] + pos, &m_data[0] + pos);
+        return pos_type(pos);
+    }
+
+    pos_type seekpos(pos_type pos, std::ios_base::openmode which) override
+    {
+        return seekoff(off_type(pos), std::ios_base::beg, which);
+    }
+
+private:
+    Aws::String m_data;
+    size_t m_bytesRead;
+};
+
+class PayloadSigningChunkSizeTest : public ::testing::Test
+{
+protected:
+    std::shared_ptr<MockHttpClient> m_mockHttpClient;
+
+    void SetUp() override
+    {
+        m_mockHttpClient = Aws::MakeShared<MockHttpClient>(ALLOCATION_TAG);
+        auto mockHttpClientFactory = Aws::MakeShared<MockHttpClientFactory>(ALLOCATION_TAG);
+        mockHttpClientFactory->SetClient(m_mockHttpClient);
+        SetHttpClientFactory(mockHttpClientFactory);
+    }
+
+    void TearDown() override
+    {
+        m_mockHttpClient = nullptr;
+        CleanupHttp();
+        InitHttp();
+    }
+
+    std::shared_ptr<S3Client> CreateClient(size_t payloadSigningChunkSize)
+    {
+        ClientConfiguration config;
+        config.payloadSigningChunkSize = payloadSigningChunkSize;
+        return Aws::MakeShared<S3Client>(ALLOCATION_TAG, Aws::Auth::AWSCredentials("akid", "secret"), config);
+    }
+
+    void QueueOkResponse()
+    {
+        auto request = CreateHttpRequest(URI("https://bucket.s3.amazonaws.com/key"), HttpMethod::HTTP_PUT,
+            Aws::Utils::Stream::DefaultResponseStreamFactoryMethod);
+        auto response = Aws::MakeShared<Standard::StandardHttpResponse>(ALLOCATION_TAG, *request);
+        response->SetResponseCode(HttpResponseCode::OK);
+        response->AddHeader("etag", "\"etag\"");
+        m_mockHttpClient->AddResponseToReturn(response);
+    }
+
+    // reads the body the way the http client would, returns what was sent.
+    Aws::String SendMostRecentBody()
+    {
+        Aws::StringStream sent;
+        sent << m_mockHttpClient->GetMostRecentHttpRequest().GetContentBody()->rdbuf();
+        return sent.str();
+    }
+};
+
+TEST_F(PayloadSigningChunkSizeTest, TestSignedPayloadIsReadTwiceByDefault)
+{
+    Aws::String data(3 * 64 * 1024 + 100, 'p');
+    ReadCountingStreamBuf body(data);
+    auto client = CreateClient(0);
+
+    PutObjectRequest putObjectRequest;
+    putObjectRequest.WithBucket("bucket").WithKey("key").SetContentLength(static_cast<long long>(data.size()));
+    putObjectRequest.SetBody(Aws::MakeShared<Aws::IOStream>(ALLOCATION_TAG, &body));
+    QueueOkResponse();
+    ASSERT_TRUE(client->PutObject(putObjectRequest).IsSuccess());
+
+    // once to hash the payload up front, once to send it.
+    ASSERT_EQ(data.size(), body.GetBytesRead());
+    ASSERT_EQ(data, SendMostRecentBody());
+    ASSERT_EQ(2 * data.size(), body.GetBytesRead());
+}
+
+TEST_F(PayloadSigningChunkSizeTest, TestChunkSignedUploadPartIsReadOnce)
+{
+    Aws::String data(3 * 64 * 1024 + 100, 'p');
+    ReadCountingStreamBuf body(data);
+    auto client = CreateClient(64 * 1024);
+
+    UploadPartRequest uploadPartRequest;
+    uploadPartRequest.WithBucket("bucket").WithKey("key").WithUploadId("upload").WithPartNumber(1).SetContentLength(static_cast<long long>(data.size()));
+    uploadPartRequest.SetBody(Aws::MakeShared<Aws::IOStream>(ALLOCATION_TAG, &body));
+    QueueOkResponse();
+    ASSERT_TRUE(client->UploadPart(uploadPartRequest).IsSuccess());
+
+    const auto& sentRequest = m_mockHttpClient->GetMostRecentHttpRequest();
+    ASSERT_STREQ("STREAMING-AWS4-HMAC-SHA256-PAYLOAD", sentRequest.GetHeaderValue("x-amz-content-sha256").c_str());
+    ASSERT_STREQ("aws-chunked", sentRequest.GetHeaderValue("content-encoding").c_str());
+    ASSERT_EQ(0u, body.GetBytesRead());
+
+    Aws::String sent = SendMostRecentBody();
+    ASSERT_EQ(data.size(), body.GetBytesRead());
+    ASSERT_STREQ(sentRequest.GetHeaderValue(CONTENT_LENGTH_HEADER).c_str(), StringUtils::to_string(sent.size()).c_str());
+}
+
+// reads each request body and reports it sent the way a real http client does, and records what was sent.
+class BodyReadingHttpClient : public MockHttpClient
+{
+public:
+    std::shared_ptr<HttpResponse> MakeRequest(HttpRequest& request, Aws::Utils::RateLimits::RateLimiterInterface* readLimiter = nullptr,
+                                              Aws::Utils::RateLimits::RateLimiterInterface* writeLimiter = nullptr) const override
+    {
+        Aws::StringStream body;
+        if (request.GetContentBody())
+        {
+            body << request.GetContentBody()->rdbuf();
+        }
+        if (request.GetDataSentEventHandler())
+        {
+            request.GetDataSentEventHandler()(&request, static_cast<long long>(body.str().size()));
+        }
+
+        std::lock_guard<std::mutex> locker(m_bodiesLock);
+        m_bodies.push_back(body.str());
+        return MockHttpClient::MakeRequest(request, readLimiter, writeLimiter);
+    }
+
+    Aws::Vector<Aws::String> GetBodies() const { std::lock_guard<std::mutex> locker(m_bodiesLock); return m_bodies; }
+
+private:
+    mutable std::mutex m_bodiesLock;
+    mutable Aws::Vector<Aws::String> m_bodies;
+};
+
+class PositionedReadUploadTest : public ::testing::Test
+{
+protected:
+    std::shared_ptr<BodyReadingHttpClient> m_mockHttpClient;
+
+    void SetUp() override
+    {
+        m_mockHttpClient = Aws::MakeShared<BodyReadingHttpClient>(ALLOCATION_TAG);
+        auto mockHttpClientFactory = Aws::MakeShared<MockHttpClientFactory>(ALLOCATION_TAG);
+        mockHttpClientFactory->SetClient(m_mockHttpClient);
+        SetHttpClientFactory(mockHttpClientFactory);
+    }
+
+    void TearDown() override
+    {
+        m_mockHttpClient = nullptr;
+        CleanupHttp();
+        InitHttp();
+    }
+
+    void QueueOkResponse(const Aws::String& body)
+    {
+        auto request = CreateHttpRequest(URI("https://bucket.s3.amazonaws.com/key"), HttpMethod::HTTP_PUT,
+            Aws::Utils::Stream::DefaultResponseStreamFactoryMethod);
+        auto response = Aws::MakeShared<Standard::StandardHttpResponse>(ALLOCATION_TAG, *request);
+        response->SetResponseCode(HttpResponseCode::OK);
+        response->AddHeader("etag", "\"etag\"");
+        response->GetResponseBody() << body;
+        m_mockHttpClient->AddResponseToReturn(response);
+    }
+};
+
+TEST_F(PositionedReadUploadTest, TestPartsAreReadWhenTheyAreSent)
+{
+    Aws::String fileName = Aws::FileSystem::CreateTempFilePath();
+    Aws::String contents;
+    for (size_t i = 0; contents.size() < MB5 + 1000; ++i)
+    {
+        contents += StringUtils::to_string(i);
+    }
+    ScopedTestFile testFile(fileName, contents);
+
+    // one thread each, the parts are queued on the transfer executor and sent on the client's
+    Aws::Utils::Threading::PooledThreadExecutor transferExecutor(1);
+    ClientConfiguration clientConfig;
+    clientConfig.executor = Aws::MakeShared<Aws::Utils::Threading::PooledThreadExecutor>(ALLOCATION_TAG, 1);
+    TransferManagerConfiguration transferConfig(&transferExecutor);
+    transferConfig.s3Client = Aws::MakeShared<S3Client>(ALLOCATION_TAG, Aws::Auth::AWSCredentials("akid", "secret"), clientConfig);
+    auto transferManager = TransferManager::Create(transferConfig);
+
+    QueueOkResponse("<InitiateMultipartUploadResult><Bucket>bucket</Bucket><Key>key</Key><UploadId>upload</UploadId></InitiateMultipartUploadResult>");
+    QueueOkResponse("");
+    QueueOkResponse("");
+    QueueOkResponse("<CompleteMultipartUploadResult><Bucket>bucket</Bucket><Key>key</Key><ETag>\"etag\"</ETag></CompleteMultipartUploadResult>");
+
+    // hold the sending thread until both parts are queued
+    std::promise<void> sendingReleased;
+    std::shared_future<void> sendingReleasedFuture = sendingReleased.get_future().share();
+    clientConfig.executor->Submit([sendingReleasedFuture]() { sendingReleasedFuture.wait(); });
+
+    auto handle = transferManager->UploadFile(fileName, "bucket", "key", "text/plain", Aws::Map<Aws::String, Aws::String>());
+    std::promise<void> partsQueued;
+    transferExecutor.Submit([&partsQueued]() { partsQueued.set_value(); });
+    partsQueued.get_future().wait();
+
+    // what the parts send is what the file holds when they are sent, not when they were queued
+    Aws::String changedContents(contents.size(), 'c');
+    ScopedTestFile changedFile(fileName, changedContents);
+    sendingReleased.set_value();
+
+    handle->WaitUntilFinished();
+    ASSERT_EQ(TransferStatus::COMPLETED, handle->GetStatus());
+
+    auto bodies = m_mockHttpClient->GetBodies();
+    ASSERT_EQ(4u, bodies.size());
+    ASSERT_EQ(changedContents.substr(0, MB5), bodies[1]);
+    ASSERT_EQ(changedContents.substr(MB5), bodies[2]);
+}
+
 /*
 TEST_F(TransferTests, TransferManager_MediumVersionedTest)
 {
@@ -0,0 +1,108 @@
+/*
+* Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+*
+* Licensed under the Apache License, Version 2.0 (the "License").
+* You may not use this file except in compliance with the License.
+* A copy of the License is located at
+*
+*  http://aws.amazon.com/apache2.0
+*
+* or in the "license" file accompanying this file. This file is distributed
+* on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+* express or implied. See the License for the specific language governing
+* permissions and limitations under the License.
+*/
+
+#pragma once
+
+#include <aws/transfer/Transfer_EXPORTS.h>
+#include <aws/transfer/TransferHandle.h>
+#include <aws/core/utils/memory/stl/AWSVector.h>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+
+namespace Aws
+{
+    namespace Transfer
+    {
+        /**
+         * Aggregate progress of one UploadDirectory or DownloadToDirectory call. Files are discovered a directory entry or a listing page at a time,
+         * and only while fewer than maxPendingTransfers of them are in flight, so the counters grow as the operation goes.
+         * Individual files are still reported through transferInitiatedCallback.
+         *
+         * All accessors are thread safe.
+         */
+        class AWS_TRANSFER_API DirectoryTransferProgress
+        {
+        public:
+            DirectoryTransferProgress(size_t maxPendingTransfers);
+
+            /**
+             * Files found by traversal or listing so far, and their total size.
+             */
+            size_t GetFilesDiscovered() const;
+            uint64_t GetBytesDiscovered() const;
+            /**
+             * Files whose transfer has been started and has not finished yet.
+             */
+            size_t GetFilesInFlight() const;
+            /**
+             * Files whose transfer completed.
+             */
+            size_t GetFilesCompleted() const;
+            /**
+             * Files whose transfer failed, was canceled or aborted. Their handles were passed to transferInitiatedCallback and can be retried.
+             */
+            size_t GetFilesFailed() const;
+            /**
+             * Bytes of completed files plus the progress of files in flight.
+             */
+            uint64_t GetBytesTransferred() const;
+            /**
+             * Average bytes per second since the operation started.
+             */
+            double GetThroughput() const;
+            /**
+             * If the traversal or listing has run to the end.
+             */
+            bool IsListingComplete() const;
+            /**
+             * If every discovered file has finished.
+             */
+            bool IsFinished() const;
+            /**
+             * Blocks the calling thread until every discovered file has finished.
+             */
+            void WaitUntilFinished() const;
+
+            /**
+             * Used by TransferManager to feed the counters.
+             */
+            void AddDiscoveredFile(uint64_t sizeInBytes);
+            bool HasFreeSlot() const;
+            void AddTransfer(const std::shared_ptr<TransferHandle>& handle);
+            void SetListingComplete();
+            /**
+             * Wakes WaitUntilFinished() callers, which then check for finished transfers.
+             */
+            void NotifyTransferFinished();
+
+        private:
+            void SweepFinishedTransfers() const;
+
+            size_t m_maxPendingTransfers;
+            std::chrono::steady_clock::time_point m_startTime;
+            size_t m_filesDiscovered;
+            uint64_t m_bytesDiscovered;
+            bool m_listingComplete;
+            mutable size_t m_filesCompleted;
+            mutable size_t m_filesFailed;
+            mutable uint64_t m_bytesCompleted;
+            mutable Aws::Vector<std::shared_ptr<TransferHandle>> m_inFlight;
+            mutable std::mutex m_lock;
+            mutable std::condition_variable m_finishedSignal;
+        };
+    }
+}
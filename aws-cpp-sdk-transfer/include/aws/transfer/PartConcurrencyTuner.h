@@ -0,0 +1,86 @@
+/*
+* Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+*
+* Licensed under the Apache License, Version 2.0 (the "License").
+* You may not use this file except in compliance with the License.
+* A copy of the License is located at
+*
+*  http://aws.amazon.com/apache2.0
+*
+* or in the "license" file accompanying this file. This file is distributed
+* on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+* express or implied. See the License for the specific language governing
+* permissions and limitations under the License.
+*/
+
+#pragma once
+
+#include <aws/transfer/Transfer_EXPORTS.h>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <cstdint>
+
+namespace Aws
+{
+    namespace Transfer
+    {
+        /**
+         * Decides how many parts a TransferManager keeps in flight, across all of its transfers. Every time as many parts have completed
+         * as are allowed in flight, the aggregate throughput of that window is compared with the previous one. The limit keeps moving by
+         * one part in the same direction while throughput improves by more than a few percent and turns around when it does not,
+         * so it settles around the point where additional connections stop paying off. A failed part halves the limit.
+         *
+         * The limit stays between 1 and maxParts, which TransferManager derives from transferBufferMaxHeapSize.
+         */
+        class AWS_TRANSFER_API PartConcurrencyTuner
+        {
+        public:
+            PartConcurrencyTuner(size_t initialParts, size_t maxParts);
+
+            PartConcurrencyTuner(const PartConcurrencyTuner&) = delete;
+            PartConcurrencyTuner& operator=(const PartConcurrencyTuner&) = delete;
+
+            /**
+             * Blocks until another part may be put in flight and counts it.
+             */
+            void AcquirePart();
+            void AcquirePart(std::chrono::steady_clock::time_point now);
+
+            /**
+             * A part put in flight by AcquirePart() finished. bytes is the size of the part when it succeeded.
+             */
+            void ReleasePart(uint64_t bytes, bool succeeded);
+            void ReleasePart(uint64_t bytes, bool succeeded, std::chrono::steady_clock::time_point now);
+
+            /**
+             * A part put in flight by AcquirePart() was canceled or never sent. Does not count towards throughput or errors.
+             */
+            void CancelPart();
+
+            /**
+             * Number of parts currently allowed in flight.
+             */
+            size_t GetLimit() const;
+
+            /**
+             * Number of parts currently in flight.
+             */
+            size_t GetInFlight() const;
+
+        private:
+            void StartWindow(std::chrono::steady_clock::time_point now);
+
+            size_t m_limit;
+            size_t m_maxParts;
+            size_t m_inFlight;
+            int m_direction;
+            double m_lastThroughput;
+            std::chrono::steady_clock::time_point m_windowStart;
+            uint64_t m_windowBytes;
+            size_t m_windowParts;
+            mutable std::mutex m_lock;
+            std::condition_variable m_partReleased;
+        };
+    }
+}
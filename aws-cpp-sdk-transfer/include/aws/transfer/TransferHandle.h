@@ -34,11 +34,21 @@ namespace Aws
         template < typename T > class Array;
     }
 
+    namespace FileSystem
+    {
+        class PositionedWriteFile;
+    }
+
     namespace Transfer
     {
         class TransferHandle;
+        class TransferJournal;
 
         typedef std::function<Aws::IOStream*(void)> CreateDownloadStreamCallback;
+        /**
+         * Receives the next length bytes of a streaming download. Return false to cancel the download.
+         */
+        typedef std::function<bool(const unsigned char* data, std::size_t length)> DownloadConsumerCallback;
 
         struct DownloadConfiguration
         {
@@ -151,6 +161,12 @@ namespace Aws
              */
             TransferHandle(const Aws::String& bucketName, const Aws::String& keyName, CreateDownloadStreamCallback createDownloadStreamFn);
 
+            /**
+             * DOWNLOAD to the file at targetFilePath. Multipart downloads write their parts straight into the file, createDownloadStreamFn
+             * must open the same file and is used for single part downloads.
+             */
+            TransferHandle(const Aws::String& bucketName, const Aws::String& keyName, const Aws::String& targetFilePath, CreateDownloadStreamCallback createDownloadStreamFn);
+
             ~TransferHandle();
 
             /**
@@ -280,6 +296,13 @@ namespace Aws
             const Aws::String& GetVersionId() const { return m_versionId; }
             void SetVersionId(const Aws::String& versionId) { m_versionId = versionId; }
 
+            /**
+             * (Download only) ETag of the object when the download started, from its HEAD request. The range requests of a streaming download
+             * are sent with it as If-Match, so its parts, retries included, all come from the same object.
+             */
+            const Aws::String& GetObjectETag() const { return m_objectETag; }
+            void SetObjectETag(const Aws::String& objectETag) { m_objectETag = objectETag; }
+
             /**
              * Upload or Download?
              */
@@ -342,12 +365,53 @@ namespace Aws
              */
             void WaitUntilFinished() const;      
 
+            /**
+             * Called every time the transfer reaches a finished status, after WaitUntilFinished() callers are woken. Must be set before the transfer starts.
+             */
+            inline void SetFinishedCallback(const std::function<void()>& finishedCallback) { m_finishedCallback = finishedCallback; }
+
             const CreateDownloadStreamCallback& GetCreateDownloadStreamFunction() const { return m_createDownloadStreamFn; }
 
             void WritePartToDownloadStream(Aws::IOStream* partStream, std::size_t writeOffset);
 
+            /**
+             * Whether this is a download to GetTargetFilePath() whose parts are written with positioned writes rather than through the download stream.
+             */
+            inline bool IsFileDownload() const { return m_direction == TransferDirection::DOWNLOAD && !m_fileName.empty(); }
+
+            /**
+             * Opens the target file of a file download, discarding its contents unless keepContents is set, and reserves preallocateSize bytes
+             * when it is not 0. keepContents is used to resume a download from its journal. Must be called before any part is written.
+             * A retried download keeps writing to the file opened the first time.
+             */
+            bool OpenDownloadFile(uint64_t preallocateSize, bool keepContents = false);
+
+            /**
+             * Writes length bytes of a downloaded part from data at writeOffset of the target file. Takes no lock, parts are written in parallel.
+             */
+            bool WritePartToDownloadFile(const unsigned char* data, std::size_t length, uint64_t writeOffset);
+
+            /**
+             * Flushes the parts written so far to the storage device.
+             */
+            bool SyncDownloadFile();
+
             void ApplyDownloadConfiguration(const DownloadConfiguration& downloadConfig);
 
+            /**
+             * (Streaming download only) the callback the object is delivered to, in order, instead of being written to a stream or file.
+             */
+            inline const DownloadConsumerCallback& GetDownloadConsumer() const { return m_downloadConsumer; }
+            inline void SetDownloadConsumer(const DownloadConsumerCallback& downloadConsumer) { m_downloadConsumer = downloadConsumer; }
+            inline bool IsStreamingDownload() const { return m_direction == TransferDirection::DOWNLOAD && static_cast<bool>(m_downloadConsumer); }
+
+            /**
+             * The on disk journal of the completed parts of this transfer, if TransferManager is configured with a journal directory
+             * and the transfer is a multipart transfer from or to a file.
+             */
+            inline const std::shared_ptr<TransferJournal>& GetJournal() const { return m_journal; }
+            inline void SetJournal(const std::shared_ptr<TransferJournal>& journal) { m_journal = journal; }
+
             bool LockForCompletion() 
             {
                 bool expected = false;
@@ -373,14 +437,20 @@ namespace Aws
             Aws::String m_fileName;
             Aws::String m_contentType;
             Aws::String m_versionId;
+            Aws::String m_objectETag;
             Aws::Map<Aws::String, Aws::String> m_metadata;
             TransferStatus m_status;
             Aws::Client::AWSError<Aws::S3::S3Errors> m_lastError;
             std::atomic<bool> m_cancel;
             std::shared_ptr<const Aws::Client::AsyncCallerContext> m_context;
 
+            std::function<void()> m_finishedCallback;
+            std::shared_ptr<TransferJournal> m_journal;
+
             CreateDownloadStreamCallback m_createDownloadStreamFn;
+            DownloadConsumerCallback m_downloadConsumer;
             Aws::IOStream* m_downloadStream;
+            Aws::FileSystem::PositionedWriteFile* m_downloadFile;
 
             std::mutex m_downloadStreamLock;
             mutable std::mutex m_partsLock;
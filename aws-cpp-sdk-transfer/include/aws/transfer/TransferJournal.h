@@ -0,0 +1,132 @@
+/*
+* Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+*
+* Licensed under the Apache License, Version 2.0 (the "License").
+* You may not use this file except in compliance with the License.
+* A copy of the License is located at
+*
+*  http://aws.amazon.com/apache2.0
+*
+* or in the "license" file accompanying this file. This file is distributed
+* on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+* express or implied. See the License for the specific language governing
+* permissions and limitations under the License.
+*/
+
+#pragma once
+
+#include <aws/transfer/Transfer_EXPORTS.h>
+#include <aws/transfer/TransferHandle.h>
+#include <aws/core/utils/memory/stl/AWSString.h>
+#include <aws/core/utils/memory/stl/AWSMap.h>
+#include <aws/core/utils/memory/stl/AWSStreamFwd.h>
+#include <mutex>
+#include <cstdint>
+
+namespace Aws
+{
+    namespace Transfer
+    {
+        /**
+         * On disk record of the completed parts of one multipart transfer, so it can be resumed by another process. The journal of a transfer
+         * lives in the journal directory under a name derived from its direction, bucket, key and local file, so starting the same transfer
+         * again finds it. It is a small text file: a header line with the layout of the transfer (total size, part size, upload id or object
+         * ETag) followed by one appended line per completed part with its byte range, ETag and the CRC32 of its data.
+         *
+         * Lines are flushed to the operating system as parts complete, not synced to the storage device. A journal outlives a crash of the
+         * process, and the CRC32 lets the parts be checked against the local file before they are trusted. An unfinished last line is ignored.
+         *
+         * RecordCompletedPart() is thread safe, the other members are used while the transfer is being set up.
+         */
+        class AWS_TRANSFER_API TransferJournal
+        {
+        public:
+            struct Part
+            {
+                Part() : partId(0), rangeBegin(0), sizeInBytes(0), checksum(0) {}
+
+                int partId;
+                uint64_t rangeBegin;
+                uint64_t sizeInBytes;
+                Aws::String eTag;
+                uint32_t checksum;
+            };
+
+            /**
+             * Reads the journal of the transfer from journalDirectory if there is one.
+             */
+            TransferJournal(const Aws::String& journalDirectory, TransferDirection direction, const Aws::String& bucketName, const Aws::String& keyName,
+                    const Aws::String& filePath);
+            ~TransferJournal();
+
+            TransferJournal(const TransferJournal&) = delete;
+            TransferJournal& operator=(const TransferJournal&) = delete;
+
+            inline const Aws::String& GetPath() const { return m_path; }
+
+            /**
+             * If a journal of this transfer was read, or has been written since.
+             */
+            inline bool HasTransfer() const { return m_hasTransfer; }
+            inline uint64_t GetBytesTotalSize() const { return m_bytesTotalSize; }
+            inline uint64_t GetPartSize() const { return m_partSize; }
+            /**
+             * Upload id of a multipart upload.
+             */
+            inline const Aws::String& GetMultipartId() const { return m_multipartId; }
+            /**
+             * ETag of the object being downloaded, a resumed download is only valid if the object has not changed since.
+             */
+            inline const Aws::String& GetObjectETag() const { return m_objectETag; }
+            /**
+             * The parts recorded as completed, by part id.
+             */
+            inline const Aws::Map<int, Part>& GetCompletedParts() const { return m_completedParts; }
+
+            /**
+             * Replaces the journal with a header for the given layout followed by completedParts, then keeps it open for appending.
+             * Used to start a journal and to compact one that is being resumed, after its parts were checked.
+             */
+            bool Rewrite(uint64_t bytesTotalSize, uint64_t partSize, const Aws::String& multipartId, const Aws::String& objectETag,
+                    const Aws::Map<int, Part>& completedParts = Aws::Map<int, Part>());
+
+            /**
+             * Appends a completed part. Must follow Rewrite().
+             */
+            bool RecordCompletedPart(const Part& part);
+
+            /**
+             * Deletes the journal, once the transfer completed or was aborted.
+             */
+            void Remove();
+
+            /**
+             * Continues checksum, the checksum of the preceding data of a part (0 for none), over length bytes of its data.
+             * This is the CRC32 recorded for each part.
+             */
+            static uint32_t CalculateChecksum(uint32_t checksum, const unsigned char* data, size_t length);
+
+        private:
+            void Read();
+            bool ParseLine(const Aws::String& line);
+            Aws::String FormatHeader() const;
+            static Aws::String FormatPart(const Part& part);
+
+            Aws::String m_path;
+            TransferDirection m_direction;
+            Aws::String m_bucketName;
+            Aws::String m_keyName;
+            Aws::String m_filePath;
+
+            bool m_hasTransfer;
+            uint64_t m_bytesTotalSize;
+            uint64_t m_partSize;
+            Aws::String m_multipartId;
+            Aws::String m_objectETag;
+            Aws::Map<int, Part> m_completedParts;
+
+            Aws::OFStream* m_stream;
+            std::mutex m_lock;
+        };
+    }
+}
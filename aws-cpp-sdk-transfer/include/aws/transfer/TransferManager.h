@@ -16,6 +16,9 @@
 #pragma once
 
 #include <aws/transfer/TransferHandle.h>
+#include <aws/transfer/PartConcurrencyTuner.h>
+#include <aws/transfer/DirectoryTransferProgress.h>
+#include <aws/transfer/TransferJournal.h>
 #include <aws/s3/S3Client.h>
 #include <aws/s3/model/PutObjectRequest.h>
 #include <aws/s3/model/CreateMultipartUploadRequest.h>
@@ -26,12 +29,21 @@
 #include <aws/core/client/AsyncCallerContext.h>
 
 #include <memory>
+#include <mutex>
 
 namespace Aws
 {    
+    namespace FileSystem
+    {
+        class MappedFile;
+        class PositionedReadFile;
+    }
+
     namespace Transfer
     {
         class TransferManager;
+        struct DirectoryTransferState;
+        struct StreamingDownloadState;
 
         typedef std::function<void(const TransferManager*, const std::shared_ptr<const TransferHandle>&)> UploadProgressCallback;
         typedef std::function<void(const TransferManager*, const std::shared_ptr<const TransferHandle>&)> DownloadProgressCallback;
@@ -41,12 +53,33 @@ namespace Aws
 
         const uint64_t MB5 = 5 * 1024 * 1024;
 
+        /**
+         * When the parts of a download to a file name are flushed to the storage device.
+         */
+        enum class DownloadFileSyncPolicy
+        {
+            /**
+             * Leave write back to the operating system, as for downloads to a stream.
+             */
+            NONE,
+            /**
+             * Flush once every part has been written, before the transfer is reported as completed.
+             */
+            ON_COMPLETION,
+            /**
+             * Flush after every part. A crash then loses at most the parts in flight.
+             */
+            EVERY_PART
+        };
+
         /**
          * Configuration for use with TransferManager. The data here will be copied directly to TransferManager.
          */
         struct TransferManagerConfiguration
         {
-            TransferManagerConfiguration(Aws::Utils::Threading::Executor* executor) : s3Client(nullptr), transferExecutor(executor), transferBufferMaxHeapSize(10 * MB5), bufferSize(MB5), maxParallelTransfers(1)
+            TransferManagerConfiguration(Aws::Utils::Threading::Executor* executor) : s3Client(nullptr), transferExecutor(executor), transferBufferMaxHeapSize(10 * MB5), bufferSize(MB5), maxParallelTransfers(1),
+                preallocateDownloadFiles(true), downloadFileSyncPolicy(DownloadFileSyncPolicy::NONE), autotunePartConcurrency(false),
+                maxPendingDirectoryTransfers(128), downloadReadAheadParts(8), mapUploadFiles(false)
             {
                 //let the programmer know if they've created two useless values here.
                 //you need at least bufferSize * maxParallelTransfers for the  max heap size.
@@ -87,14 +120,58 @@ namespace Aws
              */
             uint64_t transferBufferMaxHeapSize;
             /**
-             * Defaults to 5MB. If you are uploading large files,  (larger than 50GB, this needs to be specified to be something larger than 5MB. Also keep in mind that you may need
-             * to increase your max heap size if this is something you plan on increasing.
+             * Defaults to 5MB. This is the size of download parts and the smallest size of upload parts. Uploads larger than bufferSize * 10,000 use larger parts,
+             * as S3 allows at most 10,000 parts per upload. A larger part counts as many buffers as it spans against transferBufferMaxHeapSize, so fewer of them are
+             * in flight at once. Keep in mind that you may need to increase your max heap size if this is something you plan on increasing.
              */
             uint64_t bufferSize;
             /**
              * Maximum number of file transfers to run in parallel. The default is 1. This is only enforced if the executor is a thread pool.
              */
             size_t maxParallelTransfers;
+            /**
+             * Multipart downloads to a file name write each part at its offset in the file straight from the part buffer, in parallel.
+             * If set, the whole object is reserved on disk before the first part is requested, so a full disk fails the transfer up front
+             * and parts landing out of order do not fragment the file. Defaults to true.
+             */
+            bool preallocateDownloadFiles;
+            /**
+             * When the parts of a download to a file name are flushed to the storage device. Defaults to NONE.
+             */
+            DownloadFileSyncPolicy downloadFileSyncPolicy;
+            /**
+             * Tune the number of upload and download parts in flight, across all transfers, from the observed throughput and failures instead of
+             * only bounding it by the buffer pool. Starts at maxParallelTransfers parts and stays between 1 and transferBufferMaxHeapSize / bufferSize.
+             * See PartConcurrencyTuner. Defaults to false.
+             */
+            bool autotunePartConcurrency;
+            /**
+             * Most files of one UploadDirectory or DownloadToDirectory call that are started and not finished yet. The directory is only traversed,
+             * or listed, further as earlier files finish, which bounds the handles and open files of very large directories. Defaults to 128.
+             */
+            size_t maxPendingDirectoryTransfers;
+            /**
+             * If set, multipart uploads from a file name and multipart downloads to a file name keep a TransferJournal of their completed parts
+             * in this existing directory, removed once the transfer completes or is aborted. Starting the same transfer again, e.g. after the process
+             * restarted, resumes it: the journaled parts are checked against the CRC32 of the local file, and for uploads against the parts S3 lists
+             * for the upload, then only the other parts are transferred. A download is only resumed if the object still has the same ETag.
+             * Defaults to empty, no journal.
+             */
+            Aws::String journalDirectory;
+            /**
+             * How many parts of a DownloadToConsumer() download are requested ahead of the next part to deliver. Parts that arrive before
+             * their turn wait in the buffer pool, so this bounds the memory held per download to downloadReadAheadParts * bufferSize.
+             * Kept between 1 and transferBufferMaxHeapSize / bufferSize. Defaults to 8.
+             */
+            size_t downloadReadAheadParts;
+            /**
+             * Multipart uploads from a file name send each part straight out of a shared, read-only memory mapping of the file instead of
+             * reading it into the pooled buffers first. Only set this for files nothing else modifies during the upload: if the file is
+             * truncated while it is mapped, reading the lost pages raises SIGBUS, which terminates the process rather than failing the transfer.
+             * Files that cannot be mapped are read as usual. Defaults to false, each part is then read into its buffer with a positioned read
+             * by the worker that sends it, and a file that shrank only fails the parts it no longer holds.
+             */
+            bool mapUploadFiles;
 
             /**
              * Callback to receive progress updates for uploads.
@@ -163,6 +240,17 @@ namespace Aws
                                                          CreateDownloadStreamCallback writeToStreamfn, 
                                                          const DownloadConfiguration& downloadConfig = DownloadConfiguration());
 
+            /**
+             * Downloads the contents of bucketName/keyName in S3 and delivers it to consumer strictly in order, e.g. to feed a decompressor or a parser.
+             * Parts are fetched in parallel with ranged GetObject requests, at most downloadReadAheadParts ahead of the next part to deliver.
+             * consumer is called from the threads of the S3 client, never concurrently, and should return quickly: parts behind it wait
+             * in the buffer pool. Bytes passed to consumer are not delivered again, RetryDownload() continues from the first part not delivered.
+             */
+            std::shared_ptr<TransferHandle> DownloadToConsumer(const Aws::String& bucketName,
+                                                               const Aws::String& keyName,
+                                                               DownloadConsumerCallback consumer,
+                                                               const DownloadConfiguration& downloadConfig = DownloadConfiguration());
+
             /**
              * Retry an download that failed from a previous DownloadFile operation. If a multi-part download was used, only the failed parts will be re-fetched.
              */
@@ -186,25 +274,46 @@ namespace Aws
 
             /**
              * Uploads entire contents of directory to Amazon S3 bucket and stores them in a directory starting at prefix. This is an asynchronous method. You will receive notifications
-             * that an upload has started via the transferInitiatedCallback callback function in your configuration. If you do not set this callback, then you will not be able to handle
-             * the file transfers.
+             * that an upload has started via the transferInitiatedCallback callback function in your configuration, and the returned object tracks the aggregate progress.
+             * Traversal runs alongside the uploads, at most maxPendingDirectoryTransfers files are in flight at once and small files are uploaded in batches.
              *
              * directory: the absolute directory on disk to upload
              * bucketName: the name of the S3 bucket to upload to
              * prefix: the prefix to put on all objects uploaded (e.g. put them in x directory in the bucket).
              */
-            void UploadDirectory(const Aws::String& directory, const Aws::String& bucketName, const Aws::String& prefix, const Aws::Map<Aws::String, Aws::String>& metadata);
+            std::shared_ptr<DirectoryTransferProgress> UploadDirectory(const Aws::String& directory, const Aws::String& bucketName, const Aws::String& prefix,
+                    const Aws::Map<Aws::String, Aws::String>& metadata);
 
             /**
             * Downloads entire contents of an Amazon S3 bucket starting at prefix stores them in a directory (not including the prefix). This is an asynchronous method. You will receive notifications
-            * that a download has started via the transferInitiatedCallback callback function in your configuration. If you do not set this callback, then you will not be able to handle
-            * the file transfers. If an error occurs prior to the transfer being initiated (e.g. list objects fails, then an error will be passed through the errorCallback).
+            * that a download has started via the transferInitiatedCallback callback function in your configuration, and the returned object tracks the aggregate progress.
+            * If an error occurs prior to the transfer being initiated (e.g. list objects fails, then an error will be passed through the errorCallback).
+            * Listing runs alongside the downloads, a page at a time, at most maxPendingDirectoryTransfers files are in flight at once and small files are downloaded in batches
+            * without a HEAD request.
             *
             * directory: the absolute directory on disk to download to
             * bucketName: the name of the S3 bucket to upload to
             * prefix: the prefix in the bucket to use as the root directory (e.g. download all objects at x prefix in S3 and then store them starting in directory with the prefix stripped out).
             */
-            void DownloadToDirectory(const Aws::String& directory, const Aws::String& bucketName, const Aws::String& prefix = Aws::String());
+            std::shared_ptr<DirectoryTransferProgress> DownloadToDirectory(const Aws::String& directory, const Aws::String& bucketName, const Aws::String& prefix = Aws::String());
+
+            /**
+             * Part size used to upload totalSize bytes. S3 allows at most 10,000 parts per multipart upload, so objects too large to fit in that many parts
+             * of minPartSize get larger parts, rounded up to whole MB.
+             */
+            static uint64_t CalculateUploadPartSize(uint64_t totalSize, uint64_t minPartSize);
+
+            /**
+             * Takes a buffer of at least partSize bytes out of the buffer pool, blocking until there is room for it. Parts larger than bufferSize
+             * trade the ceil(partSize / bufferSize) pooled buffers they stand for, or the whole pool, for one buffer of their own, so memory stays
+             * bounded by transferBufferMaxHeapSize. Give the buffer back with ReleasePartBuffer.
+             */
+            Aws::Utils::Array<uint8_t>* AcquirePartBuffer(uint64_t partSize);
+
+            /**
+             * Returns a buffer taken with AcquirePartBuffer to the pool.
+             */
+            void ReleasePartBuffer(Aws::Utils::Array<uint8_t>* buffer);
 
         private:
             /**
@@ -239,10 +348,41 @@ namespace Aws
             std::shared_ptr<TransferHandle> DoUploadFile(const Aws::String& fileName, const Aws::String& bucketName, const Aws::String& keyName, const Aws::String& contentType, 
                     const Aws::Map<Aws::String, Aws::String>& metadata);
 
+            /**
+             * Creates a handle for downloading to writeToFile, without submitting it.
+             */
+            std::shared_ptr<TransferHandle> CreateDownloadFileHandle(const Aws::String& bucketName, const Aws::String& keyName, const Aws::String& writeToFile);
+            void SubmitDownload(const std::shared_ptr<TransferHandle>& handle);
+
+            /**
+             * Starts files of a directory transfer while it has free slots, discovering more as needed. Runs on the transfer executor, rescheduled
+             * whenever one of its files finishes.
+             */
+            void PumpDirectoryTransfer(const std::shared_ptr<DirectoryTransferState>& state);
+            void ScheduleDirectoryTransfer(const std::shared_ptr<DirectoryTransferState>& state);
+            bool DiscoverUploadFiles(DirectoryTransferState& state);
+            bool DiscoverDownloadFiles(DirectoryTransferState& state);
+            /**
+             * Runs the transfers of small files one after another on a single executor task.
+             */
+            void SubmitDirectoryBatch(const Aws::Vector<std::shared_ptr<TransferHandle>>& batch);
+
             bool MultipartUploadSupported(uint64_t length) const;
             bool InitializePartsForDownload(const std::shared_ptr<TransferHandle>& handle);
 
             void DoMultiPartUpload(Aws::IOStream* streamToPut, const std::shared_ptr<TransferHandle>& handle);
+            /**
+             * Part bodies view their range of mappedFile instead of being read into the pooled buffers. Only used with mapUploadFiles,
+             * see there for the hazard of the file being truncated meanwhile.
+             */
+            void DoMultiPartUpload(const std::shared_ptr<const Aws::FileSystem::MappedFile>& mappedFile, const std::shared_ptr<TransferHandle>& handle);
+            /**
+             * Each part is read from readFile into its buffer when the worker sending it first reads the body, so the parts of the file are
+             * read concurrently and off the thread queuing them.
+             */
+            void DoMultiPartUpload(const std::shared_ptr<const Aws::FileSystem::PositionedReadFile>& readFile, const std::shared_ptr<TransferHandle>& handle);
+            void DoMultiPartUpload(Aws::IOStream* streamToPut, const std::shared_ptr<const Aws::FileSystem::MappedFile>& mappedFile,
+                    const std::shared_ptr<const Aws::FileSystem::PositionedReadFile>& readFile, const std::shared_ptr<TransferHandle>& handle);
             void DoSinglePartUpload(Aws::IOStream* streamToPut, const std::shared_ptr<TransferHandle>& handle);
 
             void DoMultiPartUpload(const std::shared_ptr<TransferHandle>& handle);
@@ -256,11 +396,50 @@ namespace Aws
                                          const Aws::S3::Model::GetObjectOutcome& outcome, 
                                          const std::shared_ptr<const Aws::Client::AsyncCallerContext>& context);
 
+            /**
+             * Requests the queued parts of a streaming download in order, holding back while the read ahead window is full.
+             */
+            void DoStreamingDownload(const std::shared_ptr<TransferHandle>& handle);
+            void HandleStreamingGetObjectResponse(const Aws::S3::Model::GetObjectOutcome& outcome,
+                                                  const std::shared_ptr<const Aws::Client::AsyncCallerContext>& context);
+            /**
+             * Passes the downloaded parts that are next in line to the consumer. Only one thread delivers at a time, others return right away
+             * and leave their part to it. Once the download failed or was canceled, drops the parts waiting instead.
+             */
+            void DeliverDownloadedParts(const std::shared_ptr<TransferHandle>& handle, StreamingDownloadState& state);
+
             void WaitForCancellationAndAbortUpload(const std::shared_ptr<TransferHandle>& canceledHandle);
 
+            /**
+             * Sends CompleteMultipartUpload for the completed parts of handle and updates its status.
+             */
+            void CompleteMultipartUpload(const std::shared_ptr<TransferHandle>& handle);
+            /**
+             * Marks a download whose parts are all written as completed, or failed or canceled if any of them is not.
+             */
+            void CompleteDownload(const std::shared_ptr<TransferHandle>& handle);
+
+            /**
+             * Attaches a TransferJournal to a multipart transfer from or to a file name when journalDirectory is set.
+             */
+            void AttachJournal(const std::shared_ptr<TransferHandle>& handle);
+            /**
+             * Returns the parts of the journal of handle that can be trusted, and rewrites the journal with only those. An upload is resumed
+             * by setting the multipart id of handle, a download by its caller from the returned parts.
+             */
+            Aws::Map<int, TransferJournal::Part> ResumeUploadFromJournal(const std::shared_ptr<TransferHandle>& handle, Aws::IOStream* streamToPut,
+                    const std::shared_ptr<const Aws::FileSystem::MappedFile>& mappedFile, const std::shared_ptr<const Aws::FileSystem::PositionedReadFile>& readFile);
+            Aws::Map<int, TransferJournal::Part> ResumeDownloadFromJournal(const std::shared_ptr<TransferHandle>& handle, const Aws::String& objectETag);
+
             void HandleUploadPartResponse(const Aws::S3::S3Client*, const Aws::S3::Model::UploadPartRequest&, const Aws::S3::Model::UploadPartOutcome&, const std::shared_ptr<const Aws::Client::AsyncCallerContext>&);
             void HandlePutObjectResponse(const Aws::S3::S3Client*, const Aws::S3::Model::PutObjectRequest&, const Aws::S3::Model::PutObjectOutcome&, const std::shared_ptr<const Aws::Client::AsyncCallerContext>&);
-            void HandleListObjectsResponse(const Aws::S3::S3Client*, const Aws::S3::Model::ListObjectsV2Request&, const Aws::S3::Model::ListObjectsV2Outcome&, const std::shared_ptr<const Aws::Client::AsyncCallerContext>&);
+
+            /**
+             * Gate the parts put in flight through m_partConcurrencyTuner when autotunePartConcurrency is set, no-ops otherwise.
+             */
+            void AcquirePartSlot();
+            void ReleasePartSlot(uint64_t bytes, bool succeeded);
+            void CancelPartSlot();
 
             TransferStatus DetermineIfFailedOrCanceled(const TransferHandle&) const;
             void TriggerUploadProgressCallback(const std::shared_ptr<const TransferHandle>&) const;
@@ -270,7 +449,12 @@ namespace Aws
 
             static Aws::String DetermineFilePath(const Aws::String& directory, const Aws::String& prefix, const Aws::String& keyName);
 
+            size_t PooledBuffersFor(uint64_t partSize) const;
+
             Aws::Utils::ExclusiveOwnershipResourceManager<Aws::Utils::Array<uint8_t>*> m_bufferManager;
+            // taken while acquiring several pooled buffers for one part, so two large parts can't each hold half of what the other waits for
+            std::mutex m_largePartBufferLock;
+            std::shared_ptr<PartConcurrencyTuner> m_partConcurrencyTuner;
             TransferManagerConfiguration m_transferConfig;
         };
 
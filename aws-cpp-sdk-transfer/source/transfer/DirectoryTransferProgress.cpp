@@ -0,0 +1,177 @@
+/*
+* Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+*
+* Licensed under the Apache License, Version 2.0 (the "License").
+* You may not use this file except in compliance with the License.
+* A copy of the License is located at
+*
+*  http://aws.amazon.com/apache2.0
+*
+* or in the "license" file accompanying this file. This file is distributed
+* on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+* express or implied. See the License for the specific language governing
+* permissions and limitations under the License.
+*/
+
+#include <aws/transfer/DirectoryTransferProgress.h>
+#include <algorithm>
+
+namespace Aws
+{
+    namespace Transfer
+    {
+        static bool IsTransferFinished(TransferStatus status)
+        {
+            switch (status)
+            {
+                case TransferStatus::NOT_STARTED:
+                case TransferStatus::IN_PROGRESS:
+                    return false;
+                default:
+                    return true;
+            }
+        }
+
+        DirectoryTransferProgress::DirectoryTransferProgress(size_t maxPendingTransfers) :
+            m_maxPendingTransfers((std::max)(static_cast<size_t>(1), maxPendingTransfers)),
+            m_startTime(std::chrono::steady_clock::now()),
+            m_filesDiscovered(0),
+            m_bytesDiscovered(0),
+            m_listingComplete(false),
+            m_filesCompleted(0),
+            m_filesFailed(0),
+            m_bytesCompleted(0)
+        {
+        }
+
+        size_t DirectoryTransferProgress::GetFilesDiscovered() const
+        {
+            std::lock_guard<std::mutex> lock(m_lock);
+            return m_filesDiscovered;
+        }
+
+        uint64_t DirectoryTransferProgress::GetBytesDiscovered() const
+        {
+            std::lock_guard<std::mutex> lock(m_lock);
+            return m_bytesDiscovered;
+        }
+
+        size_t DirectoryTransferProgress::GetFilesInFlight() const
+        {
+            std::lock_guard<std::mutex> lock(m_lock);
+            SweepFinishedTransfers();
+            return m_inFlight.size();
+        }
+
+        size_t DirectoryTransferProgress::GetFilesCompleted() const
+        {
+            std::lock_guard<std::mutex> lock(m_lock);
+            SweepFinishedTransfers();
+            return m_filesCompleted;
+        }
+
+        size_t DirectoryTransferProgress::GetFilesFailed() const
+        {
+            std::lock_guard<std::mutex> lock(m_lock);
+            SweepFinishedTransfers();
+            return m_filesFailed;
+        }
+
+        uint64_t DirectoryTransferProgress::GetBytesTransferred() const
+        {
+            std::lock_guard<std::mutex> lock(m_lock);
+            SweepFinishedTransfers();
+            uint64_t bytesTransferred = m_bytesCompleted;
+            for (const auto& handle : m_inFlight)
+            {
+                bytesTransferred += handle->GetBytesTransferred();
+            }
+            return bytesTransferred;
+        }
+
+        double DirectoryTransferProgress::GetThroughput() const
+        {
+            double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - m_startTime).count();
+            return seconds > 0 ? GetBytesTransferred() / seconds : 0;
+        }
+
+        bool DirectoryTransferProgress::IsListingComplete() const
+        {
+            std::lock_guard<std::mutex> lock(m_lock);
+            return m_listingComplete;
+        }
+
+        bool DirectoryTransferProgress::IsFinished() const
+        {
+            std::lock_guard<std::mutex> lock(m_lock);
+            SweepFinishedTransfers();
+            return m_listingComplete && m_inFlight.empty();
+        }
+
+        void DirectoryTransferProgress::WaitUntilFinished() const
+        {
+            std::unique_lock<std::mutex> lock(m_lock);
+            m_finishedSignal.wait(lock, [this] { SweepFinishedTransfers(); return m_listingComplete && m_inFlight.empty(); });
+        }
+
+        void DirectoryTransferProgress::AddDiscoveredFile(uint64_t sizeInBytes)
+        {
+            std::lock_guard<std::mutex> lock(m_lock);
+            ++m_filesDiscovered;
+            m_bytesDiscovered += sizeInBytes;
+        }
+
+        bool DirectoryTransferProgress::HasFreeSlot() const
+        {
+            std::lock_guard<std::mutex> lock(m_lock);
+            SweepFinishedTransfers();
+            return m_inFlight.size() < m_maxPendingTransfers;
+        }
+
+        void DirectoryTransferProgress::AddTransfer(const std::shared_ptr<TransferHandle>& handle)
+        {
+            std::lock_guard<std::mutex> lock(m_lock);
+            m_inFlight.push_back(handle);
+        }
+
+        void DirectoryTransferProgress::SetListingComplete()
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_lock);
+                m_listingComplete = true;
+            }
+            m_finishedSignal.notify_all();
+        }
+
+        void DirectoryTransferProgress::NotifyTransferFinished()
+        {
+            // sweeping under the lock orders this with a waiter that has just swept and is about to wait
+            {
+                std::lock_guard<std::mutex> lock(m_lock);
+                SweepFinishedTransfers();
+            }
+            m_finishedSignal.notify_all();
+        }
+
+        void DirectoryTransferProgress::SweepFinishedTransfers() const
+        {
+            auto finished = std::partition(m_inFlight.begin(), m_inFlight.end(),
+                    [](const std::shared_ptr<TransferHandle>& handle) { return !IsTransferFinished(handle->GetStatus()); });
+
+            for (auto iter = finished; iter != m_inFlight.end(); ++iter)
+            {
+                auto status = (*iter)->GetStatus();
+                if (status == TransferStatus::COMPLETED || status == TransferStatus::EXACT_OBJECT_ALREADY_EXISTS)
+                {
+                    ++m_filesCompleted;
+                    m_bytesCompleted += (*iter)->GetBytesTotalSize();
+                }
+                else
+                {
+                    ++m_filesFailed;
+                }
+            }
+            m_inFlight.erase(finished, m_inFlight.end());
+        }
+    }
+}
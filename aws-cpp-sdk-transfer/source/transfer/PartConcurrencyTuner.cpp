@@ -0,0 +1,133 @@
+/*
+* Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+*
+* Licensed under the Apache License, Version 2.0 (the "License").
+* You may not use this file except in compliance with the License.
+* A copy of the License is located at
+*
+*  http://aws.amazon.com/apache2.0
+*
+* or in the "license" file accompanying this file. This file is distributed
+* on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+* express or implied. See the License for the specific language governing
+* permissions and limitations under the License.
+*/
+
+#include <aws/transfer/PartConcurrencyTuner.h>
+#include <aws/core/utils/logging/LogMacros.h>
+#include <algorithm>
+#include <cassert>
+
+namespace Aws
+{
+    namespace Transfer
+    {
+        static const char* const CLASS_TAG = "PartConcurrencyTuner";
+
+        // a window has to beat the previous one by this much for another step in the same direction
+        static const double IMPROVEMENT_THRESHOLD = 1.05;
+
+        PartConcurrencyTuner::PartConcurrencyTuner(size_t initialParts, size_t maxParts) :
+            m_limit((std::max)(static_cast<size_t>(1), (std::min)(initialParts, maxParts))),
+            m_maxParts((std::max)(static_cast<size_t>(1), maxParts)),
+            m_inFlight(0),
+            m_direction(1),
+            m_lastThroughput(0),
+            m_windowBytes(0),
+            m_windowParts(0)
+        {
+            StartWindow(std::chrono::steady_clock::now());
+        }
+
+        void PartConcurrencyTuner::AcquirePart()
+        {
+            AcquirePart(std::chrono::steady_clock::now());
+        }
+
+        void PartConcurrencyTuner::AcquirePart(std::chrono::steady_clock::time_point now)
+        {
+            std::unique_lock<std::mutex> lock(m_lock);
+            m_partReleased.wait(lock, [this] { return m_inFlight < m_limit; });
+
+            // idle time between transfers says nothing about the limit, don't let it into the window
+            if (m_inFlight == 0)
+            {
+                StartWindow(now);
+            }
+            ++m_inFlight;
+        }
+
+        void PartConcurrencyTuner::ReleasePart(uint64_t bytes, bool succeeded)
+        {
+            ReleasePart(bytes, succeeded, std::chrono::steady_clock::now());
+        }
+
+        void PartConcurrencyTuner::ReleasePart(uint64_t bytes, bool succeeded, std::chrono::steady_clock::time_point now)
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_lock);
+                assert(m_inFlight > 0);
+                --m_inFlight;
+
+                if (!succeeded)
+                {
+                    m_limit = (std::max)(static_cast<size_t>(1), m_limit / 2);
+                    m_direction = 1;
+                    m_lastThroughput = 0;
+                    StartWindow(now);
+                    AWS_LOGSTREAM_DEBUG(CLASS_TAG, "Part failed, parts in flight limited to " << m_limit);
+                }
+                else
+                {
+                    m_windowBytes += bytes;
+                    if (++m_windowParts >= m_limit)
+                    {
+                        double seconds = std::chrono::duration<double>(now - m_windowStart).count();
+                        double throughput = seconds > 0 ? m_windowBytes / seconds : 0;
+
+                        if (m_lastThroughput > 0 && throughput <= m_lastThroughput * IMPROVEMENT_THRESHOLD)
+                        {
+                            m_direction = -m_direction;
+                        }
+
+                        size_t limit = m_direction > 0 ? m_limit + 1 : m_limit - 1;
+                        m_limit = (std::max)(static_cast<size_t>(1), (std::min)(limit, m_maxParts));
+                        m_lastThroughput = throughput;
+                        StartWindow(now);
+                        AWS_LOGSTREAM_TRACE(CLASS_TAG, "Window throughput " << throughput << " bytes/s, parts in flight limited to " << m_limit);
+                    }
+                }
+            }
+            m_partReleased.notify_all();
+        }
+
+        void PartConcurrencyTuner::CancelPart()
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_lock);
+                assert(m_inFlight > 0);
+                --m_inFlight;
+            }
+            m_partReleased.notify_all();
+        }
+
+        size_t PartConcurrencyTuner::GetLimit() const
+        {
+            std::lock_guard<std::mutex> lock(m_lock);
+            return m_limit;
+        }
+
+        size_t PartConcurrencyTuner::GetInFlight() const
+        {
+            std::lock_guard<std::mutex> lock(m_lock);
+            return m_inFlight;
+        }
+
+        void PartConcurrencyTuner::StartWindow(std::chrono::steady_clock::time_point now)
+        {
+            m_windowStart = now;
+            m_windowBytes = 0;
+            m_windowParts = 0;
+        }
+    }
+}
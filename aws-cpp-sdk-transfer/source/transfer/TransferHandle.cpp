@@ -14,6 +14,7 @@
 */
 
 #include <aws/transfer/TransferHandle.h>
+#include <aws/core/platform/FileSystem.h>
 
 #include <cassert>
 
@@ -21,6 +22,7 @@ namespace Aws
 {
     namespace Transfer
     {
+        static const char* CLASS_TAG = "TransferHandle";
 
         PartState::PartState() :
             m_partId(0),
@@ -81,7 +83,8 @@ namespace Aws
             m_status(TransferStatus::NOT_STARTED), 
             m_cancel(false),
             m_createDownloadStreamFn(), 
-            m_downloadStream(nullptr)
+            m_downloadStream(nullptr),
+            m_downloadFile(nullptr)
         {}
 
         TransferHandle::TransferHandle(const Aws::String& bucketName, const Aws::String& keyName, const Aws::String& targetFilePath) :
@@ -97,7 +100,8 @@ namespace Aws
             m_status(TransferStatus::NOT_STARTED), 
             m_cancel(false),
             m_createDownloadStreamFn(), 
-            m_downloadStream(nullptr)
+            m_downloadStream(nullptr),
+            m_downloadFile(nullptr)
         {}
 
         TransferHandle::TransferHandle(const Aws::String& bucketName, const Aws::String& keyName, CreateDownloadStreamCallback createDownloadStreamFn) :
@@ -113,7 +117,26 @@ namespace Aws
             m_status(TransferStatus::NOT_STARTED), 
             m_cancel(false),
             m_createDownloadStreamFn(createDownloadStreamFn), 
-            m_downloadStream(nullptr)
+            m_downloadStream(nullptr),
+            m_downloadFile(nullptr)
+        {}
+
+        TransferHandle::TransferHandle(const Aws::String& bucketName, const Aws::String& keyName, const Aws::String& targetFilePath,
+                CreateDownloadStreamCallback createDownloadStreamFn) :
+            m_isMultipart(false),
+            m_direction(TransferDirection::DOWNLOAD),
+            m_bytesTransferred(0),
+            m_lastPart(false),
+            m_bytesTotalSize(0),
+            m_bucket(bucketName),
+            m_key(keyName),
+            m_fileName(targetFilePath),
+            m_versionId(""),
+            m_status(TransferStatus::NOT_STARTED),
+            m_cancel(false),
+            m_createDownloadStreamFn(createDownloadStreamFn),
+            m_downloadStream(nullptr),
+            m_downloadFile(nullptr)
         {}
 
         TransferHandle::~TransferHandle()
@@ -246,6 +269,7 @@ namespace Aws
             std::unique_lock<std::mutex> semaphoreLock(m_statusLock);
             if(IsTransitionAllowed(m_status, value))
             {
+                bool wasFinished = IsFinishedStatus(m_status);
                 m_status = value;
 
                 if (IsFinishedStatus(value))
@@ -257,6 +281,11 @@ namespace Aws
 
                     semaphoreLock.unlock();
                     m_waitUntilFinishedSignal.notify_all();
+
+                    if (!wasFinished && m_finishedCallback)
+                    {
+                        m_finishedCallback();
+                    }
                 }
             }
         }
@@ -302,6 +331,41 @@ namespace Aws
             m_downloadStream->flush();
         }
 
+        bool TransferHandle::OpenDownloadFile(uint64_t preallocateSize, bool keepContents)
+        {
+            std::lock_guard<std::mutex> lock(m_downloadStreamLock);
+
+            if(m_downloadFile == nullptr)
+            {
+                m_downloadFile = Aws::New<Aws::FileSystem::PositionedWriteFile>(CLASS_TAG, m_fileName.c_str(), !keepContents);
+                if(!*m_downloadFile)
+                {
+                    Aws::Delete(m_downloadFile);
+                    m_downloadFile = nullptr;
+                    return false;
+                }
+
+                if(preallocateSize > 0)
+                {
+                    return m_downloadFile->Preallocate(preallocateSize);
+                }
+            }
+
+            return true;
+        }
+
+        bool TransferHandle::WritePartToDownloadFile(const unsigned char* data, std::size_t length, uint64_t writeOffset)
+        {
+            // the file is opened before any part is requested, so no lock is needed here
+            assert(m_downloadFile);
+            return m_downloadFile->WriteAt(data, length, writeOffset);
+        }
+
+        bool TransferHandle::SyncDownloadFile()
+        {
+            return m_downloadFile && m_downloadFile->Sync();
+        }
+
         void TransferHandle::ApplyDownloadConfiguration(const DownloadConfiguration& downloadConfig)
         {
             SetVersionId(downloadConfig.versionId);
@@ -315,6 +379,12 @@ namespace Aws
                 Aws::Delete(m_downloadStream);
                 m_downloadStream = nullptr;
             }
+
+            if(m_downloadFile)
+            {
+                Aws::Delete(m_downloadFile);
+                m_downloadFile = nullptr;
+            }
         }
 
         TransferStatus TransferHandle::GetStatus() const
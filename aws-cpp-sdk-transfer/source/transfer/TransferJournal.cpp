@@ -0,0 +1,269 @@
+/*
+* Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+*
+* Licensed under the Apache License, Version 2.0 (the "License").
+* You may not use this file except in compliance with the License.
+* A copy of the License is located at
+*
+*  http://aws.amazon.com/apache2.0
+*
+* or in the "license" file accompanying this file. This file is distributed
+* on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+* express or implied. See the License for the specific language governing
+* permissions and limitations under the License.
+*/
+
+#include <aws/transfer/TransferJournal.h>
+#include <aws/core/platform/FileSystem.h>
+#include <aws/core/utils/HashingUtils.h>
+#include <aws/core/utils/StringUtils.h>
+#include <aws/core/utils/crypto/Crc32.h>
+#include <aws/core/utils/memory/AWSMemory.h>
+#include <aws/core/utils/memory/stl/AWSStringStream.h>
+#include <aws/core/utils/memory/stl/AWSVector.h>
+#include <fstream>
+#include <cstdlib>
+
+namespace Aws
+{
+    namespace Transfer
+    {
+        static const char* CLASS_TAG = "TransferJournal";
+        static const char* HEADER_RECORD = "transfer";
+        static const char* PART_RECORD = "part";
+
+        static const char* DirectionToString(TransferDirection direction)
+        {
+            return direction == TransferDirection::UPLOAD ? "UPLOAD" : "DOWNLOAD";
+        }
+
+        static Aws::String EncodeField(const Aws::String& field)
+        {
+            return Aws::Utils::StringUtils::URLEncode(field.c_str());
+        }
+
+        static Aws::String DecodeField(const Aws::String& field)
+        {
+            return Aws::Utils::StringUtils::URLDecode(field.c_str());
+        }
+
+        static bool ParseUnsigned(const Aws::String& field, uint64_t& value)
+        {
+            if (field.empty() || field[0] < '0' || field[0] > '9')
+            {
+                return false;
+            }
+
+            char* end = nullptr;
+            value = static_cast<uint64_t>(std::strtoull(field.c_str(), &end, 10));
+            return *end == '\0';
+        }
+
+        // unlike StringUtils::Split, keeps empty fields
+        static Aws::Vector<Aws::String> SplitFields(const Aws::String& line)
+        {
+            Aws::Vector<Aws::String> fields;
+            Aws::StringStream lineStream(line);
+            Aws::String field;
+            while (std::getline(lineStream, field, ' '))
+            {
+                fields.push_back(field);
+            }
+            if (!line.empty() && line.back() == ' ')
+            {
+                fields.push_back("");
+            }
+            return fields;
+        }
+
+        static Aws::OFStream* OpenForWriting(const Aws::String& path, std::ios_base::openmode mode)
+        {
+#ifdef _MSC_VER
+            return Aws::New<Aws::OFStream>(CLASS_TAG, Aws::Utils::StringUtils::ToWString(path.c_str()).c_str(), mode | std::ios_base::binary);
+#else
+            return Aws::New<Aws::OFStream>(CLASS_TAG, path.c_str(), mode | std::ios_base::binary);
+#endif
+        }
+
+        TransferJournal::TransferJournal(const Aws::String& journalDirectory, TransferDirection direction, const Aws::String& bucketName,
+                const Aws::String& keyName, const Aws::String& filePath) :
+            m_direction(direction),
+            m_bucketName(bucketName),
+            m_keyName(keyName),
+            m_filePath(filePath),
+            m_hasTransfer(false),
+            m_bytesTotalSize(0),
+            m_partSize(0),
+            m_stream(nullptr)
+        {
+            Aws::StringStream identity;
+            identity << DirectionToString(direction) << '\n' << bucketName << '\n' << keyName << '\n' << filePath;
+            auto name = Aws::Utils::HashingUtils::HexEncode(Aws::Utils::HashingUtils::CalculateSHA256(identity.str())) + ".journal";
+            m_path = Aws::FileSystem::Join(journalDirectory, name);
+
+            Read();
+        }
+
+        TransferJournal::~TransferJournal()
+        {
+            Aws::Delete(m_stream);
+        }
+
+        void TransferJournal::Read()
+        {
+#ifdef _MSC_VER
+            Aws::IFStream journalStream(Aws::Utils::StringUtils::ToWString(m_path.c_str()).c_str(), std::ios_base::in | std::ios_base::binary);
+#else
+            Aws::IFStream journalStream(m_path.c_str(), std::ios_base::in | std::ios_base::binary);
+#endif
+            if (!journalStream.good())
+            {
+                return;
+            }
+
+            Aws::StringStream contents;
+            contents << journalStream.rdbuf();
+            Aws::String journal = contents.str();
+
+            // only whole lines count, the last one may have been cut short by a crash. Replay stops at the first line that does not parse.
+            size_t lineBegin = 0;
+            size_t lineEnd = journal.find('\n');
+            while (lineEnd != Aws::String::npos && ParseLine(journal.substr(lineBegin, lineEnd - lineBegin)))
+            {
+                lineBegin = lineEnd + 1;
+                lineEnd = journal.find('\n', lineBegin);
+            }
+        }
+
+        bool TransferJournal::ParseLine(const Aws::String& line)
+        {
+            auto fields = SplitFields(line);
+            if (fields.empty())
+            {
+                return false;
+            }
+
+            if (!m_hasTransfer)
+            {
+                // the header must describe this very transfer, a journal left by another one is ignored
+                uint64_t bytesTotalSize = 0, partSize = 0;
+                if (fields.size() != 9 || fields[0] != HEADER_RECORD || fields[1] != DirectionToString(m_direction) ||
+                    DecodeField(fields[2]) != m_bucketName || DecodeField(fields[3]) != m_keyName || DecodeField(fields[4]) != m_filePath ||
+                    !ParseUnsigned(fields[5], bytesTotalSize) || !ParseUnsigned(fields[6], partSize) || partSize == 0)
+                {
+                    return false;
+                }
+
+                m_bytesTotalSize = bytesTotalSize;
+                m_partSize = partSize;
+                m_multipartId = DecodeField(fields[7]);
+                m_objectETag = DecodeField(fields[8]);
+                m_hasTransfer = true;
+                return true;
+            }
+
+            uint64_t partId = 0, checksum = 0;
+            Part part;
+            if (fields.size() != 6 || fields[0] != PART_RECORD || !ParseUnsigned(fields[1], partId) || partId == 0 ||
+                !ParseUnsigned(fields[2], part.rangeBegin) || !ParseUnsigned(fields[3], part.sizeInBytes) || !ParseUnsigned(fields[5], checksum) ||
+                part.rangeBegin + part.sizeInBytes > m_bytesTotalSize)
+            {
+                return false;
+            }
+
+            part.partId = static_cast<int>(partId);
+            part.eTag = DecodeField(fields[4]);
+            part.checksum = static_cast<uint32_t>(checksum);
+            m_completedParts[part.partId] = part;
+            return true;
+        }
+
+        Aws::String TransferJournal::FormatHeader() const
+        {
+            Aws::StringStream header;
+            header << HEADER_RECORD << ' ' << DirectionToString(m_direction) << ' ' << EncodeField(m_bucketName) << ' ' << EncodeField(m_keyName)
+                << ' ' << EncodeField(m_filePath) << ' ' << m_bytesTotalSize << ' ' << m_partSize << ' ' << EncodeField(m_multipartId)
+                << ' ' << EncodeField(m_objectETag) << '\n';
+            return header.str();
+        }
+
+        Aws::String TransferJournal::FormatPart(const Part& part)
+        {
+            Aws::StringStream record;
+            record << PART_RECORD << ' ' << part.partId << ' ' << part.rangeBegin << ' ' << part.sizeInBytes << ' ' << EncodeField(part.eTag)
+                << ' ' << part.checksum << '\n';
+            return record.str();
+        }
+
+        bool TransferJournal::Rewrite(uint64_t bytesTotalSize, uint64_t partSize, const Aws::String& multipartId, const Aws::String& objectETag,
+                const Aws::Map<int, Part>& completedParts)
+        {
+            std::lock_guard<std::mutex> locker(m_lock);
+            Aws::Delete(m_stream);
+            m_stream = nullptr;
+
+            m_bytesTotalSize = bytesTotalSize;
+            m_partSize = partSize;
+            m_multipartId = multipartId;
+            m_objectETag = objectETag;
+            m_completedParts = completedParts;
+            m_hasTransfer = true;
+
+            // written aside and moved over the journal, so a crash leaves either the old journal or the new one
+            Aws::String tempPath = m_path + ".tmp";
+            auto tempStream = OpenForWriting(tempPath, std::ios_base::out | std::ios_base::trunc);
+            *tempStream << FormatHeader();
+            for (const auto& part : completedParts)
+            {
+                *tempStream << FormatPart(part.second);
+            }
+            tempStream->flush();
+            bool written = tempStream->good();
+            Aws::Delete(tempStream);
+
+#ifdef _MSC_VER
+            // MoveFile does not replace an existing file
+            Aws::FileSystem::RemoveFileIfExists(m_path.c_str());
+#endif
+            if (!written || !Aws::FileSystem::RelocateFileOrDirectory(tempPath.c_str(), m_path.c_str()))
+            {
+                Aws::FileSystem::RemoveFileIfExists(tempPath.c_str());
+                return false;
+            }
+
+            m_stream = OpenForWriting(m_path, std::ios_base::out | std::ios_base::app);
+            return m_stream->good();
+        }
+
+        bool TransferJournal::RecordCompletedPart(const Part& part)
+        {
+            auto record = FormatPart(part);
+
+            std::lock_guard<std::mutex> locker(m_lock);
+            if (m_stream == nullptr)
+            {
+                return false;
+            }
+
+            // one write per line, so concurrent parts never interleave and a crash leaves at most one partial line
+            m_stream->write(record.c_str(), static_cast<std::streamsize>(record.size()));
+            m_stream->flush();
+            return m_stream->good();
+        }
+
+        void TransferJournal::Remove()
+        {
+            std::lock_guard<std::mutex> locker(m_lock);
+            Aws::Delete(m_stream);
+            m_stream = nullptr;
+            m_hasTransfer = false;
+            m_completedParts.clear();
+            Aws::FileSystem::RemoveFileIfExists(m_path.c_str());
+        }
+
+        uint32_t TransferJournal::CalculateChecksum(uint32_t checksum, const unsigned char* data, size_t length)
+        {
+            return Aws::Utils::Crypto::Crc32::Checksum(checksum, data, length);
+        }
+    }
+}
@@ -20,12 +20,14 @@
 #include <aws/core/utils/memory/stl/AWSStringStream.h>
 #include <aws/core/utils/HashingUtils.h>
 #include <aws/core/platform/FileSystem.h>
+#include <aws/core/utils/memory/stl/AWSQueue.h>
 #include <aws/s3/S3Client.h>
 #include <aws/s3/model/HeadObjectRequest.h>
 #include <aws/s3/model/GetObjectRequest.h>
 #include <aws/s3/model/ListObjectsV2Request.h>
 #include <aws/s3/model/CompleteMultipartUploadRequest.h>
 #include <aws/s3/model/AbortMultipartUploadRequest.h>
+#include <aws/s3/model/ListPartsRequest.h>
 #include <fstream>
 #include <algorithm>
 
@@ -36,16 +38,146 @@ namespace Aws
     namespace Transfer
     {
         static const char* const CLASS_TAG = "Aws::Transfer::TransferManager";
+
+        struct StreamingDownloadState
+        {
+            StreamingDownloadState(int firstPart, size_t readAhead) :
+                nextPart(firstPart),
+                readAheadParts(readAhead),
+                delivering(false),
+                failed(false)
+            {}
+
+            std::mutex lock;
+            std::condition_variable partDelivered;
+            // id of the next part to pass to the consumer
+            int nextPart;
+            size_t readAheadParts;
+            bool delivering;
+            bool failed;
+            // parts that arrived ahead of nextPart, each still holding its pooled buffer
+            Aws::Map<int, PartPointer> downloadedParts;
+        };
+
+        // the body of a part uploaded from a file. The part is read into its buffer the first time the body is read or seeked, i.e. by
+        // the worker sending it, and not by the thread queuing the parts.
+        class PartReadStreamBuf : public Aws::Utils::Stream::PreallocatedStreamBuf
+        {
+        public:
+            PartReadStreamBuf(const std::shared_ptr<const Aws::FileSystem::PositionedReadFile>& file, uint64_t offset,
+                    Aws::Utils::Array<uint8_t>* buffer, size_t length) :
+                PreallocatedStreamBuf(buffer, length), m_file(file), m_offset(offset), m_length(length), m_state(ReadState::PENDING)
+            {
+                setg(eback(), eback(), eback());
+            }
+
+            /**
+             * Reads the part into the buffer unless that was done already. Returns whether the buffer holds the part.
+             */
+            bool Read()
+            {
+                if (m_state == ReadState::PENDING)
+                {
+                    m_state = m_file->ReadAt(GetBuffer()->GetUnderlyingData(), m_length, m_offset) ? ReadState::READ : ReadState::FAILED;
+                    if (m_state == ReadState::READ)
+                    {
+                        PreallocatedStreamBuf::seekpos(0, std::ios_base::in);
+                    }
+                }
+
+                return m_state == ReadState::READ;
+            }
+
+            bool ReadFailed() const { return m_state == ReadState::FAILED; }
+
+        protected:
+            int_type underflow() override
+            {
+                // once read, the whole part is in the get area
+                if (m_state != ReadState::PENDING || !Read() || gptr() == egptr())
+                {
+                    return traits_type::eof();
+                }
+
+                return traits_type::to_int_type(*gptr());
+            }
+
+            pos_type seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which) override
+            {
+                return Read() ? PreallocatedStreamBuf::seekoff(off, dir, which) : pos_type(off_type(-1));
+            }
+
+            pos_type seekpos(pos_type pos, std::ios_base::openmode which) override
+            {
+                return Read() ? PreallocatedStreamBuf::seekpos(pos, which) : pos_type(off_type(-1));
+            }
+
+        private:
+            enum class ReadState
+            {
+                PENDING,
+                READ,
+                FAILED
+            };
+
+            std::shared_ptr<const Aws::FileSystem::PositionedReadFile> m_file;
+            uint64_t m_offset;
+            size_t m_length;
+            ReadState m_state;
+        };
+
         struct TransferHandleAsyncContext : public Aws::Client::AsyncCallerContext
         {
+            TransferHandleAsyncContext() : buffer(nullptr), partReader(nullptr), checksum(0) {}
+
             std::shared_ptr<TransferHandle> handle;
             PartPointer partState;
+            // uploads: the buffer taken with AcquirePartBuffer while the part is in flight, and the mapped file its body views, if any
+            Aws::Utils::Array<uint8_t>* buffer;
+            std::shared_ptr<const Aws::FileSystem::MappedFile> mappedFile;
+            // uploads from a file read by the sending worker: the body of the part, its checksum is taken once it was sent
+            PartReadStreamBuf* partReader;
+            // journaled uploads: the checksum of the part's data
+            uint32_t checksum;
+            std::shared_ptr<StreamingDownloadState> streamingState;
+        };
+
+        // small files of a directory transfer are run this many at a time on one executor task
+        static const size_t DIRECTORY_BATCH_SIZE = 8;
+
+        struct DirectoryFile
+        {
+            Aws::String path;
+            Aws::String key;
+            uint64_t sizeInBytes;
         };
 
-        struct DownloadDirectoryContext : public Aws::Client::AsyncCallerContext
+        struct DirectoryTransferState
         {
-            Aws::String rootDirectory;
+            DirectoryTransferState(TransferDirection transferDirection, size_t maxPendingTransfers) :
+                direction(transferDirection),
+                progress(Aws::MakeShared<DirectoryTransferProgress>(CLASS_TAG, maxPendingTransfers)),
+                pumpScheduled(false),
+                discoveryComplete(false)
+            {}
+
+            TransferDirection direction;
+            Aws::String directory;
+            Aws::String bucketName;
             Aws::String prefix;
+            Aws::Map<Aws::String, Aws::String> metadata;
+            std::shared_ptr<DirectoryTransferProgress> progress;
+
+            std::atomic<bool> pumpScheduled;
+            std::mutex pumpLock;
+            bool discoveryComplete;
+            // discovered and not started yet
+            Aws::Queue<DirectoryFile> discoveredFiles;
+            // uploads: the directories being traversed, innermost last
+            Aws::Vector<std::shared_ptr<Aws::FileSystem::Directory>> openDirectories;
+            // downloads: the prefixes left to list, the first one is being listed from continuationToken
+            Aws::Queue<Aws::String> prefixesToList;
+            Aws::String continuationToken;
         };
 
         std::shared_ptr<TransferManager> TransferManager::Create(const TransferManagerConfiguration& config)
@@ -68,6 +200,12 @@ namespace Aws
             {
                 m_bufferManager.PutResource(Aws::New<Aws::Utils::Array<uint8_t>>(CLASS_TAG, static_cast<size_t>(m_transferConfig.bufferSize)));
             }
+
+            if (m_transferConfig.autotunePartConcurrency)
+            {
+                size_t maxParts = static_cast<size_t>(m_transferConfig.transferBufferMaxHeapSize / m_transferConfig.bufferSize);
+                m_partConcurrencyTuner = Aws::MakeShared<PartConcurrencyTuner>(CLASS_TAG, m_transferConfig.maxParallelTransfers, maxParts);
+            }
         }
 
         TransferManager::~TransferManager()
@@ -98,8 +236,7 @@ namespace Aws
             auto handle = Aws::MakeShared<TransferHandle>(CLASS_TAG, bucketName, keyName, writeToStreamfn);
             handle->ApplyDownloadConfiguration(downloadConfig);
 
-            auto self = shared_from_this();
-            m_transferConfig.transferExecutor->Submit([self, handle] { self->DoDownload(handle); });
+            SubmitDownload(handle);
             return handle;
         }
 
@@ -108,6 +245,28 @@ namespace Aws
                                                                       const Aws::String& writeToFile, 
                                                                       const DownloadConfiguration& downloadConfig)
         {
+            auto handle = CreateDownloadFileHandle(bucketName, keyName, writeToFile);
+            handle->ApplyDownloadConfiguration(downloadConfig);
+
+            SubmitDownload(handle);
+            return handle;
+        }
+
+        std::shared_ptr<TransferHandle> TransferManager::DownloadToConsumer(const Aws::String& bucketName,
+                                                                            const Aws::String& keyName,
+                                                                            DownloadConsumerCallback consumer,
+                                                                            const DownloadConfiguration& downloadConfig)
+        {
+            auto handle = Aws::MakeShared<TransferHandle>(CLASS_TAG, bucketName, keyName);
+            handle->SetDownloadConsumer(consumer);
+            handle->ApplyDownloadConfiguration(downloadConfig);
+
+            SubmitDownload(handle);
+            return handle;
+        }
+
+        std::shared_ptr<TransferHandle> TransferManager::CreateDownloadFileHandle(const Aws::String& bucketName, const Aws::String& keyName, const Aws::String& writeToFile)
+        {
 #ifdef _MSC_VER
             auto createFileFn = [=]() { return Aws::New<Aws::FStream>(CLASS_TAG, Aws::Utils::StringUtils::ToWString(writeToFile.c_str()).c_str(),
                                                                      std::ios_base::out | std::ios_base::in | std::ios_base::binary | std::ios_base::trunc);};
@@ -116,12 +275,13 @@ namespace Aws
                                                                      std::ios_base::out | std::ios_base::in | std::ios_base::binary | std::ios_base::trunc);};
 #endif
 
-            auto handle = Aws::MakeShared<TransferHandle>(CLASS_TAG, bucketName, keyName, createFileFn);
-            handle->ApplyDownloadConfiguration(downloadConfig);
+            return Aws::MakeShared<TransferHandle>(CLASS_TAG, bucketName, keyName, writeToFile, createFileFn);
+        }
 
+        void TransferManager::SubmitDownload(const std::shared_ptr<TransferHandle>& handle)
+        {
             auto self = shared_from_this();
             m_transferConfig.transferExecutor->Submit([self, handle] { self->DoDownload(handle); });
-            return handle;
         }
 
         std::shared_ptr<TransferHandle> TransferManager::RetryUpload(const Aws::String& fileName, const std::shared_ptr<TransferHandle>& retryHandle)
@@ -171,56 +331,307 @@ namespace Aws
             m_transferConfig.transferExecutor->Submit([self, inProgressHandle] { self->WaitForCancellationAndAbortUpload(inProgressHandle); });
         }
 
-        void TransferManager::UploadDirectory(const Aws::String& directory, const Aws::String& bucketName, const Aws::String& prefix, const Aws::Map<Aws::String, Aws::String>& metadata)
+        std::shared_ptr<DirectoryTransferProgress> TransferManager::UploadDirectory(const Aws::String& directory, const Aws::String& bucketName, const Aws::String& prefix,
+                const Aws::Map<Aws::String, Aws::String>& metadata)
         {
-            assert(m_transferConfig.transferInitiatedCallback);
+            auto state = Aws::MakeShared<DirectoryTransferState>(CLASS_TAG, TransferDirection::UPLOAD, m_transferConfig.maxPendingDirectoryTransfers);
+            state->directory = directory;
+            state->bucketName = bucketName;
+            state->prefix = prefix;
+            state->metadata = metadata;
+
+            auto root = Aws::FileSystem::OpenDirectory(directory);
+            if (*root)
+            {
+                state->openDirectories.push_back(root);
+            }
 
-            auto self = shared_from_this();
-            auto visitor = [self, bucketName, prefix, metadata](const Aws::FileSystem::DirectoryTree*, const Aws::FileSystem::DirectoryEntry& entry)
+            ScheduleDirectoryTransfer(state);
+            return state->progress;
+        }
+
+        std::shared_ptr<DirectoryTransferProgress> TransferManager::DownloadToDirectory(const Aws::String& directory, const Aws::String& bucketName, const Aws::String& prefix)
+        {
+            Aws::FileSystem::CreateDirectoryIfNotExists(directory.c_str());
+
+            auto state = Aws::MakeShared<DirectoryTransferState>(CLASS_TAG, TransferDirection::DOWNLOAD, m_transferConfig.maxPendingDirectoryTransfers);
+            state->directory = directory;
+            state->bucketName = bucketName;
+            state->prefix = prefix;
+            state->prefixesToList.push(prefix);
+
+            ScheduleDirectoryTransfer(state);
+            return state->progress;
+        }
+
+        void TransferManager::ScheduleDirectoryTransfer(const std::shared_ptr<DirectoryTransferState>& state)
+        {
+            // one pending pump is enough, it starts as many files as there are free slots
+            if (!state->pumpScheduled.exchange(true))
+            {
+                auto self = shared_from_this();
+                m_transferConfig.transferExecutor->Submit([self, state] { self->PumpDirectoryTransfer(state); });
+            }
+        }
+
+        void TransferManager::PumpDirectoryTransfer(const std::shared_ptr<DirectoryTransferState>& state)
+        {
+            std::lock_guard<std::mutex> locker(state->pumpLock);
+            state->pumpScheduled = false;
+
+            std::weak_ptr<TransferManager> weakSelf = shared_from_this();
+            Aws::Vector<std::shared_ptr<TransferHandle>> smallFiles;
+            while (state->progress->HasFreeSlot())
+            {
+                if (state->discoveredFiles.empty())
+                {
+                    if (state->discoveryComplete)
+                    {
+                        break;
+                    }
+
+                    bool discovered = state->direction == TransferDirection::UPLOAD ? DiscoverUploadFiles(*state) : DiscoverDownloadFiles(*state);
+                    state->discoveryComplete = !discovered;
+                    continue;
+                }
+
+                DirectoryFile file = state->discoveredFiles.front();
+                state->discoveredFiles.pop();
+
+                std::shared_ptr<TransferHandle> handle;
+                bool isSmallFile = false;
+                if (state->direction == TransferDirection::UPLOAD)
+                {
+                    // the file is only opened to check it can be read, it is reopened once its upload runs
+#ifdef _MSC_VER
+                    Aws::FStream fileStream(Aws::Utils::StringUtils::ToWString(file.path.c_str()).c_str(), std::ios_base::in | std::ios_base::binary);
+#else
+                    Aws::FStream fileStream(file.path.c_str(), std::ios_base::in | std::ios_base::binary);
+#endif
+                    handle = CreateUploadFileHandle(&fileStream, state->bucketName, file.key, DEFAULT_CONTENT_TYPE, state->metadata, file.path);
+                    isSmallFile = !MultipartUploadSupported(handle->GetBytesTotalSize());
+                }
+                else
+                {
+                    handle = CreateDownloadFileHandle(state->bucketName, file.key, file.path);
+                    // the size is known from the listing, which lets small downloads skip the HEAD request
+                    handle->SetBytesTotalSize(file.sizeInBytes);
+                    isSmallFile = file.sizeInBytes <= m_transferConfig.bufferSize;
+                }
+
+                handle->SetFinishedCallback([weakSelf, state]
+                {
+                    state->progress->NotifyTransferFinished();
+                    if (auto self = weakSelf.lock())
+                    {
+                        self->ScheduleDirectoryTransfer(state);
+                    }
+                });
+                state->progress->AddTransfer(handle);
+
+                if (m_transferConfig.transferInitiatedCallback)
+                {
+                    m_transferConfig.transferInitiatedCallback(this, handle);
+                }
+
+                if (handle->GetStatus() != TransferStatus::NOT_STARTED)
+                {
+                    continue;
+                }
+
+                if (!isSmallFile)
+                {
+                    if (state->direction == TransferDirection::UPLOAD)
+                    {
+                        SubmitUpload(handle);
+                    }
+                    else
+                    {
+                        SubmitDownload(handle);
+                    }
+                    continue;
+                }
+
+                smallFiles.push_back(handle);
+                if (smallFiles.size() >= DIRECTORY_BATCH_SIZE)
+                {
+                    SubmitDirectoryBatch(smallFiles);
+                    smallFiles.clear();
+                }
+            }
+
+            if (!smallFiles.empty())
+            {
+                SubmitDirectoryBatch(smallFiles);
+            }
+
+            if (state->discoveryComplete && state->discoveredFiles.empty())
+            {
+                state->progress->SetListingComplete();
+            }
+        }
+
+        bool TransferManager::DiscoverUploadFiles(DirectoryTransferState& state)
+        {
+            while (!state.openDirectories.empty())
             {
-                if (entry && entry.fileType == Aws::FileSystem::FileType::File)
+                auto entry = state.openDirectories.back()->Next();
+                if (!entry)
+                {
+                    state.openDirectories.pop_back();
+                }
+                else if (entry.fileType == Aws::FileSystem::FileType::Directory)
+                {
+                    auto directory = Aws::FileSystem::OpenDirectory(entry.path, entry.relativePath);
+                    if (*directory)
+                    {
+                        state.openDirectories.push_back(directory);
+                    }
+                }
+                else if (entry.fileType == Aws::FileSystem::FileType::File)
                 {
                     Aws::StringStream ssKey;
                     Aws::String relativePath = entry.relativePath;
                     char delimiter[] = { Aws::FileSystem::PATH_DELIM, 0 };
                     Aws::Utils::StringUtils::Replace(relativePath, delimiter, "/");
+                    ssKey << state.prefix << "/" << relativePath;
+
+                    DirectoryFile file;
+                    file.path = entry.path;
+                    file.key = ssKey.str();
+                    file.sizeInBytes = static_cast<uint64_t>(entry.fileSize);
+                    state.discoveredFiles.push(file);
+                    state.progress->AddDiscoveredFile(file.sizeInBytes);
+                    return true;
+                }
+            }
+
+            return false;
+        }
 
-                    ssKey << prefix << "/" << relativePath;
-                    Aws::String keyName = ssKey.str();
-                    
-                    self->m_transferConfig.transferInitiatedCallback(self.get(), self->UploadFile(entry.path, bucketName, keyName, DEFAULT_CONTENT_TYPE, metadata));                    
+        bool TransferManager::DiscoverDownloadFiles(DirectoryTransferState& state)
+        {
+            while (!state.prefixesToList.empty())
+            {
+                Aws::S3::Model::ListObjectsV2Request request;
+                request.WithBucket(state.bucketName)
+                    .WithPrefix(state.prefixesToList.front())
+                    .WithDelimiter("/");
+                if (!state.continuationToken.empty())
+                {
+                    request.SetContinuationToken(state.continuationToken);
                 }
 
-                return true;
-            };
-            
-            m_transferConfig.transferExecutor->Submit([directory, visitor]() { Aws::FileSystem::DirectoryTree dir(directory); dir.TraverseDepthFirst(visitor); });
+                auto outcome = m_transferConfig.s3Client->ListObjectsV2(request);
+                if (!outcome.IsSuccess())
+                {
+                    //notify user if list objects failed.
+                    if (m_transferConfig.errorCallback)
+                    {
+                        auto handle = Aws::MakeShared<TransferHandle>(CLASS_TAG, request.GetBucket(), "");
+                        m_transferConfig.errorCallback(this, handle, outcome.GetError());
+                    }
+                    state.prefixesToList.pop();
+                    state.continuationToken.clear();
+                    continue;
+                }
+
+                auto& result = outcome.GetResult();
+                if (result.GetIsTruncated())
+                {
+                    state.continuationToken = result.GetNextContinuationToken();
+                }
+                else
+                {
+                    state.prefixesToList.pop();
+                    state.continuationToken.clear();
+                }
+
+                //this can contain matching directories or actual objects to download. If it's a directory, go ahead and create a local directory
+                // and list its prefix later on. if it's an object key, queue it for download.
+                for (auto& content : result.GetContents())
+                {
+                    if (content.GetSize() <= 0 && content.GetKey() != request.GetPrefix())
+                    {
+                        Aws::FileSystem::CreateDirectoryIfNotExists(DetermineFilePath(state.directory, state.prefix, content.GetKey()).c_str());
+                        state.prefixesToList.push(content.GetKey());
+                    }
+                    else if (content.GetSize() > 0)
+                    {
+                        DirectoryFile file;
+                        file.path = DetermineFilePath(state.directory, state.prefix, content.GetKey());
+                        file.key = content.GetKey();
+                        file.sizeInBytes = static_cast<uint64_t>(content.GetSize());
+                        state.discoveredFiles.push(file);
+                        state.progress->AddDiscoveredFile(file.sizeInBytes);
+                    }
+                }
+
+                for (auto& commonPrefix : result.GetCommonPrefixes())
+                {
+                    Aws::FileSystem::CreateDirectoryIfNotExists(DetermineFilePath(state.directory, state.prefix, commonPrefix.GetPrefix()).c_str());
+                    state.prefixesToList.push(commonPrefix.GetPrefix());
+                }
+
+                if (!state.discoveredFiles.empty())
+                {
+                    return true;
+                }
+            }
+
+            return false;
         }
 
-        void TransferManager::DownloadToDirectory(const Aws::String& directory, const Aws::String& bucketName, const Aws::String& prefix)
+        void TransferManager::SubmitDirectoryBatch(const Aws::Vector<std::shared_ptr<TransferHandle>>& batch)
         {
-            assert(m_transferConfig.transferInitiatedCallback);
-            Aws::FileSystem::CreateDirectoryIfNotExists(directory.c_str());
-         
-            auto self = shared_from_this(); // keep transfer manager alive until all callbacks are finished.
-            auto handler = [self](const Aws::S3::S3Client* client, const Aws::S3::Model::ListObjectsV2Request& request,
-                const Aws::S3::Model::ListObjectsV2Outcome& outcome,
-                const std::shared_ptr<const Aws::Client::AsyncCallerContext>& context) { self->HandleListObjectsResponse(client, request, outcome, context); };
+            auto self = shared_from_this();
+            m_transferConfig.transferExecutor->Submit([self, batch]
+            {
+                for (const auto& handle : batch)
+                {
+                    if (handle->GetTransferDirection() == TransferDirection::UPLOAD)
+                    {
+                        self->DoSinglePartUpload(handle);
+                    }
+                    else
+                    {
+                        self->DoDownload(handle);
+                    }
+                }
+            });
+        }
 
-            Aws::S3::Model::ListObjectsV2Request request;
-            request.WithBucket(bucketName)
-                .WithPrefix(prefix)
-                .WithDelimiter("/");
+        uint64_t TransferManager::CalculateUploadPartSize(uint64_t totalSize, uint64_t minPartSize)
+        {
+            static const uint64_t MAX_UPLOAD_PARTS = 10000;
+            static const uint64_t MB = 1024 * 1024;
 
-            auto context = Aws::MakeShared<DownloadDirectoryContext>(CLASS_TAG);
-            context->rootDirectory = directory;
-            context->prefix = prefix;
-                
-            m_transferConfig.s3Client->ListObjectsV2Async(request, handler, context);
+            uint64_t partSize = (totalSize + MAX_UPLOAD_PARTS - 1) / MAX_UPLOAD_PARTS;
+            partSize = (partSize + MB - 1) / MB * MB;
+            return (std::max)(partSize, minPartSize);
         }
 
         void TransferManager::DoMultiPartUpload(const std::shared_ptr<TransferHandle>& handle)
         {
+            // mapping is opt in, a file truncated while mapped kills the process with SIGBUS when the lost pages are read.
+            if (m_transferConfig.mapUploadFiles)
+            {
+                auto mappedFile = Aws::MakeShared<Aws::FileSystem::MappedFile>(CLASS_TAG, handle->GetTargetFilePath().c_str());
+                // fall back to reading through a stream if the file cannot be mapped, e.g. it does not fit the address space, or it shrank
+                if (*mappedFile && mappedFile->GetLength() >= handle->GetBytesTotalSize())
+                {
+                    DoMultiPartUpload(mappedFile, handle);
+                    return;
+                }
+            }
+
+            auto readFile = Aws::MakeShared<Aws::FileSystem::PositionedReadFile>(CLASS_TAG, handle->GetTargetFilePath().c_str());
+            if (*readFile)
+            {
+                DoMultiPartUpload(readFile, handle);
+                return;
+            }
+
 #ifdef _MSC_VER
             Aws::FStream streamToPut(Aws::Utils::StringUtils::ToWString(handle->GetTargetFilePath().c_str()).c_str(), std::ios_base::in | std::ios_base::binary);
             DoMultiPartUpload(&streamToPut, handle);
@@ -231,6 +642,22 @@ namespace Aws
         }
 
         void TransferManager::DoMultiPartUpload(Aws::IOStream* streamToPut, const std::shared_ptr<TransferHandle>& handle)
+        {
+            DoMultiPartUpload(streamToPut, nullptr, nullptr, handle);
+        }
+
+        void TransferManager::DoMultiPartUpload(const std::shared_ptr<const Aws::FileSystem::MappedFile>& mappedFile, const std::shared_ptr<TransferHandle>& handle)
+        {
+            DoMultiPartUpload(nullptr, mappedFile, nullptr, handle);
+        }
+
+        void TransferManager::DoMultiPartUpload(const std::shared_ptr<const Aws::FileSystem::PositionedReadFile>& readFile, const std::shared_ptr<TransferHandle>& handle)
+        {
+            DoMultiPartUpload(nullptr, nullptr, readFile, handle);
+        }
+
+        void TransferManager::DoMultiPartUpload(Aws::IOStream* streamToPut, const std::shared_ptr<const Aws::FileSystem::MappedFile>& mappedFile,
+                const std::shared_ptr<const Aws::FileSystem::PositionedReadFile>& readFile, const std::shared_ptr<TransferHandle>& handle)
         {
             handle->UpdateStatus(TransferStatus::IN_PROGRESS);
             handle->SetIsMultipart(true);
@@ -240,32 +667,73 @@ namespace Aws
 
             if (!isRetry)
             {
-                Aws::S3::Model::CreateMultipartUploadRequest createMultipartRequest = m_transferConfig.createMultipartUploadTemplate;
-                createMultipartRequest.WithBucket(handle->GetBucketName());
-                createMultipartRequest.WithContentType(handle->GetContentType());
-                createMultipartRequest.WithKey(handle->GetKey());
-                createMultipartRequest.WithMetadata(handle->GetMetadata());
+                uint64_t totalSize = handle->GetBytesTotalSize();
+                uint64_t partSize = CalculateUploadPartSize(totalSize, m_transferConfig.bufferSize);
+                Aws::Map<int, TransferJournal::Part> resumedParts;
 
-                auto createMultipartResponse = m_transferConfig.s3Client->CreateMultipartUpload(createMultipartRequest);
-                if (createMultipartResponse.IsSuccess())
+                AttachJournal(handle);
+                if (handle->GetJournal())
                 {
-                    handle->SetMultipartId(createMultipartResponse.GetResult().GetUploadId());
-                    uint64_t totalSize = handle->GetBytesTotalSize();
-                    uint64_t partCount = ( totalSize + m_transferConfig.bufferSize - 1 ) / m_transferConfig.bufferSize;
+                    resumedParts = ResumeUploadFromJournal(handle, streamToPut, mappedFile, readFile);
+                    if (!handle->GetMultiPartId().empty())
+                    {
+                        partSize = handle->GetJournal()->GetPartSize();
+                    }
+                }
+
+                if (handle->GetMultiPartId().empty())
+                {
+                    Aws::S3::Model::CreateMultipartUploadRequest createMultipartRequest = m_transferConfig.createMultipartUploadTemplate;
+                    createMultipartRequest.WithBucket(handle->GetBucketName());
+                    createMultipartRequest.WithContentType(handle->GetContentType());
+                    createMultipartRequest.WithKey(handle->GetKey());
+                    createMultipartRequest.WithMetadata(handle->GetMetadata());
+
+                    auto createMultipartResponse = m_transferConfig.s3Client->CreateMultipartUpload(createMultipartRequest);
+                    if (!createMultipartResponse.IsSuccess())
+                    {
+                        handle->SetError(createMultipartResponse.GetError());
+                        handle->UpdateStatus(DetermineIfFailedOrCanceled(*handle));
 
-                    for (uint64_t i = 0; i < partCount; ++i)
+                        TriggerErrorCallback(handle, createMultipartResponse.GetError());
+                        return;
+                    }
+
+                    handle->SetMultipartId(createMultipartResponse.GetResult().GetUploadId());
+                    if (handle->GetJournal() && !handle->GetJournal()->Rewrite(totalSize, partSize, handle->GetMultiPartId(), ""))
                     {
-                        uint64_t partSize = (std::min)(totalSize - i * m_transferConfig.bufferSize, m_transferConfig.bufferSize);
-                        bool lastPart = (i == partCount - 1) ? true : false;
-                        handle->AddQueuedPart(Aws::MakeShared<PartState>(CLASS_TAG, static_cast<int>(i + 1), 0, static_cast<size_t>(partSize), lastPart));
-                    }                    
+                        AWS_LOGSTREAM_WARN(CLASS_TAG, "Unable to write transfer journal " << handle->GetJournal()->GetPath() << ", upload will not be resumable");
+                        handle->SetJournal(nullptr);
+                    }
                 }
-                else
+
+                uint64_t partCount = ( totalSize + partSize - 1 ) / partSize;
+                for (uint64_t i = 0; i < partCount; ++i)
                 {
-                    handle->SetError(createMultipartResponse.GetError());
-                    handle->UpdateStatus(DetermineIfFailedOrCanceled(*handle));
+                    uint64_t sizeInBytes = (std::min)(totalSize - i * partSize, partSize);
+                    bool lastPart = (i == partCount - 1) ? true : false;
+                    auto partState = Aws::MakeShared<PartState>(CLASS_TAG, static_cast<int>(i + 1), 0, static_cast<size_t>(sizeInBytes), lastPart);
+                    partState->SetRangeBegin(static_cast<size_t>(i * partSize));
+
+                    auto resumedPart = resumedParts.find(partState->GetPartId());
+                    if (resumedPart != resumedParts.end())
+                    {
+                        handle->UpdateBytesTransferred(sizeInBytes);
+                        handle->ChangePartToCompleted(partState, resumedPart->second.eTag);
+                        sentBytes += sizeInBytes;
+                    }
+                    else
+                    {
+                        handle->AddQueuedPart(partState);
+                    }
+                }
 
-                    TriggerErrorCallback(handle, createMultipartResponse.GetError());
+                // the process stopped after the last part, before completing the upload
+                if (!handle->HasQueuedParts() && handle->LockForCompletion())
+                {
+                    TriggerTransferStatusUpdatedCallback(handle);
+                    CompleteMultipartUpload(handle);
+                    TriggerTransferStatusUpdatedCallback(handle);
                     return;
                 }
             }
@@ -290,20 +758,41 @@ namespace Aws
 
             while (sentBytes < handle->GetBytesTotalSize() && handle->ShouldContinue() && partsIter != queuedParts.end())
             {
-                auto buffer = m_bufferManager.Acquire();
+                auto lengthToWrite = partsIter->second->GetSizeInBytes();
+                // mapped parts do not use the buffer, holding it still bounds the number of parts in flight
+                AcquirePartSlot();
+                auto buffer = mappedFile ? m_bufferManager.Acquire() : AcquirePartBuffer(lengthToWrite);
                 if(handle->ShouldContinue())
                 {
-                    auto lengthToWrite = partsIter->second->GetSizeInBytes();
-                    streamToPut->seekg((partsIter->first - 1) * m_transferConfig.bufferSize);
-                    streamToPut->read((char*)buffer->GetUnderlyingData(), lengthToWrite);
+                    uint64_t partOffset = partsIter->second->GetRangeBegin();
 
-                    auto streamBuf = Aws::New<Aws::Utils::Stream::PreallocatedStreamBuf>(CLASS_TAG, buffer, static_cast<size_t>(lengthToWrite));
+                    Aws::Utils::Stream::PreallocatedStreamBuf* streamBuf = nullptr;
+                    PartReadStreamBuf* partReader = nullptr;
+                    const uint8_t* partData = nullptr;
+                    if (mappedFile)
+                    {
+                        partData = mappedFile->GetData() + partOffset;
+                        streamBuf = Aws::New<Aws::Utils::Stream::PreallocatedStreamBuf>(CLASS_TAG, partData, lengthToWrite);
+                    }
+                    else if (readFile)
+                    {
+                        partReader = Aws::New<PartReadStreamBuf>(CLASS_TAG, readFile, partOffset, buffer, static_cast<size_t>(lengthToWrite));
+                        streamBuf = partReader;
+                    }
+                    else
+                    {
+                        streamToPut->seekg(partOffset);
+                        streamToPut->read((char*)buffer->GetUnderlyingData(), lengthToWrite);
+                        partData = buffer->GetUnderlyingData();
+                        streamBuf = Aws::New<Aws::Utils::Stream::PreallocatedStreamBuf>(CLASS_TAG, buffer, static_cast<size_t>(lengthToWrite));
+                    }
                     auto preallocatedStreamReader = Aws::MakeShared<Aws::IOStream>(CLASS_TAG, streamBuf);
 
                     auto self = shared_from_this(); // keep transfer manager alive until all callbacks are finished.
                     PartPointer partPtr = partsIter->second;
                     Aws::S3::Model::UploadPartRequest uploadPartRequest = m_transferConfig.uploadPartTemplate;
-                    uploadPartRequest.SetContinueRequestHandler([handle](const Aws::Http::HttpRequest*) { return handle->ShouldContinue(); });
+                    // a part that could not be read aborts its request instead of sending a short body
+                    uploadPartRequest.SetContinueRequestHandler([handle, partReader](const Aws::Http::HttpRequest*) { return handle->ShouldContinue() && !(partReader && partReader->ReadFailed()); });
                     uploadPartRequest.SetDataSentEventHandler([self, handle, partPtr](const Aws::Http::HttpRequest*, long long amount){ partPtr->OnDataTransferred(amount, handle); self->TriggerUploadProgressCallback(handle); });
                     uploadPartRequest.SetRequestRetryHandler([partPtr](const AmazonWebServiceRequest&){ partPtr->Reset(); });
                     uploadPartRequest.WithBucket(handle->GetBucketName())
@@ -319,6 +808,13 @@ namespace Aws
                     auto asyncContext = Aws::MakeShared<TransferHandleAsyncContext>(CLASS_TAG);
                     asyncContext->handle = handle;
                     asyncContext->partState = partsIter->second;
+                    asyncContext->buffer = buffer;
+                    asyncContext->mappedFile = mappedFile;
+                    asyncContext->partReader = partReader;
+                    if (handle->GetJournal() && partData)
+                    {
+                        asyncContext->checksum = TransferJournal::CalculateChecksum(0, partData, lengthToWrite);
+                    }
 
                     auto callback = [self](const Aws::S3::S3Client* client, const Aws::S3::Model::UploadPartRequest& request,
                         const Aws::S3::Model::UploadPartOutcome& outcome, const std::shared_ptr<const Aws::Client::AsyncCallerContext>& context)
@@ -333,7 +829,8 @@ namespace Aws
                 }
                 else
                 {
-                    m_bufferManager.Release(buffer);
+                    ReleasePartBuffer(buffer);
+                    CancelPartSlot();
                 }
             }
             //parts get moved from queued to pending on this thread.
@@ -420,57 +917,67 @@ namespace Aws
 
             auto originalStreamBuffer = (Aws::Utils::Stream::PreallocatedStreamBuf*)request.GetBody()->rdbuf();
 
-            m_bufferManager.Release(originalStreamBuffer->GetBuffer());
+            auto partReader = transferContext->partReader;
+            bool partReadFailed = partReader && partReader->ReadFailed();
+            bool partSucceeded = outcome.IsSuccess() && !partReadFailed;
+            if (partSucceeded && partReader && transferContext->handle->GetJournal() && partReader->Read())
+            {
+                transferContext->checksum = TransferJournal::CalculateChecksum(0, transferContext->buffer->GetUnderlyingData(), transferContext->partState->GetSizeInBytes());
+            }
+
+            ReleasePartBuffer(transferContext->buffer);
             Aws::Delete(originalStreamBuffer);
 
-            if (outcome.IsSuccess())
+            if (!transferContext->handle->ShouldContinue())
             {
-                transferContext->handle->ChangePartToCompleted(transferContext->partState, outcome.GetResult().GetETag());
-                TriggerUploadProgressCallback(transferContext->handle);
+                CancelPartSlot();
             }
             else
             {
-                transferContext->handle->ChangePartToFailed(transferContext->partState);
-                transferContext->handle->SetError(outcome.GetError());
-                TriggerErrorCallback(transferContext->handle, outcome.GetError());
+                ReleasePartSlot(partSucceeded ? transferContext->partState->GetSizeInBytes() : 0, partSucceeded);
             }
 
-            TriggerTransferStatusUpdatedCallback(transferContext->handle);
+            if (partSucceeded)
+            {
+                if (transferContext->handle->GetJournal())
+                {
+                    TransferJournal::Part journalPart;
+                    journalPart.partId = transferContext->partState->GetPartId();
+                    journalPart.rangeBegin = transferContext->partState->GetRangeBegin();
+                    journalPart.sizeInBytes = transferContext->partState->GetSizeInBytes();
+                    journalPart.eTag = outcome.GetResult().GetETag();
+                    journalPart.checksum = transferContext->checksum;
+                    transferContext->handle->GetJournal()->RecordCompletedPart(journalPart);
+                }
 
-            PartStateMap pendingParts, queuedParts, failedParts, completedParts;
-            transferContext->handle->GetAllPartsTransactional(queuedParts, pendingParts, failedParts, completedParts);
+                transferContext->handle->ChangePartToCompleted(transferContext->partState, outcome.GetResult().GetETag());
+                TriggerUploadProgressCallback(transferContext->handle);
+            }
+            else if (partReadFailed)
+            {
+                Aws::Client::AWSError<Aws::S3::S3Errors> error(Aws::S3::S3Errors::INTERNAL_FAILURE, "ReadPartFailed",
+                        "Unable to read part from " + transferContext->handle->GetTargetFilePath(), false);
+                transferContext->handle->ChangePartToFailed(transferContext->partState);
+                transferContext->handle->SetError(error);
+                TriggerErrorCallback(transferContext->handle, error);
+            }
+            else
+            {
+                transferContext->handle->ChangePartToFailed(transferContext->partState);
+                transferContext->handle->SetError(outcome.GetError());
+                TriggerErrorCallback(transferContext->handle, outcome.GetError());
+            }
+
+            TriggerTransferStatusUpdatedCallback(transferContext->handle);
+
+            PartStateMap pendingParts, queuedParts, failedParts, completedParts;
+            transferContext->handle->GetAllPartsTransactional(queuedParts, pendingParts, failedParts, completedParts);
 
             if (pendingParts.size() == 0 && queuedParts.size() == 0 && transferContext->handle->LockForCompletion())
             {               
                 if (failedParts.size() == 0 && transferContext->handle->GetBytesTransferred() == transferContext->handle->GetBytesTotalSize())
                 {
-                    Aws::S3::Model::CompletedMultipartUpload completedUpload;
-
-                    for (auto& part : transferContext->handle->GetCompletedParts())
-                    {
-                        Aws::S3::Model::CompletedPart completedPart;
-                        completedPart.WithPartNumber(part.first)
-                            .WithETag(part.second->GetETag());
-                        completedUpload.AddParts(completedPart);
-                    }
-
-                    Aws::S3::Model::CompleteMultipartUploadRequest completeMultipartUploadRequest;
-                    completeMultipartUploadRequest.SetContinueRequestHandler([=](const Aws::Http::HttpRequest*) { return transferContext->handle->ShouldContinue(); });
-                    completeMultipartUploadRequest.WithBucket(transferContext->handle->GetBucketName())
-                        .WithKey(transferContext->handle->GetKey())
-                        .WithUploadId(transferContext->handle->GetMultiPartId())
-                        .WithMultipartUpload(completedUpload);
-
-                    auto completeUploadOutcome = m_transferConfig.s3Client->CompleteMultipartUpload(completeMultipartUploadRequest);
-
-                    if (completeUploadOutcome.IsSuccess())
-                    {
-                        transferContext->handle->UpdateStatus(TransferStatus::COMPLETED);
-                    }
-                    else
-                    {
-                        transferContext->handle->UpdateStatus(DetermineIfFailedOrCanceled(*transferContext->handle));
-                    }
+                    CompleteMultipartUpload(transferContext->handle);
                 }
                 else
                 {
@@ -481,6 +988,41 @@ namespace Aws
             TriggerTransferStatusUpdatedCallback(transferContext->handle);
         }
 
+        void TransferManager::CompleteMultipartUpload(const std::shared_ptr<TransferHandle>& handle)
+        {
+            Aws::S3::Model::CompletedMultipartUpload completedUpload;
+
+            for (auto& part : handle->GetCompletedParts())
+            {
+                Aws::S3::Model::CompletedPart completedPart;
+                completedPart.WithPartNumber(part.first)
+                    .WithETag(part.second->GetETag());
+                completedUpload.AddParts(completedPart);
+            }
+
+            Aws::S3::Model::CompleteMultipartUploadRequest completeMultipartUploadRequest;
+            completeMultipartUploadRequest.SetContinueRequestHandler([handle](const Aws::Http::HttpRequest*) { return handle->ShouldContinue(); });
+            completeMultipartUploadRequest.WithBucket(handle->GetBucketName())
+                .WithKey(handle->GetKey())
+                .WithUploadId(handle->GetMultiPartId())
+                .WithMultipartUpload(completedUpload);
+
+            auto completeUploadOutcome = m_transferConfig.s3Client->CompleteMultipartUpload(completeMultipartUploadRequest);
+
+            if (completeUploadOutcome.IsSuccess())
+            {
+                if (handle->GetJournal())
+                {
+                    handle->GetJournal()->Remove();
+                }
+                handle->UpdateStatus(TransferStatus::COMPLETED);
+            }
+            else
+            {
+                handle->UpdateStatus(DetermineIfFailedOrCanceled(*handle));
+            }
+        }
+
         void TransferManager::HandlePutObjectResponse(const Aws::S3::S3Client*, const Aws::S3::Model::PutObjectRequest& request,
             const Aws::S3::Model::PutObjectOutcome& outcome, const std::shared_ptr<const Aws::Client::AsyncCallerContext>& context)
         {
@@ -516,6 +1058,14 @@ namespace Aws
 
             if (retryHandle->GetStatus() == TransferStatus::ABORTED)
             {
+                if (retryHandle->IsFileDownload())
+                {
+                    return DownloadFile(retryHandle->GetBucketName(), retryHandle->GetKey(), retryHandle->GetTargetFilePath());
+                }
+                if (retryHandle->IsStreamingDownload())
+                {
+                    return DownloadToConsumer(retryHandle->GetBucketName(), retryHandle->GetKey(), retryHandle->GetDownloadConsumer());
+                }
                 return DownloadFile(retryHandle->GetBucketName(), retryHandle->GetKey(), retryHandle->GetCreateDownloadStreamFunction());
             }
 
@@ -590,7 +1140,15 @@ namespace Aws
         {
             bool isRetry = handle->HasParts();
             size_t bufferSize = static_cast<size_t>(m_transferConfig.bufferSize);
-            if (!isRetry)
+            // directory downloads know the size of each object from the listing, a single part needs no HEAD
+            if (!isRetry && handle->GetBytesTotalSize() > 0 && handle->GetBytesTotalSize() <= bufferSize)
+            {
+                handle->SetIsMultipart(false);
+                auto partState = Aws::MakeShared<PartState>(CLASS_TAG, 1, 0, static_cast<size_t>(handle->GetBytesTotalSize()), true);
+                partState->SetRangeBegin(0);
+                handle->AddQueuedPart(partState);
+            }
+            else if (!isRetry)
             {
                 Aws::S3::Model::HeadObjectRequest headObjectRequest;
                 headObjectRequest.WithBucket(handle->GetBucketName())
@@ -622,17 +1180,38 @@ namespace Aws
                 {
                     handle->SetVersionId(headObjectOutcome.GetResult().GetVersionId());
                 }
+                handle->SetObjectETag(headObjectOutcome.GetResult().GetETag());
 
                 std::size_t partCount = ( downloadSize + bufferSize - 1 ) / bufferSize;
                 handle->SetIsMultipart(partCount > 1);    // doesn't make a difference but let's be accurate
 
+                Aws::Map<int, TransferJournal::Part> resumedParts;
+                if (partCount > 1)
+                {
+                    AttachJournal(handle);
+                }
+                if (handle->GetJournal())
+                {
+                    resumedParts = ResumeDownloadFromJournal(handle, headObjectOutcome.GetResult().GetETag());
+                }
+
                 for(std::size_t i = 0; i < partCount; ++i)
                 {
                     std::size_t partSize = (i + 1 < partCount ) ? bufferSize : (downloadSize - bufferSize * (partCount - 1));
                     bool lastPart = (i == partCount - 1) ? true : false;
                     auto partState = Aws::MakeShared<PartState>(CLASS_TAG, static_cast<int>(i + 1), 0, partSize, lastPart);
                     partState->SetRangeBegin(i * bufferSize);
-                    handle->AddQueuedPart(partState);
+
+                    auto resumedPart = resumedParts.find(partState->GetPartId());
+                    if (resumedPart != resumedParts.end())
+                    {
+                        handle->UpdateBytesTransferred(partSize);
+                        handle->ChangePartToCompleted(partState, resumedPart->second.eTag);
+                    }
+                    else
+                    {
+                        handle->AddQueuedPart(partState);
+                    }
                 }
             }
             else
@@ -654,6 +1233,12 @@ namespace Aws
                 return;
             }
 
+            if(handle->IsStreamingDownload())
+            {
+                DoStreamingDownload(handle);
+                return;
+            }
+
             bool isMultipart = handle->IsMultipart();
             size_t bufferSize = static_cast<size_t>(m_transferConfig.bufferSize);
 
@@ -664,13 +1249,43 @@ namespace Aws
                 return;
             }
 
+            if(handle->IsFileDownload())
+            {
+                uint64_t preallocateSize = m_transferConfig.preallocateDownloadFiles ? handle->GetBytesTotalSize() : 0;
+                // parts resumed from the journal are already in the file
+                bool keepContents = !handle->GetCompletedParts().empty();
+                if(!handle->OpenDownloadFile(preallocateSize, keepContents))
+                {
+                    Aws::Client::AWSError<Aws::S3::S3Errors> error(Aws::S3::S3Errors::INTERNAL_FAILURE, "OpenDownloadFileFailed",
+                            "Unable to open or preallocate " + handle->GetTargetFilePath(), false);
+                    handle->SetError(error);
+                    for (auto& queuedPart : handle->GetQueuedParts())
+                    {
+                        handle->ChangePartToFailed(queuedPart.second);
+                    }
+                    handle->UpdateStatus(TransferStatus::FAILED);
+                    TriggerErrorCallback(handle, error);
+                    TriggerTransferStatusUpdatedCallback(handle);
+                    return;
+                }
+            }
+
             auto queuedParts = handle->GetQueuedParts();
+            if(queuedParts.empty() && !handle->HasPendingParts())
+            {
+                // every part was resumed from the journal
+                CompleteDownload(handle);
+                TriggerTransferStatusUpdatedCallback(handle);
+                return;
+            }
+
             auto queuedPartIter = queuedParts.begin();
             while(queuedPartIter != queuedParts.end() && handle->ShouldContinue())
             {
                 const auto& partState = queuedPartIter->second;
                 std::size_t rangeStart = ( partState->GetPartId() - 1 ) * bufferSize;
                 std::size_t rangeEnd = rangeStart + partState->GetSizeInBytes() - 1;
+                AcquirePartSlot();
                 auto buffer = m_bufferManager.Acquire();
                 partState->SetDownloadBuffer(buffer);
 
@@ -696,6 +1311,11 @@ namespace Aws
                     {
                         getObjectRangeRequest.SetVersionId(handle->GetVersionId());
                     }
+                    // parts of a journaled download must all come from the object the journal describes
+                    if(handle->GetJournal() && !handle->GetJournal()->GetObjectETag().empty())
+                    {
+                        getObjectRangeRequest.SetIfMatch(handle->GetJournal()->GetObjectETag());
+                    }
 
                     auto self = shared_from_this(); // keep transfer manager alive until all callbacks are finished.
 
@@ -729,6 +1349,7 @@ namespace Aws
                 else if(buffer)
                 {
                     m_bufferManager.Release(buffer);
+                    CancelPartSlot();
                     break;
                 }
             }
@@ -753,6 +1374,15 @@ namespace Aws
             std::shared_ptr<TransferHandleAsyncContext> transferContext =
                 std::const_pointer_cast<TransferHandleAsyncContext>(std::static_pointer_cast<const TransferHandleAsyncContext>(context));
 
+            if (!transferContext->handle->ShouldContinue())
+            {
+                CancelPartSlot();
+            }
+            else
+            {
+                ReleasePartSlot(outcome.IsSuccess() ? transferContext->partState->GetSizeInBytes() : 0, outcome.IsSuccess());
+            }
+
             if (!outcome.IsSuccess())
             {
                 transferContext->handle->ChangePartToFailed(transferContext->partState);
@@ -763,9 +1393,45 @@ namespace Aws
             {
                 if(transferContext->handle->ShouldContinue())
                 {
-                    Aws::IOStream* bufferStream = transferContext->partState->GetDownloadPartStream();
-                    transferContext->handle->WritePartToDownloadStream(bufferStream, transferContext->partState->GetRangeBegin());
-                    transferContext->handle->ChangePartToCompleted(transferContext->partState, outcome.GetResult().GetETag());
+                    const auto& handle = transferContext->handle;
+                    const auto& partState = transferContext->partState;
+                    bool written = true;
+                    if(handle->IsFileDownload())
+                    {
+                        written = handle->WritePartToDownloadFile(partState->GetDownloadBuffer()->GetUnderlyingData(), partState->GetSizeInBytes(),
+                                partState->GetRangeBegin());
+                        if(written && m_transferConfig.downloadFileSyncPolicy == DownloadFileSyncPolicy::EVERY_PART)
+                        {
+                            written = handle->SyncDownloadFile();
+                        }
+                    }
+                    else
+                    {
+                        handle->WritePartToDownloadStream(partState->GetDownloadPartStream(), partState->GetRangeBegin());
+                    }
+
+                    if(written)
+                    {
+                        if(handle->GetJournal())
+                        {
+                            TransferJournal::Part journalPart;
+                            journalPart.partId = partState->GetPartId();
+                            journalPart.rangeBegin = partState->GetRangeBegin();
+                            journalPart.sizeInBytes = partState->GetSizeInBytes();
+                            journalPart.eTag = outcome.GetResult().GetETag();
+                            journalPart.checksum = TransferJournal::CalculateChecksum(0, partState->GetDownloadBuffer()->GetUnderlyingData(), partState->GetSizeInBytes());
+                            handle->GetJournal()->RecordCompletedPart(journalPart);
+                        }
+                        handle->ChangePartToCompleted(partState, outcome.GetResult().GetETag());
+                    }
+                    else
+                    {
+                        Aws::Client::AWSError<Aws::S3::S3Errors> error(Aws::S3::S3Errors::INTERNAL_FAILURE, "WritePartFailed",
+                                "Unable to write part to " + handle->GetTargetFilePath(), false);
+                        handle->ChangePartToFailed(partState);
+                        handle->SetError(error);
+                        TriggerErrorCallback(handle, error);
+                    }
                 }
                 else
                 {
@@ -787,17 +1453,292 @@ namespace Aws
 
             if (pendingParts.size() == 0 && queuedParts.size() == 0)
             {               
-                if (failedParts.size() == 0 && transferContext->handle->GetBytesTransferred() == transferContext->handle->GetBytesTotalSize())
+                CompleteDownload(transferContext->handle);
+            }
+
+            TriggerTransferStatusUpdatedCallback(transferContext->handle);
+        }
+
+        void TransferManager::DoStreamingDownload(const std::shared_ptr<TransferHandle>& handle)
+        {
+            auto queuedParts = handle->GetQueuedParts();
+            if(queuedParts.empty())
+            {
+                // empty object
+                CompleteDownload(handle);
+                TriggerTransferStatusUpdatedCallback(handle);
+                return;
+            }
+
+            size_t maxParts = static_cast<size_t>(m_transferConfig.transferBufferMaxHeapSize / m_transferConfig.bufferSize);
+            size_t readAheadParts = (std::max)(static_cast<size_t>(1), (std::min)(m_transferConfig.downloadReadAheadParts, maxParts));
+            // delivered parts are completed, so on a retry the queued parts start at the first part not delivered yet
+            auto state = Aws::MakeShared<StreamingDownloadState>(CLASS_TAG, queuedParts.begin()->first, readAheadParts);
+
+            auto queuedPartIter = queuedParts.begin();
+            while(queuedPartIter != queuedParts.end() && handle->ShouldContinue())
+            {
+                const auto& partState = queuedPartIter->second;
+                {
+                    // parts are requested, and take their buffers, in order, so the part next in line never waits for a buffer held by a later one
+                    std::unique_lock<std::mutex> locker(state->lock);
+                    state->partDelivered.wait(locker, [&]
+                    {
+                        return state->failed || !handle->ShouldContinue() ||
+                               partState->GetPartId() < state->nextPart + static_cast<int>(state->readAheadParts);
+                    });
+                    if(state->failed || !handle->ShouldContinue())
+                    {
+                        break;
+                    }
+                }
+
+                AcquirePartSlot();
+                auto buffer = m_bufferManager.Acquire();
+                if(!handle->ShouldContinue())
+                {
+                    m_bufferManager.Release(buffer);
+                    CancelPartSlot();
+                    break;
+                }
+
+                partState->SetDownloadBuffer(buffer);
+                std::size_t rangeStart = partState->GetRangeBegin();
+                std::size_t rangeEnd = rangeStart + partState->GetSizeInBytes() - 1;
+                CreateDownloadStreamCallback responseStreamFunction = [partState, buffer, rangeEnd, rangeStart]()
+                {
+                    auto streamBuf = Aws::New<Aws::Utils::Stream::PreallocatedStreamBuf>(CLASS_TAG, buffer, rangeEnd - rangeStart + 1);
+                    auto bufferStream = Aws::New<Aws::IOStream>(CLASS_TAG, streamBuf);
+                    partState->SetDownloadPartStream(bufferStream);
+                    return bufferStream;
+                };
+
+                Aws::S3::Model::GetObjectRequest getObjectRangeRequest;
+                getObjectRangeRequest.SetContinueRequestHandler([handle](const Aws::Http::HttpRequest*) { return handle->ShouldContinue(); });
+                getObjectRangeRequest.SetBucket(handle->GetBucketName());
+                getObjectRangeRequest.WithKey(handle->GetKey());
+                getObjectRangeRequest.SetRange(FormatRangeSpecifier(rangeStart, rangeEnd));
+                getObjectRangeRequest.SetResponseStreamFactory(responseStreamFunction);
+                if(handle->GetVersionId().size() > 0)
+                {
+                    getObjectRangeRequest.SetVersionId(handle->GetVersionId());
+                }
+                // bytes already given to the consumer cannot be taken back, every part must come from the object the HEAD request saw
+                if(!handle->GetObjectETag().empty())
                 {
-                    transferContext->handle->UpdateStatus(TransferStatus::COMPLETED);
+                    getObjectRangeRequest.SetIfMatch(handle->GetObjectETag());
+                }
+
+                auto self = shared_from_this(); // keep transfer manager alive until all callbacks are finished.
+
+                getObjectRangeRequest.SetDataReceivedEventHandler([self, partState, handle](const Aws::Http::HttpRequest*, Aws::Http::HttpResponse*, long long progress)
+                {
+                    partState->OnDataTransferred(progress, handle);
+                    self->TriggerDownloadProgressCallback(handle);
+                });
+
+                getObjectRangeRequest.SetRequestRetryHandler([self, partState, handle](const Aws::AmazonWebServiceRequest&)
+                {
+                    partState->Reset();
+                    self->TriggerDownloadProgressCallback(handle);
+                });
+
+                auto asyncContext = Aws::MakeShared<TransferHandleAsyncContext>(CLASS_TAG);
+                asyncContext->handle = handle;
+                asyncContext->partState = partState;
+                asyncContext->streamingState = state;
+
+                auto callback = [self](const Aws::S3::S3Client*, const Aws::S3::Model::GetObjectRequest&,
+                    const Aws::S3::Model::GetObjectOutcome& outcome, const std::shared_ptr<const Aws::Client::AsyncCallerContext>& context)
+                {
+                    self->HandleStreamingGetObjectResponse(outcome, context);
+                };
+
+                handle->AddPendingPart(partState);
+
+                m_transferConfig.s3Client->GetObjectAsync(getObjectRangeRequest, callback, asyncContext);
+                ++queuedPartIter;
+            }
+
+            //parts get moved from queued to pending on this thread.
+            //still consistent.
+            bool stoppedEarly = queuedPartIter != queuedParts.end();
+            while(queuedPartIter != queuedParts.end())
+            {
+                handle->ChangePartToFailed(queuedPartIter->second);
+                ++queuedPartIter;
+            }
+
+            // the parts in flight may all have finished before the rest were marked failed
+            if(stoppedEarly && !handle->HasPendingParts())
+            {
+                CompleteDownload(handle);
+                TriggerTransferStatusUpdatedCallback(handle);
+            }
+        }
+
+        void TransferManager::HandleStreamingGetObjectResponse(const Aws::S3::Model::GetObjectOutcome& outcome,
+                                                               const std::shared_ptr<const Aws::Client::AsyncCallerContext>& context)
+        {
+            std::shared_ptr<TransferHandleAsyncContext> transferContext =
+                std::const_pointer_cast<TransferHandleAsyncContext>(std::static_pointer_cast<const TransferHandleAsyncContext>(context));
+            const auto& handle = transferContext->handle;
+            const auto& partState = transferContext->partState;
+            auto& state = *transferContext->streamingState;
+
+            if (!handle->ShouldContinue())
+            {
+                CancelPartSlot();
+            }
+            else
+            {
+                ReleasePartSlot(outcome.IsSuccess() ? partState->GetSizeInBytes() : 0, outcome.IsSuccess());
+            }
+
+            bool queuedForDelivery = false;
+            if (outcome.IsSuccess())
+            {
+                partState->SetETag(outcome.GetResult().GetETag());
+                std::lock_guard<std::mutex> locker(state.lock);
+                if (!state.failed && handle->ShouldContinue())
+                {
+                    state.downloadedParts[partState->GetPartId()] = partState;
+                    queuedForDelivery = true;
+                }
+            }
+            else
+            {
+                handle->SetError(outcome.GetError());
+                TriggerErrorCallback(handle, outcome.GetError());
+                // the parts behind this one cannot be delivered until it is retried
+                std::lock_guard<std::mutex> locker(state.lock);
+                state.failed = true;
+            }
+
+            if (!queuedForDelivery)
+            {
+                m_bufferManager.Release(partState->GetDownloadBuffer());
+                partState->SetDownloadBuffer(nullptr);
+                handle->ChangePartToFailed(partState);
+            }
+
+            DeliverDownloadedParts(handle, state);
+            state.partDelivered.notify_all();
+
+            TriggerTransferStatusUpdatedCallback(handle);
+
+            PartStateMap pendingParts, queuedParts, failedParts, completedParts;
+            handle->GetAllPartsTransactional(queuedParts, pendingParts, failedParts, completedParts);
+
+            if (pendingParts.size() == 0 && queuedParts.size() == 0)
+            {
+                CompleteDownload(handle);
+            }
+
+            TriggerTransferStatusUpdatedCallback(handle);
+        }
+
+        void TransferManager::DeliverDownloadedParts(const std::shared_ptr<TransferHandle>& handle, StreamingDownloadState& state)
+        {
+            {
+                std::lock_guard<std::mutex> locker(state.lock);
+                if (state.delivering)
+                {
+                    return;
+                }
+                state.delivering = true;
+            }
+
+            for (;;)
+            {
+                PartPointer nextPart;
+                Aws::Vector<PartPointer> droppedParts;
+                {
+                    std::lock_guard<std::mutex> locker(state.lock);
+                    if (state.failed || !handle->ShouldContinue())
+                    {
+                        for (auto& downloadedPart : state.downloadedParts)
+                        {
+                            droppedParts.push_back(downloadedPart.second);
+                        }
+                        state.downloadedParts.clear();
+                    }
+                    else
+                    {
+                        auto next = state.downloadedParts.find(state.nextPart);
+                        if (next != state.downloadedParts.end())
+                        {
+                            nextPart = next->second;
+                            state.downloadedParts.erase(next);
+                        }
+                    }
+
+                    if (!nextPart)
+                    {
+                        state.delivering = false;
+                    }
+                }
+
+                for (auto& droppedPart : droppedParts)
+                {
+                    m_bufferManager.Release(droppedPart->GetDownloadBuffer());
+                    droppedPart->SetDownloadBuffer(nullptr);
+                    handle->ChangePartToFailed(droppedPart);
+                }
+
+                if (!nextPart)
+                {
+                    return;
+                }
+
+                bool consumed = handle->GetDownloadConsumer()(nextPart->GetDownloadBuffer()->GetUnderlyingData(), nextPart->GetSizeInBytes());
+                m_bufferManager.Release(nextPart->GetDownloadBuffer());
+                nextPart->SetDownloadBuffer(nullptr);
+
+                if (consumed)
+                {
+                    handle->ChangePartToCompleted(nextPart, nextPart->GetETag());
                 }
                 else
                 {
-                    transferContext->handle->UpdateStatus(DetermineIfFailedOrCanceled(*transferContext->handle));
+                    handle->ChangePartToFailed(nextPart);
+                    handle->Cancel();
+                }
+
+                {
+                    std::lock_guard<std::mutex> locker(state.lock);
+                    ++state.nextPart;
                 }
+                state.partDelivered.notify_all();
             }
+        }
 
-            TriggerTransferStatusUpdatedCallback(transferContext->handle);
+        void TransferManager::CompleteDownload(const std::shared_ptr<TransferHandle>& handle)
+        {
+            if (!handle->HasFailedParts() && handle->GetBytesTransferred() == handle->GetBytesTotalSize())
+            {
+                if (handle->IsFileDownload() && m_transferConfig.downloadFileSyncPolicy == DownloadFileSyncPolicy::ON_COMPLETION &&
+                    !handle->SyncDownloadFile())
+                {
+                    Aws::Client::AWSError<Aws::S3::S3Errors> error(Aws::S3::S3Errors::INTERNAL_FAILURE, "SyncDownloadFileFailed",
+                            "Unable to flush " + handle->GetTargetFilePath(), false);
+                    handle->SetError(error);
+                    handle->UpdateStatus(TransferStatus::FAILED);
+                    TriggerErrorCallback(handle, error);
+                }
+                else
+                {
+                    if (handle->GetJournal())
+                    {
+                        handle->GetJournal()->Remove();
+                    }
+                    handle->UpdateStatus(TransferStatus::COMPLETED);
+                }
+            }
+            else
+            {
+                handle->UpdateStatus(DetermineIfFailedOrCanceled(*handle));
+            }
         }
 
         void TransferManager::WaitForCancellationAndAbortUpload(const std::shared_ptr<TransferHandle>& canceledHandle)
@@ -813,6 +1754,10 @@ namespace Aws
                 auto abortOutcome = m_transferConfig.s3Client->AbortMultipartUpload(abortMultipartUploadRequest);
                 if (abortOutcome.IsSuccess())
                 {
+                    if (canceledHandle->GetJournal())
+                    {
+                        canceledHandle->GetJournal()->Remove();
+                    }
                     canceledHandle->UpdateStatus(TransferStatus::ABORTED);
                     TriggerTransferStatusUpdatedCallback(canceledHandle);
                 }
@@ -824,63 +1769,208 @@ namespace Aws
             }
         }
 
-        void TransferManager::HandleListObjectsResponse(const Aws::S3::S3Client*, const Aws::S3::Model::ListObjectsV2Request& request, const Aws::S3::Model::ListObjectsV2Outcome& outcome,
-            const std::shared_ptr<const Aws::Client::AsyncCallerContext>& context)
+        void TransferManager::AttachJournal(const std::shared_ptr<TransferHandle>& handle)
         {
-            auto self = shared_from_this(); // keep transfer manager alive until all callbacks are finished.
-            auto handler = [self](const Aws::S3::S3Client* client, const Aws::S3::Model::ListObjectsV2Request& request, const Aws::S3::Model::ListObjectsV2Outcome& outcome,
-                const std::shared_ptr<const Aws::Client::AsyncCallerContext>& context) { self->HandleListObjectsResponse(client, request, outcome, context); };
+            if (!m_transferConfig.journalDirectory.empty() && !handle->GetTargetFilePath().empty() && !handle->GetJournal())
+            {
+                handle->SetJournal(Aws::MakeShared<TransferJournal>(CLASS_TAG, m_transferConfig.journalDirectory, handle->GetTransferDirection(),
+                        handle->GetBucketName(), handle->GetKey(), handle->GetTargetFilePath()));
+            }
+        }
 
-            if (outcome.IsSuccess())
+        static bool ChecksumStreamRange(Aws::IStream& stream, uint64_t rangeBegin, uint64_t length, Aws::Utils::Array<uint8_t>& scratch, uint32_t& checksum)
+        {
+            stream.clear();
+            stream.seekg(static_cast<std::streamoff>(rangeBegin));
+
+            checksum = 0;
+            while (length > 0)
             {
-                Aws::S3::Model::ListObjectsV2Request requestCpy = request;
-                std::shared_ptr<const DownloadDirectoryContext> downloadContext = (const std::shared_ptr<const DownloadDirectoryContext>&)context;
-                auto directory = downloadContext->rootDirectory;
-                auto prefix = downloadContext->prefix;
+                size_t chunkSize = static_cast<size_t>((std::min)(length, static_cast<uint64_t>(scratch.GetLength())));
+                stream.read(reinterpret_cast<char*>(scratch.GetUnderlyingData()), chunkSize);
+                if (static_cast<size_t>(stream.gcount()) != chunkSize)
+                {
+                    stream.clear();
+                    return false;
+                }
 
-                auto& result = outcome.GetResult();
-                //if it was truncated, we don't care on this pass anyways. Just go ahead and kick off another list objects and will handle it when it finishes.
-                if (result.GetIsTruncated())
+                checksum = TransferJournal::CalculateChecksum(checksum, scratch.GetUnderlyingData(), chunkSize);
+                length -= chunkSize;
+            }
+
+            return true;
+        }
+
+        static bool ChecksumFileRange(const Aws::FileSystem::PositionedReadFile& file, uint64_t rangeBegin, uint64_t length, Aws::Utils::Array<uint8_t>& scratch, uint32_t& checksum)
+        {
+            checksum = 0;
+            while (length > 0)
+            {
+                size_t chunkSize = static_cast<size_t>((std::min)(length, static_cast<uint64_t>(scratch.GetLength())));
+                if (!file.ReadAt(scratch.GetUnderlyingData(), chunkSize, rangeBegin))
                 {
-                    requestCpy.SetContinuationToken(result.GetNextContinuationToken());
-                    m_transferConfig.s3Client->ListObjectsV2Async(requestCpy, handler, context);
+                    return false;
                 }
 
-                //this can contain matching directories or actual objects to download. If it's a directory, go ahead and create a local directory then
-                // take the new prefix and call list again. if it's an object key, go ahead and initiate download.
-                for (auto& content : result.GetContents())
+                checksum = TransferJournal::CalculateChecksum(checksum, scratch.GetUnderlyingData(), chunkSize);
+                rangeBegin += chunkSize;
+                length -= chunkSize;
+            }
+
+            return true;
+        }
+
+        // a journaled part can only be reused if it has the place and size the part of that id has in the transfer being resumed
+        static bool IsPartOfLayout(const TransferJournal::Part& part, uint64_t totalSize, uint64_t partSize)
+        {
+            uint64_t rangeBegin = static_cast<uint64_t>(part.partId - 1) * partSize;
+            return rangeBegin < totalSize && part.rangeBegin == rangeBegin && part.sizeInBytes == (std::min)(totalSize - rangeBegin, partSize);
+        }
+
+        Aws::Map<int, TransferJournal::Part> TransferManager::ResumeUploadFromJournal(const std::shared_ptr<TransferHandle>& handle, Aws::IOStream* streamToPut,
+                const std::shared_ptr<const Aws::FileSystem::MappedFile>& mappedFile, const std::shared_ptr<const Aws::FileSystem::PositionedReadFile>& readFile)
+        {
+            Aws::Map<int, TransferJournal::Part> resumedParts;
+            auto journal = handle->GetJournal();
+            if (!journal->HasTransfer() || journal->GetMultipartId().empty())
+            {
+                return resumedParts;
+            }
+
+            if (journal->GetBytesTotalSize() != handle->GetBytesTotalSize())
+            {
+                // the file changed since, don't leave its stale upload behind
+                AWS_LOGSTREAM_INFO(CLASS_TAG, "Size of " << handle->GetTargetFilePath() << " changed since it was journaled, starting its upload over");
+                Aws::S3::Model::AbortMultipartUploadRequest abortMultipartUploadRequest;
+                abortMultipartUploadRequest.WithBucket(handle->GetBucketName())
+                    .WithKey(handle->GetKey())
+                    .WithUploadId(journal->GetMultipartId());
+                m_transferConfig.s3Client->AbortMultipartUpload(abortMultipartUploadRequest);
+                return resumedParts;
+            }
+
+            Aws::Map<int, Aws::S3::Model::Part> uploadedParts;
+            Aws::S3::Model::ListPartsRequest listPartsRequest;
+            listPartsRequest.WithBucket(handle->GetBucketName())
+                .WithKey(handle->GetKey())
+                .WithUploadId(journal->GetMultipartId());
+            for (;;)
+            {
+                auto listPartsOutcome = m_transferConfig.s3Client->ListParts(listPartsRequest);
+                if (!listPartsOutcome.IsSuccess())
                 {
-                    if (content.GetSize() <= 0 && content.GetKey() != request.GetPrefix())
-                    {
-                        Aws::FileSystem::CreateDirectoryIfNotExists(DetermineFilePath(directory, prefix, content.GetKey()).c_str());
-                        requestCpy.SetPrefix(content.GetKey());
-                        m_transferConfig.s3Client->ListObjectsV2Async(requestCpy, handler, context);
-                    }
-                    //this is our fixed point in the algorithm. eventually, everything will return an object.
-                    else if (content.GetSize() > 0)
-                    {
-                        Aws::String fileName = DetermineFilePath(downloadContext->rootDirectory, downloadContext->prefix, content.GetKey());
-                        m_transferConfig.transferInitiatedCallback(this, DownloadFile(request.GetBucket(), content.GetKey(), fileName));
-                    }
+                    // typically the upload was aborted or expired
+                    AWS_LOGSTREAM_INFO(CLASS_TAG, "Unable to list the parts of journaled upload " << journal->GetMultipartId() << ", starting the upload of "
+                            << handle->GetTargetFilePath() << " over: " << listPartsOutcome.GetError().GetMessage());
+                    return resumedParts;
                 }
 
-                //Take the common prefix and list with it, keep doing this until we start getting objects back. Go ahead and create the directories though.
-                for (auto& commonPrefix : result.GetCommonPrefixes())
+                for (const auto& part : listPartsOutcome.GetResult().GetParts())
+                {
+                    uploadedParts[part.GetPartNumber()] = part;
+                }
+
+                if (!listPartsOutcome.GetResult().GetIsTruncated())
                 {
-                    Aws::FileSystem::CreateDirectoryIfNotExists(DetermineFilePath(directory, prefix, commonPrefix.GetPrefix()).c_str());
-                    requestCpy.SetPrefix(commonPrefix.GetPrefix());
-                    m_transferConfig.s3Client->ListObjectsV2Async(requestCpy, handler, context);
+                    break;
                 }
+                listPartsRequest.SetPartNumberMarker(listPartsOutcome.GetResult().GetNextPartNumberMarker());
             }
-            else
+
+            uint64_t totalSize = journal->GetBytesTotalSize();
+            uint64_t partSize = journal->GetPartSize();
+            auto buffer = mappedFile ? nullptr : m_bufferManager.Acquire();
+            for (const auto& journaledPart : journal->GetCompletedParts())
             {
-                //notify user if list objects failed.
-                if (m_transferConfig.errorCallback)
+                const auto& part = journaledPart.second;
+                auto uploadedPart = uploadedParts.find(part.partId);
+                if (!IsPartOfLayout(part, totalSize, partSize) || uploadedPart == uploadedParts.end() ||
+                    uploadedPart->second.GetETag() != part.eTag || static_cast<uint64_t>(uploadedPart->second.GetSize()) != part.sizeInBytes)
+                {
+                    continue;
+                }
+
+                uint32_t checksum = 0;
+                if (mappedFile)
+                {
+                    checksum = TransferJournal::CalculateChecksum(0, mappedFile->GetData() + part.rangeBegin, static_cast<size_t>(part.sizeInBytes));
+                }
+                else if (readFile && !ChecksumFileRange(*readFile, part.rangeBegin, part.sizeInBytes, *buffer, checksum))
+                {
+                    continue;
+                }
+                else if (!readFile && !ChecksumStreamRange(*streamToPut, part.rangeBegin, part.sizeInBytes, *buffer, checksum))
                 {
-                    auto handle = Aws::MakeShared<TransferHandle>(CLASS_TAG, request.GetBucket(), "");
-                    m_transferConfig.errorCallback(this, handle, outcome.GetError());
+                    continue;
                 }
+
+                if (checksum == part.checksum)
+                {
+                    resumedParts[part.partId] = part;
+                }
+            }
+            if (buffer)
+            {
+                m_bufferManager.Release(buffer);
+            }
+
+            AWS_LOGSTREAM_INFO(CLASS_TAG, "Resuming upload " << journal->GetMultipartId() << " of " << handle->GetTargetFilePath() << " with "
+                    << resumedParts.size() << " of " << journal->GetCompletedParts().size() << " journaled parts");
+            handle->SetMultipartId(journal->GetMultipartId());
+            if (!journal->Rewrite(totalSize, partSize, journal->GetMultipartId(), "", resumedParts))
+            {
+                AWS_LOGSTREAM_WARN(CLASS_TAG, "Unable to write transfer journal " << journal->GetPath() << ", upload will not be resumable");
+                handle->SetJournal(nullptr);
             }
+            return resumedParts;
+        }
+
+        Aws::Map<int, TransferJournal::Part> TransferManager::ResumeDownloadFromJournal(const std::shared_ptr<TransferHandle>& handle, const Aws::String& objectETag)
+        {
+            Aws::Map<int, TransferJournal::Part> resumedParts;
+            auto journal = handle->GetJournal();
+            if (objectETag.empty())
+            {
+                // nothing to tell whether the object changed before the download is resumed
+                handle->SetJournal(nullptr);
+                return resumedParts;
+            }
+
+            uint64_t totalSize = handle->GetBytesTotalSize();
+            uint64_t partSize = m_transferConfig.bufferSize;
+            if (journal->HasTransfer() && journal->GetBytesTotalSize() == totalSize && journal->GetPartSize() == partSize && journal->GetObjectETag() == objectETag)
+            {
+#ifdef _MSC_VER
+                Aws::IFStream downloadedFile(Aws::Utils::StringUtils::ToWString(handle->GetTargetFilePath().c_str()).c_str(), std::ios_base::in | std::ios_base::binary);
+#else
+                Aws::IFStream downloadedFile(handle->GetTargetFilePath().c_str(), std::ios_base::in | std::ios_base::binary);
+#endif
+                if (downloadedFile.good())
+                {
+                    auto buffer = m_bufferManager.Acquire();
+                    for (const auto& journaledPart : journal->GetCompletedParts())
+                    {
+                        const auto& part = journaledPart.second;
+                        uint32_t checksum = 0;
+                        if (IsPartOfLayout(part, totalSize, partSize) && ChecksumStreamRange(downloadedFile, part.rangeBegin, part.sizeInBytes, *buffer, checksum) &&
+                            checksum == part.checksum)
+                        {
+                            resumedParts[part.partId] = part;
+                        }
+                    }
+                    m_bufferManager.Release(buffer);
+                }
+
+                AWS_LOGSTREAM_INFO(CLASS_TAG, "Resuming download of " << handle->GetTargetFilePath() << " with " << resumedParts.size() << " of "
+                        << journal->GetCompletedParts().size() << " journaled parts");
+            }
+
+            if (!journal->Rewrite(totalSize, partSize, "", objectETag, resumedParts))
+            {
+                AWS_LOGSTREAM_WARN(CLASS_TAG, "Unable to write transfer journal " << journal->GetPath() << ", download will not be resumable");
+                handle->SetJournal(nullptr);
+            }
+            return resumedParts;
         }
 
         Aws::String TransferManager::DetermineFilePath(const Aws::String& directory, const Aws::String& prefix, const Aws::String& keyName)
@@ -902,6 +1992,70 @@ namespace Aws
             return ss.str();
         }
 
+        Aws::Utils::Array<uint8_t>* TransferManager::AcquirePartBuffer(uint64_t partSize)
+        {
+            if (partSize <= m_transferConfig.bufferSize)
+            {
+                return m_bufferManager.Acquire();
+            }
+
+            {
+                std::lock_guard<std::mutex> locker(m_largePartBufferLock);
+                for (size_t i = PooledBuffersFor(partSize); i > 0; --i)
+                {
+                    Aws::Delete(m_bufferManager.Acquire());
+                }
+            }
+            return Aws::New<Aws::Utils::Array<uint8_t>>(CLASS_TAG, static_cast<size_t>(partSize));
+        }
+
+        void TransferManager::ReleasePartBuffer(Aws::Utils::Array<uint8_t>* buffer)
+        {
+            if (buffer->GetLength() <= m_transferConfig.bufferSize)
+            {
+                m_bufferManager.Release(buffer);
+                return;
+            }
+
+            size_t pooledBuffers = PooledBuffersFor(buffer->GetLength());
+            Aws::Delete(buffer);
+            for (size_t i = 0; i < pooledBuffers; ++i)
+            {
+                m_bufferManager.Release(Aws::New<Aws::Utils::Array<uint8_t>>(CLASS_TAG, static_cast<size_t>(m_transferConfig.bufferSize)));
+            }
+        }
+
+        size_t TransferManager::PooledBuffersFor(uint64_t partSize) const
+        {
+            uint64_t pooledBuffers = (partSize + m_transferConfig.bufferSize - 1) / m_transferConfig.bufferSize;
+            uint64_t poolSize = m_transferConfig.transferBufferMaxHeapSize / m_transferConfig.bufferSize;
+            return static_cast<size_t>((std::min)(pooledBuffers, poolSize));
+        }
+
+        void TransferManager::AcquirePartSlot()
+        {
+            if (m_partConcurrencyTuner)
+            {
+                m_partConcurrencyTuner->AcquirePart();
+            }
+        }
+
+        void TransferManager::ReleasePartSlot(uint64_t bytes, bool succeeded)
+        {
+            if (m_partConcurrencyTuner)
+            {
+                m_partConcurrencyTuner->ReleasePart(bytes, succeeded);
+            }
+        }
+
+        void TransferManager::CancelPartSlot()
+        {
+            if (m_partConcurrencyTuner)
+            {
+                m_partConcurrencyTuner->CancelPart();
+            }
+        }
+
         TransferStatus TransferManager::DetermineIfFailedOrCanceled(const TransferHandle& handle) const
         {
             return handle.ShouldContinue() ? TransferStatus::FAILED : TransferStatus::CANCELED;
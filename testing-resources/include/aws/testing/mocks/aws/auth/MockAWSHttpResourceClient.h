@@ -14,37 +14,96 @@
   */
 
 #include <aws/core/internal/AWSHttpResourceClient.h>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
 
+/**
+ * Stands in for the EC2 instance metadata endpoint. It is safe to update and query from several threads, and requests can be held at
+ * the endpoint so tests can observe what callers do while a credentials pull is in flight.
+ */
 class MockEC2MetadataClient : public Aws::Internal::EC2MetadataClient
 {
 public:
     MockEC2MetadataClient()
-        :EC2MetadataClient()
+        :EC2MetadataClient(), m_requestCount(0), m_holdRequests(false)
     { }
 
     inline Aws::String GetDefaultCredentials() const override
     {
+        std::unique_lock<std::mutex> locker(m_lock);
+        ++m_requestCount;
+        m_lastRequestThread = std::this_thread::get_id();
+        m_signal.notify_all();
+        m_signal.wait(locker, [this] { return !m_holdRequests; });
         return m_mockedValue;
     }
 
     inline void SetMockedCredentialsValue(const Aws::String& mockValue)
     {
+        std::lock_guard<std::mutex> locker(m_lock);
         m_mockedValue = mockValue;
     }
 
     inline Aws::String GetCurrentRegion() const override
     {
+        std::lock_guard<std::mutex> locker(m_lock);
         return m_region;
     }
 
     inline void SetCurrentRegionValue(const Aws::String& mockValue)
     {
+        std::lock_guard<std::mutex> locker(m_lock);
         m_region = mockValue;
     }
 
+    /**
+     * Requests for credentials block until ReleaseRequests is called.
+     */
+    inline void HoldRequests()
+    {
+        std::lock_guard<std::mutex> locker(m_lock);
+        m_holdRequests = true;
+    }
+
+    inline void ReleaseRequests()
+    {
+        {
+            std::lock_guard<std::mutex> locker(m_lock);
+            m_holdRequests = false;
+        }
+        m_signal.notify_all();
+    }
+
+    /**
+     * Waits until at least count requests for credentials have reached the endpoint.
+     */
+    inline void WaitForRequests(size_t count) const
+    {
+        std::unique_lock<std::mutex> locker(m_lock);
+        m_signal.wait(locker, [this, count] { return m_requestCount >= count; });
+    }
+
+    inline size_t GetRequestCount() const
+    {
+        std::lock_guard<std::mutex> locker(m_lock);
+        return m_requestCount;
+    }
+
+    inline std::thread::id GetLastRequestThread() const
+    {
+        std::lock_guard<std::mutex> locker(m_lock);
+        return m_lastRequestThread;
+    }
+
 private:
     Aws::String m_mockedValue;
     Aws::String m_region;
+    mutable size_t m_requestCount;
+    mutable std::thread::id m_lastRequestThread;
+    bool m_holdRequests;
+    mutable std::mutex m_lock;
+    mutable std::condition_variable m_signal;
 };
 
 